@@ -37,6 +37,10 @@
 #ifndef ARCANECORE_BASE_EXCEPTIONS_HPP_
 #define ARCANECORE_BASE_EXCEPTIONS_HPP_
 
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <new>
 #include <stdexcept>
 #include <string>
 
@@ -44,6 +48,7 @@
 #include <deus/UnicodeView.hpp>
 
 #include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/StackTrace.hpp"
 
 
 namespace arc
@@ -62,66 +67,266 @@ namespace ex
 /*!
  * \brief Base exception type which is derived from std::runtime_error that all
  *        exceptions thrown by the Deus library inherit from.
+ *
+ * Constructing an ArcError does not allocate memory in the common case: the
+ * type string is a static string, and messages shorter than
+ * arc::ex::ArcError::INLINE_WHAT_SIZE bytes (once converted to UTF-8) are
+ * stored inline within the exception object. Longer messages fallback to a
+ * heap allocation.
+ *
+ * ArcErrors can optionally record the call stack they were constructed from,
+ * see set_stack_trace_enabled().
  */
 class ArcError
     : public std::runtime_error
 {
 public:
 
+    //--------------------------------------------------------------------------
+    //                              PUBLIC CONSTANTS
+    //--------------------------------------------------------------------------
+
     /*!
-     * \brief Constructs a new ArcErrpr exception with the given message.
+     * \brief The size of the buffer (including the null terminator) used to
+     *        store messages without allocating memory.
+     */
+    static const std::size_t INLINE_WHAT_SIZE = 128;
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Constructs a new ArcError exception with the given UTF-8 message.
+     */
+    ArcError(const char* what)
+        : std::runtime_error("")
+        , m_type            ("ArcError")
+        , m_heap_what       (nullptr)
+    {
+        set_what(what, std::strlen(what));
+        capture_stack_trace();
+    }
+
+    /*!
+     * \brief Constructs a new ArcError exception with the given message.
      */
     ArcError(const deus::UnicodeView& what)
-        : std::runtime_error(what.convert_if_not(
-            deus::ASCII_COMPATIBLE_ENCODINGS,
-            deus::Encoding::kUTF8,
-            m_what_converted
-        ).c_str())
-        , m_type(deus::UnicodeView("ArcError", deus::Encoding::kUTF8))
+        : std::runtime_error("")
+        , m_type            ("ArcError")
+        , m_heap_what       (nullptr)
+    {
+        set_what(what);
+        capture_stack_trace();
+    }
+
+    ArcError(const ArcError& other)
+        : std::runtime_error(other)
+        , m_type            (other.m_type)
+        , m_heap_what       (nullptr)
+        , m_stack_trace     (other.m_stack_trace)
     {
+        set_what(other.what(), std::strlen(other.what()));
     }
 
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
     virtual ~ArcError() throw()
     {
+        delete[] m_heap_what;
+    }
+
+    //--------------------------------------------------------------------------
+    //                                 OPERATORS
+    //--------------------------------------------------------------------------
+
+    ArcError& operator=(const ArcError& other)
+    {
+        if(this != &other)
+        {
+            std::runtime_error::operator=(other);
+            m_type = other.m_type;
+            delete[] m_heap_what;
+            m_heap_what = nullptr;
+            set_what(other.what(), std::strlen(other.what()));
+            m_stack_trace = other.m_stack_trace;
+        }
+        return *this;
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC STATIC FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns whether ArcErrors record the call stack they are
+     *        constructed from.
+     */
+    static bool is_stack_trace_enabled()
+    {
+        return get_stack_trace_enabled().load(std::memory_order_relaxed);
+    }
+
+    /*!
+     * \brief Sets whether ArcErrors record the call stack they are constructed
+     *        from (this is disabled by default).
+     *
+     * Capturing is cheap (see arc::ex::StackTrace) but does increase the cost
+     * of constructing every exception, so it is opt-in.
+     */
+    static void set_stack_trace_enabled(bool enabled)
+    {
+        get_stack_trace_enabled().store(enabled, std::memory_order_relaxed);
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns the UTF-8 error message of this exception.
+     */
+    virtual const char* what() const throw() override
+    {
+        if(m_heap_what != nullptr)
+        {
+            return m_heap_what;
+        }
+        return m_what;
     }
 
     /*!
      * \brief Returns the type string of this exception.
+     *
+     * The returned view refers to a string with static storage duration.
      */
-    const deus::UnicodeStorage& get_type() const
+    deus::UnicodeView get_type() const
     {
-        return m_type;
+        return deus::UnicodeView(m_type, deus::Encoding::kASCII);
     }
 
+    /*!
+     * \brief Returns the call stack this exception was constructed from.
+     *
+     * This will be empty unless stack traces were enabled when this exception
+     * was constructed (see set_stack_trace_enabled()).
+     */
+    const StackTrace& get_stack_trace() const
+    {
+        return m_stack_trace;
+    }
 
 protected:
 
+    //--------------------------------------------------------------------------
+    //                           PROTECTED CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Super constructor which should be called by derived classes of
+     *        ArcError.
+     *
+     * \param what The UTF-8 error message of the exception.
+     * \param type The type string of the exception, usually just the name of
+     *             the class (e.g. "ValueError"). This must be a string literal
+     *             (or otherwise have static storage duration).
+     */
+    ArcError(const char* what, const char* type)
+        : std::runtime_error("")
+        , m_type            (type)
+        , m_heap_what       (nullptr)
+    {
+        set_what(what, std::strlen(what));
+        capture_stack_trace();
+    }
+
     /*!
      * \brief Super constructor which should be called by derived classes of
      *        ArcError.
      *
      * \param what The error message of the exception.
      * \param type The type string of the exception, usually just the name of
-     *             the class (e.g. "ValueError").
+     *             the class (e.g. "ValueError"). This must be a string literal
+     *             (or otherwise have static storage duration).
      */
-    ArcError(
-            const deus::UnicodeView& what,
-            const deus::UnicodeView& type)
-        : std::runtime_error(what.convert_if_not(
-            deus::ASCII_COMPATIBLE_ENCODINGS,
-            deus::Encoding::kUTF8,
-            m_what_converted
-        ).c_str())
-        , m_type(type.convert(deus::Encoding::kUTF8))
+    ArcError(const deus::UnicodeView& what, const char* type)
+        : std::runtime_error("")
+        , m_type            (type)
+        , m_heap_what       (nullptr)
     {
+        set_what(what);
+        capture_stack_trace();
     }
 
 private:
 
-    // for converted the what parameter to ascii compatible (if needed)
-    deus::UnicodeStorage m_what_converted;
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
     // the type string of this exception
-    deus::UnicodeStorage m_type;
+    const char* m_type;
+    // the message if it is too long to be stored inline
+    char* m_heap_what;
+    // the message if it is short enough to be stored inline
+    char m_what[INLINE_WHAT_SIZE];
+    // the call stack this exception was constructed from (if enabled)
+    StackTrace m_stack_trace;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    // returns the flag for whether stack traces are captured
+    static std::atomic<bool>& get_stack_trace_enabled()
+    {
+        static std::atomic<bool> enabled(false);
+        return enabled;
+    }
+
+    // records the current call stack if enabled
+    void capture_stack_trace()
+    {
+        if(is_stack_trace_enabled())
+        {
+            m_stack_trace.capture();
+        }
+    }
+
+    // sets the message of this exception from the given UTF-8 string
+    void set_what(const char* what, std::size_t length)
+    {
+        char* destination = m_what;
+        if(length >= INLINE_WHAT_SIZE)
+        {
+            m_heap_what = new(std::nothrow) char[length + 1];
+            if(m_heap_what != nullptr)
+            {
+                destination = m_heap_what;
+            }
+            else
+            {
+                // truncate rather than failing to construct the exception
+                length = INLINE_WHAT_SIZE - 1;
+            }
+        }
+        std::memcpy(destination, what, length);
+        destination[length] = '\0';
+    }
+
+    // sets the message of this exception, converting it to UTF-8 if needed
+    void set_what(const deus::UnicodeView& what)
+    {
+        deus::UnicodeStorage converted;
+        const deus::UnicodeView& utf8 = what.convert_if_not(
+            deus::ASCII_COMPATIBLE_ENCODINGS,
+            deus::Encoding::kUTF8,
+            converted
+        );
+        set_what(utf8.c_str(), std::strlen(utf8.c_str()));
+    }
 };
 
 //------------------------------------------------------------------------------
@@ -137,6 +342,11 @@ class RuntimeError
 {
 public:
 
+    RuntimeError(const char* what)
+        : ArcError(what, "RuntimeError")
+    {
+    }
+
     RuntimeError(const deus::UnicodeView& what)
         : ArcError(what, "RuntimeError")
     {
@@ -155,6 +365,11 @@ class ValueError
 {
 public:
 
+    ValueError(const char* what)
+        : ArcError(what, "ValueError")
+    {
+    }
+
     ValueError(const deus::UnicodeView& what)
         : ArcError(what, "ValueError")
     {
@@ -174,12 +389,121 @@ class StateError
 {
 public:
 
+    StateError(const char* what)
+        : ArcError(what, "StateError")
+    {
+    }
+
     StateError(const deus::UnicodeView& what)
         : ArcError(what, "StateError")
     {
     }
 };
 
+//------------------------------------------------------------------------------
+//                                   ERROR CODE
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief Identifies each of the exception types of ArcaneCore, so that an error
+ *        can be reported without throwing.
+ *
+ * \see arc::ex::Error
+ */
+enum class ErrorCode
+{
+    /// Corresponds to arc::ex::ArcError.
+    kArcError,
+    /// Corresponds to arc::ex::RuntimeError.
+    kRuntimeError,
+    /// Corresponds to arc::ex::ValueError.
+    kValueError,
+    /// Corresponds to arc::ex::StateError.
+    kStateError
+};
+
+//------------------------------------------------------------------------------
+//                                     ERROR
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief Describes an error that has not been thrown.
+ *
+ * This is the error type returned by the non-throwing (```try_```) variants of
+ * ArcaneCore functions through arc::Result. An Error is a code and a pointer to
+ * a static message, so it can be created and copied without allocating memory,
+ * and can be converted to the equivalent exception with raise().
+ */
+class Error
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTOR
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Constructs a new Error.
+     *
+     * \param code The type of the error.
+     * \param message The UTF-8 error message. This must be a string literal (or
+     *                otherwise have static storage duration).
+     */
+    Error(ErrorCode code, const char* message)
+        : m_code   (code)
+        , m_message(message)
+    {
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns the type of this error.
+     */
+    ErrorCode get_code() const
+    {
+        return m_code;
+    }
+
+    /*!
+     * \brief Returns the UTF-8 message of this error.
+     */
+    const char* get_message() const
+    {
+        return m_message;
+    }
+
+    /*!
+     * \brief Throws the exception that corresponds to this error's code, using
+     *        this error's message.
+     */
+    [[noreturn]] void raise() const
+    {
+        switch(m_code)
+        {
+            case ErrorCode::kRuntimeError:
+                throw RuntimeError(m_message);
+            case ErrorCode::kValueError:
+                throw ValueError(m_message);
+            case ErrorCode::kStateError:
+                throw StateError(m_message);
+            default:
+                throw ArcError(m_message);
+        }
+    }
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    ErrorCode m_code;
+    const char* m_message;
+};
+
 } // namespace ex
 ARC_BASE_VERSION_NS_END
 } // namespace arc
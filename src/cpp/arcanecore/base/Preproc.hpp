@@ -0,0 +1,135 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Preprocessor definitions describing the platform ArcaneCore is being
+ *        built for.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_PREPROC_HPP_
+#define ARCANECORE_BASE_PREPROC_HPP_
+
+//------------------------------------------------------------------------------
+//                               OPERATING SYSTEM
+//------------------------------------------------------------------------------
+
+#ifdef IN_DOXYGEN
+
+/*!
+ * \brief Defined when building for Windows.
+ */
+#define ARC_OS_WINDOWS
+
+/*!
+ * \brief Defined when building for a UNIX-like operating system (this includes
+ *        Linux and macOS).
+ */
+#define ARC_OS_UNIX
+
+/*!
+ * \brief Defined when building for Linux.
+ */
+#define ARC_OS_LINUX
+
+/*!
+ * \brief Defined when building for macOS.
+ */
+#define ARC_OS_MAC
+
+#else
+
+#if defined(_WIN32)
+    #define ARC_OS_WINDOWS
+#elif defined(__APPLE__)
+    #define ARC_OS_UNIX
+    #define ARC_OS_MAC
+#elif defined(__linux__)
+    #define ARC_OS_UNIX
+    #define ARC_OS_LINUX
+#elif defined(__unix__)
+    #define ARC_OS_UNIX
+#endif
+
+#endif // IN_DOXYGEN
+
+//------------------------------------------------------------------------------
+//                                 INSTRUCTION SETS
+//------------------------------------------------------------------------------
+
+#ifdef IN_DOXYGEN
+
+/*!
+ * \brief Defined when SSE2 instructions are available.
+ */
+#define ARC_SIMD_SSE2
+
+/*!
+ * \brief Defined when AVX2 instructions are available.
+ */
+#define ARC_SIMD_AVX2
+
+/*!
+ * \brief Defined when ARM NEON instructions are available.
+ */
+#define ARC_SIMD_NEON
+
+#else
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define ARC_SIMD_SSE2
+#endif
+#if defined(__AVX2__)
+    #define ARC_SIMD_AVX2
+#endif
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define ARC_SIMD_NEON
+#endif
+
+#endif // IN_DOXYGEN
+
+//------------------------------------------------------------------------------
+//                                    HARDWARE
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief The assumed size of a cache line in bytes, used to pad data that is
+ *        written by different threads so that it does not falsely share a
+ *        cache line.
+ */
+#if defined(__APPLE__) && defined(__aarch64__)
+    #define ARC_CACHE_LINE_SIZE 128
+#else
+    #define ARC_CACHE_LINE_SIZE 64
+#endif
+
+#endif
@@ -0,0 +1,455 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Type used to return either a value or an error, as an alternative to
+ *        throwing exceptions.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_RESULT_HPP_
+#define ARCANECORE_BASE_RESULT_HPP_
+
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/Exceptions.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+
+/*!
+ * \brief Holds either the value of a successful operation or the error of a
+ *        failed operation.
+ *
+ * Result is returned by the non-throwing (```try_```) variants of ArcaneCore
+ * functions so that callers on critical paths only pay for a branch when
+ * checking for failure, rather than for exception unwinding. The value or
+ * error is stored inline, so a Result never allocates memory itself.
+ *
+ * Example usage:
+ *
+ * \code
+ * arc::Result<deus::UnicodeStorage> result = arc::clock::try_get_timestamp(t);
+ * if(!result)
+ * {
+ *     std::cerr << result.get_error().get_message() << std::endl;
+ * }
+ *
+ * // or convert a failure to the equivalent exception
+ * deus::UnicodeStorage timestamp =
+ *     arc::clock::try_get_timestamp(t).get_or_throw();
+ * \endcode
+ *
+ * \tparam T The type of the value.
+ * \tparam E The type of the error, this must provide a ```raise()``` function
+ *           in order to use get_or_throw().
+ */
+template<typename T, typename E = arc::ex::Error>
+class Result
+{
+public:
+
+    static_assert(
+        !std::is_same<T, E>::value,
+        "The value and error types of arc::Result must be different."
+    );
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Constructs a successful result with the given value.
+     */
+    Result(const T& value)
+        : m_ok(true)
+    {
+        new(&m_value) T(value);
+    }
+
+    /*!
+     * \brief Constructs a successful result with the given value.
+     */
+    Result(T&& value)
+        : m_ok(true)
+    {
+        new(&m_value) T(std::move(value));
+    }
+
+    /*!
+     * \brief Constructs a failed result with the given error.
+     */
+    Result(const E& error)
+        : m_ok(false)
+    {
+        new(&m_error) E(error);
+    }
+
+    Result(const Result& other)
+        : m_ok(other.m_ok)
+    {
+        if(m_ok)
+        {
+            new(&m_value) T(other.m_value);
+        }
+        else
+        {
+            new(&m_error) E(other.m_error);
+        }
+    }
+
+    Result(Result&& other)
+        : m_ok(other.m_ok)
+    {
+        if(m_ok)
+        {
+            new(&m_value) T(std::move(other.m_value));
+        }
+        else
+        {
+            new(&m_error) E(std::move(other.m_error));
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    ~Result()
+    {
+        destroy();
+    }
+
+    //--------------------------------------------------------------------------
+    //                                 OPERATORS
+    //--------------------------------------------------------------------------
+
+    Result& operator=(const Result& other)
+    {
+        if(this != &other)
+        {
+            destroy();
+            m_ok = other.m_ok;
+            if(m_ok)
+            {
+                new(&m_value) T(other.m_value);
+            }
+            else
+            {
+                new(&m_error) E(other.m_error);
+            }
+        }
+        return *this;
+    }
+
+    Result& operator=(Result&& other)
+    {
+        if(this != &other)
+        {
+            destroy();
+            m_ok = other.m_ok;
+            if(m_ok)
+            {
+                new(&m_value) T(std::move(other.m_value));
+            }
+            else
+            {
+                new(&m_error) E(std::move(other.m_error));
+            }
+        }
+        return *this;
+    }
+
+    /*!
+     * \brief Returns whether this result holds a value.
+     */
+    explicit operator bool() const
+    {
+        return m_ok;
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns whether this result holds a value.
+     */
+    bool is_ok() const
+    {
+        return m_ok;
+    }
+
+    /*!
+     * \brief Returns whether this result holds an error.
+     */
+    bool is_error() const
+    {
+        return !m_ok;
+    }
+
+    /*!
+     * \brief Returns the value of this result.
+     *
+     * \warning This result must hold a value (see is_ok()), otherwise the
+     *          behaviour is undefined. Use get_or_throw() when this is not
+     *          known.
+     */
+    T& get_value()
+    {
+        return m_value;
+    }
+
+    /*!
+     * \brief Returns the value of this result.
+     *
+     * \warning This result must hold a value (see is_ok()), otherwise the
+     *          behaviour is undefined. Use get_or_throw() when this is not
+     *          known.
+     */
+    const T& get_value() const
+    {
+        return m_value;
+    }
+
+    /*!
+     * \brief Returns the error of this result.
+     *
+     * \warning This result must hold an error (see is_error()), otherwise the
+     *          behaviour is undefined.
+     */
+    const E& get_error() const
+    {
+        return m_error;
+    }
+
+    /*!
+     * \brief Returns the value of this result, or if this result holds an
+     *        error, throws the error's equivalent exception.
+     */
+    T& get_or_throw()
+    {
+        if(!m_ok)
+        {
+            m_error.raise();
+        }
+        return m_value;
+    }
+
+    /*!
+     * \brief Returns the value of this result, or if this result holds an
+     *        error, throws the error's equivalent exception.
+     */
+    const T& get_or_throw() const
+    {
+        if(!m_ok)
+        {
+            m_error.raise();
+        }
+        return m_value;
+    }
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    bool m_ok;
+    union
+    {
+        T m_value;
+        E m_error;
+    };
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    // destroys whichever of the value or error is held
+    void destroy()
+    {
+        if(m_ok)
+        {
+            m_value.~T();
+        }
+        else
+        {
+            m_error.~E();
+        }
+    }
+};
+
+/*!
+ * \brief Specialisation of arc::Result for operations that do not return a
+ *        value when they succeed.
+ */
+template<typename E>
+class Result<void, E>
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Constructs a successful result.
+     */
+    Result()
+        : m_ok(true)
+    {
+    }
+
+    /*!
+     * \brief Constructs a failed result with the given error.
+     */
+    Result(const E& error)
+        : m_ok(false)
+    {
+        new(&m_error) E(error);
+    }
+
+    Result(const Result& other)
+        : m_ok(other.m_ok)
+    {
+        if(!m_ok)
+        {
+            new(&m_error) E(other.m_error);
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    ~Result()
+    {
+        if(!m_ok)
+        {
+            m_error.~E();
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    //                                 OPERATORS
+    //--------------------------------------------------------------------------
+
+    Result& operator=(const Result& other)
+    {
+        if(this != &other)
+        {
+            if(!m_ok)
+            {
+                m_error.~E();
+            }
+            m_ok = other.m_ok;
+            if(!m_ok)
+            {
+                new(&m_error) E(other.m_error);
+            }
+        }
+        return *this;
+    }
+
+    /*!
+     * \brief Returns whether the operation was successful.
+     */
+    explicit operator bool() const
+    {
+        return m_ok;
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns whether the operation was successful.
+     */
+    bool is_ok() const
+    {
+        return m_ok;
+    }
+
+    /*!
+     * \brief Returns whether this result holds an error.
+     */
+    bool is_error() const
+    {
+        return !m_ok;
+    }
+
+    /*!
+     * \brief Returns the error of this result.
+     *
+     * \warning This result must hold an error (see is_error()), otherwise the
+     *          behaviour is undefined.
+     */
+    const E& get_error() const
+    {
+        return m_error;
+    }
+
+    /*!
+     * \brief If this result holds an error, throws the error's equivalent
+     *        exception.
+     */
+    void get_or_throw() const
+    {
+        if(!m_ok)
+        {
+            m_error.raise();
+        }
+    }
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    bool m_ok;
+    union
+    {
+        E m_error;
+    };
+};
+
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
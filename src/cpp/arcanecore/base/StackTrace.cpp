@@ -0,0 +1,299 @@
+/*!
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "arcanecore/base/StackTrace.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <unordered_map>
+
+#include "arcanecore/base/Preproc.hpp"
+#include "arcanecore/base/fmt/Format.hpp"
+
+#ifdef ARC_OS_WINDOWS
+    #include <windows.h>
+#else
+    #include <cxxabi.h>
+    #include <dlfcn.h>
+    #include <pthread.h>
+#endif
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace ex
+{
+
+namespace
+{
+
+#ifndef ARC_OS_WINDOWS
+
+//------------------------------------------------------------------------------
+//                                  STACK BOUNDS
+//------------------------------------------------------------------------------
+
+/*
+ * The address range of the current thread's stack, which the frame pointer
+ * walk is confined to so that it never reads outside of the stack.
+ */
+struct StackBounds
+{
+    bool initialised;
+    std::uintptr_t low;
+    std::uintptr_t high;
+};
+
+// querying the bounds can be slow (e.g. glibc reads /proc/self/maps for the
+// main thread) so they're queried once per thread
+thread_local StackBounds t_stack_bounds = {false, 0, 0};
+
+const StackBounds& get_stack_bounds()
+{
+    if(!t_stack_bounds.initialised)
+    {
+        t_stack_bounds.initialised = true;
+#if defined(ARC_OS_LINUX)
+        pthread_attr_t attr;
+        if(pthread_getattr_np(pthread_self(), &attr) == 0)
+        {
+            void* address = nullptr;
+            std::size_t size = 0;
+            if(pthread_attr_getstack(&attr, &address, &size) == 0)
+            {
+                t_stack_bounds.low = reinterpret_cast<std::uintptr_t>(address);
+                t_stack_bounds.high = t_stack_bounds.low + size;
+            }
+            pthread_attr_destroy(&attr);
+        }
+#elif defined(ARC_OS_MAC)
+        pthread_t self = pthread_self();
+        t_stack_bounds.high =
+            reinterpret_cast<std::uintptr_t>(pthread_get_stackaddr_np(self));
+        t_stack_bounds.low =
+            t_stack_bounds.high - pthread_get_stacksize_np(self);
+#endif
+    }
+    return t_stack_bounds;
+}
+
+#endif
+
+//------------------------------------------------------------------------------
+//                                  SYMBOL CACHE
+//------------------------------------------------------------------------------
+
+std::mutex g_symbol_mutex;
+std::unordered_map<void*, std::string> g_symbols;
+
+// returns the description of the code at the given return address
+std::string symbolize(void* address)
+{
+    char buffer[64];
+    ARC_FMT_TO_BUFFER(buffer, sizeof(buffer), "{}", address);
+    std::string ret(buffer);
+
+#ifndef ARC_OS_WINDOWS
+    // look up the call instruction rather than the instruction after it
+    const char* call_site = static_cast<const char*>(address) - 1;
+
+    Dl_info info;
+    if(dladdr(call_site, &info) == 0)
+    {
+        return ret;
+    }
+
+    if(info.dli_sname != nullptr)
+    {
+        int status = 0;
+        char* demangled =
+            abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+        ret += " in ";
+        ret += (status == 0 && demangled != nullptr) ?
+            demangled : info.dli_sname;
+        std::free(demangled);
+
+        ARC_FMT_TO_BUFFER(
+            buffer,
+            sizeof(buffer),
+            "+0x{:x}",
+            static_cast<std::size_t>(
+                static_cast<const char*>(address) -
+                static_cast<const char*>(info.dli_saddr)
+            )
+        );
+        ret += buffer;
+    }
+    if(info.dli_fname != nullptr)
+    {
+        // module relative offset, which can be passed to addr2line
+        ARC_FMT_TO_BUFFER(
+            buffer,
+            sizeof(buffer),
+            "+0x{:x}",
+            static_cast<std::size_t>(
+                call_site - static_cast<const char*>(info.dli_fbase)
+            )
+        );
+        ret += " (";
+        ret += info.dli_fname;
+        ret += buffer;
+        ret += ")";
+    }
+#endif
+
+    return ret;
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                  CONSTRUCTOR
+//------------------------------------------------------------------------------
+
+StackTrace::StackTrace()
+    : m_size(0)
+{
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+#if defined(__GNUC__)
+    __attribute__((noinline))
+#elif defined(_MSC_VER)
+    __declspec(noinline)
+#endif
+void StackTrace::capture(std::size_t skip)
+{
+    m_size = 0;
+
+#if defined(ARC_OS_WINDOWS)
+
+    m_size = CaptureStackBackTrace(
+        static_cast<DWORD>(skip + 1),
+        static_cast<DWORD>(MAX_FRAMES),
+        m_frames,
+        nullptr
+    );
+
+#elif defined(__GNUC__)
+
+    const StackBounds& bounds = get_stack_bounds();
+    std::uintptr_t low = bounds.low;
+    const std::uintptr_t high = bounds.high;
+
+    // each frame record is the caller's frame pointer followed by the return
+    // address (this holds for both x86-64 and AArch64)
+    void** frame = static_cast<void**>(__builtin_frame_address(0));
+    while(m_size < MAX_FRAMES)
+    {
+        const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(frame);
+        if(address < low ||
+           address + 2 * sizeof(void*) > high ||
+           address % sizeof(void*) != 0)
+        {
+            break;
+        }
+
+        void* return_address = frame[1];
+        if(return_address == nullptr)
+        {
+            break;
+        }
+        if(skip > 0)
+        {
+            --skip;
+        }
+        else
+        {
+            m_frames[m_size++] = return_address;
+        }
+
+        // the stack grows down, so callers' frames must be at higher addresses
+        low = address + 2 * sizeof(void*);
+        frame = static_cast<void**>(frame[0]);
+    }
+
+#endif
+}
+
+void StackTrace::clear()
+{
+    m_size = 0;
+}
+
+bool StackTrace::empty() const
+{
+    return m_size == 0;
+}
+
+std::size_t StackTrace::get_size() const
+{
+    return m_size;
+}
+
+void* StackTrace::get_frame(std::size_t index) const
+{
+    return m_frames[index];
+}
+
+std::string StackTrace::to_string() const
+{
+    std::string ret;
+    std::lock_guard<std::mutex> lock(g_symbol_mutex);
+    for(std::size_t i = 0; i < m_size; ++i)
+    {
+        std::unordered_map<void*, std::string>::iterator symbol =
+            g_symbols.find(m_frames[i]);
+        if(symbol == g_symbols.end())
+        {
+            symbol = g_symbols.insert(
+                std::make_pair(m_frames[i], symbolize(m_frames[i]))
+            ).first;
+        }
+
+        char index[32];
+        ARC_FMT_TO_BUFFER(index, sizeof(index), "#{:<3} ", i);
+        ret += index;
+        ret += symbol->second;
+        ret += '\n';
+    }
+    return ret;
+}
+
+} // namespace ex
+ARC_BASE_VERSION_NS_END
+} // namespace arc
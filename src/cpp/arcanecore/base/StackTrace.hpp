@@ -0,0 +1,145 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Lightweight capture of the current call stack.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_STACKTRACE_HPP_
+#define ARCANECORE_BASE_STACKTRACE_HPP_
+
+#include <cstddef>
+#include <string>
+
+#include "arcanecore/base/BaseAPI.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace ex
+{
+
+/*!
+ * \brief Records the return addresses of the current call stack, and converts
+ *        them to readable text on demand.
+ *
+ * Capturing is designed to be cheap enough to perform when constructing an
+ * exception: on UNIX-like systems the addresses are recorded by walking the
+ * chain of frame pointers into a fixed size inline array, so no memory is
+ * allocated and no symbol information is touched. Symbolization only happens
+ * when to_string() is called, and the results are kept in a process-wide cache
+ * so that repeatedly printing traces through the same code is cheap.
+ *
+ * \note The frame pointer walk can only see through code that has been built
+ *       with frame pointers (```-fno-omit-frame-pointer```), and symbol names
+ *       are only available for symbols that are exported dynamically (e.g.
+ *       linking with ```-rdynamic```). Frames that cannot be named are printed
+ *       as a module and offset, which can be resolved offline with
+ *       ```addr2line```.
+ */
+class StackTrace
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                              PUBLIC CONSTANTS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief The maximum number of frames that will be recorded.
+     */
+    static const std::size_t MAX_FRAMES = 32;
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTOR
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Constructs an empty StackTrace.
+     */
+    StackTrace();
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Records the call stack of the caller of this function, replacing
+     *        any frames previously recorded.
+     *
+     * \param skip The number of frames to omit from the top of the stack.
+     */
+    void capture(std::size_t skip = 0);
+
+    /*!
+     * \brief Removes all recorded frames.
+     */
+    void clear();
+
+    /*!
+     * \brief Returns whether this trace has no recorded frames.
+     */
+    bool empty() const;
+
+    /*!
+     * \brief Returns the number of recorded frames.
+     */
+    std::size_t get_size() const;
+
+    /*!
+     * \brief Returns the return address of the given frame, where frame 0 is
+     *        the innermost frame.
+     */
+    void* get_frame(std::size_t index) const;
+
+    /*!
+     * \brief Returns the recorded frames as symbolized text, with one line per
+     *        frame.
+     */
+    std::string to_string() const;
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    std::size_t m_size;
+    void* m_frames[MAX_FRAMES];
+};
+
+} // namespace ex
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
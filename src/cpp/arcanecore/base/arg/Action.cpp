@@ -127,20 +127,11 @@ bool Action::parse(
         bool& out_exit_program,
         int& out_exit_code)
 {
-    // TODO: which encoding to use for Windows? Is there a way to detect this?
-    deus::UnicodeView current(argv[argi], deus::Encoding::kUTF8);
+    std::size_t increment_extra = 0;
+    // TODO: parse sub actions and flags
 
-    // match?
-    if(current == m_key)
-    {
-        std::size_t increment_extra = 0;
-        // TODO: parse sub actions and flags
-
-        out_increment = 1 + increment_extra;
-        return true;
-    }
-    // not a match
-    return false;
+    out_increment = 1 + increment_extra;
+    return true;
 }
 
 } // namespace arg
@@ -42,6 +42,7 @@
 #include <deus/UnicodeView.hpp>
 
 #include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/lang/IntrusiveList.hpp"
 #include "arcanecore/base/lang/Restrictors.hpp"
 
 
@@ -183,6 +184,9 @@ private:
     //                             PRIVATE ATTRIBUTES
     //--------------------------------------------------------------------------
 
+    // links the action into its parser's list of actions
+    arc::lang::IntrusiveListHook m_parser_hook;
+
     deus::UnicodeStorage m_key;
     std::vector<deus::UnicodeStorage> m_variable_names;
     deus::UnicodeStorage m_description;
@@ -197,12 +201,12 @@ private:
     void set_parser_parent(const Parser* parser_parent);
 
     /*!
-     * \brief Parses whether the current command line argument matches this
-     *        action.
+     * \brief Parses this action once the current command line argument has
+     *        been resolved to it.
      *
-     * If the current argument matches this action's key, this call will
-     * continue to parse the sub actions and flags of this action. The action
-     * is then queued for execution once parsing has fully completed.
+     * This continues to parse the sub actions and flags of this action, after
+     * which the action is queued for execution once parsing has fully
+     * completed.
      *
      * \param argi The index of the current argument being parsed in argv.
      * \param argc The total number of arguments in argv.
@@ -214,7 +218,7 @@ private:
      * \param out_exit_code The exit code that will be used if the
      *                      out_exit_program parameter is ```true```.
      *
-     * \return Whether this action successfully matched the current argument.
+     * \return Whether parsing was successful.
      */
     bool parse(
             std::size_t argi,
@@ -32,10 +32,9 @@
  */
 #include "arcanecore/base/arg/DefaultHelpFlag.hpp"
 
-#include <iostream>
-
-#include "arcanecore/base/arg/Action.hpp"
 #include "arcanecore/base/arg/Parser.hpp"
+#include "arcanecore/base/io/FileDescriptorSink.hpp"
+#include "arcanecore/base/io/OutputSink.hpp"
 
 
 namespace arc
@@ -50,7 +49,7 @@ namespace arg
 
 DefaultHelpFlag::DefaultHelpFlag(const deus::UnicodeView& usage_text)
     : arc::arg::Flag("help", "h", "Displays this help text.")
-    , m_usage_text  (usage_text)
+    , m_renderer    (usage_text)
 {
 }
 
@@ -79,149 +78,13 @@ bool DefaultHelpFlag::parse_extra(
 
     // TODO: use ANSI -- need to learn to do this on Windows
 
-    // constants
-    static const std::size_t TAB_SIZE = 4;
-
-    // generate the divider string
-    deus::UnicodeStorage dash("-");
-    deus::UnicodeStorage divider = dash * 80;
-    std::cout << divider << std::endl;
-
-    deus::UnicodeStorage space(" ");
-    deus::UnicodeStorage tab = space * 4;
-
-    // print usage?
-    if(!m_usage_text.get_view().empty())
-    {
-        std::cout << "Usage:\n\n" << tab << m_usage_text << "\n" << std::endl;
-        std::cout << divider << std::endl;
-    }
-
-    // print actions?
-    const std::list<std::unique_ptr<arc::arg::Action>>& actions =
-        m_parser_parent->get_actions();
-    if(!actions.empty())
-    {
-        std::cout << "Actions:\n" << std::endl;
-
-        // build and find longest action key
-        std::vector<deus::UnicodeStorage> keys;
-        keys.reserve(actions.size());
-        std::size_t longest_key = 0;
-        for(const std::unique_ptr<arc::arg::Action>& action : actions)
-        {
-            deus::UnicodeStorage key = tab + action->get_key();
-            // add the variable names to the key
-            for(const deus::UnicodeStorage& var : action->get_variable_names())
-            {
-                key = key + " <" + var + ">";
-            }
-
-            keys.push_back(key);
-
-            if(key.get_view().length() > longest_key)
-            {
-                longest_key = key.get_view().length();
-            }
-        }
-        // find how far descriptions should be indented
-        std::size_t description_indent = (longest_key + 1) % TAB_SIZE;
-        description_indent = longest_key + (TAB_SIZE - description_indent);
-        // if there's not enough characters for the descriptions, surpass 80
-        // characters and add more
-        std::size_t max_chars = 80;
-        if((max_chars - description_indent) < 20)
-        {
-            max_chars = description_indent + 20;
-        }
-
-        // actually write actions
-        std::size_t offset = 0;
-        for(const std::unique_ptr<arc::arg::Action>& action : actions)
-        {
-            //  build the string for this action
-            // deus::UnicodeStorage s = keys[offset];s
-            deus::UnicodeStorage s = keys[offset];
-            deus::UnicodeStorage indent(" ");
-            indent =
-                indent *
-                static_cast<int32_t>(
-                    description_indent -
-                    s.get_view().length()
-                );
-            s = s + indent.get_view() + ":: " + action->get_description();
-            ++offset;
-
-            // TOOD: need to word wrap the description still
-            std::cout << s << "\n" << std::endl;
-        }
-        std::cout << divider << std::endl;
-    }
-
-    // print flags
-    const std::list<std::unique_ptr<arc::arg::Flag>>& flags =
-        m_parser_parent->get_flags();
-    if(!flags.empty())
-    {
-        std::cout << "Flags:\n" << std::endl;
-
-        // build and find longest flag key
-        std::vector<deus::UnicodeStorage> keys;
-        keys.reserve(flags.size());
-        std::size_t longest_key = 0;
-        for(const std::unique_ptr<arc::arg::Flag>& flag : flags)
-        {
-            deus::UnicodeStorage key = tab;
-            if(!flag->get_short_key().empty())
-            {
-                key = key + flag->get_short_key() + ", ";
-            }
-            key = key + flag->get_long_key();
-            // add the variable names to the key
-            for(const deus::UnicodeStorage& var : flag->get_variable_names())
-            {
-                key = key + " <" + var + ">";
-            }
-            keys.push_back(key);
-
-            if(key.get_view().length() > longest_key)
-            {
-                longest_key = key.get_view().length();
-            }
-        }
-        // find how far descriptions should be indented
-        std::size_t description_indent = (longest_key + 1) % TAB_SIZE;
-        description_indent = longest_key + (TAB_SIZE - description_indent);
-        // if there's not enough characters for the descriptions, surpass 80
-        // characters and add more
-        std::size_t max_chars = 80;
-        if((max_chars - description_indent) < 20)
-        {
-            max_chars = description_indent + 20;
-        }
-
-        // actually write flags
-        std::size_t offset = 0;
-        for(const std::unique_ptr<arc::arg::Flag>& flag : flags)
-        {
-            //  build the string for this action
-            deus::UnicodeStorage s = keys[offset];
-            deus::UnicodeStorage indent(" ");
-            indent =
-                indent *
-                static_cast<int32_t>(
-                    description_indent -
-                    s.get_view().length()
-                );
-            s = s + indent.get_view() + ":: " + flag->get_description();
-            ++offset;
-
-            // TOOD: need to word wrap the description still
-            std::cout << s << "\n" << std::endl;
-        }
-
-        std::cout << divider << std::endl;
-    }
+    arc::io::OutputSink& output = m_parser_parent->get_output();
+    arc::io::FileDescriptorSink::flush_standard_stream(output);
+    output.write(m_renderer.render(
+        *m_parser_parent,
+        arc::arg::HelpRenderer::get_terminal_width(output)
+    ));
+    output.flush();
 
     // exit successfully
     out_exit_code = 0;
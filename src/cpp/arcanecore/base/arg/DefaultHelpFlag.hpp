@@ -41,6 +41,7 @@
 
 #include "arcanecore/base/BaseAPI.hpp"
 #include "arcanecore/base/arg/Flag.hpp"
+#include "arcanecore/base/arg/HelpRenderer.hpp"
 #include "arcanecore/base/lang/Restrictors.hpp"
 
 
@@ -91,7 +92,8 @@ private:
     //                             PRIVATE ATTRIBUTES
     //--------------------------------------------------------------------------
 
-    const deus::UnicodeStorage m_usage_text;
+    // renders (and caches) the help text
+    arc::arg::HelpRenderer m_renderer;
 };
 
 } // namespace arg
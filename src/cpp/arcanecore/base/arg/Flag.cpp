@@ -54,6 +54,7 @@ Flag::Flag(
     , m_long_key     (long_key)
     , m_short_key    (short_key)
     , m_description  (description)
+    , m_concurrent   (false)
 {
     init_flags();
 }
@@ -67,6 +68,7 @@ Flag::Flag(
     , m_long_key      (long_key)
     , m_short_key     (short_key)
     , m_description   (description)
+    , m_concurrent    (false)
 {
     init_flags();
 
@@ -110,6 +112,41 @@ const deus::UnicodeView& Flag::get_description() const
     return m_description.get_view();
 }
 
+const std::vector<deus::UnicodeStorage>& Flag::get_dependencies() const
+{
+    return m_dependencies;
+}
+
+void Flag::add_dependency(const deus::UnicodeView& long_key)
+{
+    if(long_key.empty())
+    {
+        throw arc::ex::ValueError(
+            "Flag dependency cannot be declared with an empty long key."
+        );
+    }
+
+    // add prefix
+    if(!long_key.starts_with("--"))
+    {
+        m_dependencies.push_back("--" + long_key);
+    }
+    else
+    {
+        m_dependencies.push_back(long_key);
+    }
+}
+
+bool Flag::is_concurrent() const
+{
+    return m_concurrent;
+}
+
+void Flag::set_concurrent(bool concurrent)
+{
+    m_concurrent = concurrent;
+}
+
 bool Flag::parse_extra(
         std::size_t argi,
         std::size_t argc,
@@ -161,27 +198,18 @@ bool Flag::parse(
         bool& out_exit_program,
         int& out_exit_code)
 {
-    // TODO: which encoding to use for Windows? Is there a way to detect this?
-    deus::UnicodeView current(argv[argi], deus::Encoding::kUTF8);
-
-    // long key match?
-    if(current == m_long_key || current == m_short_key)
+    // perform any extra parsing
+    std::size_t increment_extra = 0;
+    if(!parse_extra(argi + 1, argc, argv, increment_extra, out_exit_code))
     {
-        // perform any extra parsing
-        std::size_t increment_extra = 0;
-        if(!parse_extra(argi + 1, argc, argv, increment_extra, out_exit_code))
-        {
-            // parsing failed
-            out_exit_program = true;
-            return true;
-        }
-
-        // parsing successful
-        out_increment = 1 + increment_extra;
-        return true;
+        // parsing failed
+        out_exit_program = true;
+        return false;
     }
-    // not a match
-    return false;
+
+    // parsing successful
+    out_increment = 1 + increment_extra;
+    return true;
 }
 
 } // namespace arg
@@ -42,6 +42,7 @@
 #include <deus/UnicodeView.hpp>
 
 #include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/lang/IntrusiveList.hpp"
 #include "arcanecore/base/lang/Restrictors.hpp"
 
 
@@ -66,6 +67,9 @@ class Parser;
  * version that is usually a single character and starts with '-'.
  */
 class Flag
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
 {
 private:
 
@@ -162,6 +166,46 @@ public:
      */
     const deus::UnicodeView& get_description() const;
 
+    /*!
+     * \brief Returns the long keys of the flags that must finish executing
+     *        before this flag is executed.
+     */
+    const std::vector<deus::UnicodeStorage>& get_dependencies() const;
+
+    /*!
+     * \brief Declares that this flag must not be executed until the flag with
+     *        the given long key has finished executing.
+     *
+     * Dependencies on flags that were not supplied on the command line are
+     * ignored.
+     *
+     * \param long_key The long key of the flag this flag depends on. Note: if
+     *                 the provided string does not begin with the `--` prefix
+     *                 it will be appended to the key.
+     *
+     * \throw arc::ex::ValueError If the long_key parameter is empty.
+     */
+    void add_dependency(const deus::UnicodeView& long_key);
+
+    /*!
+     * \brief Returns whether this flag may be executed concurrently with other
+     *        flags.
+     */
+    bool is_concurrent() const;
+
+    /*!
+     * \brief Sets whether this flag may be executed concurrently with other
+     *        flags.
+     *
+     * Concurrent flags may be executed on a worker thread of the parent Parser
+     * as soon as all of their dependencies have finished executing. Flags that
+     * are not concurrent (the default) are always executed one at a time on
+     * the thread that called arc::arg::Parser::execute(), in the order they
+     * were supplied on the command line except where declared dependencies
+     * (see add_dependency()) require otherwise.
+     */
+    void set_concurrent(bool concurrent);
+
     /*!
      * \brief Is called if this flag is matched in the command line arguments so
      *        that any addition parsing can be performed.
@@ -219,10 +263,15 @@ private:
     //                             PRIVATE ATTRIBUTES
     //--------------------------------------------------------------------------
 
+    // links the flag into its parser's list of flags
+    arc::lang::IntrusiveListHook m_parser_hook;
+
     deus::UnicodeStorage m_long_key;
     deus::UnicodeStorage m_short_key;
     std::vector<deus::UnicodeStorage> m_variable_names;
     deus::UnicodeStorage m_description;
+    std::vector<deus::UnicodeStorage> m_dependencies;
+    bool m_concurrent;
 
     //--------------------------------------------------------------------------
     //                          PRIVATE MEMBER FUNCTIONS
@@ -240,12 +289,11 @@ private:
     void set_parser_parent(const Parser* parser_parent);
 
     /*!
-     * \brief Parses whether the current command line argument matches this
-     *        flag.
+     * \brief Parses this flag once the current command line argument has been
+     *        resolved to it.
      *
-     * If the current argument matches this flag's key, this call will also
-     * perform any required extra parsing if a match was made. The flag is then
-     * queued for execution once parsing has fully completed.
+     * This performs any required extra parsing, after which the flag is queued
+     * for execution once parsing has fully completed.
      *
      * \param argi The index of the current argument being parsed in argv.
      * \param argc The total number of arguments in argv.
@@ -257,7 +305,7 @@ private:
      * \param out_exit_code The exit code that will be used if the
      *                      out_exit_program parameter is ```true```.
      *
-     * \return Whether this flag successfully matched the current argument.
+     * \return Whether parsing was successful.
      */
     bool parse(
             std::size_t argi,
@@ -0,0 +1,429 @@
+/*!
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "arcanecore/base/arg/HelpRenderer.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "arcanecore/base/Preproc.hpp"
+#include "arcanecore/base/arg/Action.hpp"
+#include "arcanecore/base/arg/Flag.hpp"
+#include "arcanecore/base/arg/Parser.hpp"
+#include "arcanecore/base/io/FileDescriptorSink.hpp"
+
+#ifdef ARC_OS_WINDOWS
+    #include <io.h>
+    #include <windows.h>
+#else
+    #include <sys/ioctl.h>
+    #include <unistd.h>
+#endif
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace arg
+{
+
+namespace
+{
+
+//------------------------------------------------------------------------------
+//                                   CONSTANTS
+//------------------------------------------------------------------------------
+
+static const std::size_t TAB_SIZE = 4;
+static const std::size_t DEFAULT_WIDTH = 80;
+static const std::size_t MIN_DESCRIPTION_WIDTH = 20;
+static const char DESCRIPTION_SEPARATOR[] = ":: ";
+static const std::size_t DESCRIPTION_SEPARATOR_WIDTH =
+    sizeof(DESCRIPTION_SEPARATOR) - 1;
+
+//------------------------------------------------------------------------------
+//                                     ROW
+//------------------------------------------------------------------------------
+
+/*
+ * A single action or flag within a section of the help text.
+ */
+struct Row
+{
+    // the indented key and variable names
+    std::string key;
+    // the width of the key in columns
+    std::size_t key_width;
+    // the description
+    std::string description;
+};
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+// appends the UTF-8 representation of the given string to the output
+void append_utf8(std::string& out, const deus::UnicodeView& s)
+{
+    deus::UnicodeStorage converted;
+    const deus::UnicodeView& utf8 = s.convert_if_not(
+        deus::ASCII_COMPATIBLE_ENCODINGS,
+        deus::Encoding::kUTF8,
+        converted
+    );
+    out.append(utf8.c_str(), std::strlen(utf8.c_str()));
+}
+
+// returns the number of columns the given UTF-8 string occupies
+std::size_t get_width(const char* s, std::size_t length)
+{
+    std::size_t width = 0;
+    for(std::size_t i = 0; i < length; ++i)
+    {
+        // don't count continuation bytes
+        if((static_cast<unsigned char>(s[i]) & 0xC0) != 0x80)
+        {
+            ++width;
+        }
+    }
+    return width;
+}
+
+// appends the variable names to a row's key
+void append_variable_names(
+        Row& row,
+        const std::vector<deus::UnicodeStorage>& variable_names)
+{
+    for(const deus::UnicodeStorage& var : variable_names)
+    {
+        row.key += " <";
+        append_utf8(row.key, var);
+        row.key += ">";
+    }
+}
+
+// returns the column descriptions in the given rows should begin at
+std::size_t get_description_column(const std::vector<Row>& rows)
+{
+    std::size_t longest_key = 0;
+    for(const Row& row : rows)
+    {
+        if(row.key_width > longest_key)
+        {
+            longest_key = row.key_width;
+        }
+    }
+    // align the separator to the next tab stop
+    std::size_t indent =
+        longest_key + (TAB_SIZE - ((longest_key + 1) % TAB_SIZE));
+    return indent + DESCRIPTION_SEPARATOR_WIDTH;
+}
+
+// appends the given text word wrapped to the given number of columns, where
+// every line but the first is indented by the given number of columns
+void append_wrapped(
+        std::string& out,
+        const std::string& text,
+        std::size_t indent,
+        std::size_t columns)
+{
+    std::size_t line_width = 0;
+    std::size_t i = 0;
+    while(i < text.size())
+    {
+        // explicit line break
+        if(text[i] == '\n')
+        {
+            out += '\n';
+            out.append(indent, ' ');
+            line_width = 0;
+            ++i;
+            continue;
+        }
+        if(text[i] == ' ')
+        {
+            ++i;
+            continue;
+        }
+
+        // find the extent of the next word
+        std::size_t end = i;
+        while(end < text.size() && text[end] != ' ' && text[end] != '\n')
+        {
+            ++end;
+        }
+        std::size_t word_width = get_width(&text[i], end - i);
+
+        if(line_width != 0)
+        {
+            if(line_width + 1 + word_width > columns)
+            {
+                out += '\n';
+                out.append(indent, ' ');
+                line_width = 0;
+            }
+            else
+            {
+                out += ' ';
+                ++line_width;
+            }
+        }
+        out.append(text, i, end - i);
+        line_width += word_width;
+        i = end;
+    }
+}
+
+// appends a section of the help text
+void append_section(
+        std::string& out,
+        const char* title,
+        const std::vector<Row>& rows,
+        std::size_t width,
+        const std::string& divider)
+{
+    std::size_t description_column = get_description_column(rows);
+    std::size_t description_width = MIN_DESCRIPTION_WIDTH;
+    if(width > description_column + MIN_DESCRIPTION_WIDTH)
+    {
+        description_width = width - description_column;
+    }
+
+    out += title;
+    out += ":\n\n";
+    for(const Row& row : rows)
+    {
+        out += row.key;
+        out.append(
+            description_column - DESCRIPTION_SEPARATOR_WIDTH - row.key_width,
+            ' '
+        );
+        out += DESCRIPTION_SEPARATOR;
+        append_wrapped(
+            out,
+            row.description,
+            description_column,
+            description_width
+        );
+        out += "\n\n";
+    }
+    out += divider;
+}
+
+// returns an estimate of the number of bytes a section will be rendered to
+std::size_t estimate_section(const std::vector<Row>& rows, std::size_t width)
+{
+    std::size_t size = width + 16;
+    std::size_t description_column = get_description_column(rows);
+    for(const Row& row : rows)
+    {
+        // allow for a line break and indentation every 20 columns
+        std::size_t lines = 1 + row.description.size() / MIN_DESCRIPTION_WIDTH;
+        size += row.key.size() + description_column + 2 +
+                row.description.size() + lines * (description_column + 1);
+    }
+    return size;
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                  CONSTRUCTOR
+//------------------------------------------------------------------------------
+
+HelpRenderer::HelpRenderer(const deus::UnicodeView& usage_text)
+    : m_parser  (nullptr)
+    , m_revision(0)
+    , m_width   (0)
+{
+    append_utf8(m_usage_text, usage_text);
+}
+
+//------------------------------------------------------------------------------
+//                                   DESTRUCTOR
+//------------------------------------------------------------------------------
+
+HelpRenderer::~HelpRenderer()
+{
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC STATIC FUNCTIONS
+//------------------------------------------------------------------------------
+
+std::size_t HelpRenderer::get_terminal_width(int fd)
+{
+#ifdef ARC_OS_WINDOWS
+    const HANDLE handle =
+        fd >= 0 ? reinterpret_cast<HANDLE>(_get_osfhandle(fd))
+                : INVALID_HANDLE_VALUE;
+    CONSOLE_SCREEN_BUFFER_INFO info;
+    if(handle != INVALID_HANDLE_VALUE &&
+       GetConsoleScreenBufferInfo(handle, &info))
+    {
+        return static_cast<std::size_t>(
+            info.srWindow.Right - info.srWindow.Left + 1
+        );
+    }
+#else
+    struct winsize size;
+    if(fd >= 0 && ioctl(fd, TIOCGWINSZ, &size) == 0 && size.ws_col > 0)
+    {
+        return static_cast<std::size_t>(size.ws_col);
+    }
+#endif
+
+    // fallback to the environment
+    const char* columns = std::getenv("COLUMNS");
+    if(columns != nullptr)
+    {
+        long value = std::strtol(columns, nullptr, 10);
+        if(value > 0)
+        {
+            return static_cast<std::size_t>(value);
+        }
+    }
+    return DEFAULT_WIDTH;
+}
+
+std::size_t HelpRenderer::get_terminal_width(const arc::io::OutputSink& sink)
+{
+    const arc::io::FileDescriptorSink* fd_sink =
+        dynamic_cast<const arc::io::FileDescriptorSink*>(&sink);
+    return get_terminal_width(fd_sink != nullptr ? fd_sink->get_fd() : -1);
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+const std::string& HelpRenderer::render(const Parser& parser, std::size_t width)
+{
+    if(width == 0)
+    {
+        width = DEFAULT_WIDTH;
+    }
+
+    // cached?
+    if(m_parser == &parser &&
+       m_revision == parser.get_revision() &&
+       m_width == width)
+    {
+        return m_text;
+    }
+
+    // build the rows and measure them
+    std::vector<Row> action_rows;
+    action_rows.reserve(parser.get_actions().size());
+    for(const arc::arg::Action& action : parser.get_actions())
+    {
+        Row row;
+        row.key.append(TAB_SIZE, ' ');
+        append_utf8(row.key, action.get_key());
+        append_variable_names(row, action.get_variable_names());
+        row.key_width = get_width(row.key.data(), row.key.size());
+        append_utf8(row.description, action.get_description());
+        action_rows.push_back(std::move(row));
+    }
+
+    std::vector<Row> flag_rows;
+    flag_rows.reserve(parser.get_flags().size());
+    for(const arc::arg::Flag& flag : parser.get_flags())
+    {
+        Row row;
+        row.key.append(TAB_SIZE, ' ');
+        if(!flag.get_short_key().empty())
+        {
+            append_utf8(row.key, flag.get_short_key());
+            row.key += ", ";
+        }
+        append_utf8(row.key, flag.get_long_key());
+        append_variable_names(row, flag.get_variable_names());
+        row.key_width = get_width(row.key.data(), row.key.size());
+        append_utf8(row.description, flag.get_description());
+        flag_rows.push_back(std::move(row));
+    }
+
+    std::string divider(width, '-');
+    divider += '\n';
+
+    // preallocate the text
+    std::size_t size = divider.size();
+    if(!m_usage_text.empty())
+    {
+        size += 16 + m_usage_text.size() + divider.size();
+    }
+    if(!action_rows.empty())
+    {
+        size += estimate_section(action_rows, width);
+    }
+    if(!flag_rows.empty())
+    {
+        size += estimate_section(flag_rows, width);
+    }
+    m_text.clear();
+    m_text.reserve(size);
+
+    // render
+    m_text += divider;
+    if(!m_usage_text.empty())
+    {
+        m_text += "Usage:\n\n";
+        m_text.append(TAB_SIZE, ' ');
+        append_wrapped(
+            m_text,
+            m_usage_text,
+            TAB_SIZE,
+            width > TAB_SIZE ? width - TAB_SIZE : 1
+        );
+        m_text += "\n\n";
+        m_text += divider;
+    }
+    if(!action_rows.empty())
+    {
+        append_section(m_text, "Actions", action_rows, width, divider);
+    }
+    if(!flag_rows.empty())
+    {
+        append_section(m_text, "Flags", flag_rows, width, divider);
+    }
+
+    m_parser = &parser;
+    m_revision = parser.get_revision();
+    m_width = width;
+    return m_text;
+}
+
+} // namespace arg
+ARC_BASE_VERSION_NS_END
+} // namespace arc
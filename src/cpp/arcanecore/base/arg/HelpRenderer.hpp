@@ -0,0 +1,158 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Renders the help text of a Parser.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_ARG_HELPRENDERER_HPP_
+#define ARCANECORE_BASE_ARG_HELPRENDERER_HPP_
+
+#include <cstddef>
+#include <string>
+
+#include <deus/UnicodeStorage.hpp>
+#include <deus/UnicodeView.hpp>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/io/OutputSink.hpp"
+#include "arcanecore/base/lang/Restrictors.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace arg
+{
+
+//------------------------------------------------------------------------------
+//                              FORWARD DECLARATIONS
+//------------------------------------------------------------------------------
+
+class Parser;
+
+
+/*!
+ * \brief Renders the usage, actions and flags of a Parser as help text.
+ *
+ * The text is laid out in a single pass over the Parser's definitions and
+ * written into one preallocated UTF-8 buffer, with descriptions word wrapped
+ * to the requested width. The rendered text is cached, and is only rendered
+ * again if the Parser's definitions or the requested width change.
+ *
+ * \note This object is not thread safe.
+ */
+class HelpRenderer
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTOR
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Constructs a new HelpRenderer.
+     *
+     * \param usage_text Simple example of usage of the command line tool. If
+     *                   an empty string is used the help will not contain a
+     *                   usage section.
+     */
+    HelpRenderer(const deus::UnicodeView& usage_text);
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    ~HelpRenderer();
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC STATIC FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns the width (in columns) of the terminal the given file
+     *        descriptor refers to.
+     *
+     * If the file descriptor is not a terminal this falls back to the
+     * ```COLUMNS``` environment variable, and then to 80 columns.
+     */
+    static std::size_t get_terminal_width(int fd);
+
+    /*!
+     * \brief Returns the width (in columns) of the terminal the given sink
+     *        writes to.
+     *
+     * Sinks other than arc::io::FileDescriptorSink are not terminals, so for
+     * these this falls back to the ```COLUMNS``` environment variable, and
+     * then to 80 columns.
+     */
+    static std::size_t get_terminal_width(const arc::io::OutputSink& sink);
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns the help text for the given parser as a UTF-8 string.
+     *
+     * \param parser The parser to render the help text of.
+     * \param width The number of columns to word wrap the help text to. Note
+     *              that if this leaves less than 20 columns for descriptions
+     *              the text will exceed this width.
+     */
+    const std::string& render(const Parser& parser, std::size_t width);
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    // the usage text converted to UTF-8
+    std::string m_usage_text;
+
+    // the parser, parser revision, and width the cached text was rendered for
+    const Parser* m_parser;
+    std::size_t m_revision;
+    std::size_t m_width;
+    // the cached text
+    std::string m_text;
+};
+
+} // namespace arg
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
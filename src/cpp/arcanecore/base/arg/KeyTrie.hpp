@@ -0,0 +1,437 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Compact prefix tree used to resolve command line keys.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_ARG_KEYTRIE_HPP_
+#define ARCANECORE_BASE_ARG_KEYTRIE_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "arcanecore/base/BaseAPI.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace arg
+{
+
+/*!
+ * \brief The result of resolving a key with a arc::arg::KeyTrie.
+ */
+enum class KeyMatch
+{
+    /// No registered key begins with the given key.
+    kNone,
+    /// The given key is exactly a registered key.
+    kExact,
+    /// The given key is an unambiguous prefix of a single registered key.
+    kPrefix,
+    /// The given key is a prefix of multiple registered keys.
+    kAmbiguous
+};
+
+/*!
+ * \brief Prefix tree over a set of keys (byte strings) that each map to a
+ *        value.
+ *
+ * Nodes are stored contiguously as a left-child right-sibling tree, with each
+ * node recording how many keys pass through it. This means resolving a key,
+ * or an unambiguous abbreviation of a key, is linear in the length of the key
+ * rather than the number of keys. Keys within a bounded edit distance of a
+ * string can be found by walking the tree while simulating a Levenshtein
+ * automaton, which prunes any branch that can no longer be within the bound.
+ */
+template<typename T>
+class KeyTrie
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTOR
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Constructs a new empty KeyTrie.
+     */
+    KeyTrie()
+    {
+        // root node
+        m_nodes.push_back(Node(0));
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns the number of keys in this trie.
+     */
+    std::size_t size() const
+    {
+        return m_values.size();
+    }
+
+    /*!
+     * \brief Inserts a key into this trie.
+     *
+     * \return Whether the key was inserted, if ```false``` the key already
+     *         exists in the trie and its value is not modified, or the key is
+     *         empty.
+     */
+    bool insert(const char* key, std::size_t length, const T& value)
+    {
+        // the empty key would be the root, which every key passes through
+        if(length == 0)
+        {
+            return false;
+        }
+
+        // check for an existing key first so that counts are not modified
+        T existing;
+        if(find(key, length, existing) == KeyMatch::kExact)
+        {
+            return false;
+        }
+
+        const uint32_t value_index = static_cast<uint32_t>(m_values.size());
+        m_values.push_back(value);
+
+        uint32_t node = 0;
+        for(std::size_t i = 0; i <= length; ++i)
+        {
+            Node& n = m_nodes[node];
+            if(n.count == 0)
+            {
+                n.any_value = value_index;
+            }
+            ++n.count;
+
+            if(i == length)
+            {
+                m_nodes[node].value = value_index;
+                break;
+            }
+            node = get_or_create_child(node, key[i]);
+        }
+        return true;
+    }
+
+    /*!
+     * \brief Resolves the given key, or an abbreviation of a key.
+     *
+     * \param key The key to resolve.
+     * \param length The length of the key in bytes.
+     * \param out_value Returns the value of the matched key if the result is
+     *                  arc::arg::KeyMatch::kExact or
+     *                  arc::arg::KeyMatch::kPrefix.
+     *
+     * \note An empty key never matches, rather than being treated as a prefix
+     *       of every key.
+     */
+    KeyMatch find(const char* key, std::size_t length, T& out_value) const
+    {
+        if(length == 0)
+        {
+            return KeyMatch::kNone;
+        }
+
+        uint32_t node = find_node(key, length);
+        if(node == NONE)
+        {
+            return KeyMatch::kNone;
+        }
+
+        const Node& n = m_nodes[node];
+        if(n.value != NONE)
+        {
+            out_value = m_values[n.value];
+            return KeyMatch::kExact;
+        }
+        if(n.count == 1)
+        {
+            out_value = m_values[n.any_value];
+            return KeyMatch::kPrefix;
+        }
+        return KeyMatch::kAmbiguous;
+    }
+
+    /*!
+     * \brief Returns all of the keys that begin with the given prefix, in
+     *        lexicographical order.
+     */
+    std::vector<std::string> get_completions(
+            const char* prefix,
+            std::size_t length) const
+    {
+        std::vector<std::string> ret;
+        uint32_t node = find_node(prefix, length);
+        if(node != NONE)
+        {
+            std::string path(prefix, length);
+            collect(node, path, ret);
+        }
+        return ret;
+    }
+
+    /*!
+     * \brief Returns the keys that are within the given Levenshtein distance
+     *        of the given string.
+     *
+     * The results are ordered by distance, and then lexicographically.
+     *
+     * \param s The string to find similar keys to.
+     * \param length The length of s in bytes.
+     * \param max_distance The maximum number of single byte insertions,
+     *                     deletions, or substitutions a key may differ by.
+     */
+    std::vector<std::string> get_suggestions(
+            const char* s,
+            std::size_t length,
+            std::size_t max_distance) const
+    {
+        std::vector<std::pair<std::size_t, std::string>> found;
+
+        // the automaton state is the last row of the edit distance matrix
+        std::vector<std::size_t> row(length + 1);
+        for(std::size_t i = 0; i <= length; ++i)
+        {
+            row[i] = i;
+        }
+
+        std::string path;
+        for(uint32_t child = m_nodes[0].first_child;
+            child != NONE;
+            child = m_nodes[child].next_sibling)
+        {
+            walk(child, s, length, max_distance, row, path, found);
+        }
+
+        std::sort(found.begin(), found.end());
+        std::vector<std::string> ret;
+        ret.reserve(found.size());
+        for(std::pair<std::size_t, std::string>& f : found)
+        {
+            ret.push_back(std::move(f.second));
+        }
+        return ret;
+    }
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE CONSTANTS
+    //--------------------------------------------------------------------------
+
+    static const uint32_t NONE = 0xFFFFFFFFU;
+
+    //--------------------------------------------------------------------------
+    //                               PRIVATE TYPES
+    //--------------------------------------------------------------------------
+
+    struct Node
+    {
+        // the byte this node is reached by from its parent
+        char label;
+        // the first child of this node (children are ordered by label)
+        uint32_t first_child;
+        // the next child of this node's parent
+        uint32_t next_sibling;
+        // the number of keys that pass through (or end at) this node
+        uint32_t count;
+        // the index of the value of the key that ends at this node
+        uint32_t value;
+        // the index of the value of any key that passes through this node,
+        // when count is 1 this is the only key
+        uint32_t any_value;
+
+        explicit Node(char label_)
+            : label       (label_)
+            , first_child (NONE)
+            , next_sibling(NONE)
+            , count       (0)
+            , value       (NONE)
+            , any_value   (NONE)
+        {
+        }
+    };
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    std::vector<Node> m_nodes;
+    std::vector<T> m_values;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    // returns the child of the given node with the given label, or NONE
+    uint32_t find_child(uint32_t node, char label) const
+    {
+        for(uint32_t child = m_nodes[node].first_child;
+            child != NONE;
+            child = m_nodes[child].next_sibling)
+        {
+            if(m_nodes[child].label == label)
+            {
+                return child;
+            }
+            if(m_nodes[child].label > label)
+            {
+                break;
+            }
+        }
+        return NONE;
+    }
+
+    // returns the child of the given node with the given label, inserting it
+    // in order if it does not exist
+    uint32_t get_or_create_child(uint32_t node, char label)
+    {
+        uint32_t previous = NONE;
+        uint32_t child = m_nodes[node].first_child;
+        while(child != NONE && m_nodes[child].label < label)
+        {
+            previous = child;
+            child = m_nodes[child].next_sibling;
+        }
+        if(child != NONE && m_nodes[child].label == label)
+        {
+            return child;
+        }
+
+        const uint32_t created = static_cast<uint32_t>(m_nodes.size());
+        m_nodes.push_back(Node(label));
+        m_nodes[created].next_sibling = child;
+        if(previous == NONE)
+        {
+            m_nodes[node].first_child = created;
+        }
+        else
+        {
+            m_nodes[previous].next_sibling = created;
+        }
+        return created;
+    }
+
+    // returns the node the given key ends at, or NONE
+    uint32_t find_node(const char* key, std::size_t length) const
+    {
+        uint32_t node = 0;
+        for(std::size_t i = 0; i < length && node != NONE; ++i)
+        {
+            node = find_child(node, key[i]);
+        }
+        return node;
+    }
+
+    // collects all keys that pass through the given node
+    void collect(
+            uint32_t node,
+            std::string& path,
+            std::vector<std::string>& out) const
+    {
+        if(m_nodes[node].value != NONE)
+        {
+            out.push_back(path);
+        }
+        for(uint32_t child = m_nodes[node].first_child;
+            child != NONE;
+            child = m_nodes[child].next_sibling)
+        {
+            path.push_back(m_nodes[child].label);
+            collect(child, path, out);
+            path.pop_back();
+        }
+    }
+
+    // advances the Levenshtein automaton by the given node's label
+    void walk(
+            uint32_t node,
+            const char* s,
+            std::size_t length,
+            std::size_t max_distance,
+            const std::vector<std::size_t>& previous_row,
+            std::string& path,
+            std::vector<std::pair<std::size_t, std::string>>& out) const
+    {
+        const char label = m_nodes[node].label;
+
+        std::vector<std::size_t> row(length + 1);
+        row[0] = previous_row[0] + 1;
+        std::size_t row_min = row[0];
+        for(std::size_t i = 1; i <= length; ++i)
+        {
+            std::size_t insert_cost = row[i - 1] + 1;
+            std::size_t delete_cost = previous_row[i] + 1;
+            std::size_t replace_cost =
+                previous_row[i - 1] + (s[i - 1] == label ? 0 : 1);
+            row[i] = std::min(std::min(insert_cost, delete_cost), replace_cost);
+            row_min = std::min(row_min, row[i]);
+        }
+
+        // no key below this node can be within the distance
+        if(row_min > max_distance)
+        {
+            return;
+        }
+
+        path.push_back(label);
+        if(m_nodes[node].value != NONE && row[length] <= max_distance)
+        {
+            out.push_back(std::make_pair(row[length], path));
+        }
+        for(uint32_t child = m_nodes[node].first_child;
+            child != NONE;
+            child = m_nodes[child].next_sibling)
+        {
+            walk(child, s, length, max_distance, row, path, out);
+        }
+        path.pop_back();
+    }
+};
+
+} // namespace arg
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
@@ -32,11 +32,21 @@
  */
 #include "arcanecore/base/arg/Parser.hpp"
 
-#include <iostream>
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
 
 #include "arcanecore/base/Exceptions.hpp"
 #include "arcanecore/base/arg/Action.hpp"
 #include "arcanecore/base/arg/Flag.hpp"
+#include "arcanecore/base/io/FileDescriptorSink.hpp"
+#include "arcanecore/base/lang/StringBuilder.hpp"
 
 
 namespace arc
@@ -45,6 +55,261 @@ ARC_BASE_VERSION_NS_BEGIN
 namespace arg
 {
 
+namespace
+{
+
+//------------------------------------------------------------------------------
+//                                   CONSTANTS
+//------------------------------------------------------------------------------
+
+// the maximum number of similar keys that will be suggested for an
+// unrecognised argument
+static const std::size_t MAX_SUGGESTIONS = 3;
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+// returns the UTF-8 representation of the given string
+std::string to_utf8(const deus::UnicodeView& s)
+{
+    deus::UnicodeStorage converted;
+    const deus::UnicodeView& utf8 = s.convert_if_not(
+        deus::ASCII_COMPATIBLE_ENCODINGS,
+        deus::Encoding::kUTF8,
+        converted
+    );
+    return std::string(utf8.c_str());
+}
+
+// converts the given key to UTF-8 and finds or interns its atom without
+// throwing, returns an error if the key cannot be converted or is new to a
+// frozen global atom table
+arc::Result<void> try_intern_key(
+        const deus::UnicodeView& key,
+        std::string& out_utf8,
+        arc::lang::Atom& out_atom)
+{
+    try
+    {
+        out_utf8 = to_utf8(key);
+    }
+    catch(...)
+    {
+        return arc::ex::Error(
+            arc::ex::ErrorCode::kValueError,
+            "Command line key could not be converted to UTF-8."
+        );
+    }
+
+    if(arc::lang::Atom::find(out_utf8.data(), out_utf8.length(), out_atom))
+    {
+        return arc::Result<void>();
+    }
+    if(arc::lang::AtomTable::get_global().is_frozen())
+    {
+        return arc::ex::Error(
+            arc::ex::ErrorCode::kStateError,
+            "Command line key cannot be interned since the global atom table "
+            "is frozen."
+        );
+    }
+    out_atom = arc::lang::Atom(out_utf8);
+    return arc::Result<void>();
+}
+
+// writes the given keys as a quoted, comma separated list
+void write_keys(
+        arc::lang::StringBuilder& message,
+        const std::vector<std::string>& keys)
+{
+    for(std::size_t i = 0; i < keys.size(); ++i)
+    {
+        if(i != 0)
+        {
+            message << ", ";
+        }
+        message << "\'" << keys[i] << "\'";
+    }
+}
+
+// writes the given message as a line to the given sink, and flushes it so the
+// message is seen immediately
+void write_line(arc::io::OutputSink& sink, arc::lang::StringBuilder& message)
+{
+    message << '\n';
+    arc::io::FileDescriptorSink::flush_standard_stream(sink);
+    sink.write(message);
+    sink.flush();
+}
+
+//------------------------------------------------------------------------------
+//                                   FLAG NODE
+//------------------------------------------------------------------------------
+
+/*
+ * A flag that has been queued for execution, as a node in the dependency graph
+ * of the flags to execute.
+ */
+struct FlagNode
+{
+    // the flag to execute
+    arc::arg::Flag* flag;
+    // the position of this node in the serial execution order
+    std::size_t rank;
+    // the number of dependencies which have not finished executing
+    std::size_t pending;
+    // the indices of the nodes that depend on this node
+    arc::lang::SmallVector<std::size_t, 4> dependents;
+    // the result of executing the flag
+    bool success;
+    int exit_code;
+    std::exception_ptr exception;
+};
+
+//------------------------------------------------------------------------------
+//                                 FLAG SCHEDULER
+//------------------------------------------------------------------------------
+
+/*
+ * Executes a flag dependency graph on the calling thread plus a number of
+ * worker threads. Concurrent flags can be executed by any thread, whereas
+ * other flags are only executed by the calling thread.
+ *
+ * Once a flag fails, only flags which come before it in the serial execution
+ * order continue to be started, so that the first failure in serial order is
+ * always the failure that would have been reported had the flags been executed
+ * serially.
+ */
+class FlagScheduler
+{
+public:
+
+    FlagScheduler(
+            std::vector<FlagNode>& nodes,
+            const std::vector<std::size_t>& order)
+        : m_nodes      (nodes)
+        , m_order      (order)
+        , m_running    (0)
+        , m_failed_rank(order.size())
+    {
+        for(std::size_t rank = 0; rank < m_order.size(); ++rank)
+        {
+            if(m_nodes[m_order[rank]].pending == 0)
+            {
+                m_ready.insert(rank);
+            }
+        }
+    }
+
+    void run(std::size_t worker_count)
+    {
+        std::vector<std::thread> workers;
+        workers.reserve(worker_count);
+        for(std::size_t i = 0; i < worker_count; ++i)
+        {
+            workers.emplace_back(&FlagScheduler::work, this, false);
+        }
+
+        work(true);
+
+        for(std::thread& worker : workers)
+        {
+            worker.join();
+        }
+    }
+
+private:
+
+    std::vector<FlagNode>& m_nodes;
+    const std::vector<std::size_t>& m_order;
+
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    // the ranks of the nodes whose dependencies have all been executed
+    std::set<std::size_t> m_ready;
+    // the number of nodes currently being executed
+    std::size_t m_running;
+    // the lowest rank of the nodes that have failed
+    std::size_t m_failed_rank;
+
+    void work(bool calling_thread)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while(true)
+        {
+            std::size_t index = 0;
+            if(take(calling_thread, index))
+            {
+                ++m_running;
+                lock.unlock();
+
+                FlagNode& node = m_nodes[index];
+                try
+                {
+                    node.success = node.flag->execute(node.exit_code);
+                }
+                catch(...)
+                {
+                    node.success = false;
+                    node.exception = std::current_exception();
+                }
+
+                lock.lock();
+                --m_running;
+                if(node.success)
+                {
+                    for(std::size_t dependent : node.dependents)
+                    {
+                        if(--m_nodes[dependent].pending == 0)
+                        {
+                            m_ready.insert(m_nodes[dependent].rank);
+                        }
+                    }
+                }
+                else
+                {
+                    m_failed_rank = std::min(m_failed_rank, node.rank);
+                }
+                m_condition.notify_all();
+                continue;
+            }
+
+            // finished?
+            if(m_running == 0 &&
+               (m_ready.empty() || *m_ready.begin() >= m_failed_rank))
+            {
+                return;
+            }
+            m_condition.wait(lock);
+        }
+    }
+
+    // finds the next node the current thread should execute (if any), must be
+    // called while holding the lock
+    bool take(bool calling_thread, std::size_t& out_index)
+    {
+        for(auto it = m_ready.begin(); it != m_ready.end(); ++it)
+        {
+            if(*it >= m_failed_rank)
+            {
+                return false;
+            }
+
+            std::size_t index = m_order[*it];
+            if(calling_thread || m_nodes[index].flag->is_concurrent())
+            {
+                m_ready.erase(it);
+                out_index = index;
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+} // namespace anonymous
+
 //------------------------------------------------------------------------------
 //                                  CONSTRUCTOR
 //------------------------------------------------------------------------------
@@ -52,8 +317,16 @@ namespace arg
 Parser::Parser(int error_exit_code)
     : m_executing      (false)
     , m_error_exit_code(error_exit_code)
+    , m_revision       (0)
     , m_action_execute (nullptr)
+    , m_max_threads    (std::thread::hardware_concurrency())
+    , m_output         (&arc::io::FileDescriptorSink::get_stdout())
+    , m_error_output   (&arc::io::FileDescriptorSink::get_stderr())
 {
+    if(m_max_threads == 0)
+    {
+        m_max_threads = 1;
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -62,6 +335,8 @@ Parser::Parser(int error_exit_code)
 
 Parser::~Parser()
 {
+    m_actions.clear_and_dispose(std::default_delete<arc::arg::Action>());
+    m_flags.clear_and_dispose(std::default_delete<arc::arg::Flag>());
 }
 
 //------------------------------------------------------------------------------
@@ -76,16 +351,44 @@ int Parser::execute(int argc, char** argv)
     std::size_t i = 1;
     while(i < static_cast<std::size_t>(argc))
     {
+        // TODO: which encoding to use for Windows? Is there a way to detect
+        //       this?
+        const char* current = argv[i];
+        const std::size_t length = std::strlen(current);
+        // only long flag keys and action keys may be abbreviated
+        const bool is_long_key =
+            length > 2 && current[0] == '-' && current[1] == '-';
+        const bool is_action_key = current[0] != '-';
+        // arguments which have not been interned can't be an exact key, and
+        // aren't interned here so the table isn't grown by arbitrary input
+        arc::lang::Atom key;
+
         // parse actions on the first iteration
+        KeyMatch action_match = KeyMatch::kNone;
         if(i == 1)
         {
-            bool matched = false;
-            for(std::unique_ptr<arc::arg::Action>& action : m_actions)
+            arc::arg::Action* action = nullptr;
+            auto exact = m_action_index.end();
+            if(arc::lang::Atom::find(current, length, key))
+            {
+                exact = m_action_index.find(key);
+            }
+            if(exact != m_action_index.end())
+            {
+                action = exact->second;
+                action_match = KeyMatch::kExact;
+            }
+            else
+            {
+                action_match = m_action_keys.find(current, length, action);
+            }
+            if(action_match == KeyMatch::kExact ||
+               (action_match == KeyMatch::kPrefix && is_action_key))
             {
                 std::size_t increment = 1;
                 bool exit_program = false;
                 int return_code = 0;
-                matched = action->parse(
+                action->parse(
                     i,
                     argc,
                     argv,
@@ -93,35 +396,42 @@ int Parser::execute(int argc, char** argv)
                     exit_program,
                     return_code
                 );
-                if(matched)
+                // exit?
+                if(exit_program)
                 {
-                    // exit?
-                    if(exit_program)
-                    {
-                        return return_code;
-                    }
-
-                    // queue for execution and increment
-                    m_action_execute = action.get();
-                    i += increment;
-                    break;
+                    return return_code;
                 }
-            }
 
-            if(matched)
-            {
+                // queue for execution and increment
+                m_action_execute = action;
+                i += increment;
                 continue;
             }
         }
 
         // parse flags
-        bool matched = false;
-        for(std::unique_ptr<arc::arg::Flag>& flag : m_flags)
+        arc::arg::Flag* flag = nullptr;
+        KeyMatch flag_match = KeyMatch::kExact;
+        auto exact = m_flag_index.end();
+        if(arc::lang::Atom::find(current, length, key))
+        {
+            exact = m_flag_index.find(key);
+        }
+        if(exact != m_flag_index.end())
+        {
+            flag = exact->second;
+        }
+        else
+        {
+            flag_match = m_flag_keys.find(current, length, flag);
+        }
+        if(flag_match == KeyMatch::kExact ||
+           (flag_match == KeyMatch::kPrefix && is_long_key))
         {
             std::size_t increment = 1;
             bool exit_program = false;
             int return_code = 0;
-            matched = flag->parse(
+            flag->parse(
                 i,
                 argc,
                 argv,
@@ -129,42 +439,80 @@ int Parser::execute(int argc, char** argv)
                 exit_program,
                 return_code
             );
-            if(matched)
+            // exit?
+            if(exit_program)
             {
-                // exit?
-                if(exit_program)
-                {
-                    return return_code;
-                }
-
-                // queue for execution and increment
-                m_flags_execute.push_back(flag.get());
-                i += increment;
-                break;
+                return return_code;
             }
+
+            // queue for execution and increment
+            m_flags_execute.push_back(flag);
+            i += increment;
+            continue;
         }
 
-        if(matched)
+        // ambiguous abbreviation?
+        std::vector<std::string> candidates;
+        if(action_match == KeyMatch::kAmbiguous && is_action_key)
         {
-            continue;
+            candidates = m_action_keys.get_completions(current, length);
+        }
+        else if(flag_match == KeyMatch::kAmbiguous && is_long_key)
+        {
+            candidates = m_flag_keys.get_completions(current, length);
+        }
+        if(!candidates.empty())
+        {
+            arc::lang::StringBuilder message;
+            message
+                << "Ambiguous command line argument: \'" << current
+                << "\' could be: ";
+            write_keys(message, candidates);
+            message << ".\nUse \'--help\' or \'-h\' for program help.";
+            write_line(*m_error_output, message);
+            return m_error_exit_code;
         }
 
-        // TODO: which encoding to use for Windows? Is there a way to detect
-        //       this?
-        // unrecognized argument
-        deus::UnicodeView current(argv[i], deus::Encoding::kUTF8);
-        std::cerr
-            << "Unrecognised command line argument: \'" << current << "\'."
-            << "\nUse \'--help\' or \'-h\' for program help." << std::endl;
+        // unrecognized argument, find any similar keys
+        const std::size_t max_distance = length > 4 ? 2 : 1;
+        if(i == 1)
+        {
+            candidates =
+                m_action_keys.get_suggestions(current, length, max_distance);
+        }
+        std::vector<std::string> flag_candidates =
+            m_flag_keys.get_suggestions(current, length, max_distance);
+        candidates.insert(
+            candidates.end(),
+            flag_candidates.begin(),
+            flag_candidates.end()
+        );
+        if(candidates.size() > MAX_SUGGESTIONS)
+        {
+            candidates.resize(MAX_SUGGESTIONS);
+        }
+
+        arc::lang::StringBuilder message;
+        message << "Unrecognised command line argument: \'" << current << "\'.";
+        if(!candidates.empty())
+        {
+            message << "\nDid you mean: ";
+            write_keys(message, candidates);
+            message << "?";
+        }
+        message << "\nUse \'--help\' or \'-h\' for program help.";
+        write_line(*m_error_output, message);
         return m_error_exit_code;
     }
 
     // nothing to do?
     if(m_action_execute == nullptr && m_flags_execute.empty())
     {
-        std::cerr
+        arc::lang::StringBuilder message;
+        message
             << "No command line arguments supplied.\nUse \'--help\' or \'-h\' "
-            "for program help." << std::endl;
+            << "for program help.";
+        write_line(*m_error_output, message);
         return 0;
     }
 
@@ -179,20 +527,45 @@ int Parser::execute(int argc, char** argv)
     }
 
     // execute flags
-    for(arc::arg::Flag* flag : m_flags_execute)
-    {
-        int exit_code = m_error_exit_code;
-        if(!flag->execute(exit_code))
-        {
-            return exit_code;
-        }
-    }
+    return execute_flags();
+}
 
-    // done
-    return 0;
+std::size_t Parser::get_max_threads() const
+{
+    return m_max_threads;
+}
+
+void Parser::set_max_threads(std::size_t max_threads)
+{
+    m_max_threads = max_threads;
+}
+
+arc::io::OutputSink& Parser::get_output() const
+{
+    return *m_output;
+}
+
+void Parser::set_output(arc::io::OutputSink& output)
+{
+    m_output = &output;
+}
+
+arc::io::OutputSink& Parser::get_error_output() const
+{
+    return *m_error_output;
+}
+
+void Parser::set_error_output(arc::io::OutputSink& error_output)
+{
+    m_error_output = &error_output;
 }
 
-const std::list<std::unique_ptr<arc::arg::Action>>& Parser::get_actions() const
+std::size_t Parser::get_revision() const
+{
+    return m_revision;
+}
+
+const Parser::ActionList& Parser::get_actions() const
 {
     return m_actions;
 }
@@ -201,17 +574,61 @@ void Parser::add_action(arc::arg::Action* action)
 {
     if(m_executing)
     {
-        throw arc::ex::StateError(
-            "Command line action (" + action->get_key() + ") cannot be added "
-            "to parser during parser execution."
+        arc::lang::StringBuilder message;
+        message
+            << "Command line action (" << action->get_key() << ") cannot be "
+            << "added to parser during parser execution.";
+        throw arc::ex::StateError(message.c_str());
+    }
+
+    // the key is interned and checked before the parser takes ownership, so
+    // that the caller still owns the action if this throws
+    const std::string key = to_utf8(action->get_key());
+    const arc::lang::Atom atom(key);
+    if(m_action_index.find(atom) != m_action_index.end())
+    {
+        arc::lang::StringBuilder message;
+        message
+            << "Command line action key (" << key << ") is already "
+            << "registered.";
+        throw arc::ex::ValueError(message.c_str());
+    }
+
+    link_action(action, key, atom);
+}
+
+arc::Result<void> Parser::try_add_action(arc::arg::Action* action)
+{
+    if(m_executing)
+    {
+        return arc::ex::Error(
+            arc::ex::ErrorCode::kStateError,
+            "Command line action cannot be added to parser during parser "
+            "execution."
         );
     }
 
-    action->set_parser_parent(this);
-    m_actions.emplace_back(action);
+    std::string key;
+    arc::lang::Atom atom;
+    const arc::Result<void> interned =
+        try_intern_key(action->get_key(), key, atom);
+    if(!interned.is_ok())
+    {
+        return interned;
+    }
+    if(m_action_index.find(atom) != m_action_index.end())
+    {
+        return arc::ex::Error(
+            arc::ex::ErrorCode::kValueError,
+            "Command line action key is already registered."
+        );
+    }
+
+    link_action(action, key, atom);
+    return arc::Result<void>();
 }
 
-const std::list<std::unique_ptr<arc::arg::Flag>>& Parser::get_flags() const
+const Parser::FlagList& Parser::get_flags() const
 {
     return m_flags;
 }
@@ -220,14 +637,299 @@ void Parser::add_flag(arc::arg::Flag* flag)
 {
     if(m_executing)
     {
-        throw arc::ex::StateError(
-            "Command line flag (" + flag->get_long_key() + ") cannot be added "
-            "to parser during parser execution."
+        arc::lang::StringBuilder message;
+        message
+            << "Command line flag (" << flag->get_long_key() << ") cannot be "
+            << "added to parser during parser execution.";
+        throw arc::ex::StateError(message.c_str());
+    }
+
+    // the keys are interned and checked before the parser takes ownership, so
+    // that the caller still owns the flag if this throws
+    const std::string long_key = to_utf8(flag->get_long_key());
+    const arc::lang::Atom long_atom(long_key);
+    const bool has_short_key = !flag->get_short_key().empty();
+    std::string short_key;
+    arc::lang::Atom short_atom;
+    if(has_short_key)
+    {
+        short_key = to_utf8(flag->get_short_key());
+        short_atom = arc::lang::Atom(short_key);
+    }
+    const std::string* duplicate = nullptr;
+    if(m_flag_index.find(long_atom) != m_flag_index.end())
+    {
+        duplicate = &long_key;
+    }
+    else if(has_short_key &&
+            (short_atom == long_atom ||
+             m_flag_index.find(short_atom) != m_flag_index.end()))
+    {
+        duplicate = &short_key;
+    }
+    if(duplicate != nullptr)
+    {
+        arc::lang::StringBuilder message;
+        message
+            << "Command line flag key (" << *duplicate << ") is already "
+            << "registered.";
+        throw arc::ex::ValueError(message.c_str());
+    }
+
+    link_flag(flag, long_key, long_atom, short_key, short_atom);
+}
+
+arc::Result<void> Parser::try_add_flag(arc::arg::Flag* flag)
+{
+    if(m_executing)
+    {
+        return arc::ex::Error(
+            arc::ex::ErrorCode::kStateError,
+            "Command line flag cannot be added to parser during parser "
+            "execution."
+        );
+    }
+
+    std::string long_key;
+    arc::lang::Atom long_atom;
+    arc::Result<void> interned =
+        try_intern_key(flag->get_long_key(), long_key, long_atom);
+    if(!interned.is_ok())
+    {
+        return interned;
+    }
+    const bool has_short_key = !flag->get_short_key().empty();
+    std::string short_key;
+    arc::lang::Atom short_atom;
+    if(has_short_key)
+    {
+        interned = try_intern_key(flag->get_short_key(), short_key, short_atom);
+        if(!interned.is_ok())
+        {
+            return interned;
+        }
+    }
+    if(m_flag_index.find(long_atom) != m_flag_index.end() ||
+       (has_short_key &&
+        (short_atom == long_atom ||
+         m_flag_index.find(short_atom) != m_flag_index.end())))
+    {
+        return arc::ex::Error(
+            arc::ex::ErrorCode::kValueError,
+            "Command line flag key is already registered."
         );
     }
 
+    link_flag(flag, long_key, long_atom, short_key, short_atom);
+    return arc::Result<void>();
+}
+
+//------------------------------------------------------------------------------
+//                            PRIVATE MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+void Parser::link_action(
+        arc::arg::Action* action,
+        const std::string& key,
+        const arc::lang::Atom& atom)
+{
+    action->set_parser_parent(this);
+    m_actions.push_back(*action);
+    m_action_index.try_emplace(atom, action);
+    m_action_keys.insert(key.c_str(), key.length(), action);
+    ++m_revision;
+}
+
+void Parser::link_flag(
+        arc::arg::Flag* flag,
+        const std::string& long_key,
+        const arc::lang::Atom& long_atom,
+        const std::string& short_key,
+        const arc::lang::Atom& short_atom)
+{
     flag->set_parser_parent(this);
-    m_flags.emplace_back(flag);
+    m_flags.push_back(*flag);
+    m_flag_index.try_emplace(long_atom, flag);
+    m_flag_keys.insert(long_key.c_str(), long_key.length(), flag);
+    if(!short_key.empty())
+    {
+        m_flag_index.try_emplace(short_atom, flag);
+        m_flag_keys.insert(short_key.c_str(), short_key.length(), flag);
+    }
+    ++m_revision;
+}
+
+int Parser::execute_flags()
+{
+    // build the nodes of the dependency graph in command line order
+    std::vector<FlagNode> nodes(m_flags_execute.size());
+    std::size_t concurrent_count = 0;
+    std::size_t offset = 0;
+    for(arc::arg::Flag* flag : m_flags_execute)
+    {
+        nodes[offset].flag = flag;
+        nodes[offset].rank = 0;
+        nodes[offset].pending = 0;
+        nodes[offset].success = true;
+        nodes[offset].exit_code = m_error_exit_code;
+        if(flag->is_concurrent())
+        {
+            ++concurrent_count;
+        }
+        ++offset;
+    }
+
+    // connect the edges of the graph
+    for(std::size_t i = 0; i < nodes.size(); ++i)
+    {
+        arc::arg::Flag* flag = nodes[i].flag;
+        arc::lang::SmallVector<std::size_t, 4> dependencies;
+
+        // declared dependencies
+        for(const deus::UnicodeStorage& key : flag->get_dependencies())
+        {
+            bool registered = false;
+            for(const arc::arg::Flag& other : m_flags)
+            {
+                if(other.get_long_key() == key)
+                {
+                    registered = true;
+                    break;
+                }
+            }
+            if(!registered)
+            {
+                arc::lang::StringBuilder message;
+                message
+                    << "Command line flag (" << flag->get_long_key()
+                    << ") depends on unknown flag (" << key << ").";
+                throw arc::ex::StateError(message.c_str());
+            }
+
+            for(std::size_t j = 0; j < nodes.size(); ++j)
+            {
+                if(nodes[j].flag != flag &&
+                   nodes[j].flag->get_long_key() == key)
+                {
+                    dependencies.push_back(j);
+                }
+            }
+        }
+
+        // repeated occurrences of the same flag are executed in command line
+        // order
+        for(std::size_t j = i; j > 0; --j)
+        {
+            if(nodes[j - 1].flag == flag)
+            {
+                dependencies.push_back(j - 1);
+                break;
+            }
+        }
+
+        std::sort(dependencies.begin(), dependencies.end());
+        dependencies.erase(
+            std::unique(dependencies.begin(), dependencies.end()),
+            dependencies.end()
+        );
+        for(std::size_t dependency : dependencies)
+        {
+            nodes[dependency].dependents.push_back(i);
+            ++nodes[i].pending;
+        }
+    }
+
+    // find the serial execution order: command line order, except for where
+    // dependencies require otherwise
+    std::vector<std::size_t> order;
+    order.reserve(nodes.size());
+    {
+        std::vector<std::size_t> pending(nodes.size());
+        std::set<std::size_t> ready;
+        for(std::size_t i = 0; i < nodes.size(); ++i)
+        {
+            pending[i] = nodes[i].pending;
+            if(pending[i] == 0)
+            {
+                ready.insert(i);
+            }
+        }
+        while(!ready.empty())
+        {
+            std::size_t i = *ready.begin();
+            ready.erase(ready.begin());
+            nodes[i].rank = order.size();
+            order.push_back(i);
+            for(std::size_t dependent : nodes[i].dependents)
+            {
+                if(--pending[dependent] == 0)
+                {
+                    ready.insert(dependent);
+                }
+            }
+        }
+    }
+    if(order.size() != nodes.size())
+    {
+        throw arc::ex::StateError(
+            "Command line flag dependencies contain a cycle."
+        );
+    }
+
+    // flags that are not concurrent are executed in the serial order, which
+    // already honours the declared dependencies, so chaining them in this
+    // order can't introduce a cycle
+    std::size_t previous = nodes.size();
+    for(std::size_t i : order)
+    {
+        if(nodes[i].flag->is_concurrent())
+        {
+            continue;
+        }
+        if(previous != nodes.size())
+        {
+            arc::lang::SmallVector<std::size_t, 4>& dependents =
+                nodes[previous].dependents;
+            if(std::find(dependents.begin(), dependents.end(), i) ==
+               dependents.end())
+            {
+                dependents.push_back(i);
+                ++nodes[i].pending;
+            }
+        }
+        previous = i;
+    }
+
+    // serial execution?
+    if(m_max_threads <= 1 || concurrent_count == 0)
+    {
+        for(std::size_t i : order)
+        {
+            int exit_code = m_error_exit_code;
+            if(!nodes[i].flag->execute(exit_code))
+            {
+                return exit_code;
+            }
+        }
+        return 0;
+    }
+
+    FlagScheduler scheduler(nodes, order);
+    scheduler.run(std::min(m_max_threads - 1, concurrent_count));
+
+    // report the first failure in serial order
+    for(std::size_t i : order)
+    {
+        if(nodes[i].exception)
+        {
+            std::rethrow_exception(nodes[i].exception);
+        }
+        if(!nodes[i].success)
+        {
+            return nodes[i].exit_code;
+        }
+    }
+    return 0;
 }
 
 } // namespace arg
@@ -36,11 +36,20 @@
 #ifndef ARCANECORE_BASE_ARG_PARSER_HPP_
 #define ARCANECORE_BASE_ARG_PARSER_HPP_
 
-#include <memory>
-#include <list>
+#include <cstddef>
+#include <string>
 
 #include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/Result.hpp"
+#include "arcanecore/base/arg/Action.hpp"
+#include "arcanecore/base/arg/Flag.hpp"
+#include "arcanecore/base/arg/KeyTrie.hpp"
+#include "arcanecore/base/io/OutputSink.hpp"
+#include "arcanecore/base/lang/Atom.hpp"
+#include "arcanecore/base/lang/FlatHashMap.hpp"
+#include "arcanecore/base/lang/IntrusiveList.hpp"
 #include "arcanecore/base/lang/Restrictors.hpp"
+#include "arcanecore/base/lang/SmallVector.hpp"
 
 
 namespace arc
@@ -49,13 +58,6 @@ ARC_BASE_VERSION_NS_BEGIN
 namespace arg
 {
 
-//------------------------------------------------------------------------------
-//                              FORWARD DECLARATIONS
-//------------------------------------------------------------------------------
-
-class Action;
-class Flag;
-
 /*!
  * \brief The arc::arg::Parser is used to parse command line arguments and
  *        execute functionality based on them.
@@ -67,6 +69,27 @@ class Parser
 {
 public:
 
+    //--------------------------------------------------------------------------
+    //                                PUBLIC TYPES
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief The list of the actions of a parser, in the order they were
+     *        added.
+     */
+    typedef arc::lang::IntrusiveList<
+        arc::arg::Action,
+        &arc::arg::Action::m_parser_hook
+    > ActionList;
+
+    /*!
+     * \brief The list of the flags of a parser, in the order they were added.
+     */
+    typedef arc::lang::IntrusiveList<
+        arc::arg::Flag,
+        &arc::arg::Flag::m_parser_hook
+    > FlagList;
+
     //--------------------------------------------------------------------------
     //                                CONSTRUCTOR
     //--------------------------------------------------------------------------
@@ -74,6 +97,9 @@ public:
     /*!
      * \brief Constructs a new Parser object.
      *
+     * The parser writes to the standard output and error sinks (see
+     * arc::io::FileDescriptorSink::get_stdout()) until other sinks are set.
+     *
      * \param error_exit_code Option parameter that defines the default exit
      *                        code that will be used when an error is
      *                        encountered.
@@ -97,46 +123,176 @@ public:
      * This function returns once all arguments have been parsed and all
      * functionality executed.
      *
+     * Long flag keys and action keys may be abbreviated on the command line,
+     * as long as the abbreviation is unambiguous (e.g. ```--verb``` for
+     * ```--verbose```). Unrecognised arguments are reported along with any
+     * similar keys.
+     *
+     * The matched action is executed first, followed by the matched flags.
+     * Flags are executed in the order they were supplied on the command line
+     * unless they declare dependencies (see arc::arg::Flag::add_dependency()),
+     * and flags which are concurrent (see arc::arg::Flag::set_concurrent())
+     * may be executed in parallel on worker threads. Regardless of the order
+     * flags actually complete in, the exit code (or exception) reported is
+     * always that of the first flag to fail in the serial execution order.
+     *
      * \param argc The number of command line arguments in argv.
      * \param argv The command line arguments (the first argument should be the
      *             name of the application).
      *
      * \return The exit code.
+     *
+     * \throws arc::ex::StateError If the declared flag dependencies refer to an
+     *                             unknown flag or contain a cycle.
      */
     int execute(int argc, char** argv);
 
+    /*!
+     * \brief Returns the maximum number of threads that will be used to
+     *        execute concurrent flags (including the calling thread).
+     */
+    std::size_t get_max_threads() const;
+
+    /*!
+     * \brief Sets the maximum number of threads that will be used to execute
+     *        concurrent flags (including the calling thread).
+     *
+     * By default this is the number of hardware threads available. A value of
+     * 1 (or 0) means all flags are executed serially on the calling thread.
+     */
+    void set_max_threads(std::size_t max_threads);
+
+    /*!
+     * \brief Returns the sink that output requested on the command line (such
+     *        as help text) is written to.
+     */
+    arc::io::OutputSink& get_output() const;
+
+    /*!
+     * \brief Sets the sink that output requested on the command line (such as
+     *        help text) is written to.
+     *
+     * \note The parser doesn't take ownership of the sink, which must outlive
+     *       the parser.
+     */
+    void set_output(arc::io::OutputSink& output);
+
+    /*!
+     * \brief Returns the sink that errors in the command line arguments are
+     *        reported to.
+     */
+    arc::io::OutputSink& get_error_output() const;
+
+    /*!
+     * \brief Sets the sink that errors in the command line arguments are
+     *        reported to.
+     *
+     * \note The parser doesn't take ownership of the sink, which must outlive
+     *       the parser.
+     */
+    void set_error_output(arc::io::OutputSink& error_output);
+
+    /*!
+     * \brief Returns a counter which is incremented every time an action or
+     *        flag is added to this parser.
+     *
+     * This can be used to detect when data derived from the definitions of this
+     * parser (e.g. rendered help text) is out of date.
+     */
+    std::size_t get_revision() const;
+
     /*!
      * \brief Returns the current list of Actions registered in this Parser.
      */
-    const std::list<std::unique_ptr<arc::arg::Action>>& get_actions() const;
+    const ActionList& get_actions() const;
 
     /*!
      * \brief Adds an action definition to the parser.
      *
      * \note The Parser will take ownership of the Action pointer.
      *
+     * \note The keys of the action are interned in the global
+     *       arc::lang::AtomTable, so this must be called before the table is
+     *       frozen.
+     *
      * \throws arc::ex::StateError If this function is called during
-     *                             arc::arg::Parser::execute().
+     *                             arc::arg::Parser::execute(), or if a key is
+     *                             new and the global atom table is frozen.
+     *                             The Parser doesn't take ownership of the
+     *                             Action if this is thrown.
+     * \throws arc::ex::ValueError If a key of the action is already registered.
+     *                             The Parser doesn't take ownership of the
+     *                             Action if this is thrown.
      */
     void add_action(arc::arg::Action* action);
 
+    /*!
+     * \brief Non-throwing variant of arc::arg::Parser::add_action().
+     *
+     * \note If an error is returned the Parser does not take ownership of the
+     *       Action pointer.
+     *
+     * \return An error with the code arc::ex::ErrorCode::kStateError if this
+     *         function is called during arc::arg::Parser::execute(), or if a
+     *         key is new and the global atom table is frozen. An error with
+     *         the code arc::ex::ErrorCode::kValueError if a key of the action is
+     *         already registered or cannot be converted to UTF-8.
+     */
+    arc::Result<void> try_add_action(arc::arg::Action* action);
+
     /*!
      * \brief Returns the current list of Flags registered in this Parser.
      */
-    const std::list<std::unique_ptr<arc::arg::Flag>>& get_flags() const;
+    const FlagList& get_flags() const;
 
     /*!
      * \brief Adds a flag definition to the parser.
      *
      * \note The Parser will take ownership of the Flag pointer.
      *
+     * \note The keys of the flag are interned in the global
+     *       arc::lang::AtomTable, so this must be called before the table is
+     *       frozen.
+     *
      * \throws arc::ex::StateError If this function is called during
-     *                             arc::arg::Parser::execute().
+     *                             arc::arg::Parser::execute(), or if a key is
+     *                             new and the global atom table is frozen.
+     *                             The Parser doesn't take ownership of the
+     *                             Flag if this is thrown.
+     * \throws arc::ex::ValueError If a key of the flag is already registered.
+     *                             The Parser doesn't take ownership of the
+     *                             Flag if this is thrown.
      */
     void add_flag(arc::arg::Flag* flag);
 
+    /*!
+     * \brief Non-throwing variant of arc::arg::Parser::add_flag().
+     *
+     * \note If an error is returned the Parser does not take ownership of the
+     *       Flag pointer.
+     *
+     * \return An error with the code arc::ex::ErrorCode::kStateError if this
+     *         function is called during arc::arg::Parser::execute(), or if a
+     *         key is new and the global atom table is frozen. An error with
+     *         the code arc::ex::ErrorCode::kValueError if a key of the flag is
+     *         already registered or cannot be converted to UTF-8.
+     */
+    arc::Result<void> try_add_flag(arc::arg::Flag* flag);
+
 private:
 
+    //--------------------------------------------------------------------------
+    //                               PRIVATE TYPES
+    //--------------------------------------------------------------------------
+
+    // maps the atoms of UTF-8 keys to the object with the key
+    template<typename T>
+    using KeyIndex = arc::lang::FlatHashMap<
+        arc::lang::Atom,
+        T,
+        arc::lang::AtomHash
+    >;
+
     //--------------------------------------------------------------------------
     //                             PRIVATE ATTRIBUTES
     //--------------------------------------------------------------------------
@@ -147,15 +303,67 @@ private:
     // the default exit code which will be used if an error is encountered
     int m_error_exit_code;
 
-    // the actions that have been added to the parser
-    std::list<std::unique_ptr<arc::arg::Action>> m_actions;
+    // incremented every time an action or flag is added
+    std::size_t m_revision;
+
+    // the actions that have been added to the parser (which are owned by the
+    // parser)
+    ActionList m_actions;
     // the action to be executed (null if no action)
     arc::arg::Action* m_action_execute;
+    // exact and prefix indices of the UTF-8 keys of the actions
+    KeyIndex<arc::arg::Action*> m_action_index;
+    arc::arg::KeyTrie<arc::arg::Action*> m_action_keys;
 
-    // the flags that have been added to the parser
-    std::list<std::unique_ptr<arc::arg::Flag>> m_flags;
+    // the flags that have been added to the parser (which are owned by the
+    // parser)
+    FlagList m_flags;
+    // exact and prefix indices of the UTF-8 long and short keys of the flags
+    KeyIndex<arc::arg::Flag*> m_flag_index;
+    arc::arg::KeyTrie<arc::arg::Flag*> m_flag_keys;
     // the flags to be execute (in order)
-    std::list<arc::arg::Flag*> m_flags_execute;
+    arc::lang::SmallVector<arc::arg::Flag*, 8> m_flags_execute;
+
+    // the maximum number of threads flags may be executed on
+    std::size_t m_max_threads;
+
+    // where output and errors are written (which are not owned by the parser)
+    arc::io::OutputSink* m_output;
+    arc::io::OutputSink* m_error_output;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Executes the flags that have been queued for execution, honouring
+     *        their dependencies and concurrency.
+     *
+     * \return The exit code.
+     */
+    int execute_flags();
+
+    /*!
+     * \brief Takes ownership of the given action and indexes it under its
+     *        already interned and checked key.
+     */
+    void link_action(
+            arc::arg::Action* action,
+            const std::string& key,
+            const arc::lang::Atom& atom);
+
+    /*!
+     * \brief Takes ownership of the given flag and indexes it under its
+     *        already interned and checked keys.
+     *
+     * \note The short key is not indexed if it's empty.
+     */
+    void link_flag(
+            arc::arg::Flag* flag,
+            const std::string& long_key,
+            const arc::lang::Atom& long_atom,
+            const std::string& short_key,
+            const arc::lang::Atom& short_atom);
 };
 
 } // namespace arg
@@ -0,0 +1,127 @@
+/*!
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "arcanecore/base/async/FrameAllocator.hpp"
+
+#include <new>
+
+#include "arcanecore/base/lang/ObjectPool.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace async
+{
+
+namespace
+{
+
+//------------------------------------------------------------------------------
+//                                   CONSTANTS
+//------------------------------------------------------------------------------
+
+// log2 of FrameAllocator::MIN_SIZE
+static const std::size_t MIN_SHIFT = 6;
+
+// the number of size classes between MIN_SIZE and MAX_SIZE
+static const std::size_t CLASS_COUNT = 7;
+
+static_assert(
+    (FrameAllocator::MIN_SIZE << (CLASS_COUNT - 1)) ==
+        FrameAllocator::MAX_SIZE,
+    "Frame size classes do not cover MIN_SIZE to MAX_SIZE"
+);
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+// returns the index of the smallest size class the given size fits in
+static std::size_t get_class(std::size_t size)
+{
+    std::size_t index = 0;
+    while((FrameAllocator::MIN_SIZE << index) < size)
+    {
+        ++index;
+    }
+    return index;
+}
+
+// returns the pool for the given size class, the pools are deliberately
+// leaked so that frames may be freed by static destructors
+static arc::lang::ObjectPoolBase& get_pool(std::size_t index)
+{
+    static arc::lang::ObjectPoolBase** pools = []()
+    {
+        arc::lang::ObjectPoolBase** result =
+            new arc::lang::ObjectPoolBase*[CLASS_COUNT];
+        for(std::size_t i = 0; i < CLASS_COUNT; ++i)
+        {
+            result[i] = new arc::lang::ObjectPoolBase(
+                std::size_t(1) << (MIN_SHIFT + i),
+                alignof(std::max_align_t)
+            );
+        }
+        return result;
+    }();
+    return *pools[index];
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                            PUBLIC STATIC FUNCTIONS
+//------------------------------------------------------------------------------
+
+void* FrameAllocator::allocate(std::size_t size)
+{
+    if(size > MAX_SIZE)
+    {
+        return ::operator new(size);
+    }
+    return get_pool(get_class(size)).allocate();
+}
+
+void FrameAllocator::deallocate(void* p, std::size_t size)
+{
+    if(size > MAX_SIZE)
+    {
+        ::operator delete(p);
+        return;
+    }
+    get_pool(get_class(size)).deallocate(p);
+}
+
+} // namespace async
+ARC_BASE_VERSION_NS_END
+} // namespace arc
@@ -0,0 +1,128 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Pooled allocation of coroutine frames.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_ASYNC_FRAMEALLOCATOR_HPP_
+#define ARCANECORE_BASE_ASYNC_FRAMEALLOCATOR_HPP_
+
+#include <cstddef>
+
+#include "arcanecore/base/BaseAPI.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace async
+{
+
+/*!
+ * \brief Allocates coroutine frames from a set of arc::lang::ObjectPool slots
+ *        in power of two size classes.
+ *
+ * Coroutine frames are allocated when a coroutine is called and freed when it
+ * finishes, so short-lived coroutines would otherwise make a pair of heap
+ * allocations each. Frames larger than MAX_SIZE fall back to the global heap.
+ *
+ * The pools are never destroyed, so frames may outlive static objects.
+ */
+class FrameAllocator
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                              PUBLIC CONSTANTS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief The size of the smallest size class.
+     */
+    static const std::size_t MIN_SIZE = 64;
+
+    /*!
+     * \brief The size of the largest size class.
+     */
+    static const std::size_t MAX_SIZE = 4096;
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC STATIC FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns memory for a coroutine frame of the given size.
+     *
+     * \throws std::bad_alloc If the memory could not be allocated.
+     */
+    static void* allocate(std::size_t size);
+
+    /*!
+     * \brief Frees a coroutine frame returned by allocate().
+     *
+     * \param size The size the frame was allocated with.
+     */
+    static void deallocate(void* p, std::size_t size);
+
+    FrameAllocator() = delete;
+};
+
+/*!
+ * \brief Base class of the promise types of this module, which allocates
+ *        their coroutine frames with arc::async::FrameAllocator when
+ *        ```ARC_ASYNC_POOLED_FRAMES``` is defined.
+ */
+class FramePromise
+{
+public:
+
+    #ifdef ARC_ASYNC_POOLED_FRAMES
+
+        static void* operator new(std::size_t size)
+        {
+            return FrameAllocator::allocate(size);
+        }
+
+        static void operator delete(void* p, std::size_t size)
+        {
+            FrameAllocator::deallocate(p, size);
+        }
+
+    #endif
+};
+
+} // namespace async
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
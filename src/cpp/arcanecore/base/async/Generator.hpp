@@ -0,0 +1,338 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Coroutine which lazily produces a sequence of values.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_ASYNC_GENERATOR_HPP_
+#define ARCANECORE_BASE_ASYNC_GENERATOR_HPP_
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/async/FrameAllocator.hpp"
+#include "arcanecore/base/lang/Restrictors.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace async
+{
+
+/*!
+ * \brief A coroutine which produces a sequence of values of type T using
+ *        ```co_yield```.
+ *
+ * The coroutine runs on the thread iterating over the generator, and only
+ * runs as far as the next ```co_yield``` each time the iterator is
+ * incremented. Yielded values are not copied, the iterator refers to the
+ * value in the coroutine until it is next resumed.
+ *
+ * \code
+ * arc::async::Generator<std::size_t> count_to(std::size_t n)
+ * {
+ *     for(std::size_t i = 0; i < n; ++i)
+ *     {
+ *         co_yield i;
+ *     }
+ * }
+ *
+ * for(std::size_t i : count_to(10))
+ * {
+ *     // ...
+ * }
+ * \endcode
+ *
+ * If the coroutine exits with an exception it is rethrown by begin() or the
+ * increment of the iterator.
+ */
+template<typename T>
+class Generator
+    : private arc::lang::Noncopyable
+    , private arc::lang::Noncomparable
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                               PUBLIC TYPES
+    //--------------------------------------------------------------------------
+
+    typedef typename std::remove_reference<T>::type value_type;
+    typedef typename std::conditional<
+        std::is_reference<T>::value,
+        T,
+        T&
+    >::type reference;
+    typedef value_type* pointer;
+
+    class promise_type
+        : public FramePromise
+    {
+    public:
+
+        promise_type()
+            : m_value(nullptr)
+        {
+        }
+
+        Generator get_return_object() noexcept
+        {
+            return Generator(
+                std::coroutine_handle<promise_type>::from_promise(*this)
+            );
+        }
+
+        std::suspend_always initial_suspend() const noexcept
+        {
+            return {};
+        }
+
+        std::suspend_always final_suspend() const noexcept
+        {
+            return {};
+        }
+
+        std::suspend_always yield_value(value_type& value) noexcept
+        {
+            m_value = std::addressof(value);
+            return {};
+        }
+
+        std::suspend_always yield_value(value_type&& value) noexcept
+        {
+            // the temporary lives until the coroutine is resumed
+            m_value = std::addressof(value);
+            return {};
+        }
+
+        void return_void() const noexcept
+        {
+        }
+
+        void unhandled_exception() noexcept
+        {
+            m_exception = std::current_exception();
+        }
+
+        // generators cannot await
+        template<typename Awaitable>
+        std::suspend_never await_transform(Awaitable&&) = delete;
+
+        reference get_value() const noexcept
+        {
+            return static_cast<reference>(*m_value);
+        }
+
+        void rethrow_if_exception()
+        {
+            if(m_exception)
+            {
+                std::rethrow_exception(m_exception);
+            }
+        }
+
+    private:
+
+        pointer m_value;
+        std::exception_ptr m_exception;
+    };
+
+    /*!
+     * \brief Input iterator over the values produced by a generator.
+     */
+    class Iterator
+    {
+    public:
+
+        typedef std::input_iterator_tag iterator_category;
+        typedef std::ptrdiff_t difference_type;
+        typedef Generator::value_type value_type;
+        typedef Generator::reference reference;
+        typedef Generator::pointer pointer;
+
+        Iterator() noexcept
+            : m_handle(nullptr)
+        {
+        }
+
+        explicit Iterator(std::coroutine_handle<promise_type> handle) noexcept
+            : m_handle(handle)
+        {
+        }
+
+        reference operator*() const noexcept
+        {
+            return m_handle.promise().get_value();
+        }
+
+        pointer operator->() const noexcept
+        {
+            return std::addressof(operator*());
+        }
+
+        Iterator& operator++()
+        {
+            m_handle.resume();
+            if(m_handle.done())
+            {
+                std::coroutine_handle<promise_type> handle = m_handle;
+                m_handle = nullptr;
+                handle.promise().rethrow_if_exception();
+            }
+            return *this;
+        }
+
+        void operator++(int)
+        {
+            ++*this;
+        }
+
+        bool operator==(const Iterator& other) const noexcept
+        {
+            return m_handle == other.m_handle;
+        }
+
+        bool operator!=(const Iterator& other) const noexcept
+        {
+            return !(*this == other);
+        }
+
+    private:
+
+        // null once the generator has finished
+        std::coroutine_handle<promise_type> m_handle;
+    };
+
+    typedef Iterator iterator;
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Constructs a generator with no coroutine, which produces no
+     *        values.
+     */
+    Generator() noexcept
+        : m_handle(nullptr)
+    {
+    }
+
+    explicit Generator(std::coroutine_handle<promise_type> handle) noexcept
+        : m_handle(handle)
+    {
+    }
+
+    Generator(Generator&& other) noexcept
+        : m_handle(std::exchange(other.m_handle, nullptr))
+    {
+    }
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    ~Generator()
+    {
+        if(m_handle)
+        {
+            m_handle.destroy();
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    //                                 OPERATORS
+    //--------------------------------------------------------------------------
+
+    Generator& operator=(Generator&& other) noexcept
+    {
+        if(this != &other)
+        {
+            if(m_handle)
+            {
+                m_handle.destroy();
+            }
+            m_handle = std::exchange(other.m_handle, nullptr);
+        }
+        return *this;
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Runs the coroutine to its first value and returns an iterator
+     *        to it.
+     *
+     * This may only be called once.
+     */
+    Iterator begin()
+    {
+        if(!m_handle)
+        {
+            return Iterator();
+        }
+        return ++Iterator(m_handle);
+    }
+
+    /*!
+     * \brief Returns the iterator which compares equal to an iterator of a
+     *        finished generator.
+     */
+    Iterator end() const noexcept
+    {
+        return Iterator();
+    }
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    std::coroutine_handle<promise_type> m_handle;
+};
+
+} // namespace async
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
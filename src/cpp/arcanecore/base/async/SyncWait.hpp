@@ -0,0 +1,244 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Blocks a thread until an asynchronous task has finished.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_ASYNC_SYNCWAIT_HPP_
+#define ARCANECORE_BASE_ASYNC_SYNCWAIT_HPP_
+
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <type_traits>
+#include <utility>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/async/FrameAllocator.hpp"
+#include "arcanecore/base/async/Task.hpp"
+#include "arcanecore/base/lang/Futex.hpp"
+#include "arcanecore/base/lang/Restrictors.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace async
+{
+
+namespace detail
+{
+
+//------------------------------------------------------------------------------
+//                                 SYNC WAIT TASK
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief Coroutine started by arc::async::sync_wait() which awaits a task and
+ *        then wakes the waiting thread.
+ */
+class SyncWaitTask
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                               PUBLIC TYPES
+    //--------------------------------------------------------------------------
+
+    class promise_type
+        : public FramePromise
+    {
+    public:
+
+        promise_type()
+            : m_finished(0)
+        {
+        }
+
+        SyncWaitTask get_return_object() noexcept
+        {
+            return SyncWaitTask(
+                std::coroutine_handle<promise_type>::from_promise(*this)
+            );
+        }
+
+        std::suspend_always initial_suspend() const noexcept
+        {
+            return {};
+        }
+
+        auto final_suspend() noexcept
+        {
+            struct Awaiter
+            {
+                bool await_ready() const noexcept
+                {
+                    return false;
+                }
+
+                void await_suspend(
+                        std::coroutine_handle<promise_type> handle) noexcept
+                {
+                    handle.promise().finish();
+                }
+
+                void await_resume() const noexcept
+                {
+                }
+            };
+            return Awaiter();
+        }
+
+        void return_void() const noexcept
+        {
+        }
+
+        void unhandled_exception() const noexcept
+        {
+            // the awaited task's exception is rethrown by sync_wait()
+            std::terminate();
+        }
+
+        void wait()
+        {
+            while(m_finished.load(std::memory_order_acquire) == 0)
+            {
+                arc::lang::futex_wait(&m_finished, 0);
+            }
+        }
+
+    private:
+
+        std::atomic<std::uint32_t> m_finished;
+
+        void finish() noexcept
+        {
+            m_finished.store(1, std::memory_order_release);
+            // the frame may be destroyed as soon as the store is seen, but
+            // waking is harmless since it only uses the address
+            arc::lang::futex_wake_all(&m_finished);
+        }
+    };
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    explicit SyncWaitTask(std::coroutine_handle<promise_type> handle) noexcept
+        : m_handle(handle)
+    {
+    }
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    ~SyncWaitTask()
+    {
+        m_handle.destroy();
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Runs the coroutine and blocks until it has finished, which may
+     *        be on a different thread.
+     */
+    void run()
+    {
+        m_handle.resume();
+        m_handle.promise().wait();
+    }
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    std::coroutine_handle<promise_type> m_handle;
+};
+
+template<typename T>
+SyncWaitTask make_sync_wait_task(Task<T>& task)
+{
+    co_await task.when_ready();
+}
+
+} // namespace detail
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief Starts the given task and blocks the calling thread until it has
+ *        finished.
+ *
+ * This is the entry point from synchronous code into asynchronous code, it
+ * should not be called from a coroutine since it blocks the thread the
+ * coroutine is running on.
+ *
+ * \return The value returned by the task.
+ *
+ * \throws The exception the task exited with, if any.
+ */
+template<typename T>
+T sync_wait(Task<T>&& task)
+{
+    Task<T> owned(std::move(task));
+    {
+        detail::SyncWaitTask waiter = detail::make_sync_wait_task(owned);
+        waiter.run();
+    }
+    if constexpr(std::is_void<T>::value)
+    {
+        owned.get_result();
+    }
+    else
+    {
+        return std::move(owned.get_result());
+    }
+}
+
+} // namespace async
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
@@ -0,0 +1,535 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Lazily started coroutine which produces a single value.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_ASYNC_TASK_HPP_
+#define ARCANECORE_BASE_ASYNC_TASK_HPP_
+
+#include <coroutine>
+#include <exception>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/Exceptions.hpp"
+#include "arcanecore/base/async/FrameAllocator.hpp"
+#include "arcanecore/base/lang/Restrictors.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace async
+{
+
+template<typename T>
+class Task;
+
+namespace detail
+{
+
+//------------------------------------------------------------------------------
+//                               TASK PROMISE BASE
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief The parts of the promise of an arc::async::Task that do not depend
+ *        on its result type.
+ */
+class TaskPromiseBase
+    : public FramePromise
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                               PUBLIC TYPES
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Awaiter used when the coroutine finishes, which transfers control
+     *        to the awaiting coroutine.
+     */
+    struct FinalAwaiter
+    {
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        template<typename Promise>
+        std::coroutine_handle<> await_suspend(
+                std::coroutine_handle<Promise> handle) noexcept
+        {
+            std::coroutine_handle<> continuation =
+                handle.promise().m_continuation;
+            if(continuation)
+            {
+                return continuation;
+            }
+            return std::noop_coroutine();
+        }
+
+        void await_resume() const noexcept
+        {
+        }
+    };
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    std::suspend_always initial_suspend() const noexcept
+    {
+        return {};
+    }
+
+    FinalAwaiter final_suspend() const noexcept
+    {
+        return {};
+    }
+
+    /*!
+     * \brief Sets the coroutine which is resumed when this task finishes.
+     */
+    void set_continuation(std::coroutine_handle<> continuation)
+    {
+        m_continuation = continuation;
+    }
+
+protected:
+
+    //--------------------------------------------------------------------------
+    //                            PROTECTED ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    std::coroutine_handle<> m_continuation;
+};
+
+//------------------------------------------------------------------------------
+//                                 TASK PROMISE
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief The promise of an arc::async::Task which produces a value.
+ */
+template<typename T>
+class TaskPromise
+    : public TaskPromiseBase
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    TaskPromise()
+        : m_state(State::kEmpty)
+    {
+    }
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    ~TaskPromise()
+    {
+        if(m_state == State::kValue)
+        {
+            reinterpret_cast<T*>(&m_value)->~T();
+        }
+        else if(m_state == State::kException)
+        {
+            m_exception.~exception_ptr();
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    Task<T> get_return_object() noexcept;
+
+    void unhandled_exception() noexcept
+    {
+        new(&m_exception) std::exception_ptr(std::current_exception());
+        m_state = State::kException;
+    }
+
+    template<typename Value>
+    void return_value(Value&& value)
+    {
+        new(&m_value) T(std::forward<Value>(value));
+        m_state = State::kValue;
+    }
+
+    /*!
+     * \brief Returns the result of the finished coroutine, or rethrows the
+     *        exception it exited with.
+     */
+    T& get_result()
+    {
+        if(m_state == State::kException)
+        {
+            std::rethrow_exception(m_exception);
+        }
+        return *reinterpret_cast<T*>(&m_value);
+    }
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                               PRIVATE TYPES
+    //--------------------------------------------------------------------------
+
+    enum class State
+    {
+        kEmpty,
+        kValue,
+        kException
+    };
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    State m_state;
+    union
+    {
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type m_value;
+        std::exception_ptr m_exception;
+    };
+};
+
+/*!
+ * \brief The promise of an arc::async::Task which does not produce a value.
+ */
+template<>
+class TaskPromise<void>
+    : public TaskPromiseBase
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    Task<void> get_return_object() noexcept;
+
+    void unhandled_exception() noexcept
+    {
+        m_exception = std::current_exception();
+    }
+
+    void return_void() const noexcept
+    {
+    }
+
+    /*!
+     * \brief Rethrows the exception the finished coroutine exited with, if
+     *        any.
+     */
+    void get_result()
+    {
+        if(m_exception)
+        {
+            std::rethrow_exception(m_exception);
+        }
+    }
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    std::exception_ptr m_exception;
+};
+
+} // namespace detail
+
+//------------------------------------------------------------------------------
+//                                      TASK
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief A coroutine which produces a single value of type T (or nothing when
+ *        T is void).
+ *
+ * Tasks are lazy: the coroutine does not start running until the task is
+ * awaited, at which point the awaiting coroutine is suspended and control is
+ * transferred directly to the task. When the task finishes control is
+ * transferred directly back to the awaiting coroutine, and the result is
+ * returned from the ```co_await``` expression (or the exception the task
+ * exited with is rethrown). Neither transfer is a nested call, so long chains
+ * of awaiting tasks run in constant stack space.
+ *
+ * \code
+ * arc::async::Task<int> get_value()
+ * {
+ *     co_return 7;
+ * }
+ *
+ * arc::async::Task<int> get_double()
+ * {
+ *     const int value = co_await get_value();
+ *     co_return value * 2;
+ * }
+ * \endcode
+ *
+ * A task owns its coroutine frame and must be awaited (or passed to
+ * arc::async::sync_wait()) at most once.
+ */
+template<typename T = void>
+class Task
+    : private arc::lang::Noncopyable
+    , private arc::lang::Noncomparable
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                               PUBLIC TYPES
+    //--------------------------------------------------------------------------
+
+    typedef detail::TaskPromise<T> promise_type;
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Constructs a task with no coroutine.
+     */
+    Task() noexcept
+        : m_handle(nullptr)
+    {
+    }
+
+    /*!
+     * \brief Constructs a task which owns the given coroutine.
+     */
+    explicit Task(std::coroutine_handle<promise_type> handle) noexcept
+        : m_handle(handle)
+    {
+    }
+
+    Task(Task&& other) noexcept
+        : m_handle(std::exchange(other.m_handle, nullptr))
+    {
+    }
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    ~Task()
+    {
+        if(m_handle)
+        {
+            m_handle.destroy();
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    //                                 OPERATORS
+    //--------------------------------------------------------------------------
+
+    Task& operator=(Task&& other) noexcept
+    {
+        if(this != &other)
+        {
+            if(m_handle)
+            {
+                m_handle.destroy();
+            }
+            m_handle = std::exchange(other.m_handle, nullptr);
+        }
+        return *this;
+    }
+
+    /*!
+     * \brief Starts this task and suspends the awaiting coroutine until it has
+     *        finished.
+     *
+     * \return The value the task returned.
+     *
+     * \throws arc::ex::StateError If this task has no coroutine.
+     */
+    auto operator co_await() & noexcept
+    {
+        struct Awaiter
+            : public AwaiterBase
+        {
+            decltype(auto) await_resume()
+            {
+                return this->get_result();
+            }
+        };
+        return Awaiter{{m_handle}};
+    }
+
+    auto operator co_await() && noexcept
+    {
+        struct Awaiter
+            : public AwaiterBase
+        {
+            decltype(auto) await_resume()
+            {
+                if constexpr(std::is_void<T>::value)
+                {
+                    this->get_result();
+                }
+                else
+                {
+                    return std::move(this->get_result());
+                }
+            }
+        };
+        return Awaiter{{m_handle}};
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns whether this task has finished running.
+     */
+    bool is_ready() const noexcept
+    {
+        return !m_handle || m_handle.done();
+    }
+
+    /*!
+     * \brief Returns an awaitable which starts this task and resumes the
+     *        awaiting coroutine once it has finished, without retrieving the
+     *        result.
+     */
+    auto when_ready() noexcept
+    {
+        struct Awaiter
+            : public AwaiterBase
+        {
+            void await_resume() const noexcept
+            {
+            }
+        };
+        return Awaiter{{m_handle}};
+    }
+
+    /*!
+     * \brief Returns the result of this finished task, or rethrows the
+     *        exception it exited with.
+     *
+     * \throws arc::ex::StateError If this task has not finished.
+     */
+    decltype(auto) get_result()
+    {
+        if(!m_handle || !m_handle.done())
+        {
+            throw arc::ex::StateError("Task has not finished");
+        }
+        return m_handle.promise().get_result();
+    }
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                               PRIVATE TYPES
+    //--------------------------------------------------------------------------
+
+    // the awaiter parts common to the ways a task can be awaited
+    struct AwaiterBase
+    {
+        std::coroutine_handle<promise_type> handle;
+
+        bool await_ready() const noexcept
+        {
+            return !handle || handle.done();
+        }
+
+        std::coroutine_handle<> await_suspend(
+                std::coroutine_handle<> awaiting) noexcept
+        {
+            handle.promise().set_continuation(awaiting);
+            return handle;
+        }
+
+        decltype(auto) get_result()
+        {
+            if(!handle)
+            {
+                throw arc::ex::StateError("Task has no coroutine");
+            }
+            return handle.promise().get_result();
+        }
+    };
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    std::coroutine_handle<promise_type> m_handle;
+};
+
+//------------------------------------------------------------------------------
+//                                  DEFINITIONS
+//------------------------------------------------------------------------------
+
+namespace detail
+{
+
+template<typename T>
+inline Task<T> TaskPromise<T>::get_return_object() noexcept
+{
+    return Task<T>(
+        std::coroutine_handle<TaskPromise<T>>::from_promise(*this)
+    );
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept
+{
+    return Task<void>(
+        std::coroutine_handle<TaskPromise<void>>::from_promise(*this)
+    );
+}
+
+} // namespace detail
+
+} // namespace async
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
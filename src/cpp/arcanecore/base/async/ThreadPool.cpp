@@ -0,0 +1,147 @@
+/*!
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "arcanecore/base/async/ThreadPool.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace async
+{
+
+//------------------------------------------------------------------------------
+//                           PRIVATE STATIC ATTRIBUTES
+//------------------------------------------------------------------------------
+
+thread_local ThreadPool* ThreadPool::s_current = nullptr;
+
+//------------------------------------------------------------------------------
+//                                  CONSTRUCTORS
+//------------------------------------------------------------------------------
+
+ThreadPool::ThreadPool(std::size_t thread_count, std::size_t capacity)
+    : m_queue   (capacity)
+    , m_stopping(false)
+{
+    if(thread_count == 0)
+    {
+        thread_count = std::thread::hardware_concurrency();
+        if(thread_count == 0)
+        {
+            thread_count = 1;
+        }
+    }
+
+    m_threads.reserve(thread_count);
+    for(std::size_t i = 0; i < thread_count; ++i)
+    {
+        m_threads.emplace_back(&ThreadPool::run_thread, this);
+    }
+}
+
+//------------------------------------------------------------------------------
+//                                   DESTRUCTOR
+//------------------------------------------------------------------------------
+
+ThreadPool::~ThreadPool()
+{
+    // threads only exit once the queue is empty
+    m_stopping.store(true, std::memory_order_release);
+    m_idle.notify_all();
+    for(std::thread& thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+std::size_t ThreadPool::get_thread_count() const
+{
+    return m_threads.size();
+}
+
+bool ThreadPool::is_current() const
+{
+    return s_current == this;
+}
+
+bool ThreadPool::post(std::coroutine_handle<> handle)
+{
+    if(!m_queue.try_push(handle))
+    {
+        if(is_current())
+        {
+            // the other threads are busy anyway
+            return false;
+        }
+        m_queue.push(handle);
+    }
+    m_idle.notify_one();
+    return true;
+}
+
+//------------------------------------------------------------------------------
+//                            PRIVATE MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+void ThreadPool::run_thread()
+{
+    s_current = this;
+    while(true)
+    {
+        std::coroutine_handle<> handle;
+        m_idle.wait_until([&]()
+        {
+            return m_queue.try_pop(handle) ||
+                   m_stopping.load(std::memory_order_acquire);
+        });
+        if(!handle)
+        {
+            // stopping, but a coroutine may be still being pushed
+            if(m_queue.empty())
+            {
+                break;
+            }
+            continue;
+        }
+        handle.resume();
+    }
+    s_current = nullptr;
+}
+
+} // namespace async
+ARC_BASE_VERSION_NS_END
+} // namespace arc
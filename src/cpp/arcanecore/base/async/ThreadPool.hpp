@@ -0,0 +1,220 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Pool of threads which coroutines can be scheduled onto.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_ASYNC_THREADPOOL_HPP_
+#define ARCANECORE_BASE_ASYNC_THREADPOOL_HPP_
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/lang/MpmcQueue.hpp"
+#include "arcanecore/base/lang/Restrictors.hpp"
+#include "arcanecore/base/lang/WaitStrategy.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace async
+{
+
+/*!
+ * \brief Executor which resumes coroutines on a fixed pool of threads.
+ *
+ * A coroutine moves itself onto the pool by awaiting schedule():
+ *
+ * \code
+ * arc::async::Task<> process(arc::async::ThreadPool& pool)
+ * {
+ *     co_await pool.schedule();
+ *     // now running on a thread of the pool
+ * }
+ * \endcode
+ *
+ * Suspended coroutines are queued as bare coroutine handles in a bounded
+ * lock-free queue, so scheduling never allocates. When the queue is full a
+ * coroutine scheduled from a pool thread continues running on that thread,
+ * while other threads wait for space in the queue.
+ */
+class ThreadPool
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                              PUBLIC CONSTANTS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief The default capacity of the queue of coroutines waiting to be
+     *        resumed.
+     */
+    static const std::size_t DEFAULT_CAPACITY = 4096;
+
+    //--------------------------------------------------------------------------
+    //                               PUBLIC TYPES
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Awaitable returned by schedule().
+     */
+    class ScheduleOperation
+    {
+    public:
+
+        explicit ScheduleOperation(ThreadPool& pool) noexcept
+            : m_pool(pool)
+        {
+        }
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle)
+        {
+            return m_pool.post(handle);
+        }
+
+        void await_resume() const noexcept
+        {
+        }
+
+    private:
+
+        ThreadPool& m_pool;
+    };
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Creates a new pool and starts its threads.
+     *
+     * \param thread_count The number of threads to start, if 0 this will be
+     *                     the number of hardware threads.
+     * \param capacity The capacity of the queue of coroutines waiting to be
+     *                 resumed.
+     */
+    explicit ThreadPool(
+            std::size_t thread_count = 0,
+            std::size_t capacity = DEFAULT_CAPACITY);
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Resumes every queued coroutine, and then stops the threads.
+     */
+    ~ThreadPool();
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns the number of threads of this pool.
+     */
+    std::size_t get_thread_count() const;
+
+    /*!
+     * \brief Returns whether the calling thread is a thread of this pool.
+     */
+    bool is_current() const;
+
+    /*!
+     * \brief Returns an awaitable which resumes the awaiting coroutine on a
+     *        thread of this pool.
+     */
+    ScheduleOperation schedule() noexcept
+    {
+        return ScheduleOperation(*this);
+    }
+
+    /*!
+     * \brief Queues the given suspended coroutine to be resumed on a thread of
+     *        this pool.
+     *
+     * \return False if the queue was full and the calling thread is a thread
+     *         of this pool, in which case the coroutine was not queued and
+     *         the caller should resume it.
+     */
+    bool post(std::coroutine_handle<> handle);
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                         PRIVATE STATIC ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    // the pool the current thread belongs to (null if it is not a pool thread)
+    static thread_local ThreadPool* s_current;
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    // coroutines waiting to be resumed
+    arc::lang::MpmcQueue<std::coroutine_handle<>, arc::lang::SpinWait>
+        m_queue;
+    // idle threads wait on this until a coroutine is queued
+    arc::lang::BlockingWait m_idle;
+    // set when the pool is being destroyed
+    std::atomic<bool> m_stopping;
+    std::vector<std::thread> m_threads;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    // the entry point of pool threads
+    void run_thread();
+};
+
+} // namespace async
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
@@ -0,0 +1,180 @@
+/*!
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "arcanecore/base/async/Timer.hpp"
+
+#include <chrono>
+
+#include "arcanecore/base/clock/ClockOperations.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace async
+{
+
+//------------------------------------------------------------------------------
+//                                SLEEP OPERATION
+//------------------------------------------------------------------------------
+
+bool Timer::SleepOperation::await_ready() const
+{
+    return arc::clock::get_monotonic_time(
+        arc::clock::TimeMetric::kNanoseconds
+    ) >= m_deadline;
+}
+
+//------------------------------------------------------------------------------
+//                                  CONSTRUCTORS
+//------------------------------------------------------------------------------
+
+Timer::Timer(ThreadPool* pool)
+    : m_pool         (pool)
+    , m_next_sequence(0)
+    , m_stopping     (false)
+{
+    m_thread = std::thread(&Timer::run, this);
+}
+
+//------------------------------------------------------------------------------
+//                                   DESTRUCTOR
+//------------------------------------------------------------------------------
+
+Timer::~Timer()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_condition.notify_one();
+    m_thread.join();
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+Timer::SleepOperation Timer::sleep_for(
+        arc::clock::TimeInt duration,
+        arc::clock::TimeMetric metric)
+{
+    return SleepOperation(
+        *this,
+        arc::clock::get_monotonic_time(arc::clock::TimeMetric::kNanoseconds) +
+            duration * static_cast<arc::clock::TimeInt>(metric)
+    );
+}
+
+Timer::SleepOperation Timer::sleep_until(
+        arc::clock::TimeInt deadline,
+        arc::clock::TimeMetric metric)
+{
+    return SleepOperation(
+        *this,
+        deadline * static_cast<arc::clock::TimeInt>(metric)
+    );
+}
+
+std::size_t Timer::get_pending_count() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+//------------------------------------------------------------------------------
+//                            PRIVATE MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+void Timer::add(arc::clock::TimeInt deadline, std::coroutine_handle<> handle)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const bool earliest =
+        m_entries.empty() || deadline < m_entries.top().deadline;
+    m_entries.push(Entry{deadline, m_next_sequence++, handle});
+    // the timer's thread only needs to wake if it must sleep for less time.
+    // This is notified with the lock held since once the entry is visible
+    // the coroutine may be resumed and the timer destroyed.
+    if(earliest)
+    {
+        m_condition.notify_one();
+    }
+}
+
+void Timer::resume(std::coroutine_handle<> handle)
+{
+    if(m_pool == nullptr || !m_pool->post(handle))
+    {
+        handle.resume();
+    }
+}
+
+void Timer::run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while(true)
+    {
+        if(m_entries.empty())
+        {
+            if(m_stopping)
+            {
+                return;
+            }
+            m_condition.wait(lock);
+            continue;
+        }
+
+        const arc::clock::TimeInt now = arc::clock::get_monotonic_time(
+            arc::clock::TimeMetric::kNanoseconds
+        );
+        const Entry& entry = m_entries.top();
+        if(entry.deadline <= now || m_stopping)
+        {
+            const std::coroutine_handle<> handle = entry.handle;
+            m_entries.pop();
+            // the coroutine may sleep again, which locks the mutex
+            lock.unlock();
+            resume(handle);
+            lock.lock();
+            continue;
+        }
+
+        m_condition.wait_for(
+            lock,
+            std::chrono::nanoseconds(entry.deadline - now)
+        );
+    }
+}
+
+} // namespace async
+ARC_BASE_VERSION_NS_END
+} // namespace arc
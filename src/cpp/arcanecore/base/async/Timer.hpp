@@ -0,0 +1,226 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Awaitable timer which resumes coroutines after a deadline.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_ASYNC_TIMER_HPP_
+#define ARCANECORE_BASE_ASYNC_TIMER_HPP_
+
+#include <condition_variable>
+#include <coroutine>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/async/ThreadPool.hpp"
+#include "arcanecore/base/clock/ClockDefinitions.hpp"
+#include "arcanecore/base/lang/Restrictors.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace async
+{
+
+/*!
+ * \brief Suspends coroutines until a deadline measured by
+ *        arc::clock::get_monotonic_time().
+ *
+ * The timer runs a thread which sleeps until the earliest deadline. Expired
+ * coroutines are posted to the arc::async::ThreadPool given to the
+ * constructor, or if there is no pool are resumed on the timer's thread (in
+ * which case they should move onto another executor before doing any real
+ * work, since they delay every later deadline).
+ *
+ * \code
+ * arc::async::Timer timer(&pool);
+ * // ...
+ * co_await timer.sleep_for(250, arc::clock::TimeMetric::kMilliseconds);
+ * \endcode
+ */
+class Timer
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                               PUBLIC TYPES
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Awaitable returned by sleep_for() and sleep_until().
+     */
+    class SleepOperation
+    {
+    public:
+
+        SleepOperation(Timer& timer, arc::clock::TimeInt deadline) noexcept
+            : m_timer   (timer)
+            , m_deadline(deadline)
+        {
+        }
+
+        bool await_ready() const;
+
+        void await_suspend(std::coroutine_handle<> handle)
+        {
+            m_timer.add(m_deadline, handle);
+        }
+
+        void await_resume() const noexcept
+        {
+        }
+
+    private:
+
+        Timer& m_timer;
+        // the deadline in nanoseconds
+        const arc::clock::TimeInt m_deadline;
+    };
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Creates a new timer and starts its thread.
+     *
+     * \param pool The pool expired coroutines are resumed on, if null they
+     *             are resumed on the timer's thread. The pool must outlive
+     *             this timer.
+     */
+    explicit Timer(ThreadPool* pool = nullptr);
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Resumes any sleeping coroutines early, and then stops the
+     *        timer's thread.
+     */
+    ~Timer();
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns an awaitable which suspends the awaiting coroutine for at
+     *        least the given duration.
+     */
+    SleepOperation sleep_for(
+            arc::clock::TimeInt duration,
+            arc::clock::TimeMetric metric =
+                arc::clock::TimeMetric::kMilliseconds);
+
+    /*!
+     * \brief Returns an awaitable which suspends the awaiting coroutine until
+     *        arc::clock::get_monotonic_time() reaches the given deadline.
+     */
+    SleepOperation sleep_until(
+            arc::clock::TimeInt deadline,
+            arc::clock::TimeMetric metric =
+                arc::clock::TimeMetric::kMilliseconds);
+
+    /*!
+     * \brief Returns the number of coroutines that are currently sleeping.
+     */
+    std::size_t get_pending_count() const;
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                               PRIVATE TYPES
+    //--------------------------------------------------------------------------
+
+    // a sleeping coroutine
+    struct Entry
+    {
+        arc::clock::TimeInt deadline;
+        // orders entries with the same deadline by when they were added
+        std::uint64_t sequence;
+        std::coroutine_handle<> handle;
+
+        bool operator>(const Entry& other) const
+        {
+            if(deadline != other.deadline)
+            {
+                return deadline > other.deadline;
+            }
+            return sequence > other.sequence;
+        }
+    };
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    ThreadPool* const m_pool;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_condition;
+    // the sleeping coroutines ordered by earliest deadline
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>>
+        m_entries;
+    std::uint64_t m_next_sequence;
+    bool m_stopping;
+    std::thread m_thread;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    // adds a coroutine which should be resumed at the given deadline (in
+    // nanoseconds)
+    void add(arc::clock::TimeInt deadline, std::coroutine_handle<> handle);
+
+    // resumes the given expired coroutine
+    void resume(std::coroutine_handle<> handle);
+
+    // the entry point of the timer's thread
+    void run();
+};
+
+} // namespace async
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
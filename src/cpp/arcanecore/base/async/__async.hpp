@@ -0,0 +1,85 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Documents the arc::async namespace.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_ASYNC_HPP_
+#define ARCANECORE_BASE_ASYNC_HPP_
+
+#include "arcanecore/base/BaseAPI.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+
+/*!
+ * \brief Module of C++20 coroutine types for writing asynchronous code.
+ *
+ * This module is only built when the project is configured with
+ * ```ARC_ENABLE_ASYNC``` (which builds the whole library as C++20).
+ *
+ * Coroutines return an arc::async::Task, which does not start until it is
+ * awaited. A coroutine moves itself onto an arc::async::ThreadPool by
+ * awaiting its schedule() operation, and can sleep using an
+ * arc::async::Timer:
+ *
+ * \code
+ * arc::async::Task<int> handle_request(
+ *         arc::async::ThreadPool& pool,
+ *         arc::async::Timer& timer)
+ * {
+ *     co_await pool.schedule();
+ *     co_await timer.sleep_for(10);
+ *     co_return 42;
+ * }
+ *
+ * int result = arc::async::sync_wait(handle_request(pool, timer));
+ * \endcode
+ *
+ * Awaiting a task transfers control directly to it, and a finished task
+ * transfers control directly back to its awaiter (symmetric transfer), so
+ * deep chains of ```co_await``` do not grow the stack (note compilers may only
+ * implement the transfer as a tail call in optimized builds). When
+ * ```ARC_ASYNC_POOLED_FRAMES``` is enabled coroutine frames are allocated
+ * from arc::async::FrameAllocator rather than the global heap.
+ */
+namespace async
+{
+} // namespace async
+
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
@@ -34,10 +34,11 @@
 
 #include <chrono>
 #include <ctime>
+#include <utility>
 
 #include "arcanecore/base/Exceptions.hpp"
+#include "arcanecore/base/Preproc.hpp"
 
-// TODO: need the OS definitions
 // allows us to use std::localtime, without warning it's unsafe.
 #ifdef ARC_OS_WINDOWS
     #pragma warning(disable : 4996) //_CRT_SECURE_NO_WARNINGS
@@ -59,10 +60,29 @@ TimeInt get_current_time(TimeMetric metric)
     ) / static_cast<TimeInt>(metric);
 }
 
+TimeInt get_monotonic_time(TimeMetric metric)
+{
+    return static_cast<TimeInt>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()
+            ).count()
+    ) / static_cast<TimeInt>(metric);
+}
+
 deus::UnicodeStorage get_timestamp(
         TimeInt t,
         const deus::UnicodeView& format,
         TimeMetric metric)
+{
+    arc::Result<deus::UnicodeStorage> result =
+        try_get_timestamp(t, format, metric);
+    return std::move(result.get_or_throw());
+}
+
+arc::Result<deus::UnicodeStorage> try_get_timestamp(
+        TimeInt t,
+        const deus::UnicodeView& format,
+        TimeMetric metric)
 {
     // convert input to time_t
     TimeInt to_time_t =
@@ -92,7 +112,8 @@ deus::UnicodeStorage get_timestamp(
     if(size == 0)
     {
         delete[] buffer;
-        throw arc::ex::RuntimeError(
+        return arc::ex::Error(
+            arc::ex::ErrorCode::kRuntimeError,
             "Encountered unexpected error calling strftime within: "
             "arc::clock::get_timestamp"
         );
@@ -105,7 +126,7 @@ deus::UnicodeStorage get_timestamp(
     {
         return ret.get_view().convert(format.encoding());
     }
-    return ret;
+    return std::move(ret);
 }
 
 } // namespace clock
@@ -41,6 +41,7 @@
 #include <deus/UnicodeView.hpp>
 
 #include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/Result.hpp"
 #include "arcanecore/base/clock/ClockDefinitions.hpp"
 
 
@@ -57,6 +58,17 @@ namespace clock
  */
 TimeInt get_current_time(TimeMetric metric = TimeMetric::kMilliseconds);
 
+/*!
+ * \brief Returns the time elapsed since an unspecified point in the past,
+ *        from a clock which never goes backwards.
+ *
+ * Unlike get_current_time() this is not affected by changes to the system
+ * time, so it should be used for measuring intervals and deadlines.
+ *
+ * \param metric The time measurement metric the result will be returned in.
+ */
+TimeInt get_monotonic_time(TimeMetric metric = TimeMetric::kMilliseconds);
+
 /*!
  * \brief Returns the current the given time as a formated string.
  *
@@ -73,6 +85,19 @@ deus::UnicodeStorage get_timestamp(
             deus::UnicodeView("%Y/%m/%d - %H:%M:%S", deus::Encoding::kASCII),
         TimeMetric metric = TimeMetric::kMilliseconds);
 
+/*!
+ * \brief Non-throwing variant of arc::clock::get_timestamp().
+ *
+ * \return The formatted string, or an error with the code
+ *         arc::ex::ErrorCode::kRuntimeError if the time could not be
+ *         formatted.
+ */
+arc::Result<deus::UnicodeStorage> try_get_timestamp(
+        TimeInt t,
+        const deus::UnicodeView& format =
+            deus::UnicodeView("%Y/%m/%d - %H:%M:%S", deus::Encoding::kASCII),
+        TimeMetric metric = TimeMetric::kMilliseconds);
+
 } // namespace clock
 ARC_BASE_VERSION_NS_END
 } // namespace arc
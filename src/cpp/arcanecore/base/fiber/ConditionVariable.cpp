@@ -0,0 +1,89 @@
+/*!
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "arcanecore/base/fiber/ConditionVariable.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace fiber
+{
+
+//------------------------------------------------------------------------------
+//                            PUBLIC MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+void ConditionVariable::wait(std::unique_lock<Mutex>& lock)
+{
+    Waiter waiter;
+    m_mutex.lock();
+    m_waiters.push(&waiter);
+    // a notification can't be missed since the waiter is queued before the
+    // lock is released
+    lock.unlock();
+    waiter.wait(m_mutex);
+    lock.lock();
+}
+
+void ConditionVariable::notify_one()
+{
+    Waiter* waiter = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        waiter = m_waiters.pop();
+    }
+    if(waiter != nullptr)
+    {
+        waiter->wake();
+    }
+}
+
+void ConditionVariable::notify_all()
+{
+    Waiter* waiter = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        waiter = m_waiters.pop_all();
+    }
+    while(waiter != nullptr)
+    {
+        // the waiter may be destroyed once it is woken
+        Waiter* next = waiter->next;
+        waiter->wake();
+        waiter = next;
+    }
+}
+
+} // namespace fiber
+ARC_BASE_VERSION_NS_END
+} // namespace arc
@@ -0,0 +1,124 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Condition variable which suspends fibers rather than blocking
+ *        threads.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_FIBER_CONDITIONVARIABLE_HPP_
+#define ARCANECORE_BASE_FIBER_CONDITIONVARIABLE_HPP_
+
+#include <mutex>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/fiber/Mutex.hpp"
+#include "arcanecore/base/fiber/Waiter.hpp"
+#include "arcanecore/base/lang/Restrictors.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace fiber
+{
+
+/*!
+ * \brief Condition variable for fibers, used with an arc::fiber::Mutex.
+ *
+ * Waiting fibers are suspended rather than blocking their worker thread.
+ * Threads which are not fibers may also wait, in which case they sleep.
+ * Waiters are woken in FIFO order, and there are no spurious wake ups
+ * (although the condition should still be checked in a loop since another
+ * waiter may have changed it first).
+ *
+ * \code
+ * std::unique_lock<arc::fiber::Mutex> lock(mutex);
+ * condition.wait(lock, [&]() { return !queue.empty(); });
+ * \endcode
+ */
+class ConditionVariable
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Unlocks the given lock and suspends the calling fiber (or blocks
+     *        the calling thread) until notified, after which the lock is
+     *        reacquired.
+     */
+    void wait(std::unique_lock<Mutex>& lock);
+
+    /*!
+     * \brief Waits until the given predicate returns true.
+     */
+    template<typename Predicate>
+    void wait(std::unique_lock<Mutex>& lock, Predicate predicate)
+    {
+        while(!predicate())
+        {
+            wait(lock);
+        }
+    }
+
+    /*!
+     * \brief Wakes the waiter which has been waiting the longest, if any.
+     */
+    void notify_one();
+
+    /*!
+     * \brief Wakes every waiter.
+     */
+    void notify_all();
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    // guards the waiters
+    std::mutex m_mutex;
+    WaitQueue m_waiters;
+};
+
+} // namespace fiber
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
@@ -0,0 +1,222 @@
+/*!
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "arcanecore/base/fiber/Context.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+#include "arcanecore/base/Preproc.hpp"
+
+#if !defined(ARC_OS_UNIX) || (!defined(__x86_64__) && !defined(__aarch64__))
+    #error "arc::fiber does not support this platform"
+#endif
+
+// the assembly name of a C function
+#ifdef ARC_OS_MAC
+    #define ARC_FIBER_SYMBOL(name) "_" #name
+    #define ARC_FIBER_FUNCTION(name) \
+        ".globl " ARC_FIBER_SYMBOL(name) "\n" \
+        ".p2align 4\n" \
+        ARC_FIBER_SYMBOL(name) ":\n"
+    #define ARC_FIBER_END(name)
+#else
+    #define ARC_FIBER_SYMBOL(name) #name
+    #define ARC_FIBER_FUNCTION(name) \
+        ".globl " ARC_FIBER_SYMBOL(name) "\n" \
+        ".type " ARC_FIBER_SYMBOL(name) ", %function\n" \
+        ".p2align 4\n" \
+        ARC_FIBER_SYMBOL(name) ":\n"
+    #define ARC_FIBER_END(name) \
+        ".size " ARC_FIBER_SYMBOL(name) ", .-" ARC_FIBER_SYMBOL(name) "\n"
+#endif
+
+//------------------------------------------------------------------------------
+//                                    ASSEMBLY
+//------------------------------------------------------------------------------
+
+// Saves the callee-saved registers of the calling context on its stack,
+// stores its stack pointer in *from, and then loads the stack pointer to and
+// restores the registers saved there, returning into the resumed context.
+//
+// The trampoline is the first code run by a new context, it calls the entry
+// function with the argument both of which are stored in callee-saved
+// registers by make_context(). It is marked as the outermost frame so that
+// unwinders stop there.
+
+extern "C" void arc_fiber_trampoline();
+
+#if defined(__x86_64__)
+
+// stack layout of a suspended context, from the stack pointer upwards:
+// x87 control word, MXCSR, r15, r14, r13, r12, rbx, rbp, return address
+__asm__(
+    ".text\n"
+    ARC_FIBER_FUNCTION(arc_fiber_switch_context)
+    "    pushq %rbp\n"
+    "    pushq %rbx\n"
+    "    pushq %r12\n"
+    "    pushq %r13\n"
+    "    pushq %r14\n"
+    "    pushq %r15\n"
+    "    subq $16, %rsp\n"
+    "    stmxcsr 8(%rsp)\n"
+    "    fnstcw (%rsp)\n"
+    "    movq %rsp, (%rdi)\n"
+    "    movq %rsi, %rsp\n"
+    "    fldcw (%rsp)\n"
+    "    ldmxcsr 8(%rsp)\n"
+    "    addq $16, %rsp\n"
+    "    popq %r15\n"
+    "    popq %r14\n"
+    "    popq %r13\n"
+    "    popq %r12\n"
+    "    popq %rbx\n"
+    "    popq %rbp\n"
+    "    ret\n"
+    ARC_FIBER_END(arc_fiber_switch_context)
+
+    ARC_FIBER_FUNCTION(arc_fiber_trampoline)
+    "    .cfi_startproc\n"
+    "    .cfi_undefined rip\n"
+    "    movq %r13, %rdi\n"
+    "    callq *%r12\n"
+    "    ud2\n"
+    "    .cfi_endproc\n"
+    ARC_FIBER_END(arc_fiber_trampoline)
+);
+
+#elif defined(__aarch64__)
+
+// stack layout of a suspended context, from the stack pointer upwards:
+// d8-d15, x19-x28, x29 (frame pointer), x30 (return address)
+__asm__(
+    ".text\n"
+    ARC_FIBER_FUNCTION(arc_fiber_switch_context)
+    "    sub sp, sp, #0xa0\n"
+    "    stp d8, d9, [sp, #0x00]\n"
+    "    stp d10, d11, [sp, #0x10]\n"
+    "    stp d12, d13, [sp, #0x20]\n"
+    "    stp d14, d15, [sp, #0x30]\n"
+    "    stp x19, x20, [sp, #0x40]\n"
+    "    stp x21, x22, [sp, #0x50]\n"
+    "    stp x23, x24, [sp, #0x60]\n"
+    "    stp x25, x26, [sp, #0x70]\n"
+    "    stp x27, x28, [sp, #0x80]\n"
+    "    stp x29, x30, [sp, #0x90]\n"
+    "    mov x9, sp\n"
+    "    str x9, [x0]\n"
+    "    mov sp, x1\n"
+    "    ldp d8, d9, [sp, #0x00]\n"
+    "    ldp d10, d11, [sp, #0x10]\n"
+    "    ldp d12, d13, [sp, #0x20]\n"
+    "    ldp d14, d15, [sp, #0x30]\n"
+    "    ldp x19, x20, [sp, #0x40]\n"
+    "    ldp x21, x22, [sp, #0x50]\n"
+    "    ldp x23, x24, [sp, #0x60]\n"
+    "    ldp x25, x26, [sp, #0x70]\n"
+    "    ldp x27, x28, [sp, #0x80]\n"
+    "    ldp x29, x30, [sp, #0x90]\n"
+    "    add sp, sp, #0xa0\n"
+    "    ret\n"
+    ARC_FIBER_END(arc_fiber_switch_context)
+
+    ARC_FIBER_FUNCTION(arc_fiber_trampoline)
+    "    .cfi_startproc\n"
+    "    .cfi_undefined x30\n"
+    "    mov x0, x20\n"
+    "    blr x19\n"
+    "    brk #0\n"
+    "    .cfi_endproc\n"
+    ARC_FIBER_END(arc_fiber_trampoline)
+);
+
+#endif
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace fiber
+{
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+void make_context(
+        Context& context,
+        void* stack_top,
+        void (*entry)(void*),
+        void* argument)
+{
+    // the stack must be 16 byte aligned at calls on both architectures
+    std::uintptr_t top = reinterpret_cast<std::uintptr_t>(stack_top);
+    top &= ~static_cast<std::uintptr_t>(15);
+
+    #if defined(__x86_64__)
+
+        // the frame is laid out so the stack is aligned when the trampoline
+        // makes its call
+        std::uint64_t* frame = reinterpret_cast<std::uint64_t*>(top - 16 - 72);
+        std::memset(frame, 0, 72);
+        // new contexts inherit the floating point settings of their creator
+        std::uint16_t control_word = 0;
+        std::uint32_t mxcsr = 0;
+        __asm__ __volatile__("fnstcw %0" : "=m"(control_word));
+        __asm__ __volatile__("stmxcsr %0" : "=m"(mxcsr));
+        std::memcpy(&frame[0], &control_word, sizeof(control_word));
+        std::memcpy(&frame[1], &mxcsr, sizeof(mxcsr));
+        // r13 and r12
+        frame[4] = reinterpret_cast<std::uint64_t>(argument);
+        frame[5] = reinterpret_cast<std::uint64_t>(entry);
+        // rbp is left null to terminate frame pointer chains
+        frame[8] = reinterpret_cast<std::uint64_t>(&arc_fiber_trampoline);
+
+    #elif defined(__aarch64__)
+
+        std::uint64_t* frame = reinterpret_cast<std::uint64_t*>(top - 0xA0);
+        std::memset(frame, 0, 0xA0);
+        // x19 and x20
+        frame[8] = reinterpret_cast<std::uint64_t>(entry);
+        frame[9] = reinterpret_cast<std::uint64_t>(argument);
+        // x29 is left null to terminate frame pointer chains, x30
+        frame[19] = reinterpret_cast<std::uint64_t>(&arc_fiber_trampoline);
+
+    #endif
+
+    context.stack_pointer = frame;
+}
+
+} // namespace fiber
+ARC_BASE_VERSION_NS_END
+} // namespace arc
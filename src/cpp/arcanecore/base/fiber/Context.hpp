@@ -0,0 +1,97 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Low level switching between execution contexts.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_FIBER_CONTEXT_HPP_
+#define ARCANECORE_BASE_FIBER_CONTEXT_HPP_
+
+#include <cstddef>
+
+#include "arcanecore/base/BaseAPI.hpp"
+
+
+// implemented in assembly by Context.cpp
+extern "C" void arc_fiber_switch_context(void** from, void* to);
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace fiber
+{
+
+/*!
+ * \brief The saved execution state of a suspended fiber or thread.
+ *
+ * The callee-saved registers of a suspended context are stored on its own
+ * stack, so the context itself is just the suspended stack pointer.
+ */
+struct Context
+{
+    void* stack_pointer;
+};
+
+/*!
+ * \brief Initializes the given context so that switching to it calls
+ *        ```entry(argument)``` on the given stack.
+ *
+ * The entry function must never return, it must instead switch to another
+ * context which never switches back.
+ *
+ * \param stack_top The highest address of the stack (stacks grow down).
+ */
+void make_context(
+        Context& context,
+        void* stack_top,
+        void (*entry)(void*),
+        void* argument);
+
+/*!
+ * \brief Saves the current execution state into ```from```, and resumes the
+ *        execution state saved in ```to```.
+ *
+ * This returns when another context switches back to ```from```, which may
+ * be on a different thread.
+ */
+inline void switch_context(Context& from, const Context& to)
+{
+    arc_fiber_switch_context(&from.stack_pointer, to.stack_pointer);
+}
+
+} // namespace fiber
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
@@ -0,0 +1,94 @@
+/*!
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "arcanecore/base/fiber/Mutex.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace fiber
+{
+
+//------------------------------------------------------------------------------
+//                                  CONSTRUCTORS
+//------------------------------------------------------------------------------
+
+Mutex::Mutex()
+    : m_state(UNLOCKED)
+{
+}
+
+//------------------------------------------------------------------------------
+//                            PRIVATE MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+void Mutex::lock_slow()
+{
+    m_waiters_mutex.lock();
+    // marking the mutex as contended forces the owner to take the slow path
+    // when it unlocks, which needs the waiters mutex held here
+    if(m_state.exchange(CONTENDED, std::memory_order_acquire) == UNLOCKED)
+    {
+        m_waiters_mutex.unlock();
+        return;
+    }
+
+    Waiter waiter;
+    m_waiters.push(&waiter);
+    // ownership is handed to this waiter when it is woken
+    waiter.wait(m_waiters_mutex);
+}
+
+void Mutex::unlock_slow()
+{
+    m_waiters_mutex.lock();
+    Waiter* waiter = m_waiters.pop();
+    if(waiter == nullptr)
+    {
+        m_state.store(UNLOCKED, std::memory_order_release);
+        m_waiters_mutex.unlock();
+        return;
+    }
+
+    // hand the lock to the waiter without unlocking it
+    m_state.store(
+        m_waiters.empty() ? LOCKED : CONTENDED,
+        std::memory_order_relaxed
+    );
+    m_waiters_mutex.unlock();
+    waiter->wake();
+}
+
+} // namespace fiber
+ARC_BASE_VERSION_NS_END
+} // namespace arc
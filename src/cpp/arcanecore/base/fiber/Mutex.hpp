@@ -0,0 +1,169 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Mutex which suspends fibers rather than blocking threads.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_FIBER_MUTEX_HPP_
+#define ARCANECORE_BASE_FIBER_MUTEX_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/fiber/Waiter.hpp"
+#include "arcanecore/base/lang/Restrictors.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace fiber
+{
+
+/*!
+ * \brief Mutual exclusion lock for fibers.
+ *
+ * A fiber which fails to acquire the lock is suspended, leaving its worker
+ * thread free to run other fibers, rather than blocking the thread. Threads
+ * which are not fibers may also use the lock, in which case they sleep.
+ *
+ * Locking and unlocking an uncontended mutex is a single atomic operation.
+ * When the mutex is unlocked with waiters, ownership is handed directly to the
+ * first waiter in FIFO order. Unlike std::mutex, the mutex may be unlocked on
+ * a different thread to the one that locked it (which happens when a fiber
+ * is resumed on another worker).
+ *
+ * This meets the requirements of Lockable, so can be used with
+ * std::lock_guard and std::unique_lock.
+ */
+class Mutex
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    Mutex();
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Acquires the lock, suspending the calling fiber (or blocking the
+     *        calling thread) until it is available.
+     */
+    void lock()
+    {
+        std::uint32_t expected = UNLOCKED;
+        if(!m_state.compare_exchange_strong(
+                expected,
+                LOCKED,
+                std::memory_order_acquire,
+                std::memory_order_relaxed))
+        {
+            lock_slow();
+        }
+    }
+
+    /*!
+     * \brief Acquires the lock if it is available without waiting.
+     *
+     * \return Whether the lock was acquired.
+     */
+    bool try_lock()
+    {
+        std::uint32_t expected = UNLOCKED;
+        return m_state.compare_exchange_strong(
+            expected,
+            LOCKED,
+            std::memory_order_acquire,
+            std::memory_order_relaxed
+        );
+    }
+
+    /*!
+     * \brief Releases the lock, which must be held by the caller.
+     */
+    void unlock()
+    {
+        std::uint32_t expected = LOCKED;
+        if(!m_state.compare_exchange_strong(
+                expected,
+                UNLOCKED,
+                std::memory_order_release,
+                std::memory_order_relaxed))
+        {
+            unlock_slow();
+        }
+    }
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE CONSTANTS
+    //--------------------------------------------------------------------------
+
+    static const std::uint32_t UNLOCKED = 0;
+    static const std::uint32_t LOCKED = 1;
+    // locked, and there may be waiters
+    static const std::uint32_t CONTENDED = 2;
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    std::atomic<std::uint32_t> m_state;
+    // guards the waiters
+    std::mutex m_waiters_mutex;
+    WaitQueue m_waiters;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    void lock_slow();
+    void unlock_slow();
+};
+
+} // namespace fiber
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
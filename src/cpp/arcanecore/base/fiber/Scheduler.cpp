@@ -0,0 +1,509 @@
+/*!
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "arcanecore/base/fiber/Scheduler.hpp"
+
+#include <cstdint>
+#include <exception>
+#include <mutex>
+
+#include "arcanecore/base/Exceptions.hpp"
+#include "arcanecore/base/fiber/Context.hpp"
+
+// prevents the compiler from caching the address of thread local storage
+// across a context switch, after which the fiber may be on another thread
+#if defined(__GNUC__) || defined(__clang__)
+    #define ARC_FIBER_NOINLINE __attribute__((noinline))
+#else
+    #define ARC_FIBER_NOINLINE
+#endif
+
+// ThreadSanitizer must be told about context switches
+#if defined(__SANITIZE_THREAD__)
+    #define ARC_FIBER_TSAN
+#elif defined(__has_feature)
+    #if __has_feature(thread_sanitizer)
+        #define ARC_FIBER_TSAN
+    #endif
+#endif
+#ifdef ARC_FIBER_TSAN
+    #include <sanitizer/tsan_interface.h>
+#endif
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace fiber
+{
+
+namespace
+{
+
+//------------------------------------------------------------------------------
+//                                   CONSTANTS
+//------------------------------------------------------------------------------
+
+// the stack space that must remain below a fiber's closure
+static const std::size_t MIN_FREE_STACK = 4096;
+
+// the states of a fiber with respect to suspension
+static const std::uint32_t RUNNING = 0;
+static const std::uint32_t SUSPENDED = 1;
+// woken before its worker finished suspending it
+static const std::uint32_t WOKEN = 2;
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                 PRIVATE TYPES
+//------------------------------------------------------------------------------
+
+// stored at the top of the fiber's stack
+struct Scheduler::Fiber
+{
+    // the saved state of the fiber while it is not running
+    Context context;
+    Stack stack;
+    Scheduler* scheduler;
+    // the next fiber in the run queue
+    Fiber* next;
+    // whether the fiber has been suspended and then woken
+    std::atomic<std::uint32_t> state;
+    // runs and destroys the closure
+    void (*run)(void*);
+    void* closure;
+    #ifdef ARC_FIBER_TSAN
+        void* tsan_fiber;
+    #endif
+};
+
+struct Scheduler::RunQueue
+{
+    std::mutex mutex;
+    Fiber* head;
+    Fiber* tail;
+    // allows checking whether the queue is empty without locking it
+    std::atomic<std::size_t> size;
+
+    RunQueue()
+        : head(nullptr)
+        , tail(nullptr)
+        , size(0)
+    {
+    }
+
+    void push(Fiber* fiber)
+    {
+        fiber->next = nullptr;
+        std::lock_guard<std::mutex> lock(mutex);
+        if(tail != nullptr)
+        {
+            tail->next = fiber;
+        }
+        else
+        {
+            head = fiber;
+        }
+        tail = fiber;
+        size.store(size.load(std::memory_order_relaxed) + 1);
+    }
+
+    Fiber* pop()
+    {
+        if(size.load() == 0)
+        {
+            return nullptr;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        Fiber* fiber = head;
+        if(fiber != nullptr)
+        {
+            head = fiber->next;
+            if(head == nullptr)
+            {
+                tail = nullptr;
+            }
+            size.store(size.load(std::memory_order_relaxed) - 1);
+        }
+        return fiber;
+    }
+};
+
+struct Scheduler::Worker
+{
+    Scheduler* scheduler;
+    // the index of the worker in the scheduler
+    const std::size_t index;
+    RunQueue queue;
+    // the saved state of the worker thread while it is running a fiber
+    Context context;
+    // the fiber the worker is running
+    Fiber* current;
+    // what the current fiber asked to be done once it switched back
+    Action action;
+    #ifdef ARC_FIBER_TSAN
+        void* tsan_fiber;
+    #endif
+
+    Worker(Scheduler* scheduler_, std::size_t index_)
+        : scheduler(scheduler_)
+        , index    (index_)
+        , current  (nullptr)
+        , action   (Action::kYield)
+    {
+    }
+};
+
+//------------------------------------------------------------------------------
+//                           PRIVATE STATIC ATTRIBUTES
+//------------------------------------------------------------------------------
+
+thread_local Scheduler::Worker* Scheduler::s_current_worker = nullptr;
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+void yield()
+{
+    if(Scheduler::get_current_fiber() == nullptr)
+    {
+        std::this_thread::yield();
+        return;
+    }
+    Scheduler::suspend(Scheduler::Action::kYield);
+}
+
+bool in_fiber()
+{
+    return Scheduler::get_current_fiber() != nullptr;
+}
+
+//------------------------------------------------------------------------------
+//                                  CONSTRUCTORS
+//------------------------------------------------------------------------------
+
+Scheduler::Scheduler(
+        std::size_t thread_count,
+        std::size_t stack_size,
+        bool guard_pages)
+    : m_stacks     (stack_size, guard_pages)
+    , m_injected   (new RunQueue())
+    , m_fiber_count(0)
+    , m_stopping   (false)
+{
+    if(thread_count == 0)
+    {
+        thread_count = std::thread::hardware_concurrency();
+        if(thread_count == 0)
+        {
+            thread_count = 1;
+        }
+    }
+
+    // all workers must exist before any thread starts stealing
+    m_workers.reserve(thread_count);
+    for(std::size_t i = 0; i < thread_count; ++i)
+    {
+        m_workers.emplace_back(new Worker(this, i));
+    }
+
+    m_threads.reserve(thread_count);
+    for(std::size_t i = 0; i < thread_count; ++i)
+    {
+        m_threads.emplace_back(
+            &Scheduler::run_worker,
+            this,
+            m_workers[i].get()
+        );
+    }
+}
+
+//------------------------------------------------------------------------------
+//                                   DESTRUCTOR
+//------------------------------------------------------------------------------
+
+Scheduler::~Scheduler()
+{
+    // workers only exit once every fiber has finished
+    m_stopping.store(true, std::memory_order_release);
+    m_idle.notify_all();
+    for(std::thread& thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC STATIC FUNCTIONS
+//------------------------------------------------------------------------------
+
+Scheduler* Scheduler::get_current()
+{
+    Fiber* fiber = get_current_fiber();
+    return fiber != nullptr ? fiber->scheduler : nullptr;
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+std::size_t Scheduler::get_thread_count() const
+{
+    return m_workers.size();
+}
+
+std::size_t Scheduler::get_fiber_count() const
+{
+    return m_fiber_count.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+//                            PRIVATE STATIC FUNCTIONS
+//------------------------------------------------------------------------------
+
+ARC_FIBER_NOINLINE Scheduler::Worker* Scheduler::get_current_worker()
+{
+    return s_current_worker;
+}
+
+ARC_FIBER_NOINLINE Scheduler::Fiber* Scheduler::get_current_fiber()
+{
+    Worker* worker = get_current_worker();
+    return worker != nullptr ? worker->current : nullptr;
+}
+
+void Scheduler::suspend(Action action)
+{
+    Worker* worker = get_current_worker();
+    Fiber* fiber = worker->current;
+    worker->action = action;
+    #ifdef ARC_FIBER_TSAN
+        __tsan_switch_to_fiber(worker->tsan_fiber, 0);
+    #endif
+    switch_context(fiber->context, worker->context);
+    // this may now be running on a different worker
+}
+
+void Scheduler::run_fiber(void* fiber)
+{
+    Fiber* self = static_cast<Fiber*>(fiber);
+    try
+    {
+        self->run(self->closure);
+    }
+    catch(...)
+    {
+        std::terminate();
+    }
+    suspend(Action::kFinish);
+}
+
+void Scheduler::wake(Fiber* fiber)
+{
+    // if the fiber's worker hasn't finished suspending it yet, the worker
+    // makes it ready instead
+    if(fiber->state.exchange(WOKEN, std::memory_order_acq_rel) == SUSPENDED)
+    {
+        fiber->state.store(RUNNING, std::memory_order_relaxed);
+        fiber->scheduler->make_ready(fiber);
+    }
+}
+
+//------------------------------------------------------------------------------
+//                            PRIVATE MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+Scheduler::Fiber* Scheduler::create_fiber(
+        std::size_t closure_size,
+        std::size_t closure_alignment,
+        void (*run)(void*),
+        void*& out_closure)
+{
+    const Stack stack = m_stacks.allocate();
+
+    // the fiber is at the top of the stack, followed by the closure
+    std::uintptr_t top = reinterpret_cast<std::uintptr_t>(stack.get_top());
+    top = (top - sizeof(Fiber)) & ~(alignof(Fiber) - 1);
+    std::uintptr_t closure =
+        (top - closure_size) & ~(closure_alignment - 1);
+    if(closure - reinterpret_cast<std::uintptr_t>(stack.base) <
+       MIN_FREE_STACK)
+    {
+        m_stacks.deallocate(stack);
+        throw arc::ex::ValueError(
+            "Fiber function is too large for the fiber's stack"
+        );
+    }
+
+    Fiber* fiber = new(reinterpret_cast<void*>(top)) Fiber();
+    fiber->stack = stack;
+    fiber->scheduler = this;
+    fiber->next = nullptr;
+    fiber->state.store(RUNNING, std::memory_order_relaxed);
+    fiber->run = run;
+    fiber->closure = reinterpret_cast<void*>(closure);
+    #ifdef ARC_FIBER_TSAN
+        fiber->tsan_fiber = __tsan_create_fiber(0);
+    #endif
+    make_context(
+        fiber->context,
+        fiber->closure,
+        &Scheduler::run_fiber,
+        fiber
+    );
+
+    m_fiber_count.fetch_add(1, std::memory_order_relaxed);
+    out_closure = fiber->closure;
+    return fiber;
+}
+
+void Scheduler::destroy_fiber(Fiber* fiber)
+{
+    const Stack stack = fiber->stack;
+    #ifdef ARC_FIBER_TSAN
+        __tsan_destroy_fiber(fiber->tsan_fiber);
+    #endif
+    fiber->~Fiber();
+    m_stacks.deallocate(stack);
+    if(m_fiber_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        // the scheduler may be waiting to stop
+        m_idle.notify_all();
+    }
+}
+
+void Scheduler::make_ready(Fiber* fiber)
+{
+    Worker* worker = get_current_worker();
+    if(worker != nullptr && worker->scheduler == this)
+    {
+        worker->queue.push(fiber);
+    }
+    else
+    {
+        m_injected->push(fiber);
+    }
+    m_idle.notify_one();
+}
+
+Scheduler::Fiber* Scheduler::find_fiber(Worker* worker)
+{
+    Fiber* fiber = worker->queue.pop();
+    if(fiber != nullptr)
+    {
+        return fiber;
+    }
+
+    fiber = m_injected->pop();
+    if(fiber != nullptr)
+    {
+        return fiber;
+    }
+
+    // steal from the other workers, starting from the next worker
+    const std::size_t count = m_workers.size();
+    for(std::size_t i = 1; i < count; ++i)
+    {
+        fiber = m_workers[(worker->index + i) % count]->queue.pop();
+        if(fiber != nullptr)
+        {
+            return fiber;
+        }
+    }
+    return nullptr;
+}
+
+void Scheduler::run_worker(Worker* worker)
+{
+    s_current_worker = worker;
+    #ifdef ARC_FIBER_TSAN
+        worker->tsan_fiber = __tsan_get_current_fiber();
+    #endif
+    while(true)
+    {
+        Fiber* fiber = nullptr;
+        m_idle.wait_until([&]()
+        {
+            fiber = find_fiber(worker);
+            return fiber != nullptr ||
+                (m_stopping.load(std::memory_order_acquire) &&
+                 m_fiber_count.load(std::memory_order_acquire) == 0);
+        });
+        if(fiber == nullptr)
+        {
+            break;
+        }
+
+        worker->current = fiber;
+        #ifdef ARC_FIBER_TSAN
+            __tsan_switch_to_fiber(fiber->tsan_fiber, 0);
+        #endif
+        switch_context(worker->context, fiber->context);
+        worker->current = nullptr;
+
+        switch(worker->action)
+        {
+            case Action::kYield:
+            {
+                worker->queue.push(fiber);
+                break;
+            }
+            case Action::kSuspend:
+            {
+                // the fiber's context is saved so it can now be resumed
+                std::uint32_t expected = RUNNING;
+                if(!fiber->state.compare_exchange_strong(
+                        expected,
+                        SUSPENDED,
+                        std::memory_order_acq_rel))
+                {
+                    // the fiber was woken while it was suspending
+                    fiber->state.store(RUNNING, std::memory_order_relaxed);
+                    worker->queue.push(fiber);
+                }
+                break;
+            }
+            case Action::kFinish:
+            {
+                destroy_fiber(fiber);
+                break;
+            }
+        }
+    }
+    s_current_worker = nullptr;
+}
+
+} // namespace fiber
+ARC_BASE_VERSION_NS_END
+} // namespace arc
@@ -0,0 +1,303 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief M:N scheduler which runs fibers on a pool of threads.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_FIBER_SCHEDULER_HPP_
+#define ARCANECORE_BASE_FIBER_SCHEDULER_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/fiber/StackPool.hpp"
+#include "arcanecore/base/lang/Restrictors.hpp"
+#include "arcanecore/base/lang/WaitStrategy.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace fiber
+{
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief Suspends the calling fiber and moves it to the back of its
+ *        scheduler's run queue, or yields the calling thread if it is not a
+ *        fiber.
+ */
+void yield();
+
+/*!
+ * \brief Returns whether the caller is running in a fiber.
+ */
+bool in_fiber();
+
+//------------------------------------------------------------------------------
+//                                   SCHEDULER
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief Runs fibers on a pool of worker threads.
+ *
+ * Each worker keeps a FIFO run queue of the fibers which are ready to run,
+ * fibers spawned or woken by a worker are added to its own queue and idle
+ * workers steal from the queues of other workers. Fibers are not pinned to a
+ * worker, so a fiber which suspends may be resumed on a different thread.
+ *
+ * A fiber's closure and bookkeeping are stored at the top of its own stack,
+ * so spawning a fiber doesn't allocate once the arc::fiber::StackPool has
+ * warmed up.
+ *
+ * An exception escaping a fiber calls std::terminate().
+ *
+ * \warning Since fibers may change threads, fibers should not hold thread
+ *          affine resources (e.g. a std::mutex or thread_local state) across
+ *          a suspension.
+ */
+class Scheduler
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Creates a new scheduler and starts its worker threads.
+     *
+     * \param thread_count The number of worker threads to start, if 0 this
+     *                     will be the number of hardware threads.
+     * \param stack_size The usable size of the stack of each fiber.
+     * \param guard_pages Whether fiber stacks have guard pages, see
+     *                    arc::fiber::StackPool.
+     */
+    explicit Scheduler(
+            std::size_t thread_count = 0,
+            std::size_t stack_size = StackPool::DEFAULT_STACK_SIZE,
+            bool guard_pages = true);
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Waits for all fibers to finish, and then stops the worker
+     *        threads.
+     */
+    ~Scheduler();
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC STATIC FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns the scheduler of the calling fiber, or null if the caller
+     *        is not running in a fiber.
+     */
+    static Scheduler* get_current();
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns the number of worker threads of this scheduler.
+     */
+    std::size_t get_thread_count() const;
+
+    /*!
+     * \brief Returns the number of fibers that have been spawned but have not
+     *        yet finished.
+     */
+    std::size_t get_fiber_count() const;
+
+    /*!
+     * \brief Spawns a new fiber which runs the given function.
+     *
+     * \throws std::bad_alloc If a stack could not be allocated for the fiber.
+     * \throws arc::ex::ValueError If the function is too large to fit on the
+     *                             fiber's stack.
+     */
+    template<typename Function>
+    void spawn(Function&& function)
+    {
+        typedef typename std::decay<Function>::type Closure;
+
+        void* closure = nullptr;
+        Fiber* fiber = create_fiber(
+            sizeof(Closure),
+            alignof(Closure),
+            &run_closure<Closure>,
+            closure
+        );
+        try
+        {
+            new(closure) Closure(std::forward<Function>(function));
+        }
+        catch(...)
+        {
+            destroy_fiber(fiber);
+            throw;
+        }
+        make_ready(fiber);
+    }
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                                  FRIENDS
+    //--------------------------------------------------------------------------
+
+    friend class Waiter;
+    friend void yield();
+    friend bool in_fiber();
+
+    //--------------------------------------------------------------------------
+    //                               PRIVATE TYPES
+    //--------------------------------------------------------------------------
+
+    struct Fiber;
+    struct RunQueue;
+    struct Worker;
+
+    // what a fiber asks its worker to do after it switches back to the worker
+    enum class Action
+    {
+        // the fiber should be added back to the run queue
+        kYield,
+        // the fiber is waiting to be woken
+        kSuspend,
+        // the fiber has finished
+        kFinish
+    };
+
+    //--------------------------------------------------------------------------
+    //                         PRIVATE STATIC ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    // the worker the current thread is (null if the thread is not a worker),
+    // this must only be read by get_current_worker() since a fiber may
+    // resume on a different thread
+    static thread_local Worker* s_current_worker;
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    StackPool m_stacks;
+    // fibers which were made ready by threads that are not workers
+    std::unique_ptr<RunQueue> m_injected;
+    // idle workers wait on this until a fiber is ready
+    arc::lang::BlockingWait m_idle;
+    // the number of fibers that have not finished
+    std::atomic<std::size_t> m_fiber_count;
+    // set when the scheduler is being destroyed
+    std::atomic<bool> m_stopping;
+    // the workers and their threads
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::vector<std::thread> m_threads;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE STATIC FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    // runs and then destroys a closure of the given type
+    template<typename Closure>
+    static void run_closure(void* closure)
+    {
+        Closure& function = *static_cast<Closure*>(closure);
+        function();
+        function.~Closure();
+    }
+
+    // returns the worker of the calling thread
+    static Worker* get_current_worker();
+
+    // returns the fiber the caller is running in
+    static Fiber* get_current_fiber();
+
+    // switches from the calling fiber back to its worker, which performs the
+    // given action
+    static void suspend(Action action);
+
+    // makes a fiber which has suspended, or is about to suspend, ready to run
+    static void wake(Fiber* fiber);
+
+    // the entry point of fibers
+    static void run_fiber(void* fiber);
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    // allocates a fiber whose closure will be constructed at out_closure
+    Fiber* create_fiber(
+            std::size_t closure_size,
+            std::size_t closure_alignment,
+            void (*run)(void*),
+            void*& out_closure);
+
+    // returns the stack of a fiber to the pool
+    void destroy_fiber(Fiber* fiber);
+
+    // adds the given fiber to a run queue
+    void make_ready(Fiber* fiber);
+
+    // finds a fiber for the given worker to run, returning null if none could
+    // be found
+    Fiber* find_fiber(Worker* worker);
+
+    // the entry point of worker threads
+    void run_worker(Worker* worker);
+};
+
+} // namespace fiber
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
@@ -0,0 +1,172 @@
+/*!
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "arcanecore/base/fiber/StackPool.hpp"
+
+#include <new>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#if defined(__SANITIZE_ADDRESS__)
+    #define ARC_FIBER_ASAN
+#elif defined(__has_feature)
+    #if __has_feature(address_sanitizer)
+        #define ARC_FIBER_ASAN
+    #endif
+#endif
+#ifdef ARC_FIBER_ASAN
+    #include <sanitizer/asan_interface.h>
+#endif
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace fiber
+{
+
+namespace
+{
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+static std::size_t round_up(std::size_t value, std::size_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                  CONSTRUCTORS
+//------------------------------------------------------------------------------
+
+StackPool::StackPool(std::size_t stack_size, bool guard_pages)
+    : m_page_size  (static_cast<std::size_t>(sysconf(_SC_PAGESIZE)))
+    , m_stack_size (round_up(stack_size > 0 ? stack_size : 1, m_page_size))
+    , m_guard_pages(guard_pages)
+{
+}
+
+//------------------------------------------------------------------------------
+//                                   DESTRUCTOR
+//------------------------------------------------------------------------------
+
+StackPool::~StackPool()
+{
+    const std::size_t guard_size = m_guard_pages ? m_page_size : 0;
+    for(const Stack& stack : m_free)
+    {
+        munmap(
+            static_cast<char*>(stack.base) - guard_size,
+            stack.size + guard_size
+        );
+    }
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+std::size_t StackPool::get_stack_size() const
+{
+    return m_stack_size;
+}
+
+bool StackPool::get_guard_pages() const
+{
+    return m_guard_pages;
+}
+
+Stack StackPool::allocate()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(!m_free.empty())
+        {
+            const Stack stack = m_free.back();
+            m_free.pop_back();
+            return stack;
+        }
+    }
+
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+    #ifdef MAP_NORESERVE
+        // only the pages that are touched need to be backed
+        flags |= MAP_NORESERVE;
+    #endif
+    #ifdef MAP_STACK
+        flags |= MAP_STACK;
+    #endif
+
+    const std::size_t guard_size = m_guard_pages ? m_page_size : 0;
+    void* memory = mmap(
+        nullptr,
+        m_stack_size + guard_size,
+        PROT_READ | PROT_WRITE,
+        flags,
+        -1,
+        0
+    );
+    if(memory == MAP_FAILED)
+    {
+        throw std::bad_alloc();
+    }
+    if(m_guard_pages && mprotect(memory, guard_size, PROT_NONE) != 0)
+    {
+        munmap(memory, m_stack_size + guard_size);
+        throw std::bad_alloc();
+    }
+
+    Stack stack;
+    stack.base = static_cast<char*>(memory) + guard_size;
+    stack.size = m_stack_size;
+    return stack;
+}
+
+void StackPool::deallocate(const Stack& stack)
+{
+    #ifdef ARC_FIBER_ASAN
+        // a finished fiber never returns from its outermost frames, so
+        // AddressSanitizer's poisoning of them must be cleared for reuse
+        ASAN_UNPOISON_MEMORY_REGION(stack.base, stack.size);
+    #endif
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_free.push_back(stack);
+}
+
+} // namespace fiber
+ARC_BASE_VERSION_NS_END
+} // namespace arc
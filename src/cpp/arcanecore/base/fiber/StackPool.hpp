@@ -0,0 +1,178 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Pool of memory mapped stacks for fibers.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_FIBER_STACKPOOL_HPP_
+#define ARCANECORE_BASE_FIBER_STACKPOOL_HPP_
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/lang/Restrictors.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace fiber
+{
+
+/*!
+ * \brief A region of memory used as the stack of a fiber.
+ */
+struct Stack
+{
+    /*!
+     * \brief The lowest usable address of the stack.
+     */
+    void* base;
+    /*!
+     * \brief The usable size of the stack in bytes.
+     */
+    std::size_t size;
+
+    /*!
+     * \brief Returns the highest address of the stack, where it starts since
+     *        stacks grow down.
+     */
+    void* get_top() const
+    {
+        return static_cast<char*>(base) + size;
+    }
+};
+
+/*!
+ * \brief Allocates fixed size stacks directly from the operating system and
+ *        reuses them once they are freed.
+ *
+ * Stacks are mapped lazily by the operating system, so only the pages a fiber
+ * actually touches use physical memory. Each stack can optionally have a
+ * guard page below it, so that a stack overflow faults instead of silently
+ * corrupting other memory. Note each guard page splits the mapping of its
+ * stack, so hundreds of thousands of guarded stacks may exceed the operating
+ * system's limit on mappings per process (vm.max_map_count on Linux).
+ *
+ * Freed stacks are kept until the pool is destroyed.
+ */
+class StackPool
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                              PUBLIC CONSTANTS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief The default usable size of each stack in bytes.
+     */
+    static const std::size_t DEFAULT_STACK_SIZE = 64 * 1024;
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Constructs a new pool.
+     *
+     * \param stack_size The usable size of each stack, this will be rounded up
+     *                   to a multiple of the page size.
+     * \param guard_pages Whether each stack has a guard page.
+     */
+    explicit StackPool(
+            std::size_t stack_size = DEFAULT_STACK_SIZE,
+            bool guard_pages = true);
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns the memory of all free stacks to the system.
+     *
+     * \warning Every stack must have been freed before the pool is destroyed.
+     */
+    ~StackPool();
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns the usable size of the stacks of this pool.
+     */
+    std::size_t get_stack_size() const;
+
+    /*!
+     * \brief Returns whether the stacks of this pool have guard pages.
+     */
+    bool get_guard_pages() const;
+
+    /*!
+     * \brief Returns an unused stack.
+     *
+     * \throws std::bad_alloc If the stack could not be mapped.
+     */
+    Stack allocate();
+
+    /*!
+     * \brief Returns a stack returned by allocate() to this pool.
+     */
+    void deallocate(const Stack& stack);
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    const std::size_t m_page_size;
+    const std::size_t m_stack_size;
+    const bool m_guard_pages;
+
+    std::mutex m_mutex;
+    // stacks that have been freed and can be reused
+    std::vector<Stack> m_free;
+};
+
+} // namespace fiber
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
@@ -0,0 +1,92 @@
+/*!
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "arcanecore/base/fiber/Waiter.hpp"
+
+#include "arcanecore/base/lang/Futex.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace fiber
+{
+
+//------------------------------------------------------------------------------
+//                                  CONSTRUCTORS
+//------------------------------------------------------------------------------
+
+Waiter::Waiter()
+    : next   (nullptr)
+    , m_fiber(Scheduler::get_current_fiber())
+    , m_woken(0)
+{
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+void Waiter::wait(std::mutex& lock)
+{
+    lock.unlock();
+    if(m_fiber != nullptr)
+    {
+        // this copes with being woken before the fiber has suspended
+        Scheduler::suspend(Scheduler::Action::kSuspend);
+        return;
+    }
+
+    while(m_woken.load(std::memory_order_acquire) == 0)
+    {
+        arc::lang::futex_wait(&m_woken, 0);
+    }
+}
+
+void Waiter::wake()
+{
+    Scheduler::Fiber* fiber = m_fiber;
+    if(fiber != nullptr)
+    {
+        Scheduler::wake(fiber);
+        return;
+    }
+
+    m_woken.store(1, std::memory_order_release);
+    // waking is harmless after the waiter is destroyed, since it only uses
+    // the address
+    arc::lang::futex_wake_all(&m_woken);
+}
+
+} // namespace fiber
+ARC_BASE_VERSION_NS_END
+} // namespace arc
@@ -0,0 +1,221 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Blocks a fiber or thread until it is woken.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_FIBER_WAITER_HPP_
+#define ARCANECORE_BASE_FIBER_WAITER_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/fiber/Scheduler.hpp"
+#include "arcanecore/base/lang/Restrictors.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace fiber
+{
+
+/*!
+ * \brief A fiber or thread which is waiting to be woken, this is the building
+ *        block of the synchronization primitives of this module.
+ *
+ * A waiter is created on the stack of the fiber or thread that is going to
+ * wait, which adds it to a WaitQueue while holding the lock that guards the
+ * queue, and then calls wait(). Another fiber or thread removes the waiter
+ * from the queue while holding the same lock, and then calls wake().
+ *
+ * Waiting fibers are suspended so their worker thread can run other fibers,
+ * whereas waiting threads sleep.
+ */
+class Waiter
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                             PUBLIC ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief The next waiter in the queue this waiter is in.
+     */
+    Waiter* next;
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Constructs a waiter for the calling fiber or thread.
+     */
+    Waiter();
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Blocks until wake() is called.
+     *
+     * \param lock The lock guarding the queue this waiter was added to, which
+     *             must be locked by the caller. This is unlocked once the
+     *             waiter is ready to be woken, and is not relocked.
+     */
+    void wait(std::mutex& lock);
+
+    /*!
+     * \brief Wakes the fiber or thread waiting on this waiter.
+     *
+     * The waiter may be destroyed as soon as this is called, so the caller
+     * must not use it afterwards.
+     */
+    void wake();
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    // the waiting fiber, or null if a thread is waiting
+    Scheduler::Fiber* const m_fiber;
+    // set when a waiting thread is woken
+    std::atomic<std::uint32_t> m_woken;
+};
+
+/*!
+ * \brief Intrusive FIFO queue of arc::fiber::Waiter objects.
+ *
+ * This is not thread safe, it should be guarded by the lock passed to
+ * Waiter::wait().
+ */
+class WaitQueue
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    WaitQueue()
+        : m_head(nullptr)
+        , m_tail(nullptr)
+    {
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns whether there are no waiters in the queue.
+     */
+    bool empty() const
+    {
+        return m_head == nullptr;
+    }
+
+    /*!
+     * \brief Adds a waiter to the back of the queue.
+     */
+    void push(Waiter* waiter)
+    {
+        waiter->next = nullptr;
+        if(m_tail != nullptr)
+        {
+            m_tail->next = waiter;
+        }
+        else
+        {
+            m_head = waiter;
+        }
+        m_tail = waiter;
+    }
+
+    /*!
+     * \brief Removes and returns the waiter at the front of the queue, or
+     *        null if the queue is empty.
+     */
+    Waiter* pop()
+    {
+        Waiter* waiter = m_head;
+        if(waiter != nullptr)
+        {
+            m_head = waiter->next;
+            if(m_head == nullptr)
+            {
+                m_tail = nullptr;
+            }
+        }
+        return waiter;
+    }
+
+    /*!
+     * \brief Removes every waiter from the queue, returning the first of the
+     *        list they are linked in.
+     */
+    Waiter* pop_all()
+    {
+        Waiter* waiter = m_head;
+        m_head = nullptr;
+        m_tail = nullptr;
+        return waiter;
+    }
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    Waiter* m_head;
+    Waiter* m_tail;
+};
+
+} // namespace fiber
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
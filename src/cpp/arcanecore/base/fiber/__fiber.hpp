@@ -0,0 +1,82 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Documents the arc::fiber namespace.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_FIBER_HPP_
+#define ARCANECORE_BASE_FIBER_HPP_
+
+#include "arcanecore/base/BaseAPI.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+
+/*!
+ * \brief Module of stackful fibers: lightweight threads which are scheduled
+ *        in user mode on a small pool of OS threads.
+ *
+ * Unlike coroutines, fibers can run ordinary synchronous code and suspend at
+ * any depth of the call stack, which makes them suitable for code that can't
+ * be rewritten to be asynchronous. Switching between fibers is a handful of
+ * register saves and restores rather than a kernel thread switch.
+ *
+ * \code
+ * arc::fiber::Scheduler scheduler(4);
+ * arc::fiber::Mutex mutex;
+ * for(std::size_t i = 0; i < 100000; ++i)
+ * {
+ *     scheduler.spawn([&]()
+ *     {
+ *         std::lock_guard<arc::fiber::Mutex> lock(mutex);
+ *         // ...
+ *     });
+ * }
+ * \endcode
+ *
+ * Fibers should only block using the synchronization primitives of this
+ * module (or arc::fiber::yield()), since blocking the OS thread a fiber is
+ * running on blocks every other fiber waiting to run on that thread.
+ *
+ * This module is only available on x86-64 and AArch64 UNIX-like systems.
+ */
+namespace fiber
+{
+} // namespace fiber
+
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
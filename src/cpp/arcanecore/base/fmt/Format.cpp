@@ -0,0 +1,518 @@
+/*!
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "arcanecore/base/fmt/Format.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "arcanecore/base/Exceptions.hpp"
+#include "arcanecore/base/fmt/Number.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace fmt
+{
+namespace detail
+{
+
+namespace
+{
+
+//------------------------------------------------------------------------------
+//                                   CONSTANTS
+//------------------------------------------------------------------------------
+
+// the size of the buffer arguments are written to before they are padded,
+// which only needs to grow for floating point numbers with a large precision
+static const std::size_t ARG_BUFFER_SIZE = 64;
+
+//------------------------------------------------------------------------------
+//                                    OUTPUTS
+//------------------------------------------------------------------------------
+
+// writes to a StringBuilder
+struct BuilderOutput
+{
+    arc::lang::StringBuilder& builder;
+
+    explicit BuilderOutput(arc::lang::StringBuilder& builder_)
+        : builder(builder_)
+    {
+    }
+
+    void append(const char* data, std::size_t size)
+    {
+        builder.append(data, size);
+    }
+
+    void fill(std::size_t count, char c)
+    {
+        builder.append(count, c);
+    }
+};
+
+// writes to a fixed size buffer, counting the characters that don't fit
+struct BufferOutput
+{
+    char* data;
+    // the number of characters that can be written, excluding the terminator
+    std::size_t capacity;
+    // the number of characters that have been formatted
+    std::size_t size;
+
+    BufferOutput(char* data_, std::size_t capacity_)
+        : data    (data_)
+        , capacity(capacity_)
+        , size    (0)
+    {
+    }
+
+    void append(const char* text, std::size_t count)
+    {
+        if(size < capacity)
+        {
+            const std::size_t room = capacity - size;
+            std::memcpy(data + size, text, count < room ? count : room);
+        }
+        size += count;
+    }
+
+    void fill(std::size_t count, char c)
+    {
+        if(size < capacity)
+        {
+            const std::size_t room = capacity - size;
+            std::memset(data + size, c, count < room ? count : room);
+        }
+        size += count;
+    }
+};
+
+//------------------------------------------------------------------------------
+//                                     SPEC
+//------------------------------------------------------------------------------
+
+/*
+ * The format specification of a replacement field.
+ */
+struct Spec
+{
+    // '<', '>', '^' or 0 for the default alignment
+    char align;
+    bool zero;
+    std::size_t width;
+    // -1 if there is no precision
+    int precision;
+    // the presentation type or 0 for the default
+    char type;
+};
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+// returns the message of an error found by validate()
+const char* get_error_message(FormatError error)
+{
+    switch(error)
+    {
+        case FormatError::kInvalidField:
+            return "Invalid replacement field in format string";
+        case FormatError::kUnmatchedClose:
+            return "Unmatched '}' in format string";
+        case FormatError::kTooFewArguments:
+            return "Format string has more replacement fields than there are "
+                   "arguments";
+        case FormatError::kTooManyArguments:
+            return "There are more arguments than the format string has "
+                   "replacement fields";
+        case FormatError::kInvalidType:
+            return "Format specification does not apply to the type of its "
+                   "argument";
+        default:
+            return "";
+    }
+}
+
+// parses the decimal number at index i of the format string
+std::size_t parse_number(const char* format, std::size_t& i)
+{
+    std::size_t value = 0;
+    while(is_digit(format[i]))
+    {
+        value = value * 10 + static_cast<std::size_t>(format[i] - '0');
+        ++i;
+    }
+    return value;
+}
+
+// parses the replacement field from just after its opening brace, and returns
+// the index after its closing brace
+std::size_t parse_spec(const char* format, std::size_t i, Spec& spec)
+{
+    spec.align = 0;
+    spec.zero = false;
+    spec.width = 0;
+    spec.precision = -1;
+    spec.type = 0;
+    if(format[i] == '}')
+    {
+        return i + 1;
+    }
+
+    // skip the colon
+    ++i;
+    if(format[i] == '<' || format[i] == '>' || format[i] == '^')
+    {
+        spec.align = format[i++];
+    }
+    if(format[i] == '0')
+    {
+        spec.zero = true;
+        ++i;
+    }
+    spec.width = parse_number(format, i);
+    if(format[i] == '.')
+    {
+        ++i;
+        spec.precision = static_cast<int>(parse_number(format, i));
+    }
+    if(format[i] != '}')
+    {
+        spec.type = format[i++];
+    }
+    return i + 1;
+}
+
+// returns the number of columns the given UTF-8 text occupies
+std::size_t get_width(const char* text, std::size_t size)
+{
+    std::size_t width = 0;
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        // don't count continuation bytes
+        if((static_cast<unsigned char>(text[i]) & 0xC0) != 0x80)
+        {
+            ++width;
+        }
+    }
+    return width;
+}
+
+// writes a floating point number with an explicit precision or presentation
+// type, which is rare enough to go through the C library
+std::size_t write_precise(
+        char* buffer,
+        std::vector<char>& heap,
+        const char*& out_text,
+        double value,
+        const Spec& spec)
+{
+    const char conversion[] = {
+        '%', '.', '*', spec.type == 0 ? 'g' : spec.type, '\0'
+    };
+    const int precision = spec.precision < 0 ? 6 : spec.precision;
+    int length = std::snprintf(
+        buffer,
+        ARG_BUFFER_SIZE,
+        conversion,
+        precision,
+        value
+    );
+    out_text = buffer;
+    if(length >= static_cast<int>(ARG_BUFFER_SIZE))
+    {
+        heap.resize(static_cast<std::size_t>(length) + 1);
+        length = std::snprintf(
+            heap.data(),
+            heap.size(),
+            conversion,
+            precision,
+            value
+        );
+        out_text = heap.data();
+    }
+    return length < 0 ? 0 : static_cast<std::size_t>(length);
+}
+
+// writes the given argument with padding
+template<typename Output>
+void write_arg(Output& out, const Arg& arg, const Spec& spec)
+{
+    char buffer[ARG_BUFFER_SIZE];
+    std::vector<char> heap;
+    const char* text = buffer;
+    std::size_t size = 0;
+    bool numeric = true;
+    deus::UnicodeStorage converted;
+
+    switch(arg.kind)
+    {
+        case Kind::kSigned:
+        {
+            if(spec.type == 'x' || spec.type == 'X')
+            {
+                unsigned long long magnitude =
+                    static_cast<unsigned long long>(arg.value.i);
+                if(arg.value.i < 0)
+                {
+                    buffer[size++] = '-';
+                    magnitude = 0ULL - magnitude;
+                }
+                size += write_hex(buffer + size, magnitude, spec.type == 'X');
+            }
+            else
+            {
+                size = write_signed(buffer, arg.value.i);
+            }
+            break;
+        }
+        case Kind::kUnsigned:
+        {
+            if(spec.type == 'x' || spec.type == 'X')
+            {
+                size = write_hex(buffer, arg.value.u, spec.type == 'X');
+            }
+            else
+            {
+                size = write_unsigned(buffer, arg.value.u);
+            }
+            break;
+        }
+        case Kind::kChar:
+        {
+            const unsigned char c = static_cast<unsigned char>(arg.value.c);
+            if(spec.type == 'x' || spec.type == 'X')
+            {
+                size = write_hex(buffer, c, spec.type == 'X');
+            }
+            else if(spec.type == 'd')
+            {
+                size = write_unsigned(buffer, c);
+            }
+            else
+            {
+                buffer[size++] = arg.value.c;
+                numeric = false;
+            }
+            break;
+        }
+        case Kind::kBool:
+        {
+            text = arg.value.b ? "true" : "false";
+            size = arg.value.b ? 4 : 5;
+            numeric = false;
+            break;
+        }
+        case Kind::kFloat:
+        {
+            if(spec.precision < 0 && spec.type == 0)
+            {
+                size = write_shortest(buffer, arg.value.f);
+            }
+            else
+            {
+                size = write_precise(buffer, heap, text, arg.value.f, spec);
+            }
+            break;
+        }
+        case Kind::kDouble:
+        {
+            if(spec.precision < 0 && spec.type == 0)
+            {
+                size = write_shortest(buffer, arg.value.d);
+            }
+            else
+            {
+                size = write_precise(buffer, heap, text, arg.value.d, spec);
+            }
+            break;
+        }
+        case Kind::kString:
+        {
+            text = arg.value.s.data;
+            size = arg.value.s.size;
+            numeric = false;
+            break;
+        }
+        case Kind::kUnicode:
+        {
+            const deus::UnicodeView& utf8 = arg.value.unicode->convert_if_not(
+                deus::ASCII_COMPATIBLE_ENCODINGS,
+                deus::Encoding::kUTF8,
+                converted
+            );
+            text = utf8.c_str();
+            size = std::strlen(text);
+            numeric = false;
+            break;
+        }
+        case Kind::kPointer:
+        {
+            buffer[0] = '0';
+            buffer[1] = 'x';
+            size = 2 + write_hex(
+                buffer + 2,
+                static_cast<unsigned long long>(
+                    reinterpret_cast<std::uintptr_t>(arg.value.p)
+                )
+            );
+            break;
+        }
+        default:
+        {
+            break;
+        }
+    }
+
+    const std::size_t width =
+        numeric ? size : get_width(text, size);
+    if(width >= spec.width)
+    {
+        out.append(text, size);
+        return;
+    }
+    const std::size_t padding = spec.width - width;
+
+    if(spec.zero && spec.align == 0)
+    {
+        // zeros go between the sign and the digits
+        std::size_t sign = (size > 0 && text[0] == '-') ? 1 : 0;
+        out.append(text, sign);
+        out.fill(padding, '0');
+        out.append(text + sign, size - sign);
+        return;
+    }
+
+    const char align = spec.align != 0 ? spec.align : (numeric ? '>' : '<');
+    const std::size_t before =
+        align == '>' ? padding : (align == '^' ? padding / 2 : 0);
+    out.fill(before, ' ');
+    out.append(text, size);
+    out.fill(padding - before, ' ');
+}
+
+// writes the format string with its replacement fields replaced by the given
+// arguments
+template<typename Output>
+void format_args(
+        Output& out,
+        const char* format,
+        std::size_t length,
+        const Arg* args)
+{
+    std::size_t arg = 0;
+    std::size_t i = 0;
+    while(i < length)
+    {
+        // copy the text up to the next brace
+        std::size_t brace = i;
+        while(brace < length && !is_brace(format[brace]))
+        {
+            ++brace;
+        }
+        out.append(format + i, brace - i);
+        if(brace == length)
+        {
+            break;
+        }
+
+        // escaped brace?
+        if(format[brace + 1] == format[brace])
+        {
+            out.append(format + brace, 1);
+            i = brace + 2;
+            continue;
+        }
+
+        Spec spec;
+        i = parse_spec(format, brace + 1, spec);
+        write_arg(out, args[arg++], spec);
+    }
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+void check_format(
+        const char* format,
+        std::size_t length,
+        const Kind* kinds,
+        std::size_t count)
+{
+    const FormatError error = validate(format, length, kinds, count);
+    if(error != FormatError::kNone)
+    {
+        arc::lang::StringBuilder message;
+        message << get_error_message(error) << ": \"" << format << "\"";
+        throw arc::ex::ValueError(message.c_str());
+    }
+}
+
+void vformat_to(
+        arc::lang::StringBuilder& out,
+        const char* format,
+        std::size_t length,
+        const Arg* args)
+{
+    BuilderOutput output(out);
+    format_args(output, format, length, args);
+}
+
+std::size_t vformat_to(
+        char* buffer,
+        std::size_t size,
+        const char* format,
+        std::size_t length,
+        const Arg* args)
+{
+    BufferOutput output(buffer, size > 0 ? size - 1 : 0);
+    format_args(output, format, length, args);
+    if(size > 0)
+    {
+        buffer[output.size < output.capacity ? output.size : output.capacity] =
+            '\0';
+    }
+    return output.size;
+}
+
+} // namespace detail
+} // namespace fmt
+ARC_BASE_VERSION_NS_END
+} // namespace arc
@@ -0,0 +1,831 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Formats arguments into text using format strings that can be
+ *        checked at compile time.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_FMT_FORMAT_HPP_
+#define ARCANECORE_BASE_FMT_FORMAT_HPP_
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#include <deus/UnicodeStorage.hpp>
+#include <deus/UnicodeView.hpp>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/lang/Atom.hpp"
+#include "arcanecore/base/lang/StringBuilder.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace fmt
+{
+
+//------------------------------------------------------------------------------
+//                                    DETAIL
+//------------------------------------------------------------------------------
+
+namespace detail
+{
+
+// the kinds of argument that can be formatted
+enum class Kind : unsigned char
+{
+    kNone,
+    kSigned,
+    kUnsigned,
+    kBool,
+    kChar,
+    kFloat,
+    kDouble,
+    kString,
+    kUnicode,
+    kPointer
+};
+
+// the ways a format string can be invalid for its arguments
+enum class FormatError
+{
+    kNone,
+    kInvalidField,
+    kUnmatchedClose,
+    kTooFewArguments,
+    kTooManyArguments,
+    kInvalidType
+};
+
+// an argument with its type erased
+struct Arg
+{
+    struct String
+    {
+        const char* data;
+        std::size_t size;
+    };
+
+    union Value
+    {
+        long long i;
+        unsigned long long u;
+        bool b;
+        char c;
+        float f;
+        double d;
+        String s;
+        const deus::UnicodeView* unicode;
+        const void* p;
+    };
+
+    Kind kind;
+    Value value;
+};
+
+// how each type of argument is formatted, types without a specialization can't
+// be formatted
+template<typename T, typename Enable = void>
+struct ArgTraits;
+
+template<typename T>
+struct ArgTraits<T, typename std::enable_if<
+    std::is_integral<T>::value &&
+    std::is_signed<T>::value &&
+    !std::is_same<T, char>::value
+>::type>
+{
+    static constexpr Kind KIND = Kind::kSigned;
+
+    static Arg make(T value)
+    {
+        Arg arg;
+        arg.kind = KIND;
+        arg.value.i = static_cast<long long>(value);
+        return arg;
+    }
+};
+
+template<typename T>
+struct ArgTraits<T, typename std::enable_if<
+    std::is_integral<T>::value &&
+    std::is_unsigned<T>::value &&
+    !std::is_same<T, char>::value &&
+    !std::is_same<T, bool>::value
+>::type>
+{
+    static constexpr Kind KIND = Kind::kUnsigned;
+
+    static Arg make(T value)
+    {
+        Arg arg;
+        arg.kind = KIND;
+        arg.value.u = static_cast<unsigned long long>(value);
+        return arg;
+    }
+};
+
+template<>
+struct ArgTraits<bool>
+{
+    static constexpr Kind KIND = Kind::kBool;
+
+    static Arg make(bool value)
+    {
+        Arg arg;
+        arg.kind = KIND;
+        arg.value.b = value;
+        return arg;
+    }
+};
+
+template<>
+struct ArgTraits<char>
+{
+    static constexpr Kind KIND = Kind::kChar;
+
+    static Arg make(char value)
+    {
+        Arg arg;
+        arg.kind = KIND;
+        arg.value.c = value;
+        return arg;
+    }
+};
+
+template<>
+struct ArgTraits<float>
+{
+    static constexpr Kind KIND = Kind::kFloat;
+
+    static Arg make(float value)
+    {
+        Arg arg;
+        arg.kind = KIND;
+        arg.value.f = value;
+        return arg;
+    }
+};
+
+template<>
+struct ArgTraits<double>
+{
+    static constexpr Kind KIND = Kind::kDouble;
+
+    static Arg make(double value)
+    {
+        Arg arg;
+        arg.kind = KIND;
+        arg.value.d = value;
+        return arg;
+    }
+};
+
+template<>
+struct ArgTraits<const char*>
+{
+    static constexpr Kind KIND = Kind::kString;
+
+    static Arg make(const char* value)
+    {
+        Arg arg;
+        arg.kind = KIND;
+        arg.value.s.data = value;
+        arg.value.s.size = std::strlen(value);
+        return arg;
+    }
+};
+
+template<>
+struct ArgTraits<char*> : public ArgTraits<const char*>
+{
+};
+
+template<>
+struct ArgTraits<std::string>
+{
+    static constexpr Kind KIND = Kind::kString;
+
+    static Arg make(const std::string& value)
+    {
+        Arg arg;
+        arg.kind = KIND;
+        arg.value.s.data = value.data();
+        arg.value.s.size = value.size();
+        return arg;
+    }
+};
+
+template<>
+struct ArgTraits<arc::lang::Atom>
+{
+    static constexpr Kind KIND = Kind::kString;
+
+    static Arg make(const arc::lang::Atom& value)
+    {
+        Arg arg;
+        arg.kind = KIND;
+        arg.value.s.data = value.c_str();
+        arg.value.s.size = value.size();
+        return arg;
+    }
+};
+
+template<>
+struct ArgTraits<deus::UnicodeView>
+{
+    static constexpr Kind KIND = Kind::kUnicode;
+
+    static Arg make(const deus::UnicodeView& value)
+    {
+        Arg arg;
+        arg.kind = KIND;
+        arg.value.unicode = &value;
+        return arg;
+    }
+};
+
+template<>
+struct ArgTraits<deus::UnicodeStorage>
+{
+    static constexpr Kind KIND = Kind::kUnicode;
+
+    static Arg make(const deus::UnicodeStorage& value)
+    {
+        Arg arg;
+        arg.kind = KIND;
+        arg.value.unicode = &value.get_view();
+        return arg;
+    }
+};
+
+template<typename T>
+struct ArgTraits<T*>
+{
+    static constexpr Kind KIND = Kind::kPointer;
+
+    static Arg make(const T* value)
+    {
+        Arg arg;
+        arg.kind = KIND;
+        arg.value.p = static_cast<const void*>(value);
+        return arg;
+    }
+};
+
+// returns the type erased form of the given argument
+template<typename T>
+Arg make_arg(const T& value)
+{
+    return ArgTraits<typename std::decay<T>::type>::make(value);
+}
+
+// the kinds of a list of argument types
+template<typename... Args>
+struct ArgKinds
+{
+    static constexpr std::size_t COUNT = sizeof...(Args);
+    // terminated so the array is never empty
+    static constexpr Kind VALUES[sizeof...(Args) + 1] =
+        {ArgTraits<Args>::KIND..., Kind::kNone};
+};
+
+template<typename... Args>
+constexpr std::size_t ArgKinds<Args...>::COUNT;
+
+template<typename... Args>
+constexpr Kind ArgKinds<Args...>::VALUES[sizeof...(Args) + 1];
+
+// returns the kinds of the given arguments, only for use in decltype
+template<typename... Args>
+ArgKinds<typename std::decay<Args>::type...> arg_kinds(
+        const char* format,
+        const Args&... args);
+
+// returns the length of a string literal
+template<std::size_t N>
+constexpr std::size_t literal_length(const char (&)[N])
+{
+    return N - 1;
+}
+
+/*
+ * The format string validator. Format strings are validated by the same
+ * constexpr functions at compile time (through the ARC_FMT macros) and at run
+ * time. The validator recurses once per replacement field rather than once per
+ * character, since scanning for braces divides the text in half at each
+ * level, so long format strings don't exceed the compiler's constexpr depth.
+ */
+
+constexpr bool is_digit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+constexpr bool is_integer(Kind kind)
+{
+    return kind == Kind::kSigned || kind == Kind::kUnsigned;
+}
+
+constexpr bool is_floating(Kind kind)
+{
+    return kind == Kind::kFloat || kind == Kind::kDouble;
+}
+
+constexpr bool is_type_char(char c)
+{
+    return c == 'd' || c == 'x' || c == 'X' || c == 'f' || c == 'e' ||
+           c == 'g' || c == 's' || c == 'c' || c == 'p';
+}
+
+// returns whether the presentation type applies to the kind of argument
+constexpr bool is_type_valid(char c, Kind kind)
+{
+    return (c == 'd' || c == 'x' || c == 'X') ?
+            is_integer(kind) || kind == Kind::kChar :
+        (c == 'f' || c == 'e' || c == 'g') ? is_floating(kind) :
+        c == 's' ?
+            kind == Kind::kString ||
+            kind == Kind::kUnicode ||
+            kind == Kind::kBool :
+        c == 'c' ? kind == Kind::kChar :
+        c == 'p' ? kind == Kind::kPointer :
+        false;
+}
+
+constexpr std::size_t skip_digits(const char* f, std::size_t i)
+{
+    return is_digit(f[i]) ? skip_digits(f, i + 1) : i;
+}
+
+constexpr bool is_brace(char c)
+{
+    return c == '{' || c == '}';
+}
+
+constexpr std::size_t find_brace(
+        const char* f,
+        std::size_t begin,
+        std::size_t end);
+
+// returns the result from the left half if a brace was found there, otherwise
+// searches the right half
+constexpr std::size_t find_brace_right(
+        const char* f,
+        std::size_t left,
+        std::size_t middle,
+        std::size_t end)
+{
+    return left != middle ? left : find_brace(f, middle, end);
+}
+
+// returns the index of the first brace in [begin, end), or end
+constexpr std::size_t find_brace(
+        const char* f,
+        std::size_t begin,
+        std::size_t end)
+{
+    return end - begin <= 1 ?
+        (begin != end && is_brace(f[begin]) ? begin : end) :
+        find_brace_right(
+            f,
+            find_brace(f, begin, begin + (end - begin) / 2),
+            begin + (end - begin) / 2,
+            end
+        );
+}
+
+constexpr FormatError check_text(
+        const char* f,
+        std::size_t i,
+        std::size_t length,
+        std::size_t arg,
+        const Kind* kinds,
+        std::size_t count);
+
+// checks for the end of a replacement field
+constexpr FormatError check_close(
+        const char* f,
+        std::size_t i,
+        std::size_t length,
+        std::size_t arg,
+        const Kind* kinds,
+        std::size_t count)
+{
+    return f[i] == '}' ?
+        check_text(f, i + 1, length, arg + 1, kinds, count) :
+        FormatError::kInvalidField;
+}
+
+// checks the optional presentation type
+constexpr FormatError check_type(
+        const char* f,
+        std::size_t i,
+        std::size_t length,
+        std::size_t arg,
+        const Kind* kinds,
+        std::size_t count)
+{
+    return f[i] == '}' ? check_close(f, i, length, arg, kinds, count) :
+        !is_type_char(f[i]) ? FormatError::kInvalidField :
+        !is_type_valid(f[i], kinds[arg]) ? FormatError::kInvalidType :
+        check_close(f, i + 1, length, arg, kinds, count);
+}
+
+// checks the optional precision
+constexpr FormatError check_precision(
+        const char* f,
+        std::size_t i,
+        std::size_t length,
+        std::size_t arg,
+        const Kind* kinds,
+        std::size_t count)
+{
+    return f[i] != '.' ? check_type(f, i, length, arg, kinds, count) :
+        !is_digit(f[i + 1]) ? FormatError::kInvalidField :
+        !is_floating(kinds[arg]) ? FormatError::kInvalidType :
+        check_type(f, skip_digits(f, i + 1), length, arg, kinds, count);
+}
+
+// checks the optional zero padding flag and width
+constexpr FormatError check_width(
+        const char* f,
+        std::size_t i,
+        std::size_t length,
+        std::size_t arg,
+        const Kind* kinds,
+        std::size_t count)
+{
+    return f[i] != '0' ?
+        check_precision(f, skip_digits(f, i), length, arg, kinds, count) :
+        !is_integer(kinds[arg]) && !is_floating(kinds[arg]) ?
+            FormatError::kInvalidType :
+        check_precision(f, skip_digits(f, i + 1), length, arg, kinds, count);
+}
+
+// checks a format specification, which begins with an optional alignment
+constexpr FormatError check_spec(
+        const char* f,
+        std::size_t i,
+        std::size_t length,
+        std::size_t arg,
+        const Kind* kinds,
+        std::size_t count)
+{
+    return (f[i] == '<' || f[i] == '>' || f[i] == '^') ?
+        check_width(f, i + 1, length, arg, kinds, count) :
+        check_width(f, i, length, arg, kinds, count);
+}
+
+// checks a replacement field, from just after its opening brace
+constexpr FormatError check_field(
+        const char* f,
+        std::size_t i,
+        std::size_t length,
+        std::size_t arg,
+        const Kind* kinds,
+        std::size_t count)
+{
+    return arg >= count ? FormatError::kTooFewArguments :
+        f[i] == '}' ? check_text(f, i + 1, length, arg + 1, kinds, count) :
+        f[i] == ':' ? check_spec(f, i + 1, length, arg, kinds, count) :
+        FormatError::kInvalidField;
+}
+
+// checks the text from the brace at index i
+constexpr FormatError check_brace(
+        const char* f,
+        std::size_t i,
+        std::size_t length,
+        std::size_t arg,
+        const Kind* kinds,
+        std::size_t count)
+{
+    return i == length ?
+            (arg == count ?
+                FormatError::kNone :
+                FormatError::kTooManyArguments) :
+        f[i] == '{' ?
+            (f[i + 1] == '{' ?
+                check_text(f, i + 2, length, arg, kinds, count) :
+                check_field(f, i + 1, length, arg, kinds, count)) :
+        f[i + 1] == '}' ?
+            check_text(f, i + 2, length, arg, kinds, count) :
+            FormatError::kUnmatchedClose;
+}
+
+constexpr FormatError check_text(
+        const char* f,
+        std::size_t i,
+        std::size_t length,
+        std::size_t arg,
+        const Kind* kinds,
+        std::size_t count)
+{
+    return check_brace(
+        f,
+        find_brace(f, i, length),
+        length,
+        arg,
+        kinds,
+        count
+    );
+}
+
+// returns how the given format string is invalid for arguments of the given
+// kinds, if at all
+constexpr FormatError validate(
+        const char* format,
+        std::size_t length,
+        const Kind* kinds,
+        std::size_t count)
+{
+    return check_text(format, 0, length, 0, kinds, count);
+}
+
+// fails to compile with a message describing the error if the format string
+// is invalid
+template<FormatError RESULT>
+struct FormatCheck
+{
+    static_assert(
+        RESULT != FormatError::kInvalidField,
+        "ARC_FMT: invalid replacement field in the format string"
+    );
+    static_assert(
+        RESULT != FormatError::kUnmatchedClose,
+        "ARC_FMT: unmatched '}' in the format string (use '}}' for a brace)"
+    );
+    static_assert(
+        RESULT != FormatError::kTooFewArguments,
+        "ARC_FMT: the format string has more replacement fields than there "
+        "are arguments"
+    );
+    static_assert(
+        RESULT != FormatError::kTooManyArguments,
+        "ARC_FMT: there are more arguments than the format string has "
+        "replacement fields"
+    );
+    static_assert(
+        RESULT != FormatError::kInvalidType,
+        "ARC_FMT: a format specification does not apply to the type of its "
+        "argument"
+    );
+
+    static void check()
+    {
+    }
+};
+
+// throws an arc::ex::ValueError if the format string is invalid for arguments
+// of the given kinds
+void check_format(
+        const char* format,
+        std::size_t length,
+        const Kind* kinds,
+        std::size_t count);
+
+// formats the given arguments using a format string which is known to be valid
+void vformat_to(
+        arc::lang::StringBuilder& out,
+        const char* format,
+        std::size_t length,
+        const Arg* args);
+
+std::size_t vformat_to(
+        char* buffer,
+        std::size_t size,
+        const char* format,
+        std::size_t length,
+        const Arg* args);
+
+// the functions used by the ARC_FMT macros, which have already checked the
+// format string
+template<typename... Args>
+void format_unchecked_to(
+        arc::lang::StringBuilder& out,
+        const char* format,
+        const Args&... args)
+{
+    const Arg packed[] = {make_arg(args)..., Arg()};
+    vformat_to(out, format, std::strlen(format), packed);
+}
+
+template<typename... Args>
+std::size_t format_unchecked_to_buffer(
+        char* buffer,
+        std::size_t size,
+        const char* format,
+        const Args&... args)
+{
+    const Arg packed[] = {make_arg(args)..., Arg()};
+    return vformat_to(buffer, size, format, std::strlen(format), packed);
+}
+
+template<typename... Args>
+std::string format_unchecked(const char* format, const Args&... args)
+{
+    arc::lang::StringBuilder out;
+    format_unchecked_to(out, format, args...);
+    return out.to_string();
+}
+
+} // namespace detail
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief Appends the given arguments to the builder, laid out by the format
+ *        string.
+ *
+ * Each ```{}``` in the format string is replaced by the next argument, and
+ * ```{{``` and ```}}``` are replaced by single braces. A replacement field may
+ * have a specification after a colon, ```{:[align][0][width][.precision]
+ * [type]}```, where:
+ *
+ * - ```align``` is ```<```, ```>``` or ```^``` to align the argument left,
+ *   right or centre within the width. Numbers are right aligned by default and
+ *   other arguments are left aligned.
+ * - ```0``` pads numbers with zeros after their sign rather than spaces.
+ * - ```width``` is the minimum number of columns the argument occupies.
+ * - ```precision``` is the number of digits of a floating point number after
+ *   the point (for ```f``` and ```e```) or in total (for ```g```, which is the
+ *   default when a precision is given).
+ * - ```type``` is ```d``` (decimal), ```x``` or ```X``` (hexadecimal) for
+ *   integers and characters, ```f```, ```e``` or ```g``` for floating point
+ *   numbers, ```s``` for strings and bools, ```c``` for characters and
+ *   ```p``` for pointers.
+ *
+ * Arguments may be integers, bools, characters, floating point numbers,
+ * strings (```const char*```, ```std::string```, ```deus::UnicodeView```,
+ * ```deus::UnicodeStorage``` and arc::lang::Atom) and pointers, and passing
+ * any other type fails to compile. Without a specification, floating point
+ * numbers are written with the fewest digits which parse back to the same
+ * value (see arc::fmt::write_shortest()) and pointers as ```0x``` followed by
+ * hexadecimal digits.
+ *
+ * This function checks the format string at run time, the ARC_FMT_TO() macro
+ * checks it at compile time instead.
+ *
+ * \throws arc::ex::ValueError If the format string is invalid, or doesn't have
+ *                             a replacement field for every argument.
+ */
+template<typename... Args>
+void format_to(
+        arc::lang::StringBuilder& out,
+        const char* format,
+        const Args&... args)
+{
+    typedef detail::ArgKinds<typename std::decay<Args>::type...> Kinds;
+    const std::size_t length = std::strlen(format);
+    detail::check_format(format, length, Kinds::VALUES, Kinds::COUNT);
+    const detail::Arg packed[] = {detail::make_arg(args)..., detail::Arg()};
+    detail::vformat_to(out, format, length, packed);
+}
+
+/*!
+ * \brief Writes the given arguments laid out by the format string to the
+ *        given buffer.
+ *
+ * Like ```std::snprintf```, at most size - 1 characters are written followed
+ * by a null terminator, and the length of the whole formatted string is
+ * returned, so the text was truncated if this is size or more.
+ *
+ * \see format_to(arc::lang::StringBuilder&, const char*, const Args&...)
+ *
+ * \throws arc::ex::ValueError If the format string is invalid, or doesn't have
+ *                             a replacement field for every argument.
+ */
+template<typename... Args>
+std::size_t format_to(
+        char* buffer,
+        std::size_t size,
+        const char* format,
+        const Args&... args)
+{
+    typedef detail::ArgKinds<typename std::decay<Args>::type...> Kinds;
+    const std::size_t length = std::strlen(format);
+    detail::check_format(format, length, Kinds::VALUES, Kinds::COUNT);
+    const detail::Arg packed[] = {detail::make_arg(args)..., detail::Arg()};
+    return detail::vformat_to(buffer, size, format, length, packed);
+}
+
+/*!
+ * \brief Returns the given arguments laid out by the format string.
+ *
+ * \see format_to(arc::lang::StringBuilder&, const char*, const Args&...)
+ *
+ * \throws arc::ex::ValueError If the format string is invalid, or doesn't have
+ *                             a replacement field for every argument.
+ */
+template<typename... Args>
+std::string format(const char* format, const Args&... args)
+{
+    arc::lang::StringBuilder out;
+    format_to(out, format, args...);
+    return out.to_string();
+}
+
+} // namespace fmt
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+//------------------------------------------------------------------------------
+//                                     MACROS
+//------------------------------------------------------------------------------
+
+#ifndef IN_DOXYGEN
+
+#define ARC_FMT_FIRST_(first, ...) first
+
+#define ARC_FMT_CHECK_(...)                                                    \
+    ::arc::fmt::detail::FormatCheck<                                           \
+        ::arc::fmt::detail::validate(                                          \
+            ARC_FMT_FIRST_(__VA_ARGS__, 0),                                    \
+            ::arc::fmt::detail::literal_length(                                \
+                ARC_FMT_FIRST_(__VA_ARGS__, 0)                                 \
+            ),                                                                 \
+            decltype(::arc::fmt::detail::arg_kinds(__VA_ARGS__))::VALUES,      \
+            decltype(::arc::fmt::detail::arg_kinds(__VA_ARGS__))::COUNT        \
+        )                                                                      \
+    >::check()
+
+#endif // IN_DOXYGEN
+
+/*!
+ * \brief Returns the given arguments laid out by the format string as a
+ *        ```std::string```, failing to compile if the format string is invalid
+ *        for the arguments.
+ *
+ * The format string must be a string literal.
+ *
+ * \code
+ * std::string s = ARC_FMT("{} of {} ({:.1f}%)", done, total, percent);
+ * \endcode
+ *
+ * \see arc::fmt::format_to()
+ */
+#define ARC_FMT(...)                                                           \
+    (ARC_FMT_CHECK_(__VA_ARGS__),                                              \
+     ::arc::fmt::detail::format_unchecked(__VA_ARGS__))
+
+/*!
+ * \brief Appends the given arguments laid out by the format string to the
+ *        given arc::lang::StringBuilder, failing to compile if the format
+ *        string is invalid for the arguments.
+ *
+ * \see arc::fmt::format_to()
+ */
+#define ARC_FMT_TO(out, ...)                                                   \
+    (ARC_FMT_CHECK_(__VA_ARGS__),                                              \
+     ::arc::fmt::detail::format_unchecked_to(out, __VA_ARGS__))
+
+/*!
+ * \brief Writes the given arguments laid out by the format string to the
+ *        given buffer of the given size, failing to compile if the format
+ *        string is invalid for the arguments.
+ *
+ * Returns the length of the whole formatted string, like ```std::snprintf```.
+ *
+ * \see arc::fmt::format_to(char*, std::size_t, const char*, const Args&...)
+ */
+#define ARC_FMT_TO_BUFFER(buffer, size, ...)                                   \
+    (ARC_FMT_CHECK_(__VA_ARGS__),                                              \
+     ::arc::fmt::detail::format_unchecked_to_buffer(buffer, size, __VA_ARGS__))
+
+#endif
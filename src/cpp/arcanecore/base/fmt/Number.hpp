@@ -0,0 +1,132 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Kernels which write numbers as decimal and hexadecimal text.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_FMT_NUMBER_HPP_
+#define ARCANECORE_BASE_FMT_NUMBER_HPP_
+
+#include <cstddef>
+
+#include "arcanecore/base/BaseAPI.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace fmt
+{
+
+//------------------------------------------------------------------------------
+//                                   CONSTANTS
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief The most characters write_signed() or write_unsigned() will write.
+ */
+static const std::size_t MAX_INTEGER_CHARS = 20;
+
+/*!
+ * \brief The most characters write_hex() will write.
+ */
+static const std::size_t MAX_HEX_CHARS = 16;
+
+/*!
+ * \brief The most characters write_shortest() will write.
+ */
+static const std::size_t MAX_SHORTEST_CHARS = 32;
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief Writes the given integer in decimal to the given buffer, and returns
+ *        the number of characters written.
+ *
+ * Digits are written two at a time from a table, and no terminator is written.
+ * The buffer must have room for arc::fmt::MAX_INTEGER_CHARS characters.
+ */
+std::size_t write_unsigned(char* out, unsigned long long value);
+
+/*!
+ * \brief Writes the given integer in decimal to the given buffer, and returns
+ *        the number of characters written.
+ *
+ * The buffer must have room for arc::fmt::MAX_INTEGER_CHARS characters.
+ */
+std::size_t write_signed(char* out, long long value);
+
+/*!
+ * \brief Writes the given integer in hexadecimal (without a prefix) to the
+ *        given buffer, and returns the number of characters written.
+ *
+ * The buffer must have room for arc::fmt::MAX_HEX_CHARS characters.
+ *
+ * \param upper Whether letter digits are written in upper case.
+ */
+std::size_t write_hex(
+        char* out,
+        unsigned long long value,
+        bool upper = false);
+
+/*!
+ * \brief Writes the shortest decimal representation of the given number which
+ *        parses back to the same double, and returns the number of characters
+ *        written.
+ *
+ * The digits are found with the Ryu algorithm, without going through the C
+ * library or its locale. Numbers whose decimal exponent is from -5 to 15 are
+ * written in fixed notation (e.g. "0.001" and "1500"), and others in
+ * scientific notation (e.g. "1e+300"). Infinities and NaN are written as
+ * "inf", "-inf" and "nan".
+ *
+ * The buffer must have room for arc::fmt::MAX_SHORTEST_CHARS characters.
+ */
+std::size_t write_shortest(char* out, double value);
+
+/*!
+ * \brief Writes the shortest decimal representation of the given number which
+ *        parses back to the same float, and returns the number of characters
+ *        written.
+ *
+ * \see write_shortest(char*, double)
+ */
+std::size_t write_shortest(char* out, float value);
+
+} // namespace fmt
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
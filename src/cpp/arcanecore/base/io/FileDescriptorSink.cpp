@@ -0,0 +1,311 @@
+/*!
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "arcanecore/base/io/FileDescriptorSink.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "arcanecore/base/Preproc.hpp"
+#include "arcanecore/base/lang/SmallVector.hpp"
+
+#ifdef ARC_OS_WINDOWS
+    #include <io.h>
+#else
+    #include <sys/uio.h>
+    #include <unistd.h>
+#endif
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace io
+{
+
+namespace
+{
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+#ifdef ARC_OS_WINDOWS
+
+// writes all of the given bytes, returning false on error
+bool write_all(int fd, const char* data, std::size_t size)
+{
+    while(size > 0)
+    {
+        const int written = _write(
+            fd,
+            data,
+            static_cast<unsigned int>(std::min<std::size_t>(size, INT_MAX))
+        );
+        if(written < 0)
+        {
+            if(errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        data += written;
+        size -= static_cast<std::size_t>(written);
+    }
+    return true;
+}
+
+#else
+
+// writes all of the given vectors, returning false on error
+bool write_all(int fd, struct iovec* vectors, std::size_t count)
+{
+    while(count > 0)
+    {
+        const ssize_t written = ::writev(
+            fd,
+            vectors,
+            static_cast<int>(std::min<std::size_t>(count, IOV_MAX))
+        );
+        if(written < 0)
+        {
+            if(errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+
+        // skip past what was written, which may end part way into a vector
+        std::size_t remaining = static_cast<std::size_t>(written);
+        while(count > 0 && remaining >= vectors->iov_len)
+        {
+            remaining -= vectors->iov_len;
+            ++vectors;
+            --count;
+        }
+        if(count > 0)
+        {
+            vectors->iov_base =
+                static_cast<char*>(vectors->iov_base) + remaining;
+            vectors->iov_len -= remaining;
+        }
+    }
+    return true;
+}
+
+#endif
+
+// creates a sink of a standard stream which is flushed at exit
+FileDescriptorSink* create_standard_sink(int fd, void (*flush_at_exit)())
+{
+    FileDescriptorSink* sink = new FileDescriptorSink(fd);
+    std::atexit(flush_at_exit);
+    return sink;
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                PUBLIC CONSTANTS
+//------------------------------------------------------------------------------
+
+const std::size_t FileDescriptorSink::DEFAULT_BUFFER_SIZE;
+
+//------------------------------------------------------------------------------
+//                                  CONSTRUCTOR
+//------------------------------------------------------------------------------
+
+FileDescriptorSink::FileDescriptorSink(int fd, std::size_t buffer_size)
+    : m_fd      (fd)
+    , m_buffer  (buffer_size > 0 ? new char[buffer_size] : nullptr)
+    , m_capacity(buffer_size)
+    , m_size    (0)
+    , m_failed  (false)
+{
+}
+
+//------------------------------------------------------------------------------
+//                                   DESTRUCTOR
+//------------------------------------------------------------------------------
+
+FileDescriptorSink::~FileDescriptorSink()
+{
+    flush();
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC STATIC FUNCTIONS
+//------------------------------------------------------------------------------
+
+FileDescriptorSink& FileDescriptorSink::get_stdout()
+{
+    // deliberately leaked so that it can be written to during static
+    // destruction
+    static FileDescriptorSink* sink = create_standard_sink(
+        1,
+        []() { FileDescriptorSink::get_stdout().flush(); }
+    );
+    return *sink;
+}
+
+FileDescriptorSink& FileDescriptorSink::get_stderr()
+{
+    static FileDescriptorSink* sink = create_standard_sink(
+        2,
+        []() { FileDescriptorSink::get_stderr().flush(); }
+    );
+    return *sink;
+}
+
+void FileDescriptorSink::flush_standard_stream(const arc::io::OutputSink& sink)
+{
+    const FileDescriptorSink* fd_sink =
+        dynamic_cast<const FileDescriptorSink*>(&sink);
+    if(fd_sink == nullptr)
+    {
+        return;
+    }
+    if(fd_sink->m_fd == 1)
+    {
+        std::cout.flush();
+    }
+    else if(fd_sink->m_fd == 2)
+    {
+        std::cerr.flush();
+    }
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+void FileDescriptorSink::write_slices(const Slice* slices, std::size_t count)
+{
+    std::size_t total = 0;
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        total += slices[i].size;
+    }
+    if(total == 0)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if(total <= m_capacity - m_size)
+    {
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            std::memcpy(
+                m_buffer.get() + m_size,
+                slices[i].data,
+                slices[i].size
+            );
+            m_size += slices[i].size;
+        }
+        return;
+    }
+    write_through(slices, count);
+}
+
+void FileDescriptorSink::flush()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if(m_size > 0)
+    {
+        write_through(nullptr, 0);
+    }
+}
+
+int FileDescriptorSink::get_fd() const
+{
+    return m_fd;
+}
+
+bool FileDescriptorSink::has_failed() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_failed;
+}
+
+//------------------------------------------------------------------------------
+//                            PRIVATE MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+void FileDescriptorSink::write_through(const Slice* slices, std::size_t count)
+{
+    bool success = true;
+#ifdef ARC_OS_WINDOWS
+    success = write_all(m_fd, m_buffer.get(), m_size);
+    for(std::size_t i = 0; success && i < count; ++i)
+    {
+        success = write_all(m_fd, slices[i].data, slices[i].size);
+    }
+#else
+    arc::lang::SmallVector<struct iovec, 16> vectors;
+    vectors.reserve(count + 1);
+    if(m_size > 0)
+    {
+        struct iovec vector;
+        vector.iov_base = m_buffer.get();
+        vector.iov_len = m_size;
+        vectors.push_back(vector);
+    }
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        if(slices[i].size > 0)
+        {
+            struct iovec vector;
+            vector.iov_base = const_cast<char*>(slices[i].data);
+            vector.iov_len = slices[i].size;
+            vectors.push_back(vector);
+        }
+    }
+    success = write_all(m_fd, vectors.data(), vectors.size());
+#endif
+
+    m_size = 0;
+    if(!success)
+    {
+        m_failed = true;
+    }
+}
+
+} // namespace io
+ARC_BASE_VERSION_NS_END
+} // namespace arc
@@ -0,0 +1,188 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Buffered output sink which writes to a file descriptor.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_IO_FILEDESCRIPTORSINK_HPP_
+#define ARCANECORE_BASE_IO_FILEDESCRIPTORSINK_HPP_
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/io/OutputSink.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace io
+{
+
+/*!
+ * \brief An arc::io::OutputSink which buffers output and writes it to a file
+ *        descriptor.
+ *
+ * Writes are copied into the buffer while they fit, so many small writes cost
+ * a single system call. A write which doesn't fit is passed to the file
+ * descriptor along with the buffered output in one ```writev``` call, so large
+ * writes are never copied.
+ *
+ * The sink doesn't own the file descriptor. Write errors are not reported
+ * (like the standard streams) other than through has_failed(), and output
+ * which fails to be written is discarded.
+ *
+ * \note The standard output and error sinks have their own buffers, so when
+ *       they are mixed with std::cout or printf the other must be flushed
+ *       first to keep output in order.
+ */
+class FileDescriptorSink
+    : public arc::io::OutputSink
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                              PUBLIC CONSTANTS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief The size of the buffer of a sink in bytes if it is not specified.
+     */
+    static const std::size_t DEFAULT_BUFFER_SIZE = 8192;
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Constructs a sink which writes to the given file descriptor.
+     *
+     * \param fd The file descriptor, which must remain open for the lifetime
+     *           of this sink.
+     * \param buffer_size The number of bytes that are buffered before they are
+     *                    written (0 writes every call straight through).
+     */
+    explicit FileDescriptorSink(
+            int fd,
+            std::size_t buffer_size = DEFAULT_BUFFER_SIZE);
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Flushes any buffered output.
+     */
+    virtual ~FileDescriptorSink();
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC STATIC FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns the sink of the standard output.
+     *
+     * The sink is never destroyed, and is flushed when the program exits
+     * normally (through std::exit or returning from main).
+     */
+    static FileDescriptorSink& get_stdout();
+
+    /*!
+     * \brief Returns the sink of the standard error.
+     *
+     * The sink is never destroyed, and is flushed when the program exits
+     * normally (through std::exit or returning from main).
+     */
+    static FileDescriptorSink& get_stderr();
+
+    /*!
+     * \brief Flushes the standard stream (std::cout or std::cerr) which
+     *        writes to the same file descriptor as the given sink, if any.
+     *
+     * This should be called before writing to a sink which may be the
+     * standard output or error, so that output written to the standard stream
+     * beforehand is not reordered after it.
+     */
+    static void flush_standard_stream(const arc::io::OutputSink& sink);
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    virtual void write_slices(const Slice* slices, std::size_t count) override;
+
+    virtual void flush() override;
+
+    /*!
+     * \brief Returns the file descriptor this sink writes to.
+     */
+    int get_fd() const;
+
+    /*!
+     * \brief Returns whether writing to the file descriptor has failed at any
+     *        point.
+     */
+    bool has_failed() const;
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    const int m_fd;
+
+    // guards the following
+    mutable std::mutex m_mutex;
+    std::unique_ptr<char[]> m_buffer;
+    const std::size_t m_capacity;
+    // the number of bytes in the buffer
+    std::size_t m_size;
+    bool m_failed;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    // writes the buffer followed by the given slices to the file descriptor,
+    // must be called while holding the lock
+    void write_through(const Slice* slices, std::size_t count);
+};
+
+} // namespace io
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
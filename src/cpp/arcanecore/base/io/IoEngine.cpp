@@ -0,0 +1,959 @@
+/*!
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "arcanecore/base/io/IoEngine.hpp"
+
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "arcanecore/base/Exceptions.hpp"
+#include "arcanecore/base/Preproc.hpp"
+
+#include <unistd.h>
+
+// io_uring is used where the kernel headers define it, through raw system
+// calls so that liburing is not required
+#if defined(ARC_OS_LINUX) && defined(__has_include)
+    #if __has_include(<linux/io_uring.h>)
+        #define ARC_IO_URING
+    #endif
+#endif
+
+#ifdef ARC_IO_URING
+    #include <linux/io_uring.h>
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+#endif
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace io
+{
+
+//------------------------------------------------------------------------------
+//                                    BACKEND
+//------------------------------------------------------------------------------
+
+// the interface of the implementations of the engine
+class IoEngine::Backend
+{
+public:
+
+    virtual ~Backend()
+    {
+    }
+
+    virtual void register_files(arc::lang::Span<const int> fds) = 0;
+
+    virtual void register_buffers(
+            arc::lang::Span<const arc::lang::Span<char>> buffers) = 0;
+
+    virtual void enqueue(IoRequest& request) = 0;
+
+    // returns the number of requests submitted
+    virtual std::size_t submit() = 0;
+
+    // appends requests which have completed, with their results set, waiting
+    // for at least one if need be
+    virtual void reap(bool wait, std::vector<IoRequest*>& out_completed) = 0;
+};
+
+#ifdef ARC_IO_URING
+
+//------------------------------------------------------------------------------
+//                                IO URING BACKEND
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+int io_uring_setup(unsigned entries, struct io_uring_params* params)
+{
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+int io_uring_enter(
+        int fd,
+        unsigned to_submit,
+        unsigned min_complete,
+        unsigned flags)
+{
+    return static_cast<int>(::syscall(
+        __NR_io_uring_enter,
+        fd,
+        to_submit,
+        min_complete,
+        flags,
+        nullptr,
+        0
+    ));
+}
+
+int io_uring_register(
+        int fd,
+        unsigned opcode,
+        const void* arg,
+        unsigned count)
+{
+    return static_cast<int>(
+        ::syscall(__NR_io_uring_register, fd, opcode, arg, count)
+    );
+}
+
+// the ring indices are shared with the kernel
+unsigned load_acquire(const unsigned* index)
+{
+    return __atomic_load_n(index, __ATOMIC_ACQUIRE);
+}
+
+void store_release(unsigned* index, unsigned value)
+{
+    __atomic_store_n(index, value, __ATOMIC_RELEASE);
+}
+
+} // namespace anonymous
+
+// submits requests to the kernel through the submission ring, and reads their
+// results from the completion ring, both of which are shared memory
+class IoEngine::IoUringBackend
+    : public IoEngine::Backend
+{
+public:
+
+    explicit IoUringBackend(std::size_t entries)
+        : m_fd              (-1)
+        , m_sq_ring         (MAP_FAILED)
+        , m_sq_ring_size    (0)
+        , m_cq_ring         (MAP_FAILED)
+        , m_cq_ring_size    (0)
+        , m_sqes            (nullptr)
+        , m_sqes_size       (0)
+        , m_to_submit       (0)
+        , m_files_registered(false)
+        , m_buffers_registered(false)
+    {
+        struct io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        m_fd = io_uring_setup(static_cast<unsigned>(entries), &params);
+        if(m_fd < 0)
+        {
+            throw arc::ex::RuntimeError("Failed to set up an io_uring.");
+        }
+
+        m_sq_ring_size =
+            params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        m_cq_ring_size = params.cq_off.cqes +
+            params.cq_entries * sizeof(struct io_uring_cqe);
+        // newer kernels map both rings at once
+        const bool single_mmap =
+            (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if(single_mmap && m_cq_ring_size > m_sq_ring_size)
+        {
+            m_sq_ring_size = m_cq_ring_size;
+        }
+
+        m_sq_ring = map(m_sq_ring_size, IORING_OFF_SQ_RING);
+        if(single_mmap)
+        {
+            m_cq_ring = m_sq_ring;
+            m_cq_ring_size = m_sq_ring_size;
+        }
+        else
+        {
+            m_cq_ring = map(m_cq_ring_size, IORING_OFF_CQ_RING);
+        }
+        m_sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+        m_sqes = static_cast<struct io_uring_sqe*>(
+            map(m_sqes_size, IORING_OFF_SQES)
+        );
+
+        char* sq = static_cast<char*>(m_sq_ring);
+        m_sq_head = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        m_sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        m_sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        m_sq_mask =
+            *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        m_sq_entries = params.sq_entries;
+
+        char* cq = static_cast<char*>(m_cq_ring);
+        m_cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        m_cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        m_cq_mask =
+            *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        m_cqes =
+            reinterpret_cast<struct io_uring_cqe*>(cq + params.cq_off.cqes);
+    }
+
+    virtual ~IoUringBackend()
+    {
+        release();
+    }
+
+    virtual void register_files(arc::lang::Span<const int> fds) override
+    {
+        if(m_files_registered)
+        {
+            io_uring_register(m_fd, IORING_UNREGISTER_FILES, nullptr, 0);
+            m_files_registered = false;
+        }
+        if(fds.empty())
+        {
+            return;
+        }
+        if(io_uring_register(
+                m_fd,
+                IORING_REGISTER_FILES,
+                fds.data(),
+                static_cast<unsigned>(fds.size())) < 0)
+        {
+            throw arc::ex::RuntimeError(
+                "Failed to register files with the io_uring."
+            );
+        }
+        m_files_registered = true;
+    }
+
+    virtual void register_buffers(
+            arc::lang::Span<const arc::lang::Span<char>> buffers) override
+    {
+        if(m_buffers_registered)
+        {
+            io_uring_register(m_fd, IORING_UNREGISTER_BUFFERS, nullptr, 0);
+            m_buffers_registered = false;
+        }
+        if(buffers.empty())
+        {
+            return;
+        }
+        std::vector<struct iovec> vectors(buffers.size());
+        for(std::size_t i = 0; i < buffers.size(); ++i)
+        {
+            vectors[i].iov_base = buffers[i].data();
+            vectors[i].iov_len = buffers[i].size();
+        }
+        if(io_uring_register(
+                m_fd,
+                IORING_REGISTER_BUFFERS,
+                vectors.data(),
+                static_cast<unsigned>(vectors.size())) < 0)
+        {
+            throw arc::ex::RuntimeError(
+                "Failed to register buffers with the io_uring."
+            );
+        }
+        m_buffers_registered = true;
+    }
+
+    virtual void enqueue(IoRequest& request) override
+    {
+        // only this thread writes the tail
+        unsigned tail = *m_sq_tail;
+        if(tail - load_acquire(m_sq_head) == m_sq_entries)
+        {
+            submit();
+        }
+
+        const unsigned index = tail & m_sq_mask;
+        struct io_uring_sqe& sqe = m_sqes[index];
+        std::memset(&sqe, 0, sizeof(sqe));
+        const bool is_read = request.m_operation == IoRequest::Operation::kRead;
+        if(request.m_buffer_index >= 0)
+        {
+            sqe.opcode = static_cast<std::uint8_t>(
+                is_read ? IORING_OP_READ_FIXED : IORING_OP_WRITE_FIXED
+            );
+            sqe.addr = reinterpret_cast<std::uintptr_t>(
+                request.m_vector.iov_base
+            );
+            sqe.len = static_cast<std::uint32_t>(request.m_vector.iov_len);
+            sqe.buf_index = static_cast<std::uint16_t>(request.m_buffer_index);
+        }
+        else
+        {
+            sqe.opcode = static_cast<std::uint8_t>(
+                is_read ? IORING_OP_READV : IORING_OP_WRITEV
+            );
+            sqe.addr = reinterpret_cast<std::uintptr_t>(&request.m_vector);
+            sqe.len = 1;
+        }
+        sqe.fd = request.m_fd;
+        sqe.off = request.m_offset;
+        if(request.m_registered_file)
+        {
+            sqe.flags |= IOSQE_FIXED_FILE;
+        }
+        if(request.m_linked)
+        {
+            sqe.flags |= IOSQE_IO_LINK;
+        }
+        sqe.user_data = reinterpret_cast<std::uintptr_t>(&request);
+
+        m_sq_array[index] = index;
+        store_release(m_sq_tail, tail + 1);
+        ++m_to_submit;
+    }
+
+    virtual std::size_t submit() override
+    {
+        std::size_t submitted = 0;
+        while(m_to_submit > 0)
+        {
+            const int count = io_uring_enter(m_fd, m_to_submit, 0, 0);
+            if(count < 0)
+            {
+                if(errno == EINTR)
+                {
+                    continue;
+                }
+                throw arc::ex::RuntimeError(
+                    "Failed to submit requests to the io_uring."
+                );
+            }
+            m_to_submit -= static_cast<unsigned>(count);
+            submitted += static_cast<std::size_t>(count);
+        }
+        return submitted;
+    }
+
+    virtual void reap(
+            bool wait,
+            std::vector<IoRequest*>& out_completed) override
+    {
+        while(true)
+        {
+            unsigned head = *m_cq_head;
+            const unsigned tail = load_acquire(m_cq_tail);
+            const bool any = head != tail;
+            for(; head != tail; ++head)
+            {
+                const struct io_uring_cqe& cqe = m_cqes[head & m_cq_mask];
+                IoRequest* request = reinterpret_cast<IoRequest*>(
+                    static_cast<std::uintptr_t>(cqe.user_data)
+                );
+                request->m_result = cqe.res;
+                out_completed.push_back(request);
+            }
+            store_release(m_cq_head, head);
+
+            if(any || !wait)
+            {
+                return;
+            }
+            // nothing is submitted while waiting, as that could end an open
+            // chain of linked requests
+            const int count = io_uring_enter(
+                m_fd,
+                0,
+                1,
+                IORING_ENTER_GETEVENTS
+            );
+            if(count < 0)
+            {
+                if(errno == EINTR)
+                {
+                    continue;
+                }
+                throw arc::ex::RuntimeError(
+                    "Failed to wait for completions from the io_uring."
+                );
+            }
+        }
+    }
+
+private:
+
+    int m_fd;
+    void* m_sq_ring;
+    std::size_t m_sq_ring_size;
+    void* m_cq_ring;
+    std::size_t m_cq_ring_size;
+    struct io_uring_sqe* m_sqes;
+    std::size_t m_sqes_size;
+
+    unsigned* m_sq_head;
+    unsigned* m_sq_tail;
+    unsigned* m_sq_array;
+    unsigned m_sq_mask;
+    unsigned m_sq_entries;
+    unsigned* m_cq_head;
+    unsigned* m_cq_tail;
+    unsigned m_cq_mask;
+    struct io_uring_cqe* m_cqes;
+
+    // the number of requests in the submission ring not yet submitted
+    unsigned m_to_submit;
+    bool m_files_registered;
+    bool m_buffers_registered;
+
+    // maps a region of the ring, releasing everything if it fails
+    void* map(std::size_t size, off_t offset)
+    {
+        void* ret = ::mmap(
+            nullptr,
+            size,
+            PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE,
+            m_fd,
+            offset
+        );
+        if(ret == MAP_FAILED)
+        {
+            release();
+            throw arc::ex::RuntimeError("Failed to map the io_uring.");
+        }
+        return ret;
+    }
+
+    void release()
+    {
+        if(m_sqes != nullptr)
+        {
+            ::munmap(m_sqes, m_sqes_size);
+            m_sqes = nullptr;
+        }
+        if(m_cq_ring != MAP_FAILED && m_cq_ring != m_sq_ring)
+        {
+            ::munmap(m_cq_ring, m_cq_ring_size);
+        }
+        m_cq_ring = MAP_FAILED;
+        if(m_sq_ring != MAP_FAILED)
+        {
+            ::munmap(m_sq_ring, m_sq_ring_size);
+            m_sq_ring = MAP_FAILED;
+        }
+        if(m_fd >= 0)
+        {
+            ::close(m_fd);
+            m_fd = -1;
+        }
+    }
+};
+
+#endif
+
+//------------------------------------------------------------------------------
+//                              THREAD POOL BACKEND
+//------------------------------------------------------------------------------
+
+// performs requests with blocking calls on a pool of threads, where each
+// chain of linked requests is performed in order by a single thread
+class IoEngine::ThreadPoolBackend
+    : public IoEngine::Backend
+{
+public:
+
+    explicit ThreadPoolBackend(std::size_t thread_count)
+        : m_chain_tail (nullptr)
+        , m_to_submit  (0)
+        , m_stopping   (false)
+    {
+        for(std::size_t i = 0; i < thread_count; ++i)
+        {
+            m_threads.emplace_back(&ThreadPoolBackend::run, this);
+        }
+    }
+
+    virtual ~ThreadPoolBackend()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_work.notify_all();
+        for(std::thread& thread : m_threads)
+        {
+            thread.join();
+        }
+    }
+
+    virtual void register_files(arc::lang::Span<const int> fds) override
+    {
+        m_files.assign(fds.begin(), fds.end());
+    }
+
+    virtual void register_buffers(
+            arc::lang::Span<const arc::lang::Span<char>> buffers) override
+    {
+        // the buffers of blocking calls don't need to be registered
+    }
+
+    virtual void enqueue(IoRequest& request) override
+    {
+        request.m_next = nullptr;
+        if(m_chain_tail != nullptr)
+        {
+            m_chain_tail->m_next = &request;
+        }
+        else
+        {
+            m_chains.push_back(&request);
+        }
+        m_chain_tail = request.m_linked ? &request : nullptr;
+        ++m_to_submit;
+    }
+
+    virtual std::size_t submit() override
+    {
+        // like io_uring, a chain ends when it's submitted
+        m_chain_tail = nullptr;
+        const std::size_t ret = m_to_submit;
+        m_to_submit = 0;
+        if(m_chains.empty())
+        {
+            return ret;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_queue.insert(m_queue.end(), m_chains.begin(), m_chains.end());
+        }
+        if(m_chains.size() == 1)
+        {
+            m_work.notify_one();
+        }
+        else
+        {
+            m_work.notify_all();
+        }
+        m_chains.clear();
+        return ret;
+    }
+
+    virtual void reap(
+            bool wait,
+            std::vector<IoRequest*>& out_completed) override
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if(wait)
+        {
+            m_done.wait(lock, [&]() { return !m_completed.empty(); });
+        }
+        out_completed.insert(
+            out_completed.end(),
+            m_completed.begin(),
+            m_completed.end()
+        );
+        m_completed.clear();
+    }
+
+private:
+
+    // registered files are only read by the threads while requests are
+    // pending, and only modified while none are
+    std::vector<int> m_files;
+
+    // chains which have been enqueued but not submitted
+    std::vector<IoRequest*> m_chains;
+    // the last request enqueued, if the next request is linked to it
+    IoRequest* m_chain_tail;
+    std::size_t m_to_submit;
+
+    // guards the following
+    std::mutex m_mutex;
+    std::condition_variable m_work;
+    std::condition_variable m_done;
+    std::deque<IoRequest*> m_queue;
+    std::vector<IoRequest*> m_completed;
+    bool m_stopping;
+
+    std::vector<std::thread> m_threads;
+
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while(true)
+        {
+            m_work.wait(lock, [&]()
+            {
+                return m_stopping || !m_queue.empty();
+            });
+            if(m_queue.empty())
+            {
+                return;
+            }
+            IoRequest* request = m_queue.front();
+            m_queue.pop_front();
+            lock.unlock();
+
+            bool cancelled = false;
+            while(request != nullptr)
+            {
+                // the request may be reused once it has completed
+                IoRequest* next = request->m_next;
+                if(cancelled)
+                {
+                    request->m_result = -ECANCELED;
+                }
+                else
+                {
+                    request->m_result = perform(*request);
+                    cancelled = request->m_linked &&
+                        request->m_result !=
+                        static_cast<std::int64_t>(request->m_vector.iov_len);
+                }
+
+                lock.lock();
+                m_completed.push_back(request);
+                lock.unlock();
+                m_done.notify_one();
+                request = next;
+            }
+            lock.lock();
+        }
+    }
+
+    // performs the given request, returning its result
+    std::int64_t perform(const IoRequest& request)
+    {
+        const int fd = request.m_registered_file ?
+            m_files[static_cast<std::size_t>(request.m_fd)] : request.m_fd;
+        while(true)
+        {
+            ssize_t result = 0;
+            if(request.m_operation == IoRequest::Operation::kRead)
+            {
+                result = ::pread(
+                    fd,
+                    request.m_vector.iov_base,
+                    request.m_vector.iov_len,
+                    static_cast<off_t>(request.m_offset)
+                );
+            }
+            else
+            {
+                result = ::pwrite(
+                    fd,
+                    request.m_vector.iov_base,
+                    request.m_vector.iov_len,
+                    static_cast<off_t>(request.m_offset)
+                );
+            }
+            if(result >= 0)
+            {
+                return result;
+            }
+            if(errno != EINTR)
+            {
+                return -errno;
+            }
+        }
+    }
+};
+
+//------------------------------------------------------------------------------
+//                                  CONSTRUCTOR
+//------------------------------------------------------------------------------
+
+IoEngine::IoEngine(
+        std::size_t queue_depth,
+        IoBackend backend,
+        std::size_t thread_count)
+    : m_queue_depth      (queue_depth > 0 ? queue_depth : 1)
+    , m_backend_type     (IoBackend::kThreadPool)
+    , m_pending_count    (0)
+    , m_unsubmitted_count(0)
+    , m_chain_open       (false)
+    , m_file_count       (0)
+{
+    if(backend != IoBackend::kThreadPool)
+    {
+#ifdef ARC_IO_URING
+        try
+        {
+            m_backend.reset(new IoUringBackend(m_queue_depth));
+            m_backend_type = IoBackend::kIoUring;
+        }
+        catch(const arc::ex::RuntimeError&)
+        {
+            if(backend == IoBackend::kIoUring)
+            {
+                throw;
+            }
+        }
+#else
+        if(backend == IoBackend::kIoUring)
+        {
+            throw arc::ex::RuntimeError(
+                "io_uring is not supported on this platform."
+            );
+        }
+#endif
+    }
+    if(!m_backend)
+    {
+        m_backend.reset(
+            new ThreadPoolBackend(thread_count > 0 ? thread_count : 1)
+        );
+    }
+}
+
+//------------------------------------------------------------------------------
+//                                   DESTRUCTOR
+//------------------------------------------------------------------------------
+
+IoEngine::~IoEngine()
+{
+    // the requests' buffers may not be released while the requests are in
+    // flight, so exceptions from callbacks don't stop the wait
+    while(m_pending_count > 0)
+    {
+        const std::size_t pending_count = m_pending_count;
+        try
+        {
+            wait_all();
+        }
+        catch(...)
+        {
+            // a callback which throws still completes its request, so if
+            // nothing completed the backend itself is failing, and the
+            // remaining requests are abandoned to its destructor
+            if(m_pending_count == pending_count)
+            {
+                break;
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC STATIC FUNCTIONS
+//------------------------------------------------------------------------------
+
+bool IoEngine::is_io_uring_supported()
+{
+#ifdef ARC_IO_URING
+    static const bool supported = []()
+    {
+        struct io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        const int fd = io_uring_setup(1, &params);
+        if(fd < 0)
+        {
+            return false;
+        }
+        ::close(fd);
+        return true;
+    }();
+    return supported;
+#else
+    return false;
+#endif
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+IoBackend IoEngine::get_backend() const
+{
+    return m_backend_type;
+}
+
+void IoEngine::register_files(arc::lang::Span<const int> fds)
+{
+    if(m_pending_count != 0)
+    {
+        throw arc::ex::StateError(
+            "Files cannot be registered while requests are pending."
+        );
+    }
+    m_file_count = 0;
+    m_backend->register_files(fds);
+    m_file_count = fds.size();
+}
+
+void IoEngine::register_buffers(
+        arc::lang::Span<const arc::lang::Span<char>> buffers)
+{
+    if(m_pending_count != 0)
+    {
+        throw arc::ex::StateError(
+            "Buffers cannot be registered while requests are pending."
+        );
+    }
+    m_buffers.clear();
+    m_backend->register_buffers(buffers);
+    m_buffers.assign(buffers.begin(), buffers.end());
+}
+
+void IoEngine::enqueue(IoRequest& request)
+{
+    if(request.m_operation == IoRequest::Operation::kNone)
+    {
+        throw arc::ex::ValueError("The I/O request has not been prepared.");
+    }
+    if(request.m_pending)
+    {
+        throw arc::ex::StateError("The I/O request is already pending.");
+    }
+    if(request.m_registered_file &&
+       (request.m_fd < 0 ||
+        static_cast<std::size_t>(request.m_fd) >= m_file_count))
+    {
+        throw arc::ex::ValueError(
+            "The I/O request refers to a file which is not registered."
+        );
+    }
+    if(request.m_buffer_index >= 0)
+    {
+        const char* data = static_cast<const char*>(request.m_vector.iov_base);
+        const std::size_t index =
+            static_cast<std::size_t>(request.m_buffer_index);
+        if(index >= m_buffers.size() ||
+           data < m_buffers[index].data() ||
+           data + request.m_vector.iov_len > m_buffers[index].end())
+        {
+            throw arc::ex::ValueError(
+                "The I/O request's buffer is not within the registered buffer "
+                "it refers to."
+            );
+        }
+    }
+
+    // make room by waiting for requests in flight, submitting would end an
+    // open chain of linked requests early, so then only the requests already
+    // submitted can be waited for
+    while(m_pending_count >= m_queue_depth)
+    {
+        if(!m_chain_open)
+        {
+            submit();
+        }
+        else if(m_pending_count == m_unsubmitted_count)
+        {
+            throw arc::ex::ValueError(
+                "The chain of linked I/O requests, and the requests enqueued "
+                "before it, exceed the engine's queue depth."
+            );
+        }
+        reap(true);
+    }
+
+    request.m_pending = true;
+    ++m_pending_count;
+    ++m_unsubmitted_count;
+    m_chain_open = request.m_linked;
+    m_backend->enqueue(request);
+}
+
+std::size_t IoEngine::submit()
+{
+    m_unsubmitted_count = 0;
+    m_chain_open = false;
+    return m_backend->submit();
+}
+
+std::size_t IoEngine::poll()
+{
+    return reap(false);
+}
+
+void IoEngine::wait(IoRequest& request)
+{
+    // callbacks may enqueue more requests, which are submitted as well
+    while(request.m_pending)
+    {
+        submit();
+        reap(true);
+    }
+}
+
+void IoEngine::wait_all()
+{
+    while(m_pending_count > 0)
+    {
+        submit();
+        reap(true);
+    }
+}
+
+std::size_t IoEngine::get_pending_count() const
+{
+    return m_pending_count;
+}
+
+//------------------------------------------------------------------------------
+//                            PRIVATE MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+std::size_t IoEngine::reap(bool wait)
+{
+    m_backend->reap(wait && m_completed.empty(), m_completed);
+
+    // callbacks may enqueue or wait on requests themselves, so they're called
+    // from a copy of the completed requests
+    std::vector<IoRequest*> completed;
+    completed.swap(m_completed);
+    for(std::size_t i = 0; i < completed.size(); ++i)
+    {
+        IoRequest& request = *completed[i];
+        request.m_pending = false;
+        --m_pending_count;
+        if(request.m_callback)
+        {
+            try
+            {
+                request.m_callback(request);
+            }
+            catch(...)
+            {
+                // the rest are called by the next reap
+                m_completed.insert(
+                    m_completed.begin(),
+                    completed.begin() + i + 1,
+                    completed.end()
+                );
+                throw;
+            }
+        }
+    }
+
+    // keep the capacity
+    const std::size_t ret = completed.size();
+    if(m_completed.empty())
+    {
+        completed.clear();
+        m_completed.swap(completed);
+    }
+    return ret;
+}
+
+} // namespace io
+ARC_BASE_VERSION_NS_END
+} // namespace arc
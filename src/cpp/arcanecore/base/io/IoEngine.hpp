@@ -0,0 +1,302 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Asynchronous file I/O using io_uring, or a thread pool where io_uring
+ *        is unavailable.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_IO_IOENGINE_HPP_
+#define ARCANECORE_BASE_IO_IOENGINE_HPP_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/io/IoRequest.hpp"
+#include "arcanecore/base/lang/Restrictors.hpp"
+#include "arcanecore/base/lang/Span.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace io
+{
+
+//------------------------------------------------------------------------------
+//                                  ENUMERATORS
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief The implementations of arc::io::IoEngine.
+ */
+enum class IoBackend
+{
+    /*!
+     * io_uring if it's supported, and otherwise the thread pool.
+     */
+    kAuto,
+    /*!
+     * Linux's io_uring, where requests are submitted to the kernel in batches
+     * with a single system call, and completions are read from shared memory.
+     */
+    kIoUring,
+    /*!
+     * A pool of threads which perform requests with blocking ```pread``` and
+     * ```pwrite``` calls.
+     */
+    kThreadPool
+};
+
+//------------------------------------------------------------------------------
+//                                   IO ENGINE
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief Performs arc::io::IoRequest reads and writes of files
+ *        asynchronously, so that many requests can be in flight at once.
+ *
+ * Requests are enqueued one at a time and submitted together in a batch by
+ * submit(). Completed requests are collected by poll() and the wait
+ * functions, which call the callbacks of the requests on the calling thread,
+ * so callbacks never run concurrently with each other.
+ *
+ * \code
+ * arc::io::IoEngine engine;
+ * std::vector<arc::io::IoRequest> requests(files.size());
+ * for(std::size_t i = 0; i < files.size(); ++i)
+ * {
+ *     requests[i].prepare_read(files[i], buffers[i], BUFFER_SIZE, 0);
+ *     engine.enqueue(requests[i]);
+ * }
+ * engine.submit();
+ * engine.wait_all();
+ * \endcode
+ *
+ * Where io_uring is unavailable (older kernels, other operating systems, or
+ * where it's disabled) the engine falls back to a thread pool with the same
+ * behaviour, including registered files and linked requests.
+ *
+ * An engine may only be used by one thread at a time.
+ */
+class IoEngine
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                              PUBLIC CONSTANTS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief The number of requests that may be in flight at once, if it is
+     *        not specified.
+     */
+    static const std::size_t DEFAULT_QUEUE_DEPTH = 256;
+
+    /*!
+     * \brief The number of threads of the thread pool backend, if it is not
+     *        specified.
+     */
+    static const std::size_t DEFAULT_THREAD_COUNT = 4;
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Constructs a new engine.
+     *
+     * \param queue_depth The number of requests that may be in flight at once.
+     *                    Enqueuing more waits for requests to complete.
+     * \param backend The implementation to use.
+     * \param thread_count The number of threads if the thread pool backend is
+     *                     used.
+     *
+     * \throws arc::ex::RuntimeError If arc::io::IoBackend::kIoUring was
+     *                               requested but is not supported.
+     */
+    explicit IoEngine(
+            std::size_t queue_depth = DEFAULT_QUEUE_DEPTH,
+            IoBackend backend = IoBackend::kAuto,
+            std::size_t thread_count = DEFAULT_THREAD_COUNT);
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Waits for every request in flight to complete (calling their
+     *        callbacks).
+     *
+     * If the backend fails while waiting the remaining requests are abandoned
+     * rather than waited for indefinitely.
+     */
+    ~IoEngine();
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC STATIC FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns whether io_uring can be used on this system.
+     */
+    static bool is_io_uring_supported();
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns the implementation being used, which is never
+     *        arc::io::IoBackend::kAuto.
+     */
+    IoBackend get_backend() const;
+
+    /*!
+     * \brief Registers the given file descriptors, replacing any registered
+     *        previously, so that requests can refer to them by their index
+     *        (see arc::io::IoRequest::set_registered_file()).
+     *
+     * \throws arc::ex::StateError If requests are pending.
+     * \throws arc::ex::RuntimeError If the files could not be registered.
+     */
+    void register_files(arc::lang::Span<const int> fds);
+
+    /*!
+     * \brief Registers the given buffers, replacing any registered previously,
+     *        so that requests within them can refer to them by their index
+     *        (see arc::io::IoRequest::set_registered_buffer()).
+     *
+     * \throws arc::ex::StateError If requests are pending.
+     * \throws arc::ex::RuntimeError If the buffers could not be registered
+     *                               (e.g. they exceed the limit of locked
+     *                               memory).
+     */
+    void register_buffers(arc::lang::Span<const arc::lang::Span<char>> buffers);
+
+    /*!
+     * \brief Adds the request to the next batch to be submitted.
+     *
+     * If the queue depth has been reached, this submits the requests enqueued
+     * so far, and waits for requests to complete (calling their callbacks).
+     * If the previous request is linked to this one nothing is submitted, so
+     * that the chain is not split, and only requests that were submitted
+     * already are waited for.
+     *
+     * \throws arc::ex::ValueError If the request is not prepared, or refers
+     *                             to a file or buffer that isn't registered,
+     *                             or if it continues a chain of linked
+     *                             requests which (along with the requests
+     *                             enqueued but not submitted before it) would
+     *                             exceed the queue depth.
+     * \throws arc::ex::StateError If the request is already pending.
+     */
+    void enqueue(IoRequest& request);
+
+    /*!
+     * \brief Submits the requests that have been enqueued, and returns the
+     *        number submitted.
+     */
+    std::size_t submit();
+
+    /*!
+     * \brief Calls the callbacks of the requests which have completed without
+     *        waiting, and returns the number of requests that completed.
+     */
+    std::size_t poll();
+
+    /*!
+     * \brief Submits the enqueued requests and waits until the given request
+     *        has completed, calling the callbacks of the requests that
+     *        complete meanwhile.
+     */
+    void wait(IoRequest& request);
+
+    /*!
+     * \brief Submits the enqueued requests and waits until every request has
+     *        completed.
+     */
+    void wait_all();
+
+    /*!
+     * \brief Returns the number of requests which have been enqueued and have
+     *        not completed.
+     */
+    std::size_t get_pending_count() const;
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                               PRIVATE TYPES
+    //--------------------------------------------------------------------------
+
+    class Backend;
+    class IoUringBackend;
+    class ThreadPoolBackend;
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    const std::size_t m_queue_depth;
+    std::unique_ptr<Backend> m_backend;
+    IoBackend m_backend_type;
+    std::size_t m_pending_count;
+    // the number of requests enqueued since the last submit, and whether the
+    // last of them is linked to the next
+    std::size_t m_unsubmitted_count;
+    bool m_chain_open;
+    // the size of the registered tables, to validate requests against
+    std::size_t m_file_count;
+    std::vector<arc::lang::Span<char>> m_buffers;
+    // requests which have completed but whose callbacks have not been called
+    std::vector<IoRequest*> m_completed;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    // collects completed requests, waiting for at least one if need be, and
+    // calls their callbacks
+    std::size_t reap(bool wait);
+};
+
+} // namespace io
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
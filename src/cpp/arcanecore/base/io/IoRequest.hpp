@@ -0,0 +1,288 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief A read or write of a file submitted to an arc::io::IoEngine.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_IO_IOREQUEST_HPP_
+#define ARCANECORE_BASE_IO_IOREQUEST_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/lang/Restrictors.hpp"
+
+#include <sys/uio.h>
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace io
+{
+
+class IoEngine;
+
+/*!
+ * \brief A read or write of part of a file, which is performed asynchronously
+ *        by an arc::io::IoEngine.
+ *
+ * Requests are owned by the caller, and neither the request nor its buffer
+ * may be destroyed or modified until it has completed. A request may be
+ * prepared and enqueued again once it has completed.
+ *
+ * \code
+ * arc::io::IoRequest request;
+ * request.prepare_read(fd, buffer, sizeof(buffer), 0);
+ * request.set_callback([](arc::io::IoRequest& r)
+ * {
+ *     std::cout << "read " << r.get_result() << " bytes" << std::endl;
+ * });
+ * engine.enqueue(request);
+ * engine.submit();
+ * \endcode
+ */
+class IoRequest
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                                   TYPES
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Called with the request once it has completed.
+     */
+    typedef std::function<void(IoRequest&)> Callback;
+
+    /*!
+     * \brief The operations a request may perform.
+     */
+    enum class Operation : unsigned char
+    {
+        kNone,
+        kRead,
+        kWrite
+    };
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    IoRequest()
+        : m_operation     (Operation::kNone)
+        , m_registered_file(false)
+        , m_linked        (false)
+        , m_pending       (false)
+        , m_fd            (-1)
+        , m_buffer_index  (-1)
+        , m_offset        (0)
+        , m_result        (0)
+        , m_next          (nullptr)
+    {
+        m_vector.iov_base = nullptr;
+        m_vector.iov_len = 0;
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Prepares the request to read up to the given number of bytes from
+     *        the given offset of the file into the buffer.
+     *
+     * This resets the registered file and buffer, and whether the request is
+     * linked.
+     */
+    void prepare_read(
+            int fd,
+            char* buffer,
+            std::size_t size,
+            std::uint64_t offset)
+    {
+        prepare(Operation::kRead, fd, buffer, size, offset);
+    }
+
+    /*!
+     * \brief Prepares the request to write the given bytes to the given
+     *        offset of the file.
+     *
+     * This resets the registered file and buffer, and whether the request is
+     * linked.
+     */
+    void prepare_write(
+            int fd,
+            const char* buffer,
+            std::size_t size,
+            std::uint64_t offset)
+    {
+        prepare(Operation::kWrite, fd, const_cast<char*>(buffer), size, offset);
+    }
+
+    /*!
+     * \brief Sets whether the file descriptor given to prepare_read() or
+     *        prepare_write() is instead the index of a file registered with
+     *        arc::io::IoEngine::register_files().
+     *
+     * Registered files save the kernel looking up the file for every
+     * request.
+     */
+    void set_registered_file(bool registered)
+    {
+        m_registered_file = registered;
+    }
+
+    /*!
+     * \brief Sets the index of the buffer registered with
+     *        arc::io::IoEngine::register_buffers() that the buffer of the
+     *        request lies in, or -1 if it is not in a registered buffer.
+     *
+     * Registered buffers are pinned in memory once, rather than for every
+     * request.
+     */
+    void set_registered_buffer(int index)
+    {
+        m_buffer_index = index;
+    }
+
+    /*!
+     * \brief Sets whether the next request enqueued on the same engine only
+     *        starts once this request has completed.
+     *
+     * If this request fails or transfers fewer bytes than requested, the rest
+     * of the chain of linked requests is cancelled, and completes with
+     * ```-ECANCELED```.
+     */
+    void set_linked(bool linked)
+    {
+        m_linked = linked;
+    }
+
+    /*!
+     * \brief Sets the function called when the request completes.
+     *
+     * The callback is called by the thread that calls arc::io::IoEngine::poll()
+     * or one of the wait functions of the engine, and may enqueue further
+     * requests.
+     */
+    void set_callback(Callback callback)
+    {
+        m_callback = std::move(callback);
+    }
+
+    /*!
+     * \brief Returns the operation the request was prepared for.
+     */
+    Operation get_operation() const
+    {
+        return m_operation;
+    }
+
+    /*!
+     * \brief Returns whether the request has been enqueued and has not yet
+     *        completed.
+     */
+    bool is_pending() const
+    {
+        return m_pending;
+    }
+
+    /*!
+     * \brief Returns the number of bytes transferred by the completed
+     *        request, or the negated ```errno``` value if it failed.
+     */
+    std::int64_t get_result() const
+    {
+        return m_result;
+    }
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                                  FRIENDS
+    //--------------------------------------------------------------------------
+
+    friend class IoEngine;
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    Operation m_operation;
+    bool m_registered_file;
+    bool m_linked;
+    bool m_pending;
+    int m_fd;
+    int m_buffer_index;
+    // the buffer, which io_uring reads from when the request is submitted
+    struct iovec m_vector;
+    std::uint64_t m_offset;
+    std::int64_t m_result;
+    Callback m_callback;
+    // the next request of a linked chain in the thread pool backend
+    IoRequest* m_next;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    void prepare(
+            Operation operation,
+            int fd,
+            char* buffer,
+            std::size_t size,
+            std::uint64_t offset)
+    {
+        m_operation = operation;
+        m_registered_file = false;
+        m_linked = false;
+        m_fd = fd;
+        m_buffer_index = -1;
+        m_vector.iov_base = buffer;
+        m_vector.iov_len = size;
+        m_offset = offset;
+        m_result = 0;
+    }
+};
+
+} // namespace io
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
@@ -0,0 +1,424 @@
+/*!
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "arcanecore/base/io/MappedFile.hpp"
+
+#include <cerrno>
+
+#include <deus/Constants.hpp>
+#include <deus/UnicodeStorage.hpp>
+
+#include "arcanecore/base/Exceptions.hpp"
+#include "arcanecore/base/Preproc.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace io
+{
+
+namespace
+{
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+std::size_t get_page_size()
+{
+    static const std::size_t page_size =
+        static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    return page_size;
+}
+
+// rounds the given size up to a multiple of the page size
+std::size_t round_to_pages(std::size_t size)
+{
+    const std::size_t page_size = get_page_size();
+    return (size + page_size - 1) / page_size * page_size;
+}
+
+// sets the size of the file, retrying if interrupted
+bool truncate_file(int fd, std::size_t size)
+{
+    while(::ftruncate(fd, static_cast<off_t>(size)) != 0)
+    {
+        if(errno != EINTR)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                  CONSTRUCTORS
+//------------------------------------------------------------------------------
+
+MappedFile::MappedFile()
+    : m_fd      (-1)
+    , m_mode    (MapMode::kReadOnly)
+    , m_data    (nullptr)
+    , m_size    (0)
+    , m_capacity(0)
+{
+}
+
+MappedFile::MappedFile(
+        const deus::UnicodeView& path,
+        MapMode mode,
+        bool populate)
+    : MappedFile()
+{
+    open(path, mode, populate);
+}
+
+//------------------------------------------------------------------------------
+//                                   DESTRUCTOR
+//------------------------------------------------------------------------------
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+void MappedFile::open(
+        const deus::UnicodeView& path,
+        MapMode mode,
+        bool populate)
+{
+    try_open(path, mode, populate).get_or_throw();
+}
+
+arc::Result<void> MappedFile::try_open(
+        const deus::UnicodeView& path,
+        MapMode mode,
+        bool populate)
+{
+    close();
+
+    deus::UnicodeStorage converted;
+    const deus::UnicodeView& utf8_path = path.convert_if_not(
+        deus::ASCII_COMPATIBLE_ENCODINGS,
+        deus::Encoding::kUTF8,
+        converted
+    );
+
+    int flags = O_CLOEXEC;
+    if(mode == MapMode::kReadOnly)
+    {
+        flags |= O_RDONLY;
+    }
+    else
+    {
+        flags |= O_RDWR | O_CREAT;
+    }
+    int fd = -1;
+    do
+    {
+        fd = ::open(utf8_path.c_str(), flags, 0644);
+    } while(fd < 0 && errno == EINTR);
+    if(fd < 0)
+    {
+        return arc::ex::Error(
+            arc::ex::ErrorCode::kRuntimeError,
+            "Failed to open the file to map."
+        );
+    }
+
+    struct stat info;
+    if(::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode))
+    {
+        ::close(fd);
+        return arc::ex::Error(
+            arc::ex::ErrorCode::kRuntimeError,
+            "Only regular files can be mapped."
+        );
+    }
+
+    m_fd = fd;
+    m_mode = mode;
+    m_size = static_cast<std::size_t>(info.st_size);
+    arc::Result<void> mapped = remap(round_to_pages(m_size), populate);
+    if(mapped.is_error())
+    {
+        close();
+    }
+    return mapped;
+}
+
+void MappedFile::close()
+{
+    if(m_data != nullptr)
+    {
+        ::munmap(m_data, m_capacity);
+    }
+    if(m_fd >= 0)
+    {
+        ::close(m_fd);
+    }
+    m_fd = -1;
+    m_data = nullptr;
+    m_size = 0;
+    m_capacity = 0;
+}
+
+bool MappedFile::is_open() const
+{
+    return m_fd >= 0;
+}
+
+MapMode MappedFile::get_mode() const
+{
+    return m_mode;
+}
+
+std::size_t MappedFile::size() const
+{
+    return m_size;
+}
+
+bool MappedFile::empty() const
+{
+    return m_size == 0;
+}
+
+std::size_t MappedFile::get_capacity() const
+{
+    return m_capacity;
+}
+
+const char* MappedFile::data() const
+{
+    return m_data;
+}
+
+arc::lang::Span<const char> MappedFile::view(
+        std::size_t offset,
+        std::size_t size) const
+{
+    return arc::lang::Span<const char>(m_data, m_size).subspan(offset, size);
+}
+
+arc::lang::Span<char> MappedFile::mutable_view(
+        std::size_t offset,
+        std::size_t size)
+{
+    if(m_mode != MapMode::kReadWrite)
+    {
+        throw arc::ex::StateError(
+            "A read-only mapped file cannot be written to."
+        );
+    }
+    return arc::lang::Span<char>(m_data, m_size).subspan(offset, size);
+}
+
+bool MappedFile::advise(MapAdvice advice, std::size_t offset, std::size_t size)
+{
+    if(m_data == nullptr || offset >= m_capacity)
+    {
+        return false;
+    }
+
+    int flag = MADV_NORMAL;
+    switch(advice)
+    {
+        case MapAdvice::kNormal:
+        {
+            flag = MADV_NORMAL;
+            break;
+        }
+        case MapAdvice::kSequential:
+        {
+            flag = MADV_SEQUENTIAL;
+            break;
+        }
+        case MapAdvice::kRandom:
+        {
+            flag = MADV_RANDOM;
+            break;
+        }
+        case MapAdvice::kWillNeed:
+        {
+            flag = MADV_WILLNEED;
+            break;
+        }
+        case MapAdvice::kHugePage:
+        {
+#ifdef MADV_HUGEPAGE
+            flag = MADV_HUGEPAGE;
+            break;
+#else
+            return false;
+#endif
+        }
+    }
+
+    // the range must start on a page boundary
+    const std::size_t start = offset / get_page_size() * get_page_size();
+    const std::size_t end =
+        size >= m_capacity - offset ? m_capacity : offset + size;
+    return ::madvise(m_data + start, end - start, flag) == 0;
+}
+
+void MappedFile::resize(std::size_t size)
+{
+    try_resize(size).get_or_throw();
+}
+
+arc::Result<void> MappedFile::try_resize(std::size_t size)
+{
+    if(!is_open() || m_mode != MapMode::kReadWrite)
+    {
+        return arc::ex::Error(
+            arc::ex::ErrorCode::kStateError,
+            "Only files which are mapped read-write can be resized."
+        );
+    }
+
+    if(size > m_capacity)
+    {
+        // grow geometrically so that appending is amortised constant time
+        std::size_t capacity = m_capacity * 2;
+        if(capacity < size)
+        {
+            capacity = size;
+        }
+        arc::Result<void> mapped = remap(round_to_pages(capacity), false);
+        if(mapped.is_error())
+        {
+            return mapped;
+        }
+    }
+
+    if(!truncate_file(m_fd, size))
+    {
+        return arc::ex::Error(
+            arc::ex::ErrorCode::kRuntimeError,
+            "Failed to resize the mapped file."
+        );
+    }
+    m_size = size;
+    return arc::Result<void>();
+}
+
+void MappedFile::reserve(std::size_t capacity)
+{
+    if(!is_open() || m_mode != MapMode::kReadWrite)
+    {
+        throw arc::ex::StateError(
+            "Only files which are mapped read-write can reserve capacity."
+        );
+    }
+    if(capacity > m_capacity)
+    {
+        remap(round_to_pages(capacity), false).get_or_throw();
+    }
+}
+
+void MappedFile::sync()
+{
+    if(m_data != nullptr &&
+       m_mode == MapMode::kReadWrite &&
+       ::msync(m_data, m_capacity, MS_SYNC) != 0)
+    {
+        throw arc::ex::RuntimeError("Failed to sync the mapped file.");
+    }
+}
+
+//------------------------------------------------------------------------------
+//                            PRIVATE MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+arc::Result<void> MappedFile::remap(std::size_t capacity, bool populate)
+{
+    if(capacity == m_capacity)
+    {
+        return arc::Result<void>();
+    }
+
+    void* mapped = MAP_FAILED;
+#ifdef ARC_OS_LINUX
+    // extends the mapping in place where the address space after it is free
+    if(m_data != nullptr)
+    {
+        mapped = ::mremap(m_data, m_capacity, capacity, MREMAP_MAYMOVE);
+    }
+    else
+#endif
+    {
+        int prot = PROT_READ;
+        if(m_mode == MapMode::kReadWrite)
+        {
+            prot |= PROT_WRITE;
+        }
+        int flags = MAP_SHARED;
+#ifdef MAP_POPULATE
+        if(populate)
+        {
+            flags |= MAP_POPULATE;
+        }
+#endif
+        mapped = ::mmap(nullptr, capacity, prot, flags, m_fd, 0);
+        if(mapped != MAP_FAILED && m_data != nullptr)
+        {
+            ::munmap(m_data, m_capacity);
+        }
+    }
+
+    if(mapped == MAP_FAILED)
+    {
+        return arc::ex::Error(
+            arc::ex::ErrorCode::kRuntimeError,
+            "Failed to map the file."
+        );
+    }
+    m_data = static_cast<char*>(mapped);
+    m_capacity = capacity;
+    return arc::Result<void>();
+}
+
+} // namespace io
+ARC_BASE_VERSION_NS_END
+} // namespace arc
@@ -0,0 +1,333 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Memory mapped files.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_IO_MAPPEDFILE_HPP_
+#define ARCANECORE_BASE_IO_MAPPEDFILE_HPP_
+
+#include <cstddef>
+
+#include <deus/UnicodeView.hpp>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/Result.hpp"
+#include "arcanecore/base/lang/Restrictors.hpp"
+#include "arcanecore/base/lang/Span.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace io
+{
+
+//------------------------------------------------------------------------------
+//                                  ENUMERATORS
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief How a file is mapped.
+ */
+enum class MapMode
+{
+    /*!
+     * The file must exist, and the mapping may only be read.
+     */
+    kReadOnly,
+    /*!
+     * The file is created if it doesn't exist, and writes to the mapping are
+     * written to the file.
+     */
+    kReadWrite
+};
+
+/*!
+ * \brief Hints about how a mapping will be accessed (see
+ *        arc::io::MappedFile::advise()).
+ */
+enum class MapAdvice
+{
+    /*!
+     * The default read ahead.
+     */
+    kNormal,
+    /*!
+     * Pages will be accessed in order, so read ahead aggressively and free
+     * pages soon after they're accessed.
+     */
+    kSequential,
+    /*!
+     * Pages will be accessed in no particular order, so don't read ahead.
+     */
+    kRandom,
+    /*!
+     * The pages will be needed soon, so start reading them now.
+     */
+    kWillNeed,
+    /*!
+     * Back the mapping with huge pages where possible, which reduces TLB
+     * misses when scanning large mappings. This is only supported by some
+     * file systems.
+     */
+    kHugePage
+};
+
+//------------------------------------------------------------------------------
+//                                  MAPPED FILE
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief A file mapped into memory, so that its contents can be read (and
+ *        written) in place without copying them through a buffer.
+ *
+ * \code
+ * arc::io::MappedFile file("data.bin");
+ * file.advise(arc::io::MapAdvice::kSequential);
+ * arc::lang::Span<const char> bytes = file.view();
+ * \endcode
+ *
+ * Read-write mappings can be grown with resize(). The mapping reserves
+ * address space beyond the size of the file (see reserve()), so growing the
+ * file within the reservation only extends the file, and pointers into the
+ * mapping remain valid. Growing beyond the reservation at least doubles it,
+ * which may move the mapping.
+ *
+ * Accessing a mapping after the file has been truncated by another process
+ * raises SIGBUS, so mapped files should not be shared with writers that
+ * don't also map them.
+ *
+ * \note Mapped files are only supported on UNIX.
+ */
+class MappedFile
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                              PUBLIC CONSTANTS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Used as a size to mean the rest of the mapping.
+     */
+    static const std::size_t npos = static_cast<std::size_t>(-1);
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Constructs a mapped file which is not open.
+     */
+    MappedFile();
+
+    /*!
+     * \brief Constructs a mapping of the given file.
+     *
+     * \see open()
+     */
+    explicit MappedFile(
+            const deus::UnicodeView& path,
+            MapMode mode = MapMode::kReadOnly,
+            bool populate = false);
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Unmaps and closes the file.
+     */
+    ~MappedFile();
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Maps the given file, closing the mapping that was open.
+     *
+     * \param path The path to the file.
+     * \param mode Whether the mapping may be written to.
+     * \param populate Whether to read the whole file into memory now, rather
+     *                 than as pages are first accessed. This costs more up
+     *                 front but avoids a page fault per page (only supported
+     *                 on Linux).
+     *
+     * \throws arc::ex::RuntimeError If the file could not be opened or mapped.
+     */
+    void open(
+            const deus::UnicodeView& path,
+            MapMode mode = MapMode::kReadOnly,
+            bool populate = false);
+
+    /*!
+     * \brief Non-throwing variant of open().
+     */
+    arc::Result<void> try_open(
+            const deus::UnicodeView& path,
+            MapMode mode = MapMode::kReadOnly,
+            bool populate = false);
+
+    /*!
+     * \brief Unmaps and closes the file, if it's open.
+     */
+    void close();
+
+    /*!
+     * \brief Returns whether a file is mapped.
+     */
+    bool is_open() const;
+
+    /*!
+     * \brief Returns how the file is mapped.
+     */
+    MapMode get_mode() const;
+
+    /*!
+     * \brief Returns the size of the file in bytes.
+     */
+    std::size_t size() const;
+
+    /*!
+     * \brief Returns whether the file is empty (or not open).
+     */
+    bool empty() const;
+
+    /*!
+     * \brief Returns the number of bytes of address space reserved for the
+     *        mapping, which the file can grow to without moving the mapping.
+     */
+    std::size_t get_capacity() const;
+
+    /*!
+     * \brief Returns the start of the mapping, or null if the file is empty.
+     */
+    const char* data() const;
+
+    /*!
+     * \brief Returns a view of the given range of the file.
+     *
+     * The size is clamped to the end of the file.
+     *
+     * \throws arc::ex::ValueError If the offset is past the end of the file.
+     */
+    arc::lang::Span<const char> view(
+            std::size_t offset = 0,
+            std::size_t size = npos) const;
+
+    /*!
+     * \brief Returns a writable view of the given range of the file.
+     *
+     * \throws arc::ex::StateError If the file is mapped read-only.
+     * \throws arc::ex::ValueError If the offset is past the end of the file.
+     */
+    arc::lang::Span<char> mutable_view(
+            std::size_t offset = 0,
+            std::size_t size = npos);
+
+    /*!
+     * \brief Hints how the given range of the mapping will be accessed.
+     *
+     * \return Whether the hint was accepted by the operating system, which
+     *         may ignore hints it doesn't support.
+     */
+    bool advise(
+            MapAdvice advice,
+            std::size_t offset = 0,
+            std::size_t size = npos);
+
+    /*!
+     * \brief Resizes the file, which must be mapped read-write.
+     *
+     * Pointers into the mapping remain valid unless the size is greater than
+     * get_capacity(). New bytes are zero.
+     *
+     * \throws arc::ex::StateError If the file is not mapped read-write.
+     * \throws arc::ex::RuntimeError If the file could not be resized.
+     */
+    void resize(std::size_t size);
+
+    /*!
+     * \brief Non-throwing variant of resize().
+     */
+    arc::Result<void> try_resize(std::size_t size);
+
+    /*!
+     * \brief Reserves address space so that the file can grow to the given
+     *        size without the mapping moving.
+     *
+     * \throws arc::ex::StateError If the file is not mapped read-write.
+     * \throws arc::ex::RuntimeError If the address space could not be
+     *                               reserved.
+     */
+    void reserve(std::size_t capacity);
+
+    /*!
+     * \brief Writes the modified pages of the mapping to the file, and waits
+     *        for them to be written.
+     *
+     * \throws arc::ex::RuntimeError If the pages could not be written.
+     */
+    void sync();
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    int m_fd;
+    MapMode m_mode;
+    char* m_data;
+    std::size_t m_size;
+    // the length of the mapping, which is a multiple of the page size
+    std::size_t m_capacity;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    // maps the file with the given length, replacing the current mapping
+    arc::Result<void> remap(std::size_t capacity, bool populate);
+};
+
+} // namespace io
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
@@ -0,0 +1,122 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Output sink which collects output in memory.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_IO_MEMORYSINK_HPP_
+#define ARCANECORE_BASE_IO_MEMORYSINK_HPP_
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/io/OutputSink.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace io
+{
+
+/*!
+ * \brief An arc::io::OutputSink which appends everything written to it to a
+ *        string in memory.
+ *
+ * This is useful for capturing the output of library code, e.g. to return the
+ * output of an arc::arg::Parser to a remote caller or to check it in a test.
+ */
+class MemorySink
+    : public arc::io::OutputSink
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Constructs a new empty sink.
+     */
+    MemorySink();
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    virtual ~MemorySink();
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    virtual void write_slices(const Slice* slices, std::size_t count) override;
+
+    /*!
+     * \brief Does nothing, since output is never buffered.
+     */
+    virtual void flush() override;
+
+    /*!
+     * \brief Returns a copy of everything that has been written to this sink.
+     */
+    std::string to_string() const;
+
+    /*!
+     * \brief Returns the number of bytes that have been written to this sink.
+     */
+    std::size_t size() const;
+
+    /*!
+     * \brief Discards everything that has been written to this sink.
+     */
+    void clear();
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    // guards the following
+    mutable std::mutex m_mutex;
+    std::string m_data;
+};
+
+} // namespace io
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
@@ -0,0 +1,141 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Abstract destination of text or binary output.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_IO_OUTPUTSINK_HPP_
+#define ARCANECORE_BASE_IO_OUTPUTSINK_HPP_
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/lang/Restrictors.hpp"
+#include "arcanecore/base/lang/StringBuilder.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace io
+{
+
+/*!
+ * \brief A contiguous range of bytes to be written to an arc::io::OutputSink.
+ */
+struct Slice
+{
+    const char* data;
+    std::size_t size;
+};
+
+/*!
+ * \brief Interface of a destination that bytes can be written to.
+ *
+ * Sinks may buffer what is written to them, so output is only guaranteed to
+ * have reached its destination after flush() has been called. Writing a
+ * number of slices in a single call allows a sink to pass them to the
+ * destination together (e.g. with a single ```writev``` system call), rather
+ * than copying them into one buffer first.
+ *
+ * Implementations must be safe to write to from multiple threads, and the
+ * bytes of each call are never interleaved with the bytes of other calls.
+ */
+class OutputSink
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    virtual ~OutputSink();
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Writes the given slices, in order, as a single write.
+     */
+    virtual void write_slices(const Slice* slices, std::size_t count) = 0;
+
+    /*!
+     * \brief Writes any output this sink has buffered to its destination.
+     */
+    virtual void flush() = 0;
+
+    /*!
+     * \brief Writes the given bytes.
+     */
+    void write(const char* data, std::size_t size)
+    {
+        const Slice slice = {data, size};
+        write_slices(&slice, 1);
+    }
+
+    /*!
+     * \brief Writes the given null terminated string.
+     */
+    void write(const char* s)
+    {
+        write(s, std::strlen(s));
+    }
+
+    /*!
+     * \brief Writes the given string.
+     */
+    void write(const std::string& s)
+    {
+        write(s.data(), s.size());
+    }
+
+    /*!
+     * \brief Writes the contents of the given builder.
+     */
+    void write(const arc::lang::StringBuilder& builder)
+    {
+        write(builder.data(), builder.size());
+    }
+};
+
+} // namespace io
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
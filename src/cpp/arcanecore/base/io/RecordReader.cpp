@@ -0,0 +1,501 @@
+/*!
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "arcanecore/base/io/RecordReader.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+#include "arcanecore/base/Exceptions.hpp"
+#include "arcanecore/base/Preproc.hpp"
+
+#if defined(ARC_SIMD_AVX2)
+    #include <immintrin.h>
+#elif defined(ARC_SIMD_SSE2)
+    #include <emmintrin.h>
+#elif defined(ARC_SIMD_NEON) && defined(__aarch64__)
+    #include <arm_neon.h>
+#endif
+
+#include <fcntl.h>
+#include <unistd.h>
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace io
+{
+
+namespace
+{
+
+//------------------------------------------------------------------------------
+//                                     BLOCK
+//------------------------------------------------------------------------------
+
+// the number of bytes scanned at a time, which is the number of bits of a mask
+static const std::size_t BLOCK_SIZE = 64;
+
+// 64 bytes of text, which are compared against a character to build a mask
+// with a bit set for each byte that matches
+class Block
+{
+public:
+
+    explicit Block(const char* data)
+    {
+        #if defined(ARC_SIMD_AVX2)
+            m_chunks[0] = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(data)
+            );
+            m_chunks[1] = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(data + 32)
+            );
+        #elif defined(ARC_SIMD_SSE2)
+            for(std::size_t i = 0; i < 4; ++i)
+            {
+                m_chunks[i] = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(data + i * 16)
+                );
+            }
+        #elif defined(ARC_SIMD_NEON) && defined(__aarch64__)
+            for(std::size_t i = 0; i < 4; ++i)
+            {
+                m_chunks[i] = vld1q_u8(
+                    reinterpret_cast<const std::uint8_t*>(data + i * 16)
+                );
+            }
+        #else
+            std::memcpy(m_chunks, data, BLOCK_SIZE);
+        #endif
+    }
+
+    std::uint64_t match(char c) const
+    {
+        #if defined(ARC_SIMD_AVX2)
+            const __m256i value = _mm256_set1_epi8(c);
+            const std::uint32_t low = static_cast<std::uint32_t>(
+                _mm256_movemask_epi8(_mm256_cmpeq_epi8(m_chunks[0], value))
+            );
+            const std::uint32_t high = static_cast<std::uint32_t>(
+                _mm256_movemask_epi8(_mm256_cmpeq_epi8(m_chunks[1], value))
+            );
+            return low | (static_cast<std::uint64_t>(high) << 32);
+        #elif defined(ARC_SIMD_SSE2)
+            const __m128i value = _mm_set1_epi8(c);
+            std::uint64_t mask = 0;
+            for(std::size_t i = 0; i < 4; ++i)
+            {
+                mask |= static_cast<std::uint64_t>(static_cast<std::uint16_t>(
+                    _mm_movemask_epi8(_mm_cmpeq_epi8(m_chunks[i], value))
+                )) << (i * 16);
+            }
+            return mask;
+        #elif defined(ARC_SIMD_NEON) && defined(__aarch64__)
+            // NEON has no movemask, so each matching byte is reduced to its
+            // bit and the bytes are summed together pairwise
+            static const std::uint8_t BITS[16] = {
+                1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128
+            };
+            const uint8x16_t bits = vld1q_u8(BITS);
+            const uint8x16_t value = vdupq_n_u8(static_cast<std::uint8_t>(c));
+            uint8x16_t sums[4];
+            for(std::size_t i = 0; i < 4; ++i)
+            {
+                sums[i] = vandq_u8(vceqq_u8(m_chunks[i], value), bits);
+            }
+            uint8x16_t sum = vpaddq_u8(
+                vpaddq_u8(sums[0], sums[1]),
+                vpaddq_u8(sums[2], sums[3])
+            );
+            sum = vpaddq_u8(sum, sum);
+            return vgetq_lane_u64(vreinterpretq_u64_u8(sum), 0);
+        #else
+            std::uint64_t mask = 0;
+            for(std::size_t i = 0; i < BLOCK_SIZE; ++i)
+            {
+                mask |= static_cast<std::uint64_t>(m_chunks[i] == c) << i;
+            }
+            return mask;
+        #endif
+    }
+
+private:
+
+    #if defined(ARC_SIMD_AVX2)
+        __m256i m_chunks[2];
+    #elif defined(ARC_SIMD_SSE2)
+        __m128i m_chunks[4];
+    #elif defined(ARC_SIMD_NEON) && defined(__aarch64__)
+        uint8x16_t m_chunks[4];
+    #else
+        char m_chunks[BLOCK_SIZE];
+    #endif
+};
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+// returns the index of the lowest set bit of a non-zero mask
+std::size_t count_trailing_zeros(std::uint64_t mask)
+{
+    #if defined(__GNUC__) || defined(__clang__)
+        return static_cast<std::size_t>(__builtin_ctzll(mask));
+    #else
+        std::size_t result = 0;
+        while((mask & 1U) == 0)
+        {
+            mask >>= 1;
+            ++result;
+        }
+        return result;
+    #endif
+}
+
+// sets each bit to the XOR of it and every bit below it, so that given the
+// mask of quotes, the bits from an opening quote up to its closing quote are
+// set (escaped quotes are doubled, so they cancel out)
+std::uint64_t prefix_xor(std::uint64_t mask)
+{
+    mask ^= mask << 1;
+    mask ^= mask << 2;
+    mask ^= mask << 4;
+    mask ^= mask << 8;
+    mask ^= mask << 16;
+    mask ^= mask << 32;
+    return mask;
+}
+
+// returns the mask of the delimiters in the block of the given size (up to 64
+// bytes) which are outside of quotes, where quoted is all ones if the block
+// starts within quotes, and is updated to whether it ends within them
+std::uint64_t find_delimiters(
+        const char* data,
+        std::size_t size,
+        char delimiter,
+        bool quoting,
+        std::uint64_t& quoted)
+{
+    // the end of the text is copied so that it isn't read past
+    char padded[BLOCK_SIZE];
+    if(size < BLOCK_SIZE)
+    {
+        std::memcpy(padded, data, size);
+        std::memset(padded + size, 0, BLOCK_SIZE - size);
+        data = padded;
+    }
+
+    const Block block(data);
+    std::uint64_t delimiters = block.match(delimiter);
+    if(quoting)
+    {
+        const std::uint64_t inside = prefix_xor(block.match('"')) ^ quoted;
+        delimiters &= ~inside;
+        quoted = 0 - (inside >> 63);
+    }
+    if(size < BLOCK_SIZE)
+    {
+        delimiters &= (static_cast<std::uint64_t>(1) << size) - 1;
+    }
+    return delimiters;
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                  CONSTRUCTORS
+//------------------------------------------------------------------------------
+
+RecordReader::RecordReader(
+        arc::lang::Span<const char> data,
+        RecordFormat format)
+    : m_format      (format)
+    , m_fd          (-1)
+    , m_window_size (0)
+    , m_capacity    (0)
+    , m_data        (data.data())
+    , m_size        (data.size())
+    , m_end         (true)
+    , m_position    (0)
+    , m_scanned     (0)
+    , m_delimiters  (0)
+    , m_block       (0)
+    , m_quoted      (0)
+    , m_record_count(0)
+{
+}
+
+RecordReader::RecordReader(
+        int fd,
+        RecordFormat format,
+        std::size_t window_size)
+    : m_format      (format)
+    , m_fd          (fd)
+    , m_window_size (window_size > 0 ? window_size : 1)
+    , m_buffer      (new char[m_window_size * 2])
+    , m_capacity    (m_window_size * 2)
+    , m_data        (m_buffer.get())
+    , m_size        (0)
+    , m_end         (false)
+    , m_position    (0)
+    , m_scanned     (0)
+    , m_delimiters  (0)
+    , m_block       (0)
+    , m_quoted      (0)
+    , m_record_count(0)
+{
+    // the kernel reads ahead further for sequential access, which overlaps
+    // reading the next window with splitting this one
+    #ifdef POSIX_FADV_SEQUENTIAL
+        ::posix_fadvise(m_fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    #endif
+}
+
+//------------------------------------------------------------------------------
+//                                   DESTRUCTOR
+//------------------------------------------------------------------------------
+
+RecordReader::~RecordReader()
+{
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+RecordFormat RecordReader::get_format() const
+{
+    return m_format;
+}
+
+bool RecordReader::next(arc::lang::Span<const char>& out_record)
+{
+    while(m_delimiters == 0)
+    {
+        // a partial block is only scanned at the end of the text, since a
+        // delimiter could follow it
+        const std::size_t remaining = m_size - m_scanned;
+        if(remaining >= BLOCK_SIZE || (m_end && remaining > 0))
+        {
+            const std::size_t size =
+                remaining < BLOCK_SIZE ? remaining : BLOCK_SIZE;
+            m_block = m_scanned;
+            m_delimiters = find_delimiters(
+                m_data + m_scanned,
+                size,
+                '\n',
+                m_format == RecordFormat::kCsv,
+                m_quoted
+            );
+            m_scanned += size;
+        }
+        else if(!m_end)
+        {
+            m_end = !refill();
+        }
+        else if(m_position < m_size)
+        {
+            // the last record isn't terminated
+            std::size_t size = m_size - m_position;
+            if(m_data[m_size - 1] == '\r')
+            {
+                --size;
+            }
+            out_record = arc::lang::Span<const char>(
+                m_data + m_position,
+                size
+            );
+            m_position = m_size;
+            ++m_record_count;
+            return true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    const std::size_t end = m_block + count_trailing_zeros(m_delimiters);
+    m_delimiters &= m_delimiters - 1;
+
+    std::size_t size = end - m_position;
+    if(size > 0 && m_data[end - 1] == '\r')
+    {
+        --size;
+    }
+    out_record = arc::lang::Span<const char>(m_data + m_position, size);
+    m_position = end + 1;
+    ++m_record_count;
+    return true;
+}
+
+std::size_t RecordReader::get_record_count() const
+{
+    return m_record_count;
+}
+
+//------------------------------------------------------------------------------
+//                            PRIVATE MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+bool RecordReader::refill()
+{
+    if(m_position > 0)
+    {
+        m_size -= m_position;
+        m_scanned -= m_position;
+        std::memmove(m_buffer.get(), m_buffer.get() + m_position, m_size);
+        m_position = 0;
+    }
+
+    // only a record longer than a window grows it
+    if(m_capacity - m_size < m_window_size)
+    {
+        std::size_t capacity = m_capacity * 2;
+        if(capacity < m_size + m_window_size)
+        {
+            capacity = m_size + m_window_size;
+        }
+        std::unique_ptr<char[]> buffer(new char[capacity]);
+        std::memcpy(buffer.get(), m_buffer.get(), m_size);
+        m_buffer.swap(buffer);
+        m_capacity = capacity;
+        m_data = m_buffer.get();
+    }
+
+    while(true)
+    {
+        const ssize_t count =
+            ::read(m_fd, m_buffer.get() + m_size, m_capacity - m_size);
+        if(count > 0)
+        {
+            m_size += static_cast<std::size_t>(count);
+            return true;
+        }
+        if(count == 0)
+        {
+            return false;
+        }
+        if(errno != EINTR)
+        {
+            throw arc::ex::RuntimeError("Failed to read records from file.");
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+//                                   CSV FIELDS
+//------------------------------------------------------------------------------
+
+CsvFields::CsvFields(arc::lang::Span<const char> record, char separator)
+    : m_data      (record.data())
+    , m_size      (record.size())
+    , m_separator (separator)
+    , m_position  (0)
+    , m_scanned   (0)
+    , m_separators(0)
+    , m_block     (0)
+    , m_quoted    (0)
+    , m_end       (false)
+{
+}
+
+std::size_t CsvFields::unescape(
+        arc::lang::Span<const char> field,
+        char* out_buffer)
+{
+    std::size_t size = 0;
+    for(std::size_t i = 0; i < field.size(); ++i)
+    {
+        out_buffer[size++] = field[i];
+        if(field[i] == '"' && i + 1 < field.size() && field[i + 1] == '"')
+        {
+            ++i;
+        }
+    }
+    return size;
+}
+
+bool CsvFields::next(arc::lang::Span<const char>& out_field)
+{
+    std::size_t end = 0;
+    while(true)
+    {
+        if(m_separators != 0)
+        {
+            end = m_block + count_trailing_zeros(m_separators);
+            m_separators &= m_separators - 1;
+            break;
+        }
+        if(m_scanned < m_size)
+        {
+            const std::size_t remaining = m_size - m_scanned;
+            const std::size_t size =
+                remaining < BLOCK_SIZE ? remaining : BLOCK_SIZE;
+            m_block = m_scanned;
+            m_separators = find_delimiters(
+                m_data + m_scanned,
+                size,
+                m_separator,
+                true,
+                m_quoted
+            );
+            m_scanned += size;
+            continue;
+        }
+        // the last field is ended by the end of the record
+        if(m_end)
+        {
+            return false;
+        }
+        m_end = true;
+        end = m_size;
+        break;
+    }
+
+    const char* field = m_data + m_position;
+    std::size_t size = end - m_position;
+    m_position = end + 1;
+    if(size >= 2 && field[0] == '"' && field[size - 1] == '"')
+    {
+        ++field;
+        size -= 2;
+    }
+    out_field = arc::lang::Span<const char>(field, size);
+    return true;
+}
+
+} // namespace io
+ARC_BASE_VERSION_NS_END
+} // namespace arc
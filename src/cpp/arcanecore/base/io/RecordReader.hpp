@@ -0,0 +1,306 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Splits newline delimited and CSV text into records, finding delimiters
+ *        a block of bytes at a time.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_IO_RECORDREADER_HPP_
+#define ARCANECORE_BASE_IO_RECORDREADER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/lang/Restrictors.hpp"
+#include "arcanecore/base/lang/Span.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace io
+{
+
+//------------------------------------------------------------------------------
+//                                  ENUMERATORS
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief How text is split into records by an arc::io::RecordReader.
+ */
+enum class RecordFormat
+{
+    /*!
+     * Each line is a record.
+     */
+    kLines,
+    /*!
+     * Each line is a record, except that newlines within double quotes are
+     * part of the record (as in RFC 4180), so a record may span lines.
+     */
+    kCsv
+};
+
+//------------------------------------------------------------------------------
+//                                 RECORD READER
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief Splits text into records without copying or allocating per record.
+ *
+ * Records are returned as views of either the memory being read (e.g. an
+ * arc::io::MappedFile) or of a window that a file is read through, so they're
+ * only valid until the next call to next().
+ *
+ * \code
+ * arc::io::MappedFile file("data.csv");
+ * file.advise(arc::io::MapAdvice::kSequential);
+ * arc::io::RecordReader reader(file.view(), arc::io::RecordFormat::kCsv);
+ * arc::lang::Span<const char> record;
+ * while(reader.next(record))
+ * {
+ *     arc::io::CsvFields fields(record);
+ *     arc::lang::Span<const char> field;
+ *     while(fields.next(field))
+ *     {
+ *         // ...
+ *     }
+ * }
+ * \endcode
+ *
+ * Delimiters are found 64 bytes at a time: a bit mask of the newlines in each
+ * block is built with SSE2, AVX2, or NEON comparisons (where available), and
+ * each record end is then found from the mask by counting trailing zeros.
+ * For CSV, a prefix XOR of the mask of quotes gives the mask of the bytes
+ * within quotes, which removes quoted newlines without branching per byte.
+ *
+ * Records don't include their terminating newline, or a carriage return
+ * before it. An empty line is an empty record, and the last record need not
+ * be terminated.
+ */
+class RecordReader
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                              PUBLIC CONSTANTS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief The number of bytes read from a file at a time, if it is not
+     *        specified.
+     */
+    static const std::size_t DEFAULT_WINDOW_SIZE = 1024 * 1024;
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Constructs a reader of the given memory, which must remain valid
+     *        while records are being read.
+     */
+    explicit RecordReader(
+            arc::lang::Span<const char> data,
+            RecordFormat format = RecordFormat::kLines);
+
+    /*!
+     * \brief Constructs a reader of the given file descriptor from its current
+     *        position.
+     *
+     * The file is read through a window which holds the record in progress
+     * followed by the next window_size bytes read. When the window is used
+     * up the partial record at its end is moved to the front and reading
+     * continues after it, so the window only grows if a single record is
+     * longer than window_size. The reader doesn't take ownership of the file
+     * descriptor.
+     */
+    explicit RecordReader(
+            int fd,
+            RecordFormat format = RecordFormat::kLines,
+            std::size_t window_size = DEFAULT_WINDOW_SIZE);
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    ~RecordReader();
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns how records are split.
+     */
+    RecordFormat get_format() const;
+
+    /*!
+     * \brief Reads the next record, returning false if there are none left.
+     *
+     * \throws arc::ex::RuntimeError If the file could not be read.
+     */
+    bool next(arc::lang::Span<const char>& out_record);
+
+    /*!
+     * \brief Returns the number of records that have been read.
+     */
+    std::size_t get_record_count() const;
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    const RecordFormat m_format;
+    const int m_fd;
+    const std::size_t m_window_size;
+
+    // the window files are read through
+    std::unique_ptr<char[]> m_buffer;
+    std::size_t m_capacity;
+
+    // the text being split, and whether there is no more to come
+    const char* m_data;
+    std::size_t m_size;
+    bool m_end;
+
+    // the start of the next record
+    std::size_t m_position;
+    // the end of the text which has been scanned for delimiters
+    std::size_t m_scanned;
+    // the delimiters not yet returned in the last block scanned, as bits
+    // relative to the start of the block
+    std::uint64_t m_delimiters;
+    std::size_t m_block;
+    // all ones if the end of the scanned text is within quotes
+    std::uint64_t m_quoted;
+
+    std::size_t m_record_count;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    // moves the record in progress to the front of the window and reads more
+    // of the file after it, returning false at the end of the file
+    bool refill();
+};
+
+//------------------------------------------------------------------------------
+//                                   CSV FIELDS
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief Splits a CSV record into its fields, using the same scanning as
+ *        arc::io::RecordReader.
+ *
+ * Fields are returned as views of the record. The quotes around a quoted
+ * field are removed, but quotes escaped within it are left doubled, since
+ * removing them requires a copy (see unescape()).
+ */
+class CsvFields
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Constructs a splitter of the given record, which must remain
+     *        valid while fields are being read.
+     */
+    explicit CsvFields(
+            arc::lang::Span<const char> record,
+            char separator = ',');
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC STATIC FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Copies the given field to out_buffer with its escaped quotes
+     *        undoubled, returning the size copied.
+     *
+     * The buffer must be at least as large as the field.
+     */
+    static std::size_t unescape(
+            arc::lang::Span<const char> field,
+            char* out_buffer);
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Reads the next field, returning false if there are none left.
+     *
+     * A record always has at least one field, which is empty if the record
+     * is.
+     */
+    bool next(arc::lang::Span<const char>& out_field);
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    const char* const m_data;
+    const std::size_t m_size;
+    const char m_separator;
+
+    // these are as in arc::io::RecordReader
+    std::size_t m_position;
+    std::size_t m_scanned;
+    std::uint64_t m_separators;
+    std::size_t m_block;
+    std::uint64_t m_quoted;
+    bool m_end;
+};
+
+} // namespace io
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
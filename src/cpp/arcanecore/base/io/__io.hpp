@@ -0,0 +1,78 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Documents the arc::io namespace.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_IO_HPP_
+#define ARCANECORE_BASE_IO_HPP_
+
+#include "arcanecore/base/BaseAPI.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+
+/*!
+ * \brief Module of input and output.
+ *
+ * Library code which produces text writes it to an arc::io::OutputSink rather
+ * than a std::ostream, so that the destination can be injected (e.g. to
+ * capture output in memory) and so that output doesn't go through the
+ * synchronisation and locale machinery of the standard streams:
+ *
+ * \code
+ * arc::io::OutputSink& out = arc::io::FileDescriptorSink::get_stdout();
+ * out.write("Hello world!\n");
+ * out.flush();
+ * \endcode
+ *
+ * Large files are read (and written) in place through an arc::io::MappedFile,
+ * rather than copied through stream buffers. Many independent reads and
+ * writes (e.g. of blocks scattered through files) are instead batched through
+ * an arc::io::IoEngine, which keeps them in flight at once using io_uring
+ * where it's available.
+ *
+ * Newline delimited and CSV text is split into records (and fields) by an
+ * arc::io::RecordReader, which returns views of a mapping or of its read
+ * window rather than a string per line as std::getline() does.
+ */
+namespace io
+{
+} // namespace io
+
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
@@ -0,0 +1,214 @@
+/*!
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "arcanecore/base/lang/Arena.hpp"
+
+#include <limits>
+
+#include "arcanecore/base/Exceptions.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace lang
+{
+
+//------------------------------------------------------------------------------
+//                                  CONSTRUCTORS
+//------------------------------------------------------------------------------
+
+Arena::Arena(std::size_t block_size)
+    : m_block_size(block_size)
+    , m_first     (nullptr)
+    , m_current   (nullptr)
+    , m_position  (nullptr)
+    , m_end       (nullptr)
+{
+    m_buffer_block.next = nullptr;
+    m_buffer_block.begin = nullptr;
+    m_buffer_block.end = nullptr;
+    m_buffer_block.owned = false;
+}
+
+Arena::Arena(
+        void* buffer,
+        std::size_t buffer_size,
+        std::size_t block_size)
+    : m_block_size(block_size)
+    , m_first     (nullptr)
+    , m_current   (nullptr)
+    , m_position  (nullptr)
+    , m_end       (nullptr)
+{
+    m_buffer_block.next = nullptr;
+    m_buffer_block.begin = static_cast<char*>(buffer);
+    m_buffer_block.end = m_buffer_block.begin + buffer_size;
+    m_buffer_block.owned = false;
+
+    if(buffer != nullptr && buffer_size > 0)
+    {
+        m_first = &m_buffer_block;
+        use_block(m_first);
+    }
+}
+
+//------------------------------------------------------------------------------
+//                                   DESTRUCTOR
+//------------------------------------------------------------------------------
+
+Arena::~Arena()
+{
+    Block* block = m_first;
+    while(block != nullptr)
+    {
+        Block* next = block->next;
+        if(block->owned)
+        {
+            ::operator delete(block);
+        }
+        block = next;
+    }
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+void Arena::rewind(const Marker& marker)
+{
+    if(marker.m_block == nullptr)
+    {
+        reset();
+        return;
+    }
+
+    m_current = marker.m_block;
+    m_position = marker.m_position;
+    m_end = m_current->end;
+}
+
+void Arena::reset()
+{
+    if(m_first != nullptr)
+    {
+        use_block(m_first);
+    }
+}
+
+std::size_t Arena::get_capacity() const
+{
+    std::size_t capacity = 0;
+    for(const Block* block = m_first; block != nullptr; block = block->next)
+    {
+        if(block->owned)
+        {
+            capacity += static_cast<std::size_t>(block->end - block->begin);
+        }
+    }
+    return capacity;
+}
+
+//------------------------------------------------------------------------------
+//                            PRIVATE MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+void* Arena::allocate_slow(std::size_t size, std::size_t alignment)
+{
+    if(alignment == 0 || (alignment & (alignment - 1)) != 0)
+    {
+        throw arc::ex::ValueError(
+            "Arena allocation alignment must be a power of two"
+        );
+    }
+    if(size == 0)
+    {
+        // zero sized allocations still return a unique pointer
+        size = 1;
+    }
+    // the size of a dedicated block, including its header, must not overflow
+    if(size > std::numeric_limits<std::size_t>::max() - alignment -
+              sizeof(Block))
+    {
+        throw std::bad_alloc();
+    }
+    // the worst case number of bytes needed to satisfy the alignment
+    const std::size_t required = size + alignment - 1;
+
+    // blocks retained after a rewind are reused before allocating new ones
+    Block* block = (m_current != nullptr) ? m_current->next : nullptr;
+    for(; block != nullptr; block = block->next)
+    {
+        if(static_cast<std::size_t>(block->end - block->begin) >= required)
+        {
+            use_block(block);
+            return allocate(size, alignment);
+        }
+    }
+
+    // allocations larger than the block size are given a dedicated block
+    const std::size_t block_size =
+        (required > m_block_size) ? required : m_block_size;
+    char* memory =
+        static_cast<char*>(::operator new(sizeof(Block) + block_size));
+    block = new(memory) Block();
+    block->begin = memory + sizeof(Block);
+    block->end = block->begin + block_size;
+    block->owned = true;
+
+    // insert the block after the current block so that the blocks remain in
+    // the order they are allocated from
+    if(m_current == nullptr)
+    {
+        block->next = m_first;
+        m_first = block;
+    }
+    else
+    {
+        block->next = m_current->next;
+        m_current->next = block;
+    }
+
+    use_block(block);
+    return allocate(size, alignment);
+}
+
+void Arena::use_block(Block* block)
+{
+    m_current = block;
+    m_position = block->begin;
+    m_end = block->end;
+}
+
+} // namespace lang
+ARC_BASE_VERSION_NS_END
+} // namespace arc
@@ -0,0 +1,415 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Monotonic (bump pointer) memory allocation.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_LANG_ARENA_HPP_
+#define ARCANECORE_BASE_LANG_ARENA_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <utility>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/lang/Restrictors.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace lang
+{
+
+/*!
+ * \brief Allocates memory by advancing a pointer through large blocks, where
+ *        the memory is released all at once rather than per allocation.
+ *
+ * Allocation is a pointer increment in the common case, and freeing is a
+ * no-op: memory is reclaimed either by rewinding the arena to a Marker taken
+ * earlier, or by resetting the arena entirely. Blocks are retained when the
+ * arena is rewound and reused by later allocations, and are only returned to
+ * the system when the arena is destroyed.
+ *
+ * The first block can optionally be provided by the user (see
+ * arc::lang::InlineArena) so that small workloads do not allocate at all.
+ *
+ * \warning Destructors are never called for objects allocated in an arena, so
+ *          it should be used for trivially destructible objects, or objects
+ *          whose destructors are called manually.
+ */
+class Arena
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
+{
+private:
+
+    //--------------------------------------------------------------------------
+    //                               PRIVATE TYPES
+    //--------------------------------------------------------------------------
+
+    struct Block;
+
+public:
+
+    //--------------------------------------------------------------------------
+    //                              PUBLIC CONSTANTS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief The default size of the blocks allocated by an arena, in bytes.
+     */
+    static const std::size_t DEFAULT_BLOCK_SIZE = 4096;
+
+    //--------------------------------------------------------------------------
+    //                                PUBLIC TYPES
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Records a position in an arena that it can later be rewound to.
+     */
+    class Marker
+    {
+    private:
+
+        friend class Arena;
+
+        Block* m_block;
+        char* m_position;
+
+        Marker(Block* block, char* position)
+            : m_block   (block)
+            , m_position(position)
+        {
+        }
+    };
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Constructs a new arena which allocates no memory until it is
+     *        first used.
+     *
+     * \param block_size The size of blocks the arena will allocate. Single
+     *                   allocations larger than this will be given their own
+     *                   block.
+     */
+    explicit Arena(std::size_t block_size = DEFAULT_BLOCK_SIZE);
+
+    /*!
+     * \brief Constructs a new arena that uses the given buffer as its first
+     *        block.
+     *
+     * \param buffer Memory the arena will allocate from before allocating
+     *               blocks of its own. This must remain valid for the lifetime
+     *               of the arena.
+     * \param buffer_size The size of the buffer in bytes.
+     * \param block_size The size of blocks the arena will allocate once the
+     *                   buffer is exhausted.
+     */
+    Arena(
+            void* buffer,
+            std::size_t buffer_size,
+            std::size_t block_size = DEFAULT_BLOCK_SIZE);
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns all blocks allocated by this arena to the system.
+     */
+    ~Arena();
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Allocates uninitialised memory from this arena.
+     *
+     * \param size The number of bytes to allocate.
+     * \param alignment The alignment of the returned memory, this must be a
+     *                  power of two.
+     *
+     * \throws arc::ex::ValueError If alignment is not a power of two.
+     * \throws std::bad_alloc If the size is too large to be allocated.
+     */
+    void* allocate(
+            std::size_t size,
+            std::size_t alignment = alignof(std::max_align_t))
+    {
+        if(alignment != 0 && (alignment & (alignment - 1)) == 0 && size != 0)
+        {
+            // the bounds are checked against the remaining space so that
+            // large sizes or alignments can't overflow past the block
+            const std::uintptr_t position =
+                reinterpret_cast<std::uintptr_t>(m_position);
+            const std::uintptr_t available =
+                reinterpret_cast<std::uintptr_t>(m_end) - position;
+            const std::uintptr_t padding =
+                (0 - position) & static_cast<std::uintptr_t>(alignment - 1);
+            if(padding <= available && size <= available - padding)
+            {
+                char* const ret = m_position + padding;
+                m_position = ret + size;
+                return ret;
+            }
+        }
+        return allocate_slow(size, alignment);
+    }
+
+    /*!
+     * \brief Allocates and constructs an object of type T in this arena.
+     *
+     * \warning The destructor of the object will not be called by the arena.
+     */
+    template<typename T, typename... Args>
+    T* create(Args&&... args)
+    {
+        return new(allocate(sizeof(T), alignof(T)))
+            T(std::forward<Args>(args)...);
+    }
+
+    /*!
+     * \brief Returns a marker of the current position of this arena.
+     */
+    Marker get_marker() const
+    {
+        return Marker(m_current, m_position);
+    }
+
+    /*!
+     * \brief Releases all memory allocated since the given marker was taken.
+     *
+     * \warning The marker must have been taken from this arena, and must not
+     *          precede a position that has already been rewound past.
+     */
+    void rewind(const Marker& marker);
+
+    /*!
+     * \brief Releases all memory allocated from this arena, the arena retains
+     *        its blocks for future allocations.
+     */
+    void reset();
+
+    /*!
+     * \brief Returns the total number of bytes of the blocks this arena has
+     *        allocated from the system.
+     */
+    std::size_t get_capacity() const;
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                               PRIVATE TYPES
+    //--------------------------------------------------------------------------
+
+    struct Block
+    {
+        // the next block in allocation order
+        Block* next;
+        // the start and end of the memory of this block
+        char* begin;
+        char* end;
+        // whether this block was allocated by the arena
+        bool owned;
+    };
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    const std::size_t m_block_size;
+
+    // describes the user provided buffer, if there is one
+    Block m_buffer_block;
+    // the first block, all blocks form a list from this block
+    Block* m_first;
+    // the block currently being allocated from
+    Block* m_current;
+    // the next free byte and the end of the current block
+    char* m_position;
+    char* m_end;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    // performs an allocation that doesn't fit in the current block
+    void* allocate_slow(std::size_t size, std::size_t alignment);
+
+    // makes the given block the block currently being allocated from
+    void use_block(Block* block);
+};
+
+/*!
+ * \brief An arc::lang::Arena whose first block is stored inline within the
+ *        object.
+ *
+ * \tparam N The size of the inline block in bytes.
+ */
+template<std::size_t N>
+class InlineArena
+    : public Arena
+{
+public:
+
+    /*!
+     * \brief Constructs a new InlineArena.
+     *
+     * \param block_size The size of blocks the arena will allocate once the
+     *                   inline block is exhausted.
+     */
+    explicit InlineArena(std::size_t block_size = DEFAULT_BLOCK_SIZE)
+        : Arena(m_storage, N, block_size)
+    {
+    }
+
+private:
+
+    alignas(std::max_align_t) char m_storage[N];
+};
+
+/*!
+ * \brief Standard library compatible allocator which allocates from an
+ *        arc::lang::Arena.
+ *
+ * This allows standard containers (e.g. ```std::vector```,
+ * ```std::basic_string```) to be stored in an arena. Deallocation is a no-op,
+ * so memory released by a container is only reclaimed when the arena is
+ * rewound or reset.
+ *
+ * \code
+ * arc::lang::InlineArena<1024> arena;
+ * std::vector<int, arc::lang::ArenaAllocator<int>> v(
+ *     arc::lang::ArenaAllocator<int>(arena)
+ * );
+ * \endcode
+ */
+template<typename T>
+class ArenaAllocator
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                                PUBLIC TYPES
+    //--------------------------------------------------------------------------
+
+    typedef T value_type;
+
+    template<typename U>
+    struct rebind
+    {
+        typedef ArenaAllocator<U> other;
+    };
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Constructs a new allocator which allocates from the given arena.
+     */
+    ArenaAllocator(Arena& arena)
+        : m_arena(&arena)
+    {
+    }
+
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other)
+        : m_arena(other.get_arena())
+    {
+    }
+
+    //--------------------------------------------------------------------------
+    //                                 OPERATORS
+    //--------------------------------------------------------------------------
+
+    template<typename U>
+    bool operator==(const ArenaAllocator<U>& other) const
+    {
+        return m_arena == other.get_arena();
+    }
+
+    template<typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const
+    {
+        return m_arena != other.get_arena();
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    T* allocate(std::size_t n)
+    {
+        if(n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+        {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(m_arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n)
+    {
+        // memory is released by the arena
+    }
+
+    /*!
+     * \brief Returns the arena this allocator allocates from.
+     */
+    Arena* get_arena() const
+    {
+        return m_arena;
+    }
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    Arena* m_arena;
+};
+
+} // namespace lang
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
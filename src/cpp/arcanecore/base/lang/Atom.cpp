@@ -0,0 +1,321 @@
+/*!
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "arcanecore/base/lang/Atom.hpp"
+
+#include <cstring>
+#include <memory>
+
+#include "arcanecore/base/Exceptions.hpp"
+#include "arcanecore/base/lang/StringBuilder.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace lang
+{
+
+namespace
+{
+
+//------------------------------------------------------------------------------
+//                                   CONSTANTS
+//------------------------------------------------------------------------------
+
+// the smallest number of slots a table has
+static const std::size_t MIN_SLOTS = 64;
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                  CONSTRUCTORS
+//------------------------------------------------------------------------------
+
+Atom::Atom(const char* s)
+    : Atom(s, std::strlen(s))
+{
+}
+
+Atom::Atom(const char* data, std::size_t size)
+    : m_entry(AtomTable::get_global().intern(data, size).m_entry)
+{
+}
+
+Atom::Atom(const std::string& s)
+    : Atom(s.data(), s.size())
+{
+}
+
+Atom::Atom(const deus::UnicodeView& s)
+    : Atom(s.c_str(), s.byte_length() - 1)
+{
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC STATIC FUNCTIONS
+//------------------------------------------------------------------------------
+
+bool Atom::find(const char* data, std::size_t size, Atom& out_atom)
+{
+    return AtomTable::get_global().find(data, size, out_atom);
+}
+
+//------------------------------------------------------------------------------
+//                                 PRIVATE TYPES
+//------------------------------------------------------------------------------
+
+struct AtomTable::Slots
+{
+    // the number of slots minus one, the number of slots is a power of two
+    const std::size_t mask;
+    std::unique_ptr<std::atomic<const Atom::Entry*>[]> entries;
+
+    explicit Slots(std::size_t count)
+        : mask   (count - 1)
+        , entries(new std::atomic<const Atom::Entry*>[count])
+    {
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            entries[i].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+};
+
+//------------------------------------------------------------------------------
+//                                  CONSTRUCTORS
+//------------------------------------------------------------------------------
+
+AtomTable::AtomTable(std::size_t capacity)
+    : m_slots (nullptr)
+    , m_size  (0)
+    , m_frozen(false)
+{
+    // the table is kept at most half full so that probes are short
+    std::size_t count = MIN_SLOTS;
+    while(count < capacity * 2)
+    {
+        count *= 2;
+    }
+    m_slots.store(new Slots(count), std::memory_order_release);
+}
+
+//------------------------------------------------------------------------------
+//                                   DESTRUCTOR
+//------------------------------------------------------------------------------
+
+AtomTable::~AtomTable()
+{
+    delete m_slots.load(std::memory_order_relaxed);
+    for(Slots* slots : m_retired)
+    {
+        delete slots;
+    }
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC STATIC FUNCTIONS
+//------------------------------------------------------------------------------
+
+AtomTable& AtomTable::get_global()
+{
+    // deliberately leaked so that atoms outlive any static objects
+    static AtomTable* table = new AtomTable(1024);
+    return *table;
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+Atom AtomTable::intern(const char* data, std::size_t size)
+{
+    if(size == 0)
+    {
+        return Atom();
+    }
+
+    // most strings have already been interned
+    const std::size_t hash = static_cast<std::size_t>(hash_bytes(data, size));
+    const Atom::Entry* entry = find_entry(
+        m_slots.load(std::memory_order_acquire),
+        data,
+        size,
+        hash
+    );
+    if(entry != nullptr)
+    {
+        return Atom(entry);
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // another thread may have interned the string since
+    Slots* slots = m_slots.load(std::memory_order_relaxed);
+    entry = find_entry(slots, data, size, hash);
+    if(entry != nullptr)
+    {
+        return Atom(entry);
+    }
+    if(m_frozen.load(std::memory_order_relaxed))
+    {
+        StringBuilder message;
+        message << "Cannot intern a new string in a frozen atom table: \"";
+        message.append(data, size).append('"');
+        throw arc::ex::StateError(message.c_str());
+    }
+
+    const std::size_t count = m_size.load(std::memory_order_relaxed) + 1;
+    if(count * 2 > slots->mask + 1)
+    {
+        grow((slots->mask + 1) * 2);
+        slots = m_slots.load(std::memory_order_relaxed);
+    }
+
+    Atom::Entry* created = static_cast<Atom::Entry*>(m_arena.allocate(
+        offsetof(Atom::Entry, data) + size + 1,
+        alignof(Atom::Entry)
+    ));
+    created->hash = hash;
+    created->size = size;
+    char* chars = created->data;
+    std::memcpy(chars, data, size);
+    chars[size] = '\0';
+
+    std::size_t index = hash & slots->mask;
+    while(slots->entries[index].load(std::memory_order_relaxed) != nullptr)
+    {
+        index = (index + 1) & slots->mask;
+    }
+    // publishes the contents of the entry to readers
+    slots->entries[index].store(created, std::memory_order_release);
+    m_size.store(count, std::memory_order_relaxed);
+    return Atom(created);
+}
+
+bool AtomTable::find(const char* data, std::size_t size, Atom& out_atom) const
+{
+    if(size == 0)
+    {
+        out_atom = Atom();
+        return true;
+    }
+
+    const Atom::Entry* entry = find_entry(
+        m_slots.load(std::memory_order_acquire),
+        data,
+        size,
+        static_cast<std::size_t>(hash_bytes(data, size))
+    );
+    if(entry == nullptr)
+    {
+        return false;
+    }
+    out_atom = Atom(entry);
+    return true;
+}
+
+void AtomTable::freeze()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_frozen.store(true, std::memory_order_relaxed);
+}
+
+bool AtomTable::is_frozen() const
+{
+    return m_frozen.load(std::memory_order_relaxed);
+}
+
+std::size_t AtomTable::size() const
+{
+    return m_size.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+//                            PRIVATE MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+const Atom::Entry* AtomTable::find_entry(
+        const Slots* slots,
+        const char* data,
+        std::size_t size,
+        std::size_t hash)
+{
+    // the table is never full, so this always reaches an empty slot
+    std::size_t index = hash & slots->mask;
+    while(true)
+    {
+        const Atom::Entry* entry =
+            slots->entries[index].load(std::memory_order_acquire);
+        if(entry == nullptr)
+        {
+            return nullptr;
+        }
+        if(entry->hash == hash &&
+           entry->size == size &&
+           std::memcmp(entry->data, data, size) == 0)
+        {
+            return entry;
+        }
+        index = (index + 1) & slots->mask;
+    }
+}
+
+void AtomTable::grow(std::size_t count)
+{
+    Slots* old_slots = m_slots.load(std::memory_order_relaxed);
+    m_retired.reserve(m_retired.size() + 1);
+    Slots* slots = new Slots(count);
+    for(std::size_t i = 0; i <= old_slots->mask; ++i)
+    {
+        const Atom::Entry* entry =
+            old_slots->entries[i].load(std::memory_order_relaxed);
+        if(entry == nullptr)
+        {
+            continue;
+        }
+        std::size_t index = entry->hash & slots->mask;
+        while(slots->entries[index].load(std::memory_order_relaxed) != nullptr)
+        {
+            index = (index + 1) & slots->mask;
+        }
+        slots->entries[index].store(entry, std::memory_order_relaxed);
+    }
+
+    // readers may still be probing the old slots, so they are kept until the
+    // table is destroyed (which only costs half the size of the new slots)
+    m_retired.push_back(old_slots);
+    m_slots.store(slots, std::memory_order_release);
+}
+
+} // namespace lang
+ARC_BASE_VERSION_NS_END
+} // namespace arc
@@ -0,0 +1,412 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Interned strings which are compared by pointer.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_LANG_ATOM_HPP_
+#define ARCANECORE_BASE_LANG_ATOM_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <deus/UnicodeView.hpp>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/lang/Arena.hpp"
+#include "arcanecore/base/lang/Hash.hpp"
+#include "arcanecore/base/lang/Restrictors.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace lang
+{
+
+//------------------------------------------------------------------------------
+//                              FORWARD DECLARATIONS
+//------------------------------------------------------------------------------
+
+class AtomTable;
+
+//------------------------------------------------------------------------------
+//                                      ATOM
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief A handle to a string which has been interned in an
+ *        arc::lang::AtomTable.
+ *
+ * Every atom of the same string from the same table refers to the same
+ * storage, so atoms are compared by pointer and their hash is computed once
+ * when the string is first interned. An atom is the size of a pointer and is
+ * trivially copyable, and the string it refers to lives as long as its table
+ * (the global table is never destroyed).
+ *
+ * Atoms are intended for keys which are repeated often and compared more
+ * often, such as flag keys and field names, rather than arbitrary strings:
+ * interned strings are never freed.
+ *
+ * \code
+ * const arc::lang::Atom verbose("--verbose");
+ * if(arc::lang::Atom("--verbose") == verbose)
+ * {
+ *     // ...
+ * }
+ * \endcode
+ *
+ * The bytes of the string are interned as is, so strings should be interned in
+ * a consistent encoding (i.e. UTF-8).
+ */
+class Atom
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Constructs the atom of the empty string, which doesn't use any
+     *        table.
+     */
+    Atom()
+        : m_entry(nullptr)
+    {
+    }
+
+    /*!
+     * \brief Constructs the atom of the given null terminated string in the
+     *        global table.
+     *
+     * \throws arc::ex::StateError If the string is not in the global table and
+     *                             the table has been frozen.
+     */
+    explicit Atom(const char* s);
+
+    /*!
+     * \brief Constructs the atom of the given bytes in the global table.
+     *
+     * \throws arc::ex::StateError If the string is not in the global table and
+     *                             the table has been frozen.
+     */
+    Atom(const char* data, std::size_t size);
+
+    /*!
+     * \brief Constructs the atom of the given string in the global table.
+     *
+     * \throws arc::ex::StateError If the string is not in the global table and
+     *                             the table has been frozen.
+     */
+    explicit Atom(const std::string& s);
+
+    /*!
+     * \brief Constructs the atom of the bytes of the given string in the
+     *        global table.
+     *
+     * \throws arc::ex::StateError If the string is not in the global table and
+     *                             the table has been frozen.
+     */
+    explicit Atom(const deus::UnicodeView& s);
+
+    //--------------------------------------------------------------------------
+    //                                 OPERATORS
+    //--------------------------------------------------------------------------
+
+    bool operator==(const Atom& other) const
+    {
+        return m_entry == other.m_entry;
+    }
+
+    bool operator!=(const Atom& other) const
+    {
+        return m_entry != other.m_entry;
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC STATIC FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Finds the atom of the given bytes in the global table without
+     *        interning them.
+     *
+     * This never blocks, and is useful for looking up untrusted input (such
+     * as command line arguments) which shouldn't grow the table.
+     *
+     * \return Whether the string has been interned, in which case its atom is
+     *         written to out_atom.
+     */
+    static bool find(const char* data, std::size_t size, Atom& out_atom);
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns whether this is the atom of the empty string.
+     */
+    bool empty() const
+    {
+        return m_entry == nullptr;
+    }
+
+    /*!
+     * \brief Returns the length of the string in bytes.
+     */
+    std::size_t size() const
+    {
+        return m_entry != nullptr ? m_entry->size : 0;
+    }
+
+    /*!
+     * \brief Returns the null terminated string.
+     */
+    const char* c_str() const
+    {
+        return m_entry != nullptr ? m_entry->data : "";
+    }
+
+    /*!
+     * \brief Returns a UTF-8 view of the string.
+     */
+    deus::UnicodeView get_view() const
+    {
+        return deus::UnicodeView(c_str(), size(), deus::Encoding::kUTF8);
+    }
+
+    /*!
+     * \brief Returns the hash of the string, which is the same as the
+     *        arc::lang::StringHash of the string.
+     */
+    std::size_t get_hash() const
+    {
+        return m_entry != nullptr
+            ? m_entry->hash
+            : static_cast<std::size_t>(hash_bytes("", 0));
+    }
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                                  FRIENDS
+    //--------------------------------------------------------------------------
+
+    friend class AtomTable;
+
+    //--------------------------------------------------------------------------
+    //                               PRIVATE TYPES
+    //--------------------------------------------------------------------------
+
+    // an interned string, allocated with enough space for the string
+    struct Entry
+    {
+        std::size_t hash;
+        std::size_t size;
+        // null terminated
+        char data[1];
+    };
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    // null for the empty string
+    const Entry* m_entry;
+
+    //--------------------------------------------------------------------------
+    //                           PRIVATE CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    explicit Atom(const Entry* entry)
+        : m_entry(entry)
+    {
+    }
+};
+
+/*!
+ * \brief Hash functor for arc::lang::Atom which returns the precomputed hash.
+ */
+struct AtomHash
+{
+    std::size_t operator()(const Atom& atom) const
+    {
+        return atom.get_hash();
+    }
+};
+
+//------------------------------------------------------------------------------
+//                                   ATOM TABLE
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief Concurrent table of interned strings.
+ *
+ * Lookups never lock or retry, so are wait-free: the table is an open
+ * addressing array of atomic pointers which only ever has entries added, and
+ * when it grows the old array is kept alive so that concurrent readers can
+ * finish with it. Interning a string which is not in the table takes a lock,
+ * and the string is copied into an arc::lang::Arena owned by the table.
+ *
+ * Once every string that will be needed has been interned (e.g. after
+ * startup) the table can be frozen, after which interning an existing string
+ * never locks and interning a new string is an error.
+ *
+ * Atoms of different tables are never equal, even for the same string (except
+ * for the empty string).
+ */
+class AtomTable
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Constructs a new empty table.
+     *
+     * \param capacity The number of strings the table can hold before it has
+     *                 to grow.
+     */
+    explicit AtomTable(std::size_t capacity = 0);
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Frees the strings of the table, after which any atoms from the
+     *        table are invalid.
+     */
+    ~AtomTable();
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC STATIC FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns the table used by the constructors of arc::lang::Atom.
+     *
+     * The global table is never destroyed, so its atoms may be used during
+     * static destruction.
+     */
+    static AtomTable& get_global();
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns the atom of the given bytes, interning them if they are
+     *        not already in this table.
+     *
+     * \throws arc::ex::StateError If the string is not in this table and the
+     *                             table has been frozen.
+     */
+    Atom intern(const char* data, std::size_t size);
+
+    /*!
+     * \brief Finds the atom of the given bytes without interning them.
+     *
+     * \return Whether the string is in this table, in which case its atom is
+     *         written to out_atom.
+     */
+    bool find(const char* data, std::size_t size, Atom& out_atom) const;
+
+    /*!
+     * \brief Prevents any new strings being interned in this table.
+     */
+    void freeze();
+
+    /*!
+     * \brief Returns whether this table has been frozen.
+     */
+    bool is_frozen() const;
+
+    /*!
+     * \brief Returns the number of strings in this table.
+     */
+    std::size_t size() const;
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                               PRIVATE TYPES
+    //--------------------------------------------------------------------------
+
+    struct Slots;
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    // the current array of entries
+    std::atomic<Slots*> m_slots;
+    std::atomic<std::size_t> m_size;
+    std::atomic<bool> m_frozen;
+
+    // guards the following and insertions into the slots
+    std::mutex m_mutex;
+    // the storage of the entries
+    arc::lang::Arena m_arena;
+    // arrays the table has outgrown, which readers may still be using
+    std::vector<Slots*> m_retired;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    // finds the entry of the given string in the given slots
+    static const Atom::Entry* find_entry(
+            const Slots* slots,
+            const char* data,
+            std::size_t size,
+            std::size_t hash);
+
+    // replaces the slots with an array of the given capacity
+    void grow(std::size_t capacity);
+};
+
+} // namespace lang
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
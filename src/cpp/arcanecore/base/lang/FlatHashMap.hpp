@@ -0,0 +1,366 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Open addressing hash map.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_LANG_FLATHASHMAP_HPP_
+#define ARCANECORE_BASE_LANG_FLATHASHMAP_HPP_
+
+#include <functional>
+#include <initializer_list>
+#include <new>
+#include <tuple>
+#include <utility>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/lang/FlatHashTable.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace lang
+{
+
+/*!
+ * \brief Hash map which stores its values inline in a single open addressing
+ *        table.
+ *
+ * This is a replacement for ```std::unordered_map``` which does not allocate
+ * per value, and typically finds a key with a single probe of 16 control
+ * bytes. See arc::lang::FlatHashTable for details.
+ *
+ * Unlike ```std::unordered_map```, inserting into the map may invalidate
+ * references to the existing values.
+ *
+ * Transparent functors such as arc::lang::StringHash and
+ * arc::lang::StringEqual allow lookups by other types without constructing a
+ * key:
+ *
+ * \code
+ * arc::lang::FlatHashMap<
+ *     std::string,
+ *     int,
+ *     arc::lang::StringHash,
+ *     arc::lang::StringEqual
+ * > map;
+ * map["hello"] = 1;
+ * auto it = map.find(deus::UnicodeView("hello"));
+ * \endcode
+ */
+template<
+    typename K,
+    typename V,
+    typename Hash = std::hash<K>,
+    typename Equal = std::equal_to<K>
+>
+class FlatHashMap
+{
+private:
+
+    //--------------------------------------------------------------------------
+    //                               PRIVATE TYPES
+    //--------------------------------------------------------------------------
+
+    struct KeyOf
+    {
+        const K& operator()(const std::pair<const K, V>& value) const
+        {
+            return value.first;
+        }
+
+        // moves a value to uninitialised memory and destroys the original
+        static void transfer(
+                std::pair<const K, V>* destination,
+                std::pair<const K, V>* source)
+        {
+            // the source is destroyed immediately, so its key may be moved
+            new(destination) std::pair<const K, V>(
+                std::move(const_cast<K&>(source->first)),
+                std::move(source->second)
+            );
+            source->~pair();
+        }
+    };
+
+    typedef FlatHashTable<std::pair<const K, V>, K, KeyOf, Hash, Equal>
+        Table;
+
+public:
+
+    //--------------------------------------------------------------------------
+    //                                PUBLIC TYPES
+    //--------------------------------------------------------------------------
+
+    typedef K key_type;
+    typedef V mapped_type;
+    typedef std::pair<const K, V> value_type;
+    typedef std::size_t size_type;
+    typedef Hash hasher;
+    typedef Equal key_equal;
+    typedef typename Table::iterator iterator;
+    typedef typename Table::const_iterator const_iterator;
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Constructs a new empty map.
+     *
+     * \param capacity The number of values to reserve space for.
+     */
+    explicit FlatHashMap(
+            size_type capacity = 0,
+            const Hash& hash = Hash(),
+            const Equal& equal = Equal())
+        : m_table(capacity, hash, equal)
+    {
+    }
+
+    /*!
+     * \brief Constructs a new map from the given values.
+     */
+    FlatHashMap(std::initializer_list<value_type> values)
+        : m_table(values.size())
+    {
+        for(const value_type& value : values)
+        {
+            insert(value);
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    //                                 OPERATORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns the value mapped to the given key, inserting a value
+     *        initialised value if there is not one.
+     */
+    template<typename Key>
+    V& operator[](const Key& key)
+    {
+        return try_emplace(key).first->second;
+    }
+
+    bool operator==(const FlatHashMap& other) const
+    {
+        if(size() != other.size())
+        {
+            return false;
+        }
+        for(const value_type& value : *this)
+        {
+            const_iterator it = other.find(value.first);
+            if(it == other.end() || !(it->second == value.second))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool operator!=(const FlatHashMap& other) const
+    {
+        return !((*this) == other);
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    iterator begin()
+    {
+        return m_table.begin();
+    }
+
+    const_iterator begin() const
+    {
+        return m_table.begin();
+    }
+
+    iterator end()
+    {
+        return m_table.end();
+    }
+
+    const_iterator end() const
+    {
+        return m_table.end();
+    }
+
+    size_type size() const
+    {
+        return m_table.size();
+    }
+
+    bool empty() const
+    {
+        return m_table.empty();
+    }
+
+    size_type capacity() const
+    {
+        return m_table.capacity();
+    }
+
+    void reserve(size_type count)
+    {
+        m_table.reserve(count);
+    }
+
+    void clear()
+    {
+        m_table.clear();
+    }
+
+    template<typename Key>
+    iterator find(const Key& key)
+    {
+        return m_table.find(key);
+    }
+
+    template<typename Key>
+    const_iterator find(const Key& key) const
+    {
+        return m_table.find(key);
+    }
+
+    template<typename Key>
+    bool contains(const Key& key) const
+    {
+        return m_table.contains(key);
+    }
+
+    template<typename Key>
+    size_type count(const Key& key) const
+    {
+        return m_table.count(key);
+    }
+
+    /*!
+     * \brief Inserts a copy of the given value if its key is not already in
+     *        the map.
+     *
+     * \return An iterator to the value with the key, and whether it was
+     *         inserted.
+     */
+    std::pair<iterator, bool> insert(const value_type& value)
+    {
+        return m_table.emplace_key(value.first, value);
+    }
+
+    /*!
+     * \brief Moves the given value into the map if its key is not already in
+     *        the map.
+     */
+    std::pair<iterator, bool> insert(value_type&& value)
+    {
+        return m_table.emplace_key(value.first, std::move(value));
+    }
+
+    /*!
+     * \brief Inserts a value constructed from the given arguments if the key
+     *        is not already in the map, otherwise the arguments are unused.
+     *
+     * \return An iterator to the value with the key, and whether it was
+     *         inserted.
+     */
+    template<typename Key, typename... Args>
+    std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args)
+    {
+        return m_table.emplace_key(
+            key,
+            std::piecewise_construct,
+            std::forward_as_tuple(key),
+            std::forward_as_tuple(std::forward<Args>(args)...)
+        );
+    }
+
+    /*!
+     * \brief Maps the given key to the given value, replacing any existing
+     *        value.
+     */
+    template<typename Key, typename Value>
+    std::pair<iterator, bool> insert_or_assign(const Key& key, Value&& value)
+    {
+        std::pair<iterator, bool> ret = try_emplace(key);
+        ret.first->second = std::forward<Value>(value);
+        return ret;
+    }
+
+    /*!
+     * \brief Removes the value at the given position.
+     */
+    void erase(const_iterator position)
+    {
+        m_table.erase(position);
+    }
+
+    void erase(iterator position)
+    {
+        m_table.erase(position);
+    }
+
+    /*!
+     * \brief Removes the value with the given key, if there is one.
+     *
+     * \return The number of values removed (0 or 1).
+     */
+    template<typename Key>
+    size_type erase(const Key& key)
+    {
+        return m_table.erase_key(key);
+    }
+
+    void swap(FlatHashMap& other)
+    {
+        m_table.swap(other.m_table);
+    }
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    Table m_table;
+};
+
+} // namespace lang
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
@@ -0,0 +1,275 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Open addressing hash set.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_LANG_FLATHASHSET_HPP_
+#define ARCANECORE_BASE_LANG_FLATHASHSET_HPP_
+
+#include <functional>
+#include <initializer_list>
+#include <new>
+#include <utility>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/lang/FlatHashTable.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace lang
+{
+
+/*!
+ * \brief Hash set which stores its values inline in a single open addressing
+ *        table.
+ *
+ * This is a replacement for ```std::unordered_set```, see
+ * arc::lang::FlatHashMap and arc::lang::FlatHashTable for details.
+ */
+template<
+    typename K,
+    typename Hash = std::hash<K>,
+    typename Equal = std::equal_to<K>
+>
+class FlatHashSet
+{
+private:
+
+    //--------------------------------------------------------------------------
+    //                               PRIVATE TYPES
+    //--------------------------------------------------------------------------
+
+    struct KeyOf
+    {
+        const K& operator()(const K& value) const
+        {
+            return value;
+        }
+
+        // moves a value to uninitialised memory and destroys the original
+        static void transfer(K* destination, K* source)
+        {
+            new(destination) K(std::move(*source));
+            source->~K();
+        }
+    };
+
+    typedef FlatHashTable<K, K, KeyOf, Hash, Equal> Table;
+
+public:
+
+    //--------------------------------------------------------------------------
+    //                                PUBLIC TYPES
+    //--------------------------------------------------------------------------
+
+    typedef K key_type;
+    typedef K value_type;
+    typedef std::size_t size_type;
+    typedef Hash hasher;
+    typedef Equal key_equal;
+    // values may not be modified in place since that would change their hash
+    typedef typename Table::const_iterator iterator;
+    typedef typename Table::const_iterator const_iterator;
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Constructs a new empty set.
+     *
+     * \param capacity The number of values to reserve space for.
+     */
+    explicit FlatHashSet(
+            size_type capacity = 0,
+            const Hash& hash = Hash(),
+            const Equal& equal = Equal())
+        : m_table(capacity, hash, equal)
+    {
+    }
+
+    /*!
+     * \brief Constructs a new set from the given values.
+     */
+    FlatHashSet(std::initializer_list<K> values)
+        : m_table(values.size())
+    {
+        for(const K& value : values)
+        {
+            insert(value);
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    //                                 OPERATORS
+    //--------------------------------------------------------------------------
+
+    bool operator==(const FlatHashSet& other) const
+    {
+        if(size() != other.size())
+        {
+            return false;
+        }
+        for(const K& value : *this)
+        {
+            if(!other.contains(value))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool operator!=(const FlatHashSet& other) const
+    {
+        return !((*this) == other);
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    const_iterator begin() const
+    {
+        return m_table.begin();
+    }
+
+    const_iterator end() const
+    {
+        return m_table.end();
+    }
+
+    size_type size() const
+    {
+        return m_table.size();
+    }
+
+    bool empty() const
+    {
+        return m_table.empty();
+    }
+
+    size_type capacity() const
+    {
+        return m_table.capacity();
+    }
+
+    void reserve(size_type count)
+    {
+        m_table.reserve(count);
+    }
+
+    void clear()
+    {
+        m_table.clear();
+    }
+
+    template<typename Key>
+    const_iterator find(const Key& key) const
+    {
+        return m_table.find(key);
+    }
+
+    template<typename Key>
+    bool contains(const Key& key) const
+    {
+        return m_table.contains(key);
+    }
+
+    template<typename Key>
+    size_type count(const Key& key) const
+    {
+        return m_table.count(key);
+    }
+
+    /*!
+     * \brief Inserts the given value if it is not already in the set.
+     *
+     * \return An iterator to the value in the set, and whether it was
+     *         inserted.
+     */
+    std::pair<const_iterator, bool> insert(const K& value)
+    {
+        return m_table.emplace_key(value, value);
+    }
+
+    /*!
+     * \brief Moves the given value into the set if it is not already in the
+     *        set.
+     */
+    std::pair<const_iterator, bool> insert(K&& value)
+    {
+        return m_table.emplace_key(value, std::move(value));
+    }
+
+    /*!
+     * \brief Removes the value at the given position.
+     */
+    void erase(const_iterator position)
+    {
+        m_table.erase(position);
+    }
+
+    /*!
+     * \brief Removes the given value, if it is in the set.
+     *
+     * \return The number of values removed (0 or 1).
+     */
+    template<typename Key>
+    size_type erase(const Key& key)
+    {
+        return m_table.erase_key(key);
+    }
+
+    void swap(FlatHashSet& other)
+    {
+        m_table.swap(other.m_table);
+    }
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    Table m_table;
+};
+
+} // namespace lang
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
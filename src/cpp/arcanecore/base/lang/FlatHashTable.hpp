@@ -0,0 +1,973 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Open addressing hash table which is the implementation of
+ *        arc::lang::FlatHashMap and arc::lang::FlatHashSet.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_LANG_FLATHASHTABLE_HPP_
+#define ARCANECORE_BASE_LANG_FLATHASHTABLE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/Preproc.hpp"
+#include "arcanecore/base/lang/Hash.hpp"
+
+#ifdef ARC_SIMD_SSE2
+    #include <emmintrin.h>
+#endif
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace lang
+{
+
+//------------------------------------------------------------------------------
+//                                 CONTROL BYTES
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief The metadata byte stored for each slot of an
+ *        arc::lang::FlatHashTable.
+ *
+ * Full slots store the low 7 bits of their hash (a non-negative value), while
+ * the other states are negative.
+ */
+typedef std::int8_t FlatHashCtrl;
+
+/*!
+ * \brief Control byte values of slots which do not contain a value.
+ */
+enum : FlatHashCtrl
+{
+    kFlatHashEmpty = -128,
+    kFlatHashDeleted = -2,
+    kFlatHashSentinel = -1
+};
+
+/*!
+ * \brief Returns the control bytes used by tables that have not allocated.
+ */
+inline const FlatHashCtrl* get_flat_hash_empty_group()
+{
+    alignas(16) static const FlatHashCtrl group[16] = {
+        kFlatHashSentinel, kFlatHashEmpty, kFlatHashEmpty, kFlatHashEmpty,
+        kFlatHashEmpty,    kFlatHashEmpty, kFlatHashEmpty, kFlatHashEmpty,
+        kFlatHashEmpty,    kFlatHashEmpty, kFlatHashEmpty, kFlatHashEmpty,
+        kFlatHashEmpty,    kFlatHashEmpty, kFlatHashEmpty, kFlatHashEmpty
+    };
+    return group;
+}
+
+//------------------------------------------------------------------------------
+//                                     GROUP
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief A group of 16 consecutive control bytes which are matched at once.
+ *
+ * This uses SSE2 when it is available, and otherwise falls back to scalar
+ * comparisons.
+ */
+class FlatHashGroup
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                              PUBLIC CONSTANTS
+    //--------------------------------------------------------------------------
+
+    static const std::size_t WIDTH = 16;
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    explicit FlatHashGroup(const FlatHashCtrl* ctrl)
+    {
+        #ifdef ARC_SIMD_SSE2
+            m_ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+        #else
+            std::memcpy(m_ctrl, ctrl, WIDTH);
+        #endif
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns a bit mask of the positions in the group that have the
+     *        given control byte.
+     */
+    std::uint32_t match(FlatHashCtrl value) const
+    {
+        #ifdef ARC_SIMD_SSE2
+            return static_cast<std::uint32_t>(_mm_movemask_epi8(
+                _mm_cmpeq_epi8(_mm_set1_epi8(value), m_ctrl)
+            ));
+        #else
+            std::uint32_t mask = 0;
+            for(std::size_t i = 0; i < WIDTH; ++i)
+            {
+                mask |= static_cast<std::uint32_t>(m_ctrl[i] == value) << i;
+            }
+            return mask;
+        #endif
+    }
+
+    /*!
+     * \brief Returns a bit mask of the positions in the group that are empty.
+     */
+    std::uint32_t match_empty() const
+    {
+        return match(kFlatHashEmpty);
+    }
+
+    /*!
+     * \brief Returns a bit mask of the positions in the group that are empty
+     *        or deleted.
+     */
+    std::uint32_t match_empty_or_deleted() const
+    {
+        #ifdef ARC_SIMD_SSE2
+            // empty and deleted are the only values less than the sentinel
+            return static_cast<std::uint32_t>(_mm_movemask_epi8(
+                _mm_cmpgt_epi8(_mm_set1_epi8(kFlatHashSentinel), m_ctrl)
+            ));
+        #else
+            std::uint32_t mask = 0;
+            for(std::size_t i = 0; i < WIDTH; ++i)
+            {
+                mask |= static_cast<std::uint32_t>(
+                    m_ctrl[i] < kFlatHashSentinel) << i;
+            }
+            return mask;
+        #endif
+    }
+
+    /*!
+     * \brief Returns the number of leading positions in the group which are
+     *        empty or deleted.
+     */
+    std::size_t count_leading_empty_or_deleted() const
+    {
+        // the extra bit gives a result of WIDTH when the whole group is empty
+        const std::uint32_t mask = match_empty_or_deleted();
+        return count_trailing_zeros((~mask & 0xFFFFU) | (1U << WIDTH));
+    }
+
+    /*!
+     * \brief Returns the index of the lowest set bit of a non-zero mask.
+     */
+    static std::size_t count_trailing_zeros(std::uint32_t mask)
+    {
+        #if defined(__GNUC__) || defined(__clang__)
+            return static_cast<std::size_t>(__builtin_ctz(mask));
+        #else
+            std::size_t result = 0;
+            while((mask & 1U) == 0)
+            {
+                mask >>= 1;
+                ++result;
+            }
+            return result;
+        #endif
+    }
+
+    /*!
+     * \brief Returns the number of leading zero bits of a non-zero 16-bit
+     *        mask.
+     */
+    static std::size_t count_leading_zeros(std::uint32_t mask)
+    {
+        #if defined(__GNUC__) || defined(__clang__)
+            return static_cast<std::size_t>(__builtin_clz(mask)) - 16;
+        #else
+            std::size_t result = 0;
+            while((mask & 0x8000U) == 0)
+            {
+                mask <<= 1;
+                ++result;
+            }
+            return result;
+        #endif
+    }
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    #ifdef ARC_SIMD_SSE2
+        __m128i m_ctrl;
+    #else
+        FlatHashCtrl m_ctrl[WIDTH];
+    #endif
+};
+
+//------------------------------------------------------------------------------
+//                                     TABLE
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief Open addressing hash table in the style of Swiss tables, this is the
+ *        implementation of arc::lang::FlatHashMap and arc::lang::FlatHashSet.
+ *
+ * Values are stored inline in a single array of slots alongside an array of
+ * one control byte per slot. The control byte of a full slot holds 7 bits of
+ * the value's hash, so a lookup compares 16 control bytes at once and only
+ * compares keys for slots whose hash bits match. Deleted slots leave a
+ * tombstone which is reclaimed when the table is rehashed.
+ *
+ * Inserting or erasing values invalidates iterators and references to values
+ * if the table rehashes.
+ *
+ * \tparam Value The type stored in the table.
+ * \tparam Key The type values are looked up by.
+ * \tparam KeyOf Functor which returns the key of a value.
+ * \tparam Hash Functor which hashes keys. If Hash and Equal define
+ *              ```is_transparent``` lookups can use any type they accept,
+ *              otherwise lookups are converted to Key.
+ * \tparam Equal Functor which compares keys.
+ */
+template<
+    typename Value,
+    typename Key,
+    typename KeyOf,
+    typename Hash,
+    typename Equal
+>
+class FlatHashTable
+    : private Hash
+    , private Equal
+{
+private:
+
+    //--------------------------------------------------------------------------
+    //                               PRIVATE TYPES
+    //--------------------------------------------------------------------------
+
+    template<typename T, typename = void>
+    struct IsTransparent
+        : public std::false_type
+    {
+    };
+
+    template<typename T>
+    struct IsTransparent<T, typename T::is_transparent>
+        : public std::true_type
+    {
+    };
+
+    static const bool TRANSPARENT =
+        IsTransparent<Hash>::value && IsTransparent<Equal>::value;
+
+    template<typename K>
+    struct LookupKey
+    {
+        typedef typename std::conditional<
+            TRANSPARENT,
+            K,
+            Key
+        >::type type;
+    };
+
+public:
+
+    //--------------------------------------------------------------------------
+    //                                PUBLIC TYPES
+    //--------------------------------------------------------------------------
+
+    typedef Key key_type;
+    typedef Value value_type;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Hash hasher;
+    typedef Equal key_equal;
+    typedef Value& reference;
+    typedef const Value& const_reference;
+
+    /*!
+     * \brief Forward iterator over the values in the table.
+     */
+    template<bool IS_CONST>
+    class Iterator
+    {
+    public:
+
+        typedef std::forward_iterator_tag iterator_category;
+        typedef Value value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef typename std::conditional<IS_CONST, const Value*, Value*>::type
+            pointer;
+        typedef typename std::conditional<IS_CONST, const Value&, Value&>::type
+            reference;
+
+        Iterator()
+            : m_ctrl(nullptr)
+            , m_slot(nullptr)
+        {
+        }
+
+        // allow conversion from a mutable to a const iterator
+        Iterator(const Iterator<false>& other)
+            : m_ctrl(other.m_ctrl)
+            , m_slot(other.m_slot)
+        {
+        }
+
+        reference operator*() const
+        {
+            return *m_slot;
+        }
+
+        pointer operator->() const
+        {
+            return m_slot;
+        }
+
+        Iterator& operator++()
+        {
+            ++m_ctrl;
+            ++m_slot;
+            skip_empty();
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator ret(*this);
+            ++(*this);
+            return ret;
+        }
+
+        bool operator==(const Iterator& other) const
+        {
+            return m_ctrl == other.m_ctrl;
+        }
+
+        bool operator!=(const Iterator& other) const
+        {
+            return m_ctrl != other.m_ctrl;
+        }
+
+    private:
+
+        friend class FlatHashTable;
+        friend class Iterator<!IS_CONST>;
+
+        const FlatHashCtrl* m_ctrl;
+        Value* m_slot;
+
+        Iterator(const FlatHashCtrl* ctrl, Value* slot)
+            : m_ctrl(ctrl)
+            , m_slot(slot)
+        {
+        }
+
+        // advances to the next full slot, or the end sentinel
+        void skip_empty()
+        {
+            while(*m_ctrl < kFlatHashSentinel)
+            {
+                const std::size_t shift =
+                    FlatHashGroup(m_ctrl).count_leading_empty_or_deleted();
+                m_ctrl += shift;
+                m_slot += shift;
+            }
+            // the end of the table is represented by the sentinel
+            if(*m_ctrl == kFlatHashSentinel)
+            {
+                m_slot = nullptr;
+            }
+        }
+    };
+
+    typedef Iterator<false> iterator;
+    typedef Iterator<true> const_iterator;
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Constructs a new empty table, which does not allocate until a
+     *        value is inserted.
+     */
+    explicit FlatHashTable(
+            size_type capacity = 0,
+            const Hash& hash = Hash(),
+            const Equal& equal = Equal())
+        : Hash         (hash)
+        , Equal        (equal)
+        , m_ctrl       (const_cast<FlatHashCtrl*>(get_flat_hash_empty_group()))
+        , m_slots      (nullptr)
+        , m_size       (0)
+        , m_capacity   (0)
+        , m_growth_left(0)
+    {
+        if(capacity > 0)
+        {
+            reserve(capacity);
+        }
+    }
+
+    /*!
+     * \brief Copy constructor.
+     */
+    FlatHashTable(const FlatHashTable& other)
+        : FlatHashTable(0, other.get_hash(), other.get_equal())
+    {
+        reserve(other.m_size);
+        for(const Value& value : other)
+        {
+            insert_unique(value);
+        }
+    }
+
+    /*!
+     * \brief Move constructor.
+     */
+    FlatHashTable(FlatHashTable&& other)
+        : Hash         (other.get_hash())
+        , Equal        (other.get_equal())
+        , m_ctrl       (other.m_ctrl)
+        , m_slots      (other.m_slots)
+        , m_size       (other.m_size)
+        , m_capacity   (other.m_capacity)
+        , m_growth_left(other.m_growth_left)
+    {
+        other.reset_empty();
+    }
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    ~FlatHashTable()
+    {
+        destroy();
+    }
+
+    //--------------------------------------------------------------------------
+    //                                 OPERATORS
+    //--------------------------------------------------------------------------
+
+    FlatHashTable& operator=(const FlatHashTable& other)
+    {
+        if(this != &other)
+        {
+            FlatHashTable copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    FlatHashTable& operator=(FlatHashTable&& other)
+    {
+        if(this != &other)
+        {
+            destroy();
+            reset_empty();
+            swap(other);
+        }
+        return *this;
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    iterator begin()
+    {
+        iterator it(m_ctrl, m_slots);
+        it.skip_empty();
+        return it;
+    }
+
+    const_iterator begin() const
+    {
+        return const_cast<FlatHashTable*>(this)->begin();
+    }
+
+    iterator end()
+    {
+        return iterator(m_ctrl + m_capacity, nullptr);
+    }
+
+    const_iterator end() const
+    {
+        return const_cast<FlatHashTable*>(this)->end();
+    }
+
+    /*!
+     * \brief Returns the number of values in the table.
+     */
+    size_type size() const
+    {
+        return m_size;
+    }
+
+    /*!
+     * \brief Returns whether the table contains no values.
+     */
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    /*!
+     * \brief Returns the number of slots in the table.
+     */
+    size_type capacity() const
+    {
+        return m_capacity;
+    }
+
+    /*!
+     * \brief Returns the hash functor of this table.
+     */
+    const Hash& get_hash() const
+    {
+        return *this;
+    }
+
+    /*!
+     * \brief Returns the key equality functor of this table.
+     */
+    const Equal& get_equal() const
+    {
+        return *this;
+    }
+
+    /*!
+     * \brief Removes all values from this table, the capacity is retained.
+     */
+    void clear()
+    {
+        if(m_capacity == 0)
+        {
+            return;
+        }
+        for(size_type i = 0; i < m_capacity; ++i)
+        {
+            if(m_ctrl[i] >= 0)
+            {
+                m_slots[i].~Value();
+            }
+        }
+        reset_ctrl();
+        m_size = 0;
+        m_growth_left = get_max_load(m_capacity);
+    }
+
+    /*!
+     * \brief Ensures the table can hold the given number of values without
+     *        rehashing.
+     */
+    void reserve(size_type count)
+    {
+        if(count > m_size + m_growth_left)
+        {
+            rehash(get_capacity_for(count));
+        }
+    }
+
+    /*!
+     * \brief Returns an iterator to the value with the given key, or end() if
+     *        there is no such value.
+     */
+    template<typename K>
+    iterator find(const K& key)
+    {
+        const typename LookupKey<K>::type& lookup = key;
+        return find_hashed(lookup, hash_key(lookup));
+    }
+
+    template<typename K>
+    const_iterator find(const K& key) const
+    {
+        return const_cast<FlatHashTable*>(this)->find(key);
+    }
+
+    /*!
+     * \brief Returns whether the table contains a value with the given key.
+     */
+    template<typename K>
+    bool contains(const K& key) const
+    {
+        return find(key) != end();
+    }
+
+    /*!
+     * \brief Returns the number of values with the given key (0 or 1).
+     */
+    template<typename K>
+    size_type count(const K& key) const
+    {
+        return contains(key) ? 1 : 0;
+    }
+
+    /*!
+     * \brief Inserts a value constructed from the given arguments if there is
+     *        not already a value with the given key.
+     *
+     * \param key The key of the value to be constructed.
+     * \param args The arguments to construct the value with.
+     *
+     * \return An iterator to the value with the key, and whether it was
+     *         inserted.
+     */
+    template<typename K, typename... Args>
+    std::pair<iterator, bool> emplace_key(const K& key, Args&&... args)
+    {
+        const typename LookupKey<K>::type& lookup = key;
+        const std::size_t hash = hash_key(lookup);
+        iterator it = find_hashed(lookup, hash);
+        if(it != end())
+        {
+            return std::make_pair(it, false);
+        }
+        Value* slot = prepare_insert(hash);
+        new(slot) Value(std::forward<Args>(args)...);
+        return std::make_pair(iterator(m_ctrl + (slot - m_slots), slot), true);
+    }
+
+    /*!
+     * \brief Removes the value at the given position.
+     */
+    void erase(const_iterator position)
+    {
+        const std::size_t index =
+            static_cast<std::size_t>(position.m_ctrl - m_ctrl);
+        m_slots[index].~Value();
+        --m_size;
+
+        // if no group containing this slot was ever full, no probe sequence
+        // continued past it, so it can be marked empty instead of deleted
+        const std::size_t before =
+            (index - FlatHashGroup::WIDTH) & m_capacity;
+        const std::uint32_t empty_after =
+            FlatHashGroup(m_ctrl + index).match_empty();
+        const std::uint32_t empty_before =
+            FlatHashGroup(m_ctrl + before).match_empty();
+        const bool was_never_full =
+            empty_before != 0 &&
+            empty_after != 0 &&
+            FlatHashGroup::count_trailing_zeros(empty_after) +
+                FlatHashGroup::count_leading_zeros(empty_before) <
+                    FlatHashGroup::WIDTH;
+        if(was_never_full)
+        {
+            set_ctrl(index, kFlatHashEmpty);
+            ++m_growth_left;
+        }
+        else
+        {
+            set_ctrl(index, kFlatHashDeleted);
+        }
+    }
+
+    /*!
+     * \brief Removes the value with the given key, if there is one.
+     *
+     * \return The number of values removed (0 or 1).
+     */
+    template<typename K>
+    size_type erase_key(const K& key)
+    {
+        iterator it = find(key);
+        if(it == end())
+        {
+            return 0;
+        }
+        erase(it);
+        return 1;
+    }
+
+    /*!
+     * \brief Swaps the contents of this table with another.
+     */
+    void swap(FlatHashTable& other)
+    {
+        std::swap(static_cast<Hash&>(*this), static_cast<Hash&>(other));
+        std::swap(static_cast<Equal&>(*this), static_cast<Equal&>(other));
+        std::swap(m_ctrl, other.m_ctrl);
+        std::swap(m_slots, other.m_slots);
+        std::swap(m_size, other.m_size);
+        std::swap(m_capacity, other.m_capacity);
+        std::swap(m_growth_left, other.m_growth_left);
+    }
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    // m_capacity + WIDTH control bytes: one per slot, the sentinel, and a copy
+    // of the first WIDTH - 1 bytes so groups can be loaded past the end
+    FlatHashCtrl* m_ctrl;
+    Value* m_slots;
+    size_type m_size;
+    // the number of slots, this is always zero or one less than a power of two
+    // so that it can be used as a mask
+    size_type m_capacity;
+    // the number of values that can be inserted before the table must rehash
+    size_type m_growth_left;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    template<typename K>
+    std::size_t hash_key(const K& key) const
+    {
+        // the hash is mixed so that weak hashes (e.g. std::hash of integers)
+        // still provide well distributed control bytes
+        const typename LookupKey<K>::type& lookup = key;
+        return static_cast<std::size_t>(
+            hash_mix(static_cast<std::uint64_t>(get_hash()(lookup))));
+    }
+
+    static std::size_t get_h1(std::size_t hash)
+    {
+        return hash >> 7;
+    }
+
+    static FlatHashCtrl get_h2(std::size_t hash)
+    {
+        return static_cast<FlatHashCtrl>(hash & 0x7F);
+    }
+
+    // the maximum number of values for the given capacity (7/8 load)
+    static size_type get_max_load(size_type capacity)
+    {
+        return capacity - capacity / 8;
+    }
+
+    // the smallest valid capacity which can hold the given number of values
+    static size_type get_capacity_for(size_type count)
+    {
+        size_type capacity = FlatHashGroup::WIDTH - 1;
+        while(get_max_load(capacity) < count)
+        {
+            capacity = capacity * 2 + 1;
+        }
+        return capacity;
+    }
+
+    void set_ctrl(std::size_t index, FlatHashCtrl value)
+    {
+        static const std::size_t CLONED = FlatHashGroup::WIDTH - 1;
+        m_ctrl[index] = value;
+        m_ctrl[((index - CLONED) & m_capacity) + (CLONED & m_capacity)] =
+            value;
+    }
+
+    void reset_ctrl()
+    {
+        std::memset(m_ctrl, kFlatHashEmpty, m_capacity + FlatHashGroup::WIDTH);
+        m_ctrl[m_capacity] = kFlatHashSentinel;
+    }
+
+    void reset_empty()
+    {
+        m_ctrl = const_cast<FlatHashCtrl*>(get_flat_hash_empty_group());
+        m_slots = nullptr;
+        m_size = 0;
+        m_capacity = 0;
+        m_growth_left = 0;
+    }
+
+    // destroys all values and frees the memory of the table
+    void destroy()
+    {
+        if(m_capacity == 0)
+        {
+            return;
+        }
+        for(size_type i = 0; i < m_capacity; ++i)
+        {
+            if(m_ctrl[i] >= 0)
+            {
+                m_slots[i].~Value();
+            }
+        }
+        ::operator delete(m_ctrl);
+    }
+
+    // returns the value with the given key and hash of the key
+    template<typename K>
+    iterator find_hashed(const K& key, std::size_t hash)
+    {
+        const FlatHashCtrl h2 = get_h2(hash);
+        std::size_t offset = get_h1(hash) & m_capacity;
+        std::size_t step = 0;
+        while(true)
+        {
+            const FlatHashGroup group(m_ctrl + offset);
+            for(std::uint32_t mask = group.match(h2); mask != 0;
+                mask &= mask - 1)
+            {
+                const std::size_t index =
+                    (offset + FlatHashGroup::count_trailing_zeros(mask)) &
+                    m_capacity;
+                if(get_equal()(KeyOf()(m_slots[index]), key))
+                {
+                    return iterator(m_ctrl + index, m_slots + index);
+                }
+            }
+            if(group.match_empty() != 0)
+            {
+                return end();
+            }
+            step += FlatHashGroup::WIDTH;
+            offset = (offset + step) & m_capacity;
+        }
+    }
+
+    // returns the first empty or deleted slot in the probe sequence of hash
+    std::size_t find_first_non_full(std::size_t hash) const
+    {
+        std::size_t offset = get_h1(hash) & m_capacity;
+        std::size_t step = 0;
+        while(true)
+        {
+            const std::uint32_t mask =
+                FlatHashGroup(m_ctrl + offset).match_empty_or_deleted();
+            if(mask != 0)
+            {
+                return (offset + FlatHashGroup::count_trailing_zeros(mask)) &
+                       m_capacity;
+            }
+            step += FlatHashGroup::WIDTH;
+            offset = (offset + step) & m_capacity;
+        }
+    }
+
+    // claims a slot for a new value with the given hash
+    Value* prepare_insert(std::size_t hash)
+    {
+        std::size_t index = find_first_non_full(hash);
+        if(m_growth_left == 0 && m_ctrl[index] != kFlatHashDeleted)
+        {
+            // grow if the table is mostly full of values, otherwise just
+            // rehash to clear out the tombstones
+            if(m_capacity == 0)
+            {
+                rehash(FlatHashGroup::WIDTH - 1);
+            }
+            else if(m_size * 32 > m_capacity * 25)
+            {
+                rehash(m_capacity * 2 + 1);
+            }
+            else
+            {
+                rehash(m_capacity);
+            }
+            index = find_first_non_full(hash);
+        }
+        if(m_ctrl[index] == kFlatHashEmpty)
+        {
+            --m_growth_left;
+        }
+        ++m_size;
+        set_ctrl(index, get_h2(hash));
+        return m_slots + index;
+    }
+
+    // inserts a value that is known to not be in the table
+    void insert_unique(const Value& value)
+    {
+        Value* slot = prepare_insert(hash_key(KeyOf()(value)));
+        new(slot) Value(value);
+    }
+
+    // moves all values to a new allocation with the given capacity
+    void rehash(size_type capacity)
+    {
+        static_assert(
+            alignof(Value) <= alignof(std::max_align_t),
+            "FlatHashTable does not support over-aligned types"
+        );
+
+        const std::size_t ctrl_size =
+            (capacity + FlatHashGroup::WIDTH + alignof(Value) - 1) &
+            ~(alignof(Value) - 1);
+        char* memory = static_cast<char*>(
+            ::operator new(ctrl_size + capacity * sizeof(Value)));
+
+        FlatHashCtrl* old_ctrl = m_ctrl;
+        Value* old_slots = m_slots;
+        const size_type old_capacity = m_capacity;
+
+        m_ctrl = reinterpret_cast<FlatHashCtrl*>(memory);
+        m_slots = reinterpret_cast<Value*>(memory + ctrl_size);
+        m_capacity = capacity;
+        m_growth_left = get_max_load(capacity) - m_size;
+        reset_ctrl();
+
+        for(size_type i = 0; i < old_capacity; ++i)
+        {
+            if(old_ctrl[i] >= 0)
+            {
+                const std::size_t hash = hash_key(KeyOf()(old_slots[i]));
+                const std::size_t index = find_first_non_full(hash);
+                set_ctrl(index, get_h2(hash));
+                KeyOf::transfer(m_slots + index, old_slots + i);
+            }
+        }
+        if(old_capacity != 0)
+        {
+            ::operator delete(old_ctrl);
+        }
+    }
+};
+
+} // namespace lang
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
@@ -0,0 +1,175 @@
+/*!
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "arcanecore/base/lang/Futex.hpp"
+
+#include "arcanecore/base/Preproc.hpp"
+
+#ifdef ARC_OS_LINUX
+    #include <climits>
+    #include <linux/futex.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#else
+    #include <condition_variable>
+    #include <cstddef>
+    #include <cstdint>
+    #include <mutex>
+#endif
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace lang
+{
+
+namespace
+{
+
+#ifdef ARC_OS_LINUX
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+static long futex(
+        std::atomic<std::uint32_t>* word,
+        int operation,
+        std::uint32_t value)
+{
+    return syscall(
+        SYS_futex,
+        reinterpret_cast<std::uint32_t*>(word),
+        operation,
+        value,
+        nullptr,
+        nullptr,
+        0
+    );
+}
+
+#else
+
+//------------------------------------------------------------------------------
+//                                   CONSTANTS
+//------------------------------------------------------------------------------
+
+// the number of buckets waiting threads are distributed between
+static const std::size_t BUCKET_COUNT = 64;
+
+//------------------------------------------------------------------------------
+//                                    BUCKET
+//------------------------------------------------------------------------------
+
+/*
+ * The threads waiting on words whose addresses hash to the same bucket.
+ */
+struct Bucket
+{
+    std::mutex mutex;
+    std::condition_variable condition;
+};
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+static Bucket& get_bucket(std::atomic<std::uint32_t>* word)
+{
+    // deliberately leaked so that the buckets outlive any static objects
+    static Bucket* buckets = new Bucket[BUCKET_COUNT];
+    const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(word);
+    return buckets[(address >> 4) % BUCKET_COUNT];
+}
+
+#endif
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+void futex_wait(std::atomic<std::uint32_t>* word, std::uint32_t expected)
+{
+    #ifdef ARC_OS_LINUX
+
+        futex(word, FUTEX_WAIT_PRIVATE, expected);
+
+    #else
+
+        Bucket& bucket = get_bucket(word);
+        std::unique_lock<std::mutex> lock(bucket.mutex);
+        if(word->load(std::memory_order_acquire) == expected)
+        {
+            bucket.condition.wait(lock);
+        }
+
+    #endif
+}
+
+void futex_wake_one(std::atomic<std::uint32_t>* word)
+{
+    #ifdef ARC_OS_LINUX
+
+        futex(word, FUTEX_WAKE_PRIVATE, 1);
+
+    #else
+
+        // other words may share the bucket, so all threads must be woken
+        futex_wake_all(word);
+
+    #endif
+}
+
+void futex_wake_all(std::atomic<std::uint32_t>* word)
+{
+    #ifdef ARC_OS_LINUX
+
+        futex(word, FUTEX_WAKE_PRIVATE, INT_MAX);
+
+    #else
+
+        Bucket& bucket = get_bucket(word);
+        {
+            // acquiring the lock orders the wake after any waiter's check
+            std::lock_guard<std::mutex> lock(bucket.mutex);
+        }
+        bucket.condition.notify_all();
+
+    #endif
+}
+
+} // namespace lang
+ARC_BASE_VERSION_NS_END
+} // namespace arc
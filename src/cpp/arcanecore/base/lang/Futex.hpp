@@ -0,0 +1,81 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Operations for waiting on the value of an atomic integer.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_LANG_FUTEX_HPP_
+#define ARCANECORE_BASE_LANG_FUTEX_HPP_
+
+#include <atomic>
+#include <cstdint>
+
+#include "arcanecore/base/BaseAPI.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace lang
+{
+
+/*!
+ * \brief Blocks the calling thread while the given word has the expected
+ *        value.
+ *
+ * This may return spuriously, so callers should check the condition they are
+ * waiting for in a loop. On Linux this is a futex, on other platforms waiting
+ * threads are parked on a condition variable selected by the address of the
+ * word.
+ */
+void futex_wait(std::atomic<std::uint32_t>* word, std::uint32_t expected);
+
+/*!
+ * \brief Wakes at most one thread blocked in futex_wait() on the given word.
+ *
+ * The word should be modified before calling this function.
+ */
+void futex_wake_one(std::atomic<std::uint32_t>* word);
+
+/*!
+ * \brief Wakes all threads blocked in futex_wait() on the given word.
+ *
+ * The word should be modified before calling this function.
+ */
+void futex_wake_all(std::atomic<std::uint32_t>* word);
+
+} // namespace lang
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
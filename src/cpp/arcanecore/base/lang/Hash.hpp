@@ -0,0 +1,236 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Hashing utilities and transparent string hash functors.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_LANG_HASH_HPP_
+#define ARCANECORE_BASE_LANG_HASH_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include <deus/UnicodeStorage.hpp>
+#include <deus/UnicodeView.hpp>
+
+#include "arcanecore/base/BaseAPI.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace lang
+{
+
+/*!
+ * \brief Mixes the bits of the given value so that every bit of the result
+ *        depends on every bit of the input.
+ */
+inline std::uint64_t hash_mix(std::uint64_t value)
+{
+    value ^= value >> 33;
+    value *= 0xFF51AFD7ED558CCDULL;
+    value ^= value >> 33;
+    value *= 0xC4CEB9FE1A85EC53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+/*!
+ * \brief Returns a 64-bit hash of the given bytes.
+ */
+inline std::uint64_t hash_bytes(const void* data, std::size_t size)
+{
+    static const std::uint64_t MULTIPLIER_A = 0x9E3779B97F4A7C15ULL;
+    static const std::uint64_t MULTIPLIER_B = 0xC2B2AE3D27D4EB4FULL;
+
+    // reads use fixed sizes so that they compile to single loads
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    std::uint64_t hash = size * MULTIPLIER_A;
+    if(size <= 8)
+    {
+        std::uint64_t word = 0;
+        if(size >= 4)
+        {
+            // two possibly overlapping 4 byte reads cover the string
+            std::uint32_t low;
+            std::uint32_t high;
+            std::memcpy(&low, bytes, 4);
+            std::memcpy(&high, bytes + size - 4, 4);
+            word = (static_cast<std::uint64_t>(high) << 32) | low;
+        }
+        else if(size > 0)
+        {
+            word =
+                (static_cast<std::uint64_t>(bytes[0]) << 16) |
+                (static_cast<std::uint64_t>(bytes[size / 2]) << 8) |
+                bytes[size - 1];
+        }
+        return hash_mix(hash ^ word);
+    }
+
+    const unsigned char* last = bytes + size - 8;
+    std::uint64_t word;
+    while(bytes < last)
+    {
+        std::memcpy(&word, bytes, 8);
+        hash = (hash ^ (word * MULTIPLIER_B)) * MULTIPLIER_A;
+        hash ^= hash >> 29;
+        bytes += 8;
+    }
+    // the final read overlaps the previous one rather than reading a partial
+    // word
+    std::memcpy(&word, last, 8);
+    hash = (hash ^ (word * MULTIPLIER_B)) * MULTIPLIER_A;
+    return hash_mix(hash);
+}
+
+/*!
+ * \brief Hash functor for strings which supports heterogeneous lookup.
+ *
+ * Null terminated strings, ```std::string```, deus::UnicodeView and
+ * deus::UnicodeStorage objects with the same bytes all have the same hash, so
+ * a container keyed by ```std::string``` can be searched with any of these
+ * types without constructing a key. deus strings are hashed by their raw
+ * bytes, so should be in the same encoding as the keys (i.e. UTF-8).
+ */
+struct StringHash
+{
+    //--------------------------------------------------------------------------
+    //                                PUBLIC TYPES
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Marks this functor as supporting heterogeneous lookup.
+     */
+    typedef void is_transparent;
+
+    //--------------------------------------------------------------------------
+    //                                 OPERATORS
+    //--------------------------------------------------------------------------
+
+    std::size_t operator()(const char* s) const
+    {
+        return static_cast<std::size_t>(hash_bytes(s, std::strlen(s)));
+    }
+
+    std::size_t operator()(const std::string& s) const
+    {
+        return static_cast<std::size_t>(hash_bytes(s.data(), s.size()));
+    }
+
+    std::size_t operator()(const deus::UnicodeView& s) const
+    {
+        return static_cast<std::size_t>(
+            hash_bytes(s.c_str(), s.byte_length() - 1));
+    }
+
+    std::size_t operator()(const deus::UnicodeStorage& s) const
+    {
+        return (*this)(s.get_view());
+    }
+};
+
+/*!
+ * \brief Equality functor for strings which supports heterogeneous lookup.
+ *
+ * Compares the bytes of any combination of null terminated strings,
+ * ```std::string```, deus::UnicodeView and deus::UnicodeStorage objects. See
+ * arc::lang::StringHash.
+ */
+struct StringEqual
+{
+    //--------------------------------------------------------------------------
+    //                                PUBLIC TYPES
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Marks this functor as supporting heterogeneous lookup.
+     */
+    typedef void is_transparent;
+
+    //--------------------------------------------------------------------------
+    //                                 OPERATORS
+    //--------------------------------------------------------------------------
+
+    template<typename A, typename B>
+    bool operator()(const A& a, const B& b) const
+    {
+        const char* a_data = nullptr;
+        const char* b_data = nullptr;
+        const std::size_t a_size = get_bytes(a, a_data);
+        const std::size_t b_size = get_bytes(b, b_data);
+        return a_size == b_size && std::memcmp(a_data, b_data, a_size) == 0;
+    }
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                       PRIVATE STATIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    static std::size_t get_bytes(const char* s, const char*& out_data)
+    {
+        out_data = s;
+        return std::strlen(s);
+    }
+
+    static std::size_t get_bytes(const std::string& s, const char*& out_data)
+    {
+        out_data = s.data();
+        return s.size();
+    }
+
+    static std::size_t get_bytes(
+            const deus::UnicodeView& s,
+            const char*& out_data)
+    {
+        out_data = s.c_str();
+        return s.byte_length() - 1;
+    }
+
+    static std::size_t get_bytes(
+            const deus::UnicodeStorage& s,
+            const char*& out_data)
+    {
+        return get_bytes(s.get_view(), out_data);
+    }
+};
+
+} // namespace lang
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
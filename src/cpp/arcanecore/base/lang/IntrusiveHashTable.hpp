@@ -0,0 +1,657 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Chained hash table of objects which contain their own links.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_LANG_INTRUSIVEHASHTABLE_HPP_
+#define ARCANECORE_BASE_LANG_INTRUSIVEHASHTABLE_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/lang/Hash.hpp"
+#include "arcanecore/base/lang/Restrictors.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace lang
+{
+
+//------------------------------------------------------------------------------
+//                              FORWARD DECLARATIONS
+//------------------------------------------------------------------------------
+
+class IntrusiveHashHook;
+
+template<
+    typename T,
+    IntrusiveHashHook T::*HOOK,
+    typename KeyOf,
+    typename Hash,
+    typename Equal
+>
+class IntrusiveHashTable;
+
+//------------------------------------------------------------------------------
+//                                      HOOK
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief The link and cached hash an object needs to be a member of an
+ *        arc::lang::IntrusiveHashTable.
+ *
+ * Like arc::lang::IntrusiveListHook, a hook can't be copied or moved.
+ */
+class IntrusiveHashHook
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    IntrusiveHashHook()
+        : m_next  (nullptr)
+        , m_hash  (0)
+        , m_linked(false)
+    {
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns whether the object of this hook is in a table.
+     */
+    bool is_linked() const
+    {
+        return m_linked;
+    }
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                                  FRIENDS
+    //--------------------------------------------------------------------------
+
+    template<
+        typename T,
+        IntrusiveHashHook T::*HOOK,
+        typename KeyOf,
+        typename Hash,
+        typename Equal
+    >
+    friend class IntrusiveHashTable;
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    // the next hook in the same bucket
+    IntrusiveHashHook* m_next;
+    // the hash of the object's key, so the table can grow without rehashing
+    // keys
+    std::size_t m_hash;
+    bool m_linked;
+};
+
+//------------------------------------------------------------------------------
+//                                     TABLE
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief Hash table of objects which store their own links in an
+ *        arc::lang::IntrusiveHashHook member.
+ *
+ * Each bucket is a singly linked chain threaded through the objects, so
+ * inserting an object only allocates when the bucket array grows. Keys are
+ * read from the objects themselves with the KeyOf functor, so are not
+ * duplicated. Lookups are heterogeneous when the hash and equality functors
+ * are transparent (e.g. arc::lang::StringHash and arc::lang::StringEqual).
+ *
+ * Like arc::lang::IntrusiveList, the table does not own its objects, which
+ * must be neither copyable nor movable, and the key of an object must not
+ * change while it is in the table.
+ *
+ * \code
+ * struct KeyOfSession
+ * {
+ *     std::uint64_t operator()(const Session& session) const
+ *     {
+ *         return session.id;
+ *     }
+ * };
+ *
+ * arc::lang::IntrusiveHashTable<
+ *     Session,
+ *     &Session::hook,
+ *     KeyOfSession
+ * > sessions;
+ * \endcode
+ *
+ * \tparam T The type of the objects in the table.
+ * \tparam HOOK The member of T that links it into this table.
+ * \tparam KeyOf Functor which returns the key of an object.
+ * \tparam Hash Functor which hashes keys.
+ * \tparam Equal Functor which compares keys.
+ */
+template<
+    typename T,
+    IntrusiveHashHook T::*HOOK,
+    typename KeyOf,
+    typename Hash = std::hash<
+        typename std::decay<
+            decltype(std::declval<KeyOf>()(std::declval<const T&>()))
+        >::type
+    >,
+    typename Equal = std::equal_to<
+        typename std::decay<
+            decltype(std::declval<KeyOf>()(std::declval<const T&>()))
+        >::type
+    >
+>
+class IntrusiveHashTable
+    : private arc::lang::Noncopyable
+    , private arc::lang::Noncomparable
+    , private Hash
+    , private Equal
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                                PUBLIC TYPES
+    //--------------------------------------------------------------------------
+
+    typedef T value_type;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Hash hasher;
+    typedef Equal key_equal;
+    typedef T& reference;
+    typedef const T& const_reference;
+
+    /*!
+     * \brief Forward iterator over the objects in the table, in no particular
+     *        order.
+     */
+    template<bool IS_CONST>
+    class Iterator
+    {
+    public:
+
+        typedef std::forward_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef typename std::conditional<IS_CONST, const T*, T*>::type
+            pointer;
+        typedef typename std::conditional<IS_CONST, const T&, T&>::type
+            reference;
+
+        Iterator()
+            : m_bucket(nullptr)
+            , m_end   (nullptr)
+            , m_hook  (nullptr)
+        {
+        }
+
+        // allow conversion from a mutable to a const iterator
+        Iterator(const Iterator<false>& other)
+            : m_bucket(other.m_bucket)
+            , m_end   (other.m_end)
+            , m_hook  (other.m_hook)
+        {
+        }
+
+        reference operator*() const
+        {
+            return *get_object(m_hook);
+        }
+
+        pointer operator->() const
+        {
+            return get_object(m_hook);
+        }
+
+        Iterator& operator++()
+        {
+            m_hook = m_hook->m_next;
+            if(m_hook == nullptr)
+            {
+                ++m_bucket;
+                skip_empty();
+            }
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator ret(*this);
+            ++(*this);
+            return ret;
+        }
+
+        bool operator==(const Iterator& other) const
+        {
+            return m_hook == other.m_hook;
+        }
+
+        bool operator!=(const Iterator& other) const
+        {
+            return m_hook != other.m_hook;
+        }
+
+    private:
+
+        friend class IntrusiveHashTable;
+        friend class Iterator<!IS_CONST>;
+
+        IntrusiveHashHook* const* m_bucket;
+        IntrusiveHashHook* const* m_end;
+        IntrusiveHashHook* m_hook;
+
+        Iterator(
+                IntrusiveHashHook* const* bucket,
+                IntrusiveHashHook* const* end)
+            : m_bucket(bucket)
+            , m_end   (end)
+            , m_hook  (nullptr)
+        {
+            skip_empty();
+        }
+
+        // advances to the first object of the next non-empty bucket, the end
+        // iterator has a null hook
+        void skip_empty()
+        {
+            while(m_bucket != m_end && *m_bucket == nullptr)
+            {
+                ++m_bucket;
+            }
+            m_hook = m_bucket != m_end ? *m_bucket : nullptr;
+        }
+    };
+
+    typedef Iterator<false> iterator;
+    typedef Iterator<true> const_iterator;
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Constructs a new empty table, which does not allocate until an
+     *        object is inserted.
+     */
+    explicit IntrusiveHashTable(
+            const KeyOf& key_of = KeyOf(),
+            const Hash& hash = Hash(),
+            const Equal& equal = Equal())
+        : Hash   (hash)
+        , Equal  (equal)
+        , m_key_of(key_of)
+        , m_size  (0)
+    {
+        static_assert(
+            !std::is_copy_constructible<T>::value &&
+            !std::is_move_constructible<T>::value,
+            "IntrusiveHashTable objects must be neither copyable nor movable"
+        );
+    }
+
+    /*!
+     * \brief Moves the objects of the other table into a new table, leaving
+     *        the other table empty.
+     */
+    IntrusiveHashTable(IntrusiveHashTable&& other)
+        : Hash    (static_cast<const Hash&>(other))
+        , Equal   (static_cast<const Equal&>(other))
+        , m_key_of(other.m_key_of)
+        , m_buckets(std::move(other.m_buckets))
+        , m_size   (other.m_size)
+    {
+        other.m_buckets.clear();
+        other.m_size = 0;
+    }
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Unlinks any objects still in the table, without destroying them.
+     */
+    ~IntrusiveHashTable()
+    {
+        clear();
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    iterator begin()
+    {
+        return iterator(get_buckets(), get_buckets() + m_buckets.size());
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator(
+            get_buckets(),
+            get_buckets() + m_buckets.size()
+        );
+    }
+
+    iterator end()
+    {
+        return iterator();
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator();
+    }
+
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    size_type size() const
+    {
+        return m_size;
+    }
+
+    /*!
+     * \brief Returns the number of buckets the objects are distributed
+     *        between.
+     */
+    size_type bucket_count() const
+    {
+        return m_buckets.size();
+    }
+
+    /*!
+     * \brief Inserts the given object if no object with an equal key is in
+     *        the table.
+     *
+     * \return The object with the key in the table, and whether it is the
+     *         given object.
+     */
+    std::pair<T*, bool> insert(T& object)
+    {
+        const std::size_t hash = Hash::operator()(m_key_of(object));
+        T* existing = find_hashed(m_key_of(object), hash);
+        if(existing != nullptr)
+        {
+            return std::make_pair(existing, false);
+        }
+
+        // keep the load factor at most 1
+        if(m_size + 1 > m_buckets.size())
+        {
+            rehash(m_buckets.empty() ? MIN_BUCKETS : m_buckets.size() * 2);
+        }
+
+        IntrusiveHashHook* hook = &(object.*HOOK);
+        IntrusiveHashHook*& bucket = m_buckets[get_index(hash)];
+        hook->m_next = bucket;
+        hook->m_hash = hash;
+        hook->m_linked = true;
+        bucket = hook;
+        ++m_size;
+        return std::make_pair(&object, true);
+    }
+
+    /*!
+     * \brief Returns the object with the given key, or null if there isn't
+     *        one.
+     */
+    template<typename K>
+    T* find(const K& key)
+    {
+        return find_hashed(key, Hash::operator()(key));
+    }
+
+    template<typename K>
+    const T* find(const K& key) const
+    {
+        return const_cast<IntrusiveHashTable*>(this)->find(key);
+    }
+
+    template<typename K>
+    bool contains(const K& key) const
+    {
+        return find(key) != nullptr;
+    }
+
+    /*!
+     * \brief Removes the given object, which must be in this table.
+     */
+    void erase(T& object)
+    {
+        IntrusiveHashHook* hook = &(object.*HOOK);
+        IntrusiveHashHook** link = &m_buckets[get_index(hook->m_hash)];
+        while(*link != hook)
+        {
+            link = &(*link)->m_next;
+        }
+        *link = hook->m_next;
+        unlink(hook);
+        --m_size;
+    }
+
+    /*!
+     * \brief Removes the object with the given key.
+     *
+     * \return The removed object, or null if there was no object with the
+     *         key.
+     */
+    template<typename K>
+    T* erase_key(const K& key)
+    {
+        T* object = find(key);
+        if(object != nullptr)
+        {
+            erase(*object);
+        }
+        return object;
+    }
+
+    /*!
+     * \brief Removes every object from the table, without destroying them.
+     *
+     * The bucket array is kept for reuse.
+     */
+    void clear()
+    {
+        clear_and_dispose([](T*) {});
+    }
+
+    /*!
+     * \brief Removes every object from the table, and then calls the given
+     *        disposer with a pointer to each object.
+     */
+    template<typename Disposer>
+    void clear_and_dispose(Disposer disposer)
+    {
+        for(IntrusiveHashHook*& bucket : m_buckets)
+        {
+            IntrusiveHashHook* hook = bucket;
+            bucket = nullptr;
+            while(hook != nullptr)
+            {
+                // the disposer may destroy the hook
+                IntrusiveHashHook* next = hook->m_next;
+                unlink(hook);
+                disposer(get_object(hook));
+                hook = next;
+            }
+        }
+        m_size = 0;
+    }
+
+    /*!
+     * \brief Ensures the table can hold the given number of objects without
+     *        growing.
+     */
+    void reserve(size_type count)
+    {
+        size_type bucket_count = MIN_BUCKETS;
+        while(bucket_count < count)
+        {
+            bucket_count *= 2;
+        }
+        if(bucket_count > m_buckets.size())
+        {
+            rehash(bucket_count);
+        }
+    }
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE CONSTANTS
+    //--------------------------------------------------------------------------
+
+    // the number of buckets allocated by the first insertion
+    static const size_type MIN_BUCKETS = 8;
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    KeyOf m_key_of;
+    // the heads of the chains, the size is always zero or a power of two
+    std::vector<IntrusiveHashHook*> m_buckets;
+    size_type m_size;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE STATIC FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    // returns the object the given hook is a member of
+    static T* get_object(const IntrusiveHashHook* hook)
+    {
+        // the offset of the hook member, measured on suitably aligned storage
+        // since T can't be constructed here
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+        const T* object = reinterpret_cast<const T*>(&storage);
+        const std::ptrdiff_t offset =
+            reinterpret_cast<const char*>(&(object->*HOOK)) -
+            reinterpret_cast<const char*>(object);
+
+        return reinterpret_cast<T*>(
+            const_cast<char*>(reinterpret_cast<const char*>(hook)) - offset);
+    }
+
+    static void unlink(IntrusiveHashHook* hook)
+    {
+        hook->m_next = nullptr;
+        hook->m_linked = false;
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    IntrusiveHashHook* const* get_buckets() const
+    {
+        return m_buckets.data();
+    }
+
+    // returns the bucket of the given hash, which is mixed first since hashes
+    // such as std::hash of integers are not well distributed in their low
+    // bits
+    std::size_t get_index(std::size_t hash) const
+    {
+        return static_cast<std::size_t>(hash_mix(hash)) &
+               (m_buckets.size() - 1);
+    }
+
+    template<typename K>
+    T* find_hashed(const K& key, std::size_t hash)
+    {
+        if(m_buckets.empty())
+        {
+            return nullptr;
+        }
+        for(IntrusiveHashHook* hook = m_buckets[get_index(hash)];
+            hook != nullptr;
+            hook = hook->m_next)
+        {
+            if(hook->m_hash == hash &&
+               Equal::operator()(m_key_of(*get_object(hook)), key))
+            {
+                return get_object(hook);
+            }
+        }
+        return nullptr;
+    }
+
+    // redistributes the objects between the given number of buckets
+    void rehash(size_type bucket_count)
+    {
+        std::vector<IntrusiveHashHook*> buckets(bucket_count, nullptr);
+        m_buckets.swap(buckets);
+        for(IntrusiveHashHook* hook : buckets)
+        {
+            while(hook != nullptr)
+            {
+                IntrusiveHashHook* next = hook->m_next;
+                IntrusiveHashHook*& bucket = m_buckets[get_index(hook->m_hash)];
+                hook->m_next = bucket;
+                bucket = hook;
+                hook = next;
+            }
+        }
+    }
+};
+
+} // namespace lang
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
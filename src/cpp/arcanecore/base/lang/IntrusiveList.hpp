@@ -0,0 +1,529 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Doubly linked list of objects which contain their own links.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_LANG_INTRUSIVELIST_HPP_
+#define ARCANECORE_BASE_LANG_INTRUSIVELIST_HPP_
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/lang/Restrictors.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace lang
+{
+
+//------------------------------------------------------------------------------
+//                              FORWARD DECLARATIONS
+//------------------------------------------------------------------------------
+
+class IntrusiveListHook;
+
+template<typename T, IntrusiveListHook T::*HOOK>
+class IntrusiveList;
+
+//------------------------------------------------------------------------------
+//                                      HOOK
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief The links an object needs to be a member of an
+ *        arc::lang::IntrusiveList.
+ *
+ * An object has one hook member for each list it can be in at the same time.
+ * A hook can't be copied or moved since the list points to it, so any class
+ * with a hook member is also neither copyable nor movable.
+ */
+class IntrusiveListHook
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    IntrusiveListHook()
+        : m_prev(nullptr)
+        , m_next(nullptr)
+    {
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns whether the object of this hook is in a list.
+     */
+    bool is_linked() const
+    {
+        return m_next != nullptr;
+    }
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                                  FRIENDS
+    //--------------------------------------------------------------------------
+
+    template<typename T, IntrusiveListHook T::*HOOK>
+    friend class IntrusiveList;
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    IntrusiveListHook* m_prev;
+    IntrusiveListHook* m_next;
+};
+
+//------------------------------------------------------------------------------
+//                                      LIST
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief Doubly linked list of objects which store the links themselves in an
+ *        arc::lang::IntrusiveListHook member.
+ *
+ * Unlike ```std::list<std::unique_ptr<T>>``` inserting an object doesn't
+ * allocate, and iterating reaches each object through one pointer rather than
+ * two. Objects can be removed in constant time given just a reference to
+ * them.
+ *
+ * The list does not own its objects: they must outlive their membership, and
+ * must be removed (or the list cleared) before they are destroyed.
+ * clear_and_dispose() can be used to destroy owned objects.
+ *
+ * Since the list stores pointers to its objects, they must not be copyable or
+ * movable, which is what the arc::lang::Noncopyable and
+ * arc::lang::Nonmovable restrictors mark.
+ *
+ * \code
+ * class Timer
+ *     : private arc::lang::Noncopyable
+ *     , private arc::lang::Nonmovable
+ * {
+ * public:
+ *     arc::lang::IntrusiveListHook hook;
+ * };
+ *
+ * arc::lang::IntrusiveList<Timer, &Timer::hook> timers;
+ * \endcode
+ *
+ * \tparam T The type of the objects in the list.
+ * \tparam HOOK The member of T that links it into this list.
+ */
+template<typename T, IntrusiveListHook T::*HOOK>
+class IntrusiveList
+    : private arc::lang::Noncopyable
+    , private arc::lang::Noncomparable
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                                PUBLIC TYPES
+    //--------------------------------------------------------------------------
+
+    typedef T value_type;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef T& reference;
+    typedef const T& const_reference;
+
+    /*!
+     * \brief Bidirectional iterator over the objects in the list.
+     */
+    template<bool IS_CONST>
+    class Iterator
+    {
+    public:
+
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef typename std::conditional<IS_CONST, const T*, T*>::type
+            pointer;
+        typedef typename std::conditional<IS_CONST, const T&, T&>::type
+            reference;
+
+        Iterator()
+            : m_hook(nullptr)
+        {
+        }
+
+        // allow conversion from a mutable to a const iterator
+        Iterator(const Iterator<false>& other)
+            : m_hook(other.m_hook)
+        {
+        }
+
+        reference operator*() const
+        {
+            return *get_object(m_hook);
+        }
+
+        pointer operator->() const
+        {
+            return get_object(m_hook);
+        }
+
+        Iterator& operator++()
+        {
+            m_hook = m_hook->m_next;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator ret(*this);
+            ++(*this);
+            return ret;
+        }
+
+        Iterator& operator--()
+        {
+            m_hook = m_hook->m_prev;
+            return *this;
+        }
+
+        Iterator operator--(int)
+        {
+            Iterator ret(*this);
+            --(*this);
+            return ret;
+        }
+
+        bool operator==(const Iterator& other) const
+        {
+            return m_hook == other.m_hook;
+        }
+
+        bool operator!=(const Iterator& other) const
+        {
+            return m_hook != other.m_hook;
+        }
+
+    private:
+
+        friend class IntrusiveList;
+        friend class Iterator<!IS_CONST>;
+
+        IntrusiveListHook* m_hook;
+
+        explicit Iterator(const IntrusiveListHook* hook)
+            : m_hook(const_cast<IntrusiveListHook*>(hook))
+        {
+        }
+    };
+
+    typedef Iterator<false> iterator;
+    typedef Iterator<true> const_iterator;
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Constructs a new empty list.
+     */
+    IntrusiveList()
+        : m_size(0)
+    {
+        static_assert(
+            !std::is_copy_constructible<T>::value &&
+            !std::is_move_constructible<T>::value,
+            "IntrusiveList objects must be neither copyable nor movable"
+        );
+
+        m_root.m_prev = &m_root;
+        m_root.m_next = &m_root;
+    }
+
+    /*!
+     * \brief Moves the objects of the other list into a new list, leaving
+     *        the other list empty.
+     */
+    IntrusiveList(IntrusiveList&& other)
+        : IntrusiveList()
+    {
+        splice(end(), other);
+    }
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Unlinks any objects still in the list, without destroying them.
+     */
+    ~IntrusiveList()
+    {
+        clear();
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    iterator begin()
+    {
+        return iterator(m_root.m_next);
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator(m_root.m_next);
+    }
+
+    iterator end()
+    {
+        return iterator(&m_root);
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(&m_root);
+    }
+
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    size_type size() const
+    {
+        return m_size;
+    }
+
+    T& front()
+    {
+        return *get_object(m_root.m_next);
+    }
+
+    const T& front() const
+    {
+        return *get_object(m_root.m_next);
+    }
+
+    T& back()
+    {
+        return *get_object(m_root.m_prev);
+    }
+
+    const T& back() const
+    {
+        return *get_object(m_root.m_prev);
+    }
+
+    /*!
+     * \brief Returns an iterator to the given object, which must be in this
+     *        list.
+     */
+    iterator iterator_to(T& object)
+    {
+        return iterator(&(object.*HOOK));
+    }
+
+    const_iterator iterator_to(const T& object) const
+    {
+        return const_iterator(&(object.*HOOK));
+    }
+
+    /*!
+     * \brief Inserts the given object, which must not be in a list using the
+     *        same hook, before the given position.
+     *
+     * \return An iterator to the inserted object.
+     */
+    iterator insert(const_iterator position, T& object)
+    {
+        IntrusiveListHook* next = position.m_hook;
+        IntrusiveListHook* hook = &(object.*HOOK);
+        hook->m_prev = next->m_prev;
+        hook->m_next = next;
+        next->m_prev->m_next = hook;
+        next->m_prev = hook;
+        ++m_size;
+        return iterator(hook);
+    }
+
+    void push_front(T& object)
+    {
+        insert(begin(), object);
+    }
+
+    void push_back(T& object)
+    {
+        insert(end(), object);
+    }
+
+    /*!
+     * \brief Removes the object at the given position from the list.
+     *
+     * \return An iterator to the object after the removed object.
+     */
+    iterator erase(const_iterator position)
+    {
+        IntrusiveListHook* hook = position.m_hook;
+        IntrusiveListHook* next = hook->m_next;
+        hook->m_prev->m_next = next;
+        next->m_prev = hook->m_prev;
+        hook->m_prev = nullptr;
+        hook->m_next = nullptr;
+        --m_size;
+        return iterator(next);
+    }
+
+    /*!
+     * \brief Removes the given object, which must be in this list.
+     */
+    void erase(T& object)
+    {
+        erase(iterator_to(object));
+    }
+
+    void pop_front()
+    {
+        erase(begin());
+    }
+
+    void pop_back()
+    {
+        erase(const_iterator(m_root.m_prev));
+    }
+
+    /*!
+     * \brief Moves every object of the other list before the given position
+     *        of this list.
+     */
+    void splice(const_iterator position, IntrusiveList& other)
+    {
+        if(other.empty())
+        {
+            return;
+        }
+
+        IntrusiveListHook* next = position.m_hook;
+        IntrusiveListHook* first = other.m_root.m_next;
+        IntrusiveListHook* last = other.m_root.m_prev;
+        first->m_prev = next->m_prev;
+        last->m_next = next;
+        next->m_prev->m_next = first;
+        next->m_prev = last;
+        m_size += other.m_size;
+
+        other.m_root.m_prev = &other.m_root;
+        other.m_root.m_next = &other.m_root;
+        other.m_size = 0;
+    }
+
+    /*!
+     * \brief Removes every object from the list, without destroying them.
+     */
+    void clear()
+    {
+        clear_and_dispose([](T*) {});
+    }
+
+    /*!
+     * \brief Removes every object from the list, and then calls the given
+     *        disposer with a pointer to each object.
+     *
+     * \code
+     * list.clear_and_dispose(std::default_delete<T>());
+     * \endcode
+     */
+    template<typename Disposer>
+    void clear_and_dispose(Disposer disposer)
+    {
+        IntrusiveListHook* hook = m_root.m_next;
+        m_root.m_prev = &m_root;
+        m_root.m_next = &m_root;
+        m_size = 0;
+        while(hook != &m_root)
+        {
+            // the disposer may destroy the hook
+            IntrusiveListHook* next = hook->m_next;
+            hook->m_prev = nullptr;
+            hook->m_next = nullptr;
+            disposer(get_object(hook));
+            hook = next;
+        }
+    }
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    // the list is circular through this hook, which is not part of an object
+    IntrusiveListHook m_root;
+    size_type m_size;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE STATIC FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    // returns the object the given hook is a member of
+    static T* get_object(const IntrusiveListHook* hook)
+    {
+        // the offset of the hook member, measured on suitably aligned storage
+        // since T can't be constructed here
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+        const T* object = reinterpret_cast<const T*>(&storage);
+        const std::ptrdiff_t offset =
+            reinterpret_cast<const char*>(&(object->*HOOK)) -
+            reinterpret_cast<const char*>(object);
+
+        return reinterpret_cast<T*>(
+            const_cast<char*>(reinterpret_cast<const char*>(hook)) - offset);
+    }
+};
+
+} // namespace lang
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
@@ -0,0 +1,491 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Bounded lock-free multiple producer, multiple consumer queue.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_LANG_MPMCQUEUE_HPP_
+#define ARCANECORE_BASE_LANG_MPMCQUEUE_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/Preproc.hpp"
+#include "arcanecore/base/lang/Restrictors.hpp"
+#include "arcanecore/base/lang/WaitStrategy.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace lang
+{
+
+/*!
+ * \brief Bounded lock-free queue which any number of threads may push to and
+ *        pop from.
+ *
+ * This is Dmitry Vyukov's bounded MPMC queue: a power of two sized ring of
+ * cells, where each cell has a sequence number that says whether it is ready
+ * to be written or read for a given position. Producers and consumers each
+ * claim positions with a single compare and swap on their own cache line.
+ *
+ * Batch operations claim a run of consecutive positions with one compare and
+ * swap. A thread that has claimed a position whose cell is still being
+ * read (or written) by the thread that claimed the previous lap of the ring
+ * briefly spins until it is released.
+ *
+ * The try_ functions never block. The blocking functions wait using the Wait
+ * strategy (see arc::lang::BlockingWait and arc::lang::SpinWait).
+ *
+ * \tparam T The type of the values in the queue.
+ * \tparam Wait The strategy used when blocking on a full or empty queue.
+ */
+template<typename T, typename Wait = arc::lang::BlockingWait>
+class MpmcQueue
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Constructs a new queue.
+     *
+     * \param capacity The maximum number of values in the queue, this is
+     *                 rounded up to a power of two (of at least 2).
+     */
+    explicit MpmcQueue(std::size_t capacity)
+        : m_mask       (round_capacity(capacity) - 1)
+        , m_cells      (static_cast<Cell*>(
+            ::operator new((m_mask + 1) * sizeof(Cell))
+        ))
+        , m_enqueue_pos(0)
+        , m_dequeue_pos(0)
+    {
+        for(std::size_t i = 0; i <= m_mask; ++i)
+        {
+            new(&m_cells[i].sequence) std::atomic<std::size_t>(i);
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    ~MpmcQueue()
+    {
+        const std::size_t end = m_enqueue_pos.load(std::memory_order_relaxed);
+        for(std::size_t i = m_dequeue_pos.load(std::memory_order_relaxed);
+            i != end; ++i)
+        {
+            get_value(m_cells[i & m_mask]).~T();
+        }
+        ::operator delete(m_cells);
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns the maximum number of values in the queue.
+     */
+    std::size_t capacity() const
+    {
+        return m_mask + 1;
+    }
+
+    /*!
+     * \brief Returns the number of values in the queue, this is only a
+     *        snapshot if other threads are using the queue.
+     */
+    std::size_t size() const
+    {
+        const std::size_t dequeue =
+            m_dequeue_pos.load(std::memory_order_acquire);
+        const std::size_t enqueue =
+            m_enqueue_pos.load(std::memory_order_acquire);
+        return (enqueue > dequeue) ? enqueue - dequeue : 0;
+    }
+
+    /*!
+     * \brief Returns whether the queue contains no values, this is only a
+     *        snapshot if other threads are using the queue.
+     */
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    /*!
+     * \brief Constructs a value at the back of the queue if it is not full.
+     *
+     * \return Whether the value was pushed.
+     */
+    template<typename... Args>
+    bool try_emplace(Args&&... args)
+    {
+        std::size_t position = 0;
+        if(claim(m_enqueue_pos, 0, 1, position) == 0)
+        {
+            return false;
+        }
+        Cell& cell = m_cells[position & m_mask];
+        new(&cell.storage) T(std::forward<Args>(args)...);
+        cell.sequence.store(position + 1, std::memory_order_release);
+        m_not_empty.notify_one();
+        return true;
+    }
+
+    /*!
+     * \brief Pushes a copy of the given value if the queue is not full.
+     */
+    bool try_push(const T& value)
+    {
+        return try_emplace(value);
+    }
+
+    /*!
+     * \brief Moves the given value into the queue if it is not full, the
+     *        value is unchanged if it could not be pushed.
+     */
+    bool try_push(T&& value)
+    {
+        return try_emplace(std::move(value));
+    }
+
+    /*!
+     * \brief Pushes a copy of the given value, waiting while the queue is
+     *        full.
+     */
+    void push(const T& value)
+    {
+        if(!try_push(value))
+        {
+            m_not_full.wait_until([&]() { return try_push(value); });
+        }
+    }
+
+    /*!
+     * \brief Moves the given value into the queue, waiting while the queue is
+     *        full.
+     */
+    void push(T&& value)
+    {
+        if(!try_push(std::move(value)))
+        {
+            m_not_full.wait_until(
+                [&]() { return try_push(std::move(value)); }
+            );
+        }
+    }
+
+    /*!
+     * \brief Pushes up to count of the given values, claiming their positions
+     *        in the queue at once.
+     *
+     * \param first Iterator to the first value to push, values are moved from.
+     * \param count The number of values to push.
+     *
+     * \return The number of values pushed.
+     */
+    template<typename InputIterator>
+    std::size_t try_push_batch(InputIterator first, std::size_t count)
+    {
+        std::size_t position = 0;
+        count = claim(m_enqueue_pos, 0, count, position);
+        for(std::size_t i = 0; i < count; ++i, ++first)
+        {
+            Cell& cell = m_cells[(position + i) & m_mask];
+            wait_for_sequence(cell, position + i);
+            new(&cell.storage) T(std::move(*first));
+            cell.sequence.store(position + i + 1, std::memory_order_release);
+        }
+        if(count == 1)
+        {
+            m_not_empty.notify_one();
+        }
+        else if(count > 1)
+        {
+            m_not_empty.notify_all();
+        }
+        return count;
+    }
+
+    /*!
+     * \brief Pushes all of the given values, waiting while the queue is full.
+     */
+    template<typename InputIterator>
+    void push_batch(InputIterator first, std::size_t count)
+    {
+        std::size_t pushed = try_push_batch(first, count);
+        while(pushed < count)
+        {
+            m_not_full.wait_until([&]()
+            {
+                const std::size_t n =
+                    try_push_batch(std::next(first, pushed), count - pushed);
+                pushed += n;
+                return n != 0;
+            });
+        }
+    }
+
+    /*!
+     * \brief Pops the value at the front of the queue if it is not empty.
+     *
+     * \return Whether a value was popped.
+     */
+    bool try_pop(T& out_value)
+    {
+        std::size_t position = 0;
+        if(claim(m_dequeue_pos, 1, 1, position) == 0)
+        {
+            return false;
+        }
+        Cell& cell = m_cells[position & m_mask];
+        T& value = get_value(cell);
+        out_value = std::move(value);
+        value.~T();
+        cell.sequence.store(position + m_mask + 1, std::memory_order_release);
+        m_not_full.notify_one();
+        return true;
+    }
+
+    /*!
+     * \brief Pops the value at the front of the queue, waiting while the
+     *        queue is empty.
+     */
+    void pop(T& out_value)
+    {
+        if(!try_pop(out_value))
+        {
+            m_not_empty.wait_until([&]() { return try_pop(out_value); });
+        }
+    }
+
+    /*!
+     * \brief Pops up to max_count values from the front of the queue,
+     *        claiming their positions at once.
+     *
+     * \param out Output iterator the values are moved to.
+     * \param max_count The maximum number of values to pop.
+     *
+     * \return The number of values popped.
+     */
+    template<typename OutputIterator>
+    std::size_t try_pop_batch(OutputIterator out, std::size_t max_count)
+    {
+        std::size_t position = 0;
+        const std::size_t count =
+            claim(m_dequeue_pos, 1, max_count, position);
+        for(std::size_t i = 0; i < count; ++i, ++out)
+        {
+            Cell& cell = m_cells[(position + i) & m_mask];
+            wait_for_sequence(cell, position + i + 1);
+            T& value = get_value(cell);
+            *out = std::move(value);
+            value.~T();
+            cell.sequence.store(
+                position + i + m_mask + 1,
+                std::memory_order_release
+            );
+        }
+        if(count == 1)
+        {
+            m_not_full.notify_one();
+        }
+        else if(count > 1)
+        {
+            m_not_full.notify_all();
+        }
+        return count;
+    }
+
+    /*!
+     * \brief Pops up to max_count values from the front of the queue, waiting
+     *        while the queue is empty.
+     *
+     * \return The number of values popped, which is at least one.
+     */
+    template<typename OutputIterator>
+    std::size_t pop_batch(OutputIterator out, std::size_t max_count)
+    {
+        std::size_t count = try_pop_batch(out, max_count);
+        if(count == 0)
+        {
+            m_not_empty.wait_until([&]()
+            {
+                count = try_pop_batch(out, max_count);
+                return count != 0;
+            });
+        }
+        return count;
+    }
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                               PRIVATE TYPES
+    //--------------------------------------------------------------------------
+
+    struct Cell
+    {
+        // equal to the position when the cell can be written, and the position
+        // plus one when it can be read
+        std::atomic<std::size_t> sequence;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+    };
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    // read only after construction
+    const std::size_t m_mask;
+    Cell* const m_cells;
+
+    alignas(ARC_CACHE_LINE_SIZE) std::atomic<std::size_t> m_enqueue_pos;
+    alignas(ARC_CACHE_LINE_SIZE) std::atomic<std::size_t> m_dequeue_pos;
+
+    // only written when a thread blocks
+    alignas(ARC_CACHE_LINE_SIZE) Wait m_not_full;
+    Wait m_not_empty;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    static std::size_t round_capacity(std::size_t capacity)
+    {
+        std::size_t ret = 2;
+        while(ret < capacity)
+        {
+            ret <<= 1;
+        }
+        return ret;
+    }
+
+    static T& get_value(Cell& cell)
+    {
+        return *reinterpret_cast<T*>(&cell.storage);
+    }
+
+    static void wait_for_sequence(Cell& cell, std::size_t sequence)
+    {
+        while(cell.sequence.load(std::memory_order_acquire) != sequence)
+        {
+            cpu_relax();
+        }
+    }
+
+    // claims up to count consecutive positions from the given counter whose
+    // cells have the sequence position + offset (or will shortly), returns
+    // the number of positions claimed
+    std::size_t claim(
+            std::atomic<std::size_t>& counter,
+            std::size_t offset,
+            std::size_t count,
+            std::size_t& out_position)
+    {
+        if(count == 0)
+        {
+            return 0;
+        }
+
+        std::size_t position = counter.load(std::memory_order_relaxed);
+        while(true)
+        {
+            const std::size_t sequence = m_cells[position & m_mask]
+                .sequence.load(std::memory_order_acquire);
+            const std::intptr_t difference =
+                static_cast<std::intptr_t>(sequence) -
+                static_cast<std::intptr_t>(position + offset);
+            if(difference < 0)
+            {
+                // the queue is full (or empty)
+                return 0;
+            }
+            if(difference > 0)
+            {
+                // another thread claimed this position
+                position = counter.load(std::memory_order_relaxed);
+                continue;
+            }
+
+            // the first cell is ready, so find how many of the following
+            // cells are ready. The cells between the first and last ready
+            // cells have already been claimed by the other side so they will
+            // be released shortly.
+            std::size_t n = (count <= m_mask + 1) ? count : m_mask + 1;
+            while(n > 1)
+            {
+                const std::size_t last = position + n - 1;
+                if(m_cells[last & m_mask].sequence.load(
+                    std::memory_order_acquire) == last + offset)
+                {
+                    break;
+                }
+                n /= 2;
+            }
+
+            if(counter.compare_exchange_weak(
+                position,
+                position + n,
+                std::memory_order_relaxed,
+                std::memory_order_relaxed
+            ))
+            {
+                out_position = position;
+                return n;
+            }
+        }
+    }
+};
+
+} // namespace lang
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
@@ -0,0 +1,501 @@
+/*!
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "arcanecore/base/lang/ObjectPool.hpp"
+
+#include <cstring>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "arcanecore/base/Exceptions.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace lang
+{
+
+namespace
+{
+
+//------------------------------------------------------------------------------
+//                                   CONSTANTS
+//------------------------------------------------------------------------------
+
+// the value free slots are filled with in debug builds
+static const unsigned char POISON_BYTE = 0xDD;
+// whether free slots are poisoned, this is decided here rather than in the
+// header so that it matches between the library and its consumers
+#ifndef NDEBUG
+    static const bool POISON_FREE_SLOTS = true;
+#else
+    static const bool POISON_FREE_SLOTS = false;
+#endif
+
+// the largest supported log2 of the size of the first slab
+static const std::size_t MAX_SLAB_SHIFT = 16;
+
+//------------------------------------------------------------------------------
+//                                    GLOBALS
+//------------------------------------------------------------------------------
+
+// the id of the next pool to be constructed
+static std::atomic<std::uint64_t> g_next_id(1);
+
+// the pools that are currently alive, so that threads exiting can return
+// their magazines to pools that still exist. These are deliberately leaked
+// so that they outlive thread_local destructors.
+static std::mutex& get_registry_mutex()
+{
+    static std::mutex* mutex = new std::mutex();
+    return *mutex;
+}
+
+static std::unordered_map<std::uint64_t, ObjectPoolBase*>& get_registry()
+{
+    static std::unordered_map<std::uint64_t, ObjectPoolBase*>* registry =
+        new std::unordered_map<std::uint64_t, ObjectPoolBase*>();
+    return *registry;
+}
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+static std::size_t round_up(std::size_t value, std::size_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+// returns the index of the most significant set bit of a non-zero value
+static std::size_t log2_floor(std::uint64_t value)
+{
+    #if defined(__GNUC__) || defined(__clang__)
+        return 63 - static_cast<std::size_t>(__builtin_clzll(value));
+    #else
+        std::size_t result = 0;
+        while(value >>= 1)
+        {
+            ++result;
+        }
+        return result;
+    #endif
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                 PRIVATE TYPES
+//------------------------------------------------------------------------------
+
+struct ObjectPoolBase::ThreadCache
+{
+    std::vector<std::unique_ptr<CacheEntry>> entries;
+
+    ~ThreadCache()
+    {
+        s_last_entry = nullptr;
+
+        std::lock_guard<std::mutex> lock(get_registry_mutex());
+        for(const std::unique_ptr<CacheEntry>& entry : entries)
+        {
+            auto pool = get_registry().find(entry->pool_id);
+            if(pool != get_registry().end())
+            {
+                pool->second->flush(entry.get(), 0);
+            }
+        }
+    }
+
+    CacheEntry* get(ObjectPoolBase* pool)
+    {
+        for(const std::unique_ptr<CacheEntry>& entry : entries)
+        {
+            if(entry->pool_id == pool->m_id)
+            {
+                return entry.get();
+            }
+        }
+
+        // this thread is using a new pool, so take the opportunity to discard
+        // the entries of any pools that have since been destroyed
+        {
+            std::lock_guard<std::mutex> lock(get_registry_mutex());
+            std::size_t keep = 0;
+            for(std::size_t i = 0; i < entries.size(); ++i)
+            {
+                if(get_registry().count(entries[i]->pool_id) != 0)
+                {
+                    entries[keep++] = std::move(entries[i]);
+                }
+            }
+            entries.resize(keep);
+        }
+
+        std::unique_ptr<CacheEntry> entry(new CacheEntry());
+        entry->pool_id = pool->m_id;
+        entry->count = 0;
+        entries.push_back(std::move(entry));
+        return entries.back().get();
+    }
+};
+
+//------------------------------------------------------------------------------
+//                           PRIVATE STATIC ATTRIBUTES
+//------------------------------------------------------------------------------
+
+thread_local ObjectPoolBase::CacheEntry* ObjectPoolBase::s_last_entry =
+    nullptr;
+
+//------------------------------------------------------------------------------
+//                                  CONSTRUCTORS
+//------------------------------------------------------------------------------
+
+ObjectPoolBase::ObjectPoolBase(
+        std::size_t object_size,
+        std::size_t object_alignment,
+        std::size_t slab_size)
+    : m_id           (g_next_id.fetch_add(1, std::memory_order_relaxed))
+    , m_object_size  (object_size)
+    , m_poison       (POISON_FREE_SLOTS)
+    , m_header_offset(
+        round_up(object_size > 0 ? object_size : 1, alignof(SlotHeader))
+    )
+    , m_stride       (
+        round_up(
+            m_header_offset + sizeof(SlotHeader),
+            object_alignment > alignof(SlotHeader)
+                ? object_alignment
+                : alignof(SlotHeader)
+        )
+    )
+    , m_slab_shift   (
+        slab_size > 1 ? log2_floor(slab_size - 1) + 1 : 0
+    )
+    , m_slab_count   (0)
+    , m_head         (0)
+{
+    if(object_alignment == 0 ||
+       (object_alignment & (object_alignment - 1)) != 0 ||
+       object_alignment > alignof(std::max_align_t))
+    {
+        throw arc::ex::ValueError(
+            "ObjectPool alignment must be a power of two no larger than the "
+            "alignment of std::max_align_t"
+        );
+    }
+    if(m_slab_shift > MAX_SLAB_SHIFT)
+    {
+        throw arc::ex::ValueError("ObjectPool slab size is too large");
+    }
+
+    for(std::size_t i = 0; i < MAX_SLABS; ++i)
+    {
+        m_slabs[i].store(nullptr, std::memory_order_relaxed);
+    }
+
+    std::lock_guard<std::mutex> lock(get_registry_mutex());
+    get_registry()[m_id] = this;
+}
+
+//------------------------------------------------------------------------------
+//                                   DESTRUCTOR
+//------------------------------------------------------------------------------
+
+ObjectPoolBase::~ObjectPoolBase()
+{
+    {
+        std::lock_guard<std::mutex> lock(get_registry_mutex());
+        get_registry().erase(m_id);
+    }
+
+    for(std::size_t i = 0; i < m_slab_count; ++i)
+    {
+        ::operator delete(m_slabs[i].load(std::memory_order_relaxed));
+    }
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+std::size_t ObjectPoolBase::get_capacity() const
+{
+    std::lock_guard<std::mutex> lock(m_grow_mutex);
+    return ((std::size_t(1) << m_slab_count) - 1) << m_slab_shift;
+}
+
+//------------------------------------------------------------------------------
+//                            PRIVATE MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+void* ObjectPoolBase::allocate_slow()
+{
+    CacheEntry* cache = get_cache();
+    if(cache->count == 0)
+    {
+        refill(cache);
+    }
+
+    void* p = cache->magazine[--cache->count];
+    if(m_poison)
+    {
+        check_poison(p);
+    }
+    return p;
+}
+
+void ObjectPoolBase::deallocate_slow(void* p)
+{
+    if(p == nullptr)
+    {
+        return;
+    }
+
+    if(m_poison)
+    {
+        poison(p);
+    }
+
+    CacheEntry* cache = get_cache();
+    if(cache->count == MAGAZINE_SIZE)
+    {
+        flush(cache, MAGAZINE_SIZE / 2);
+    }
+    cache->magazine[cache->count++] = p;
+}
+
+ObjectPoolBase::CacheEntry* ObjectPoolBase::get_cache()
+{
+    if(s_last_entry != nullptr && s_last_entry->pool_id == m_id)
+    {
+        return s_last_entry;
+    }
+
+    static thread_local ThreadCache cache;
+    s_last_entry = cache.get(this);
+    return s_last_entry;
+}
+
+ObjectPoolBase::SlotHeader* ObjectPoolBase::get_header(
+        std::uint32_t index) const
+{
+    // slab k holds the indices [(2^k - 1) << shift, (2^(k+1) - 1) << shift)
+    const std::size_t slab =
+        log2_floor((static_cast<std::uint64_t>(index) >> m_slab_shift) + 1);
+    const std::uint64_t offset =
+        index - (((std::uint64_t(1) << slab) - 1) << m_slab_shift);
+
+    char* memory = m_slabs[slab].load(std::memory_order_acquire);
+    return reinterpret_cast<SlotHeader*>(
+        memory + offset * m_stride + m_header_offset);
+}
+
+void ObjectPoolBase::push_chain(std::uint32_t first, std::uint32_t last)
+{
+    SlotHeader* last_header = get_header(last);
+    std::uint64_t head = m_head.load(std::memory_order_relaxed);
+    std::uint64_t new_head = 0;
+    do
+    {
+        last_header->next.store(
+            static_cast<std::uint32_t>(head),
+            std::memory_order_relaxed
+        );
+        // the tag is incremented on every change so that a stale head can
+        // never be swapped in (ABA)
+        new_head = (((head >> 32) + 1) << 32) | (std::uint64_t(first) + 1);
+    }
+    while(!m_head.compare_exchange_weak(
+        head,
+        new_head,
+        std::memory_order_release,
+        std::memory_order_relaxed
+    ));
+}
+
+bool ObjectPoolBase::pop(std::uint32_t& out_index)
+{
+    std::uint64_t head = m_head.load(std::memory_order_acquire);
+    while(true)
+    {
+        const std::uint32_t first = static_cast<std::uint32_t>(head);
+        if(first == 0)
+        {
+            return false;
+        }
+
+        // slots are never returned to the system, so this is safe to read
+        // even if another thread has since popped the slot
+        const std::uint32_t next =
+            get_header(first - 1)->next.load(std::memory_order_relaxed);
+        const std::uint64_t new_head = (((head >> 32) + 1) << 32) | next;
+        if(m_head.compare_exchange_weak(
+            head,
+            new_head,
+            std::memory_order_acq_rel,
+            std::memory_order_acquire
+        ))
+        {
+            out_index = first - 1;
+            return true;
+        }
+    }
+}
+
+void ObjectPoolBase::refill(CacheEntry* cache)
+{
+    std::uint32_t index = 0;
+    while(cache->count < MAGAZINE_SIZE / 2 && pop(index))
+    {
+        cache->magazine[cache->count++] = get_slot(get_header(index));
+    }
+
+    if(cache->count == 0)
+    {
+        grow(cache);
+    }
+}
+
+void ObjectPoolBase::flush(CacheEntry* cache, std::size_t keep)
+{
+    if(cache->count <= keep)
+    {
+        return;
+    }
+
+    // the oldest slots are at the bottom of the magazine
+    const std::size_t count = cache->count - keep;
+    for(std::size_t i = 0; i + 1 < count; ++i)
+    {
+        get_header(cache->magazine[i])->next.store(
+            get_header(cache->magazine[i + 1])->index + 1,
+            std::memory_order_relaxed
+        );
+    }
+    push_chain(
+        get_header(cache->magazine[0])->index,
+        get_header(cache->magazine[count - 1])->index
+    );
+
+    std::memmove(
+        cache->magazine,
+        cache->magazine + count,
+        keep * sizeof(void*)
+    );
+    cache->count = keep;
+}
+
+void ObjectPoolBase::grow(CacheEntry* cache)
+{
+    std::lock_guard<std::mutex> lock(m_grow_mutex);
+
+    // another thread may have grown the pool while we waited for the lock
+    std::uint32_t index = 0;
+    if(pop(index))
+    {
+        cache->magazine[cache->count++] = get_slot(get_header(index));
+        return;
+    }
+
+    const std::size_t slab = m_slab_count;
+    const std::uint64_t first =
+        ((std::uint64_t(1) << slab) - 1) << m_slab_shift;
+    const std::uint64_t size = std::uint64_t(1) << (m_slab_shift + slab);
+    // indices are stored plus one in 32 bits
+    if(slab >= MAX_SLABS || first + size >= 0xFFFFFFFFULL)
+    {
+        throw std::bad_alloc();
+    }
+
+    char* memory = static_cast<char*>(
+        ::operator new(static_cast<std::size_t>(size) * m_stride));
+    for(std::uint64_t i = 0; i < size; ++i)
+    {
+        char* slot = memory + i * m_stride;
+        SlotHeader* header = new(slot + m_header_offset) SlotHeader();
+        header->next.store(0, std::memory_order_relaxed);
+        header->index = static_cast<std::uint32_t>(first + i);
+        if(m_poison)
+        {
+            poison(slot);
+        }
+    }
+    m_slabs[slab].store(memory, std::memory_order_release);
+    ++m_slab_count;
+
+    // the magazine takes the first slots, and the rest go to the global list
+    std::uint64_t next = first;
+    while(cache->count < MAGAZINE_SIZE && next < first + size)
+    {
+        cache->magazine[cache->count++] = memory + (next++ - first) * m_stride;
+    }
+    if(next < first + size)
+    {
+        for(std::uint64_t i = next; i + 1 < first + size; ++i)
+        {
+            get_header(static_cast<std::uint32_t>(i))->next.store(
+                static_cast<std::uint32_t>(i + 2),
+                std::memory_order_relaxed
+            );
+        }
+        push_chain(
+            static_cast<std::uint32_t>(next),
+            static_cast<std::uint32_t>(first + size - 1)
+        );
+    }
+}
+
+void ObjectPoolBase::poison(void* p) const
+{
+    std::memset(p, POISON_BYTE, m_object_size);
+}
+
+void ObjectPoolBase::check_poison(void* p) const
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(p);
+    for(std::size_t i = 0; i < m_object_size; ++i)
+    {
+        if(bytes[i] != POISON_BYTE)
+        {
+            throw arc::ex::StateError(
+                "ObjectPool slot was written to after it was deallocated"
+            );
+        }
+    }
+}
+
+} // namespace lang
+ARC_BASE_VERSION_NS_END
+} // namespace arc
@@ -0,0 +1,379 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Lock-free pools of fixed size objects.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_LANG_OBJECTPOOL_HPP_
+#define ARCANECORE_BASE_LANG_OBJECTPOOL_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <utility>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/lang/Restrictors.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace lang
+{
+
+/*!
+ * \brief Untyped pool of fixed size memory slots, this is the implementation
+ *        of arc::lang::ObjectPool.
+ *
+ * Slots are allocated from slabs which double in size each time the pool
+ * grows. Free slots are kept on a global lock-free free list, in front of
+ * which each thread keeps a small cache (magazine) of slots, so that most
+ * allocations and deallocations do not touch shared state at all.
+ *
+ * Memory is never returned to the system until the pool is destroyed. Slots
+ * may be deallocated on a different thread to the one that allocated them.
+ *
+ * When the library is built without NDEBUG the memory of free slots is
+ * poisoned, and allocate() will throw an arc::ex::StateError if a slot was
+ * written to after it was deallocated. This is decided by the library rather
+ * than the code including this header, so that consumers built with a
+ * different configuration agree with it.
+ */
+class ObjectPoolBase
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                              PUBLIC CONSTANTS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief The default number of slots in the first slab of a pool.
+     */
+    static const std::size_t DEFAULT_SLAB_SIZE = 64;
+
+    /*!
+     * \brief The maximum number of free slots each thread caches per pool.
+     */
+    static const std::size_t MAGAZINE_SIZE = 64;
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Constructs a new pool.
+     *
+     * \param object_size The size of each slot in bytes.
+     * \param object_alignment The alignment of each slot, this may not be
+     *                         larger than the alignment of
+     *                         ```std::max_align_t```.
+     * \param slab_size The number of slots in the first slab, this will be
+     *                  rounded up to a power of two.
+     *
+     * \throws arc::ex::ValueError If the alignment is not supported.
+     */
+    ObjectPoolBase(
+            std::size_t object_size,
+            std::size_t object_alignment,
+            std::size_t slab_size = DEFAULT_SLAB_SIZE);
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns the memory of all slots to the system.
+     *
+     * \warning No other thread may be using the pool while it is destroyed.
+     */
+    ~ObjectPoolBase();
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns an unused slot from this pool.
+     *
+     * \throws std::bad_alloc If the pool cannot grow any further.
+     */
+    void* allocate()
+    {
+        CacheEntry* cache = s_last_entry;
+        if(cache != nullptr && cache->pool_id == m_id && cache->count != 0)
+        {
+            void* p = cache->magazine[--cache->count];
+            if(m_poison)
+            {
+                check_poison(p);
+            }
+            return p;
+        }
+        return allocate_slow();
+    }
+
+    /*!
+     * \brief Returns a slot allocated by allocate() to this pool.
+     */
+    void deallocate(void* p)
+    {
+        CacheEntry* cache = s_last_entry;
+        if(p != nullptr &&
+           cache != nullptr &&
+           cache->pool_id == m_id &&
+           cache->count != MAGAZINE_SIZE)
+        {
+            if(m_poison)
+            {
+                poison(p);
+            }
+            cache->magazine[cache->count++] = p;
+            return;
+        }
+        deallocate_slow(p);
+    }
+
+    /*!
+     * \brief Returns the total number of slots this pool has allocated from
+     *        the system.
+     */
+    std::size_t get_capacity() const;
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE CONSTANTS
+    //--------------------------------------------------------------------------
+
+    // slabs double in size, so this bounds the number of indices to 2^32
+    static const std::size_t MAX_SLABS = 32;
+
+    //--------------------------------------------------------------------------
+    //                               PRIVATE TYPES
+    //--------------------------------------------------------------------------
+
+    // header stored after the object storage of each slot
+    struct SlotHeader
+    {
+        // the index of the next slot in the free list, plus one
+        std::atomic<std::uint32_t> next;
+        // the index of this slot
+        std::uint32_t index;
+    };
+
+    // the magazine of a single thread for a single pool
+    struct CacheEntry
+    {
+        std::uint64_t pool_id;
+        std::size_t count;
+        void* magazine[MAGAZINE_SIZE];
+    };
+
+    // the magazines of a single thread for all pools
+    struct ThreadCache;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE STATIC ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    // the cache entry most recently used by the current thread
+    static thread_local CacheEntry* s_last_entry;
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    // unique id of this pool which is never reused by another pool
+    const std::uint64_t m_id;
+
+    const std::size_t m_object_size;
+    // whether free slots are poisoned, as decided by the library's build
+    const bool m_poison;
+    // offset of the slot header and the distance between slots
+    const std::size_t m_header_offset;
+    const std::size_t m_stride;
+    // log2 of the number of slots in the first slab
+    const std::size_t m_slab_shift;
+
+    // the slabs of this pool, slab k holds (1 << (m_slab_shift + k)) slots
+    std::atomic<char*> m_slabs[MAX_SLABS];
+    // the number of slabs allocated so far, guarded by the grow mutex
+    std::size_t m_slab_count;
+    mutable std::mutex m_grow_mutex;
+
+    // the tag (high 32 bits) and the index plus one (low 32 bits) of the
+    // first slot in the global free list
+    std::atomic<std::uint64_t> m_head;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    // performs an allocation or deallocation that cannot be served by the
+    // current thread's most recently used magazine
+    void* allocate_slow();
+    void deallocate_slow(void* p);
+
+    // returns the current thread's cache entry for this pool
+    CacheEntry* get_cache();
+
+    // returns the header of the slot with the given index
+    SlotHeader* get_header(std::uint32_t index) const;
+
+    // returns the header of the given slot
+    SlotHeader* get_header(void* p) const
+    {
+        return reinterpret_cast<SlotHeader*>(
+            static_cast<char*>(p) + m_header_offset);
+    }
+
+    // returns the memory of the slot with the given header
+    void* get_slot(SlotHeader* header) const
+    {
+        return reinterpret_cast<char*>(header) - m_header_offset;
+    }
+
+    // pushes the chain of slots first...last, that are already linked, onto
+    // the global free list
+    void push_chain(std::uint32_t first, std::uint32_t last);
+
+    // pops a single slot from the global free list, returns false if the
+    // list is empty
+    bool pop(std::uint32_t& out_index);
+
+    // fills the given empty magazine with slots, growing the pool if needed
+    void refill(CacheEntry* cache);
+
+    // returns all but the given number of the most recently freed slots in
+    // the magazine to the global free list
+    void flush(CacheEntry* cache, std::size_t keep);
+
+    // allocates a new slab and fills the given magazine with its slots
+    void grow(CacheEntry* cache);
+
+    // poisons or checks the poison of a free slot
+    void poison(void* p) const;
+    void check_poison(void* p) const;
+};
+
+/*!
+ * \brief A lock-free pool of objects of type T.
+ *
+ * This is intended for small, frequently allocated objects whose allocation
+ * cost would otherwise be dominated by ```malloc```/```free```. Memory for
+ * objects is reused within the pool rather than being returned to the system.
+ *
+ * \code
+ * arc::lang::ObjectPool<Message> pool;
+ * Message* message = pool.create(id, payload);
+ * // ...
+ * pool.destroy(message);
+ * \endcode
+ *
+ * See arc::lang::ObjectPoolBase for details.
+ */
+template<typename T>
+class ObjectPool
+    : private ObjectPoolBase
+{
+public:
+
+    static_assert(
+        alignof(T) <= alignof(std::max_align_t),
+        "ObjectPool does not support over-aligned types"
+    );
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Constructs a new pool.
+     *
+     * \param slab_size The number of objects in the first slab of the pool.
+     */
+    explicit ObjectPool(std::size_t slab_size = DEFAULT_SLAB_SIZE)
+        : ObjectPoolBase(sizeof(T), alignof(T), slab_size)
+    {
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Constructs a new object in this pool with the given arguments.
+     */
+    template<typename... Args>
+    T* create(Args&&... args)
+    {
+        void* p = allocate();
+        try
+        {
+            return new(p) T(std::forward<Args>(args)...);
+        }
+        catch(...)
+        {
+            deallocate(p);
+            throw;
+        }
+    }
+
+    /*!
+     * \brief Destroys an object created by this pool.
+     */
+    void destroy(T* object)
+    {
+        if(object == nullptr)
+        {
+            return;
+        }
+        object->~T();
+        deallocate(object);
+    }
+
+    using ObjectPoolBase::get_capacity;
+};
+
+} // namespace lang
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
@@ -0,0 +1,655 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Sequence container that stores a small number of elements inline.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_LANG_SMALLVECTOR_HPP_
+#define ARCANECORE_BASE_LANG_SMALLVECTOR_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "arcanecore/base/BaseAPI.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace lang
+{
+
+/*!
+ * \brief A contiguous sequence container that stores up to N elements within
+ *        the object itself, and only allocates from the heap once it grows
+ *        larger than that.
+ *
+ * The interface follows ```std::vector```. Moving a SmallVector whose
+ * elements are on the heap steals the allocation, while moving one whose
+ * elements are inline moves each element.
+ *
+ * \note Unlike ```std::vector```, elements are moved when the container grows
+ *       even if their move constructor may throw.
+ *
+ * \tparam T The type of the elements.
+ * \tparam N The number of elements that can be stored inline.
+ */
+template<typename T, std::size_t N>
+class SmallVector
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                                PUBLIC TYPES
+    //--------------------------------------------------------------------------
+
+    typedef T value_type;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Constructs a new empty SmallVector.
+     */
+    SmallVector()
+        : m_data    (get_inline())
+        , m_size    (0)
+        , m_capacity(N)
+    {
+    }
+
+    /*!
+     * \brief Constructs a new SmallVector containing count copies of value.
+     */
+    SmallVector(size_type count, const T& value)
+        : SmallVector()
+    {
+        assign(count, value);
+    }
+
+    /*!
+     * \brief Constructs a new SmallVector from the given elements.
+     */
+    SmallVector(std::initializer_list<T> elements)
+        : SmallVector()
+    {
+        assign(elements.begin(), elements.end());
+    }
+
+    /*!
+     * \brief Constructs a new SmallVector from the elements in the given
+     *        iterator range.
+     */
+    template<
+        typename InputIterator,
+        typename = typename std::enable_if<!std::is_integral<
+            InputIterator
+        >::value>::type
+    >
+    SmallVector(InputIterator first, InputIterator last)
+        : SmallVector()
+    {
+        assign(first, last);
+    }
+
+    /*!
+     * \brief Copy constructor.
+     */
+    SmallVector(const SmallVector& other)
+        : SmallVector()
+    {
+        assign(other.begin(), other.end());
+    }
+
+    /*!
+     * \brief Move constructor.
+     */
+    SmallVector(SmallVector&& other)
+        : SmallVector()
+    {
+        steal(std::move(other));
+    }
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    ~SmallVector()
+    {
+        destroy_range(m_data, m_data + m_size);
+        release();
+    }
+
+    //--------------------------------------------------------------------------
+    //                                 OPERATORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Copy assignment operator.
+     */
+    SmallVector& operator=(const SmallVector& other)
+    {
+        if(this != &other)
+        {
+            assign(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    /*!
+     * \brief Move assignment operator.
+     */
+    SmallVector& operator=(SmallVector&& other)
+    {
+        if(this != &other)
+        {
+            clear();
+            steal(std::move(other));
+        }
+        return *this;
+    }
+
+    /*!
+     * \brief Replaces the contents of this SmallVector with the given
+     *        elements.
+     */
+    SmallVector& operator=(std::initializer_list<T> elements)
+    {
+        assign(elements.begin(), elements.end());
+        return *this;
+    }
+
+    /*!
+     * \brief Returns whether this SmallVector has the same elements as the
+     *        other.
+     */
+    bool operator==(const SmallVector& other) const
+    {
+        return m_size == other.m_size &&
+               std::equal(begin(), end(), other.begin());
+    }
+
+    /*!
+     * \brief Returns whether this SmallVector does not have the same elements
+     *        as the other.
+     */
+    bool operator!=(const SmallVector& other) const
+    {
+        return !((*this) == other);
+    }
+
+    /*!
+     * \brief Returns the element at the given index.
+     */
+    T& operator[](size_type index)
+    {
+        return m_data[index];
+    }
+
+    /*!
+     * \brief Returns the element at the given index.
+     */
+    const T& operator[](size_type index) const
+    {
+        return m_data[index];
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    iterator begin()
+    {
+        return m_data;
+    }
+
+    const_iterator begin() const
+    {
+        return m_data;
+    }
+
+    iterator end()
+    {
+        return m_data + m_size;
+    }
+
+    const_iterator end() const
+    {
+        return m_data + m_size;
+    }
+
+    reverse_iterator rbegin()
+    {
+        return reverse_iterator(end());
+    }
+
+    const_reverse_iterator rbegin() const
+    {
+        return const_reverse_iterator(end());
+    }
+
+    reverse_iterator rend()
+    {
+        return reverse_iterator(begin());
+    }
+
+    const_reverse_iterator rend() const
+    {
+        return const_reverse_iterator(begin());
+    }
+
+    T& front()
+    {
+        return m_data[0];
+    }
+
+    const T& front() const
+    {
+        return m_data[0];
+    }
+
+    T& back()
+    {
+        return m_data[m_size - 1];
+    }
+
+    const T& back() const
+    {
+        return m_data[m_size - 1];
+    }
+
+    T* data()
+    {
+        return m_data;
+    }
+
+    const T* data() const
+    {
+        return m_data;
+    }
+
+    /*!
+     * \brief Returns the number of elements in this SmallVector.
+     */
+    size_type size() const
+    {
+        return m_size;
+    }
+
+    /*!
+     * \brief Returns whether this SmallVector contains no elements.
+     */
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    /*!
+     * \brief Returns the number of elements this SmallVector can hold before
+     *        it must allocate.
+     */
+    size_type capacity() const
+    {
+        return m_capacity;
+    }
+
+    /*!
+     * \brief Returns whether the elements of this SmallVector are currently
+     *        stored inline.
+     */
+    bool is_inline() const
+    {
+        return m_data == get_inline();
+    }
+
+    /*!
+     * \brief Ensures this SmallVector can hold at least the given number of
+     *        elements without allocating.
+     */
+    void reserve(size_type capacity)
+    {
+        if(capacity > m_capacity)
+        {
+            reallocate(capacity);
+        }
+    }
+
+    /*!
+     * \brief Resizes this SmallVector to the given number of elements, new
+     *        elements are value initialised.
+     */
+    void resize(size_type size)
+    {
+        if(size < m_size)
+        {
+            destroy_range(m_data + size, m_data + m_size);
+            m_size = size;
+            return;
+        }
+        reserve(size);
+        for(; m_size < size; ++m_size)
+        {
+            new(m_data + m_size) T();
+        }
+    }
+
+    /*!
+     * \brief Resizes this SmallVector to the given number of elements, new
+     *        elements are copies of the given value.
+     */
+    void resize(size_type size, const T& value)
+    {
+        if(size < m_size)
+        {
+            destroy_range(m_data + size, m_data + m_size);
+            m_size = size;
+            return;
+        }
+        reserve(size);
+        for(; m_size < size; ++m_size)
+        {
+            new(m_data + m_size) T(value);
+        }
+    }
+
+    /*!
+     * \brief Replaces the contents of this SmallVector with count copies of
+     *        value.
+     */
+    void assign(size_type count, const T& value)
+    {
+        clear();
+        resize(count, value);
+    }
+
+    /*!
+     * \brief Replaces the contents of this SmallVector with the elements in
+     *        the given iterator range.
+     */
+    template<typename InputIterator>
+    void assign(InputIterator first, InputIterator last)
+    {
+        clear();
+        append(first, last);
+    }
+
+    /*!
+     * \brief Appends the elements in the given iterator range to the end of
+     *        this SmallVector.
+     */
+    template<typename InputIterator>
+    void append(InputIterator first, InputIterator last)
+    {
+        typedef typename std::iterator_traits<InputIterator>::iterator_category
+            Category;
+        if(std::is_base_of<std::forward_iterator_tag, Category>::value)
+        {
+            reserve(
+                m_size + static_cast<size_type>(std::distance(first, last))
+            );
+        }
+        for(; first != last; ++first)
+        {
+            emplace_back(*first);
+        }
+    }
+
+    /*!
+     * \brief Appends a copy of the given value.
+     */
+    void push_back(const T& value)
+    {
+        emplace_back(value);
+    }
+
+    /*!
+     * \brief Appends the given value by moving it.
+     */
+    void push_back(T&& value)
+    {
+        emplace_back(std::move(value));
+    }
+
+    /*!
+     * \brief Constructs a new element in place at the end of this SmallVector.
+     */
+    template<typename... Args>
+    T& emplace_back(Args&&... args)
+    {
+        if(m_size == m_capacity)
+        {
+            // construct first, in case the arguments refer to an element
+            T value(std::forward<Args>(args)...);
+            reallocate(grow_capacity(m_size + 1));
+            new(m_data + m_size) T(std::move(value));
+        }
+        else
+        {
+            new(m_data + m_size) T(std::forward<Args>(args)...);
+        }
+        return m_data[m_size++];
+    }
+
+    /*!
+     * \brief Removes the last element.
+     */
+    void pop_back()
+    {
+        --m_size;
+        m_data[m_size].~T();
+    }
+
+    /*!
+     * \brief Inserts a copy of the given value before the given position.
+     *
+     * \return An iterator to the inserted element.
+     */
+    iterator insert(const_iterator position, const T& value)
+    {
+        return emplace(position, value);
+    }
+
+    /*!
+     * \brief Inserts the given value before the given position by moving it.
+     *
+     * \return An iterator to the inserted element.
+     */
+    iterator insert(const_iterator position, T&& value)
+    {
+        return emplace(position, std::move(value));
+    }
+
+    /*!
+     * \brief Constructs a new element in place before the given position.
+     *
+     * \return An iterator to the inserted element.
+     */
+    template<typename... Args>
+    iterator emplace(const_iterator position, Args&&... args)
+    {
+        const size_type index = static_cast<size_type>(position - m_data);
+        emplace_back(std::forward<Args>(args)...);
+        std::rotate(m_data + index, m_data + m_size - 1, m_data + m_size);
+        return m_data + index;
+    }
+
+    /*!
+     * \brief Removes the element at the given position.
+     *
+     * \return An iterator to the element following the removed element.
+     */
+    iterator erase(const_iterator position)
+    {
+        return erase(position, position + 1);
+    }
+
+    /*!
+     * \brief Removes the elements in the given range.
+     *
+     * \return An iterator to the element following the removed elements.
+     */
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        T* const begin = m_data + (first - m_data);
+        T* const end = m_data + (last - m_data);
+        T* const new_end = std::move(end, m_data + m_size, begin);
+        destroy_range(new_end, m_data + m_size);
+        m_size = static_cast<size_type>(new_end - m_data);
+        return begin;
+    }
+
+    /*!
+     * \brief Removes all elements, the capacity is retained.
+     */
+    void clear()
+    {
+        destroy_range(m_data, m_data + m_size);
+        m_size = 0;
+    }
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                               PRIVATE TYPES
+    //--------------------------------------------------------------------------
+
+    typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type
+        Storage;
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    T* m_data;
+    size_type m_size;
+    size_type m_capacity;
+    // zero length arrays are not allowed, so there is always one element
+    Storage m_inline[N > 0 ? N : 1];
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    T* get_inline()
+    {
+        return reinterpret_cast<T*>(m_inline);
+    }
+
+    const T* get_inline() const
+    {
+        return reinterpret_cast<const T*>(m_inline);
+    }
+
+    size_type grow_capacity(size_type required) const
+    {
+        return std::max(required, m_capacity * 2);
+    }
+
+    static void destroy_range(T* first, T* last)
+    {
+        for(; first != last; ++first)
+        {
+            first->~T();
+        }
+    }
+
+    // moves the elements to a new heap allocation of the given capacity
+    void reallocate(size_type capacity)
+    {
+        T* data = static_cast<T*>(::operator new(capacity * sizeof(T)));
+        for(size_type i = 0; i < m_size; ++i)
+        {
+            new(data + i) T(std::move(m_data[i]));
+        }
+        destroy_range(m_data, m_data + m_size);
+        release();
+        m_data = data;
+        m_capacity = capacity;
+    }
+
+    // frees the heap allocation of the elements, if there is one
+    void release()
+    {
+        if(!is_inline())
+        {
+            ::operator delete(m_data);
+        }
+    }
+
+    // takes the elements of the other vector, which is left empty, this
+    // vector must be empty
+    void steal(SmallVector&& other)
+    {
+        if(other.is_inline())
+        {
+            reserve(other.m_size);
+            for(size_type i = 0; i < other.m_size; ++i)
+            {
+                new(m_data + i) T(std::move(other.m_data[i]));
+            }
+            m_size = other.m_size;
+            other.clear();
+            return;
+        }
+
+        release();
+        m_data = other.m_data;
+        m_size = other.m_size;
+        m_capacity = other.m_capacity;
+        other.m_data = other.get_inline();
+        other.m_size = 0;
+        other.m_capacity = N;
+    }
+};
+
+} // namespace lang
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
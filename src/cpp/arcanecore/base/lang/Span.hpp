@@ -0,0 +1,276 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Non-owning view of a contiguous sequence of values.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_LANG_SPAN_HPP_
+#define ARCANECORE_BASE_LANG_SPAN_HPP_
+
+#include <cstddef>
+#include <type_traits>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/Exceptions.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace lang
+{
+
+/*!
+ * \brief Non-owning view of a contiguous sequence of values, which is a
+ *        pointer and a size.
+ *
+ * This is a minimal stand-in for C++20's ```std::span``` with a dynamic
+ * extent. Spans are cheap to copy and should be passed by value, and the
+ * values they view must outlive them.
+ *
+ * \code
+ * arc::lang::Span<const char> bytes = mapped_file.view();
+ * for(char c : bytes.subspan(0, 16))
+ * {
+ *     ...
+ * }
+ * \endcode
+ *
+ * A span of non-const values converts implicitly to a span of const values.
+ */
+template<typename T>
+class Span
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                                   TYPES
+    //--------------------------------------------------------------------------
+
+    typedef T element_type;
+    typedef typename std::remove_cv<T>::type value_type;
+    typedef std::size_t size_type;
+    typedef T* pointer;
+    typedef T& reference;
+    typedef T* iterator;
+
+    //--------------------------------------------------------------------------
+    //                              PUBLIC CONSTANTS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Used as the size of subspan() to mean the rest of the span.
+     */
+    static const std::size_t npos = static_cast<std::size_t>(-1);
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Constructs an empty span.
+     */
+    Span()
+        : m_data(nullptr)
+        , m_size(0)
+    {
+    }
+
+    /*!
+     * \brief Constructs a span of the given number of values.
+     */
+    Span(T* data, std::size_t size)
+        : m_data(data)
+        , m_size(size)
+    {
+    }
+
+    /*!
+     * \brief Constructs a span of the values of the given array.
+     */
+    template<std::size_t N>
+    Span(T (&array)[N])
+        : m_data(array)
+        , m_size(N)
+    {
+    }
+
+    /*!
+     * \brief Converts a span of non-const values to a span of const values.
+     */
+    template<typename U, typename Enable = typename std::enable_if<
+        std::is_convertible<U(*)[], T(*)[]>::value
+    >::type>
+    Span(const Span<U>& other)
+        : m_data(other.data())
+        , m_size(other.size())
+    {
+    }
+
+    //--------------------------------------------------------------------------
+    //                                 OPERATORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns the value at the given index, which must be less than
+     *        size().
+     */
+    T& operator[](std::size_t index) const
+    {
+        return m_data[index];
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns a pointer to the first value.
+     */
+    T* data() const
+    {
+        return m_data;
+    }
+
+    /*!
+     * \brief Returns the number of values.
+     */
+    std::size_t size() const
+    {
+        return m_size;
+    }
+
+    /*!
+     * \brief Returns the number of bytes the values take.
+     */
+    std::size_t size_bytes() const
+    {
+        return m_size * sizeof(T);
+    }
+
+    /*!
+     * \brief Returns whether the span has no values.
+     */
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    /*!
+     * \brief Returns an iterator to the first value.
+     */
+    T* begin() const
+    {
+        return m_data;
+    }
+
+    /*!
+     * \brief Returns an iterator past the last value.
+     */
+    T* end() const
+    {
+        return m_data + m_size;
+    }
+
+    /*!
+     * \brief Returns the first value, the span must not be empty.
+     */
+    T& front() const
+    {
+        return m_data[0];
+    }
+
+    /*!
+     * \brief Returns the last value, the span must not be empty.
+     */
+    T& back() const
+    {
+        return m_data[m_size - 1];
+    }
+
+    /*!
+     * \brief Returns a span of the given number of values starting at the
+     *        given offset.
+     *
+     * The size is clamped to the end of the span.
+     *
+     * \throws arc::ex::ValueError If the offset is past the end of the span.
+     */
+    Span subspan(std::size_t offset, std::size_t size = npos) const
+    {
+        if(offset > m_size)
+        {
+            throw arc::ex::ValueError(
+                "Span::subspan() offset is past the end of the span."
+            );
+        }
+        const std::size_t remaining = m_size - offset;
+        return Span(m_data + offset, size < remaining ? size : remaining);
+    }
+
+    /*!
+     * \brief Returns a span of the first given number of values, which must be
+     *        at most size().
+     */
+    Span first(std::size_t count) const
+    {
+        return Span(m_data, count);
+    }
+
+    /*!
+     * \brief Returns a span of the last given number of values, which must be
+     *        at most size().
+     */
+    Span last(std::size_t count) const
+    {
+        return Span(m_data + (m_size - count), count);
+    }
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    T* m_data;
+    std::size_t m_size;
+};
+
+template<typename T>
+const std::size_t Span<T>::npos;
+
+} // namespace lang
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
@@ -0,0 +1,308 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Lock-free single producer single consumer queue of variable sized
+ *        records.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_LANG_SPSCBYTEQUEUE_HPP_
+#define ARCANECORE_BASE_LANG_SPSCBYTEQUEUE_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/Preproc.hpp"
+#include "arcanecore/base/lang/Restrictors.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace lang
+{
+
+/*!
+ * \brief Bounded lock-free queue for passing variable sized records of bytes
+ *        from exactly one producer thread to exactly one consumer thread.
+ *
+ * Records are written in place: the producer reserves space for a record,
+ * writes it, and commits it, so a record is never copied. Each record is
+ * preceded by a small header, and records are kept contiguous by padding to
+ * the end of the ring when a record doesn't fit before it wraps.
+ *
+ * The consumer visits every committed record in a batch and then releases
+ * them with a single update of the shared index (see consume()).
+ *
+ * Like arc::lang::SpscQueue the indices are on separate cache lines and each
+ * side caches the other side's index. This queue never blocks, waiting is left
+ * to the user.
+ */
+class SpscByteQueue
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                              PUBLIC CONSTANTS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief The alignment of the records, the sizes of records are rounded up
+     *        to a multiple of this.
+     */
+    static const std::size_t ALIGNMENT = 8;
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Constructs a new queue.
+     *
+     * \param capacity The size of the ring in bytes, this is rounded up to a
+     *                 power of two (of at least 64).
+     */
+    explicit SpscByteQueue(std::size_t capacity)
+        : m_mask       (round_capacity(capacity) - 1)
+        , m_data       (static_cast<char*>(::operator new(m_mask + 1)))
+        , m_tail       (0)
+        , m_cached_head(0)
+        , m_reserved   (0)
+        , m_head       (0)
+    {
+    }
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    ~SpscByteQueue()
+    {
+        ::operator delete(m_data);
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns the size of the ring in bytes.
+     */
+    std::size_t capacity() const
+    {
+        return m_mask + 1;
+    }
+
+    /*!
+     * \brief Returns the size of the largest record the queue can hold.
+     */
+    std::size_t get_max_size() const
+    {
+        return capacity() - HEADER_SIZE;
+    }
+
+    /*!
+     * \brief Returns whether the queue contains no records, this is only a
+     *        snapshot if other threads are using the queue.
+     */
+    bool empty() const
+    {
+        return m_head.load(std::memory_order_acquire) ==
+               m_tail.load(std::memory_order_acquire);
+    }
+
+    /*!
+     * \brief Reserves space for a record of the given size at the back of the
+     *        queue if there is room.
+     *
+     * May only be called by the producer thread. The record is not visible to
+     * the consumer until commit() is called, and only one record may be
+     * reserved at a time.
+     *
+     * \return The ALIGNMENT aligned storage of the record, or null if there is
+     *         currently not enough free space (or the record is larger than
+     *         get_max_size()).
+     */
+    char* try_reserve(std::size_t size)
+    {
+        const std::size_t needed =
+            HEADER_SIZE + ((size + ALIGNMENT - 1) & ~(ALIGNMENT - 1));
+        std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        const std::size_t contiguous = capacity() - (tail & m_mask);
+        if(needed > contiguous)
+        {
+            // pad to the end of the ring so the record starts at the beginning
+            if(needed > capacity() || !has_space(tail, contiguous))
+            {
+                return nullptr;
+            }
+            write_header(tail, contiguous | PADDING_BIT);
+            tail += contiguous;
+            m_tail.store(tail, std::memory_order_release);
+        }
+        if(!has_space(tail, needed))
+        {
+            return nullptr;
+        }
+
+        write_header(tail, needed);
+        m_reserved = needed;
+        return m_data + (tail & m_mask) + HEADER_SIZE;
+    }
+
+    /*!
+     * \brief Makes the record returned by the last call to try_reserve()
+     *        visible to the consumer.
+     *
+     * May only be called by the producer thread.
+     */
+    void commit()
+    {
+        m_tail.store(
+            m_tail.load(std::memory_order_relaxed) + m_reserved,
+            std::memory_order_release
+        );
+    }
+
+    /*!
+     * \brief Calls the given function for every record which has been
+     *        committed, in order, and then removes them from the queue.
+     *
+     * May only be called by the consumer thread.
+     *
+     * \param function Called with the data and size of each record (the size
+     *                 is rounded up to a multiple of ALIGNMENT). The data is
+     *                 only valid until this function returns.
+     *
+     * \return The number of records consumed.
+     */
+    template<typename Function>
+    std::size_t consume(Function function)
+    {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        const std::size_t tail = m_tail.load(std::memory_order_acquire);
+        std::size_t count = 0;
+        for(std::size_t position = head; position != tail;)
+        {
+            const char* record = m_data + (position & m_mask);
+            std::uint64_t header = 0;
+            std::memcpy(&header, record, HEADER_SIZE);
+            const std::size_t size =
+                static_cast<std::size_t>(header & ~PADDING_BIT);
+            if((header & PADDING_BIT) == 0)
+            {
+                function(record + HEADER_SIZE, size - HEADER_SIZE);
+                ++count;
+            }
+            position += size;
+        }
+        m_head.store(tail, std::memory_order_release);
+        return count;
+    }
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE CONSTANTS
+    //--------------------------------------------------------------------------
+
+    // the size of the header before each record, which is the size of the
+    // record including the header
+    static const std::size_t HEADER_SIZE = sizeof(std::uint64_t);
+    // marks a header which pads to the end of the ring rather than a record
+    static const std::uint64_t PADDING_BIT = 1ULL << 63;
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    // read only after construction
+    const std::size_t m_mask;
+    char* const m_data;
+
+    // written by the producer
+    std::atomic<std::size_t> m_tail;
+    std::size_t m_cached_head;
+    std::size_t m_reserved;
+    // keeps the indices on separate cache lines (padding is used rather than
+    // alignment so that queues can be heap allocated before C++17)
+    char m_padding[ARC_CACHE_LINE_SIZE - 3 * sizeof(std::size_t)];
+
+    // written by the consumer
+    std::atomic<std::size_t> m_head;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    static std::size_t round_capacity(std::size_t capacity)
+    {
+        std::size_t ret = 64;
+        while(ret < capacity)
+        {
+            ret <<= 1;
+        }
+        return ret;
+    }
+
+    // returns whether the given number of bytes are free after the given tail
+    bool has_space(std::size_t tail, std::size_t size)
+    {
+        if(tail + size - m_cached_head > capacity())
+        {
+            m_cached_head = m_head.load(std::memory_order_acquire);
+            if(tail + size - m_cached_head > capacity())
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void write_header(std::size_t tail, std::uint64_t header)
+    {
+        std::memcpy(m_data + (tail & m_mask), &header, HEADER_SIZE);
+    }
+};
+
+} // namespace lang
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
@@ -0,0 +1,425 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Bounded lock-free single producer, single consumer queue.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_LANG_SPSCQUEUE_HPP_
+#define ARCANECORE_BASE_LANG_SPSCQUEUE_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/Preproc.hpp"
+#include "arcanecore/base/lang/Restrictors.hpp"
+#include "arcanecore/base/lang/WaitStrategy.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace lang
+{
+
+/*!
+ * \brief Bounded lock-free queue for passing values from exactly one producer
+ *        thread to exactly one consumer thread.
+ *
+ * Values are stored in a power of two sized ring. The producer and consumer
+ * indices are on separate cache lines, and each side keeps a cached copy of
+ * the other side's index so that the shared index is only read when the
+ * queue appears full (or empty).
+ *
+ * The try_ functions never block. The blocking functions wait using the Wait
+ * strategy (see arc::lang::BlockingWait and arc::lang::SpinWait).
+ *
+ * \tparam T The type of the values in the queue.
+ * \tparam Wait The strategy used when blocking on a full or empty queue.
+ */
+template<typename T, typename Wait = arc::lang::BlockingWait>
+class SpscQueue
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Constructs a new queue.
+     *
+     * \param capacity The maximum number of values in the queue, this is
+     *                 rounded up to a power of two.
+     */
+    explicit SpscQueue(std::size_t capacity)
+        : m_mask       (round_capacity(capacity) - 1)
+        , m_slots      (static_cast<Slot*>(
+            ::operator new((m_mask + 1) * sizeof(Slot))
+        ))
+        , m_tail       (0)
+        , m_cached_head(0)
+        , m_head       (0)
+        , m_cached_tail(0)
+    {
+    }
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    ~SpscQueue()
+    {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        for(std::size_t i = m_head.load(std::memory_order_relaxed);
+            i != tail; ++i)
+        {
+            get_value(i).~T();
+        }
+        ::operator delete(m_slots);
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns the maximum number of values in the queue.
+     */
+    std::size_t capacity() const
+    {
+        return m_mask + 1;
+    }
+
+    /*!
+     * \brief Returns the number of values in the queue, this is only a
+     *        snapshot if other threads are using the queue.
+     */
+    std::size_t size() const
+    {
+        return m_tail.load(std::memory_order_acquire) -
+               m_head.load(std::memory_order_acquire);
+    }
+
+    /*!
+     * \brief Returns whether the queue contains no values, this is only a
+     *        snapshot if other threads are using the queue.
+     */
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    /*!
+     * \brief Constructs a value at the back of the queue if it is not full.
+     *
+     * May only be called by the producer thread.
+     *
+     * \return Whether the value was pushed.
+     */
+    template<typename... Args>
+    bool try_emplace(Args&&... args)
+    {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if(tail - m_cached_head > m_mask)
+        {
+            m_cached_head = m_head.load(std::memory_order_acquire);
+            if(tail - m_cached_head > m_mask)
+            {
+                return false;
+            }
+        }
+        new(&m_slots[tail & m_mask]) T(std::forward<Args>(args)...);
+        m_tail.store(tail + 1, std::memory_order_release);
+        m_not_empty.notify_one();
+        return true;
+    }
+
+    /*!
+     * \brief Pushes a copy of the given value if the queue is not full.
+     */
+    bool try_push(const T& value)
+    {
+        return try_emplace(value);
+    }
+
+    /*!
+     * \brief Moves the given value into the queue if it is not full, the
+     *        value is unchanged if it could not be pushed.
+     */
+    bool try_push(T&& value)
+    {
+        return try_emplace(std::move(value));
+    }
+
+    /*!
+     * \brief Pushes a copy of the given value, waiting while the queue is
+     *        full.
+     */
+    void push(const T& value)
+    {
+        if(!try_push(value))
+        {
+            m_not_full.wait_until([&]() { return try_push(value); });
+        }
+    }
+
+    /*!
+     * \brief Moves the given value into the queue, waiting while the queue is
+     *        full.
+     */
+    void push(T&& value)
+    {
+        if(!try_push(std::move(value)))
+        {
+            m_not_full.wait_until(
+                [&]() { return try_push(std::move(value)); }
+            );
+        }
+    }
+
+    /*!
+     * \brief Pushes as many of the given values as fit in the queue, with a
+     *        single update of the shared index.
+     *
+     * May only be called by the producer thread.
+     *
+     * \param first Iterator to the first value to push, values are moved from.
+     * \param count The number of values to push.
+     *
+     * \return The number of values pushed.
+     */
+    template<typename InputIterator>
+    std::size_t try_push_batch(InputIterator first, std::size_t count)
+    {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        std::size_t free = m_mask + 1 - (tail - m_cached_head);
+        if(free < count)
+        {
+            m_cached_head = m_head.load(std::memory_order_acquire);
+            free = m_mask + 1 - (tail - m_cached_head);
+        }
+        if(count > free)
+        {
+            count = free;
+        }
+        if(count == 0)
+        {
+            return 0;
+        }
+
+        for(std::size_t i = 0; i < count; ++i, ++first)
+        {
+            new(&m_slots[(tail + i) & m_mask]) T(std::move(*first));
+        }
+        m_tail.store(tail + count, std::memory_order_release);
+        m_not_empty.notify_one();
+        return count;
+    }
+
+    /*!
+     * \brief Pushes all of the given values, waiting while the queue is full.
+     */
+    template<typename InputIterator>
+    void push_batch(InputIterator first, std::size_t count)
+    {
+        std::size_t pushed = try_push_batch(first, count);
+        while(pushed < count)
+        {
+            m_not_full.wait_until([&]()
+            {
+                const std::size_t n =
+                    try_push_batch(std::next(first, pushed), count - pushed);
+                pushed += n;
+                return n != 0;
+            });
+        }
+    }
+
+    /*!
+     * \brief Pops the value at the front of the queue if it is not empty.
+     *
+     * May only be called by the consumer thread.
+     *
+     * \return Whether a value was popped.
+     */
+    bool try_pop(T& out_value)
+    {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        if(head == m_cached_tail)
+        {
+            m_cached_tail = m_tail.load(std::memory_order_acquire);
+            if(head == m_cached_tail)
+            {
+                return false;
+            }
+        }
+        T& value = get_value(head);
+        out_value = std::move(value);
+        value.~T();
+        m_head.store(head + 1, std::memory_order_release);
+        m_not_full.notify_one();
+        return true;
+    }
+
+    /*!
+     * \brief Pops the value at the front of the queue, waiting while the
+     *        queue is empty.
+     */
+    void pop(T& out_value)
+    {
+        if(!try_pop(out_value))
+        {
+            m_not_empty.wait_until([&]() { return try_pop(out_value); });
+        }
+    }
+
+    /*!
+     * \brief Pops up to max_count values from the front of the queue, with a
+     *        single update of the shared index.
+     *
+     * May only be called by the consumer thread.
+     *
+     * \param out Output iterator the values are moved to.
+     * \param max_count The maximum number of values to pop.
+     *
+     * \return The number of values popped.
+     */
+    template<typename OutputIterator>
+    std::size_t try_pop_batch(OutputIterator out, std::size_t max_count)
+    {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        std::size_t available = m_cached_tail - head;
+        if(available < max_count)
+        {
+            m_cached_tail = m_tail.load(std::memory_order_acquire);
+            available = m_cached_tail - head;
+        }
+        const std::size_t count =
+            (available < max_count) ? available : max_count;
+        if(count == 0)
+        {
+            return 0;
+        }
+
+        for(std::size_t i = 0; i < count; ++i, ++out)
+        {
+            T& value = get_value(head + i);
+            *out = std::move(value);
+            value.~T();
+        }
+        m_head.store(head + count, std::memory_order_release);
+        m_not_full.notify_one();
+        return count;
+    }
+
+    /*!
+     * \brief Pops up to max_count values from the front of the queue, waiting
+     *        while the queue is empty.
+     *
+     * \return The number of values popped, which is at least one.
+     */
+    template<typename OutputIterator>
+    std::size_t pop_batch(OutputIterator out, std::size_t max_count)
+    {
+        std::size_t count = try_pop_batch(out, max_count);
+        if(count == 0)
+        {
+            m_not_empty.wait_until([&]()
+            {
+                count = try_pop_batch(out, max_count);
+                return count != 0;
+            });
+        }
+        return count;
+    }
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                               PRIVATE TYPES
+    //--------------------------------------------------------------------------
+
+    typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type Slot;
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    // read only after construction
+    const std::size_t m_mask;
+    Slot* const m_slots;
+
+    // written by the producer
+    alignas(ARC_CACHE_LINE_SIZE) std::atomic<std::size_t> m_tail;
+    std::size_t m_cached_head;
+
+    // written by the consumer
+    alignas(ARC_CACHE_LINE_SIZE) std::atomic<std::size_t> m_head;
+    std::size_t m_cached_tail;
+
+    // only written when a thread blocks
+    alignas(ARC_CACHE_LINE_SIZE) Wait m_not_full;
+    Wait m_not_empty;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    static std::size_t round_capacity(std::size_t capacity)
+    {
+        std::size_t ret = 1;
+        while(ret < capacity)
+        {
+            ret <<= 1;
+        }
+        return ret;
+    }
+
+    T& get_value(std::size_t index)
+    {
+        return *reinterpret_cast<T*>(&m_slots[index & m_mask]);
+    }
+};
+
+} // namespace lang
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
@@ -0,0 +1,113 @@
+/*!
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "arcanecore/base/lang/StringBuilder.hpp"
+
+#include "arcanecore/base/fmt/Number.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace lang
+{
+
+//------------------------------------------------------------------------------
+//                                PUBLIC CONSTANTS
+//------------------------------------------------------------------------------
+
+const std::size_t StringBuilder::INLINE_CAPACITY;
+
+//------------------------------------------------------------------------------
+//                            PUBLIC MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+StringBuilder& StringBuilder::append(const deus::UnicodeView& s)
+{
+    deus::UnicodeStorage converted;
+    const deus::UnicodeView& utf8 = s.convert_if_not(
+        deus::ASCII_COMPATIBLE_ENCODINGS,
+        deus::Encoding::kUTF8,
+        converted
+    );
+    return append(utf8.c_str());
+}
+
+StringBuilder& StringBuilder::append(float value)
+{
+    char buffer[arc::fmt::MAX_SHORTEST_CHARS];
+    return append(buffer, arc::fmt::write_shortest(buffer, value));
+}
+
+StringBuilder& StringBuilder::append(double value)
+{
+    char buffer[arc::fmt::MAX_SHORTEST_CHARS];
+    return append(buffer, arc::fmt::write_shortest(buffer, value));
+}
+
+//------------------------------------------------------------------------------
+//                            PRIVATE MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+void StringBuilder::grow(std::size_t required)
+{
+    std::size_t capacity = (m_capacity + 1) * 2 - 1;
+    if(capacity < required)
+    {
+        capacity = required;
+    }
+
+    char* data = new char[capacity + 1];
+    std::memcpy(data, m_data, m_size);
+    if(m_data != m_inline)
+    {
+        delete[] m_data;
+    }
+    m_data = data;
+    m_capacity = capacity;
+}
+
+StringBuilder& StringBuilder::append_signed(long long value)
+{
+    char buffer[arc::fmt::MAX_INTEGER_CHARS];
+    return append(buffer, arc::fmt::write_signed(buffer, value));
+}
+
+StringBuilder& StringBuilder::append_unsigned(unsigned long long value)
+{
+    char buffer[arc::fmt::MAX_INTEGER_CHARS];
+    return append(buffer, arc::fmt::write_unsigned(buffer, value));
+}
+
+} // namespace lang
+ARC_BASE_VERSION_NS_END
+} // namespace arc
@@ -0,0 +1,377 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Builds strings from many pieces in a single growing buffer.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_LANG_STRINGBUILDER_HPP_
+#define ARCANECORE_BASE_LANG_STRINGBUILDER_HPP_
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#include <deus/UnicodeStorage.hpp>
+#include <deus/UnicodeView.hpp>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/lang/Restrictors.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace lang
+{
+
+/*!
+ * \brief Assembles a UTF-8 string from views, integers and floating point
+ *        numbers in a single buffer.
+ *
+ * Short strings are built within the object itself, and longer strings in a
+ * heap buffer whose capacity doubles as it fills, so building a string from n
+ * bytes of pieces copies O(n) bytes. This is unlike chaining
+ * ```deus::UnicodeStorage``` or ```std::string``` ```operator+```, which
+ * allocates and copies the whole string for every piece. The string is only
+ * copied out once it is complete.
+ *
+ * \code
+ * arc::lang::StringBuilder message;
+ * message << "Flag (" << flag.get_long_key() << ") expects " << count
+ *         << " values.";
+ * throw arc::ex::ValueError(message.c_str());
+ * \endcode
+ *
+ * Numbers are written without a locale: integers in decimal, and floating
+ * point numbers with the fewest significant digits which parse back to the
+ * same value (see arc::fmt::write_shortest()). Use arc::fmt::format_to() to
+ * control how they are written.
+ */
+class StringBuilder
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                              PUBLIC CONSTANTS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief The number of bytes (including the null terminator) that are
+     *        stored within the object before a heap buffer is used.
+     */
+    static const std::size_t INLINE_CAPACITY = 256;
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Constructs a new empty StringBuilder.
+     */
+    StringBuilder()
+        : m_data    (m_inline)
+        , m_size    (0)
+        , m_capacity(INLINE_CAPACITY - 1)
+    {
+    }
+
+    /*!
+     * \brief Constructs a new empty StringBuilder with room for the given
+     *        number of bytes.
+     */
+    explicit StringBuilder(std::size_t capacity)
+        : StringBuilder()
+    {
+        reserve(capacity);
+    }
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    ~StringBuilder()
+    {
+        if(m_data != m_inline)
+        {
+            delete[] m_data;
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    //                                 OPERATORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Appends the given value using the matching append() overload.
+     */
+    template<typename T>
+    StringBuilder& operator<<(const T& value)
+    {
+        return append(value);
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns the number of bytes in the string.
+     */
+    std::size_t size() const
+    {
+        return m_size;
+    }
+
+    /*!
+     * \brief Returns whether the string is empty.
+     */
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    /*!
+     * \brief Returns the number of bytes the string can hold before the buffer
+     *        needs to grow.
+     */
+    std::size_t capacity() const
+    {
+        return m_capacity;
+    }
+
+    /*!
+     * \brief Returns the bytes of the string, which are not null terminated.
+     *
+     * \note This is invalidated by any function which appends to the builder.
+     */
+    const char* data() const
+    {
+        return m_data;
+    }
+
+    /*!
+     * \brief Returns the string as a null terminated UTF-8 string.
+     *
+     * \note This is invalidated by any function which appends to the builder.
+     */
+    const char* c_str() const
+    {
+        // there is always room for the terminator
+        m_data[m_size] = '\0';
+        return m_data;
+    }
+
+    /*!
+     * \brief Returns a view of the string, without copying it.
+     *
+     * \note This is invalidated by any function which appends to the builder.
+     */
+    deus::UnicodeView get_view() const
+    {
+        return deus::UnicodeView(c_str(), m_size, deus::Encoding::kUTF8);
+    }
+
+    /*!
+     * \brief Returns a copy of the string as a std::string.
+     */
+    std::string to_string() const
+    {
+        return std::string(m_data, m_size);
+    }
+
+    /*!
+     * \brief Returns a copy of the string as a deus::UnicodeStorage.
+     */
+    deus::UnicodeStorage to_unicode() const
+    {
+        return deus::UnicodeStorage(get_view());
+    }
+
+    /*!
+     * \brief Makes the string empty, keeping the current buffer.
+     */
+    void clear()
+    {
+        m_size = 0;
+    }
+
+    /*!
+     * \brief Ensures the string can hold at least the given number of bytes
+     *        without the buffer growing.
+     */
+    void reserve(std::size_t capacity)
+    {
+        if(capacity > m_capacity)
+        {
+            grow(capacity);
+        }
+    }
+
+    /*!
+     * \brief Appends the given bytes.
+     */
+    StringBuilder& append(const char* data, std::size_t size)
+    {
+        if(size > m_capacity - m_size)
+        {
+            grow(m_size + size);
+        }
+        std::memcpy(m_data + m_size, data, size);
+        m_size += size;
+        return *this;
+    }
+
+    /*!
+     * \brief Appends the given null terminated string.
+     */
+    StringBuilder& append(const char* s)
+    {
+        return append(s, std::strlen(s));
+    }
+
+    /*!
+     * \brief Appends the given string.
+     */
+    StringBuilder& append(const std::string& s)
+    {
+        return append(s.data(), s.size());
+    }
+
+    /*!
+     * \brief Appends the given string, converting it to UTF-8 if it is not in
+     *        an ASCII compatible encoding.
+     */
+    StringBuilder& append(const deus::UnicodeView& s);
+
+    /*!
+     * \brief Appends the given character.
+     */
+    StringBuilder& append(char c)
+    {
+        if(m_size == m_capacity)
+        {
+            grow(m_size + 1);
+        }
+        m_data[m_size++] = c;
+        return *this;
+    }
+
+    /*!
+     * \brief Appends the given character the given number of times.
+     */
+    StringBuilder& append(std::size_t count, char c)
+    {
+        if(count > m_capacity - m_size)
+        {
+            grow(m_size + count);
+        }
+        std::memset(m_data + m_size, c, count);
+        m_size += count;
+        return *this;
+    }
+
+    /*!
+     * \brief Appends "true" or "false".
+     */
+    StringBuilder& append(bool value)
+    {
+        return value ? append("true", 4) : append("false", 5);
+    }
+
+    /*!
+     * \brief Appends the given integer in decimal.
+     */
+    template<typename T>
+    typename std::enable_if<
+        std::is_integral<T>::value &&
+        !std::is_same<T, bool>::value &&
+        !std::is_same<T, char>::value,
+        StringBuilder&
+    >::type append(T value)
+    {
+        if(std::is_signed<T>::value)
+        {
+            return append_signed(static_cast<long long>(value));
+        }
+        return append_unsigned(static_cast<unsigned long long>(value));
+    }
+
+    /*!
+     * \brief Appends the shortest decimal representation of the given number
+     *        which parses back to the same float.
+     */
+    StringBuilder& append(float value);
+
+    /*!
+     * \brief Appends the shortest decimal representation of the given number
+     *        which parses back to the same double.
+     */
+    StringBuilder& append(double value);
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    // the buffer, which is either m_inline or a heap allocation of
+    // m_capacity + 1 bytes
+    char* m_data;
+    // the number of bytes in the string
+    std::size_t m_size;
+    // the number of bytes the buffer can hold, excluding the terminator
+    std::size_t m_capacity;
+    // the buffer of short strings
+    char m_inline[INLINE_CAPACITY];
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    // grows the buffer to hold at least the given number of bytes
+    void grow(std::size_t required);
+
+    // appends the given integer in decimal
+    StringBuilder& append_signed(long long value);
+    StringBuilder& append_unsigned(unsigned long long value);
+};
+
+} // namespace lang
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
@@ -0,0 +1,251 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Strategies for threads waiting on a condition to become true.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_LANG_WAITSTRATEGY_HPP_
+#define ARCANECORE_BASE_LANG_WAITSTRATEGY_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/Preproc.hpp"
+#include "arcanecore/base/lang/Futex.hpp"
+#include "arcanecore/base/lang/Restrictors.hpp"
+
+#ifdef ARC_SIMD_SSE2
+    #include <emmintrin.h>
+#endif
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace lang
+{
+
+/*!
+ * \brief Hints to the processor that the calling thread is busy waiting.
+ */
+inline void cpu_relax()
+{
+    #if defined(ARC_SIMD_SSE2)
+        _mm_pause();
+    #elif defined(__aarch64__) || defined(__arm__)
+        __asm__ __volatile__("yield");
+    #endif
+}
+
+/*!
+ * \brief Wait strategy which busy waits, never putting the waiting thread to
+ *        sleep.
+ *
+ * This gives the lowest latency, but waiting threads consume a whole core, so
+ * it should only be used when there is a core for every waiting thread.
+ *
+ * A wait strategy is used by calling wait_until() with a predicate which
+ * attempts the operation being waited for, and by calling notify_one() or
+ * notify_all() after changing the state the predicate depends on.
+ */
+class SpinWait
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Waits until the given predicate returns true.
+     */
+    template<typename Predicate>
+    void wait_until(Predicate predicate)
+    {
+        std::size_t spins = 0;
+        while(!predicate())
+        {
+            cpu_relax();
+            // give other threads a chance if the system is oversubscribed
+            if(++spins % 1024 == 0)
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    /*!
+     * \brief Does nothing since waiting threads never sleep.
+     */
+    void notify_one()
+    {
+    }
+
+    /*!
+     * \brief Does nothing since waiting threads never sleep.
+     */
+    void notify_all()
+    {
+    }
+};
+
+/*!
+ * \brief Wait strategy which busy waits briefly before putting the waiting
+ *        thread to sleep until it is notified.
+ *
+ * Notifying is only a fence and a load when no threads are sleeping.
+ */
+class BlockingWait
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                              PUBLIC CONSTANTS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief The number of times the predicate is retried before sleeping.
+     */
+    static const std::size_t SPIN_COUNT = 128;
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    BlockingWait()
+        : m_epoch  (0)
+        , m_waiters(0)
+    {
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Waits until the given predicate returns true.
+     */
+    template<typename Predicate>
+    void wait_until(Predicate predicate)
+    {
+        for(std::size_t i = 0; i < SPIN_COUNT; ++i)
+        {
+            if(predicate())
+            {
+                return;
+            }
+            cpu_relax();
+        }
+
+        while(true)
+        {
+            // the waiter count must be visible before the predicate is
+            // checked, so that a notifier either sees the waiter or the
+            // waiter sees the notifier's change
+            m_waiters.fetch_add(1, std::memory_order_seq_cst);
+            const std::uint32_t epoch = m_epoch.load(std::memory_order_seq_cst);
+            if(predicate())
+            {
+                m_waiters.fetch_sub(1, std::memory_order_relaxed);
+                return;
+            }
+            futex_wait(&m_epoch, epoch);
+            m_waiters.fetch_sub(1, std::memory_order_relaxed);
+            if(predicate())
+            {
+                return;
+            }
+        }
+    }
+
+    /*!
+     * \brief Wakes one thread sleeping in wait_until().
+     */
+    void notify_one()
+    {
+        if(has_waiters())
+        {
+            m_epoch.fetch_add(1, std::memory_order_seq_cst);
+            futex_wake_one(&m_epoch);
+        }
+    }
+
+    /*!
+     * \brief Wakes all threads sleeping in wait_until().
+     */
+    void notify_all()
+    {
+        if(has_waiters())
+        {
+            m_epoch.fetch_add(1, std::memory_order_seq_cst);
+            futex_wake_all(&m_epoch);
+        }
+    }
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    // incremented by every notification that wakes threads
+    std::atomic<std::uint32_t> m_epoch;
+    // the number of threads that may be sleeping
+    std::atomic<std::uint32_t> m_waiters;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    bool has_waiters() const
+    {
+        // orders the notifier's change to the state before this load
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return m_waiters.load(std::memory_order_relaxed) != 0;
+    }
+};
+
+} // namespace lang
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
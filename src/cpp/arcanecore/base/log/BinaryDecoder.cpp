@@ -0,0 +1,399 @@
+/*!
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "arcanecore/base/log/BinaryDecoder.hpp"
+
+#include <cstring>
+#include <limits>
+
+#include "arcanecore/base/Exceptions.hpp"
+#include "arcanecore/base/log/BinaryFormat.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace log
+{
+
+//------------------------------------------------------------------------------
+//                                DECODED MESSAGE
+//------------------------------------------------------------------------------
+
+void DecodedMessage::format_to(arc::lang::StringBuilder& out) const
+{
+    arc::fmt::detail::vformat_to(out, format, format_length, args);
+}
+
+//------------------------------------------------------------------------------
+//                                  CONSTRUCTOR
+//------------------------------------------------------------------------------
+
+BinaryDecoder::BinaryDecoder(std::FILE* file)
+    : m_file          (file)
+    , m_from          (0)
+    , m_to            (std::numeric_limits<arc::clock::TimeInt>::max())
+    , m_skipped_blocks(0)
+    , m_started       (false)
+    , m_position      (0)
+    , m_in_messages   (false)
+    , m_previous_time (0)
+{
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+void BinaryDecoder::set_time_range(
+        arc::clock::TimeInt from,
+        arc::clock::TimeInt to)
+{
+    m_from = from;
+    m_to = to;
+}
+
+bool BinaryDecoder::next(DecodedMessage& out_message)
+{
+    while(true)
+    {
+        while(m_in_messages && m_position < m_block.size())
+        {
+            if(read_message(out_message))
+            {
+                return true;
+            }
+        }
+        if(!read_block())
+        {
+            return false;
+        }
+    }
+}
+
+std::size_t BinaryDecoder::get_skipped_block_count() const
+{
+    return m_skipped_blocks;
+}
+
+//------------------------------------------------------------------------------
+//                            PRIVATE MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+bool BinaryDecoder::read_block()
+{
+    m_in_messages = false;
+
+    char header[binary::BLOCK_HEADER_SIZE];
+    const std::size_t header_size =
+        std::fread(header, 1, sizeof(header), m_file);
+    if(header_size != sizeof(header))
+    {
+        if(std::ferror(m_file))
+        {
+            throw arc::ex::RuntimeError("Failed to read the binary log.");
+        }
+        if(header_size != 0)
+        {
+            throw arc::ex::ValueError(
+                "The binary log ends part way through a block header."
+            );
+        }
+        return false;
+    }
+
+    const unsigned char type = static_cast<unsigned char>(header[0]);
+    std::uint32_t size = 0;
+    for(std::size_t i = 0; i < 4; ++i)
+    {
+        size |= static_cast<std::uint32_t>(
+            static_cast<unsigned char>(header[1 + i])
+        ) << (i * 8);
+    }
+    const arc::clock::TimeInt min_time = binary::load_u64(header + 5);
+    const arc::clock::TimeInt max_time = binary::load_u64(header + 13);
+
+    if(!m_started &&
+       type != static_cast<unsigned char>(binary::BlockType::kStart))
+    {
+        throw arc::ex::ValueError(
+            "The file is not a binary log: it does not begin with a start "
+            "block."
+        );
+    }
+
+    // seek past messages outside of the range, and blocks of unknown types
+    // which must have been written by a later version
+    const bool is_messages =
+        type == static_cast<unsigned char>(binary::BlockType::kMessages);
+    if((is_messages && (max_time < m_from || min_time > m_to)) ||
+       type < static_cast<unsigned char>(binary::BlockType::kStart) ||
+       type > static_cast<unsigned char>(binary::BlockType::kMessages))
+    {
+        if(std::fseek(m_file, static_cast<long>(size), SEEK_CUR) != 0)
+        {
+            throw arc::ex::RuntimeError("Failed to seek in the binary log.");
+        }
+        if(is_messages)
+        {
+            ++m_skipped_blocks;
+        }
+        return true;
+    }
+
+    m_block.resize(size);
+    m_position = 0;
+    if(size != 0 && std::fread(m_block.data(), 1, size, m_file) != size)
+    {
+        if(std::ferror(m_file))
+        {
+            throw arc::ex::RuntimeError("Failed to read the binary log.");
+        }
+        throw arc::ex::ValueError(
+            "The binary log ends part way through a block."
+        );
+    }
+
+    switch(static_cast<binary::BlockType>(type))
+    {
+        case binary::BlockType::kStart:
+        {
+            if(size < binary::MAGIC_SIZE + 1 ||
+               std::memcmp(m_block.data(), binary::MAGIC, binary::MAGIC_SIZE)
+                    != 0)
+            {
+                throw arc::ex::ValueError(
+                    "The file is not a binary log: the start block is invalid."
+                );
+            }
+            if(static_cast<unsigned char>(m_block[binary::MAGIC_SIZE]) >
+               binary::VERSION)
+            {
+                throw arc::ex::ValueError(
+                    "The binary log was written by a later version."
+                );
+            }
+            m_started = true;
+            m_sites.clear();
+            break;
+        }
+        case binary::BlockType::kSites:
+        {
+            read_sites();
+            break;
+        }
+        case binary::BlockType::kMessages:
+        {
+            m_previous_time = binary::load_u64(read_bytes(8));
+            m_in_messages = true;
+            break;
+        }
+    }
+    return true;
+}
+
+void BinaryDecoder::read_sites()
+{
+    while(m_position < m_block.size())
+    {
+        if(read_varint() != m_sites.size())
+        {
+            throw arc::ex::ValueError(
+                "The binary log defines a site out of order."
+            );
+        }
+
+        Site site;
+        const unsigned char level =
+            static_cast<unsigned char>(*read_bytes(1));
+        if(level > static_cast<unsigned char>(Level::kError))
+        {
+            throw arc::ex::ValueError("The binary log has an invalid level.");
+        }
+        site.level = static_cast<Level>(level);
+
+        std::size_t size = static_cast<std::size_t>(read_varint());
+        site.format.assign(read_bytes(size), size);
+        size = static_cast<std::size_t>(read_varint());
+        site.file.assign(read_bytes(size), size);
+        site.line = static_cast<unsigned>(read_varint());
+
+        const std::size_t count = static_cast<std::size_t>(read_varint());
+        const char* kinds = read_bytes(count);
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            arc::fmt::detail::Kind kind =
+                static_cast<arc::fmt::detail::Kind>(kinds[i]);
+            if(kind <= arc::fmt::detail::Kind::kNone ||
+               kind > arc::fmt::detail::Kind::kPointer)
+            {
+                throw arc::ex::ValueError(
+                    "The binary log has an argument of an invalid kind."
+                );
+            }
+            // unicode is stored as UTF-8
+            if(kind == arc::fmt::detail::Kind::kUnicode)
+            {
+                kind = arc::fmt::detail::Kind::kString;
+            }
+            site.kinds.push_back(kind);
+        }
+
+        // the messages are formatted without being checked
+        arc::fmt::detail::check_format(
+            site.format.data(),
+            site.format.size(),
+            site.kinds.data(),
+            site.kinds.size()
+        );
+        m_sites.push_back(site);
+    }
+}
+
+bool BinaryDecoder::read_message(DecodedMessage& out_message)
+{
+    const std::uint64_t id = read_varint();
+    if(id >= m_sites.size())
+    {
+        throw arc::ex::ValueError(
+            "The binary log has a message of an undefined site."
+        );
+    }
+    const Site& site = m_sites[static_cast<std::size_t>(id)];
+
+    const arc::clock::TimeInt time = m_previous_time + static_cast<
+        arc::clock::TimeInt
+    >(binary::zigzag_decode(read_varint()));
+    m_previous_time = time;
+
+    m_args.clear();
+    for(arc::fmt::detail::Kind kind : site.kinds)
+    {
+        arc::fmt::detail::Arg arg;
+        arg.kind = kind;
+        switch(kind)
+        {
+            case arc::fmt::detail::Kind::kSigned:
+            {
+                arg.value.i = binary::zigzag_decode(read_varint());
+                break;
+            }
+            case arc::fmt::detail::Kind::kUnsigned:
+            {
+                arg.value.u = read_varint();
+                break;
+            }
+            case arc::fmt::detail::Kind::kPointer:
+            {
+                arg.value.p = reinterpret_cast<const void*>(
+                    static_cast<std::uintptr_t>(read_varint())
+                );
+                break;
+            }
+            case arc::fmt::detail::Kind::kBool:
+            {
+                arg.value.b = *read_bytes(1) != 0;
+                break;
+            }
+            case arc::fmt::detail::Kind::kChar:
+            {
+                arg.value.c = *read_bytes(1);
+                break;
+            }
+            case arc::fmt::detail::Kind::kFloat:
+            {
+                std::memcpy(&arg.value.f, read_bytes(sizeof(float)), 4);
+                break;
+            }
+            case arc::fmt::detail::Kind::kDouble:
+            {
+                std::memcpy(&arg.value.d, read_bytes(sizeof(double)), 8);
+                break;
+            }
+            default:
+            {
+                arg.value.s.size = static_cast<std::size_t>(read_varint());
+                arg.value.s.data = read_bytes(arg.value.s.size);
+                break;
+            }
+        }
+        m_args.push_back(arg);
+    }
+    m_args.push_back(arc::fmt::detail::Arg());
+
+    if(time < m_from || time > m_to)
+    {
+        return false;
+    }
+
+    out_message.time = time;
+    out_message.level = site.level;
+    out_message.format = site.format.data();
+    out_message.format_length = site.format.size();
+    out_message.file = site.file.c_str();
+    out_message.line = site.line;
+    out_message.args = m_args.data();
+    out_message.arg_count = site.kinds.size();
+    return true;
+}
+
+const char* BinaryDecoder::read_bytes(std::size_t size)
+{
+    if(size > m_block.size() - m_position)
+    {
+        throw arc::ex::ValueError(
+            "The binary log has a block which ends part way through a value."
+        );
+    }
+    const char* ret = m_block.data() + m_position;
+    m_position += size;
+    return ret;
+}
+
+std::uint64_t BinaryDecoder::read_varint()
+{
+    std::uint64_t ret = 0;
+    for(unsigned shift = 0; shift < 64; shift += 7)
+    {
+        const unsigned char byte = static_cast<unsigned char>(*read_bytes(1));
+        ret |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if((byte & 0x80) == 0)
+        {
+            return ret;
+        }
+    }
+    throw arc::ex::ValueError("The binary log has a varint which is too long.");
+}
+
+} // namespace log
+ARC_BASE_VERSION_NS_END
+} // namespace arc
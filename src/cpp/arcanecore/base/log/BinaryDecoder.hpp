@@ -0,0 +1,239 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Decodes the messages of binary log files.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_LOG_BINARYDECODER_HPP_
+#define ARCANECORE_BASE_LOG_BINARYDECODER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/clock/ClockDefinitions.hpp"
+#include "arcanecore/base/fmt/Format.hpp"
+#include "arcanecore/base/lang/Restrictors.hpp"
+#include "arcanecore/base/lang/StringBuilder.hpp"
+#include "arcanecore/base/log/Logger.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace log
+{
+
+/*!
+ * \brief A message read from a binary log.
+ *
+ * The pointers of a message are only valid until the next message is read
+ * from its arc::log::BinaryDecoder.
+ */
+struct DecodedMessage
+{
+    /*!
+     * \brief The time the message was logged in nanoseconds since Linux
+     *        Epoch.
+     */
+    arc::clock::TimeInt time;
+    /*!
+     * \brief The level the message was logged at.
+     */
+    Level level;
+    /*!
+     * \brief The format string of the message, which is not null terminated.
+     */
+    const char* format;
+    /*!
+     * \brief The length of the format string in bytes.
+     */
+    std::size_t format_length;
+    /*!
+     * \brief The source file the message was logged from.
+     */
+    const char* file;
+    /*!
+     * \brief The line the message was logged from.
+     */
+    unsigned line;
+    /*!
+     * \brief The arguments of the message.
+     */
+    const arc::fmt::detail::Arg* args;
+    /*!
+     * \brief The number of arguments of the message.
+     */
+    std::size_t arg_count;
+
+    /*!
+     * \brief Appends the formatted text of the message to the given builder.
+     */
+    void format_to(arc::lang::StringBuilder& out) const;
+};
+
+/*!
+ * \brief Reads the messages of a binary log (see arc::log::binary) in the
+ *        order they were written.
+ *
+ * When a time range is set, blocks of messages which are entirely outside of
+ * the range are skipped by seeking past them, using only their headers, so
+ * reading a short range of a long log only reads a small part of the file.
+ *
+ * \code
+ * std::FILE* file = std::fopen("app.arclog", "rb");
+ * arc::log::BinaryDecoder decoder(file);
+ * decoder.set_time_range(from, to);
+ *
+ * arc::log::DecodedMessage message;
+ * arc::lang::StringBuilder text;
+ * while(decoder.next(message))
+ * {
+ *     message.format_to(text);
+ *     text << '\n';
+ * }
+ * \endcode
+ */
+class BinaryDecoder
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Creates a decoder which reads from the current position of the
+     *        given file, which must remain open while the decoder is used.
+     */
+    explicit BinaryDecoder(std::FILE* file);
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Only messages logged from the time ```from``` to the time
+     *        ```to``` (inclusive) are read from now on.
+     *
+     * Times are in nanoseconds since Linux Epoch.
+     */
+    void set_time_range(arc::clock::TimeInt from, arc::clock::TimeInt to);
+
+    /*!
+     * \brief Reads the next message in the time range.
+     *
+     * \return false if the end of the file has been reached.
+     *
+     * \throws arc::ex::ValueError If the file is not a binary log or is
+     *                             malformed or truncated.
+     * \throws arc::ex::RuntimeError If reading the file fails.
+     */
+    bool next(DecodedMessage& out_message);
+
+    /*!
+     * \brief Returns the number of blocks of messages which have been skipped
+     *        because they were outside of the time range.
+     */
+    std::size_t get_skipped_block_count() const;
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                               PRIVATE TYPES
+    //--------------------------------------------------------------------------
+
+    // the definition of a call site
+    struct Site
+    {
+        Level level;
+        std::string format;
+        std::string file;
+        unsigned line;
+        std::vector<arc::fmt::detail::Kind> kinds;
+    };
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    std::FILE* m_file;
+    arc::clock::TimeInt m_from;
+    arc::clock::TimeInt m_to;
+    std::size_t m_skipped_blocks;
+    // whether the start block has been read
+    bool m_started;
+    // the sites defined since the last start block, by id
+    std::vector<Site> m_sites;
+
+    // the payload of the current block and the position read up to
+    std::vector<char> m_block;
+    std::size_t m_position;
+    // whether the current block holds messages
+    bool m_in_messages;
+    arc::clock::TimeInt m_previous_time;
+    // the arguments of the current message
+    std::vector<arc::fmt::detail::Arg> m_args;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    // reads the next block, returning false at the end of the file
+    bool read_block();
+
+    // reads the definitions of the current sites block
+    void read_sites();
+
+    // reads the next message of the current messages block, returning false
+    // if it is outside of the time range
+    bool read_message(DecodedMessage& out_message);
+
+    // reads the given number of bytes of the current block
+    const char* read_bytes(std::size_t size);
+
+    // reads a varint of the current block
+    std::uint64_t read_varint();
+};
+
+} // namespace log
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
@@ -0,0 +1,277 @@
+/*!
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "arcanecore/base/log/BinaryEncoder.hpp"
+
+#include <cstring>
+#include <limits>
+
+#include <deus/UnicodeStorage.hpp>
+#include <deus/UnicodeView.hpp>
+
+#include "arcanecore/base/log/BinaryFormat.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace log
+{
+
+//------------------------------------------------------------------------------
+//                                  CONSTRUCTOR
+//------------------------------------------------------------------------------
+
+BinaryEncoder::BinaryEncoder()
+    : m_min_time     (std::numeric_limits<arc::clock::TimeInt>::max())
+    , m_max_time     (0)
+    , m_previous_time(0)
+{
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+void BinaryEncoder::write_start(
+        arc::lang::StringBuilder& out,
+        arc::clock::TimeInt time)
+{
+    // the pending messages belong to the previous log
+    write_blocks(out);
+    m_site_ids.clear();
+
+    arc::lang::StringBuilder payload;
+    payload.append(binary::MAGIC, binary::MAGIC_SIZE);
+    payload.append(static_cast<char>(binary::VERSION));
+    write_block(
+        out,
+        static_cast<unsigned char>(binary::BlockType::kStart),
+        time,
+        time,
+        payload
+    );
+}
+
+void BinaryEncoder::add_message(
+        const detail::Site& site,
+        arc::clock::TimeInt time,
+        const arc::fmt::detail::Arg* args,
+        std::size_t arg_count)
+{
+    // define the site the first time it's seen
+    std::pair<
+        arc::lang::FlatHashMap<const detail::Site*, std::uint64_t>::iterator,
+        bool
+    > id = m_site_ids.insert(std::make_pair(&site, m_site_ids.size()));
+    if(id.second)
+    {
+        binary::write_varint(m_sites, id.first->second);
+        m_sites.append(static_cast<char>(site.level));
+        binary::write_varint(m_sites, site.format_length);
+        m_sites.append(site.format, site.format_length);
+        const std::size_t file_length = std::strlen(site.file);
+        binary::write_varint(m_sites, file_length);
+        m_sites.append(site.file, file_length);
+        binary::write_varint(m_sites, site.line);
+        binary::write_varint(m_sites, arg_count);
+        for(std::size_t i = 0; i < arg_count; ++i)
+        {
+            m_sites.append(static_cast<char>(args[i].kind));
+        }
+    }
+
+    if(m_messages.empty())
+    {
+        char base[8];
+        binary::store_u64(base, time);
+        m_messages.append(base, sizeof(base));
+        m_previous_time = time;
+    }
+    if(time < m_min_time)
+    {
+        m_min_time = time;
+    }
+    if(time > m_max_time)
+    {
+        m_max_time = time;
+    }
+
+    binary::write_varint(m_messages, id.first->second);
+    binary::write_varint(
+        m_messages,
+        binary::zigzag_encode(
+            static_cast<std::int64_t>(time - m_previous_time)
+        )
+    );
+    m_previous_time = time;
+
+    for(std::size_t i = 0; i < arg_count; ++i)
+    {
+        const arc::fmt::detail::Arg::Value& value = args[i].value;
+        switch(args[i].kind)
+        {
+            case arc::fmt::detail::Kind::kSigned:
+            {
+                binary::write_varint(
+                    m_messages,
+                    binary::zigzag_encode(value.i)
+                );
+                break;
+            }
+            case arc::fmt::detail::Kind::kUnsigned:
+            {
+                binary::write_varint(m_messages, value.u);
+                break;
+            }
+            case arc::fmt::detail::Kind::kPointer:
+            {
+                binary::write_varint(
+                    m_messages,
+                    reinterpret_cast<std::uintptr_t>(value.p)
+                );
+                break;
+            }
+            case arc::fmt::detail::Kind::kBool:
+            {
+                m_messages.append(static_cast<char>(value.b));
+                break;
+            }
+            case arc::fmt::detail::Kind::kChar:
+            {
+                m_messages.append(value.c);
+                break;
+            }
+            case arc::fmt::detail::Kind::kFloat:
+            {
+                char bytes[sizeof(float)];
+                std::memcpy(bytes, &value.f, sizeof(bytes));
+                m_messages.append(bytes, sizeof(bytes));
+                break;
+            }
+            case arc::fmt::detail::Kind::kDouble:
+            {
+                char bytes[sizeof(double)];
+                std::memcpy(bytes, &value.d, sizeof(bytes));
+                m_messages.append(bytes, sizeof(bytes));
+                break;
+            }
+            case arc::fmt::detail::Kind::kString:
+            {
+                binary::write_varint(m_messages, value.s.size);
+                m_messages.append(value.s.data, value.s.size);
+                break;
+            }
+            case arc::fmt::detail::Kind::kUnicode:
+            {
+                deus::UnicodeStorage converted;
+                const deus::UnicodeView& utf8 = value.unicode->convert_if_not(
+                    deus::ASCII_COMPATIBLE_ENCODINGS,
+                    deus::Encoding::kUTF8,
+                    converted
+                );
+                const std::size_t size = std::strlen(utf8.c_str());
+                binary::write_varint(m_messages, size);
+                m_messages.append(utf8.c_str(), size);
+                break;
+            }
+            case arc::fmt::detail::Kind::kNone:
+            {
+                break;
+            }
+        }
+    }
+}
+
+std::size_t BinaryEncoder::get_pending_size() const
+{
+    return m_sites.size() + m_messages.size();
+}
+
+void BinaryEncoder::write_blocks(arc::lang::StringBuilder& out)
+{
+    if(m_messages.empty())
+    {
+        return;
+    }
+
+    if(!m_sites.empty())
+    {
+        write_block(
+            out,
+            static_cast<unsigned char>(binary::BlockType::kSites),
+            m_min_time,
+            m_max_time,
+            m_sites
+        );
+        m_sites.clear();
+    }
+    write_block(
+        out,
+        static_cast<unsigned char>(binary::BlockType::kMessages),
+        m_min_time,
+        m_max_time,
+        m_messages
+    );
+    m_messages.clear();
+    m_min_time = std::numeric_limits<arc::clock::TimeInt>::max();
+    m_max_time = 0;
+}
+
+//------------------------------------------------------------------------------
+//                            PRIVATE MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+void BinaryEncoder::write_block(
+        arc::lang::StringBuilder& out,
+        unsigned char type,
+        arc::clock::TimeInt min_time,
+        arc::clock::TimeInt max_time,
+        const arc::lang::StringBuilder& payload)
+{
+    char header[binary::BLOCK_HEADER_SIZE];
+    header[0] = static_cast<char>(type);
+    const std::uint32_t size = static_cast<std::uint32_t>(payload.size());
+    for(std::size_t i = 0; i < 4; ++i)
+    {
+        header[1 + i] = static_cast<char>(size >> (i * 8));
+    }
+    binary::store_u64(header + 5, min_time);
+    binary::store_u64(header + 13, max_time);
+
+    out.append(header, sizeof(header));
+    out.append(payload.data(), payload.size());
+}
+
+} // namespace log
+ARC_BASE_VERSION_NS_END
+} // namespace arc
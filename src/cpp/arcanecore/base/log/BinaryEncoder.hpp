@@ -0,0 +1,156 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Encodes log messages in the binary log layout.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_LOG_BINARYENCODER_HPP_
+#define ARCANECORE_BASE_LOG_BINARYENCODER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/clock/ClockDefinitions.hpp"
+#include "arcanecore/base/fmt/Format.hpp"
+#include "arcanecore/base/lang/FlatHashMap.hpp"
+#include "arcanecore/base/lang/Restrictors.hpp"
+#include "arcanecore/base/lang/StringBuilder.hpp"
+#include "arcanecore/base/log/Logger.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace log
+{
+
+/*!
+ * \brief Encodes messages into the blocks of a binary log (see
+ *        arc::log::binary).
+ *
+ * Messages are added one at a time, and are then written out as a block of
+ * the sites seen for the first time, followed by a block of the messages.
+ *
+ * This is used by the background thread of an arc::log::Logger with
+ * arc::log::OutputFormat::kBinary.
+ */
+class BinaryEncoder
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    BinaryEncoder();
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Appends the start block of a log to the given builder.
+     *
+     * Every site is defined again after this.
+     *
+     * \param time The time the log starts in nanoseconds since Linux Epoch.
+     */
+    void write_start(arc::lang::StringBuilder& out, arc::clock::TimeInt time);
+
+    /*!
+     * \brief Adds a message to the messages that are written by the next call
+     *        to write_blocks().
+     *
+     * \param site The call site of the message, which must outlive the
+     *             encoder. Every message of a site must have arguments of the
+     *             same kinds.
+     * \param time The time of the message in nanoseconds since Linux Epoch.
+     * \param args The arguments of the message.
+     * \param arg_count The number of arguments of the message.
+     */
+    void add_message(
+            const detail::Site& site,
+            arc::clock::TimeInt time,
+            const arc::fmt::detail::Arg* args,
+            std::size_t arg_count);
+
+    /*!
+     * \brief Returns the number of bytes that the messages which have been
+     *        added since the last call to write_blocks() take.
+     */
+    std::size_t get_pending_size() const;
+
+    /*!
+     * \brief Appends the blocks of the messages which have been added since the
+     *        last call to this function, if any.
+     */
+    void write_blocks(arc::lang::StringBuilder& out);
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    // the ids of the sites defined in the current log
+    arc::lang::FlatHashMap<const detail::Site*, std::uint64_t> m_site_ids;
+    // the payloads of the pending blocks
+    arc::lang::StringBuilder m_sites;
+    arc::lang::StringBuilder m_messages;
+    // the time bounds of the pending messages, and the time of the last one
+    arc::clock::TimeInt m_min_time;
+    arc::clock::TimeInt m_max_time;
+    arc::clock::TimeInt m_previous_time;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    // appends a block with the given payload to the builder
+    static void write_block(
+            arc::lang::StringBuilder& out,
+            unsigned char type,
+            arc::clock::TimeInt min_time,
+            arc::clock::TimeInt max_time,
+            const arc::lang::StringBuilder& payload);
+};
+
+} // namespace log
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
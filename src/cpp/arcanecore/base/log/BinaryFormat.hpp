@@ -0,0 +1,203 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Definitions of the layout of binary log files.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_LOG_BINARYFORMAT_HPP_
+#define ARCANECORE_BASE_LOG_BINARYFORMAT_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/lang/StringBuilder.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace log
+{
+
+/*!
+ * \brief The layout of the log files written by an arc::log::Logger with
+ *        arc::log::OutputFormat::kBinary.
+ *
+ * A binary log is a sequence of blocks, each of which starts with a fixed size
+ * header:
+ *
+ * | Bytes | Field                                                  |
+ * | ----- | ------------------------------------------------------ |
+ * | 1     | The arc::log::binary::BlockType                        |
+ * | 4     | The size of the payload which follows the header       |
+ * | 8     | The earliest time of a message in the block            |
+ * | 8     | The latest time of a message in the block              |
+ *
+ * All fixed size integers are little endian, times are nanoseconds since
+ * Linux Epoch, and variable size integers (varints) are LEB128. Since a reader
+ * can skip a block using only its header, the headers form a sparse index of
+ * the file by time.
+ *
+ * - **kStart** begins the log of a logger. The payload is MAGIC followed by
+ *   the VERSION byte. Since site ids are only unique within a logger, a start
+ *   block forgets the sites before it, so logs may be appended to each other.
+ * - **kSites** defines the call sites of the messages which follow it. Each
+ *   site is the varint id, the arc::log::Level byte, the format string and
+ *   source file (each a varint size followed by the bytes), the varint line
+ *   number, the varint number of arguments, and a byte per argument of its
+ *   kind.
+ * - **kMessages** holds messages. The payload starts with the 8 byte time of
+ *   the first message, then each message is its varint site id, the
+ *   difference between its time and the time of the previous message as a
+ *   zig-zag varint, and its arguments. Signed integers are zig-zag varints,
+ *   unsigned integers and pointers are varints, booleans and characters are a
+ *   byte, floats and doubles are their 4 or 8 bytes, and strings are a varint
+ *   size followed by the UTF-8 bytes.
+ *
+ * Since the format string of a site is written once per log rather than once
+ * per message, a message typically takes a fraction of the size of its line
+ * of text.
+ */
+namespace binary
+{
+
+//------------------------------------------------------------------------------
+//                                   CONSTANTS
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief The bytes which begin the payload of a start block.
+ */
+static const char MAGIC[] = "ARCLOG";
+
+/*!
+ * \brief The number of bytes in MAGIC.
+ */
+static const std::size_t MAGIC_SIZE = sizeof(MAGIC) - 1;
+
+/*!
+ * \brief The version of the layout which is written.
+ */
+static const unsigned char VERSION = 1;
+
+/*!
+ * \brief The size of the header of every block in bytes.
+ */
+static const std::size_t BLOCK_HEADER_SIZE = 21;
+
+//------------------------------------------------------------------------------
+//                                  ENUMERATORS
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief The types of blocks in a binary log.
+ */
+enum class BlockType : unsigned char
+{
+    kStart = 1,
+    kSites,
+    kMessages
+};
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief Appends the given integer as a LEB128 varint.
+ */
+inline void write_varint(arc::lang::StringBuilder& out, std::uint64_t value)
+{
+    char buffer[10];
+    std::size_t size = 0;
+    while(value >= 0x80)
+    {
+        buffer[size++] = static_cast<char>((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    buffer[size++] = static_cast<char>(value);
+    out.append(buffer, size);
+}
+
+/*!
+ * \brief Maps signed integers to unsigned integers so that numbers close to
+ *        zero are small.
+ */
+inline std::uint64_t zigzag_encode(std::int64_t value)
+{
+    return (static_cast<std::uint64_t>(value) << 1) ^
+           static_cast<std::uint64_t>(value >> 63);
+}
+
+/*!
+ * \brief The inverse of zigzag_encode().
+ */
+inline std::int64_t zigzag_decode(std::uint64_t value)
+{
+    return static_cast<std::int64_t>(value >> 1) ^
+           -static_cast<std::int64_t>(value & 1);
+}
+
+/*!
+ * \brief Writes the given integer to the given 8 bytes in little endian order.
+ */
+inline void store_u64(char* out, std::uint64_t value)
+{
+    for(std::size_t i = 0; i < 8; ++i)
+    {
+        out[i] = static_cast<char>(value >> (i * 8));
+    }
+}
+
+/*!
+ * \brief Reads a little endian integer from the given 8 bytes.
+ */
+inline std::uint64_t load_u64(const char* data)
+{
+    std::uint64_t ret = 0;
+    for(std::size_t i = 0; i < 8; ++i)
+    {
+        ret |= static_cast<std::uint64_t>(
+            static_cast<unsigned char>(data[i])
+        ) << (i * 8);
+    }
+    return ret;
+}
+
+} // namespace binary
+} // namespace log
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
@@ -0,0 +1,644 @@
+/*!
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "arcanecore/base/log/Logger.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+#include "arcanecore/base/lang/SmallVector.hpp"
+#include "arcanecore/base/lang/SpscByteQueue.hpp"
+#include "arcanecore/base/lang/WaitStrategy.hpp"
+#include "arcanecore/base/log/BinaryEncoder.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace log
+{
+
+namespace
+{
+
+//------------------------------------------------------------------------------
+//                                   CONSTANTS
+//------------------------------------------------------------------------------
+
+// how long the background thread sleeps when there are no messages
+static const std::chrono::milliseconds POLL_INTERVAL(1);
+
+// the size the batch of lines is written to the sink at
+static const std::size_t BATCH_SIZE = 64 * 1024;
+
+//------------------------------------------------------------------------------
+//                                   VARIABLES
+//------------------------------------------------------------------------------
+
+std::atomic<std::uint64_t> g_next_id(1);
+
+// the site of the messages reporting dropped messages
+const arc::fmt::detail::Kind DROPPED_KINDS[] = {
+    arc::fmt::detail::Kind::kUnsigned
+};
+const detail::Encoding DROPPED_ENCODINGS[] = {
+    detail::Encoding::kScalar,
+    detail::Encoding::kNone
+};
+const char DROPPED_FORMAT[] =
+    "Dropped {} log messages because the queue was full.";
+const detail::Site DROPPED_SITE = {
+    Level::kWarning,
+    DROPPED_FORMAT,
+    sizeof(DROPPED_FORMAT) - 1,
+    DROPPED_KINDS,
+    DROPPED_ENCODINGS,
+    __FILE__,
+    __LINE__
+};
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+const char* get_level_name(Level level)
+{
+    switch(level)
+    {
+        case Level::kDebug:
+            return "DEBUG";
+        case Level::kInfo:
+            return "INFO";
+        case Level::kWarning:
+            return "WARNING";
+        case Level::kError:
+            return "ERROR";
+    }
+    return "UNKNOWN";
+}
+
+//------------------------------------------------------------------------------
+//                                 PRIVATE TYPES
+//------------------------------------------------------------------------------
+
+/*
+ * A queue of records. When a queue grows a new ring is chained after the old
+ * one, and the background thread moves on to it once the old one is empty.
+ */
+struct Logger::Ring
+{
+    arc::lang::SpscByteQueue queue;
+    std::atomic<Ring*> next;
+
+    explicit Ring(std::size_t capacity)
+        : queue(capacity)
+        , next (nullptr)
+    {
+    }
+};
+
+/*
+ * The queue of a single thread, which is shared by the logger and the thread
+ * so that either may outlive the other.
+ */
+struct Logger::ThreadQueue
+{
+    // the ring the thread writes to, only used by the thread
+    Ring* producer;
+    // the ring the background thread reads from, only used by the background
+    // thread
+    Ring* consumer;
+    // the number of records the thread has dropped
+    std::atomic<std::size_t> dropped;
+    // the number of dropped records that have been reported
+    std::size_t reported_dropped;
+    // set once the thread has exited
+    std::atomic<bool> closed;
+    // set once the logger has been destroyed
+    std::atomic<bool> orphaned;
+    // woken when the background thread has emptied the ring
+    arc::lang::BlockingWait not_full;
+
+    explicit ThreadQueue(std::size_t capacity)
+        : producer        (new Ring(capacity))
+        , consumer        (producer)
+        , dropped         (0)
+        , reported_dropped(0)
+        , closed          (false)
+        , orphaned        (false)
+    {
+    }
+
+    ~ThreadQueue()
+    {
+        while(consumer != nullptr)
+        {
+            Ring* next = consumer->next.load(std::memory_order_relaxed);
+            delete consumer;
+            consumer = next;
+        }
+    }
+};
+
+namespace
+{
+
+//------------------------------------------------------------------------------
+//                                 THREAD QUEUES
+//------------------------------------------------------------------------------
+
+/*
+ * The queues of the calling thread for each logger it has logged to.
+ */
+template<typename ThreadQueue>
+struct ThreadQueues
+{
+    struct Entry
+    {
+        std::uint64_t logger_id;
+        std::shared_ptr<ThreadQueue> queue;
+    };
+
+    // the most recently used entry, which is checked first
+    std::uint64_t last_id;
+    ThreadQueue* last_queue;
+    std::vector<Entry> entries;
+
+    ThreadQueues()
+        : last_id   (0)
+        , last_queue(nullptr)
+    {
+    }
+
+    ~ThreadQueues()
+    {
+        for(Entry& entry : entries)
+        {
+            entry.queue->closed.store(true, std::memory_order_release);
+        }
+    }
+};
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                  CONSTRUCTOR
+//------------------------------------------------------------------------------
+
+Logger::Logger(
+        arc::io::OutputSink& sink,
+        FullPolicy full_policy,
+        std::size_t queue_capacity,
+        OutputFormat output_format)
+    : m_id               (g_next_id.fetch_add(1, std::memory_order_relaxed))
+    , m_sink             (sink)
+    , m_full_policy      (full_policy)
+    , m_queue_capacity   (queue_capacity)
+    , m_output_format    (output_format)
+    , m_level            (Level::kDebug)
+    , m_dropped          (0)
+    , m_queues_revision  (0)
+    , m_stopping         (false)
+    , m_wake_requested   (false)
+    , m_flush_requested  (0)
+    , m_flush_completed  (0)
+    , m_consumer_revision(0)
+{
+    if(m_output_format == OutputFormat::kBinary)
+    {
+        m_encoder.reset(new BinaryEncoder());
+        m_encoder->write_start(
+            m_batch,
+            arc::clock::get_current_time(arc::clock::TimeMetric::kNanoseconds)
+        );
+    }
+    m_thread = std::thread(&Logger::run, this);
+}
+
+//------------------------------------------------------------------------------
+//                                   DESTRUCTOR
+//------------------------------------------------------------------------------
+
+Logger::~Logger()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_one();
+    m_thread.join();
+
+    std::lock_guard<std::mutex> lock(m_queues_mutex);
+    for(std::shared_ptr<ThreadQueue>& queue : m_queues)
+    {
+        queue->orphaned.store(true, std::memory_order_release);
+    }
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+Level Logger::get_level() const
+{
+    return m_level.load(std::memory_order_relaxed);
+}
+
+void Logger::set_level(Level level)
+{
+    m_level.store(level, std::memory_order_relaxed);
+}
+
+FullPolicy Logger::get_full_policy() const
+{
+    return m_full_policy;
+}
+
+OutputFormat Logger::get_output_format() const
+{
+    return m_output_format;
+}
+
+std::size_t Logger::get_dropped_count() const
+{
+    return m_dropped.load(std::memory_order_relaxed);
+}
+
+void Logger::flush()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    const std::uint64_t ticket = ++m_flush_requested;
+    m_wake.notify_one();
+    m_flushed.wait(lock, [&]() { return m_flush_completed >= ticket; });
+}
+
+//------------------------------------------------------------------------------
+//                            PRIVATE MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+char* Logger::reserve(std::size_t size, ThreadQueue*& out_queue)
+{
+    ThreadQueue& queue = get_thread_queue();
+    out_queue = &queue;
+    char* out = queue.producer->queue.try_reserve(size);
+    if(out != nullptr)
+    {
+        return out;
+    }
+    return reserve_full(queue, size);
+}
+
+char* Logger::reserve_full(ThreadQueue& queue, std::size_t size)
+{
+    arc::lang::SpscByteQueue& ring = queue.producer->queue;
+    char* out = nullptr;
+    switch(m_full_policy)
+    {
+        case FullPolicy::kBlock:
+        {
+            if(size > ring.get_max_size())
+            {
+                break;
+            }
+            wake();
+            queue.not_full.wait_until([&]()
+            {
+                out = ring.try_reserve(size);
+                return out != nullptr;
+            });
+            return out;
+        }
+        case FullPolicy::kDrop:
+        {
+            break;
+        }
+        case FullPolicy::kGrow:
+        {
+            std::size_t capacity = ring.capacity() * 2;
+            while(capacity < size * 2)
+            {
+                capacity *= 2;
+            }
+            Ring* grown = new Ring(capacity);
+            queue.producer->next.store(grown, std::memory_order_release);
+            queue.producer = grown;
+            return grown->queue.try_reserve(size);
+        }
+    }
+
+    queue.dropped.fetch_add(1, std::memory_order_relaxed);
+    m_dropped.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+}
+
+void Logger::commit(ThreadQueue* queue)
+{
+    queue->producer->queue.commit();
+}
+
+Logger::ThreadQueue& Logger::get_thread_queue()
+{
+    static thread_local ThreadQueues<ThreadQueue> t_queues;
+    if(t_queues.last_id == m_id)
+    {
+        return *t_queues.last_queue;
+    }
+
+    typedef ThreadQueues<ThreadQueue>::Entry Entry;
+    std::vector<Entry>& entries = t_queues.entries;
+    auto entry = std::find_if(
+        entries.begin(),
+        entries.end(),
+        [&](const Entry& e) { return e.logger_id == m_id; }
+    );
+    if(entry == entries.end())
+    {
+        // forget the queues of loggers that have been destroyed
+        entries.erase(
+            std::remove_if(
+                entries.begin(),
+                entries.end(),
+                [](const Entry& e)
+                {
+                    return e.queue->orphaned.load(std::memory_order_acquire);
+                }
+            ),
+            entries.end()
+        );
+
+        Entry created = {m_id, std::make_shared<ThreadQueue>(m_queue_capacity)};
+        {
+            std::lock_guard<std::mutex> lock(m_queues_mutex);
+            m_queues.push_back(created.queue);
+            m_queues_revision.fetch_add(1, std::memory_order_release);
+        }
+        entries.push_back(created);
+        entry = entries.end() - 1;
+    }
+
+    t_queues.last_id = m_id;
+    t_queues.last_queue = entry->queue.get();
+    return *t_queues.last_queue;
+}
+
+void Logger::wake()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_wake_requested = true;
+    }
+    m_wake.notify_one();
+}
+
+void Logger::run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while(true)
+    {
+        // everything logged before these were requested is drained below
+        const std::uint64_t flush_requested = m_flush_requested;
+        const bool stopping = m_stopping;
+        m_wake_requested = false;
+        lock.unlock();
+
+        const std::size_t count = drain();
+
+        lock.lock();
+        if(flush_requested != m_flush_completed)
+        {
+            m_sink.flush();
+            m_flush_completed = flush_requested;
+            m_flushed.notify_all();
+        }
+        if(stopping)
+        {
+            m_sink.flush();
+            return;
+        }
+        if(count == 0)
+        {
+            m_wake.wait_for(lock, POLL_INTERVAL, [&]()
+            {
+                return m_stopping ||
+                       m_wake_requested ||
+                       m_flush_requested != flush_requested;
+            });
+        }
+    }
+}
+
+std::size_t Logger::drain()
+{
+    // pick up the queues of any new threads
+    const std::size_t revision =
+        m_queues_revision.load(std::memory_order_acquire);
+    if(revision != m_consumer_revision)
+    {
+        std::lock_guard<std::mutex> lock(m_queues_mutex);
+        m_consumer_queues = m_queues;
+        m_consumer_revision = revision;
+    }
+
+    std::size_t count = 0;
+    bool closed = false;
+    for(std::shared_ptr<ThreadQueue>& queue : m_consumer_queues)
+    {
+        // read before draining, so that once the queue is drained it's known
+        // to be empty for good
+        closed |= queue->closed.load(std::memory_order_acquire);
+
+        auto write = [&](const char* data, std::size_t)
+        {
+            write_record(data);
+            if(get_batch_size() >= BATCH_SIZE)
+            {
+                write_batch();
+            }
+        };
+        while(true)
+        {
+            count += queue->consumer->queue.consume(write);
+            Ring* next = queue->consumer->next.load(std::memory_order_acquire);
+            if(next == nullptr)
+            {
+                break;
+            }
+            // the thread has moved on to the next ring, so this pass empties
+            // the old ring for good
+            count += queue->consumer->queue.consume(write);
+            delete queue->consumer;
+            queue->consumer = next;
+        }
+        queue->not_full.notify_all();
+
+        const std::size_t dropped =
+            queue->dropped.load(std::memory_order_relaxed);
+        if(dropped != queue->reported_dropped)
+        {
+            arc::fmt::detail::Arg args[2];
+            args[0].kind = arc::fmt::detail::Kind::kUnsigned;
+            args[0].value.u = dropped - queue->reported_dropped;
+            args[1].kind = arc::fmt::detail::Kind::kNone;
+            write_message(
+                DROPPED_SITE,
+                arc::clock::get_current_time(
+                    arc::clock::TimeMetric::kNanoseconds
+                ),
+                args,
+                1
+            );
+            queue->reported_dropped = dropped;
+        }
+    }
+    write_batch();
+
+    // forget the queues of threads that have exited, which are now empty
+    if(closed)
+    {
+        std::lock_guard<std::mutex> lock(m_queues_mutex);
+        auto is_closed = [](const std::shared_ptr<ThreadQueue>& queue)
+        {
+            return queue->closed.load(std::memory_order_acquire) &&
+                   queue->consumer->queue.empty();
+        };
+        m_queues.erase(
+            std::remove_if(m_queues.begin(), m_queues.end(), is_closed),
+            m_queues.end()
+        );
+        m_consumer_queues = m_queues;
+        m_consumer_revision = m_queues_revision.load(std::memory_order_relaxed);
+    }
+    return count;
+}
+
+void Logger::write_record(const char* data)
+{
+    detail::RecordHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    data += sizeof(header);
+    const detail::Site& site = *header.site;
+
+    arc::lang::SmallVector<arc::fmt::detail::Arg, 16> args;
+    for(std::size_t i = 0; site.encodings[i] != detail::Encoding::kNone; ++i)
+    {
+        arc::fmt::detail::Arg arg;
+        arg.kind = arc::fmt::detail::Kind::kString;
+        switch(site.encodings[i])
+        {
+            case detail::Encoding::kScalar:
+            {
+                arg.kind = site.kinds[i];
+                std::memcpy(&arg.value, data, 8);
+                data += 8;
+                break;
+            }
+            case detail::Encoding::kString:
+            {
+                std::size_t size = 0;
+                std::memcpy(&size, data, sizeof(size));
+                arg.value.s.data = data + sizeof(size);
+                arg.value.s.size = size;
+                data += sizeof(size) + size;
+                break;
+            }
+            case detail::Encoding::kAtom:
+            {
+                arc::lang::Atom atom;
+                std::memcpy(&atom, data, sizeof(atom));
+                arg.value.s.data = atom.c_str();
+                arg.value.s.size = atom.size();
+                data += sizeof(atom);
+                break;
+            }
+            case detail::Encoding::kNone:
+            {
+                break;
+            }
+        }
+        args.push_back(arg);
+    }
+    const std::size_t arg_count = args.size();
+    args.push_back(arc::fmt::detail::Arg());
+
+    write_message(site, header.time, args.data(), arg_count);
+}
+
+void Logger::write_message(
+        const detail::Site& site,
+        arc::clock::TimeInt time,
+        const arc::fmt::detail::Arg* args,
+        std::size_t arg_count)
+{
+    if(m_encoder)
+    {
+        m_encoder->add_message(site, time, args, arg_count);
+        return;
+    }
+
+    m_timestamps.write(m_batch, time);
+    m_batch << " [" << get_level_name(site.level) << "] ";
+    arc::fmt::detail::vformat_to(
+        m_batch,
+        site.format,
+        site.format_length,
+        args
+    );
+    m_batch << '\n';
+}
+
+std::size_t Logger::get_batch_size() const
+{
+    if(m_encoder)
+    {
+        return m_batch.size() + m_encoder->get_pending_size();
+    }
+    return m_batch.size();
+}
+
+void Logger::write_batch()
+{
+    if(m_encoder)
+    {
+        m_encoder->write_blocks(m_batch);
+    }
+    if(!m_batch.empty())
+    {
+        m_sink.write(m_batch);
+        m_batch.clear();
+    }
+}
+
+} // namespace log
+ARC_BASE_VERSION_NS_END
+} // namespace arc
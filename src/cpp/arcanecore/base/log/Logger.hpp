@@ -0,0 +1,693 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Asynchronous logger which formats messages on a background thread.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_LOG_LOGGER_HPP_
+#define ARCANECORE_BASE_LOG_LOGGER_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <deus/UnicodeStorage.hpp>
+#include <deus/UnicodeView.hpp>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/clock/ClockOperations.hpp"
+#include "arcanecore/base/fmt/Format.hpp"
+#include "arcanecore/base/io/OutputSink.hpp"
+#include "arcanecore/base/lang/Atom.hpp"
+#include "arcanecore/base/lang/Restrictors.hpp"
+#include "arcanecore/base/lang/StringBuilder.hpp"
+#include "arcanecore/base/log/TimestampFormatter.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace log
+{
+
+class BinaryEncoder;
+
+//------------------------------------------------------------------------------
+//                                  ENUMERATORS
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief The severity of a log message.
+ */
+enum class Level : unsigned char
+{
+    kDebug,
+    kInfo,
+    kWarning,
+    kError
+};
+
+/*!
+ * \brief What a thread logging a message does when its queue is full.
+ */
+enum class FullPolicy
+{
+    /*!
+     * The thread waits for the background thread to make room.
+     */
+    kBlock,
+    /*!
+     * The message is discarded, and the number of messages discarded is
+     * reported in the log.
+     */
+    kDrop,
+    /*!
+     * The thread's queue is replaced by one twice the size.
+     */
+    kGrow
+};
+
+/*!
+ * \brief How a logger writes messages to its sink.
+ */
+enum class OutputFormat
+{
+    /*!
+     * A line of text per message.
+     */
+    kText,
+    /*!
+     * The compact binary layout described by arc::log::binary, which can be
+     * read with arc::log::BinaryDecoder or the arc_logdecode tool.
+     */
+    kBinary
+};
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief Returns the name of the given level as it appears in log lines.
+ */
+const char* get_level_name(Level level);
+
+//------------------------------------------------------------------------------
+//                                    DETAIL
+//------------------------------------------------------------------------------
+
+namespace detail
+{
+
+// how an argument is stored in a queued record
+enum class Encoding : unsigned char
+{
+    kNone,
+    // the first 8 bytes of the arc::fmt::detail::Arg value
+    kScalar,
+    // the length followed by the UTF-8 bytes
+    kString,
+    // the atom itself, since interned strings are never freed
+    kAtom
+};
+
+static_assert(
+    sizeof(arc::fmt::detail::Arg::Value) >= 8 && sizeof(long long) == 8,
+    "Scalar log arguments are stored in 8 bytes"
+);
+
+// the static description of a log call site
+struct Site
+{
+    Level level;
+    const char* format;
+    std::size_t format_length;
+    // the arc::fmt kinds and encodings of the arguments, terminated by kNone
+    const arc::fmt::detail::Kind* kinds;
+    const Encoding* encodings;
+    const char* file;
+    unsigned line;
+};
+
+// yields the level of a log call site, which fails to compile if the level
+// isn't a constant expression since it's stored in the site's static
+// description
+template<Level L>
+struct SiteLevel
+{
+    static constexpr Level get()
+    {
+        return L;
+    }
+};
+
+// the start of every queued record, followed by the encoded arguments
+struct RecordHeader
+{
+    const Site* site;
+    arc::clock::TimeInt time;
+};
+
+// how each type of argument is written to a record
+template<typename T, typename Enable = void>
+struct Encoder
+{
+    static constexpr Encoding ENCODING = Encoding::kScalar;
+
+    static std::size_t get_size(const T&)
+    {
+        return 8;
+    }
+
+    static char* write(char* out, const T& value)
+    {
+        const arc::fmt::detail::Arg arg = arc::fmt::detail::make_arg(value);
+        std::memcpy(out, &arg.value, 8);
+        return out + 8;
+    }
+};
+
+// writes the bytes of a string
+inline char* write_string(char* out, const char* data, std::size_t size)
+{
+    std::memcpy(out, &size, sizeof(size));
+    std::memcpy(out + sizeof(size), data, size);
+    return out + sizeof(size) + size;
+}
+
+template<>
+struct Encoder<const char*>
+{
+    static constexpr Encoding ENCODING = Encoding::kString;
+
+    static std::size_t get_size(const char* value)
+    {
+        return sizeof(std::size_t) + std::strlen(value);
+    }
+
+    static char* write(char* out, const char* value)
+    {
+        return write_string(out, value, std::strlen(value));
+    }
+};
+
+template<>
+struct Encoder<char*> : public Encoder<const char*>
+{
+};
+
+template<>
+struct Encoder<std::string>
+{
+    static constexpr Encoding ENCODING = Encoding::kString;
+
+    static std::size_t get_size(const std::string& value)
+    {
+        return sizeof(std::size_t) + value.size();
+    }
+
+    static char* write(char* out, const std::string& value)
+    {
+        return write_string(out, value.data(), value.size());
+    }
+};
+
+template<>
+struct Encoder<arc::lang::Atom>
+{
+    static constexpr Encoding ENCODING = Encoding::kAtom;
+
+    static std::size_t get_size(const arc::lang::Atom&)
+    {
+        return sizeof(arc::lang::Atom);
+    }
+
+    static char* write(char* out, const arc::lang::Atom& value)
+    {
+        std::memcpy(out, &value, sizeof(value));
+        return out + sizeof(value);
+    }
+};
+
+template<>
+struct Encoder<deus::UnicodeView>
+{
+    static constexpr Encoding ENCODING = Encoding::kString;
+
+    // strings in other encodings are converted to UTF-8 for both the size and
+    // the write, but this only allocates for encodings which aren't ASCII
+    // compatible
+    static std::size_t get_size(const deus::UnicodeView& value)
+    {
+        deus::UnicodeStorage converted;
+        return sizeof(std::size_t) +
+            to_utf8(value, converted).byte_length() - 1;
+    }
+
+    static char* write(char* out, const deus::UnicodeView& value)
+    {
+        deus::UnicodeStorage converted;
+        const deus::UnicodeView utf8 = to_utf8(value, converted);
+        return write_string(out, utf8.c_str(), utf8.byte_length() - 1);
+    }
+
+    static deus::UnicodeView to_utf8(
+            const deus::UnicodeView& value,
+            deus::UnicodeStorage& converted)
+    {
+        return value.convert_if_not(
+            deus::ASCII_COMPATIBLE_ENCODINGS,
+            deus::Encoding::kUTF8,
+            converted
+        );
+    }
+};
+
+template<>
+struct Encoder<deus::UnicodeStorage>
+{
+    static constexpr Encoding ENCODING = Encoding::kString;
+
+    static std::size_t get_size(const deus::UnicodeStorage& value)
+    {
+        return Encoder<deus::UnicodeView>::get_size(value.get_view());
+    }
+
+    static char* write(char* out, const deus::UnicodeStorage& value)
+    {
+        return Encoder<deus::UnicodeView>::write(out, value.get_view());
+    }
+};
+
+// the encodings of a list of argument types
+template<typename... Args>
+struct Encodings
+{
+    static constexpr Encoding VALUES[sizeof...(Args) + 1] =
+        {Encoder<Args>::ENCODING..., Encoding::kNone};
+};
+
+template<typename... Args>
+constexpr Encoding Encodings<Args...>::VALUES[sizeof...(Args) + 1];
+
+// returns the encodings of the given arguments, only for use in decltype
+template<typename... Args>
+Encodings<typename std::decay<Args>::type...> arg_encodings(
+        const char* format,
+        const Args&... args);
+
+inline std::size_t get_args_size()
+{
+    return 0;
+}
+
+template<typename T, typename... Args>
+std::size_t get_args_size(const T& value, const Args&... args)
+{
+    return Encoder<typename std::decay<T>::type>::get_size(value) +
+        get_args_size(args...);
+}
+
+inline char* write_args(char* out)
+{
+    return out;
+}
+
+template<typename T, typename... Args>
+char* write_args(char* out, const T& value, const Args&... args)
+{
+    return write_args(
+        Encoder<typename std::decay<T>::type>::write(out, value),
+        args...
+    );
+}
+
+} // namespace detail
+
+//------------------------------------------------------------------------------
+//                                     LOGGER
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief Asynchronous logger which writes lines of text to an
+ *        arc::io::OutputSink.
+ *
+ * Messages are logged with the ARC_LOG macros, which check the format string
+ * at compile time (see arc::fmt::format_to() for the syntax). Logging a
+ * message doesn't format it: the calling thread copies a pointer to the
+ * static description of the call site, the raw clock time, and the binary
+ * arguments into a lock-free queue of its own (strings are copied, except for
+ * arc::lang::Atom which is only a pointer). A background thread drains the
+ * queues of every thread, formats the messages, and writes them to the sink in
+ * batches, so the calling thread never waits on I/O.
+ *
+ * Each line is written as:
+ *
+ * \code
+ * 2018/06/02 - 14:03:27.041 [INFO] Loaded 12 assets in 3.2ms.
+ * \endcode
+ *
+ * using arc::clock::get_timestamp() for the local time, which is only
+ * recomputed when the second changes.
+ *
+ * Alternatively, with arc::log::OutputFormat::kBinary, the messages are
+ * written without being formatted in a compact binary layout, in which the
+ * format string of each call site is written once, and arguments and times
+ * are written as variable size integers. This typically takes a fraction of
+ * the bytes and of the background thread's time of text, and the log can be
+ * rendered as text or JSON later with the arc_logdecode tool.
+ *
+ * Messages from the same thread are written in the order they were logged,
+ * whereas messages from different threads are only approximately ordered.
+ * Messages are written within a millisecond or so of being logged, and
+ * flush() waits until everything logged so far has been written.
+ *
+ * \note Messages larger than the queue capacity can only be logged with
+ *       arc::log::FullPolicy::kGrow, and are otherwise dropped.
+ */
+class Logger
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                              PUBLIC CONSTANTS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief The size of the queue of each thread in bytes, if it is not
+     *        specified.
+     */
+    static const std::size_t DEFAULT_QUEUE_CAPACITY = 64 * 1024;
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Constructs a new logger and starts its background thread.
+     *
+     * \param sink Where the log lines are written, which must outlive the
+     *             logger.
+     * \param full_policy What a thread does when its queue is full.
+     * \param queue_capacity The size in bytes of the queue each thread that
+     *                       logs a message is given.
+     * \param output_format How messages are written to the sink.
+     */
+    explicit Logger(
+            arc::io::OutputSink& sink,
+            FullPolicy full_policy = FullPolicy::kBlock,
+            std::size_t queue_capacity = DEFAULT_QUEUE_CAPACITY,
+            OutputFormat output_format = OutputFormat::kText);
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Writes every message that has been logged and stops the
+     *        background thread.
+     *
+     * No thread may be logging to the logger while it is destroyed.
+     */
+    ~Logger();
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns the lowest level of message which is logged.
+     */
+    Level get_level() const;
+
+    /*!
+     * \brief Sets the lowest level of message which is logged, messages below
+     *        this level cost a single comparison.
+     */
+    void set_level(Level level);
+
+    /*!
+     * \brief Returns whether messages of the given level are logged.
+     */
+    bool is_enabled(Level level) const
+    {
+        return level >= m_level.load(std::memory_order_relaxed);
+    }
+
+    /*!
+     * \brief Returns what threads do when their queue is full.
+     */
+    FullPolicy get_full_policy() const;
+
+    /*!
+     * \brief Returns how messages are written to the sink.
+     */
+    OutputFormat get_output_format() const;
+
+    /*!
+     * \brief Returns the number of messages that have been dropped because a
+     *        queue was full.
+     */
+    std::size_t get_dropped_count() const;
+
+    /*!
+     * \brief Waits until every message logged before this call has been
+     *        written to the sink, and the sink has been flushed.
+     */
+    void flush();
+
+    /*!
+     * \brief Queues a message for the background thread.
+     *
+     * This is used by the ARC_LOG macros, which should be used instead since
+     * they check the format string at compile time.
+     */
+    template<typename... Args>
+    void log(
+            const detail::Site& site,
+            const char* format,
+            const Args&... args)
+    {
+        ThreadQueue* queue = nullptr;
+        char* out = reserve(
+            sizeof(detail::RecordHeader) + detail::get_args_size(args...),
+            queue
+        );
+        if(out == nullptr)
+        {
+            return;
+        }
+
+        const detail::RecordHeader header = {
+            &site,
+            arc::clock::get_current_time(arc::clock::TimeMetric::kNanoseconds)
+        };
+        std::memcpy(out, &header, sizeof(header));
+        detail::write_args(out + sizeof(header), args...);
+        commit(queue);
+    }
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                               PRIVATE TYPES
+    //--------------------------------------------------------------------------
+
+    struct Ring;
+    struct ThreadQueue;
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    // distinguishes this logger from any previous logger at the same address
+    const std::uint64_t m_id;
+    arc::io::OutputSink& m_sink;
+    const FullPolicy m_full_policy;
+    const std::size_t m_queue_capacity;
+    const OutputFormat m_output_format;
+    std::atomic<Level> m_level;
+    std::atomic<std::size_t> m_dropped;
+
+    // guards the queues of the threads
+    std::mutex m_queues_mutex;
+    std::vector<std::shared_ptr<ThreadQueue>> m_queues;
+    // incremented when a queue is added
+    std::atomic<std::size_t> m_queues_revision;
+
+    // guards the following, which wake and stop the background thread
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_flushed;
+    bool m_stopping;
+    bool m_wake_requested;
+    std::uint64_t m_flush_requested;
+    std::uint64_t m_flush_completed;
+
+    // only used by the background thread
+    std::vector<std::shared_ptr<ThreadQueue>> m_consumer_queues;
+    std::size_t m_consumer_revision;
+    arc::lang::StringBuilder m_batch;
+    TimestampFormatter m_timestamps;
+    // null unless the output format is binary
+    std::unique_ptr<BinaryEncoder> m_encoder;
+
+    std::thread m_thread;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    // returns space for a record of the given size in the calling thread's
+    // queue, or null if the record was dropped
+    char* reserve(std::size_t size, ThreadQueue*& out_queue);
+
+    // the slow path of reserve(), for when the queue is full
+    char* reserve_full(ThreadQueue& queue, std::size_t size);
+
+    // makes the reserved record visible to the background thread
+    void commit(ThreadQueue* queue);
+
+    // returns the calling thread's queue, creating it if need be
+    ThreadQueue& get_thread_queue();
+
+    // wakes the background thread without waiting for it
+    void wake();
+
+    // the function run by the background thread
+    void run();
+
+    // formats and writes the messages in every queue, returning the number of
+    // messages written
+    std::size_t drain();
+
+    // appends the message of the given record to the batch
+    void write_record(const char* data);
+
+    // appends the given message to the batch
+    void write_message(
+            const detail::Site& site,
+            arc::clock::TimeInt time,
+            const arc::fmt::detail::Arg* args,
+            std::size_t arg_count);
+
+    // returns the number of bytes of messages that haven't been written
+    std::size_t get_batch_size() const;
+
+    // writes the batch to the sink
+    void write_batch();
+};
+
+} // namespace log
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+//------------------------------------------------------------------------------
+//                                     MACROS
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief Logs a message of the given level to the given arc::log::Logger,
+ *        failing to compile if the format string is invalid for the
+ *        arguments.
+ *
+ * The arguments are only evaluated if the level is enabled. The level must be
+ * a constant expression, as it's part of the call site's static description.
+ * The format string must be a string literal, and arguments may be any type
+ * arc::fmt can format.
+ *
+ * \code
+ * ARC_LOG(logger, arc::log::Level::kWarning, "Retrying {} ({})", path, n);
+ * \endcode
+ */
+#define ARC_LOG(logger, level, ...)                                            \
+    do                                                                         \
+    {                                                                          \
+        ::arc::log::Logger& arc_log_logger_ = (logger);                        \
+        if(arc_log_logger_.is_enabled(level))                                  \
+        {                                                                      \
+            ARC_FMT_CHECK_(__VA_ARGS__);                                       \
+            static const ::arc::log::detail::Site arc_log_site_ = {            \
+                ::arc::log::detail::SiteLevel<(level)>::get(),                 \
+                ARC_FMT_FIRST_(__VA_ARGS__, 0),                                \
+                ::arc::fmt::detail::literal_length(                            \
+                    ARC_FMT_FIRST_(__VA_ARGS__, 0)                             \
+                ),                                                             \
+                decltype(::arc::fmt::detail::arg_kinds(__VA_ARGS__))::VALUES,  \
+                decltype(                                                      \
+                    ::arc::log::detail::arg_encodings(__VA_ARGS__)             \
+                )::VALUES,                                                     \
+                __FILE__,                                                      \
+                __LINE__                                                       \
+            };                                                                 \
+            arc_log_logger_.log(arc_log_site_, __VA_ARGS__);                   \
+        }                                                                      \
+    }                                                                          \
+    while(false)
+
+/*!
+ * \brief Logs a message with the level arc::log::Level::kDebug.
+ */
+#define ARC_LOG_DEBUG(logger, ...) \
+    ARC_LOG(logger, ::arc::log::Level::kDebug, __VA_ARGS__)
+
+/*!
+ * \brief Logs a message with the level arc::log::Level::kInfo.
+ */
+#define ARC_LOG_INFO(logger, ...) \
+    ARC_LOG(logger, ::arc::log::Level::kInfo, __VA_ARGS__)
+
+/*!
+ * \brief Logs a message with the level arc::log::Level::kWarning.
+ */
+#define ARC_LOG_WARNING(logger, ...) \
+    ARC_LOG(logger, ::arc::log::Level::kWarning, __VA_ARGS__)
+
+/*!
+ * \brief Logs a message with the level arc::log::Level::kError.
+ */
+#define ARC_LOG_ERROR(logger, ...) \
+    ARC_LOG(logger, ::arc::log::Level::kError, __VA_ARGS__)
+
+#endif
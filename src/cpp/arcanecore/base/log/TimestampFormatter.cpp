@@ -0,0 +1,111 @@
+/*!
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "arcanecore/base/log/TimestampFormatter.hpp"
+
+#include <deus/UnicodeStorage.hpp>
+#include <deus/UnicodeView.hpp>
+
+#include "arcanecore/base/Result.hpp"
+#include "arcanecore/base/clock/ClockOperations.hpp"
+#include "arcanecore/base/fmt/Number.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace log
+{
+
+//------------------------------------------------------------------------------
+//                                  CONSTRUCTOR
+//------------------------------------------------------------------------------
+
+TimestampFormatter::TimestampFormatter()
+    : m_cached_second(~static_cast<arc::clock::TimeInt>(0))
+{
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+void TimestampFormatter::write(
+        arc::lang::StringBuilder& out,
+        arc::clock::TimeInt time)
+{
+    const arc::clock::TimeInt nanoseconds_per_second =
+        static_cast<arc::clock::TimeInt>(arc::clock::TimeMetric::kSeconds);
+    const arc::clock::TimeInt second = time / nanoseconds_per_second;
+    if(second != m_cached_second)
+    {
+        arc::Result<deus::UnicodeStorage> timestamp =
+            arc::clock::try_get_timestamp(
+                second,
+                deus::UnicodeView(
+                    "%Y/%m/%d - %H:%M:%S",
+                    deus::Encoding::kASCII
+                ),
+                arc::clock::TimeMetric::kSeconds
+            );
+        if(timestamp.is_ok())
+        {
+            m_cached_text = timestamp.get_value().get_view().c_str();
+        }
+        else
+        {
+            // fall back to the raw number of seconds
+            char buffer[arc::fmt::MAX_INTEGER_CHARS];
+            m_cached_text.assign(
+                buffer,
+                arc::fmt::write_unsigned(buffer, second)
+            );
+        }
+        m_cached_second = second;
+    }
+
+    const unsigned milliseconds = static_cast<unsigned>(
+        (time % nanoseconds_per_second) /
+        static_cast<arc::clock::TimeInt>(
+            arc::clock::TimeMetric::kMilliseconds
+        )
+    );
+    out
+        << m_cached_text << '.'
+        << static_cast<char>('0' + milliseconds / 100)
+        << static_cast<char>('0' + milliseconds / 10 % 10)
+        << static_cast<char>('0' + milliseconds % 10);
+}
+
+} // namespace log
+ARC_BASE_VERSION_NS_END
+} // namespace arc
@@ -0,0 +1,97 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Writes the timestamps of log lines, caching the formatted second.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_LOG_TIMESTAMPFORMATTER_HPP_
+#define ARCANECORE_BASE_LOG_TIMESTAMPFORMATTER_HPP_
+
+#include <string>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/clock/ClockDefinitions.hpp"
+#include "arcanecore/base/lang/StringBuilder.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace log
+{
+
+/*!
+ * \brief Writes times as the local time with millisecond precision, e.g.
+ *        ```2018/06/02 - 14:03:27.041```.
+ *
+ * The date and time of day are formatted by arc::clock::get_timestamp() with
+ * its default layout, which is only called when the second changes, so
+ * writing the timestamps of consecutive log lines is cheap.
+ */
+class TimestampFormatter
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    TimestampFormatter();
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Appends the timestamp of the given time to the builder.
+     *
+     * \param time The time since Linux Epoch in nanoseconds.
+     */
+    void write(arc::lang::StringBuilder& out, arc::clock::TimeInt time);
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    // the second that was last formatted, and its formatted form
+    arc::clock::TimeInt m_cached_second;
+    std::string m_cached_text;
+};
+
+} // namespace log
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
@@ -0,0 +1,74 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Documents the arc::log namespace.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_LOG_HPP_
+#define ARCANECORE_BASE_LOG_HPP_
+
+#include "arcanecore/base/BaseAPI.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+
+/*!
+ * \brief Module of asynchronous logging.
+ *
+ * Log calls only copy their arguments into a per-thread queue, and the text is
+ * formatted and written by a background thread, so logging never blocks the
+ * calling thread on I/O:
+ *
+ * \code
+ * arc::log::Logger logger(arc::io::FileDescriptorSink::get_stderr());
+ * ARC_LOG_INFO(logger, "Loaded {} assets in {:.1f}ms.", count, elapsed);
+ * \endcode
+ *
+ * Loggers can instead write a compact binary log (see arc::log::binary),
+ * which is read back with arc::log::BinaryDecoder, or rendered as text or JSON
+ * with the arc_logdecode tool:
+ *
+ * \code
+ * arc_logdecode --input app.arclog --json --from "2018/06/02 - 14:00:00"
+ * \endcode
+ */
+namespace log
+{
+} // namespace log
+
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
@@ -0,0 +1,158 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Parallel for_each and transform algorithms.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_PARALLEL_FOREACH_HPP_
+#define ARCANECORE_BASE_PARALLEL_FOREACH_HPP_
+
+#include <cstddef>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/parallel/Partition.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace parallel
+{
+
+/*!
+ * \brief Parallel version of std::for_each().
+ *
+ * The function may be called concurrently and in any order.
+ *
+ * \param first Random access iterator to the first element.
+ * \param last Random access iterator to one past the last element.
+ * \param function Called with each element of the range.
+ * \param grain The largest number of elements processed by one task, if 0
+ *              this is chosen automatically.
+ */
+template<typename RandomIt, typename Function>
+void for_each(
+        RandomIt first,
+        RandomIt last,
+        Function function,
+        std::size_t grain = 0)
+{
+    for_range(
+        0,
+        static_cast<std::size_t>(last - first),
+        [&](std::size_t begin, std::size_t end)
+        {
+            RandomIt it = first + begin;
+            const RandomIt chunk_last = first + end;
+            for(; it != chunk_last; ++it)
+            {
+                function(*it);
+            }
+        },
+        grain
+    );
+}
+
+/*!
+ * \brief Parallel version of std::transform() for one input range.
+ *
+ * The grain size is chosen automatically, use for_range() directly to control
+ * it.
+ *
+ * \return Iterator to one past the last element written.
+ */
+template<typename InputIt, typename OutputIt, typename Function>
+OutputIt transform(
+        InputIt first,
+        InputIt last,
+        OutputIt out,
+        Function function)
+{
+    const std::size_t count = static_cast<std::size_t>(last - first);
+    for_range(
+        0,
+        count,
+        [&](std::size_t begin, std::size_t end)
+        {
+            InputIt it = first + begin;
+            OutputIt o = out + begin;
+            for(std::size_t i = begin; i < end; ++i, ++it, ++o)
+            {
+                *o = function(*it);
+            }
+        }
+    );
+    return out + count;
+}
+
+/*!
+ * \brief Parallel version of std::transform() for two input ranges.
+ *
+ * \return Iterator to one past the last element written.
+ */
+template<
+    typename InputIt1,
+    typename InputIt2,
+    typename OutputIt,
+    typename Function
+>
+OutputIt transform(
+        InputIt1 first1,
+        InputIt1 last1,
+        InputIt2 first2,
+        OutputIt out,
+        Function function)
+{
+    const std::size_t count = static_cast<std::size_t>(last1 - first1);
+    for_range(
+        0,
+        count,
+        [&](std::size_t begin, std::size_t end)
+        {
+            InputIt1 it1 = first1 + begin;
+            InputIt2 it2 = first2 + begin;
+            OutputIt o = out + begin;
+            for(std::size_t i = begin; i < end; ++i, ++it1, ++it2, ++o)
+            {
+                *o = function(*it1, *it2);
+            }
+        }
+    );
+    return out + count;
+}
+
+} // namespace parallel
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
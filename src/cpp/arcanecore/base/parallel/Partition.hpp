@@ -0,0 +1,226 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Utilities for splitting ranges into tasks.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_PARALLEL_PARTITION_HPP_
+#define ARCANECORE_BASE_PARALLEL_PARTITION_HPP_
+
+#include <cstddef>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/task/Scheduler.hpp"
+#include "arcanecore/base/task/TaskGroup.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace parallel
+{
+
+//------------------------------------------------------------------------------
+//                                   CONSTANTS
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief The smallest number of elements processed by a single task when the
+ *        grain size is chosen automatically.
+ *
+ * This keeps the cost of spawning a task small relative to the work done by
+ * the task for cheap per element operations.
+ */
+static const std::size_t MIN_GRAIN_SIZE = 4096;
+
+/*!
+ * \brief The number of chunks per worker a range is split into when the grain
+ *        size is chosen automatically.
+ *
+ * Splitting into more chunks than workers lets idle workers steal from busy
+ * workers when chunks take an uneven amount of time.
+ */
+static const std::size_t CHUNKS_PER_WORKER = 8;
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief Returns the scheduler parallel algorithms called from the current
+ *        thread should use.
+ *
+ * This is the scheduler of the current worker thread, or the default
+ * scheduler if the current thread is not a worker.
+ */
+inline arc::task::Scheduler& get_scheduler()
+{
+    arc::task::Scheduler* current = arc::task::Scheduler::get_current();
+    return current != nullptr ? *current : arc::task::Scheduler::get_default();
+}
+
+/*!
+ * \brief Returns the number of elements each task should process for a range
+ *        of the given size.
+ *
+ * Ranges no larger than the minimum grain size are a single grain, which is
+ * decided without touching a scheduler, so that small ranges are processed
+ * serially without creating the default scheduler.
+ *
+ * \param count The number of elements in the range.
+ * \param min_grain The minimum number of elements a task should process.
+ */
+inline std::size_t get_grain_size(
+        std::size_t count,
+        std::size_t min_grain = MIN_GRAIN_SIZE)
+{
+    if(min_grain == 0)
+    {
+        min_grain = 1;
+    }
+    if(count <= min_grain)
+    {
+        return min_grain;
+    }
+
+    const std::size_t chunks =
+        get_scheduler().get_worker_count() * CHUNKS_PER_WORKER;
+    const std::size_t grain = (count + chunks - 1) / chunks;
+    return grain > min_grain ? grain : min_grain;
+}
+
+/*!
+ * \brief Calls the given function on a worker thread of the scheduler
+ *        returned by get_scheduler(), waiting for it to finish.
+ *
+ * If the current thread is already a worker the function is called directly,
+ * otherwise it is executed as a task so that it may help execute the tasks it
+ * spawns. Exceptions thrown by the function are rethrown.
+ *
+ * \param function Function which will be passed the scheduler.
+ */
+template<typename Function>
+void run_on_scheduler(Function function)
+{
+    arc::task::Scheduler* current = arc::task::Scheduler::get_current();
+    if(current != nullptr)
+    {
+        function(*current);
+        return;
+    }
+
+    arc::task::Scheduler& scheduler = arc::task::Scheduler::get_default();
+    arc::task::TaskGroup group(scheduler);
+    group.spawn([&]() { function(scheduler); });
+    group.wait();
+}
+
+/*!
+ * \brief Calls the given function in parallel on chunks of the range
+ *        [begin, end) which are no larger than the given grain size.
+ *
+ * The range is split in half recursively, so chunks near each other are
+ * likely to be processed by the same worker.
+ *
+ * \param scheduler The scheduler to spawn tasks on, the calling thread must be
+ *                  a worker of this scheduler.
+ * \param begin The first index of the range.
+ * \param end The index one past the end of the range.
+ * \param grain The largest number of indices passed to a single call.
+ * \param function Called with the begin and end index of each chunk.
+ */
+template<typename Function>
+void split_range(
+        arc::task::Scheduler& scheduler,
+        std::size_t begin,
+        std::size_t end,
+        std::size_t grain,
+        const Function& function)
+{
+    arc::task::TaskGroup group(scheduler);
+    while(end - begin > grain)
+    {
+        // spawn the upper half and continue splitting the lower half
+        const std::size_t middle = begin + (end - begin) / 2;
+        group.spawn([&scheduler, middle, end, grain, &function]()
+        {
+            split_range(scheduler, middle, end, grain, function);
+        });
+        end = middle;
+    }
+    function(begin, end);
+    group.wait();
+}
+
+/*!
+ * \brief Calls the given function in parallel on chunks of the range
+ *        [begin, end).
+ *
+ * \param begin The first index of the range.
+ * \param end The index one past the end of the range.
+ * \param function Called with the begin and end index of each chunk.
+ * \param grain The largest number of indices passed to a single call, if 0
+ *              this is chosen by get_grain_size().
+ */
+template<typename Function>
+void for_range(
+        std::size_t begin,
+        std::size_t end,
+        const Function& function,
+        std::size_t grain = 0)
+{
+    if(end <= begin)
+    {
+        return;
+    }
+    if(grain == 0)
+    {
+        grain = get_grain_size(end - begin);
+    }
+    if(end - begin <= grain)
+    {
+        function(begin, end);
+        return;
+    }
+
+    run_on_scheduler([&](arc::task::Scheduler& scheduler)
+    {
+        split_range(scheduler, begin, end, grain, function);
+    });
+}
+
+} // namespace parallel
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
@@ -0,0 +1,239 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Parallel reduce and transform_reduce algorithms.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_PARALLEL_REDUCE_HPP_
+#define ARCANECORE_BASE_PARALLEL_REDUCE_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/parallel/Partition.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace parallel
+{
+
+/*!
+ * \brief Reduces the count (at least 1) transformed elements starting at the
+ *        given iterator in parallel.
+ *
+ * The elements are combined in order, so the operation only needs to be
+ * associative (not commutative).
+ *
+ * \param scheduler The scheduler to spawn tasks on, the calling thread must be
+ *                  a worker of this scheduler.
+ */
+template<
+    typename T,
+    typename RandomIt,
+    typename ReduceOp,
+    typename TransformOp
+>
+T reduce_chunks(
+        arc::task::Scheduler& scheduler,
+        RandomIt first,
+        std::size_t count,
+        std::size_t grain,
+        const ReduceOp& reduce_op,
+        const TransformOp& transform_op)
+{
+    if(count <= grain)
+    {
+        T result = transform_op(*first);
+        for(std::size_t i = 1; i < count; ++i)
+        {
+            result = reduce_op(std::move(result), transform_op(first[i]));
+        }
+        return result;
+    }
+
+    // holds the result of the other task, which T may not be default
+    // constructible for
+    struct Result
+    {
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+        bool constructed;
+
+        T& get()
+        {
+            return *reinterpret_cast<T*>(&storage);
+        }
+
+        ~Result()
+        {
+            if(constructed)
+            {
+                get().~T();
+            }
+        }
+    };
+
+    const std::size_t half = count / 2;
+    Result right;
+    right.constructed = false;
+    arc::task::TaskGroup group(scheduler);
+    group.spawn([&]()
+    {
+        new(&right.storage) T(
+            reduce_chunks<T>(
+                scheduler,
+                first + half,
+                count - half,
+                grain,
+                reduce_op,
+                transform_op
+            )
+        );
+        right.constructed = true;
+    });
+    T left = reduce_chunks<T>(
+        scheduler,
+        first,
+        half,
+        grain,
+        reduce_op,
+        transform_op
+    );
+    group.wait();
+    return reduce_op(std::move(left), std::move(right.get()));
+}
+
+/*!
+ * \brief Parallel version of std::transform_reduce() (C++17) for one input
+ *        range.
+ *
+ * Each element is transformed with transform_op, and the results are combined
+ * with reduce_op, which must be associative. The results are combined in the
+ * order of the elements, so reduce_op does not need to be commutative.
+ *
+ * \param first Random access iterator to the first element.
+ * \param last Random access iterator to one past the last element.
+ * \param init The initial value of the reduction.
+ * \param reduce_op Binary operation which combines two values of type T.
+ * \param transform_op Unary operation which converts an element to type T.
+ */
+template<
+    typename RandomIt,
+    typename T,
+    typename ReduceOp,
+    typename TransformOp
+>
+T transform_reduce(
+        RandomIt first,
+        RandomIt last,
+        T init,
+        ReduceOp reduce_op,
+        TransformOp transform_op)
+{
+    const std::size_t count = static_cast<std::size_t>(last - first);
+    if(count == 0)
+    {
+        return init;
+    }
+
+    const std::size_t grain = get_grain_size(count);
+    if(count <= grain)
+    {
+        for(; first != last; ++first)
+        {
+            init = reduce_op(std::move(init), transform_op(*first));
+        }
+        return init;
+    }
+
+    run_on_scheduler([&](arc::task::Scheduler& scheduler)
+    {
+        init = reduce_op(
+            std::move(init),
+            reduce_chunks<T>(
+                scheduler,
+                first,
+                count,
+                grain,
+                reduce_op,
+                transform_op
+            )
+        );
+    });
+    return init;
+}
+
+/*!
+ * \brief Parallel version of std::reduce() (C++17).
+ *
+ * The elements are combined with reduce_op, which must be associative. The
+ * elements are combined in order, so reduce_op does not need to be
+ * commutative.
+ *
+ * \param first Random access iterator to the first element.
+ * \param last Random access iterator to one past the last element.
+ * \param init The initial value of the reduction.
+ * \param reduce_op Binary operation which combines two values of type T.
+ */
+template<typename RandomIt, typename T, typename ReduceOp>
+T reduce(RandomIt first, RandomIt last, T init, ReduceOp reduce_op)
+{
+    typedef decltype(*first) Reference;
+    return arc::parallel::transform_reduce(
+        first,
+        last,
+        std::move(init),
+        reduce_op,
+        [](Reference element) -> T { return element; }
+    );
+}
+
+/*!
+ * \brief Parallel version of std::reduce() (C++17) which sums the elements.
+ */
+template<typename RandomIt, typename T>
+T reduce(RandomIt first, RandomIt last, T init)
+{
+    return arc::parallel::reduce(first, last, std::move(init), std::plus<T>());
+}
+
+} // namespace parallel
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
@@ -0,0 +1,237 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Parallel inclusive and exclusive prefix scan algorithms.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_PARALLEL_SCAN_HPP_
+#define ARCANECORE_BASE_PARALLEL_SCAN_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/parallel/Partition.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace parallel
+{
+
+/*!
+ * \brief Computes a prefix scan of the given range in parallel.
+ *
+ * This makes two passes over the data: the first reduces each chunk, and once
+ * the chunk totals have been scanned serially, the second scans each chunk
+ * starting from the total of the chunks before it. The output may be the same
+ * range as the input.
+ *
+ * \param first Random access iterator to the first element.
+ * \param last Random access iterator to one past the last element.
+ * \param out Random access iterator to the first element of the output.
+ * \param init The value combined before the first element.
+ * \param inclusive Whether the i-th output includes the i-th input.
+ * \param op Associative binary operation.
+ *
+ * \return Iterator to one past the last element written.
+ */
+template<typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+OutputIt scan(
+        InputIt first,
+        InputIt last,
+        OutputIt out,
+        T init,
+        bool inclusive,
+        BinaryOp op)
+{
+    const std::size_t count = static_cast<std::size_t>(last - first);
+    const std::size_t grain = get_grain_size(count);
+
+    // scans [begin, end) starting from the given total
+    auto scan_chunk = [&](std::size_t begin, std::size_t end, T total)
+    {
+        for(std::size_t i = begin; i < end; ++i)
+        {
+            if(inclusive)
+            {
+                total = op(std::move(total), first[i]);
+                out[i] = total;
+            }
+            else
+            {
+                // read before writing, in case the output is the input
+                T next = op(total, first[i]);
+                out[i] = std::move(total);
+                total = std::move(next);
+            }
+        }
+    };
+
+    if(count <= grain)
+    {
+        scan_chunk(0, count, std::move(init));
+        return out + count;
+    }
+
+    // reduce each chunk
+    const std::size_t chunks = (count + grain - 1) / grain;
+    std::vector<T> totals(chunks, init);
+    for_range(
+        0,
+        chunks,
+        [&](std::size_t chunk_begin, std::size_t chunk_end)
+        {
+            for(std::size_t c = chunk_begin; c < chunk_end; ++c)
+            {
+                const std::size_t begin = c * grain;
+                const std::size_t end =
+                    begin + grain < count ? begin + grain : count;
+                T total = first[begin];
+                for(std::size_t i = begin + 1; i < end; ++i)
+                {
+                    total = op(std::move(total), first[i]);
+                }
+                totals[c] = std::move(total);
+            }
+        },
+        1
+    );
+
+    // find the value each chunk starts from
+    T total = std::move(init);
+    for(std::size_t c = 0; c < chunks; ++c)
+    {
+        T next = op(total, totals[c]);
+        totals[c] = std::move(total);
+        total = std::move(next);
+    }
+
+    // scan each chunk
+    for_range(
+        0,
+        chunks,
+        [&](std::size_t chunk_begin, std::size_t chunk_end)
+        {
+            for(std::size_t c = chunk_begin; c < chunk_end; ++c)
+            {
+                const std::size_t begin = c * grain;
+                const std::size_t end =
+                    begin + grain < count ? begin + grain : count;
+                scan_chunk(begin, end, totals[c]);
+            }
+        },
+        1
+    );
+    return out + count;
+}
+
+/*!
+ * \brief Parallel version of std::inclusive_scan() (C++17).
+ *
+ * The operation must be associative.
+ *
+ * \return Iterator to one past the last element written.
+ */
+template<typename InputIt, typename OutputIt, typename BinaryOp>
+OutputIt inclusive_scan(
+        InputIt first,
+        InputIt last,
+        OutputIt out,
+        BinaryOp op)
+{
+    typedef typename std::iterator_traits<InputIt>::value_type T;
+    if(first == last)
+    {
+        return out;
+    }
+    // the first element is the initial value
+    T init = *first;
+    *out = init;
+    return scan(first + 1, last, out + 1, std::move(init), true, op);
+}
+
+/*!
+ * \brief Parallel version of std::inclusive_scan() (C++17) which computes
+ *        the prefix sums.
+ */
+template<typename InputIt, typename OutputIt>
+OutputIt inclusive_scan(InputIt first, InputIt last, OutputIt out)
+{
+    typedef typename std::iterator_traits<InputIt>::value_type T;
+    return arc::parallel::inclusive_scan(first, last, out, std::plus<T>());
+}
+
+/*!
+ * \brief Parallel version of std::exclusive_scan() (C++17).
+ *
+ * The operation must be associative.
+ *
+ * \return Iterator to one past the last element written.
+ */
+template<typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+OutputIt exclusive_scan(
+        InputIt first,
+        InputIt last,
+        OutputIt out,
+        T init,
+        BinaryOp op)
+{
+    return scan(first, last, out, std::move(init), false, op);
+}
+
+/*!
+ * \brief Parallel version of std::exclusive_scan() (C++17) which computes
+ *        the prefix sums.
+ */
+template<typename InputIt, typename OutputIt, typename T>
+OutputIt exclusive_scan(InputIt first, InputIt last, OutputIt out, T init)
+{
+    return arc::parallel::exclusive_scan(
+        first,
+        last,
+        out,
+        std::move(init),
+        std::plus<T>()
+    );
+}
+
+} // namespace parallel
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
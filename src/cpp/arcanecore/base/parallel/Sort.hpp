@@ -0,0 +1,531 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Parallel radix and merge sort algorithms.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_PARALLEL_SORT_HPP_
+#define ARCANECORE_BASE_PARALLEL_SORT_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/parallel/Partition.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace parallel
+{
+
+//------------------------------------------------------------------------------
+//                                   CONSTANTS
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief The minimum number of elements each task of a parallel sort will
+ *        process.
+ */
+static const std::size_t SORT_GRAIN_SIZE = 16384;
+
+/*!
+ * \brief The number of bits of the key sorted by each pass of radix_sort().
+ */
+static const std::size_t RADIX_BITS = 8;
+
+//------------------------------------------------------------------------------
+//                                   RADIX SORT
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief Converts an integral key to an unsigned integer with the same order.
+ */
+template<typename Key>
+typename std::make_unsigned<Key>::type to_radix(Key key)
+{
+    typedef typename std::make_unsigned<Key>::type Unsigned;
+    // flip the sign bit so that negative numbers come first
+    const Unsigned sign_bit = std::is_signed<Key>::value
+        ? static_cast<Unsigned>(
+            static_cast<Unsigned>(1) <<
+            (std::numeric_limits<Unsigned>::digits - 1)
+        )
+        : 0;
+    return static_cast<Unsigned>(key) ^ sign_bit;
+}
+
+/*!
+ * \brief Performs a single pass of radix_sort(), moving elements from the
+ *        source to the destination ordered by the digit at the given shift.
+ *
+ * \param counts The per block histograms of the digits, which will be
+ *               overwritten.
+ */
+template<typename SourceIt, typename DestIt, typename KeyFunction>
+void radix_pass(
+        SourceIt source,
+        DestIt dest,
+        std::size_t count,
+        std::size_t grain,
+        std::size_t shift,
+        const KeyFunction& key,
+        std::vector<std::size_t>& counts)
+{
+    static const std::size_t RADIX = std::size_t(1) << RADIX_BITS;
+    const std::size_t blocks = counts.size() / RADIX;
+
+    // offset every block's digits so that digits are in order, and blocks
+    // are in order within each digit (which makes the sort stable)
+    std::size_t offset = 0;
+    for(std::size_t digit = 0; digit < RADIX; ++digit)
+    {
+        for(std::size_t block = 0; block < blocks; ++block)
+        {
+            const std::size_t block_count = counts[block * RADIX + digit];
+            counts[block * RADIX + digit] = offset;
+            offset += block_count;
+        }
+    }
+
+    for_range(
+        0,
+        blocks,
+        [&](std::size_t block_begin, std::size_t block_end)
+        {
+            for(std::size_t block = block_begin; block < block_end; ++block)
+            {
+                std::size_t* offsets = &counts[block * RADIX];
+                const std::size_t begin = block * grain;
+                const std::size_t end =
+                    begin + grain < count ? begin + grain : count;
+                for(std::size_t i = begin; i < end; ++i)
+                {
+                    const std::size_t digit = static_cast<std::size_t>(
+                        (to_radix(key(source[i])) >> shift) & (RADIX - 1)
+                    );
+                    dest[offsets[digit]++] = std::move(source[i]);
+                }
+            }
+        },
+        1
+    );
+}
+
+/*!
+ * \brief Sorts the given range in parallel by an integral key using a least
+ *        significant digit radix sort.
+ *
+ * This is a stable sort which takes time linear in the number of elements, so
+ * it is much faster than a comparison sort for large numbers of integers (such
+ * as arc::clock::TimeInt timestamps). Passes for digits which are the same for
+ * every element are skipped.
+ *
+ * \param first Random access iterator to the first element.
+ * \param last Random access iterator to one past the last element.
+ * \param key Function which returns the integral key of an element.
+ */
+template<typename RandomIt, typename KeyFunction>
+void radix_sort(RandomIt first, RandomIt last, KeyFunction key)
+{
+    typedef typename std::iterator_traits<RandomIt>::value_type T;
+    typedef typename std::decay<decltype(key(*first))>::type Key;
+    static_assert(
+        std::is_integral<Key>::value,
+        "radix_sort keys must be integral"
+    );
+    static const std::size_t RADIX = std::size_t(1) << RADIX_BITS;
+
+    const std::size_t count = static_cast<std::size_t>(last - first);
+    if(count < 2)
+    {
+        return;
+    }
+    const std::size_t grain = get_grain_size(count, SORT_GRAIN_SIZE);
+    const std::size_t blocks = (count + grain - 1) / grain;
+
+    // the elements are ping-ponged between the range and the buffer
+    std::vector<T> buffer(
+        std::make_move_iterator(first),
+        std::make_move_iterator(last)
+    );
+    bool in_buffer = true;
+
+    std::vector<std::size_t> counts(blocks * RADIX);
+    for(std::size_t shift = 0;
+        shift < sizeof(Key) * 8;
+        shift += RADIX_BITS)
+    {
+        // count the digits of each block
+        for_range(
+            0,
+            blocks,
+            [&](std::size_t block_begin, std::size_t block_end)
+            {
+                for(std::size_t block = block_begin;
+                    block < block_end;
+                    ++block)
+                {
+                    std::size_t* histogram = &counts[block * RADIX];
+                    std::fill(histogram, histogram + RADIX, 0);
+                    const std::size_t begin = block * grain;
+                    const std::size_t end =
+                        begin + grain < count ? begin + grain : count;
+                    for(std::size_t i = begin; i < end; ++i)
+                    {
+                        const Key k =
+                            in_buffer ? key(buffer[i]) : key(first[i]);
+                        ++histogram[(to_radix(k) >> shift) & (RADIX - 1)];
+                    }
+                }
+            },
+            1
+        );
+
+        // skip the pass if every element has the same digit
+        bool skip = false;
+        for(std::size_t digit = 0; digit < RADIX && !skip; ++digit)
+        {
+            std::size_t total = 0;
+            for(std::size_t block = 0; block < blocks; ++block)
+            {
+                total += counts[block * RADIX + digit];
+            }
+            skip = total == count;
+        }
+        if(skip)
+        {
+            continue;
+        }
+
+        if(in_buffer)
+        {
+            radix_pass(buffer.begin(), first, count, grain, shift, key, counts);
+        }
+        else
+        {
+            radix_pass(first, buffer.begin(), count, grain, shift, key, counts);
+        }
+        in_buffer = !in_buffer;
+    }
+
+    if(in_buffer)
+    {
+        for_range(
+            0,
+            count,
+            [&](std::size_t begin, std::size_t end)
+            {
+                std::move(
+                    buffer.begin() + begin,
+                    buffer.begin() + end,
+                    first + begin
+                );
+            }
+        );
+    }
+}
+
+//------------------------------------------------------------------------------
+//                                   MERGE SORT
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief Moves the two sorted ranges X and Y into the output in sorted order,
+ *        in parallel.
+ *
+ * Elements of X come before equal elements of Y. The larger range is split at
+ * its middle element, and the other range is split at the position of that
+ * element found with a binary search, so both halves can be merged in
+ * parallel.
+ */
+template<typename InputIt, typename OutputIt, typename Compare>
+void merge_chunks(
+        arc::task::Scheduler& scheduler,
+        InputIt x,
+        std::size_t x_count,
+        InputIt y,
+        std::size_t y_count,
+        OutputIt out,
+        std::size_t grain,
+        const Compare& comp)
+{
+    if(x_count + y_count <= grain)
+    {
+        std::merge(
+            std::make_move_iterator(x),
+            std::make_move_iterator(x + x_count),
+            std::make_move_iterator(y),
+            std::make_move_iterator(y + y_count),
+            out,
+            comp
+        );
+        return;
+    }
+
+    std::size_t x_split = 0;
+    std::size_t y_split = 0;
+    if(x_count >= y_count)
+    {
+        x_split = x_count / 2;
+        y_split = static_cast<std::size_t>(
+            std::lower_bound(y, y + y_count, x[x_split], comp) - y
+        );
+    }
+    else
+    {
+        y_split = y_count / 2;
+        x_split = static_cast<std::size_t>(
+            std::upper_bound(x, x + x_count, y[y_split], comp) - x
+        );
+    }
+
+    arc::task::TaskGroup group(scheduler);
+    group.spawn([&]()
+    {
+        merge_chunks(
+            scheduler,
+            x + x_split,
+            x_count - x_split,
+            y + y_split,
+            y_count - y_split,
+            out + (x_split + y_split),
+            grain,
+            comp
+        );
+    });
+    merge_chunks(scheduler, x, x_split, y, y_split, out, grain, comp);
+    group.wait();
+}
+
+/*!
+ * \brief Sorts the count elements of A in parallel, leaving the result in B
+ *        if to_b is true, or otherwise in A.
+ *
+ * B must contain count assignable elements which are used as scratch space.
+ */
+template<typename AIt, typename BIt, typename Compare>
+void merge_sort_chunks(
+        arc::task::Scheduler& scheduler,
+        AIt a,
+        BIt b,
+        std::size_t count,
+        std::size_t grain,
+        bool to_b,
+        const Compare& comp)
+{
+    if(count <= grain)
+    {
+        std::sort(a, a + count, comp);
+        if(to_b)
+        {
+            std::move(a, a + count, b);
+        }
+        return;
+    }
+
+    // sort each half into the other array, then merge them back
+    const std::size_t half = count / 2;
+    arc::task::TaskGroup group(scheduler);
+    group.spawn([&]()
+    {
+        merge_sort_chunks(
+            scheduler,
+            a + half,
+            b + half,
+            count - half,
+            grain,
+            !to_b,
+            comp
+        );
+    });
+    merge_sort_chunks(scheduler, a, b, half, grain, !to_b, comp);
+    group.wait();
+
+    if(to_b)
+    {
+        merge_chunks(
+            scheduler,
+            a,
+            half,
+            a + half,
+            count - half,
+            b,
+            grain,
+            comp
+        );
+    }
+    else
+    {
+        merge_chunks(
+            scheduler,
+            b,
+            half,
+            b + half,
+            count - half,
+            a,
+            grain,
+            comp
+        );
+    }
+}
+
+/*!
+ * \brief Sorts the given range in parallel using a merge sort.
+ *
+ * Chunks of the range are sorted with std::sort() and then merged in
+ * parallel. Like std::sort() this is not a stable sort.
+ *
+ * \param first Random access iterator to the first element.
+ * \param last Random access iterator to one past the last element.
+ * \param comp Strict weak ordering of the elements.
+ */
+template<typename RandomIt, typename Compare>
+void merge_sort(RandomIt first, RandomIt last, Compare comp)
+{
+    typedef typename std::iterator_traits<RandomIt>::value_type T;
+
+    const std::size_t count = static_cast<std::size_t>(last - first);
+    const std::size_t grain = get_grain_size(count, SORT_GRAIN_SIZE);
+    if(count <= grain)
+    {
+        std::sort(first, last, comp);
+        return;
+    }
+
+    std::vector<T> buffer(
+        std::make_move_iterator(first),
+        std::make_move_iterator(last)
+    );
+    run_on_scheduler([&](arc::task::Scheduler& scheduler)
+    {
+        merge_sort_chunks(
+            scheduler,
+            buffer.begin(),
+            first,
+            count,
+            grain,
+            true,
+            comp
+        );
+    });
+}
+
+//------------------------------------------------------------------------------
+//                                      SORT
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief Returns the element it is given, used as the key of radix_sort()
+ *        for integral elements.
+ */
+struct IdentityKey
+{
+    template<typename T>
+    T operator()(const T& value) const
+    {
+        return value;
+    }
+};
+
+/*!
+ * \brief Sorts integral elements (other than bool) with radix_sort(), or with
+ *        std::sort() if there are too few to be worth its buffer and passes.
+ */
+template<typename RandomIt>
+void sort_dispatch(RandomIt first, RandomIt last, std::true_type)
+{
+    const std::size_t count = static_cast<std::size_t>(last - first);
+    if(count <= get_grain_size(count, SORT_GRAIN_SIZE))
+    {
+        std::sort(first, last);
+        return;
+    }
+    radix_sort(first, last, IdentityKey());
+}
+
+/*!
+ * \brief Sorts non-integral elements with merge_sort().
+ */
+template<typename RandomIt>
+void sort_dispatch(RandomIt first, RandomIt last, std::false_type)
+{
+    typedef typename std::iterator_traits<RandomIt>::value_type T;
+    merge_sort(first, last, std::less<T>());
+}
+
+/*!
+ * \brief Parallel version of std::sort() with a custom comparison.
+ *
+ * This is a parallel merge_sort().
+ */
+template<typename RandomIt, typename Compare>
+void sort(RandomIt first, RandomIt last, Compare comp)
+{
+    merge_sort(first, last, comp);
+}
+
+/*!
+ * \brief Parallel version of std::sort() which sorts the elements in
+ *        ascending order.
+ *
+ * Integral elements (including arc::clock::TimeInt) are sorted with
+ * radix_sort(), other elements with merge_sort(). Either falls back to
+ * std::sort() for ranges no larger than a single grain.
+ */
+template<typename RandomIt>
+void sort(RandomIt first, RandomIt last)
+{
+    typedef typename std::iterator_traits<RandomIt>::value_type T;
+    sort_dispatch(
+        first,
+        last,
+        std::integral_constant<
+            bool,
+            std::is_integral<T>::value && !std::is_same<T, bool>::value
+        >()
+    );
+}
+
+} // namespace parallel
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
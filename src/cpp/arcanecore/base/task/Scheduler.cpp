@@ -0,0 +1,393 @@
+/*!
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "arcanecore/base/task/Scheduler.hpp"
+
+#include <exception>
+
+#include "arcanecore/base/Exceptions.hpp"
+#include "arcanecore/base/Preproc.hpp"
+#include "arcanecore/base/lang/StringBuilder.hpp"
+#include "arcanecore/base/task/TaskGroup.hpp"
+
+#if defined(ARC_OS_WINDOWS)
+    #include <windows.h>
+#elif defined(ARC_OS_LINUX)
+    #include <pthread.h>
+    #include <sched.h>
+#endif
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace task
+{
+
+namespace
+{
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+// returns a pseudo random number which is unique to the calling thread
+std::uint32_t next_random()
+{
+    static thread_local std::uint32_t state = 0;
+    if(state == 0)
+    {
+        // seed from the address of the state, which differs between threads
+        state = static_cast<std::uint32_t>(
+            reinterpret_cast<std::uintptr_t>(&state) >> 4
+        ) | 1;
+    }
+    // xorshift32
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+// pins the given thread to the given CPU
+void pin_thread(std::thread& thread, std::size_t cpu)
+{
+#if defined(ARC_OS_WINDOWS)
+    SetThreadAffinityMask(
+        thread.native_handle(),
+        static_cast<DWORD_PTR>(1) << (cpu % (sizeof(DWORD_PTR) * 8))
+    );
+#elif defined(ARC_OS_LINUX)
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(cpu % CPU_SETSIZE, &cpus);
+    pthread_setaffinity_np(thread.native_handle(), sizeof(cpus), &cpus);
+#else
+    // not supported
+    static_cast<void>(thread);
+    static_cast<void>(cpu);
+#endif
+}
+
+// increments a counter which is only ever written by one thread
+void increment(std::atomic<std::uint64_t>& counter)
+{
+    counter.store(
+        counter.load(std::memory_order_relaxed) + 1,
+        std::memory_order_relaxed
+    );
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                     WORKER
+//------------------------------------------------------------------------------
+
+struct Scheduler::Worker
+{
+    // the scheduler the worker belongs to
+    Scheduler* scheduler;
+    // the tasks spawned on this worker
+    WorkStealingDeque<Task> deque;
+    // keeps the statistics off the cache line of the deque's bottom index
+    char padding[ARC_CACHE_LINE_SIZE];
+    // statistics (only written by the worker's thread)
+    std::atomic<std::uint64_t> executed;
+    std::atomic<std::uint64_t> spawned;
+    std::atomic<std::uint64_t> stolen;
+    std::atomic<std::uint64_t> steal_attempts;
+
+    Worker(Scheduler* scheduler_)
+        : scheduler     (scheduler_)
+        , executed      (0)
+        , spawned       (0)
+        , stolen        (0)
+        , steal_attempts(0)
+    {
+    }
+};
+
+//------------------------------------------------------------------------------
+//                           PRIVATE STATIC ATTRIBUTES
+//------------------------------------------------------------------------------
+
+thread_local Scheduler::Worker* Scheduler::s_current_worker = nullptr;
+
+//------------------------------------------------------------------------------
+//                                  CONSTRUCTORS
+//------------------------------------------------------------------------------
+
+Scheduler::Scheduler(std::size_t worker_count, bool pin_threads)
+    : m_pin_threads(pin_threads)
+    , m_injected   (INJECTION_CAPACITY)
+    , m_stopping   (false)
+{
+    if(worker_count == 0)
+    {
+        worker_count = std::thread::hardware_concurrency();
+        if(worker_count == 0)
+        {
+            worker_count = 1;
+        }
+    }
+
+    // all workers must exist before any thread starts stealing
+    m_workers.reserve(worker_count);
+    for(std::size_t i = 0; i < worker_count; ++i)
+    {
+        m_workers.emplace_back(new Worker(this));
+    }
+
+    m_threads.reserve(worker_count);
+    for(std::size_t i = 0; i < worker_count; ++i)
+    {
+        m_threads.emplace_back(
+            &Scheduler::run_worker,
+            this,
+            m_workers[i].get()
+        );
+        if(m_pin_threads)
+        {
+            pin_thread(m_threads.back(), i);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+//                                   DESTRUCTOR
+//------------------------------------------------------------------------------
+
+Scheduler::~Scheduler()
+{
+    // workers only exit once they can't find any more tasks
+    m_stopping.store(true, std::memory_order_release);
+    m_idle.notify_all();
+    for(std::thread& thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC STATIC FUNCTIONS
+//------------------------------------------------------------------------------
+
+Scheduler& Scheduler::get_default()
+{
+    static Scheduler scheduler;
+    return scheduler;
+}
+
+Scheduler* Scheduler::get_current()
+{
+    Worker* worker = s_current_worker;
+    return worker != nullptr ? worker->scheduler : nullptr;
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+std::size_t Scheduler::get_worker_count() const
+{
+    return m_workers.size();
+}
+
+bool Scheduler::get_pin_threads() const
+{
+    return m_pin_threads;
+}
+
+WorkerStats Scheduler::get_worker_stats(std::size_t index) const
+{
+    if(index >= m_workers.size())
+    {
+        arc::lang::StringBuilder message;
+        message << "Scheduler worker index is out of range: " << index;
+        throw arc::ex::ValueError(message.c_str());
+    }
+
+    const Worker& worker = *m_workers[index];
+    WorkerStats stats;
+    stats.executed = worker.executed.load(std::memory_order_relaxed);
+    stats.spawned = worker.spawned.load(std::memory_order_relaxed);
+    stats.stolen = worker.stolen.load(std::memory_order_relaxed);
+    stats.steal_attempts =
+        worker.steal_attempts.load(std::memory_order_relaxed);
+    return stats;
+}
+
+WorkerStats Scheduler::get_total_stats() const
+{
+    WorkerStats total = {0, 0, 0, 0};
+    for(std::size_t i = 0; i < m_workers.size(); ++i)
+    {
+        const WorkerStats stats = get_worker_stats(i);
+        total.executed += stats.executed;
+        total.spawned += stats.spawned;
+        total.stolen += stats.stolen;
+        total.steal_attempts += stats.steal_attempts;
+    }
+    return total;
+}
+
+//------------------------------------------------------------------------------
+//                            PRIVATE MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+Scheduler::Worker* Scheduler::get_current_worker() const
+{
+    Worker* worker = s_current_worker;
+    if(worker != nullptr && worker->scheduler == this)
+    {
+        return worker;
+    }
+    return nullptr;
+}
+
+void Scheduler::spawn_task(Task* task)
+{
+    Worker* worker = get_current_worker();
+    if(worker != nullptr)
+    {
+        worker->deque.push(task);
+        increment(worker->spawned);
+    }
+    else if(!m_injected.try_push(task))
+    {
+        // the injection queue is full so the workers are busy anyway
+        execute(nullptr, task);
+        return;
+    }
+    m_idle.notify_one();
+}
+
+Task* Scheduler::find_task(Worker* worker)
+{
+    Task* task = nullptr;
+    if(worker != nullptr)
+    {
+        task = worker->deque.pop();
+        if(task != nullptr)
+        {
+            return task;
+        }
+    }
+
+    if(m_injected.try_pop(task))
+    {
+        return task;
+    }
+
+    // try each other worker once, starting from a random worker
+    const std::size_t count = m_workers.size();
+    const std::size_t start = next_random() % count;
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        Worker* victim = m_workers[(start + i) % count].get();
+        if(victim == worker || victim->deque.empty())
+        {
+            continue;
+        }
+
+        task = victim->deque.steal();
+        if(worker != nullptr)
+        {
+            increment(worker->steal_attempts);
+            if(task != nullptr)
+            {
+                increment(worker->stolen);
+            }
+        }
+        if(task != nullptr)
+        {
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+void Scheduler::execute(Worker* worker, Task* task)
+{
+    TaskGroup* group = task->get_group();
+    try
+    {
+        task->run();
+    }
+    catch(...)
+    {
+        if(group == nullptr)
+        {
+            // detached tasks have nowhere to report exceptions
+            std::terminate();
+        }
+        group->set_exception(std::current_exception());
+    }
+    m_task_pool.destroy(task);
+
+    if(worker != nullptr)
+    {
+        increment(worker->executed);
+    }
+    if(group != nullptr)
+    {
+        group->finish();
+    }
+}
+
+void Scheduler::run_worker(Worker* worker)
+{
+    s_current_worker = worker;
+
+    Task* task = nullptr;
+    while(true)
+    {
+        m_idle.wait_until([&]()
+        {
+            task = find_task(worker);
+            return task != nullptr ||
+                   m_stopping.load(std::memory_order_acquire);
+        });
+        if(task == nullptr)
+        {
+            break;
+        }
+        execute(worker, task);
+    }
+
+    s_current_worker = nullptr;
+}
+
+} // namespace task
+ARC_BASE_VERSION_NS_END
+} // namespace arc
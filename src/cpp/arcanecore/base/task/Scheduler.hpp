@@ -0,0 +1,279 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Work-stealing scheduler which executes tasks on a pool of worker
+ *        threads.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_TASK_SCHEDULER_HPP_
+#define ARCANECORE_BASE_TASK_SCHEDULER_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/lang/MpmcQueue.hpp"
+#include "arcanecore/base/lang/ObjectPool.hpp"
+#include "arcanecore/base/lang/Restrictors.hpp"
+#include "arcanecore/base/lang/WaitStrategy.hpp"
+#include "arcanecore/base/task/Task.hpp"
+#include "arcanecore/base/task/WorkStealingDeque.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace task
+{
+
+/*!
+ * \brief Counters describing the work performed by a single worker thread of
+ *        an arc::task::Scheduler.
+ */
+struct WorkerStats
+{
+    /*!
+     * \brief The number of tasks the worker has executed.
+     */
+    std::uint64_t executed;
+    /*!
+     * \brief The number of tasks spawned by tasks executing on the worker.
+     */
+    std::uint64_t spawned;
+    /*!
+     * \brief The number of tasks the worker has stolen from other workers.
+     */
+    std::uint64_t stolen;
+    /*!
+     * \brief The number of times the worker attempted to steal from another
+     *        worker (including successful steals).
+     */
+    std::uint64_t steal_attempts;
+};
+
+/*!
+ * \brief Executes tasks on a fixed pool of worker threads using work-stealing.
+ *
+ * Every worker owns an arc::task::WorkStealingDeque. Tasks spawned by a worker
+ * are pushed onto the bottom of its own deque and it pops its most recent task
+ * first, whereas idle workers steal the oldest tasks from the top of the
+ * deques of random other workers. Tasks spawned from threads that are not
+ * workers of the scheduler are placed on a shared injection queue. Workers
+ * which can't find any work spin briefly before sleeping.
+ *
+ * Tasks are usually spawned through an arc::task::TaskGroup so that they can
+ * be waited on. Tasks may also be spawned detached with spawn(), in which case
+ * an exception thrown by the task calls std::terminate().
+ *
+ * Example usage:
+ *
+ * \code
+ * arc::task::Scheduler scheduler;
+ * scheduler.spawn([]() { do_work(); });
+ * \endcode
+ */
+class Scheduler
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                              PUBLIC CONSTANTS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief The capacity of the queue of tasks spawned by threads which are
+     *        not workers of the scheduler.
+     *
+     * If the queue is full the spawning thread executes the task immediately.
+     */
+    static const std::size_t INJECTION_CAPACITY = 4096;
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Creates a new scheduler and starts its worker threads.
+     *
+     * \param worker_count The number of worker threads to start, if 0 this
+     *                     will be the number of hardware threads.
+     * \param pin_threads Whether each worker thread should be pinned to its
+     *                    own CPU (round robin if there are more workers than
+     *                    CPUs). Pinning is ignored on platforms which don't
+     *                    support it.
+     */
+    Scheduler(std::size_t worker_count = 0, bool pin_threads = false);
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Waits for all spawned tasks to be executed, and then stops the
+     *        worker threads.
+     */
+    ~Scheduler();
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC STATIC FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns the process wide scheduler, which has a worker for every
+     *        hardware thread.
+     *
+     * The scheduler is created the first time this function is called.
+     */
+    static Scheduler& get_default();
+
+    /*!
+     * \brief Returns the scheduler the calling thread is a worker of, or null
+     *        if the calling thread is not a worker thread.
+     */
+    static Scheduler* get_current();
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns the number of worker threads of this scheduler.
+     */
+    std::size_t get_worker_count() const;
+
+    /*!
+     * \brief Returns whether the worker threads were pinned to CPUs.
+     */
+    bool get_pin_threads() const;
+
+    /*!
+     * \brief Returns a snapshot of the statistics of the worker at the given
+     *        index.
+     *
+     * \throws arc::ex::ValueError If the index is not less than
+     *                             get_worker_count().
+     */
+    WorkerStats get_worker_stats(std::size_t index) const;
+
+    /*!
+     * \brief Returns the total of the statistics of all workers.
+     */
+    WorkerStats get_total_stats() const;
+
+    /*!
+     * \brief Spawns a detached task which executes the given function.
+     *
+     * Closures of up to arc::task::Task::INLINE_SIZE bytes are spawned without
+     * allocating.
+     */
+    template<typename Function>
+    void spawn(Function&& function)
+    {
+        spawn_task(
+            m_task_pool.create(std::forward<Function>(function), nullptr)
+        );
+    }
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                                  FRIENDS
+    //--------------------------------------------------------------------------
+
+    friend class TaskGroup;
+
+    //--------------------------------------------------------------------------
+    //                               PRIVATE TYPES
+    //--------------------------------------------------------------------------
+
+    struct Worker;
+
+    //--------------------------------------------------------------------------
+    //                         PRIVATE STATIC ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    // the worker the current thread is (null if the thread is not a worker)
+    static thread_local Worker* s_current_worker;
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    // whether worker threads are pinned
+    const bool m_pin_threads;
+    // the storage of tasks that have not been executed yet
+    arc::lang::ObjectPool<Task> m_task_pool;
+    // tasks spawned by threads that are not workers
+    arc::lang::MpmcQueue<Task*, arc::lang::SpinWait> m_injected;
+    // idle workers wait on this until a task is spawned
+    arc::lang::BlockingWait m_idle;
+    // set when the scheduler is being destroyed
+    std::atomic<bool> m_stopping;
+    // the workers and their threads
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::vector<std::thread> m_threads;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    // returns the current thread's worker if it belongs to this scheduler
+    Worker* get_current_worker() const;
+
+    // queues the given task for execution
+    void spawn_task(Task* task);
+
+    // finds a task for the given worker (which may be null) to execute,
+    // returning null if none could be found
+    Task* find_task(Worker* worker);
+
+    // executes, destroys, and completes the given task
+    void execute(Worker* worker, Task* task);
+
+    // the entry point of worker threads
+    void run_worker(Worker* worker);
+};
+
+} // namespace task
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
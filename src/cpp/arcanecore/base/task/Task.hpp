@@ -0,0 +1,204 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief A unit of work executed by an arc::task::Scheduler.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_TASK_TASK_HPP_
+#define ARCANECORE_BASE_TASK_TASK_HPP_
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/lang/Restrictors.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace task
+{
+
+//------------------------------------------------------------------------------
+//                              FORWARD DECLARATIONS
+//------------------------------------------------------------------------------
+
+class TaskGroup;
+
+/*!
+ * \brief A type-erased closure which is executed once by an
+ *        arc::task::Scheduler.
+ *
+ * Closures of up to INLINE_SIZE bytes are stored within the task itself, and
+ * tasks are allocated from an arc::lang::ObjectPool, so spawning a small
+ * closure does not allocate. Larger closures are moved to the heap.
+ *
+ * Tasks are created by the scheduler, it should not be necessary to use this
+ * class directly.
+ */
+class Task
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                              PUBLIC CONSTANTS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief The maximum size in bytes of a closure that can be stored without
+     *        a heap allocation.
+     */
+    static const std::size_t INLINE_SIZE = 48;
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Creates a new task which will execute the given function.
+     *
+     * \param function The function to execute.
+     * \param group The group the task belongs to, or null if the task is
+     *              detached.
+     */
+    template<typename Function>
+    Task(Function&& function, TaskGroup* group)
+        : m_group(group)
+    {
+        typedef typename std::decay<Function>::type Closure;
+        init<Closure>(
+            std::forward<Function>(function),
+            std::integral_constant<
+                bool,
+                sizeof(Closure) <= INLINE_SIZE &&
+                alignof(Closure) <= alignof(std::max_align_t)
+            >()
+        );
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Executes and then destroys the closure of this task.
+     *
+     * This must be called exactly once. Exceptions thrown by the closure are
+     * propagated (after the closure has been destroyed).
+     */
+    void run()
+    {
+        m_run(m_storage);
+    }
+
+    /*!
+     * \brief Returns the group this task belongs to (null if detached).
+     */
+    TaskGroup* get_group() const
+    {
+        return m_group;
+    }
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    // the closure, or a pointer to the closure if it is too large
+    alignas(std::max_align_t) unsigned char m_storage[INLINE_SIZE];
+    // runs and then destroys the closure in the storage
+    void (*m_run)(void*);
+    // the group the task belongs to
+    TaskGroup* m_group;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE STATIC FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    template<typename Closure>
+    static void run_inline(void* storage)
+    {
+        // destroys the closure even if it throws
+        struct Guard
+        {
+            Closure* closure;
+
+            ~Guard()
+            {
+                closure->~Closure();
+            }
+        };
+
+        Guard guard = {static_cast<Closure*>(storage)};
+        (*guard.closure)();
+    }
+
+    template<typename Closure>
+    static void run_heap(void* storage)
+    {
+        std::unique_ptr<Closure> closure(*static_cast<Closure**>(storage));
+        (*closure)();
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    template<typename Closure, typename Function>
+    void init(Function&& function, std::true_type)
+    {
+        new(m_storage) Closure(std::forward<Function>(function));
+        m_run = &Task::run_inline<Closure>;
+    }
+
+    template<typename Closure, typename Function>
+    void init(Function&& function, std::false_type)
+    {
+        new(m_storage) Closure*(new Closure(std::forward<Function>(function)));
+        m_run = &Task::run_heap<Closure>;
+    }
+};
+
+} // namespace task
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
@@ -0,0 +1,165 @@
+/*!
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "arcanecore/base/task/TaskGroup.hpp"
+
+#include "arcanecore/base/lang/Futex.hpp"
+#include "arcanecore/base/lang/WaitStrategy.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace task
+{
+
+//------------------------------------------------------------------------------
+//                                  CONSTRUCTORS
+//------------------------------------------------------------------------------
+
+TaskGroup::TaskGroup(Scheduler& scheduler)
+    : m_scheduler(scheduler)
+    , m_state    (0)
+{
+}
+
+//------------------------------------------------------------------------------
+//                                   DESTRUCTOR
+//------------------------------------------------------------------------------
+
+TaskGroup::~TaskGroup()
+{
+    wait_for_tasks();
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+void TaskGroup::wait()
+{
+    wait_for_tasks();
+
+    std::exception_ptr exception;
+    {
+        std::lock_guard<std::mutex> lock(m_exception_mutex);
+        std::swap(exception, m_exception);
+    }
+    if(exception)
+    {
+        std::rethrow_exception(exception);
+    }
+}
+
+//------------------------------------------------------------------------------
+//                            PRIVATE MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+void TaskGroup::wait_for_tasks()
+{
+    // threads which are not workers don't help since they have no deque of
+    // their own, so would execute the oldest (and so largest) tasks first,
+    // which can nest arbitrarily deeply and overflow the stack
+    Scheduler::Worker* worker = m_scheduler.get_current_worker();
+    std::size_t spins = 0;
+    while(true)
+    {
+        std::uint32_t state = m_state.load(std::memory_order_acquire);
+        if((state & PENDING_MASK) == 0)
+        {
+            // clear the flag so that reusing the group doesn't cause
+            // needless wakes (unless a task has been spawned since)
+            if((state & WAITING) != 0)
+            {
+                m_state.compare_exchange_strong(
+                    state,
+                    0,
+                    std::memory_order_relaxed
+                );
+            }
+            return;
+        }
+
+        if(worker != nullptr)
+        {
+            Task* task = m_scheduler.find_task(worker);
+            if(task != nullptr)
+            {
+                m_scheduler.execute(worker, task);
+                spins = 0;
+                continue;
+            }
+        }
+
+        // the remaining tasks are executing on other threads
+        if(spins < arc::lang::BlockingWait::SPIN_COUNT)
+        {
+            ++spins;
+            arc::lang::cpu_relax();
+            continue;
+        }
+        if((state & WAITING) == 0 &&
+           !m_state.compare_exchange_weak(
+                state,
+                state | WAITING,
+                std::memory_order_relaxed))
+        {
+            continue;
+        }
+        arc::lang::futex_wait(&m_state, state | WAITING);
+    }
+}
+
+void TaskGroup::set_exception(std::exception_ptr exception)
+{
+    std::lock_guard<std::mutex> lock(m_exception_mutex);
+    if(!m_exception)
+    {
+        m_exception = exception;
+    }
+}
+
+void TaskGroup::finish()
+{
+    const std::uint32_t previous =
+        m_state.fetch_sub(1, std::memory_order_acq_rel);
+    if(previous == (WAITING | 1))
+    {
+        // the group may have already been destroyed by a thread which saw the
+        // count reach zero, but waking only uses the address of the state
+        arc::lang::futex_wake_all(&m_state);
+    }
+}
+
+} // namespace task
+ARC_BASE_VERSION_NS_END
+} // namespace arc
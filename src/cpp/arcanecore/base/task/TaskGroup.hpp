@@ -0,0 +1,196 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief A group of tasks which can be waited on together.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_TASK_TASKGROUP_HPP_
+#define ARCANECORE_BASE_TASK_TASKGROUP_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <utility>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/lang/Restrictors.hpp"
+#include "arcanecore/base/task/Scheduler.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace task
+{
+
+/*!
+ * \brief Spawns tasks on an arc::task::Scheduler which can then be waited on
+ *        together (fork/join).
+ *
+ * Waiting from a worker thread does not block while there is work available,
+ * instead the worker executes pending tasks (of any group) until all of the
+ * tasks of the group have finished. This means tasks may themselves spawn and
+ * wait on nested groups without starving the scheduler of threads. Threads
+ * which are not workers of the scheduler sleep while waiting, so recursive
+ * work is best started by spawning its root as a single task.
+ *
+ * Example usage:
+ *
+ * \code
+ * std::uint64_t fib(arc::task::Scheduler& scheduler, std::uint64_t n)
+ * {
+ *     if(n < 2)
+ *     {
+ *         return n;
+ *     }
+ *     std::uint64_t a = 0;
+ *     arc::task::TaskGroup group(scheduler);
+ *     group.spawn([&]() { a = fib(scheduler, n - 1); });
+ *     const std::uint64_t b = fib(scheduler, n - 2);
+ *     group.wait();
+ *     return a + b;
+ * }
+ * \endcode
+ */
+class TaskGroup
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Creates a new empty group which spawns tasks on the given
+     *        scheduler.
+     */
+    TaskGroup(Scheduler& scheduler);
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Waits for the tasks of this group to finish.
+     *
+     * Exceptions thrown by the tasks are discarded if wait() has not been
+     * called.
+     */
+    ~TaskGroup();
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Spawns a task in this group which executes the given function.
+     *
+     * Closures of up to arc::task::Task::INLINE_SIZE bytes are spawned without
+     * allocating.
+     */
+    template<typename Function>
+    void spawn(Function&& function)
+    {
+        // only count the task once it has been created, in case creating it
+        // throws
+        Task* task = m_scheduler.m_task_pool.create(
+            std::forward<Function>(function),
+            this
+        );
+        m_state.fetch_add(1, std::memory_order_relaxed);
+        m_scheduler.spawn_task(task);
+    }
+
+    /*!
+     * \brief Waits for every task spawned in this group to finish, executing
+     *        other pending tasks in the meantime if called from a worker
+     *        thread.
+     *
+     * \throws If any task threw an exception, the exception thrown by the first
+     *         task to fail is rethrown once all tasks have finished.
+     */
+    void wait();
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE CONSTANTS
+    //--------------------------------------------------------------------------
+
+    // set in the state when a thread is sleeping until the group finishes
+    static const std::uint32_t WAITING = 0x80000000U;
+    // the bits of the state which hold the number of pending tasks
+    static const std::uint32_t PENDING_MASK = WAITING - 1;
+
+    //--------------------------------------------------------------------------
+    //                                  FRIENDS
+    //--------------------------------------------------------------------------
+
+    friend class Scheduler;
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    // the scheduler tasks are spawned on
+    Scheduler& m_scheduler;
+    // the number of tasks which have not finished, and the WAITING flag
+    std::atomic<std::uint32_t> m_state;
+    // the exception thrown by the first task to fail
+    std::mutex m_exception_mutex;
+    std::exception_ptr m_exception;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    // waits for all tasks to finish without rethrowing exceptions
+    void wait_for_tasks();
+
+    // records the exception of a task which failed
+    void set_exception(std::exception_ptr exception);
+
+    // called once a task of this group has finished
+    void finish();
+};
+
+} // namespace task
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
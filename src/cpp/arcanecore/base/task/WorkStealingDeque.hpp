@@ -0,0 +1,279 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Lock-free Chase-Lev work-stealing deque.
+ *
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ARCANECORE_BASE_TASK_WORKSTEALINGDEQUE_HPP_
+#define ARCANECORE_BASE_TASK_WORKSTEALINGDEQUE_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "arcanecore/base/BaseAPI.hpp"
+#include "arcanecore/base/Preproc.hpp"
+#include "arcanecore/base/lang/Restrictors.hpp"
+
+
+namespace arc
+{
+ARC_BASE_VERSION_NS_BEGIN
+namespace task
+{
+
+/*!
+ * \brief Unbounded deque of pointers which one owner thread pushes to and pops
+ *        from the bottom of, while any number of other threads steal from the
+ *        top.
+ *
+ * This is the Chase-Lev deque with the memory orderings described by Le et al.
+ * in "Correct and Efficient Work-Stealing for Weak Memory Models". The owner
+ * works in LIFO order (which is cache friendly for fork/join) while thieves
+ * take the oldest, and usually largest, pieces of work.
+ *
+ * The ring buffer doubles when it is full. Replaced buffers are retained until
+ * the deque is destroyed since a thief may still be reading from them.
+ *
+ * \tparam T The type pointed to by the elements.
+ */
+template<typename T>
+class WorkStealingDeque
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Creates a new deque.
+     *
+     * \param capacity The initial capacity, which is rounded up to a power of
+     *                 two.
+     */
+    WorkStealingDeque(std::size_t capacity = 256)
+        : m_top   (0)
+        , m_bottom(0)
+    {
+        std::size_t rounded = 2;
+        while(rounded < capacity)
+        {
+            rounded <<= 1;
+        }
+        m_buffers.emplace_back(new Buffer(rounded));
+        m_buffer.store(m_buffers.back().get(), std::memory_order_relaxed);
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Pushes an element onto the bottom of the deque.
+     *
+     * \warning May only be called by the owner thread.
+     */
+    void push(T* element)
+    {
+        const std::int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+        const std::int64_t top = m_top.load(std::memory_order_acquire);
+        Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+        if(bottom - top > static_cast<std::int64_t>(buffer->mask))
+        {
+            buffer = grow(buffer, top, bottom);
+        }
+        // release so that a thief reading the element sees its contents
+        buffer->get(bottom).store(element, std::memory_order_release);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    /*!
+     * \brief Pops the most recently pushed element from the bottom of the
+     *        deque, returning null if the deque is empty.
+     *
+     * \warning May only be called by the owner thread.
+     */
+    T* pop()
+    {
+        const std::int64_t bottom =
+            m_bottom.load(std::memory_order_relaxed) - 1;
+        Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+        m_bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t top = m_top.load(std::memory_order_relaxed);
+
+        if(top > bottom)
+        {
+            // empty
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        T* element = buffer->get(bottom).load(std::memory_order_relaxed);
+        if(top == bottom)
+        {
+            // last element, race thieves for it
+            if(!m_top.compare_exchange_strong(
+                    top,
+                    top + 1,
+                    std::memory_order_seq_cst,
+                    std::memory_order_relaxed))
+            {
+                element = nullptr;
+            }
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return element;
+    }
+
+    /*!
+     * \brief Steals the oldest element from the top of the deque, returning
+     *        null if the deque is empty or the steal lost a race with another
+     *        thread.
+     *
+     * This may be called by any thread.
+     */
+    T* steal()
+    {
+        std::int64_t top = m_top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const std::int64_t bottom = m_bottom.load(std::memory_order_acquire);
+        if(top >= bottom)
+        {
+            return nullptr;
+        }
+
+        Buffer* buffer = m_buffer.load(std::memory_order_acquire);
+        T* element = buffer->get(top).load(std::memory_order_acquire);
+        if(!m_top.compare_exchange_strong(
+                top,
+                top + 1,
+                std::memory_order_seq_cst,
+                std::memory_order_relaxed))
+        {
+            return nullptr;
+        }
+        return element;
+    }
+
+    /*!
+     * \brief Returns an estimate of the number of elements in the deque.
+     */
+    std::size_t size() const
+    {
+        const std::int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+        const std::int64_t top = m_top.load(std::memory_order_relaxed);
+        return bottom > top ? static_cast<std::size_t>(bottom - top) : 0;
+    }
+
+    /*!
+     * \brief Returns whether the deque appears to be empty.
+     */
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                               PRIVATE TYPES
+    //--------------------------------------------------------------------------
+
+    // a power of two sized ring of elements
+    struct Buffer
+    {
+        std::size_t mask;
+        std::unique_ptr<std::atomic<T*>[]> elements;
+
+        Buffer(std::size_t capacity)
+            : mask    (capacity - 1)
+            , elements(new std::atomic<T*>[capacity])
+        {
+        }
+
+        std::atomic<T*>& get(std::int64_t index)
+        {
+            return elements[static_cast<std::size_t>(index) & mask];
+        }
+    };
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    // the index thieves steal from
+    std::atomic<std::int64_t> m_top;
+    // keeps the indices on separate cache lines (padding is used rather than
+    // alignment so that deques can be heap allocated before C++17)
+    char m_padding[ARC_CACHE_LINE_SIZE - sizeof(std::atomic<std::int64_t>)];
+    // the index the owner pushes to and pops from
+    std::atomic<std::int64_t> m_bottom;
+    // the current buffer
+    std::atomic<Buffer*> m_buffer;
+    // every buffer that has been used by the deque (only accessed by the owner)
+    std::vector<std::unique_ptr<Buffer>> m_buffers;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    // replaces the buffer with one twice the size
+    Buffer* grow(Buffer* buffer, std::int64_t top, std::int64_t bottom)
+    {
+        m_buffers.emplace_back(new Buffer((buffer->mask + 1) * 2));
+        Buffer* grown = m_buffers.back().get();
+        for(std::int64_t i = top; i < bottom; ++i)
+        {
+            grown->get(i).store(
+                buffer->get(i).load(std::memory_order_relaxed),
+                std::memory_order_relaxed
+            );
+        }
+        m_buffer.store(grown, std::memory_order_release);
+        return grown;
+    }
+};
+
+} // namespace task
+ARC_BASE_VERSION_NS_END
+} // namespace arc
+
+#endif
@@ -0,0 +1,562 @@
+/*!
+ * \copyright Copyright (c) 2018, The Arcane Initiative
+ *            All rights reserved.
+ *
+ * \license BSD 3-Clause License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ * arc_logdecode: renders binary logs written by arc::log::Logger as text or
+ * JSON.
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+
+#include "arcanecore/base/Exceptions.hpp"
+#include "arcanecore/base/arg/DefaultHelpFlag.hpp"
+#include "arcanecore/base/arg/Flag.hpp"
+#include "arcanecore/base/arg/Parser.hpp"
+#include "arcanecore/base/fmt/Number.hpp"
+#include "arcanecore/base/io/FileDescriptorSink.hpp"
+#include "arcanecore/base/lang/StringBuilder.hpp"
+#include "arcanecore/base/log/BinaryDecoder.hpp"
+#include "arcanecore/base/log/TimestampFormatter.hpp"
+
+
+namespace
+{
+
+//------------------------------------------------------------------------------
+//                                   CONSTANTS
+//------------------------------------------------------------------------------
+
+static const char* USAGE =
+    "arc_logdecode --input <file> [--json] [--from <time>] [--to <time>]\n\n"
+    "Renders a binary log written by arc::log::Logger as text, or as JSON "
+    "with an object per line. Times are either nanoseconds since Linux Epoch "
+    "or local times such as \"2018/06/02 - 14:03:27\".";
+
+// the size the output is written to stdout at
+static const std::size_t OUTPUT_BATCH_SIZE = 64 * 1024;
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+// parses a time given on the command line as nanoseconds since Linux Epoch,
+// returning false if it's invalid
+bool parse_time(const char* text, arc::clock::TimeInt& out_time)
+{
+    const arc::clock::TimeInt nanoseconds_per_second =
+        static_cast<arc::clock::TimeInt>(arc::clock::TimeMetric::kSeconds);
+
+    std::tm local;
+    std::memset(&local, 0, sizeof(local));
+    int consumed = 0;
+    if(std::sscanf(
+            text,
+            "%d/%d/%d%*[ -]%d:%d:%d%n",
+            &local.tm_year,
+            &local.tm_mon,
+            &local.tm_mday,
+            &local.tm_hour,
+            &local.tm_min,
+            &local.tm_sec,
+            &consumed) == 6)
+    {
+        local.tm_year -= 1900;
+        local.tm_mon -= 1;
+        local.tm_isdst = -1;
+        const std::time_t seconds = std::mktime(&local);
+        if(seconds == static_cast<std::time_t>(-1))
+        {
+            return false;
+        }
+        out_time =
+            static_cast<arc::clock::TimeInt>(seconds) * nanoseconds_per_second;
+
+        // optional milliseconds
+        text += consumed;
+        if(*text == '.')
+        {
+            char* end = nullptr;
+            const unsigned long milliseconds = std::strtoul(text + 1, &end, 10);
+            if(end == text + 1 || milliseconds >= 1000)
+            {
+                return false;
+            }
+            text = end;
+            out_time += milliseconds * static_cast<arc::clock::TimeInt>(
+                arc::clock::TimeMetric::kMilliseconds
+            );
+        }
+        return *text == '\0';
+    }
+
+    char* end = nullptr;
+    const unsigned long long nanoseconds = std::strtoull(text, &end, 10);
+    if(end == text || *end != '\0')
+    {
+        return false;
+    }
+    out_time = static_cast<arc::clock::TimeInt>(nanoseconds);
+    return true;
+}
+
+// appends the given text as a JSON string
+void write_json_string(
+        arc::lang::StringBuilder& out,
+        const char* text,
+        std::size_t size)
+{
+    static const char HEX[] = "0123456789abcdef";
+
+    out << '"';
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        const unsigned char c = static_cast<unsigned char>(text[i]);
+        switch(c)
+        {
+            case '"':
+                out << "\\\"";
+                break;
+            case '\\':
+                out << "\\\\";
+                break;
+            case '\n':
+                out << "\\n";
+                break;
+            case '\r':
+                out << "\\r";
+                break;
+            case '\t':
+                out << "\\t";
+                break;
+            default:
+                if(c < 0x20)
+                {
+                    out << "\\u00" << HEX[c >> 4] << HEX[c & 0xF];
+                }
+                else
+                {
+                    out << static_cast<char>(c);
+                }
+                break;
+        }
+    }
+    out << '"';
+}
+
+// appends the given argument as a JSON value
+void write_json_arg(
+        arc::lang::StringBuilder& out,
+        const arc::fmt::detail::Arg& arg)
+{
+    char buffer[arc::fmt::MAX_SHORTEST_CHARS];
+    switch(arg.kind)
+    {
+        case arc::fmt::detail::Kind::kSigned:
+            out << arg.value.i;
+            break;
+        case arc::fmt::detail::Kind::kUnsigned:
+            out << arg.value.u;
+            break;
+        case arc::fmt::detail::Kind::kBool:
+            out << (arg.value.b ? "true" : "false");
+            break;
+        case arc::fmt::detail::Kind::kChar:
+            write_json_string(out, &arg.value.c, 1);
+            break;
+        case arc::fmt::detail::Kind::kFloat:
+        case arc::fmt::detail::Kind::kDouble:
+        {
+            const double value = arg.kind == arc::fmt::detail::Kind::kFloat ?
+                static_cast<double>(arg.value.f) : arg.value.d;
+            // JSON has no representation of infinity or NaN
+            if(value - value != 0.0)
+            {
+                out << "null";
+            }
+            else if(arg.kind == arc::fmt::detail::Kind::kFloat)
+            {
+                out.append(
+                    buffer,
+                    arc::fmt::write_shortest(buffer, arg.value.f)
+                );
+            }
+            else
+            {
+                out.append(
+                    buffer,
+                    arc::fmt::write_shortest(buffer, arg.value.d)
+                );
+            }
+            break;
+        }
+        case arc::fmt::detail::Kind::kPointer:
+        {
+            out << "\"0x";
+            out.append(
+                buffer,
+                arc::fmt::write_hex(
+                    buffer,
+                    reinterpret_cast<std::uintptr_t>(arg.value.p)
+                )
+            );
+            out << '"';
+            break;
+        }
+        default:
+            write_json_string(out, arg.value.s.data, arg.value.s.size);
+            break;
+    }
+}
+
+//------------------------------------------------------------------------------
+//                                    OPTIONS
+//------------------------------------------------------------------------------
+
+struct Options
+{
+    std::string input;
+    bool json;
+    bool help_shown;
+    arc::clock::TimeInt from;
+    arc::clock::TimeInt to;
+    bool decoded;
+
+    Options()
+        : json      (false)
+        , help_shown(false)
+        , from      (0)
+        , to        (~static_cast<arc::clock::TimeInt>(0))
+        , decoded   (false)
+    {
+    }
+};
+
+// writes an error line to the parser's error output
+void write_error(const arc::arg::Parser& parser, const char* message)
+{
+    arc::lang::StringBuilder line;
+    line << "arc_logdecode: " << message << '\n';
+    parser.get_error_output().write(line);
+    parser.get_error_output().flush();
+}
+
+//------------------------------------------------------------------------------
+//                                     FLAGS
+//------------------------------------------------------------------------------
+
+// records that the help text was displayed
+class HelpFlag
+    : public arc::arg::DefaultHelpFlag
+{
+public:
+
+    HelpFlag(Options& options)
+        : arc::arg::DefaultHelpFlag(USAGE)
+        , m_options                (options)
+    {
+    }
+
+    virtual bool parse_extra(
+            std::size_t argi,
+            std::size_t argc,
+            char** argv,
+            std::size_t& out_increment,
+            int& out_exit_code) override
+    {
+        m_options.help_shown = true;
+        return arc::arg::DefaultHelpFlag::parse_extra(
+            argi,
+            argc,
+            argv,
+            out_increment,
+            out_exit_code
+        );
+    }
+
+private:
+
+    Options& m_options;
+};
+
+// --json
+class JsonFlag
+    : public arc::arg::Flag
+{
+public:
+
+    JsonFlag(Options& options)
+        : arc::arg::Flag(
+            "json",
+            "j",
+            "Renders each message as a JSON object on its own line."
+        )
+        , m_options(options)
+    {
+    }
+
+    virtual bool parse_extra(
+            std::size_t argi,
+            std::size_t argc,
+            char** argv,
+            std::size_t& out_increment,
+            int& out_exit_code) override
+    {
+        m_options.json = true;
+        return true;
+    }
+
+    virtual bool execute(int& out_exit_code) override
+    {
+        return true;
+    }
+
+private:
+
+    Options& m_options;
+};
+
+// --from and --to
+class TimeFlag
+    : public arc::arg::Flag
+{
+public:
+
+    TimeFlag(
+            const char* key,
+            const char* description,
+            arc::clock::TimeInt& time)
+        : arc::arg::Flag(key, "", {"time"}, description)
+        , m_key         (key)
+        , m_time        (time)
+    {
+    }
+
+    virtual bool parse_extra(
+            std::size_t argi,
+            std::size_t argc,
+            char** argv,
+            std::size_t& out_increment,
+            int& out_exit_code) override
+    {
+        if(argi >= argc || !parse_time(argv[argi], m_time))
+        {
+            std::string message("--");
+            message += m_key;
+            message += " requires a time in nanoseconds or a local time.";
+            write_error(*m_parser_parent, message.c_str());
+            out_exit_code = 1;
+            return false;
+        }
+        out_increment = 1;
+        return true;
+    }
+
+    virtual bool execute(int& out_exit_code) override
+    {
+        return true;
+    }
+
+private:
+
+    const char* m_key;
+    arc::clock::TimeInt& m_time;
+};
+
+// --input, which decodes the log once every flag has been parsed
+class InputFlag
+    : public arc::arg::Flag
+{
+public:
+
+    InputFlag(Options& options)
+        : arc::arg::Flag(
+            "input",
+            "i",
+            {"file"},
+            "The binary log to decode."
+        )
+        , m_options(options)
+    {
+    }
+
+    virtual bool parse_extra(
+            std::size_t argi,
+            std::size_t argc,
+            char** argv,
+            std::size_t& out_increment,
+            int& out_exit_code) override
+    {
+        if(argi >= argc)
+        {
+            write_error(*m_parser_parent, "--input requires a file.");
+            out_exit_code = 1;
+            return false;
+        }
+        m_options.input = argv[argi];
+        out_increment = 1;
+        return true;
+    }
+
+    virtual bool execute(int& out_exit_code) override
+    {
+        m_options.decoded = true;
+        out_exit_code = 1;
+
+        std::FILE* file = std::fopen(m_options.input.c_str(), "rb");
+        if(file == nullptr)
+        {
+            std::string message("Failed to open: ");
+            message += m_options.input;
+            write_error(*m_parser_parent, message.c_str());
+            return false;
+        }
+
+        bool ret = true;
+        try
+        {
+            decode(file);
+        }
+        catch(const arc::ex::ArcError& e)
+        {
+            write_error(*m_parser_parent, e.what());
+            ret = false;
+        }
+        std::fclose(file);
+        return ret;
+    }
+
+private:
+
+    Options& m_options;
+
+    void decode(std::FILE* file)
+    {
+        arc::log::BinaryDecoder decoder(file);
+        decoder.set_time_range(m_options.from, m_options.to);
+
+        arc::io::OutputSink& output = m_parser_parent->get_output();
+        arc::log::TimestampFormatter timestamps;
+        arc::lang::StringBuilder out;
+        arc::log::DecodedMessage message;
+        while(decoder.next(message))
+        {
+            if(m_options.json)
+            {
+                out << "{\"time\":" << message.time << ",\"timestamp\":\"";
+                timestamps.write(out, message.time);
+                out
+                    << "\",\"level\":\""
+                    << arc::log::get_level_name(message.level)
+                    << "\",\"file\":";
+                write_json_string(
+                    out,
+                    message.file,
+                    std::strlen(message.file)
+                );
+                out << ",\"line\":" << message.line << ",\"message\":";
+
+                arc::lang::StringBuilder text;
+                message.format_to(text);
+                write_json_string(out, text.data(), text.size());
+
+                out << ",\"args\":[";
+                for(std::size_t i = 0; i < message.arg_count; ++i)
+                {
+                    if(i != 0)
+                    {
+                        out << ',';
+                    }
+                    write_json_arg(out, message.args[i]);
+                }
+                out << "]}\n";
+            }
+            else
+            {
+                timestamps.write(out, message.time);
+                out
+                    << " [" << arc::log::get_level_name(message.level)
+                    << "] ";
+                message.format_to(out);
+                out << '\n';
+            }
+
+            if(out.size() >= OUTPUT_BATCH_SIZE)
+            {
+                output.write(out);
+                out.clear();
+            }
+        }
+        output.write(out);
+        output.flush();
+    }
+};
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                 MAIN FUNCTION
+//------------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+    Options options;
+
+    arc::arg::Parser parser;
+    parser.add_flag(new HelpFlag(options));
+    parser.add_flag(new InputFlag(options));
+    parser.add_flag(new JsonFlag(options));
+    parser.add_flag(new TimeFlag(
+        "from",
+        "Only renders messages logged at or after this time.",
+        options.from
+    ));
+    parser.add_flag(new TimeFlag(
+        "to",
+        "Only renders messages logged at or before this time.",
+        options.to
+    ));
+
+    const int exit_code = parser.execute(argc, argv);
+    if(exit_code != 0 || options.help_shown)
+    {
+        return exit_code;
+    }
+    if(!options.decoded)
+    {
+        write_error(parser, "No input file was given (see --help).");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,89 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <vector>
+
+#include <arcanecore/base/lang/Arena.hpp>
+
+
+//------------------------------------------------------------------------------
+//                                   CONSTANTS
+//------------------------------------------------------------------------------
+
+// the number of allocations performed per iteration
+static const std::size_t ALLOCATION_COUNT = 1024;
+
+//------------------------------------------------------------------------------
+//                                   BENCHMARKS
+//------------------------------------------------------------------------------
+
+static void BM_Arena_malloc(benchmark::State& state)
+{
+    const std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<void*> pointers(ALLOCATION_COUNT);
+    for(auto _ : state)
+    {
+        for(std::size_t i = 0; i < ALLOCATION_COUNT; ++i)
+        {
+            pointers[i] = std::malloc(size);
+            benchmark::DoNotOptimize(pointers[i]);
+        }
+        for(std::size_t i = 0; i < ALLOCATION_COUNT; ++i)
+        {
+            std::free(pointers[i]);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * ALLOCATION_COUNT);
+}
+BENCHMARK(BM_Arena_malloc)->Arg(16)->Arg(64)->Arg(256);
+
+static void BM_Arena_allocate(benchmark::State& state)
+{
+    const std::size_t size = static_cast<std::size_t>(state.range(0));
+    arc::lang::Arena arena(64 * 1024);
+    for(auto _ : state)
+    {
+        for(std::size_t i = 0; i < ALLOCATION_COUNT; ++i)
+        {
+            void* p = arena.allocate(size);
+            benchmark::DoNotOptimize(p);
+        }
+        arena.reset();
+    }
+    state.SetItemsProcessed(state.iterations() * ALLOCATION_COUNT);
+}
+BENCHMARK(BM_Arena_allocate)->Arg(16)->Arg(64)->Arg(256);
+
+static void BM_Arena_vector_std(benchmark::State& state)
+{
+    for(auto _ : state)
+    {
+        std::vector<int> v;
+        for(std::size_t i = 0; i < ALLOCATION_COUNT; ++i)
+        {
+            v.push_back(static_cast<int>(i));
+        }
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+BENCHMARK(BM_Arena_vector_std);
+
+static void BM_Arena_vector_arena(benchmark::State& state)
+{
+    arc::lang::InlineArena<16 * 1024> arena;
+    for(auto _ : state)
+    {
+        {
+            std::vector<int, arc::lang::ArenaAllocator<int>> v{
+                arc::lang::ArenaAllocator<int>(arena)
+            };
+            for(std::size_t i = 0; i < ALLOCATION_COUNT; ++i)
+            {
+                v.push_back(static_cast<int>(i));
+            }
+            benchmark::DoNotOptimize(v.data());
+        }
+        arena.reset();
+    }
+}
+BENCHMARK(BM_Arena_vector_arena);
@@ -0,0 +1,100 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+#include <arcanecore/base/async/Generator.hpp>
+#include <arcanecore/base/async/SyncWait.hpp>
+#include <arcanecore/base/async/Task.hpp>
+#include <arcanecore/base/async/ThreadPool.hpp>
+
+
+//------------------------------------------------------------------------------
+//                                   CONSTANTS
+//------------------------------------------------------------------------------
+
+// the depth of the chain of awaiting tasks
+static const std::uint64_t CHAIN_DEPTH = 1024;
+// the number of times a coroutine is rescheduled onto a pool
+static const std::uint64_t HOP_COUNT = 1024;
+// the number of values produced by a generator
+static const std::uint64_t GENERATOR_COUNT = 1 << 16;
+
+//------------------------------------------------------------------------------
+//                                    FIXTURES
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+arc::async::Task<std::uint64_t> count_depth(std::uint64_t depth)
+{
+    if(depth == 0)
+    {
+        co_return 0;
+    }
+    co_return 1 + co_await count_depth(depth - 1);
+}
+
+arc::async::Task<std::uint64_t> hop(
+        arc::async::ThreadPool& pool,
+        std::uint64_t count)
+{
+    for(std::uint64_t i = 0; i < count; ++i)
+    {
+        co_await pool.schedule();
+    }
+    co_return count;
+}
+
+arc::async::Generator<std::uint64_t> count_to(std::uint64_t n)
+{
+    for(std::uint64_t i = 0; i < n; ++i)
+    {
+        co_yield i;
+    }
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                   BENCHMARKS
+//------------------------------------------------------------------------------
+
+static void BM_Async_await_chain(benchmark::State& state)
+{
+    // one coroutine frame allocation and two transfers per level
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(
+            arc::async::sync_wait(count_depth(CHAIN_DEPTH))
+        );
+    }
+    state.SetItemsProcessed(state.iterations() * CHAIN_DEPTH);
+}
+BENCHMARK(BM_Async_await_chain);
+
+static void BM_Async_schedule(benchmark::State& state)
+{
+    arc::async::ThreadPool pool(static_cast<std::size_t>(state.range(0)));
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(arc::async::sync_wait(hop(pool, HOP_COUNT)));
+    }
+    state.SetItemsProcessed(state.iterations() * HOP_COUNT);
+}
+BENCHMARK(BM_Async_schedule)->RangeMultiplier(4)->Range(1, 16)->UseRealTime();
+
+static void BM_Async_generator(benchmark::State& state)
+{
+    for(auto _ : state)
+    {
+        std::uint64_t sum = 0;
+        for(std::uint64_t value : count_to(GENERATOR_COUNT))
+        {
+            sum += value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * GENERATOR_COUNT);
+}
+BENCHMARK(BM_Async_generator);
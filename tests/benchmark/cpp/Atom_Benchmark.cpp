@@ -0,0 +1,104 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <arcanecore/base/lang/Atom.hpp>
+#include <arcanecore/base/lang/FlatHashMap.hpp>
+#include <arcanecore/base/lang/Hash.hpp>
+
+
+//------------------------------------------------------------------------------
+//                                   CONSTANTS
+//------------------------------------------------------------------------------
+
+// the number of keys in the lookup benchmarks
+static const std::size_t KEY_COUNT = 64;
+
+//------------------------------------------------------------------------------
+//                                    FIXTURES
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+std::vector<std::string> make_keys()
+{
+    std::vector<std::string> keys;
+    for(std::size_t i = 0; i < KEY_COUNT; ++i)
+    {
+        keys.push_back("--benchmark-flag-" + std::to_string(i));
+    }
+    return keys;
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                   BENCHMARKS
+//------------------------------------------------------------------------------
+
+static void BM_Atom_find(benchmark::State& state)
+{
+    const std::vector<std::string> keys = make_keys();
+    for(const std::string& key : keys)
+    {
+        arc::lang::Atom interned(key);
+    }
+    std::size_t i = 0;
+    for(auto _ : state)
+    {
+        const std::string& key = keys[i++ % KEY_COUNT];
+        arc::lang::Atom atom;
+        benchmark::DoNotOptimize(
+            arc::lang::Atom::find(key.data(), key.size(), atom));
+        benchmark::DoNotOptimize(atom);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Atom_find)->ThreadRange(1, 4)->UseRealTime();
+
+static void BM_Atom_map_lookup(benchmark::State& state)
+{
+    // lookups by atom use the precomputed hash and a pointer compare
+    const std::vector<std::string> keys = make_keys();
+    std::vector<arc::lang::Atom> atoms;
+    arc::lang::FlatHashMap<arc::lang::Atom, std::size_t, arc::lang::AtomHash>
+        map;
+    for(std::size_t i = 0; i < KEY_COUNT; ++i)
+    {
+        atoms.emplace_back(keys[i]);
+        map[atoms.back()] = i;
+    }
+    std::size_t i = 0;
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(map.find(atoms[i++ % KEY_COUNT]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Atom_map_lookup);
+
+static void BM_Atom_string_map_lookup(benchmark::State& state)
+{
+    // the equivalent lookups by string hash and byte comparison
+    const std::vector<std::string> keys = make_keys();
+    arc::lang::FlatHashMap<
+        std::string,
+        std::size_t,
+        arc::lang::StringHash,
+        arc::lang::StringEqual
+    > map;
+    for(std::size_t i = 0; i < KEY_COUNT; ++i)
+    {
+        map[keys[i]] = i;
+    }
+    std::size_t i = 0;
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(map.find(keys[i++ % KEY_COUNT]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Atom_string_map_lookup);
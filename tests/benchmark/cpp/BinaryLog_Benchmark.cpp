@@ -0,0 +1,203 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+
+#include <arcanecore/base/clock/ClockOperations.hpp>
+#include <arcanecore/base/io/OutputSink.hpp>
+#include <arcanecore/base/lang/Atom.hpp>
+#include <arcanecore/base/log/BinaryEncoder.hpp>
+#include <arcanecore/base/log/Logger.hpp>
+#include <arcanecore/base/log/TimestampFormatter.hpp>
+
+
+//------------------------------------------------------------------------------
+//                                    FIXTURES
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+// discards what is written, counting the bytes
+class CountingSink
+    : public arc::io::OutputSink
+{
+public:
+
+    CountingSink()
+        : m_size(0)
+    {
+    }
+
+    virtual void write_slices(
+            const arc::io::Slice* slices,
+            std::size_t count) override
+    {
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            m_size += slices[i].size;
+        }
+    }
+
+    virtual void flush() override
+    {
+    }
+
+    std::size_t get_size() const
+    {
+        return m_size;
+    }
+
+private:
+
+    std::size_t m_size;
+};
+
+// the arguments of a typical message, as the background thread decodes them
+struct Message
+{
+    arc::log::detail::Site site;
+    arc::fmt::detail::Arg args[5];
+
+    Message()
+    {
+        static const char FORMAT[] = "[{} {}] request {} completed in {:.3f}ms";
+        static const arc::fmt::detail::Kind KINDS[] = {
+            arc::fmt::detail::Kind::kString,
+            arc::fmt::detail::Kind::kUnsigned,
+            arc::fmt::detail::Kind::kUnsigned,
+            arc::fmt::detail::Kind::kDouble
+        };
+        site.level = arc::log::Level::kInfo;
+        site.format = FORMAT;
+        site.format_length = sizeof(FORMAT) - 1;
+        site.kinds = KINDS;
+        site.encodings = nullptr;
+        site.file = __FILE__;
+        site.line = __LINE__;
+
+        for(std::size_t i = 0; i < 4; ++i)
+        {
+            args[i].kind = KINDS[i];
+        }
+        args[0].value.s.data = "worker";
+        args[0].value.s.size = 6;
+        args[4].kind = arc::fmt::detail::Kind::kNone;
+    }
+
+    void set(std::size_t i)
+    {
+        args[1].value.u = i % 8;
+        args[2].value.u = i;
+        args[3].value.d = 0.25 * static_cast<double>(i);
+    }
+};
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                   BENCHMARKS
+//------------------------------------------------------------------------------
+
+static void BM_BinaryLog_encode_text(benchmark::State& state)
+{
+    // the background thread's cost per message for text
+    Message message;
+    arc::log::TimestampFormatter timestamps;
+    arc::lang::StringBuilder out;
+    arc::clock::TimeInt time =
+        arc::clock::get_current_time(arc::clock::TimeMetric::kNanoseconds);
+    std::size_t i = 0;
+    std::size_t bytes = 0;
+    for(auto _ : state)
+    {
+        message.set(i++);
+        time += 250;
+        timestamps.write(out, time);
+        out << " [" << arc::log::get_level_name(message.site.level) << "] ";
+        arc::fmt::detail::vformat_to(
+            out,
+            message.site.format,
+            message.site.format_length,
+            message.args
+        );
+        out << '\n';
+        if(out.size() >= 64 * 1024)
+        {
+            bytes += out.size();
+            out.clear();
+        }
+    }
+    bytes += out.size();
+    state.counters["bytes_per_message"] =
+        static_cast<double>(bytes) / static_cast<double>(state.iterations());
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_BinaryLog_encode_text);
+
+static void BM_BinaryLog_encode_binary(benchmark::State& state)
+{
+    // the background thread's cost per message for the binary layout
+    Message message;
+    arc::log::BinaryEncoder encoder;
+    arc::lang::StringBuilder out;
+    arc::clock::TimeInt time =
+        arc::clock::get_current_time(arc::clock::TimeMetric::kNanoseconds);
+    encoder.write_start(out, time);
+    std::size_t i = 0;
+    std::size_t bytes = 0;
+    for(auto _ : state)
+    {
+        message.set(i++);
+        time += 250;
+        encoder.add_message(message.site, time, message.args, 4);
+        if(encoder.get_pending_size() >= 64 * 1024)
+        {
+            encoder.write_blocks(out);
+            bytes += out.size();
+            out.clear();
+        }
+    }
+    encoder.write_blocks(out);
+    bytes += out.size();
+    state.counters["bytes_per_message"] =
+        static_cast<double>(bytes) / static_cast<double>(state.iterations());
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_BinaryLog_encode_binary);
+
+static void BM_BinaryLog_logger(benchmark::State& state)
+{
+    // the total cost of logging, including the background thread, for text
+    // (0) and binary (1)
+    CountingSink sink;
+    {
+        arc::log::Logger logger(
+            sink,
+            arc::log::FullPolicy::kBlock,
+            1024 * 1024,
+            state.range(0) == 0 ?
+                arc::log::OutputFormat::kText :
+                arc::log::OutputFormat::kBinary
+        );
+        const arc::lang::Atom worker("worker");
+        std::size_t i = 0;
+        for(auto _ : state)
+        {
+            ARC_LOG_INFO(
+                logger,
+                "[{} {}] request {} completed in {:.3f}ms",
+                worker,
+                i % 8,
+                i,
+                0.25 * static_cast<double>(i)
+            );
+            ++i;
+        }
+        logger.flush();
+    }
+    state.counters["bytes_per_message"] =
+        static_cast<double>(sink.get_size()) /
+        static_cast<double>(state.iterations());
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_BinaryLog_logger)->Arg(0)->Arg(1)->UseRealTime();
@@ -0,0 +1,210 @@
+#include <benchmark/benchmark.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#include <arcanecore/base/fiber/ConditionVariable.hpp>
+#include <arcanecore/base/fiber/Context.hpp>
+#include <arcanecore/base/fiber/Mutex.hpp>
+#include <arcanecore/base/fiber/Scheduler.hpp>
+#include <arcanecore/base/fiber/StackPool.hpp>
+
+
+//------------------------------------------------------------------------------
+//                                   CONSTANTS
+//------------------------------------------------------------------------------
+
+// the number of round trips made by each ping pong benchmark iteration
+static const std::size_t ROUND_TRIPS = 1000;
+
+//------------------------------------------------------------------------------
+//                                    FIXTURES
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+// the contexts of the raw switch benchmark
+struct Contexts
+{
+    arc::fiber::Context main;
+    arc::fiber::Context other;
+};
+
+void switch_back_entry(void* argument)
+{
+    Contexts& contexts = *static_cast<Contexts*>(argument);
+    while(true)
+    {
+        arc::fiber::switch_context(contexts.other, contexts.main);
+    }
+}
+
+// a value two parties take turns to increment, waking each other with the
+// given mutex and condition variable types
+template<typename Mutex, typename Condition>
+struct Turns
+{
+    Mutex mutex;
+    Condition condition;
+    std::uint64_t value;
+
+    Turns()
+        : value(0)
+    {
+    }
+
+    // increments the value whenever its parity matches the given parity
+    void play(std::uint64_t parity)
+    {
+        std::unique_lock<Mutex> lock(mutex);
+        for(std::size_t i = 0; i < ROUND_TRIPS; ++i)
+        {
+            while(value % 2 != parity)
+            {
+                condition.wait(lock);
+            }
+            ++value;
+            condition.notify_one();
+        }
+    }
+};
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                   BENCHMARKS
+//------------------------------------------------------------------------------
+
+static void BM_Fiber_switch_context(benchmark::State& state)
+{
+    arc::fiber::StackPool stacks;
+    const arc::fiber::Stack stack = stacks.allocate();
+    Contexts contexts;
+    arc::fiber::make_context(
+        contexts.other,
+        stack.get_top(),
+        &switch_back_entry,
+        &contexts
+    );
+    for(auto _ : state)
+    {
+        // a switch there and a switch back
+        arc::fiber::switch_context(contexts.main, contexts.other);
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+    // the context is abandoned, which is fine since its stack owns nothing
+    stacks.deallocate(stack);
+}
+BENCHMARK(BM_Fiber_switch_context);
+
+static void BM_Fiber_yield(benchmark::State& state)
+{
+    // two fibers on one worker yielding to each other
+    arc::fiber::Scheduler scheduler(1);
+    for(auto _ : state)
+    {
+        for(std::size_t i = 0; i < 2; ++i)
+        {
+            scheduler.spawn([]()
+            {
+                for(std::size_t j = 0; j < ROUND_TRIPS; ++j)
+                {
+                    arc::fiber::yield();
+                }
+            });
+        }
+        while(scheduler.get_fiber_count() != 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * ROUND_TRIPS * 2);
+}
+BENCHMARK(BM_Fiber_yield)->UseRealTime();
+
+static void BM_Fiber_spawn(benchmark::State& state)
+{
+    // many tiny fibers spawned from outside the scheduler
+    static const std::size_t FIBER_COUNT = 1024;
+    arc::fiber::Scheduler scheduler(static_cast<std::size_t>(state.range(0)));
+    for(auto _ : state)
+    {
+        for(std::size_t i = 0; i < FIBER_COUNT; ++i)
+        {
+            scheduler.spawn([]() {});
+        }
+        while(scheduler.get_fiber_count() != 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * FIBER_COUNT);
+}
+BENCHMARK(BM_Fiber_spawn)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+
+static void BM_Fiber_mutex(benchmark::State& state)
+{
+    // fibers contending for one lock
+    static const std::size_t FIBER_COUNT = 64;
+    static const std::size_t ITERATIONS = 256;
+    arc::fiber::Scheduler scheduler(static_cast<std::size_t>(state.range(0)));
+    arc::fiber::Mutex mutex;
+    std::uint64_t counter = 0;
+    for(auto _ : state)
+    {
+        for(std::size_t i = 0; i < FIBER_COUNT; ++i)
+        {
+            scheduler.spawn([&]()
+            {
+                for(std::size_t j = 0; j < ITERATIONS; ++j)
+                {
+                    std::lock_guard<arc::fiber::Mutex> lock(mutex);
+                    ++counter;
+                }
+            });
+        }
+        while(scheduler.get_fiber_count() != 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+    benchmark::DoNotOptimize(counter);
+    state.SetItemsProcessed(state.iterations() * FIBER_COUNT * ITERATIONS);
+}
+BENCHMARK(BM_Fiber_mutex)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+
+static void BM_Fiber_condition_ping_pong(benchmark::State& state)
+{
+    // two fibers waking each other through a condition variable
+    arc::fiber::Scheduler scheduler(static_cast<std::size_t>(state.range(0)));
+    for(auto _ : state)
+    {
+        Turns<arc::fiber::Mutex, arc::fiber::ConditionVariable> turns;
+        scheduler.spawn([&]() { turns.play(0); });
+        scheduler.spawn([&]() { turns.play(1); });
+        while(scheduler.get_fiber_count() != 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * ROUND_TRIPS * 2);
+}
+BENCHMARK(BM_Fiber_condition_ping_pong)->Arg(1)->Arg(2)->UseRealTime();
+
+static void BM_Fiber_thread_ping_pong(benchmark::State& state)
+{
+    // the OS thread equivalent of the above, for comparison
+    for(auto _ : state)
+    {
+        Turns<std::mutex, std::condition_variable> turns;
+        std::thread other([&]() { turns.play(1); });
+        turns.play(0);
+        other.join();
+    }
+    state.SetItemsProcessed(state.iterations() * ROUND_TRIPS * 2);
+}
+BENCHMARK(BM_Fiber_thread_ping_pong)->UseRealTime();
@@ -0,0 +1,140 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <arcanecore/base/lang/FlatHashMap.hpp>
+
+
+//------------------------------------------------------------------------------
+//                                    FIXTURES
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+// returns count pseudo-random keys
+static std::vector<std::uint64_t> make_keys(std::size_t count)
+{
+    std::vector<std::uint64_t> keys(count);
+    std::uint64_t state = 0x853C49E6748FEA9BULL;
+    for(std::uint64_t& key : keys)
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        key = state >> 16;
+    }
+    return keys;
+}
+
+// returns count keys in the style of command line flags
+static std::vector<std::string> make_string_keys(std::size_t count)
+{
+    std::vector<std::string> keys;
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        keys.push_back("--option-" + std::to_string(i * 7919));
+    }
+    return keys;
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                   BENCHMARKS
+//------------------------------------------------------------------------------
+
+template<typename Map>
+static void BM_FlatHashMap_find_int(benchmark::State& state)
+{
+    const std::vector<std::uint64_t> keys =
+        make_keys(static_cast<std::size_t>(state.range(0)));
+    Map map;
+    for(std::uint64_t key : keys)
+    {
+        map[key] = key;
+    }
+
+    std::size_t i = 0;
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(map.find(keys[i])->second);
+        i = (i + 1) % keys.size();
+    }
+}
+BENCHMARK_TEMPLATE(
+    BM_FlatHashMap_find_int,
+    std::unordered_map<std::uint64_t, std::uint64_t>
+)->Range(64, 1 << 20);
+BENCHMARK_TEMPLATE(
+    BM_FlatHashMap_find_int,
+    arc::lang::FlatHashMap<std::uint64_t, std::uint64_t>
+)->Range(64, 1 << 20);
+
+template<typename Map>
+static void BM_FlatHashMap_insert_int(benchmark::State& state)
+{
+    const std::vector<std::uint64_t> keys =
+        make_keys(static_cast<std::size_t>(state.range(0)));
+    for(auto _ : state)
+    {
+        Map map;
+        for(std::uint64_t key : keys)
+        {
+            map[key] = key;
+        }
+        benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK_TEMPLATE(
+    BM_FlatHashMap_insert_int,
+    std::unordered_map<std::uint64_t, std::uint64_t>
+)->Range(64, 1 << 16);
+BENCHMARK_TEMPLATE(
+    BM_FlatHashMap_insert_int,
+    arc::lang::FlatHashMap<std::uint64_t, std::uint64_t>
+)->Range(64, 1 << 16);
+
+static void BM_FlatHashMap_find_cstr_std(benchmark::State& state)
+{
+    const std::vector<std::string> keys = make_string_keys(64);
+    std::unordered_map<std::string, std::size_t> map;
+    for(std::size_t i = 0; i < keys.size(); ++i)
+    {
+        map[keys[i]] = i;
+    }
+
+    std::size_t i = 0;
+    for(auto _ : state)
+    {
+        // the standard map must construct a key for lookup
+        benchmark::DoNotOptimize(map.find(keys[i].c_str())->second);
+        i = (i + 1) % keys.size();
+    }
+}
+BENCHMARK(BM_FlatHashMap_find_cstr_std);
+
+static void BM_FlatHashMap_find_cstr_flat(benchmark::State& state)
+{
+    const std::vector<std::string> keys = make_string_keys(64);
+    arc::lang::FlatHashMap<
+        std::string,
+        std::size_t,
+        arc::lang::StringHash,
+        arc::lang::StringEqual
+    > map;
+    for(std::size_t i = 0; i < keys.size(); ++i)
+    {
+        map[keys[i]] = i;
+    }
+
+    std::size_t i = 0;
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(map.find(keys[i].c_str())->second);
+        i = (i + 1) % keys.size();
+    }
+}
+BENCHMARK(BM_FlatHashMap_find_cstr_flat);
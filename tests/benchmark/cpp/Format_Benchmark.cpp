@@ -0,0 +1,202 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <arcanecore/base/fmt/Format.hpp>
+#include <arcanecore/base/fmt/Number.hpp>
+#include <arcanecore/base/lang/StringBuilder.hpp>
+
+
+//------------------------------------------------------------------------------
+//                                   CONSTANTS
+//------------------------------------------------------------------------------
+
+// the number of values in each benchmark's input
+static const std::size_t VALUE_COUNT = 1024;
+
+//------------------------------------------------------------------------------
+//                                    FIXTURES
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+std::vector<std::uint64_t> make_integers()
+{
+    // a mix of magnitudes
+    std::mt19937_64 random(42);
+    std::vector<std::uint64_t> values;
+    for(std::size_t i = 0; i < VALUE_COUNT; ++i)
+    {
+        values.push_back(random() >> (random() % 64));
+    }
+    return values;
+}
+
+std::vector<double> make_doubles()
+{
+    std::mt19937_64 random(42);
+    std::uniform_real_distribution<double> distribution(-1e6, 1e6);
+    std::vector<double> values;
+    for(std::size_t i = 0; i < VALUE_COUNT; ++i)
+    {
+        values.push_back(distribution(random));
+    }
+    return values;
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                   BENCHMARKS
+//------------------------------------------------------------------------------
+
+static void BM_Format_write_unsigned(benchmark::State& state)
+{
+    const std::vector<std::uint64_t> values = make_integers();
+    char buffer[arc::fmt::MAX_INTEGER_CHARS];
+    std::size_t i = 0;
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(
+            arc::fmt::write_unsigned(buffer, values[i++ % VALUE_COUNT])
+        );
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Format_write_unsigned);
+
+static void BM_Format_snprintf_unsigned(benchmark::State& state)
+{
+    const std::vector<std::uint64_t> values = make_integers();
+    char buffer[32];
+    std::size_t i = 0;
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(std::snprintf(
+            buffer,
+            sizeof(buffer),
+            "%llu",
+            static_cast<unsigned long long>(values[i++ % VALUE_COUNT])
+        ));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Format_snprintf_unsigned);
+
+static void BM_Format_write_shortest(benchmark::State& state)
+{
+    const std::vector<double> values = make_doubles();
+    char buffer[arc::fmt::MAX_SHORTEST_CHARS];
+    std::size_t i = 0;
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(
+            arc::fmt::write_shortest(buffer, values[i++ % VALUE_COUNT])
+        );
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Format_write_shortest);
+
+static void BM_Format_snprintf_round_trip(benchmark::State& state)
+{
+    // the usual way to print a double that round trips
+    const std::vector<double> values = make_doubles();
+    char buffer[32];
+    std::size_t i = 0;
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(std::snprintf(
+            buffer,
+            sizeof(buffer),
+            "%.17g",
+            values[i++ % VALUE_COUNT]
+        ));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Format_snprintf_round_trip);
+
+static void BM_Format_format_to(benchmark::State& state)
+{
+    // a log line sized message
+    const std::vector<std::uint64_t> integers = make_integers();
+    const std::vector<double> doubles = make_doubles();
+    arc::lang::StringBuilder builder;
+    std::size_t i = 0;
+    for(auto _ : state)
+    {
+        builder.clear();
+        ARC_FMT_TO(
+            builder,
+            "[worker {:2}] request {} completed in {:.3f}ms ({}) from {}",
+            i % 8,
+            integers[i % VALUE_COUNT],
+            doubles[i % VALUE_COUNT],
+            doubles[(i + 1) % VALUE_COUNT],
+            "127.0.0.1"
+        );
+        benchmark::DoNotOptimize(builder.data());
+        ++i;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Format_format_to);
+
+static void BM_Format_snprintf(benchmark::State& state)
+{
+    const std::vector<std::uint64_t> integers = make_integers();
+    const std::vector<double> doubles = make_doubles();
+    char buffer[256];
+    std::size_t i = 0;
+    for(auto _ : state)
+    {
+        std::snprintf(
+            buffer,
+            sizeof(buffer),
+            "[worker %2zu] request %llu completed in %.3fms (%.17g) from %s",
+            i % 8,
+            static_cast<unsigned long long>(integers[i % VALUE_COUNT]),
+            doubles[i % VALUE_COUNT],
+            doubles[(i + 1) % VALUE_COUNT],
+            "127.0.0.1"
+        );
+        benchmark::DoNotOptimize(buffer);
+        ++i;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Format_snprintf);
+
+static void BM_Format_ostringstream(benchmark::State& state)
+{
+    const std::vector<std::uint64_t> integers = make_integers();
+    const std::vector<double> doubles = make_doubles();
+    std::size_t i = 0;
+    for(auto _ : state)
+    {
+        std::ostringstream stream;
+        stream.precision(17);
+        stream
+            << "[worker " << (i % 8) << "] request "
+            << integers[i % VALUE_COUNT] << " completed in "
+            << doubles[i % VALUE_COUNT] << "ms ("
+            << doubles[(i + 1) % VALUE_COUNT] << ") from 127.0.0.1";
+        std::string line = stream.str();
+        benchmark::DoNotOptimize(line.data());
+        ++i;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Format_ostringstream);
@@ -0,0 +1,129 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <vector>
+
+#include <arcanecore/base/lang/IntrusiveList.hpp>
+#include <arcanecore/base/lang/Restrictors.hpp>
+
+
+//------------------------------------------------------------------------------
+//                                    FIXTURES
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+class Node
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+{
+public:
+
+    std::uint64_t value;
+    arc::lang::IntrusiveListHook hook;
+
+    explicit Node(std::uint64_t value_)
+        : value(value_)
+    {
+    }
+};
+
+typedef arc::lang::IntrusiveList<Node, &Node::hook> NodeList;
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                   BENCHMARKS
+//------------------------------------------------------------------------------
+
+static void BM_IntrusiveList_build(benchmark::State& state)
+{
+    // the objects already exist so building the list doesn't allocate
+    const std::size_t count = static_cast<std::size_t>(state.range(0));
+    std::vector<std::unique_ptr<Node>> nodes;
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        nodes.emplace_back(new Node(i));
+    }
+    for(auto _ : state)
+    {
+        NodeList list;
+        for(const std::unique_ptr<Node>& node : nodes)
+        {
+            list.push_back(*node);
+        }
+        benchmark::DoNotOptimize(list.size());
+        list.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_IntrusiveList_build)->Range(8, 4096);
+
+static void BM_IntrusiveList_std_list_build(benchmark::State& state)
+{
+    const std::size_t count = static_cast<std::size_t>(state.range(0));
+    std::vector<std::unique_ptr<Node>> nodes;
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        nodes.emplace_back(new Node(i));
+    }
+    for(auto _ : state)
+    {
+        std::list<Node*> list;
+        for(const std::unique_ptr<Node>& node : nodes)
+        {
+            list.push_back(node.get());
+        }
+        benchmark::DoNotOptimize(list.size());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_IntrusiveList_std_list_build)->Range(8, 4096);
+
+static void BM_IntrusiveList_iterate(benchmark::State& state)
+{
+    const std::size_t count = static_cast<std::size_t>(state.range(0));
+    NodeList list;
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        list.push_back(*new Node(i));
+    }
+    for(auto _ : state)
+    {
+        std::uint64_t sum = 0;
+        for(const Node& node : list)
+        {
+            sum += node.value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+    list.clear_and_dispose(std::default_delete<Node>());
+}
+BENCHMARK(BM_IntrusiveList_iterate)->Range(8, 4096);
+
+static void BM_IntrusiveList_std_list_iterate(benchmark::State& state)
+{
+    // the layout arc::arg::Parser used before it switched to intrusive lists
+    const std::size_t count = static_cast<std::size_t>(state.range(0));
+    std::list<std::unique_ptr<Node>> list;
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        list.emplace_back(new Node(i));
+    }
+    for(auto _ : state)
+    {
+        std::uint64_t sum = 0;
+        for(const std::unique_ptr<Node>& node : list)
+        {
+            sum += node->value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_IntrusiveList_std_list_iterate)->Range(8, 4096);
@@ -0,0 +1,174 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <arcanecore/base/io/IoEngine.hpp>
+#include <arcanecore/base/io/IoRequest.hpp>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+
+//------------------------------------------------------------------------------
+//                                   CONSTANTS
+//------------------------------------------------------------------------------
+
+// the size of the file read, which is small enough to stay in the page cache
+// so that the overhead of each way of reading it is measured rather than the
+// disk
+static const std::size_t FILE_SIZE = 64 * 1024 * 1024;
+
+// the size of each read
+static const std::size_t BLOCK_SIZE = 4096;
+
+// the number of reads per iteration
+static const std::size_t BATCH_SIZE = 256;
+
+//------------------------------------------------------------------------------
+//                                    FIXTURES
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+// creates the file read by the benchmarks, which is deleted on exit
+const char* get_file()
+{
+    static std::string path;
+    if(path.empty())
+    {
+        path = "/tmp/arc_io_engine_benchmark_XXXXXX";
+        const int fd = ::mkstemp(&path[0]);
+        std::vector<char> block(1024 * 1024);
+        for(std::size_t i = 0; i < block.size(); ++i)
+        {
+            block[i] = static_cast<char>(i * 31);
+        }
+        for(std::size_t i = 0; i < FILE_SIZE; i += block.size())
+        {
+            if(::write(fd, block.data(), block.size()) < 0)
+            {
+                break;
+            }
+        }
+        ::close(fd);
+        std::atexit([]() { std::remove(path.c_str()); });
+    }
+    return path.c_str();
+}
+
+// returns the offsets of the blocks read
+std::vector<std::uint64_t> get_random_offsets()
+{
+    std::vector<std::uint64_t> ret(BATCH_SIZE * 16);
+    std::uint64_t state = 0x9E3779B97F4A7C15ULL;
+    for(std::uint64_t& offset : ret)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        offset = (state % (FILE_SIZE / BLOCK_SIZE)) * BLOCK_SIZE;
+    }
+    return ret;
+}
+
+// reads batches of random blocks through an engine with the given backend,
+// with (1) or without (0) registered files and buffers
+void read_random(benchmark::State& state, arc::io::IoBackend backend)
+{
+    if(backend == arc::io::IoBackend::kIoUring &&
+       !arc::io::IoEngine::is_io_uring_supported())
+    {
+        state.SkipWithError("io_uring is not supported");
+        return;
+    }
+
+    const int fd = ::open(get_file(), O_RDONLY);
+    const std::vector<std::uint64_t> offsets = get_random_offsets();
+    std::vector<char> memory(BATCH_SIZE * BLOCK_SIZE);
+    std::vector<arc::io::IoRequest> requests(BATCH_SIZE);
+    arc::io::IoEngine engine(BATCH_SIZE, backend);
+
+    const bool registered = state.range(0) != 0;
+    if(registered)
+    {
+        const int fds[] = {fd};
+        engine.register_files(fds);
+        const arc::lang::Span<char> buffers[] = {
+            arc::lang::Span<char>(memory.data(), memory.size())
+        };
+        engine.register_buffers(buffers);
+    }
+
+    std::size_t next = 0;
+    for(auto _ : state)
+    {
+        for(std::size_t i = 0; i < BATCH_SIZE; ++i)
+        {
+            requests[i].prepare_read(
+                registered ? 0 : fd,
+                memory.data() + i * BLOCK_SIZE,
+                BLOCK_SIZE,
+                offsets[next++ % offsets.size()]
+            );
+            if(registered)
+            {
+                requests[i].set_registered_file(true);
+                requests[i].set_registered_buffer(0);
+            }
+            engine.enqueue(requests[i]);
+        }
+        engine.wait_all();
+        benchmark::DoNotOptimize(memory.data());
+    }
+    ::close(fd);
+    state.SetBytesProcessed(state.iterations() * BATCH_SIZE * BLOCK_SIZE);
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                   BENCHMARKS
+//------------------------------------------------------------------------------
+
+static void BM_IoEngine_io_uring(benchmark::State& state)
+{
+    read_random(state, arc::io::IoBackend::kIoUring);
+}
+BENCHMARK(BM_IoEngine_io_uring)->Arg(0)->Arg(1);
+
+static void BM_IoEngine_thread_pool(benchmark::State& state)
+{
+    read_random(state, arc::io::IoBackend::kThreadPool);
+}
+BENCHMARK(BM_IoEngine_thread_pool)->Arg(0)->Arg(1);
+
+static void BM_IoEngine_pread(benchmark::State& state)
+{
+    // the same reads made synchronously
+    const int fd = ::open(get_file(), O_RDONLY);
+    const std::vector<std::uint64_t> offsets = get_random_offsets();
+    std::vector<char> memory(BATCH_SIZE * BLOCK_SIZE);
+    std::size_t next = 0;
+    for(auto _ : state)
+    {
+        for(std::size_t i = 0; i < BATCH_SIZE; ++i)
+        {
+            benchmark::DoNotOptimize(::pread(
+                fd,
+                memory.data() + i * BLOCK_SIZE,
+                BLOCK_SIZE,
+                static_cast<off_t>(offsets[next++ % offsets.size()])
+            ));
+        }
+        benchmark::DoNotOptimize(memory.data());
+    }
+    ::close(fd);
+    state.SetBytesProcessed(state.iterations() * BATCH_SIZE * BLOCK_SIZE);
+}
+BENCHMARK(BM_IoEngine_pread);
@@ -0,0 +1,119 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <string>
+
+#include <arcanecore/base/io/FileDescriptorSink.hpp>
+#include <arcanecore/base/lang/Atom.hpp>
+#include <arcanecore/base/log/Logger.hpp>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+
+//------------------------------------------------------------------------------
+//                                   CONSTANTS
+//------------------------------------------------------------------------------
+
+// the file output is written to, so that the cost measured is that of the
+// logging rather than a terminal
+static const char* const NULL_DEVICE = "/dev/null";
+
+//------------------------------------------------------------------------------
+//                                   BENCHMARKS
+//------------------------------------------------------------------------------
+
+static void BM_Logger_log(benchmark::State& state)
+{
+    // the cost to the calling thread: messages the background thread can't
+    // keep up with are dropped rather than waited for, so this only measures
+    // the queueing (the background thread shares the core on small machines)
+    const int fd = ::open(NULL_DEVICE, O_WRONLY);
+    {
+        arc::io::FileDescriptorSink sink(fd);
+        arc::log::Logger logger(
+            sink,
+            arc::log::FullPolicy::kDrop,
+            1024 * 1024
+        );
+        const arc::lang::Atom worker("worker");
+        std::size_t i = 0;
+        for(auto _ : state)
+        {
+            ARC_LOG_INFO(
+                logger,
+                "[{} {}] request {} completed in {:.3f}ms",
+                worker,
+                i % 8,
+                i,
+                0.25 * static_cast<double>(i)
+            );
+            ++i;
+        }
+        logger.flush();
+        state.counters["dropped"] =
+            static_cast<double>(logger.get_dropped_count());
+    }
+    ::close(fd);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Logger_log);
+
+static void BM_Logger_log_string(benchmark::State& state)
+{
+    const int fd = ::open(NULL_DEVICE, O_WRONLY);
+    {
+        arc::io::FileDescriptorSink sink(fd);
+        arc::log::Logger logger(
+            sink,
+            arc::log::FullPolicy::kDrop,
+            1024 * 1024
+        );
+        const std::string path = "/data/assets/textures/terrain_albedo.png";
+        for(auto _ : state)
+        {
+            ARC_LOG_INFO(logger, "Loaded {} ({} bytes)", path, path.size());
+        }
+        logger.flush();
+    }
+    ::close(fd);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Logger_log_string);
+
+static void BM_Logger_disabled(benchmark::State& state)
+{
+    arc::io::FileDescriptorSink sink(-1);
+    arc::log::Logger logger(sink);
+    logger.set_level(arc::log::Level::kError);
+    std::size_t i = 0;
+    for(auto _ : state)
+    {
+        ARC_LOG_DEBUG(logger, "request {}", i++);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Logger_disabled);
+
+static void BM_Logger_fprintf(benchmark::State& state)
+{
+    // what the logger replaces: formatting and writing on the calling thread
+    std::FILE* file = std::fopen(NULL_DEVICE, "w");
+    std::size_t i = 0;
+    for(auto _ : state)
+    {
+        std::fprintf(
+            file,
+            "[%s %zu] request %zu completed in %.3fms\n",
+            "worker",
+            i % 8,
+            i,
+            0.25 * static_cast<double>(i)
+        );
+        std::fflush(file);
+        ++i;
+    }
+    std::fclose(file);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Logger_fprintf);
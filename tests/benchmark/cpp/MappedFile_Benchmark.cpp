@@ -0,0 +1,192 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <arcanecore/base/io/MappedFile.hpp>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+
+//------------------------------------------------------------------------------
+//                                   CONSTANTS
+//------------------------------------------------------------------------------
+
+// the size of the file read, which is small enough to stay in the page cache
+// so that the cost of each way of reading it is measured rather than the disk
+static const std::size_t FILE_SIZE = 64 * 1024 * 1024;
+
+// the size of each random read
+static const std::size_t BLOCK_SIZE = 4096;
+
+// the size of the buffer sequential reads are made through
+static const std::size_t BUFFER_SIZE = 1024 * 1024;
+
+//------------------------------------------------------------------------------
+//                                    FIXTURES
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+// creates the file read by the benchmarks, which is deleted on exit
+const char* get_file()
+{
+    static std::string path;
+    if(path.empty())
+    {
+        path = "/tmp/arc_mapped_file_benchmark_XXXXXX";
+        const int fd = ::mkstemp(&path[0]);
+        std::vector<char> block(BUFFER_SIZE);
+        for(std::size_t i = 0; i < block.size(); ++i)
+        {
+            block[i] = static_cast<char>(i * 31);
+        }
+        for(std::size_t i = 0; i < FILE_SIZE; i += block.size())
+        {
+            if(::write(fd, block.data(), block.size()) < 0)
+            {
+                break;
+            }
+        }
+        ::close(fd);
+        std::atexit([]() { std::remove(path.c_str()); });
+    }
+    return path.c_str();
+}
+
+// sums the given bytes a word at a time, so that every byte is read
+std::uint64_t sum(const char* data, std::size_t size)
+{
+    std::uint64_t ret = 0;
+    for(std::size_t i = 0; i + 8 <= size; i += 8)
+    {
+        std::uint64_t word;
+        std::memcpy(&word, data + i, 8);
+        ret += word;
+    }
+    return ret;
+}
+
+// returns the offsets of the blocks read by the random benchmarks
+std::vector<std::size_t> get_random_offsets()
+{
+    std::vector<std::size_t> ret(1024);
+    std::uint64_t state = 0x9E3779B97F4A7C15ULL;
+    for(std::size_t& offset : ret)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        offset = static_cast<std::size_t>(state % (FILE_SIZE / BLOCK_SIZE)) *
+                 BLOCK_SIZE;
+    }
+    return ret;
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                   BENCHMARKS
+//------------------------------------------------------------------------------
+
+static void BM_MappedFile_sequential(benchmark::State& state)
+{
+    // mapping once and reading in place, with (1) or without (0) populating
+    // the mapping up front
+    const char* path = get_file();
+    for(auto _ : state)
+    {
+        arc::io::MappedFile file(
+            path,
+            arc::io::MapMode::kReadOnly,
+            state.range(0) != 0
+        );
+        file.advise(arc::io::MapAdvice::kSequential);
+        benchmark::DoNotOptimize(sum(file.data(), file.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * FILE_SIZE);
+}
+BENCHMARK(BM_MappedFile_sequential)->Arg(0)->Arg(1);
+
+static void BM_MappedFile_sequential_mapped(benchmark::State& state)
+{
+    // reading a mapping which is already open, without page faults
+    arc::io::MappedFile file(get_file(), arc::io::MapMode::kReadOnly, true);
+    file.advise(arc::io::MapAdvice::kSequential);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(sum(file.data(), file.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * FILE_SIZE);
+}
+BENCHMARK(BM_MappedFile_sequential_mapped);
+
+static void BM_pread_sequential(benchmark::State& state)
+{
+    const int fd = ::open(get_file(), O_RDONLY);
+    std::vector<char> buffer(BUFFER_SIZE);
+    for(auto _ : state)
+    {
+        std::uint64_t total = 0;
+        for(std::size_t offset = 0; offset < FILE_SIZE; offset += BUFFER_SIZE)
+        {
+            const ssize_t count = ::pread(
+                fd,
+                buffer.data(),
+                buffer.size(),
+                static_cast<off_t>(offset)
+            );
+            total += sum(buffer.data(), static_cast<std::size_t>(count));
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    ::close(fd);
+    state.SetBytesProcessed(state.iterations() * FILE_SIZE);
+}
+BENCHMARK(BM_pread_sequential);
+
+static void BM_MappedFile_random(benchmark::State& state)
+{
+    arc::io::MappedFile file(get_file());
+    file.advise(arc::io::MapAdvice::kRandom);
+    const std::vector<std::size_t> offsets = get_random_offsets();
+    std::size_t i = 0;
+    for(auto _ : state)
+    {
+        const std::size_t offset = offsets[i++ % offsets.size()];
+        benchmark::DoNotOptimize(sum(file.data() + offset, BLOCK_SIZE));
+    }
+    state.SetBytesProcessed(state.iterations() * BLOCK_SIZE);
+}
+BENCHMARK(BM_MappedFile_random);
+
+static void BM_pread_random(benchmark::State& state)
+{
+    const int fd = ::open(get_file(), O_RDONLY);
+    char buffer[BLOCK_SIZE];
+    const std::vector<std::size_t> offsets = get_random_offsets();
+    std::size_t i = 0;
+    for(auto _ : state)
+    {
+        const std::size_t offset = offsets[i++ % offsets.size()];
+        const ssize_t count = ::pread(
+            fd,
+            buffer,
+            BLOCK_SIZE,
+            static_cast<off_t>(offset)
+        );
+        benchmark::DoNotOptimize(
+            sum(buffer, static_cast<std::size_t>(count))
+        );
+    }
+    ::close(fd);
+    state.SetBytesProcessed(state.iterations() * BLOCK_SIZE);
+}
+BENCHMARK(BM_pread_random);
@@ -0,0 +1,78 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <vector>
+
+#include <arcanecore/base/lang/ObjectPool.hpp>
+
+
+//------------------------------------------------------------------------------
+//                                   CONSTANTS
+//------------------------------------------------------------------------------
+
+// the number of objects that are live at once per thread
+static const std::size_t LIVE_COUNT = 64;
+
+//------------------------------------------------------------------------------
+//                                    FIXTURES
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+struct Message
+{
+    std::uint64_t id;
+    char payload[56];
+
+    Message(std::uint64_t id_)
+        : id(id_)
+    {
+    }
+};
+
+static arc::lang::ObjectPool<Message> g_pool;
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                   BENCHMARKS
+//------------------------------------------------------------------------------
+
+static void BM_ObjectPool_new(benchmark::State& state)
+{
+    std::vector<Message*> messages(LIVE_COUNT);
+    for(auto _ : state)
+    {
+        for(std::size_t i = 0; i < LIVE_COUNT; ++i)
+        {
+            messages[i] = new Message(i);
+            benchmark::DoNotOptimize(messages[i]);
+        }
+        for(std::size_t i = 0; i < LIVE_COUNT; ++i)
+        {
+            delete messages[i];
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * LIVE_COUNT);
+}
+BENCHMARK(BM_ObjectPool_new)->ThreadRange(1, 8)->UseRealTime();
+
+static void BM_ObjectPool_create(benchmark::State& state)
+{
+    std::vector<Message*> messages(LIVE_COUNT);
+    for(auto _ : state)
+    {
+        for(std::size_t i = 0; i < LIVE_COUNT; ++i)
+        {
+            messages[i] = g_pool.create(i);
+            benchmark::DoNotOptimize(messages[i]);
+        }
+        for(std::size_t i = 0; i < LIVE_COUNT; ++i)
+        {
+            g_pool.destroy(messages[i]);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * LIVE_COUNT);
+}
+BENCHMARK(BM_ObjectPool_create)->ThreadRange(1, 8)->UseRealTime();
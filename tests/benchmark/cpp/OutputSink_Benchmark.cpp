@@ -0,0 +1,86 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+
+#include <arcanecore/base/io/FileDescriptorSink.hpp>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+
+//------------------------------------------------------------------------------
+//                                   CONSTANTS
+//------------------------------------------------------------------------------
+
+// the file output is written to, so that the cost measured is that of the
+// writes rather than a terminal
+static const char* const NULL_DEVICE = "/dev/null";
+
+// a typical line of diagnostic output
+static const char* const LINE =
+    "Unrecognised command line argument: '--vrbose'.";
+
+//------------------------------------------------------------------------------
+//                                   BENCHMARKS
+//------------------------------------------------------------------------------
+
+static void BM_OutputSink_fd_lines(benchmark::State& state)
+{
+    const int fd = ::open(NULL_DEVICE, O_WRONLY);
+    {
+        arc::io::FileDescriptorSink sink(fd);
+        for(auto _ : state)
+        {
+            const arc::io::Slice slices[] = {
+                {LINE, std::char_traits<char>::length(LINE)},
+                {"\n", 1}
+            };
+            sink.write_slices(slices, 2);
+        }
+    }
+    ::close(fd);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_OutputSink_fd_lines);
+
+static void BM_OutputSink_fd_lines_flushed(benchmark::State& state)
+{
+    // one system call per line, like std::endl
+    const int fd = ::open(NULL_DEVICE, O_WRONLY);
+    {
+        arc::io::FileDescriptorSink sink(fd);
+        for(auto _ : state)
+        {
+            sink.write(LINE);
+            sink.write("\n", 1);
+            sink.flush();
+        }
+    }
+    ::close(fd);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_OutputSink_fd_lines_flushed);
+
+static void BM_OutputSink_ostream_endl(benchmark::State& state)
+{
+    std::ofstream stream(NULL_DEVICE);
+    for(auto _ : state)
+    {
+        stream << LINE << std::endl;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_OutputSink_ostream_endl);
+
+static void BM_OutputSink_ostream_newline(benchmark::State& state)
+{
+    std::ofstream stream(NULL_DEVICE);
+    for(auto _ : state)
+    {
+        stream << LINE << '\n';
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_OutputSink_ostream_newline);
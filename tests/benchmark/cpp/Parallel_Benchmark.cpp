@@ -0,0 +1,228 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <arcanecore/base/parallel/ForEach.hpp>
+#include <arcanecore/base/parallel/Reduce.hpp>
+#include <arcanecore/base/parallel/Scan.hpp>
+#include <arcanecore/base/parallel/Sort.hpp>
+
+
+//------------------------------------------------------------------------------
+//                                   CONSTANTS
+//------------------------------------------------------------------------------
+
+// the benchmarks are run for 1M, 32M and 1B elements (the largest sizes need
+// several gigabytes of memory)
+static const std::int64_t MIN_COUNT = std::int64_t(1) << 20;
+static const std::int64_t MAX_COUNT = std::int64_t(1) << 30;
+static const int COUNT_MULTIPLIER = 32;
+
+//------------------------------------------------------------------------------
+//                                    FIXTURES
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+std::vector<std::uint32_t> random_values(std::size_t count)
+{
+    std::vector<std::uint32_t> values(count);
+    std::minstd_rand engine(7);
+    for(std::uint32_t& value : values)
+    {
+        value = static_cast<std::uint32_t>(engine());
+    }
+    return values;
+}
+
+// runs the given function on a scheduler with the benchmark's worker count
+// (or serially if the worker count is 0)
+template<typename Function>
+void run(benchmark::State& state, Function function)
+{
+    const std::size_t workers = static_cast<std::size_t>(state.range(1));
+    if(workers == 0)
+    {
+        for(auto _ : state)
+        {
+            function();
+        }
+    }
+    else
+    {
+        arc::task::Scheduler scheduler(workers);
+        arc::task::TaskGroup group(scheduler);
+        group.spawn([&]()
+        {
+            for(auto _ : state)
+            {
+                function();
+            }
+        });
+        group.wait();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// element counts crossed with serial (0) and 1 to 64 workers
+void arguments(benchmark::internal::Benchmark* benchmark)
+{
+    for(std::int64_t count = MIN_COUNT;
+        count <= MAX_COUNT;
+        count *= COUNT_MULTIPLIER)
+    {
+        benchmark->Args({count, 0});
+        for(std::int64_t workers = 1; workers <= 64; workers *= 4)
+        {
+            benchmark->Args({count, workers});
+        }
+    }
+    benchmark->ArgNames({"count", "workers"});
+    benchmark->UseRealTime();
+    benchmark->Unit(benchmark::kMillisecond);
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                   BENCHMARKS
+//------------------------------------------------------------------------------
+
+static void BM_Parallel_for_each(benchmark::State& state)
+{
+    std::vector<float> values(static_cast<std::size_t>(state.range(0)), 2.0F);
+    auto op = [](float& value) { value = std::sqrt(value) + 1.0F; };
+    const bool serial = state.range(1) == 0;
+    run(state, [&]()
+    {
+        if(serial)
+        {
+            std::for_each(values.begin(), values.end(), op);
+        }
+        else
+        {
+            arc::parallel::for_each(values.begin(), values.end(), op);
+        }
+    });
+}
+BENCHMARK(BM_Parallel_for_each)->Apply(arguments);
+
+static void BM_Parallel_transform(benchmark::State& state)
+{
+    const std::vector<std::uint32_t> in =
+        random_values(static_cast<std::size_t>(state.range(0)));
+    std::vector<std::uint64_t> out(in.size());
+    auto op = [](std::uint32_t x) { return std::uint64_t(x) * x; };
+    const bool serial = state.range(1) == 0;
+    run(state, [&]()
+    {
+        if(serial)
+        {
+            std::transform(in.begin(), in.end(), out.begin(), op);
+        }
+        else
+        {
+            arc::parallel::transform(in.begin(), in.end(), out.begin(), op);
+        }
+        benchmark::DoNotOptimize(out.data());
+    });
+}
+BENCHMARK(BM_Parallel_transform)->Apply(arguments);
+
+static void BM_Parallel_reduce(benchmark::State& state)
+{
+    const std::vector<std::uint32_t> values =
+        random_values(static_cast<std::size_t>(state.range(0)));
+    const bool serial = state.range(1) == 0;
+    run(state, [&]()
+    {
+        std::uint64_t sum = serial
+            ? std::accumulate(values.begin(), values.end(), std::uint64_t(0))
+            : arc::parallel::reduce(
+                values.begin(),
+                values.end(),
+                std::uint64_t(0)
+            );
+        benchmark::DoNotOptimize(sum);
+    });
+}
+BENCHMARK(BM_Parallel_reduce)->Apply(arguments);
+
+static void BM_Parallel_scan(benchmark::State& state)
+{
+    const std::vector<std::uint32_t> values =
+        random_values(static_cast<std::size_t>(state.range(0)));
+    std::vector<std::uint32_t> out(values.size());
+    const bool serial = state.range(1) == 0;
+    run(state, [&]()
+    {
+        if(serial)
+        {
+            std::partial_sum(values.begin(), values.end(), out.begin());
+        }
+        else
+        {
+            arc::parallel::inclusive_scan(
+                values.begin(),
+                values.end(),
+                out.begin()
+            );
+        }
+        benchmark::DoNotOptimize(out.data());
+    });
+}
+BENCHMARK(BM_Parallel_scan)->Apply(arguments);
+
+static void BM_Parallel_sort_integers(benchmark::State& state)
+{
+    const std::vector<std::uint32_t> values =
+        random_values(static_cast<std::size_t>(state.range(0)));
+    std::vector<std::uint32_t> sorted;
+    const bool serial = state.range(1) == 0;
+    run(state, [&]()
+    {
+        state.PauseTiming();
+        sorted = values;
+        state.ResumeTiming();
+        if(serial)
+        {
+            std::sort(sorted.begin(), sorted.end());
+        }
+        else
+        {
+            arc::parallel::sort(sorted.begin(), sorted.end());
+        }
+    });
+}
+BENCHMARK(BM_Parallel_sort_integers)->Apply(arguments);
+
+static void BM_Parallel_sort_doubles(benchmark::State& state)
+{
+    const std::vector<std::uint32_t> ints =
+        random_values(static_cast<std::size_t>(state.range(0)));
+    const std::vector<double> values(ints.begin(), ints.end());
+    std::vector<double> sorted;
+    const bool serial = state.range(1) == 0;
+    run(state, [&]()
+    {
+        state.PauseTiming();
+        sorted = values;
+        state.ResumeTiming();
+        if(serial)
+        {
+            std::sort(sorted.begin(), sorted.end());
+        }
+        else
+        {
+            arc::parallel::sort(sorted.begin(), sorted.end());
+        }
+    });
+}
+BENCHMARK(BM_Parallel_sort_doubles)->Apply(arguments);
@@ -0,0 +1,228 @@
+#include <benchmark/benchmark.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include <arcanecore/base/lang/MpmcQueue.hpp>
+#include <arcanecore/base/lang/SpscQueue.hpp>
+
+
+//------------------------------------------------------------------------------
+//                                   CONSTANTS
+//------------------------------------------------------------------------------
+
+// the capacity of the queues (large enough that 64 threads pushing a full
+// batch each can never fill the queue)
+static const std::size_t CAPACITY = 4096;
+// the number of values pushed and popped at once by the batch benchmarks
+static const std::size_t BATCH_SIZE = 16;
+
+//------------------------------------------------------------------------------
+//                                    FIXTURES
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+// bounded queue guarded by a mutex, as a baseline for the lock-free queues
+class MutexQueue
+{
+public:
+
+    MutexQueue(std::size_t capacity)
+        : m_capacity(capacity)
+    {
+    }
+
+    void push(std::uint64_t value)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_not_full.wait(lock, [&]() { return m_values.size() < m_capacity; });
+        m_values.push_back(value);
+        lock.unlock();
+        m_not_empty.notify_one();
+    }
+
+    void pop(std::uint64_t& out_value)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_not_empty.wait(lock, [&]() { return !m_values.empty(); });
+        out_value = m_values.front();
+        m_values.pop_front();
+        lock.unlock();
+        m_not_full.notify_one();
+    }
+
+private:
+
+    std::size_t m_capacity;
+    std::mutex m_mutex;
+    std::condition_variable m_not_full;
+    std::condition_variable m_not_empty;
+    std::deque<std::uint64_t> m_values;
+};
+
+static arc::lang::SpscQueue<std::uint64_t> g_spsc(CAPACITY);
+static arc::lang::SpscQueue<std::uint64_t, arc::lang::SpinWait>
+    g_spsc_spin(CAPACITY);
+static arc::lang::MpmcQueue<std::uint64_t> g_mpmc(CAPACITY);
+static arc::lang::MpmcQueue<std::uint64_t, arc::lang::SpinWait>
+    g_mpmc_spin(CAPACITY);
+static MutexQueue g_mutex(CAPACITY);
+
+// thread 0 produces and thread 1 consumes (every thread runs the same number
+// of iterations so the queue is empty once the benchmark finishes)
+template<typename Queue>
+void spsc_throughput(benchmark::State& state, Queue& queue)
+{
+    std::uint64_t value = 0;
+    if(state.thread_index() == 0)
+    {
+        for(auto _ : state)
+        {
+            queue.push(value++);
+        }
+    }
+    else
+    {
+        for(auto _ : state)
+        {
+            queue.pop(value);
+            benchmark::DoNotOptimize(value);
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// every thread pushes and then pops a value, so the queue never holds more
+// values than there are threads
+template<typename Queue>
+void mpmc_throughput(benchmark::State& state, Queue& queue)
+{
+    std::uint64_t value = 0;
+    for(auto _ : state)
+    {
+        queue.push(value);
+        queue.pop(value);
+        benchmark::DoNotOptimize(value);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// as above, but with batches of values
+template<typename Queue>
+void mpmc_batch_throughput(benchmark::State& state, Queue& queue)
+{
+    std::uint64_t values[BATCH_SIZE] = {};
+    for(auto _ : state)
+    {
+        queue.push_batch(values, BATCH_SIZE);
+        // other threads may have taken some of our values
+        std::size_t popped = 0;
+        while(popped < BATCH_SIZE)
+        {
+            popped += queue.pop_batch(values + popped, BATCH_SIZE - popped);
+        }
+        benchmark::DoNotOptimize(values);
+    }
+    state.SetItemsProcessed(state.iterations() * BATCH_SIZE);
+}
+
+// measures the round trip time of a value sent to another thread and back
+template<typename Queue>
+void round_trip_latency(benchmark::State& state)
+{
+    Queue ping(CAPACITY);
+    Queue pong(CAPACITY);
+    std::thread echo([&]()
+    {
+        std::uint64_t value = 0;
+        do
+        {
+            ping.pop(value);
+            pong.push(value);
+        }
+        while(value != 0);
+    });
+
+    std::uint64_t value = 1;
+    for(auto _ : state)
+    {
+        ping.push(value);
+        pong.pop(value);
+    }
+    ping.push(0);
+    pong.pop(value);
+    echo.join();
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                   BENCHMARKS
+//------------------------------------------------------------------------------
+
+static void BM_Queue_spsc_mutex(benchmark::State& state)
+{
+    spsc_throughput(state, g_mutex);
+}
+BENCHMARK(BM_Queue_spsc_mutex)->Threads(2)->UseRealTime();
+
+static void BM_Queue_spsc_blocking(benchmark::State& state)
+{
+    spsc_throughput(state, g_spsc);
+}
+BENCHMARK(BM_Queue_spsc_blocking)->Threads(2)->UseRealTime();
+
+static void BM_Queue_spsc_spin(benchmark::State& state)
+{
+    spsc_throughput(state, g_spsc_spin);
+}
+BENCHMARK(BM_Queue_spsc_spin)->Threads(2)->UseRealTime();
+
+static void BM_Queue_mpmc_mutex(benchmark::State& state)
+{
+    mpmc_throughput(state, g_mutex);
+}
+BENCHMARK(BM_Queue_mpmc_mutex)->ThreadRange(1, 64)->UseRealTime();
+
+static void BM_Queue_mpmc_blocking(benchmark::State& state)
+{
+    mpmc_throughput(state, g_mpmc);
+}
+BENCHMARK(BM_Queue_mpmc_blocking)->ThreadRange(1, 64)->UseRealTime();
+
+static void BM_Queue_mpmc_spin(benchmark::State& state)
+{
+    mpmc_throughput(state, g_mpmc_spin);
+}
+BENCHMARK(BM_Queue_mpmc_spin)->ThreadRange(1, 64)->UseRealTime();
+
+static void BM_Queue_mpmc_batch(benchmark::State& state)
+{
+    mpmc_batch_throughput(state, g_mpmc);
+}
+BENCHMARK(BM_Queue_mpmc_batch)->ThreadRange(1, 64)->UseRealTime();
+
+static void BM_Queue_latency_mutex(benchmark::State& state)
+{
+    round_trip_latency<MutexQueue>(state);
+}
+BENCHMARK(BM_Queue_latency_mutex)->UseRealTime();
+
+static void BM_Queue_latency_blocking(benchmark::State& state)
+{
+    round_trip_latency<arc::lang::SpscQueue<std::uint64_t>>(state);
+}
+BENCHMARK(BM_Queue_latency_blocking)->UseRealTime();
+
+static void BM_Queue_latency_spin(benchmark::State& state)
+{
+    round_trip_latency<
+        arc::lang::SpscQueue<std::uint64_t, arc::lang::SpinWait>
+    >(state);
+}
+BENCHMARK(BM_Queue_latency_spin)->UseRealTime();
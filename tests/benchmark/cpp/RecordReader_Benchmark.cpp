@@ -0,0 +1,189 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+#include <arcanecore/base/io/MappedFile.hpp>
+#include <arcanecore/base/io/RecordReader.hpp>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+
+//------------------------------------------------------------------------------
+//                                   CONSTANTS
+//------------------------------------------------------------------------------
+
+// the size of the text split, which is small enough to stay in the page cache
+// so that splitting is measured rather than the disk
+static const std::size_t TEXT_SIZE = 64 * 1024 * 1024;
+
+//------------------------------------------------------------------------------
+//                                    FIXTURES
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+// returns CSV text of records of around 60 bytes, some of which have quoted
+// fields
+const std::string& get_text()
+{
+    static std::string text;
+    if(text.empty())
+    {
+        text.reserve(TEXT_SIZE + 128);
+        std::uint64_t i = 0;
+        while(text.size() < TEXT_SIZE)
+        {
+            text += std::to_string(i);
+            text += ",2018-06-01 12:34:56,";
+            text += (i % 4 == 0) ? "\"Smith, John\"" : "Jane Doe";
+            text += ",";
+            text += std::to_string(i * 7919 % 100000);
+            text += ",some text\n";
+            ++i;
+        }
+    }
+    return text;
+}
+
+// writes the text to a file which is deleted on exit
+const char* get_file()
+{
+    static std::string path;
+    if(path.empty())
+    {
+        path = "/tmp/arc_record_reader_benchmark_XXXXXX";
+        const int fd = ::mkstemp(&path[0]);
+        const std::string& text = get_text();
+        if(::write(fd, text.data(), text.size()) < 0)
+        {
+            std::perror("write");
+        }
+        ::close(fd);
+        std::atexit([]() { std::remove(path.c_str()); });
+    }
+    return path.c_str();
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                   BENCHMARKS
+//------------------------------------------------------------------------------
+
+static void BM_RecordReader_memory(benchmark::State& state)
+{
+    // splitting text in memory as lines (0) or CSV (1)
+    const std::string& text = get_text();
+    const arc::io::RecordFormat format = state.range(0) != 0 ?
+        arc::io::RecordFormat::kCsv : arc::io::RecordFormat::kLines;
+    for(auto _ : state)
+    {
+        arc::io::RecordReader reader(
+            arc::lang::Span<const char>(text.data(), text.size()),
+            format
+        );
+        arc::lang::Span<const char> record;
+        std::size_t total = 0;
+        while(reader.next(record))
+        {
+            total += record.size();
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_RecordReader_memory)->Arg(0)->Arg(1);
+
+static void BM_RecordReader_fields(benchmark::State& state)
+{
+    // splitting CSV text into records and fields
+    const std::string& text = get_text();
+    for(auto _ : state)
+    {
+        arc::io::RecordReader reader(
+            arc::lang::Span<const char>(text.data(), text.size()),
+            arc::io::RecordFormat::kCsv
+        );
+        arc::lang::Span<const char> record;
+        std::size_t total = 0;
+        while(reader.next(record))
+        {
+            arc::io::CsvFields fields(record);
+            arc::lang::Span<const char> field;
+            while(fields.next(field))
+            {
+                total += field.size();
+            }
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_RecordReader_fields);
+
+static void BM_RecordReader_file(benchmark::State& state)
+{
+    // reading lines from a file through the window
+    const char* path = get_file();
+    for(auto _ : state)
+    {
+        const int fd = ::open(path, O_RDONLY);
+        arc::io::RecordReader reader(fd);
+        arc::lang::Span<const char> record;
+        std::size_t total = 0;
+        while(reader.next(record))
+        {
+            total += record.size();
+        }
+        benchmark::DoNotOptimize(total);
+        ::close(fd);
+    }
+    state.SetBytesProcessed(state.iterations() * get_text().size());
+}
+BENCHMARK(BM_RecordReader_file);
+
+static void BM_RecordReader_mapped(benchmark::State& state)
+{
+    // reading lines from a mapped file
+    const char* path = get_file();
+    for(auto _ : state)
+    {
+        arc::io::MappedFile file(path);
+        file.advise(arc::io::MapAdvice::kSequential);
+        arc::io::RecordReader reader(file.view());
+        arc::lang::Span<const char> record;
+        std::size_t total = 0;
+        while(reader.next(record))
+        {
+            total += record.size();
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetBytesProcessed(state.iterations() * get_text().size());
+}
+BENCHMARK(BM_RecordReader_mapped);
+
+static void BM_getline_file(benchmark::State& state)
+{
+    const char* path = get_file();
+    for(auto _ : state)
+    {
+        std::ifstream stream(path);
+        std::string line;
+        std::size_t total = 0;
+        while(std::getline(stream, line))
+        {
+            total += line.size();
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetBytesProcessed(state.iterations() * get_text().size());
+}
+BENCHMARK(BM_getline_file);
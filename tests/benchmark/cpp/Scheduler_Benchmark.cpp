@@ -0,0 +1,164 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include <arcanecore/base/task/Scheduler.hpp>
+#include <arcanecore/base/task/TaskGroup.hpp>
+
+
+//------------------------------------------------------------------------------
+//                                   CONSTANTS
+//------------------------------------------------------------------------------
+
+// the fibonacci number computed with one task per call
+static const std::uint64_t FIB_N = 25;
+// the number of elements summed by the parallel for benchmarks
+static const std::size_t ELEMENT_COUNT = 1 << 20;
+// the number of elements summed by each leaf task
+static const std::size_t GRAIN_SIZE = 256;
+
+//------------------------------------------------------------------------------
+//                                    FIXTURES
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+std::uint64_t fib_serial(std::uint64_t n)
+{
+    return n < 2 ? n : fib_serial(n - 1) + fib_serial(n - 2);
+}
+
+std::uint64_t fib_task(arc::task::Scheduler& scheduler, std::uint64_t n)
+{
+    if(n < 2)
+    {
+        return n;
+    }
+    std::uint64_t a = 0;
+    arc::task::TaskGroup group(scheduler);
+    group.spawn([&scheduler, &a, n]() { a = fib_task(scheduler, n - 1); });
+    const std::uint64_t b = fib_task(scheduler, n - 2);
+    group.wait();
+    return a + b;
+}
+
+// sums the given range by recursively splitting it in half
+std::uint64_t sum_task(
+        arc::task::Scheduler& scheduler,
+        const std::uint32_t* first,
+        std::size_t count)
+{
+    if(count <= GRAIN_SIZE)
+    {
+        std::uint64_t sum = 0;
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            sum += first[i];
+        }
+        return sum;
+    }
+    const std::size_t half = count / 2;
+    std::uint64_t a = 0;
+    arc::task::TaskGroup group(scheduler);
+    group.spawn([&]() { a = sum_task(scheduler, first, half); });
+    const std::uint64_t b = sum_task(scheduler, first + half, count - half);
+    group.wait();
+    return a + b;
+}
+
+// runs the given function as a task and waits for it
+template<typename Function>
+void run_root(arc::task::Scheduler& scheduler, Function function)
+{
+    arc::task::TaskGroup group(scheduler);
+    group.spawn(function);
+    group.wait();
+}
+
+// reports the number of tasks stolen per task executed
+void set_counters(
+        benchmark::State& state,
+        const arc::task::Scheduler& scheduler)
+{
+    const arc::task::WorkerStats stats = scheduler.get_total_stats();
+    state.counters["workers"] =
+        static_cast<double>(scheduler.get_worker_count());
+    state.counters["steal_ratio"] = stats.executed == 0
+        ? 0.0
+        : static_cast<double>(stats.stolen) /
+          static_cast<double>(stats.executed);
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                   BENCHMARKS
+//------------------------------------------------------------------------------
+
+static void BM_Scheduler_fib_serial(benchmark::State& state)
+{
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(fib_serial(FIB_N));
+    }
+}
+BENCHMARK(BM_Scheduler_fib_serial)->UseRealTime();
+
+static void BM_Scheduler_fib(benchmark::State& state)
+{
+    arc::task::Scheduler scheduler(static_cast<std::size_t>(state.range(0)));
+    for(auto _ : state)
+    {
+        std::uint64_t result = 0;
+        run_root(scheduler, [&]() { result = fib_task(scheduler, FIB_N); });
+        benchmark::DoNotOptimize(result);
+    }
+    // one task per call
+    state.SetItemsProcessed(state.iterations() * fib_serial(FIB_N + 1));
+    set_counters(state, scheduler);
+}
+BENCHMARK(BM_Scheduler_fib)->RangeMultiplier(2)->Range(1, 64)->UseRealTime();
+
+static void BM_Scheduler_sum(benchmark::State& state)
+{
+    std::vector<std::uint32_t> values(ELEMENT_COUNT, 1);
+    arc::task::Scheduler scheduler(static_cast<std::size_t>(state.range(0)));
+    for(auto _ : state)
+    {
+        std::uint64_t result = 0;
+        run_root(scheduler, [&]()
+        {
+            result = sum_task(scheduler, values.data(), values.size());
+        });
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * ELEMENT_COUNT);
+    set_counters(state, scheduler);
+}
+BENCHMARK(BM_Scheduler_sum)->RangeMultiplier(2)->Range(1, 64)->UseRealTime();
+
+static void BM_Scheduler_spawn(benchmark::State& state)
+{
+    // many tiny independent tasks spawned from outside the scheduler
+    static const std::size_t TASK_COUNT = 1024;
+    arc::task::Scheduler scheduler(static_cast<std::size_t>(state.range(0)));
+    std::atomic<std::uint64_t> counter(0);
+    for(auto _ : state)
+    {
+        arc::task::TaskGroup group(scheduler);
+        for(std::size_t i = 0; i < TASK_COUNT; ++i)
+        {
+            group.spawn([&counter]()
+            {
+                counter.fetch_add(1, std::memory_order_relaxed);
+            });
+        }
+        group.wait();
+    }
+    state.SetItemsProcessed(state.iterations() * TASK_COUNT);
+    set_counters(state, scheduler);
+}
+BENCHMARK(BM_Scheduler_spawn)->RangeMultiplier(2)->Range(1, 64)->UseRealTime();
@@ -0,0 +1,118 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <sstream>
+#include <string>
+
+#include <deus/UnicodeStorage.hpp>
+#include <deus/UnicodeView.hpp>
+
+#include <arcanecore/base/lang/StringBuilder.hpp>
+
+
+//------------------------------------------------------------------------------
+//                                   CONSTANTS
+//------------------------------------------------------------------------------
+
+// the number of rows of a help text sized string
+static const std::size_t HELP_ROWS = 64;
+
+static const char KEY[] = "    -o, --output <path>";
+static const char DESCRIPTION[] =
+    ":: The path to write the output of the program to, which is created if "
+    "it doesn't exist.\n\n";
+
+//------------------------------------------------------------------------------
+//                                   BENCHMARKS
+//------------------------------------------------------------------------------
+
+static void BM_StringBuilder_help_text(benchmark::State& state)
+{
+    // ~8KB assembled from short pieces
+    for(auto _ : state)
+    {
+        arc::lang::StringBuilder builder;
+        for(std::size_t i = 0; i < HELP_ROWS; ++i)
+        {
+            builder << KEY << i;
+            builder.append(4, ' ');
+            builder << DESCRIPTION;
+        }
+        std::string text = builder.to_string();
+        benchmark::DoNotOptimize(text.data());
+    }
+}
+BENCHMARK(BM_StringBuilder_help_text);
+
+static void BM_StringBuilder_unicode_help_text(benchmark::State& state)
+{
+    // the same string with deus::UnicodeStorage operator+
+    for(auto _ : state)
+    {
+        deus::UnicodeStorage text;
+        for(std::size_t i = 0; i < HELP_ROWS; ++i)
+        {
+            text = text + KEY + std::to_string(i).c_str() + "    " +
+                   DESCRIPTION;
+        }
+        benchmark::DoNotOptimize(text.get_view().c_str());
+    }
+}
+BENCHMARK(BM_StringBuilder_unicode_help_text);
+
+static void BM_StringBuilder_log_line(benchmark::State& state)
+{
+    // ~100 bytes mixing text, integers and a float
+    std::size_t sequence = 0;
+    for(auto _ : state)
+    {
+        arc::lang::StringBuilder builder;
+        builder
+            << "[worker " << (sequence % 8) << "] request " << sequence
+            << " completed in " << 0.125 * static_cast<double>(sequence % 64)
+            << "ms with status " << 200 << " from "
+            << deus::UnicodeView("127.0.0.1");
+        std::string line = builder.to_string();
+        benchmark::DoNotOptimize(line.data());
+        ++sequence;
+    }
+}
+BENCHMARK(BM_StringBuilder_log_line);
+
+static void BM_StringBuilder_unicode_log_line(benchmark::State& state)
+{
+    std::size_t sequence = 0;
+    for(auto _ : state)
+    {
+        deus::UnicodeStorage line =
+            "[worker " + deus::UnicodeStorage(std::to_string(sequence % 8)) +
+            "] request " + deus::UnicodeStorage(std::to_string(sequence)) +
+            " completed in " +
+            deus::UnicodeStorage(
+                std::to_string(0.125 * static_cast<double>(sequence % 64))
+            ) +
+            "ms with status " + deus::UnicodeStorage(std::to_string(200)) +
+            " from " + deus::UnicodeView("127.0.0.1");
+        benchmark::DoNotOptimize(line.get_view().c_str());
+        ++sequence;
+    }
+}
+BENCHMARK(BM_StringBuilder_unicode_log_line);
+
+static void BM_StringBuilder_stream_log_line(benchmark::State& state)
+{
+    std::size_t sequence = 0;
+    for(auto _ : state)
+    {
+        std::ostringstream stream;
+        stream
+            << "[worker " << (sequence % 8) << "] request " << sequence
+            << " completed in " << 0.125 * static_cast<double>(sequence % 64)
+            << "ms with status " << 200 << " from "
+            << deus::UnicodeView("127.0.0.1");
+        std::string line = stream.str();
+        benchmark::DoNotOptimize(line.data());
+        ++sequence;
+    }
+}
+BENCHMARK(BM_StringBuilder_stream_log_line);
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <vector>
+
+#include <arcanecore/base/Exceptions.hpp>
+#include <arcanecore/base/lang/Arena.hpp>
+
+
+//------------------------------------------------------------------------------
+//                                     TESTS
+//------------------------------------------------------------------------------
+
+TEST(Arena, alignment)
+{
+    arc::lang::Arena arena(128);
+    for(std::size_t alignment = 1; alignment <= 64; alignment *= 2)
+    {
+        arena.allocate(1, 1);
+        void* p = arena.allocate(3, alignment);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p) % alignment, 0U);
+    }
+
+    // allocations larger than the block size get their own block
+    void* large = arena.allocate(1000, 256);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(large) % 256, 0U);
+    EXPECT_GE(arena.get_capacity(), 1000U);
+
+    EXPECT_THROW(arena.allocate(8, 3), arc::ex::ValueError);
+    EXPECT_THROW(arena.allocate(8, 0), arc::ex::ValueError);
+    EXPECT_THROW(arena.allocate(8, 12), arc::ex::ValueError);
+}
+
+TEST(Arena, oversized)
+{
+    const std::size_t max = std::numeric_limits<std::size_t>::max();
+    arc::lang::Arena arena(128);
+    char* first = static_cast<char*>(arena.allocate(8, 8));
+
+    // sizes that would overflow the bounds of the block are rejected rather
+    // than wrapping around
+    EXPECT_THROW(arena.allocate(max - 64, 8), std::bad_alloc);
+    EXPECT_THROW(arena.allocate(max, 1), std::bad_alloc);
+    char* second = static_cast<char*>(arena.allocate(8, 8));
+    EXPECT_GE(second, first + 8);
+
+    arc::lang::ArenaAllocator<std::uint64_t> allocator(arena);
+    EXPECT_THROW(allocator.allocate(max / 4), std::bad_alloc);
+}
+
+TEST(Arena, rewind)
+{
+    arc::lang::Arena arena(64);
+    arena.create<int>(1);
+    const arc::lang::Arena::Marker marker = arena.get_marker();
+
+    int* first = arena.create<int>(2);
+    for(int i = 0; i < 100; ++i)
+    {
+        arena.create<int>(i);
+    }
+    const std::size_t capacity = arena.get_capacity();
+
+    // rewinding reuses the same memory and blocks
+    arena.rewind(marker);
+    EXPECT_EQ(arena.create<int>(3), first);
+    for(int i = 0; i < 100; ++i)
+    {
+        arena.create<int>(i);
+    }
+    EXPECT_EQ(arena.get_capacity(), capacity);
+
+    arena.reset();
+    EXPECT_EQ(arena.get_capacity(), capacity);
+}
+
+TEST(Arena, inline_block)
+{
+    arc::lang::InlineArena<256> arena;
+    for(int i = 0; i < 16; ++i)
+    {
+        arena.allocate(8, 8);
+    }
+    EXPECT_EQ(arena.get_capacity(), 0U);
+
+    arena.allocate(512);
+    EXPECT_GT(arena.get_capacity(), 0U);
+}
+
+TEST(Arena, allocator)
+{
+    arc::lang::InlineArena<1024> arena;
+    std::vector<int, arc::lang::ArenaAllocator<int>> v{
+        arc::lang::ArenaAllocator<int>(arena)
+    };
+    for(int i = 0; i < 1000; ++i)
+    {
+        v.push_back(i);
+    }
+    for(int i = 0; i < 1000; ++i)
+    {
+        EXPECT_EQ(v[i], i);
+    }
+    EXPECT_TRUE(v.get_allocator() == arc::lang::ArenaAllocator<char>(arena));
+}
@@ -0,0 +1,272 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstring>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <arcanecore/base/async/FrameAllocator.hpp>
+#include <arcanecore/base/async/Generator.hpp>
+#include <arcanecore/base/async/SyncWait.hpp>
+#include <arcanecore/base/async/Task.hpp>
+#include <arcanecore/base/async/ThreadPool.hpp>
+#include <arcanecore/base/async/Timer.hpp>
+#include <arcanecore/base/clock/ClockOperations.hpp>
+
+
+//------------------------------------------------------------------------------
+//                                    FIXTURES
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+arc::async::Task<int> get_value(int value)
+{
+    co_return value;
+}
+
+arc::async::Task<int> add_values(int a, int b)
+{
+    const int x = co_await get_value(a);
+    const int y = co_await get_value(b);
+    co_return x + y;
+}
+
+arc::async::Task<> throw_error()
+{
+    throw std::runtime_error("failed");
+    co_return;
+}
+
+// awaits a chain of the given depth, which would overflow the stack if each
+// await was a nested call
+arc::async::Task<std::uint64_t> count_depth(std::uint64_t depth)
+{
+    if(depth == 0)
+    {
+        co_return 0;
+    }
+    co_return 1 + co_await count_depth(depth - 1);
+}
+
+arc::async::Generator<int> count_to(int n)
+{
+    for(int i = 0; i < n; ++i)
+    {
+        co_yield i;
+    }
+}
+
+arc::async::Generator<int> throw_after(int n)
+{
+    for(int i = 0; i < n; ++i)
+    {
+        co_yield i;
+    }
+    throw std::runtime_error("failed");
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                     TESTS
+//------------------------------------------------------------------------------
+
+TEST(Task, result)
+{
+    EXPECT_EQ(arc::async::sync_wait(add_values(2, 3)), 5);
+
+    auto get_pointer = []() -> arc::async::Task<std::unique_ptr<int>>
+    {
+        co_return std::unique_ptr<int>(new int(7));
+    };
+    std::unique_ptr<int> pointer = arc::async::sync_wait(get_pointer());
+    EXPECT_EQ(*pointer, 7);
+
+    // tasks are lazy
+    bool started = false;
+    auto set_started = [&]() -> arc::async::Task<>
+    {
+        started = true;
+        co_return;
+    };
+    arc::async::Task<> task = set_started();
+    EXPECT_FALSE(started);
+    EXPECT_FALSE(task.is_ready());
+    EXPECT_THROW(task.get_result(), arc::ex::StateError);
+    arc::async::sync_wait(std::move(task));
+    EXPECT_TRUE(started);
+}
+
+TEST(Task, exception)
+{
+    EXPECT_THROW(arc::async::sync_wait(throw_error()), std::runtime_error);
+
+    auto catch_error = []() -> arc::async::Task<bool>
+    {
+        try
+        {
+            co_await throw_error();
+        }
+        catch(const std::runtime_error&)
+        {
+            co_return true;
+        }
+        co_return false;
+    };
+    EXPECT_TRUE(arc::async::sync_wait(catch_error()));
+}
+
+TEST(Task, symmetric_transfer)
+{
+    // transfers are only compiled as tail calls in optimized builds
+    #ifdef NDEBUG
+        const std::uint64_t depth = 1000000;
+    #else
+        const std::uint64_t depth = 1000;
+    #endif
+    EXPECT_EQ(arc::async::sync_wait(count_depth(depth)), depth);
+}
+
+TEST(Generator, values)
+{
+    std::vector<int> values;
+    for(int value : count_to(5))
+    {
+        values.push_back(value);
+    }
+    EXPECT_EQ(values, std::vector<int>({0, 1, 2, 3, 4}));
+
+    // the coroutine is destroyed when the generator is not finished
+    for(int value : count_to(1000))
+    {
+        if(value == 10)
+        {
+            break;
+        }
+    }
+
+    values.clear();
+    EXPECT_THROW(
+        {
+            for(int value : throw_after(3))
+            {
+                values.push_back(value);
+            }
+        },
+        std::runtime_error
+    );
+    EXPECT_EQ(values.size(), 3U);
+}
+
+TEST(ThreadPool, schedule)
+{
+    arc::async::ThreadPool pool(4, 16);
+    EXPECT_EQ(pool.get_thread_count(), 4U);
+    EXPECT_FALSE(pool.is_current());
+
+    auto run = [&]() -> arc::async::Task<bool>
+    {
+        co_await pool.schedule();
+        co_return pool.is_current();
+    };
+    EXPECT_TRUE(arc::async::sync_wait(run()));
+
+    // more coroutines than the capacity of the queue
+    std::atomic<int> count(0);
+    auto increment = [&]() -> arc::async::Task<>
+    {
+        co_await pool.schedule();
+        count.fetch_add(1);
+    };
+    auto spawn_all = [&]() -> arc::async::Task<>
+    {
+        co_await pool.schedule();
+        std::vector<arc::async::Task<>> tasks;
+        for(int i = 0; i < 1000; ++i)
+        {
+            tasks.push_back(increment());
+        }
+        for(arc::async::Task<>& task : tasks)
+        {
+            co_await task;
+        }
+    };
+    arc::async::sync_wait(spawn_all());
+    EXPECT_EQ(count.load(), 1000);
+}
+
+TEST(Timer, sleep)
+{
+    arc::async::ThreadPool pool(2);
+    arc::async::Timer timer(&pool);
+
+    auto sleep = [&](arc::clock::TimeInt ms) -> arc::async::Task<bool>
+    {
+        const arc::clock::TimeInt start = arc::clock::get_monotonic_time();
+        co_await timer.sleep_for(ms);
+        co_return
+            pool.is_current() &&
+            arc::clock::get_monotonic_time() - start >= ms;
+    };
+    EXPECT_TRUE(arc::async::sync_wait(sleep(20)));
+
+    // deadlines in the past do not suspend
+    auto sleep_past = [&]() -> arc::async::Task<bool>
+    {
+        co_await timer.sleep_until(0);
+        co_return pool.is_current();
+    };
+    EXPECT_FALSE(arc::async::sync_wait(sleep_past()));
+}
+
+TEST(Timer, order)
+{
+    // without a pool coroutines are resumed on the timer's thread, so the
+    // order does not need to be synchronized
+    std::unique_ptr<arc::async::Timer> timer(new arc::async::Timer());
+    std::vector<arc::clock::TimeInt> order;
+    auto sleep = [&](arc::clock::TimeInt ms) -> arc::async::Task<>
+    {
+        co_await timer->sleep_for(ms);
+        order.push_back(ms);
+    };
+
+    std::vector<std::thread> threads;
+    for(arc::clock::TimeInt ms : {60, 20, 40})
+    {
+        threads.emplace_back([&, ms]() { arc::async::sync_wait(sleep(ms)); });
+    }
+    for(std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    EXPECT_EQ(order, std::vector<arc::clock::TimeInt>({20, 40, 60}));
+
+    // sleeping coroutines are resumed early when the timer is destroyed
+    std::thread thread([&]() { arc::async::sync_wait(sleep(60000)); });
+    while(timer->get_pending_count() == 0)
+    {
+        std::this_thread::yield();
+    }
+    const arc::clock::TimeInt start = arc::clock::get_monotonic_time();
+    timer.reset();
+    thread.join();
+    EXPECT_LT(arc::clock::get_monotonic_time() - start, 60000U);
+    EXPECT_EQ(order.back(), 60000U);
+}
+
+TEST(FrameAllocator, allocate)
+{
+    const std::size_t sizes[] = {1, 64, 65, 1000, 4096, 4097, 100000};
+    for(std::size_t size : sizes)
+    {
+        void* p = arc::async::FrameAllocator::allocate(size);
+        std::memset(p, 0xAB, size);
+        arc::async::FrameAllocator::deallocate(p, size);
+    }
+}
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arcanecore/base/Exceptions.hpp>
+#include <arcanecore/base/lang/Atom.hpp>
+#include <arcanecore/base/lang/FlatHashMap.hpp>
+#include <arcanecore/base/lang/Hash.hpp>
+
+
+//------------------------------------------------------------------------------
+//                                     TESTS
+//------------------------------------------------------------------------------
+
+TEST(Atom, intern)
+{
+    const arc::lang::Atom a("--verbose");
+    const arc::lang::Atom b(std::string("--verbose"));
+    const arc::lang::Atom c(deus::UnicodeView("--version"));
+    EXPECT_TRUE(a == b);
+    EXPECT_TRUE(a != c);
+    // interned strings share storage
+    EXPECT_EQ(a.c_str(), b.c_str());
+    EXPECT_STREQ(a.c_str(), "--verbose");
+    EXPECT_EQ(a.size(), 9U);
+    EXPECT_TRUE(a.get_view() == deus::UnicodeView("--verbose"));
+    EXPECT_EQ(a.get_hash(), arc::lang::StringHash()("--verbose"));
+
+    // embedded nulls are part of the string
+    const arc::lang::Atom nulls("a\0b", 3);
+    EXPECT_EQ(nulls.size(), 3U);
+    EXPECT_TRUE(nulls != arc::lang::Atom("a"));
+
+    const arc::lang::Atom empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_TRUE(empty == arc::lang::Atom(""));
+    EXPECT_STREQ(empty.c_str(), "");
+    EXPECT_EQ(empty.get_hash(), arc::lang::StringHash()(""));
+}
+
+TEST(Atom, find)
+{
+    arc::lang::Atom atom;
+    const std::string key = "Atom.find never interned";
+    EXPECT_FALSE(arc::lang::Atom::find(key.data(), key.size(), atom));
+    const arc::lang::Atom interned(key);
+    EXPECT_TRUE(arc::lang::Atom::find(key.data(), key.size(), atom));
+    EXPECT_TRUE(atom == interned);
+}
+
+TEST(AtomTable, grow_and_freeze)
+{
+    arc::lang::AtomTable table;
+    std::vector<arc::lang::Atom> atoms;
+    for(std::size_t i = 0; i < 10000; ++i)
+    {
+        const std::string s = std::to_string(i);
+        atoms.push_back(table.intern(s.data(), s.size()));
+    }
+    EXPECT_EQ(table.size(), 10000U);
+    for(std::size_t i = 0; i < 10000; ++i)
+    {
+        // the atoms are still valid after the table has grown
+        const std::string s = std::to_string(i);
+        EXPECT_STREQ(atoms[i].c_str(), s.c_str());
+        EXPECT_TRUE(table.intern(s.data(), s.size()) == atoms[i]);
+    }
+
+    // atoms of different tables are distinct
+    EXPECT_TRUE(atoms[5] != arc::lang::Atom("5"));
+
+    table.freeze();
+    EXPECT_TRUE(table.is_frozen());
+    EXPECT_TRUE(table.intern("42", 2) == atoms[42]);
+    EXPECT_THROW(table.intern("new", 3), arc::ex::StateError);
+    arc::lang::Atom atom;
+    EXPECT_FALSE(table.find("new", 3, atom));
+}
+
+TEST(AtomTable, concurrent)
+{
+    // threads interning overlapping strings while the table grows agree on
+    // every atom
+    static const std::size_t THREAD_COUNT = 4;
+    static const std::size_t STRING_COUNT = 5000;
+
+    arc::lang::AtomTable table;
+    std::vector<std::vector<arc::lang::Atom>> results(THREAD_COUNT);
+    std::vector<std::thread> threads;
+    for(std::size_t t = 0; t < THREAD_COUNT; ++t)
+    {
+        threads.emplace_back([&, t]()
+        {
+            for(std::size_t i = 0; i < STRING_COUNT; ++i)
+            {
+                // each thread interns the strings in a different order
+                const std::string s =
+                    std::to_string((i * (t * 2 + 1)) % STRING_COUNT);
+                results[t].push_back(table.intern(s.data(), s.size()));
+            }
+        });
+    }
+    for(std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(table.size(), STRING_COUNT);
+    for(std::size_t t = 0; t < THREAD_COUNT; ++t)
+    {
+        for(std::size_t i = 0; i < STRING_COUNT; ++i)
+        {
+            const std::string s =
+                std::to_string((i * (t * 2 + 1)) % STRING_COUNT);
+            arc::lang::Atom atom;
+            ASSERT_TRUE(table.find(s.data(), s.size(), atom));
+            EXPECT_TRUE(results[t][i] == atom);
+        }
+    }
+}
+
+TEST(Atom, hash_map_key)
+{
+    arc::lang::FlatHashMap<arc::lang::Atom, int, arc::lang::AtomHash> map;
+    map[arc::lang::Atom("--help")] = 1;
+    map[arc::lang::Atom("-h")] = 2;
+    EXPECT_EQ(map.find(arc::lang::Atom("--help"))->second, 1);
+    EXPECT_EQ(map.find(arc::lang::Atom("-h"))->second, 2);
+    EXPECT_FALSE(map.contains(arc::lang::Atom("--version")));
+}
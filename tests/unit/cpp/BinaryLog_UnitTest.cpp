@@ -0,0 +1,287 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <deus/UnicodeView.hpp>
+
+#include <arcanecore/base/Exceptions.hpp>
+#include <arcanecore/base/clock/ClockOperations.hpp>
+#include <arcanecore/base/io/MemorySink.hpp>
+#include <arcanecore/base/lang/Atom.hpp>
+#include <arcanecore/base/log/BinaryDecoder.hpp>
+#include <arcanecore/base/log/BinaryFormat.hpp>
+#include <arcanecore/base/log/Logger.hpp>
+
+
+//------------------------------------------------------------------------------
+//                                    FIXTURES
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+// a temporary file holding the given bytes, positioned at the start
+class TemporaryFile
+{
+public:
+
+    explicit TemporaryFile(const std::string& data)
+        : m_file(std::tmpfile())
+    {
+        std::fwrite(data.data(), 1, data.size(), m_file);
+        std::rewind(m_file);
+    }
+
+    ~TemporaryFile()
+    {
+        std::fclose(m_file);
+    }
+
+    std::FILE* get() const
+    {
+        return m_file;
+    }
+
+private:
+
+    std::FILE* m_file;
+};
+
+// decodes the given log, returning each message as "[LEVEL] text"
+std::vector<std::string> decode(
+        const std::string& data,
+        arc::clock::TimeInt from = 0,
+        arc::clock::TimeInt to = ~static_cast<arc::clock::TimeInt>(0),
+        std::size_t* out_skipped = nullptr)
+{
+    TemporaryFile file(data);
+    arc::log::BinaryDecoder decoder(file.get());
+    decoder.set_time_range(from, to);
+
+    std::vector<std::string> ret;
+    arc::log::DecodedMessage message;
+    while(decoder.next(message))
+    {
+        arc::lang::StringBuilder text;
+        text << '[' << arc::log::get_level_name(message.level) << "] ";
+        message.format_to(text);
+        ret.push_back(text.to_string());
+    }
+    if(out_skipped != nullptr)
+    {
+        *out_skipped = decoder.get_skipped_block_count();
+    }
+    return ret;
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                     TESTS
+//------------------------------------------------------------------------------
+
+TEST(BinaryLog, round_trip)
+{
+    arc::io::MemorySink sink;
+    const arc::clock::TimeInt start =
+        arc::clock::get_current_time(arc::clock::TimeMetric::kNanoseconds);
+    {
+        arc::log::Logger logger(
+            sink,
+            arc::log::FullPolicy::kBlock,
+            arc::log::Logger::DEFAULT_QUEUE_CAPACITY,
+            arc::log::OutputFormat::kBinary
+        );
+        EXPECT_EQ(logger.get_output_format(), arc::log::OutputFormat::kBinary);
+
+        std::string temporary = "temporary";
+        for(int i = 0; i < 2; ++i)
+        {
+            ARC_LOG_INFO(logger, "Hello {}!", "world");
+        }
+        ARC_LOG_WARNING(logger, "{} {:.2f} {:x} {}", 42, 3.14159, 255U, true);
+        ARC_LOG_ERROR(logger, "{:>5}|{}|{}", 'c', -7LL, 0.5f);
+        ARC_LOG_DEBUG(
+            logger,
+            "{} {} {}",
+            temporary,
+            arc::lang::Atom("atom"),
+            deus::UnicodeView("view")
+        );
+        ARC_LOG_INFO(logger, "{}", static_cast<const void*>(nullptr));
+        ARC_LOG_INFO(logger, "no arguments");
+    }
+    const arc::clock::TimeInt end =
+        arc::clock::get_current_time(arc::clock::TimeMetric::kNanoseconds);
+
+    EXPECT_EQ(
+        decode(sink.to_string()),
+        std::vector<std::string>({
+            "[INFO] Hello world!",
+            "[INFO] Hello world!",
+            "[WARNING] 42 3.14 ff true",
+            "[ERROR]     c|-7|0.5",
+            "[DEBUG] temporary atom view",
+            "[INFO] 0x0",
+            "[INFO] no arguments"
+        })
+    );
+
+    // the messages keep their times and sites
+    TemporaryFile file(sink.to_string());
+    arc::log::BinaryDecoder decoder(file.get());
+    arc::log::DecodedMessage message;
+    arc::clock::TimeInt previous = start;
+    while(decoder.next(message))
+    {
+        EXPECT_GE(message.time, previous);
+        EXPECT_LE(message.time, end);
+        EXPECT_NE(std::string(message.file).find("BinaryLog_UnitTest"),
+                  std::string::npos);
+        EXPECT_GT(message.line, 0U);
+        previous = message.time;
+    }
+}
+
+TEST(BinaryLog, compact)
+{
+    arc::io::MemorySink text_sink;
+    arc::io::MemorySink binary_sink;
+    {
+        arc::log::Logger text(text_sink);
+        arc::log::Logger binary(
+            binary_sink,
+            arc::log::FullPolicy::kBlock,
+            arc::log::Logger::DEFAULT_QUEUE_CAPACITY,
+            arc::log::OutputFormat::kBinary
+        );
+        for(int i = 0; i < 1000; ++i)
+        {
+            ARC_LOG_INFO(
+                text,
+                "Processed request {} for user {} in {:.3f}ms.",
+                1000 + i,
+                i % 17,
+                0.25 * i
+            );
+            ARC_LOG_INFO(
+                binary,
+                "Processed request {} for user {} in {:.3f}ms.",
+                1000 + i,
+                i % 17,
+                0.25 * i
+            );
+        }
+    }
+
+    EXPECT_EQ(decode(binary_sink.to_string()).size(), 1000U);
+    EXPECT_LT(binary_sink.size() * 4, text_sink.size());
+}
+
+TEST(BinaryLog, time_range)
+{
+    arc::io::MemorySink sink;
+    arc::clock::TimeInt middle = 0;
+    {
+        arc::log::Logger logger(
+            sink,
+            arc::log::FullPolicy::kBlock,
+            arc::log::Logger::DEFAULT_QUEUE_CAPACITY,
+            arc::log::OutputFormat::kBinary
+        );
+        ARC_LOG_INFO(logger, "before {}", 1);
+        ARC_LOG_INFO(logger, "before {}", 2);
+        // flushing ends the block
+        logger.flush();
+        middle =
+            arc::clock::get_current_time(arc::clock::TimeMetric::kNanoseconds);
+        ARC_LOG_INFO(logger, "after {}", 3);
+    }
+
+    // the background thread may have split the messages into more blocks
+    std::size_t skipped = 0;
+    EXPECT_EQ(
+        decode(
+            sink.to_string(),
+            middle,
+            ~static_cast<arc::clock::TimeInt>(0),
+            &skipped
+        ),
+        std::vector<std::string>({"[INFO] after 3"})
+    );
+    EXPECT_GE(skipped, 1U);
+
+    EXPECT_EQ(
+        decode(sink.to_string(), 0, middle, &skipped),
+        std::vector<std::string>({"[INFO] before 1", "[INFO] before 2"})
+    );
+    EXPECT_GE(skipped, 1U);
+}
+
+TEST(BinaryLog, appended)
+{
+    // each logger defines its sites again, so logs can share a file
+    arc::io::MemorySink sink;
+    for(int i = 0; i < 2; ++i)
+    {
+        arc::log::Logger logger(
+            sink,
+            arc::log::FullPolicy::kBlock,
+            arc::log::Logger::DEFAULT_QUEUE_CAPACITY,
+            arc::log::OutputFormat::kBinary
+        );
+        if(i == 1)
+        {
+            ARC_LOG_WARNING(logger, "second {}", "log");
+        }
+        ARC_LOG_INFO(logger, "log {}", i);
+    }
+    EXPECT_EQ(
+        decode(sink.to_string()),
+        std::vector<std::string>({
+            "[INFO] log 0",
+            "[WARNING] second log",
+            "[INFO] log 1"
+        })
+    );
+}
+
+TEST(BinaryLog, malformed)
+{
+    EXPECT_EQ(decode("").size(), 0U);
+    EXPECT_THROW(
+        decode("2018/06/02 - 14:03:27.041 [INFO] text\n"),
+        arc::ex::ValueError
+    );
+
+    arc::io::MemorySink sink;
+    {
+        arc::log::Logger logger(
+            sink,
+            arc::log::FullPolicy::kBlock,
+            arc::log::Logger::DEFAULT_QUEUE_CAPACITY,
+            arc::log::OutputFormat::kBinary
+        );
+        ARC_LOG_INFO(logger, "{} {}", "some", "text");
+    }
+    const std::string data = sink.to_string();
+
+    // truncated part way through a block or a header
+    EXPECT_THROW(
+        decode(data.substr(0, data.size() - 1)),
+        arc::ex::ValueError
+    );
+    EXPECT_THROW(
+        decode(data.substr(0, data.size() - 5)),
+        arc::ex::ValueError
+    );
+
+    // a message of a site which isn't defined (the message is the site id, the
+    // time delta, and the two strings)
+    std::string undefined = data;
+    undefined[undefined.size() - 12] = 5;
+    EXPECT_THROW(decode(undefined), arc::ex::ValueError);
+}
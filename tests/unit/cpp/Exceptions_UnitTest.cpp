@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include <arcanecore/base/Exceptions.hpp>
+
+
+//------------------------------------------------------------------------------
+//                                     TESTS
+//------------------------------------------------------------------------------
+
+TEST(Exceptions, type)
+{
+    EXPECT_STREQ(arc::ex::ArcError("").get_type().c_str(), "ArcError");
+    EXPECT_STREQ(arc::ex::RuntimeError("").get_type().c_str(), "RuntimeError");
+    EXPECT_STREQ(arc::ex::ValueError("").get_type().c_str(), "ValueError");
+    EXPECT_STREQ(arc::ex::StateError("").get_type().c_str(), "StateError");
+}
+
+TEST(Exceptions, what)
+{
+    arc::ex::ValueError inline_error("Invalid value.");
+    EXPECT_STREQ(inline_error.what(), "Invalid value.");
+
+    // too long to be stored inline
+    std::string message(arc::ex::ArcError::INLINE_WHAT_SIZE * 2, 'x');
+    arc::ex::ValueError heap_error(message.c_str());
+    EXPECT_EQ(std::string(heap_error.what()), message);
+
+    arc::ex::ValueError copy(heap_error);
+    EXPECT_EQ(std::string(copy.what()), message);
+    copy = inline_error;
+    EXPECT_STREQ(copy.what(), "Invalid value.");
+
+    try
+    {
+        throw arc::ex::StateError(deus::UnicodeView("Invalid state."));
+    }
+    catch(const std::runtime_error& e)
+    {
+        EXPECT_STREQ(e.what(), "Invalid state.");
+    }
+}
+
+TEST(Exceptions, stack_trace)
+{
+    EXPECT_FALSE(arc::ex::ArcError::is_stack_trace_enabled());
+    EXPECT_TRUE(arc::ex::RuntimeError("").get_stack_trace().empty());
+
+    arc::ex::ArcError::set_stack_trace_enabled(true);
+    arc::ex::RuntimeError error("");
+    arc::ex::ArcError::set_stack_trace_enabled(false);
+
+    ASSERT_FALSE(error.get_stack_trace().empty());
+    EXPECT_FALSE(error.get_stack_trace().to_string().empty());
+
+    // copies keep the trace
+    arc::ex::RuntimeError copy(error);
+    ASSERT_EQ(
+        copy.get_stack_trace().get_size(),
+        error.get_stack_trace().get_size()
+    );
+    EXPECT_EQ(
+        copy.get_stack_trace().get_frame(0),
+        error.get_stack_trace().get_frame(0)
+    );
+}
@@ -0,0 +1,304 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <arcanecore/base/fiber/ConditionVariable.hpp>
+#include <arcanecore/base/fiber/Context.hpp>
+#include <arcanecore/base/fiber/Mutex.hpp>
+#include <arcanecore/base/fiber/Scheduler.hpp>
+#include <arcanecore/base/fiber/StackPool.hpp>
+
+
+//------------------------------------------------------------------------------
+//                                    FIXTURES
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+// the state shared between the main context and a raw context
+struct PingPong
+{
+    arc::fiber::Context main;
+    arc::fiber::Context other;
+    std::vector<int> trace;
+};
+
+void ping_pong_entry(void* argument)
+{
+    PingPong& state = *static_cast<PingPong*>(argument);
+    for(int i = 0; i < 3; ++i)
+    {
+        state.trace.push_back(i * 2 + 1);
+        arc::fiber::switch_context(state.other, state.main);
+    }
+    // never switched back to
+    arc::fiber::switch_context(state.other, state.main);
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                     TESTS
+//------------------------------------------------------------------------------
+
+TEST(Context, switch_context)
+{
+    arc::fiber::StackPool stacks;
+    const arc::fiber::Stack stack = stacks.allocate();
+
+    PingPong state;
+    arc::fiber::make_context(
+        state.other,
+        stack.get_top(),
+        &ping_pong_entry,
+        &state
+    );
+    for(int i = 0; i < 3; ++i)
+    {
+        state.trace.push_back(i * 2);
+        arc::fiber::switch_context(state.main, state.other);
+    }
+    EXPECT_EQ(state.trace, std::vector<int>({0, 1, 2, 3, 4, 5}));
+
+    stacks.deallocate(stack);
+}
+
+TEST(StackPool, reuse)
+{
+    arc::fiber::StackPool stacks(1000, false);
+    EXPECT_EQ(stacks.get_stack_size() % 4096, 0U);
+    EXPECT_FALSE(stacks.get_guard_pages());
+
+    const arc::fiber::Stack a = stacks.allocate();
+    const arc::fiber::Stack b = stacks.allocate();
+    EXPECT_NE(a.base, b.base);
+    // the whole stack is writable
+    static_cast<char*>(a.base)[0] = 1;
+    static_cast<char*>(a.get_top())[-1] = 1;
+
+    stacks.deallocate(a);
+    EXPECT_EQ(stacks.allocate().base, a.base);
+    stacks.deallocate(a);
+    stacks.deallocate(b);
+}
+
+TEST(FiberScheduler, spawn)
+{
+    std::atomic<std::size_t> counter(0);
+    {
+        arc::fiber::Scheduler scheduler(4);
+        EXPECT_EQ(scheduler.get_thread_count(), 4U);
+        EXPECT_FALSE(arc::fiber::in_fiber());
+        EXPECT_TRUE(arc::fiber::Scheduler::get_current() == nullptr);
+
+        for(std::size_t i = 0; i < 1000; ++i)
+        {
+            scheduler.spawn([&]()
+            {
+                EXPECT_TRUE(arc::fiber::in_fiber());
+                EXPECT_EQ(arc::fiber::Scheduler::get_current(), &scheduler);
+                counter.fetch_add(1);
+            });
+        }
+        // the destructor waits for every fiber
+    }
+    EXPECT_EQ(counter.load(), 1000U);
+}
+
+TEST(FiberScheduler, yield)
+{
+    // with one worker fibers are resumed in FIFO order
+    std::vector<int> trace;
+    {
+        arc::fiber::Scheduler scheduler(1);
+        // fibers spawned by a worker are queued on that worker
+        scheduler.spawn([&]()
+        {
+            for(int id = 0; id < 3; ++id)
+            {
+                scheduler.spawn([&trace, id]()
+                {
+                    for(int i = 0; i < 3; ++i)
+                    {
+                        trace.push_back(id);
+                        arc::fiber::yield();
+                    }
+                });
+            }
+        });
+    }
+    EXPECT_EQ(trace, std::vector<int>({0, 1, 2, 0, 1, 2, 0, 1, 2}));
+}
+
+TEST(FiberScheduler, spawn_from_fiber)
+{
+    std::atomic<std::size_t> counter(0);
+    {
+        arc::fiber::Scheduler scheduler(2);
+        scheduler.spawn([&]()
+        {
+            for(std::size_t i = 0; i < 100; ++i)
+            {
+                arc::fiber::Scheduler::get_current()->spawn([&]()
+                {
+                    counter.fetch_add(1);
+                });
+            }
+        });
+    }
+    EXPECT_EQ(counter.load(), 100U);
+}
+
+TEST(FiberMutex, lock)
+{
+    static const std::size_t FIBER_COUNT = 64;
+    static const std::size_t ITERATIONS = 1000;
+
+    arc::fiber::Mutex mutex;
+    std::size_t counter = 0;
+    {
+        arc::fiber::Scheduler scheduler(4);
+        for(std::size_t i = 0; i < FIBER_COUNT; ++i)
+        {
+            scheduler.spawn([&]()
+            {
+                for(std::size_t j = 0; j < ITERATIONS; ++j)
+                {
+                    std::lock_guard<arc::fiber::Mutex> lock(mutex);
+                    const std::size_t value = counter;
+                    // invite other fibers to contend for the lock
+                    if(j % 16 == 0)
+                    {
+                        arc::fiber::yield();
+                    }
+                    counter = value + 1;
+                }
+            });
+        }
+        // threads which are not fibers can also use the mutex
+        for(std::size_t j = 0; j < ITERATIONS; ++j)
+        {
+            std::lock_guard<arc::fiber::Mutex> lock(mutex);
+            ++counter;
+        }
+    }
+    EXPECT_EQ(counter, (FIBER_COUNT + 1) * ITERATIONS);
+
+    EXPECT_TRUE(mutex.try_lock());
+    EXPECT_FALSE(mutex.try_lock());
+    mutex.unlock();
+}
+
+TEST(FiberConditionVariable, producer_consumer)
+{
+    static const std::size_t ITEM_COUNT = 10000;
+
+    arc::fiber::Mutex mutex;
+    arc::fiber::ConditionVariable condition;
+    std::vector<std::size_t> queue;
+    std::size_t sum = 0;
+    bool done = false;
+    {
+        arc::fiber::Scheduler scheduler(4);
+        for(std::size_t i = 0; i < 4; ++i)
+        {
+            scheduler.spawn([&]()
+            {
+                std::unique_lock<arc::fiber::Mutex> lock(mutex);
+                while(true)
+                {
+                    condition.wait(lock, [&]()
+                    {
+                        return !queue.empty() || done;
+                    });
+                    if(queue.empty())
+                    {
+                        return;
+                    }
+                    sum += queue.back();
+                    queue.pop_back();
+                }
+            });
+        }
+
+        // produce from a thread which is not a fiber
+        for(std::size_t i = 1; i <= ITEM_COUNT; ++i)
+        {
+            std::lock_guard<arc::fiber::Mutex> lock(mutex);
+            queue.push_back(i);
+            condition.notify_one();
+        }
+        std::lock_guard<arc::fiber::Mutex> lock(mutex);
+        done = true;
+        condition.notify_all();
+    }
+    EXPECT_EQ(sum, ITEM_COUNT * (ITEM_COUNT + 1) / 2);
+}
+
+TEST(FiberConditionVariable, thread_waiter)
+{
+    // a thread which is not a fiber waits for a fiber
+    arc::fiber::Mutex mutex;
+    arc::fiber::ConditionVariable condition;
+    bool ready = false;
+
+    arc::fiber::Scheduler scheduler(1);
+    scheduler.spawn([&]()
+    {
+        std::lock_guard<arc::fiber::Mutex> lock(mutex);
+        ready = true;
+        condition.notify_all();
+    });
+
+    std::unique_lock<arc::fiber::Mutex> lock(mutex);
+    condition.wait(lock, [&]() { return ready; });
+    EXPECT_TRUE(ready);
+}
+
+TEST(FiberScheduler, many_fibers)
+{
+    // every fiber is suspended at once, which needs a stack each (fewer
+    // under ThreadSanitizer, which keeps a large amount of state per fiber)
+    #ifdef __SANITIZE_THREAD__
+        static const std::size_t FIBER_COUNT = 1000;
+    #else
+        static const std::size_t FIBER_COUNT = 100000;
+    #endif
+
+    arc::fiber::Mutex mutex;
+    arc::fiber::ConditionVariable condition;
+    arc::fiber::ConditionVariable all_waiting;
+    std::size_t waiting = 0;
+    bool release = false;
+    std::atomic<std::size_t> finished(0);
+    {
+        // guard pages would need two mappings per stack, which exceeds the
+        // default mapping limit of Linux at this fiber count
+        arc::fiber::Scheduler scheduler(2, 16 * 1024, false);
+        for(std::size_t i = 0; i < FIBER_COUNT; ++i)
+        {
+            scheduler.spawn([&]()
+            {
+                std::unique_lock<arc::fiber::Mutex> lock(mutex);
+                if(++waiting == FIBER_COUNT)
+                {
+                    all_waiting.notify_one();
+                }
+                condition.wait(lock, [&]() { return release; });
+                finished.fetch_add(1);
+            });
+        }
+
+        std::unique_lock<arc::fiber::Mutex> lock(mutex);
+        all_waiting.wait(lock, [&]() { return waiting == FIBER_COUNT; });
+        EXPECT_EQ(scheduler.get_fiber_count(), FIBER_COUNT);
+        release = true;
+        condition.notify_all();
+    }
+    EXPECT_EQ(finished.load(), FIBER_COUNT);
+}
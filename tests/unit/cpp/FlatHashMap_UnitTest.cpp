@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include <deus/UnicodeView.hpp>
+
+#include <arcanecore/base/lang/FlatHashMap.hpp>
+#include <arcanecore/base/lang/FlatHashSet.hpp>
+
+
+//------------------------------------------------------------------------------
+//                                     TESTS
+//------------------------------------------------------------------------------
+
+TEST(FlatHashMap, insert_find_erase)
+{
+    // compare against std::unordered_map with a mix of inserts and erases
+    arc::lang::FlatHashMap<int, int> map;
+    std::unordered_map<int, int> expected;
+    unsigned int state = 12345;
+    for(int i = 0; i < 20000; ++i)
+    {
+        state = state * 1103515245U + 12345U;
+        const int key = static_cast<int>((state >> 8) % 2000);
+        if((state >> 4) % 3 == 0)
+        {
+            EXPECT_EQ(map.erase(key), expected.erase(key));
+        }
+        else
+        {
+            map[key] = i;
+            expected[key] = i;
+        }
+    }
+
+    ASSERT_EQ(map.size(), expected.size());
+    for(const std::pair<const int, int>& value : expected)
+    {
+        auto it = map.find(value.first);
+        ASSERT_TRUE(it != map.end());
+        EXPECT_EQ(it->second, value.second);
+    }
+    std::size_t count = 0;
+    for(const std::pair<const int, int>& value : map)
+    {
+        EXPECT_EQ(expected.at(value.first), value.second);
+        ++count;
+    }
+    EXPECT_EQ(count, expected.size());
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_TRUE(map.begin() == map.end());
+    EXPECT_FALSE(map.contains(1));
+}
+
+TEST(FlatHashMap, heterogeneous_lookup)
+{
+    arc::lang::FlatHashMap<
+        std::string,
+        std::unique_ptr<int>,
+        arc::lang::StringHash,
+        arc::lang::StringEqual
+    > map;
+    EXPECT_TRUE(map.try_emplace("--help", new int(1)).second);
+    // the value is not constructed if the key exists
+    std::unique_ptr<int> unused(new int(2));
+    EXPECT_FALSE(map.try_emplace(std::string("--help"), unused.get()).second);
+    EXPECT_EQ(*map.find("--help")->second, 1);
+    map.insert_or_assign("--version", std::unique_ptr<int>(new int(3)));
+
+    EXPECT_EQ(*map.find("--help")->second, 1);
+    EXPECT_EQ(*map.find(deus::UnicodeView("--version"))->second, 3);
+    EXPECT_TRUE(map.find(deus::UnicodeView("--verb")) == map.end());
+
+    // values (and keys) are moved when the map grows
+    for(int i = 0; i < 100; ++i)
+    {
+        map.try_emplace(std::to_string(i), new int(i));
+    }
+    EXPECT_EQ(*map.find("99")->second, 99);
+    EXPECT_EQ(*map.find("--help")->second, 1);
+
+    arc::lang::FlatHashMap<
+        std::string,
+        std::unique_ptr<int>,
+        arc::lang::StringHash,
+        arc::lang::StringEqual
+    > moved(std::move(map));
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(moved.size(), 102U);
+    EXPECT_EQ(moved.erase("--help"), 1U);
+    EXPECT_FALSE(moved.contains("--help"));
+}
+
+TEST(FlatHashSet, insert)
+{
+    arc::lang::FlatHashSet<std::string> set{"a", "b"};
+    EXPECT_FALSE(set.insert("a").second);
+    EXPECT_TRUE(set.insert("c").second);
+    EXPECT_EQ(set.size(), 3U);
+
+    arc::lang::FlatHashSet<std::string> copy(set);
+    EXPECT_TRUE(copy == set);
+    copy.erase("b");
+    EXPECT_TRUE(copy != set);
+    EXPECT_FALSE(copy.contains("b"));
+}
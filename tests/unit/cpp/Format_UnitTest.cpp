@@ -0,0 +1,287 @@
+#include <gtest/gtest.h>
+
+#include <cfloat>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+
+#include <deus/UnicodeStorage.hpp>
+#include <deus/UnicodeView.hpp>
+
+#include <arcanecore/base/Exceptions.hpp>
+#include <arcanecore/base/fmt/Format.hpp>
+#include <arcanecore/base/fmt/Number.hpp>
+#include <arcanecore/base/lang/Atom.hpp>
+#include <arcanecore/base/lang/StringBuilder.hpp>
+
+
+//------------------------------------------------------------------------------
+//                                    FIXTURES
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+std::string shortest(double value)
+{
+    char buffer[arc::fmt::MAX_SHORTEST_CHARS];
+    return std::string(buffer, arc::fmt::write_shortest(buffer, value));
+}
+
+std::string shortest(float value)
+{
+    char buffer[arc::fmt::MAX_SHORTEST_CHARS];
+    return std::string(buffer, arc::fmt::write_shortest(buffer, value));
+}
+
+// returns the fewest significant digits printf needs to round trip the value
+template<typename T>
+int get_shortest_precision(T value, int max_precision)
+{
+    char buffer[64];
+    for(int precision = 1; precision < max_precision; ++precision)
+    {
+        std::snprintf(
+            buffer,
+            sizeof(buffer),
+            "%.*e",
+            precision - 1,
+            static_cast<double>(value)
+        );
+        if(static_cast<T>(std::strtod(buffer, nullptr)) == value)
+        {
+            return precision;
+        }
+    }
+    return max_precision;
+}
+
+// returns the number of significant digits in a formatted number
+int count_significant(const std::string& text)
+{
+    std::string digits;
+    for(char c : text)
+    {
+        if(c == 'e')
+        {
+            break;
+        }
+        if(c >= '0' && c <= '9')
+        {
+            digits += c;
+        }
+    }
+    const std::size_t first = digits.find_first_not_of('0');
+    if(first == std::string::npos)
+    {
+        return 1;
+    }
+    return static_cast<int>(digits.find_last_not_of('0') - first + 1);
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                     TESTS
+//------------------------------------------------------------------------------
+
+TEST(FormatNumber, integers)
+{
+    char buffer[arc::fmt::MAX_INTEGER_CHARS];
+    EXPECT_EQ(
+        std::string(buffer, arc::fmt::write_unsigned(buffer, 0)),
+        "0"
+    );
+    EXPECT_EQ(
+        std::string(
+            buffer,
+            arc::fmt::write_unsigned(buffer, ULLONG_MAX)
+        ),
+        "18446744073709551615"
+    );
+    EXPECT_EQ(
+        std::string(buffer, arc::fmt::write_signed(buffer, LLONG_MIN)),
+        "-9223372036854775808"
+    );
+    EXPECT_EQ(
+        std::string(buffer, arc::fmt::write_hex(buffer, 0xBEEF)),
+        "beef"
+    );
+    EXPECT_EQ(
+        std::string(buffer, arc::fmt::write_hex(buffer, ULLONG_MAX, true)),
+        "FFFFFFFFFFFFFFFF"
+    );
+    for(long long i = -1000; i <= 1000; ++i)
+    {
+        EXPECT_EQ(
+            std::string(buffer, arc::fmt::write_signed(buffer, i)),
+            std::to_string(i)
+        );
+    }
+}
+
+TEST(FormatNumber, shortest)
+{
+    EXPECT_EQ(shortest(0.0), "0");
+    EXPECT_EQ(shortest(-0.0), "-0");
+    EXPECT_EQ(shortest(0.1), "0.1");
+    EXPECT_EQ(shortest(0.3), "0.3");
+    EXPECT_EQ(shortest(1.5), "1.5");
+    EXPECT_EQ(shortest(100.0), "100");
+    EXPECT_EQ(shortest(1234.5), "1234.5");
+    EXPECT_EQ(shortest(1e15), "1000000000000000");
+    EXPECT_EQ(shortest(1e16), "1e+16");
+    EXPECT_EQ(shortest(0.00001), "0.00001");
+    EXPECT_EQ(shortest(0.000001), "1e-06");
+    EXPECT_EQ(shortest(5e-324), "5e-324");
+    EXPECT_EQ(shortest(DBL_MAX), "1.7976931348623157e+308");
+    EXPECT_EQ(shortest(0.1F), "0.1");
+    EXPECT_EQ(shortest(FLT_MAX), "3.4028235e+38");
+    EXPECT_EQ(shortest(std::numeric_limits<double>::infinity()), "inf");
+    EXPECT_EQ(shortest(-std::numeric_limits<float>::infinity()), "-inf");
+    EXPECT_EQ(shortest(std::numeric_limits<double>::quiet_NaN()), "nan");
+}
+
+TEST(FormatNumber, shortest_round_trip)
+{
+    // random bit patterns parse back to the same value with no more digits
+    // than printf needs
+    std::mt19937_64 random(1234);
+    for(std::size_t i = 0; i < 20000; ++i)
+    {
+        const std::uint64_t bits = random();
+        double d;
+        std::memcpy(&d, &bits, sizeof(d));
+        if(d == d && d - d == 0)
+        {
+            const std::string text = shortest(d);
+            ASSERT_EQ(std::strtod(text.c_str(), nullptr), d) << text;
+            ASSERT_LE(count_significant(text), get_shortest_precision(d, 17))
+                << text;
+        }
+
+        const std::uint32_t float_bits = static_cast<std::uint32_t>(bits);
+        float f;
+        std::memcpy(&f, &float_bits, sizeof(f));
+        if(f == f && f - f == 0)
+        {
+            const std::string text = shortest(f);
+            ASSERT_EQ(std::strtof(text.c_str(), nullptr), f) << text;
+            ASSERT_LE(count_significant(text), get_shortest_precision(f, 9))
+                << text;
+        }
+    }
+}
+
+TEST(Format, arguments)
+{
+    const std::string s = "std";
+    const int* pointer = reinterpret_cast<const int*>(0x1234);
+    EXPECT_EQ(
+        ARC_FMT(
+            "{} {} {} {} {} {} {} {} {} {} {}",
+            -42,
+            42U,
+            true,
+            'c',
+            2.5F,
+            0.1,
+            "literal",
+            s,
+            deus::UnicodeView("view"),
+            deus::UnicodeStorage("storage"),
+            arc::lang::Atom("atom")
+        ),
+        "-42 42 true c 2.5 0.1 literal std view storage atom"
+    );
+    EXPECT_EQ(ARC_FMT("{}", pointer), "0x1234");
+    EXPECT_EQ(ARC_FMT("no fields"), "no fields");
+    EXPECT_EQ(ARC_FMT("{{{}}} }}{{", 1), "{1} }{");
+}
+
+TEST(Format, specs)
+{
+    EXPECT_EQ(ARC_FMT("[{:5}]", 42), "[   42]");
+    EXPECT_EQ(ARC_FMT("[{:<5}]", 42), "[42   ]");
+    EXPECT_EQ(ARC_FMT("[{:^6}]", 42), "[  42  ]");
+    EXPECT_EQ(ARC_FMT("[{:05}]", -42), "[-0042]");
+    EXPECT_EQ(ARC_FMT("[{:5}]", "ab"), "[ab   ]");
+    EXPECT_EQ(ARC_FMT("[{:>5}]", "ab"), "[   ab]");
+    // width counts code points rather than bytes
+    EXPECT_EQ(ARC_FMT("[{:3}]", "\xC3\xA9"), "[\xC3\xA9  ]");
+    EXPECT_EQ(ARC_FMT("[{:1}]", "long"), "[long]");
+
+    EXPECT_EQ(ARC_FMT("{:x} {:X} {:x}", 255, 255U, -255), "ff FF -ff");
+    EXPECT_EQ(ARC_FMT("{:08x}", 0xBEEFU), "0000beef");
+    EXPECT_EQ(ARC_FMT("{:d} {:c} {:x}", 'A', 'A', 'A'), "65 A 41");
+    EXPECT_EQ(ARC_FMT("{:.3f} {:.2e} {:.3}", 3.14159, 31415.9, 2.0 / 3.0),
+              "3.142 3.14e+04 0.667");
+    EXPECT_EQ(ARC_FMT("{:8.2f}|{:08.2f}", 3.14159, -3.14159),
+              "    3.14|-0003.14");
+    EXPECT_EQ(ARC_FMT("{:f}", 1.5F), "1.500000");
+    EXPECT_EQ(ARC_FMT("{:s} {:s}", "str", false), "str false");
+
+    // a long result from an explicit precision
+    const std::string big = ARC_FMT("{:.2f}", 1e300);
+    EXPECT_EQ(big.size(), 304U);
+    EXPECT_EQ(big.substr(big.size() - 3), ".00");
+}
+
+TEST(Format, outputs)
+{
+    arc::lang::StringBuilder builder;
+    builder << "prefix ";
+    ARC_FMT_TO(builder, "{} + {} = {}", 1, 2, 3);
+    EXPECT_STREQ(builder.c_str(), "prefix 1 + 2 = 3");
+
+    // truncates like snprintf
+    char buffer[8];
+    EXPECT_EQ(ARC_FMT_TO_BUFFER(buffer, sizeof(buffer), "{}", 12345), 5U);
+    EXPECT_STREQ(buffer, "12345");
+    EXPECT_EQ(
+        ARC_FMT_TO_BUFFER(buffer, sizeof(buffer), "{:>12}", "abc"),
+        12U
+    );
+    EXPECT_STREQ(buffer, "       ");
+    EXPECT_EQ(ARC_FMT_TO_BUFFER(buffer, 0, "{}", 1), 1U);
+
+    EXPECT_EQ(arc::fmt::format_to(buffer, sizeof(buffer), "{}!", 'x'), 2U);
+    EXPECT_STREQ(buffer, "x!");
+}
+
+TEST(Format, run_time_checks)
+{
+    // the same checks ARC_FMT makes at compile time
+    EXPECT_EQ(arc::fmt::format("{} {:.1f}", "a", 0.25), "a 0.2");
+    EXPECT_THROW(arc::fmt::format("{} {}", 1), arc::ex::ValueError);
+    EXPECT_THROW(arc::fmt::format("{}", 1, 2), arc::ex::ValueError);
+    EXPECT_THROW(arc::fmt::format("{", 1), arc::ex::ValueError);
+    EXPECT_THROW(arc::fmt::format("}", 1), arc::ex::ValueError);
+    EXPECT_THROW(arc::fmt::format("{:q}", 1), arc::ex::ValueError);
+    EXPECT_THROW(arc::fmt::format("{:.2}", 1), arc::ex::ValueError);
+    EXPECT_THROW(arc::fmt::format("{:x}", "s"), arc::ex::ValueError);
+    EXPECT_THROW(arc::fmt::format("{:05}", "s"), arc::ex::ValueError);
+    EXPECT_THROW(arc::fmt::format("{0}", 1), arc::ex::ValueError);
+
+    // long format strings don't exceed the compiler's constexpr depth
+    EXPECT_EQ(
+        ARC_FMT(
+            "0123456789012345678901234567890123456789012345678901234567890123"
+            "0123456789012345678901234567890123456789012345678901234567890123"
+            "0123456789012345678901234567890123456789012345678901234567890123"
+            "0123456789012345678901234567890123456789012345678901234567890123"
+            "0123456789012345678901234567890123456789012345678901234567890123"
+            "0123456789012345678901234567890123456789012345678901234567890123"
+            "0123456789012345678901234567890123456789012345678901234567890123"
+            "0123456789012345678901234567890123456789012345678901234567890123"
+            "0123456789012345678901234567890123456789012345678901234567890123"
+            "{}",
+            1
+        ).size(),
+        64U * 9 + 1
+    );
+}
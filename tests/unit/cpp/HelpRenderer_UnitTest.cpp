@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <arcanecore/base/arg/Flag.hpp>
+#include <arcanecore/base/arg/HelpRenderer.hpp>
+#include <arcanecore/base/arg/Parser.hpp>
+#include <arcanecore/base/io/MemorySink.hpp>
+
+
+//------------------------------------------------------------------------------
+//                                    FIXTURES
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+// a flag that only exists to be described
+class DescribedFlag
+    : public arc::arg::Flag
+{
+public:
+
+    DescribedFlag(
+            const deus::UnicodeView& long_key,
+            const deus::UnicodeView& short_key,
+            const deus::UnicodeView& description)
+        : arc::arg::Flag(long_key, short_key, description)
+    {
+    }
+
+    virtual bool execute(int& out_exit_code) override
+    {
+        return true;
+    }
+};
+
+// splits the given text into lines
+std::vector<std::string> split_lines(const std::string& text)
+{
+    std::vector<std::string> lines;
+    std::size_t begin = 0;
+    while(begin < text.size())
+    {
+        std::size_t end = text.find('\n', begin);
+        if(end == std::string::npos)
+        {
+            end = text.size();
+        }
+        lines.push_back(text.substr(begin, end - begin));
+        begin = end + 1;
+    }
+    return lines;
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                     TESTS
+//------------------------------------------------------------------------------
+
+TEST(HelpRenderer, word_wrapping)
+{
+    arc::arg::Parser parser;
+    parser.add_flag(new DescribedFlag(
+        "verbose",
+        "",
+        "Prints a great deal of extra information about what is happening "
+        "while the program runs, which is mostly useful for debugging."
+    ));
+
+    arc::arg::HelpRenderer renderer("app [options]");
+    const std::string& text = renderer.render(parser, 50);
+    const std::vector<std::string> lines = split_lines(text);
+
+    // the description begins on the key's line and continues on lines
+    // indented to the description column
+    std::size_t description_column = std::string::npos;
+    std::size_t continuation_lines = 0;
+    for(const std::string& line : lines)
+    {
+        EXPECT_LE(line.size(), 50U) << line;
+        const std::size_t separator = line.find(":: ");
+        if(separator != std::string::npos)
+        {
+            description_column = separator + 3;
+            EXPECT_EQ(line.find("--verbose"), 4U);
+        }
+        else if(description_column != std::string::npos && !line.empty() &&
+                line[0] == ' ')
+        {
+            EXPECT_EQ(
+                line.find_first_not_of(' '),
+                description_column
+            ) << line;
+            ++continuation_lines;
+        }
+    }
+    ASSERT_NE(description_column, std::string::npos);
+    EXPECT_GE(continuation_lines, 2U);
+    EXPECT_NE(text.find("debugging."), std::string::npos);
+}
+
+TEST(HelpRenderer, column_alignment)
+{
+    arc::arg::Parser parser;
+    parser.add_flag(new DescribedFlag("verbose", "", "Extra output."));
+    parser.add_flag(new DescribedFlag("output", "o", "The output path."));
+    parser.add_flag(new DescribedFlag("x", "", "Short."));
+
+    arc::arg::HelpRenderer renderer("");
+    const std::vector<std::string> lines =
+        split_lines(renderer.render(parser, 80));
+
+    // every separator is aligned to the same tab stop past the longest key
+    std::vector<std::size_t> separators;
+    for(const std::string& line : lines)
+    {
+        const std::size_t separator = line.find(":: ");
+        if(separator != std::string::npos)
+        {
+            separators.push_back(separator);
+        }
+    }
+    ASSERT_EQ(separators.size(), 3U);
+    EXPECT_EQ(separators[0], separators[1]);
+    EXPECT_EQ(separators[1], separators[2]);
+    // "    -o, --output" is the longest key at 16 columns
+    EXPECT_GT(separators[0], 16U);
+    EXPECT_EQ((separators[0] + 1) % 4, 0U);
+}
+
+TEST(HelpRenderer, cache)
+{
+    arc::arg::Parser parser;
+    parser.add_flag(new DescribedFlag("verbose", "", "Extra output."));
+
+    arc::arg::HelpRenderer renderer("app [options]");
+    const std::string& first = renderer.render(parser, 60);
+    const std::string copy = first;
+    const char* const data = first.data();
+
+    // rendering again with the same parser revision and width is a cache hit
+    const std::string& second = renderer.render(parser, 60);
+    EXPECT_EQ(&second, &first);
+    EXPECT_EQ(second.data(), data);
+    EXPECT_EQ(second, copy);
+
+    // a change of width invalidates the cached text
+    const std::string narrow = renderer.render(parser, 40);
+    EXPECT_NE(narrow, copy);
+    EXPECT_EQ(narrow.find('\n'), 40U);
+    EXPECT_EQ(renderer.render(parser, 60), copy);
+
+    // adding a definition changes the parser's revision and so invalidates
+    // the cached text
+    parser.add_flag(new DescribedFlag("quiet", "q", "Less output."));
+    const std::string& added = renderer.render(parser, 60);
+    EXPECT_NE(added, copy);
+    EXPECT_NE(added.find("-q, --quiet"), std::string::npos);
+}
+
+TEST(HelpRenderer, terminal_width_of_sink)
+{
+    // a memory sink isn't a terminal
+    arc::io::MemorySink sink;
+    EXPECT_EQ(
+        arc::arg::HelpRenderer::get_terminal_width(sink),
+        arc::arg::HelpRenderer::get_terminal_width(-1)
+    );
+    EXPECT_GT(arc::arg::HelpRenderer::get_terminal_width(-1), 0U);
+}
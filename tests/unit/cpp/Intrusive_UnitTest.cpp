@@ -0,0 +1,233 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <arcanecore/base/lang/Hash.hpp>
+#include <arcanecore/base/lang/IntrusiveHashTable.hpp>
+#include <arcanecore/base/lang/IntrusiveList.hpp>
+#include <arcanecore/base/lang/Restrictors.hpp>
+
+
+//------------------------------------------------------------------------------
+//                                    FIXTURES
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+// an object which can be in a list and a table at the same time
+class Node
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+{
+public:
+
+    std::string name;
+    int value;
+    arc::lang::IntrusiveListHook list_hook;
+    arc::lang::IntrusiveHashHook table_hook;
+
+    Node(const std::string& name_, int value_)
+        : name (name_)
+        , value(value_)
+    {
+    }
+
+    virtual ~Node()
+    {
+    }
+};
+
+struct NameOf
+{
+    const std::string& operator()(const Node& node) const
+    {
+        return node.name;
+    }
+};
+
+struct ValueOf
+{
+    int operator()(const Node& node) const
+    {
+        return node.value;
+    }
+};
+
+typedef arc::lang::IntrusiveList<Node, &Node::list_hook> NodeList;
+
+typedef arc::lang::IntrusiveHashTable<
+    Node,
+    &Node::table_hook,
+    NameOf,
+    arc::lang::StringHash,
+    arc::lang::StringEqual
+> NodeTable;
+
+std::vector<int> get_values(const NodeList& list)
+{
+    std::vector<int> values;
+    for(const Node& node : list)
+    {
+        values.push_back(node.value);
+    }
+    return values;
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                     TESTS
+//------------------------------------------------------------------------------
+
+TEST(IntrusiveList, insert_erase)
+{
+    Node a("a", 1);
+    Node b("b", 2);
+    Node c("c", 3);
+
+    NodeList list;
+    EXPECT_TRUE(list.empty());
+    EXPECT_TRUE(list.begin() == list.end());
+    list.push_back(b);
+    list.push_front(a);
+    list.push_back(c);
+    EXPECT_EQ(list.size(), 3U);
+    EXPECT_EQ(get_values(list), std::vector<int>({1, 2, 3}));
+    EXPECT_EQ(&list.front(), &a);
+    EXPECT_EQ(&list.back(), &c);
+    EXPECT_TRUE(b.list_hook.is_linked());
+
+    // removal only needs the object
+    list.erase(b);
+    EXPECT_FALSE(b.list_hook.is_linked());
+    EXPECT_EQ(get_values(list), std::vector<int>({1, 3}));
+    list.insert(list.iterator_to(c), b);
+    EXPECT_EQ(get_values(list), std::vector<int>({1, 2, 3}));
+
+    // iterate backwards
+    std::vector<int> reversed;
+    for(auto it = list.end(); it != list.begin();)
+    {
+        --it;
+        reversed.push_back(it->value);
+    }
+    EXPECT_EQ(reversed, std::vector<int>({3, 2, 1}));
+
+    list.pop_front();
+    list.pop_back();
+    EXPECT_EQ(get_values(list), std::vector<int>({2}));
+    list.clear();
+    EXPECT_TRUE(list.empty());
+    EXPECT_FALSE(b.list_hook.is_linked());
+}
+
+TEST(IntrusiveList, splice_and_move)
+{
+    Node a("a", 1);
+    Node b("b", 2);
+    Node c("c", 3);
+
+    NodeList first;
+    NodeList second;
+    first.push_back(a);
+    second.push_back(b);
+    second.push_back(c);
+    first.splice(first.end(), second);
+    EXPECT_TRUE(second.empty());
+    EXPECT_EQ(get_values(first), std::vector<int>({1, 2, 3}));
+
+    NodeList moved(std::move(first));
+    EXPECT_TRUE(first.empty());
+    EXPECT_EQ(moved.size(), 3U);
+    EXPECT_EQ(get_values(moved), std::vector<int>({1, 2, 3}));
+    moved.clear();
+}
+
+TEST(IntrusiveList, clear_and_dispose)
+{
+    // the list can be used to own heap allocated objects
+    NodeList list;
+    for(int i = 0; i < 10; ++i)
+    {
+        list.push_back(*new Node(std::to_string(i), i));
+    }
+    EXPECT_EQ(list.size(), 10U);
+    list.clear_and_dispose(std::default_delete<Node>());
+    EXPECT_TRUE(list.empty());
+}
+
+TEST(IntrusiveHashTable, insert_find_erase)
+{
+    std::vector<std::unique_ptr<Node>> nodes;
+    NodeTable table;
+    EXPECT_TRUE(table.find("0") == nullptr);
+    for(int i = 0; i < 1000; ++i)
+    {
+        nodes.emplace_back(new Node(std::to_string(i), i));
+        EXPECT_TRUE(table.insert(*nodes.back()).second);
+    }
+    EXPECT_EQ(table.size(), 1000U);
+    EXPECT_GE(table.bucket_count(), table.size());
+
+    // keys are unique
+    Node duplicate("7", -1);
+    const std::pair<Node*, bool> result = table.insert(duplicate);
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ(result.first, nodes[7].get());
+    EXPECT_FALSE(duplicate.table_hook.is_linked());
+
+    // heterogeneous lookup
+    EXPECT_EQ(table.find("999"), nodes[999].get());
+    EXPECT_EQ(table.find(std::string("42"))->value, 42);
+    EXPECT_FALSE(table.contains("1000"));
+
+    for(int i = 0; i < 1000; i += 2)
+    {
+        table.erase(*nodes[i]);
+    }
+    EXPECT_EQ(table.erase_key("1"), nodes[1].get());
+    EXPECT_TRUE(table.erase_key("1") == nullptr);
+    EXPECT_EQ(table.size(), 499U);
+    EXPECT_FALSE(table.contains("0"));
+    EXPECT_TRUE(table.contains("3"));
+
+    int sum = 0;
+    std::size_t count = 0;
+    for(const Node& node : table)
+    {
+        sum += node.value;
+        ++count;
+    }
+    EXPECT_EQ(count, 499U);
+    EXPECT_EQ(sum, 250000 - 1);
+
+    table.clear();
+    EXPECT_TRUE(table.empty());
+    EXPECT_FALSE(nodes[3]->table_hook.is_linked());
+}
+
+TEST(IntrusiveHashTable, list_and_table)
+{
+    // an object can be in a list and a table at once through separate hooks,
+    // and the default hash and equality functors are used for integer keys
+    arc::lang::IntrusiveHashTable<Node, &Node::table_hook, ValueOf> table;
+    NodeList list;
+    Node a("a", 1);
+    Node b("b", 2);
+    list.push_back(a);
+    list.push_back(b);
+    table.insert(a);
+    table.insert(b);
+
+    EXPECT_EQ(table.find(2), &b);
+    table.erase(b);
+    EXPECT_TRUE(table.find(2) == nullptr);
+    EXPECT_EQ(get_values(list), std::vector<int>({1, 2}));
+
+    list.clear();
+    table.clear();
+}
@@ -0,0 +1,506 @@
+#include <gtest/gtest.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <arcanecore/base/Exceptions.hpp>
+#include <arcanecore/base/io/IoEngine.hpp>
+#include <arcanecore/base/io/IoRequest.hpp>
+#include <arcanecore/base/lang/Span.hpp>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+
+//------------------------------------------------------------------------------
+//                                    FIXTURES
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+// a uniquely named file which is open for reading and writing, and is deleted
+// at the end of the test
+class TemporaryFile
+{
+public:
+
+    TemporaryFile()
+        : m_path("/tmp/arc_io_engine_XXXXXX")
+        , m_fd  (::mkstemp(&m_path[0]))
+    {
+    }
+
+    ~TemporaryFile()
+    {
+        ::close(m_fd);
+        std::remove(m_path.c_str());
+    }
+
+    int get_fd() const
+    {
+        return m_fd;
+    }
+
+    void write(const std::string& data) const
+    {
+        ASSERT_EQ(
+            ::pwrite(m_fd, data.data(), data.size(), 0),
+            static_cast<ssize_t>(data.size())
+        );
+    }
+
+    std::string read() const
+    {
+        const off_t size = ::lseek(m_fd, 0, SEEK_END);
+        std::string ret(static_cast<std::size_t>(size), 0);
+        EXPECT_EQ(
+            ::pread(m_fd, &ret[0], ret.size(), 0),
+            static_cast<ssize_t>(ret.size())
+        );
+        return ret;
+    }
+
+private:
+
+    std::string m_path;
+    int m_fd;
+};
+
+// returns the backends supported by this system
+std::vector<arc::io::IoBackend> get_backends()
+{
+    std::vector<arc::io::IoBackend> ret;
+    ret.push_back(arc::io::IoBackend::kThreadPool);
+    if(arc::io::IoEngine::is_io_uring_supported())
+    {
+        ret.push_back(arc::io::IoBackend::kIoUring);
+    }
+    return ret;
+}
+
+std::string make_data(std::size_t size)
+{
+    std::string ret;
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        ret += static_cast<char>('a' + (i * 7) % 26);
+    }
+    return ret;
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                     TESTS
+//------------------------------------------------------------------------------
+
+TEST(IoEngine, backends)
+{
+    arc::io::IoEngine engine;
+    EXPECT_NE(engine.get_backend(), arc::io::IoBackend::kAuto);
+    EXPECT_EQ(
+        engine.get_backend() == arc::io::IoBackend::kIoUring,
+        arc::io::IoEngine::is_io_uring_supported()
+    );
+    if(!arc::io::IoEngine::is_io_uring_supported())
+    {
+        EXPECT_THROW(
+            arc::io::IoEngine(16, arc::io::IoBackend::kIoUring),
+            arc::ex::RuntimeError
+        );
+    }
+}
+
+TEST(IoEngine, read_write)
+{
+    const std::size_t BLOCK_SIZE = 512;
+    const std::size_t BLOCK_COUNT = 64;
+    const std::string data = make_data(BLOCK_SIZE * BLOCK_COUNT);
+
+    for(arc::io::IoBackend backend : get_backends())
+    {
+        TemporaryFile file;
+        // a queue depth less than the number of requests, so that enqueuing
+        // waits for requests to complete
+        arc::io::IoEngine engine(16, backend, 3);
+        EXPECT_EQ(engine.get_backend(), backend);
+
+        std::vector<arc::io::IoRequest> requests(BLOCK_COUNT);
+        std::size_t completed = 0;
+        for(std::size_t i = 0; i < BLOCK_COUNT; ++i)
+        {
+            requests[i].prepare_write(
+                file.get_fd(),
+                data.data() + i * BLOCK_SIZE,
+                BLOCK_SIZE,
+                i * BLOCK_SIZE
+            );
+            requests[i].set_callback([&](arc::io::IoRequest& request)
+            {
+                EXPECT_FALSE(request.is_pending());
+                EXPECT_EQ(
+                    request.get_result(),
+                    static_cast<std::int64_t>(BLOCK_SIZE)
+                );
+                ++completed;
+            });
+            engine.enqueue(requests[i]);
+            EXPECT_TRUE(requests[i].is_pending() || completed > 0);
+        }
+        engine.wait_all();
+        EXPECT_EQ(completed, BLOCK_COUNT);
+        EXPECT_EQ(engine.get_pending_count(), 0U);
+        EXPECT_EQ(file.read(), data);
+
+        // read back in reverse, reusing the requests
+        std::string read(data.size(), 0);
+        for(std::size_t i = BLOCK_COUNT; i-- > 0;)
+        {
+            requests[i].prepare_read(
+                file.get_fd(),
+                &read[i * BLOCK_SIZE],
+                BLOCK_SIZE,
+                i * BLOCK_SIZE
+            );
+            engine.enqueue(requests[i]);
+        }
+        engine.wait_all();
+        EXPECT_EQ(completed, BLOCK_COUNT * 2);
+        EXPECT_EQ(read, data);
+
+        // a read past the end of the file
+        char buffer[16];
+        requests[0].prepare_read(file.get_fd(), buffer, 16, data.size() - 4);
+        requests[0].set_callback(nullptr);
+        engine.enqueue(requests[0]);
+        engine.wait(requests[0]);
+        EXPECT_EQ(requests[0].get_result(), 4);
+        EXPECT_EQ(std::string(buffer, 4), data.substr(data.size() - 4));
+    }
+}
+
+TEST(IoEngine, poll)
+{
+    const std::string data = make_data(4096);
+    for(arc::io::IoBackend backend : get_backends())
+    {
+        TemporaryFile file;
+        file.write(data);
+        arc::io::IoEngine engine(8, backend);
+
+        char buffer[4096];
+        arc::io::IoRequest request;
+        request.prepare_read(file.get_fd(), buffer, sizeof(buffer), 0);
+        EXPECT_EQ(engine.poll(), 0U);
+        engine.enqueue(request);
+        EXPECT_EQ(engine.get_pending_count(), 1U);
+        EXPECT_EQ(engine.submit(), 1U);
+        EXPECT_EQ(engine.submit(), 0U);
+
+        std::size_t completed = 0;
+        while(completed == 0)
+        {
+            completed = engine.poll();
+        }
+        EXPECT_EQ(completed, 1U);
+        EXPECT_FALSE(request.is_pending());
+        EXPECT_EQ(engine.get_pending_count(), 0U);
+        EXPECT_EQ(request.get_result(), 4096);
+        EXPECT_EQ(std::string(buffer, sizeof(buffer)), data);
+    }
+}
+
+TEST(IoEngine, callback_enqueue)
+{
+    // each completion enqueues the read of the next block
+    const std::size_t BLOCK_SIZE = 256;
+    const std::string data = make_data(BLOCK_SIZE * 10);
+    for(arc::io::IoBackend backend : get_backends())
+    {
+        TemporaryFile file;
+        file.write(data);
+        arc::io::IoEngine engine(4, backend);
+
+        std::string read;
+        char buffer[BLOCK_SIZE];
+        arc::io::IoRequest request;
+        request.set_callback([&](arc::io::IoRequest& r)
+        {
+            if(r.get_result() <= 0)
+            {
+                return;
+            }
+            read.append(buffer, static_cast<std::size_t>(r.get_result()));
+            r.prepare_read(file.get_fd(), buffer, BLOCK_SIZE, read.size());
+            engine.enqueue(r);
+        });
+        request.prepare_read(file.get_fd(), buffer, BLOCK_SIZE, 0);
+        engine.enqueue(request);
+        engine.wait_all();
+        EXPECT_EQ(read, data);
+        EXPECT_EQ(request.get_result(), 0);
+    }
+}
+
+TEST(IoEngine, registered)
+{
+    const std::size_t BLOCK_SIZE = 4096;
+    const std::string data = make_data(BLOCK_SIZE * 4);
+    for(arc::io::IoBackend backend : get_backends())
+    {
+        TemporaryFile source;
+        TemporaryFile destination;
+        source.write(data);
+        arc::io::IoEngine engine(16, backend);
+
+        const int fds[] = {source.get_fd(), destination.get_fd()};
+        engine.register_files(fds);
+        std::vector<char> memory(data.size());
+        const arc::lang::Span<char> buffers[] = {
+            arc::lang::Span<char>(memory.data(), memory.size())
+        };
+        engine.register_buffers(buffers);
+
+        // read into the registered buffer, and then write it out
+        std::vector<arc::io::IoRequest> requests(4);
+        for(std::size_t i = 0; i < requests.size(); ++i)
+        {
+            requests[i].prepare_read(
+                0,
+                memory.data() + i * BLOCK_SIZE,
+                BLOCK_SIZE,
+                i * BLOCK_SIZE
+            );
+            requests[i].set_registered_file(true);
+            requests[i].set_registered_buffer(0);
+            engine.enqueue(requests[i]);
+        }
+        engine.wait_all();
+        EXPECT_EQ(std::string(memory.data(), memory.size()), data);
+
+        for(std::size_t i = 0; i < requests.size(); ++i)
+        {
+            EXPECT_EQ(
+                requests[i].get_result(),
+                static_cast<std::int64_t>(BLOCK_SIZE)
+            );
+            requests[i].prepare_write(
+                1,
+                memory.data() + i * BLOCK_SIZE,
+                BLOCK_SIZE,
+                i * BLOCK_SIZE
+            );
+            requests[i].set_registered_file(true);
+            requests[i].set_registered_buffer(0);
+            engine.enqueue(requests[i]);
+        }
+        engine.wait_all();
+        EXPECT_EQ(destination.read(), data);
+
+        // unregistering
+        engine.register_files(arc::lang::Span<const int>());
+        requests[0].prepare_read(0, memory.data(), BLOCK_SIZE, 0);
+        requests[0].set_registered_file(true);
+        EXPECT_THROW(engine.enqueue(requests[0]), arc::ex::ValueError);
+    }
+}
+
+TEST(IoEngine, linked)
+{
+    const std::string data = make_data(1000);
+    for(arc::io::IoBackend backend : get_backends())
+    {
+        TemporaryFile file;
+        arc::io::IoEngine engine(16, backend);
+
+        // a write followed by a read of what was written
+        arc::io::IoRequest write;
+        arc::io::IoRequest read;
+        std::string buffer(data.size(), 0);
+        write.prepare_write(file.get_fd(), data.data(), data.size(), 0);
+        write.set_linked(true);
+        read.prepare_read(file.get_fd(), &buffer[0], buffer.size(), 0);
+        engine.enqueue(write);
+        engine.enqueue(read);
+        engine.wait_all();
+        EXPECT_EQ(write.get_result(), 1000);
+        EXPECT_EQ(read.get_result(), 1000);
+        EXPECT_EQ(buffer, data);
+
+        // a failure cancels the rest of the chain
+        arc::io::IoRequest chain[3];
+        char bytes[3][100];
+        chain[0].prepare_read(-1, bytes[0], 100, 0);
+        chain[0].set_linked(true);
+        chain[1].prepare_read(file.get_fd(), bytes[1], 100, 0);
+        chain[1].set_linked(true);
+        chain[2].prepare_read(file.get_fd(), bytes[2], 100, 0);
+        for(arc::io::IoRequest& request : chain)
+        {
+            engine.enqueue(request);
+        }
+        // unlinked requests are unaffected
+        arc::io::IoRequest independent;
+        independent.prepare_read(file.get_fd(), &buffer[0], 100, 0);
+        engine.enqueue(independent);
+        engine.wait_all();
+        EXPECT_EQ(chain[0].get_result(), -EBADF);
+        EXPECT_EQ(chain[1].get_result(), -ECANCELED);
+        EXPECT_EQ(chain[2].get_result(), -ECANCELED);
+        EXPECT_EQ(independent.get_result(), 100);
+
+        // as does a short read
+        chain[0].prepare_read(file.get_fd(), bytes[0], 100, 950);
+        chain[0].set_linked(true);
+        chain[1].prepare_read(file.get_fd(), bytes[1], 100, 0);
+        engine.enqueue(chain[0]);
+        engine.enqueue(chain[1]);
+        engine.wait(chain[1]);
+        EXPECT_EQ(chain[0].get_result(), 50);
+        EXPECT_EQ(chain[1].get_result(), -ECANCELED);
+    }
+}
+
+TEST(IoEngine, linked_queue_depth)
+{
+    const std::string data = make_data(1000);
+    for(arc::io::IoBackend backend : get_backends())
+    {
+        TemporaryFile file;
+        file.write(data);
+        arc::io::IoEngine engine(3, backend);
+        char bytes[4][100];
+
+        // a full queue only waits for the request submitted before the chain,
+        // rather than submitting the chain in two parts
+        arc::io::IoRequest before;
+        before.prepare_read(file.get_fd(), bytes[3], 100, 0);
+        engine.enqueue(before);
+        engine.submit();
+        arc::io::IoRequest chain[3];
+        chain[0].prepare_read(-1, bytes[0], 100, 0);
+        chain[0].set_linked(true);
+        chain[1].prepare_read(file.get_fd(), bytes[1], 100, 0);
+        chain[1].set_linked(true);
+        chain[2].prepare_read(file.get_fd(), bytes[2], 100, 0);
+        for(arc::io::IoRequest& request : chain)
+        {
+            engine.enqueue(request);
+        }
+        engine.wait_all();
+        EXPECT_EQ(before.get_result(), 100);
+        EXPECT_EQ(chain[0].get_result(), -EBADF);
+        EXPECT_EQ(chain[1].get_result(), -ECANCELED);
+        EXPECT_EQ(chain[2].get_result(), -ECANCELED);
+
+        // a chain which can't fit in the queue is rejected
+        arc::io::IoRequest long_chain[4];
+        for(std::size_t i = 0; i < 4; ++i)
+        {
+            long_chain[i].prepare_read(-1, bytes[i], 100, 0);
+            long_chain[i].set_linked(true);
+        }
+        for(std::size_t i = 0; i < 3; ++i)
+        {
+            engine.enqueue(long_chain[i]);
+        }
+        EXPECT_THROW(engine.enqueue(long_chain[3]), arc::ex::ValueError);
+        EXPECT_FALSE(long_chain[3].is_pending());
+        engine.wait_all();
+        EXPECT_EQ(long_chain[0].get_result(), -EBADF);
+        EXPECT_EQ(long_chain[1].get_result(), -ECANCELED);
+        EXPECT_EQ(long_chain[2].get_result(), -ECANCELED);
+    }
+}
+
+TEST(IoEngine, errors)
+{
+    for(arc::io::IoBackend backend : get_backends())
+    {
+        TemporaryFile file;
+        file.write(make_data(100));
+        arc::io::IoEngine engine(16, backend);
+
+        arc::io::IoRequest request;
+        EXPECT_EQ(
+            request.get_operation(),
+            arc::io::IoRequest::Operation::kNone
+        );
+        EXPECT_THROW(engine.enqueue(request), arc::ex::ValueError);
+
+        // buffers outside of the registered buffer
+        char memory[64];
+        const arc::lang::Span<char> buffers[] = {
+            arc::lang::Span<char>(memory, 32)
+        };
+        engine.register_buffers(buffers);
+        request.prepare_read(file.get_fd(), memory + 16, 32, 0);
+        request.set_registered_buffer(0);
+        EXPECT_THROW(engine.enqueue(request), arc::ex::ValueError);
+        request.set_registered_buffer(1);
+        EXPECT_THROW(engine.enqueue(request), arc::ex::ValueError);
+
+        // a request may only be pending once, and nothing is registered while
+        // requests are pending
+        request.prepare_read(file.get_fd(), memory, 32, 0);
+        engine.enqueue(request);
+        EXPECT_TRUE(request.is_pending());
+        EXPECT_THROW(engine.enqueue(request), arc::ex::StateError);
+        const int fds[] = {file.get_fd()};
+        EXPECT_THROW(engine.register_files(fds), arc::ex::StateError);
+        EXPECT_THROW(engine.register_buffers(buffers), arc::ex::StateError);
+        engine.wait(request);
+        EXPECT_FALSE(request.is_pending());
+        EXPECT_EQ(request.get_result(), 32);
+
+        // errors are reported through the result
+        request.prepare_write(file.get_fd() + 1000, memory, 32, 0);
+        engine.enqueue(request);
+        engine.wait(request);
+        EXPECT_EQ(request.get_result(), -EBADF);
+    }
+}
+
+TEST(IoEngine, destructor_waits)
+{
+    const std::string data = make_data(8192);
+    for(arc::io::IoBackend backend : get_backends())
+    {
+        TemporaryFile file;
+        file.write(data);
+        std::vector<arc::io::IoRequest> requests(8);
+        std::vector<std::string> buffers(8, std::string(1024, 0));
+        std::size_t completed = 0;
+        {
+            arc::io::IoEngine engine(4, backend);
+            for(std::size_t i = 0; i < requests.size(); ++i)
+            {
+                requests[i].prepare_read(
+                    file.get_fd(),
+                    &buffers[i][0],
+                    1024,
+                    i * 1024
+                );
+                requests[i].set_callback([&](arc::io::IoRequest&)
+                {
+                    ++completed;
+                });
+                engine.enqueue(requests[i]);
+            }
+            engine.submit();
+        }
+        EXPECT_EQ(completed, requests.size());
+        for(std::size_t i = 0; i < requests.size(); ++i)
+        {
+            EXPECT_FALSE(requests[i].is_pending());
+            EXPECT_EQ(buffers[i], data.substr(i * 1024, 1024));
+        }
+    }
+}
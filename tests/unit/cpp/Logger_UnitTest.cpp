@@ -0,0 +1,247 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <deus/UnicodeView.hpp>
+
+#include <arcanecore/base/io/MemorySink.hpp>
+#include <arcanecore/base/lang/Atom.hpp>
+#include <arcanecore/base/lang/SpscByteQueue.hpp>
+#include <arcanecore/base/log/Logger.hpp>
+
+
+//------------------------------------------------------------------------------
+//                                    FIXTURES
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+// returns the lines of the given text without their timestamps
+std::vector<std::string> get_messages(const std::string& text)
+{
+    std::vector<std::string> ret;
+    std::size_t start = 0;
+    while(start < text.size())
+    {
+        const std::size_t end = text.find('\n', start);
+        const std::string line = text.substr(start, end - start);
+        // timestamps are "YYYY/MM/DD - HH:MM:SS.mmm "
+        ret.push_back(line.substr(line.find(" [")  + 1));
+        start = end + 1;
+    }
+    return ret;
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                     TESTS
+//------------------------------------------------------------------------------
+
+TEST(SpscByteQueue, records)
+{
+    arc::lang::SpscByteQueue queue(64);
+    EXPECT_EQ(queue.capacity(), 64U);
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.try_reserve(queue.get_max_size() + 1), nullptr);
+
+    // wraps many times, with records of varying sizes
+    std::size_t written = 0;
+    std::size_t read = 0;
+    for(std::size_t i = 0; i < 1000; ++i)
+    {
+        const std::size_t size = 1 + i % 23;
+        char* out = queue.try_reserve(size);
+        if(out == nullptr)
+        {
+            queue.consume([&](const char* data, std::size_t record_size)
+            {
+                EXPECT_EQ(record_size % arc::lang::SpscByteQueue::ALIGNMENT, 0U);
+                EXPECT_EQ(static_cast<unsigned char>(data[0]), read % 256);
+                ++read;
+            });
+            out = queue.try_reserve(size);
+            ASSERT_NE(out, nullptr);
+        }
+        out[0] = static_cast<char>(written % 256);
+        queue.commit();
+        ++written;
+    }
+    queue.consume([&](const char*, std::size_t) { ++read; });
+    EXPECT_EQ(read, written);
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(Logger, messages)
+{
+    arc::io::MemorySink sink;
+    {
+        arc::log::Logger logger(sink);
+        std::string temporary = "temporary";
+        ARC_LOG_INFO(logger, "Hello {}!", "world");
+        ARC_LOG_WARNING(logger, "{} {:.2f} {:x} {}", 42, 3.14159, 255U, true);
+        ARC_LOG_ERROR(logger, "{:>5}|{}", 'c', -7LL);
+        ARC_LOG_DEBUG(
+            logger,
+            "{} {} {}",
+            temporary,
+            arc::lang::Atom("atom"),
+            deus::UnicodeView("view")
+        );
+        // strings are copied when logged
+        temporary = "changed";
+        ARC_LOG_INFO(logger, "no arguments");
+        logger.flush();
+
+        EXPECT_EQ(
+            get_messages(sink.to_string()),
+            std::vector<std::string>({
+                "[INFO] Hello world!",
+                "[WARNING] 42 3.14 ff true",
+                "[ERROR]     c|-7",
+                "[DEBUG] temporary atom view",
+                "[INFO] no arguments"
+            })
+        );
+
+        // the timestamp has the default layout plus milliseconds
+        const std::string line = sink.to_string();
+        ASSERT_GT(line.size(), 24U);
+        EXPECT_EQ(line[4], '/');
+        EXPECT_EQ(line.substr(10, 3), " - ");
+        EXPECT_EQ(line[21], '.');
+        EXPECT_EQ(line[25], ' ');
+    }
+}
+
+TEST(Logger, level)
+{
+    arc::io::MemorySink sink;
+    arc::log::Logger logger(sink);
+    logger.set_level(arc::log::Level::kWarning);
+    EXPECT_EQ(logger.get_level(), arc::log::Level::kWarning);
+    EXPECT_FALSE(logger.is_enabled(arc::log::Level::kInfo));
+
+    int evaluated = 0;
+    ARC_LOG_INFO(logger, "{}", ++evaluated);
+    ARC_LOG_ERROR(logger, "{}", ++evaluated);
+    logger.flush();
+    EXPECT_EQ(evaluated, 1);
+    EXPECT_EQ(
+        get_messages(sink.to_string()),
+        std::vector<std::string>({"[ERROR] 1"})
+    );
+}
+
+TEST(Logger, full_policies)
+{
+    const arc::log::FullPolicy policies[] = {
+        arc::log::FullPolicy::kBlock,
+        arc::log::FullPolicy::kDrop,
+        arc::log::FullPolicy::kGrow
+    };
+    const std::string large(1000, 'x');
+    for(arc::log::FullPolicy policy : policies)
+    {
+        const std::size_t count = 2000;
+        arc::io::MemorySink sink;
+        std::size_t dropped = 0;
+        {
+            arc::log::Logger logger(sink, policy, 256);
+            EXPECT_EQ(logger.get_full_policy(), policy);
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                ARC_LOG_INFO(logger, "{}", i);
+            }
+            // too large for the queue
+            ARC_LOG_INFO(logger, "{}", large);
+            logger.flush();
+            dropped = logger.get_dropped_count();
+        }
+
+        std::vector<std::string> messages = get_messages(sink.to_string());
+        std::size_t logged = 0;
+        std::size_t previous = 0;
+        bool large_logged = false;
+        for(const std::string& message : messages)
+        {
+            if(message.find("[WARNING] Dropped ") == 0)
+            {
+                continue;
+            }
+            if(message == "[INFO] " + large)
+            {
+                large_logged = true;
+                continue;
+            }
+            // the messages of a thread stay in order
+            const std::size_t i = std::stoul(message.substr(7));
+            EXPECT_TRUE(logged == 0 || i > previous);
+            previous = i;
+            ++logged;
+        }
+
+        if(policy == arc::log::FullPolicy::kDrop)
+        {
+            EXPECT_EQ(logged + dropped, count + 1);
+            EXPECT_FALSE(large_logged);
+        }
+        else if(policy == arc::log::FullPolicy::kBlock)
+        {
+            EXPECT_EQ(logged, count);
+            EXPECT_EQ(dropped, 1U);
+            EXPECT_FALSE(large_logged);
+        }
+        else
+        {
+            EXPECT_EQ(logged, count);
+            EXPECT_EQ(dropped, 0U);
+            EXPECT_TRUE(large_logged);
+        }
+    }
+}
+
+TEST(Logger, threads)
+{
+    const std::size_t thread_count = 4;
+    const std::size_t count = 1000;
+    arc::io::MemorySink sink;
+    {
+        arc::log::Logger logger(sink, arc::log::FullPolicy::kBlock, 1024);
+        std::vector<std::thread> threads;
+        for(std::size_t t = 0; t < thread_count; ++t)
+        {
+            threads.emplace_back([&logger, t, count]()
+            {
+                for(std::size_t i = 0; i < count; ++i)
+                {
+                    ARC_LOG_INFO(logger, "{} {}", t, i);
+                }
+            });
+        }
+        for(std::thread& thread : threads)
+        {
+            thread.join();
+        }
+        // written when the logger is destroyed
+    }
+
+    std::map<std::size_t, std::size_t> next;
+    for(const std::string& message : get_messages(sink.to_string()))
+    {
+        const std::size_t space = message.find(' ', 7);
+        const std::size_t t = std::stoul(message.substr(7, space - 7));
+        const std::size_t i = std::stoul(message.substr(space + 1));
+        EXPECT_EQ(i, next[t]);
+        next[t] = i + 1;
+    }
+    for(std::size_t t = 0; t < thread_count; ++t)
+    {
+        EXPECT_EQ(next[t], count);
+    }
+}
@@ -0,0 +1,205 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <arcanecore/base/Exceptions.hpp>
+#include <arcanecore/base/io/MappedFile.hpp>
+#include <arcanecore/base/lang/Span.hpp>
+
+#include <unistd.h>
+
+
+//------------------------------------------------------------------------------
+//                                    FIXTURES
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+// a uniquely named file which is deleted at the end of the test
+class TemporaryPath
+{
+public:
+
+    TemporaryPath()
+        : m_path("/tmp/arc_mapped_file_XXXXXX")
+    {
+        ::close(::mkstemp(&m_path[0]));
+    }
+
+    ~TemporaryPath()
+    {
+        std::remove(m_path.c_str());
+    }
+
+    const char* get() const
+    {
+        return m_path.c_str();
+    }
+
+    void write(const std::string& data) const
+    {
+        std::FILE* file = std::fopen(m_path.c_str(), "wb");
+        std::fwrite(data.data(), 1, data.size(), file);
+        std::fclose(file);
+    }
+
+    std::string read() const
+    {
+        std::string ret;
+        std::FILE* file = std::fopen(m_path.c_str(), "rb");
+        char buffer[4096];
+        std::size_t count = 0;
+        while((count = std::fread(buffer, 1, sizeof(buffer), file)) > 0)
+        {
+            ret.append(buffer, count);
+        }
+        std::fclose(file);
+        return ret;
+    }
+
+private:
+
+    std::string m_path;
+};
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                     TESTS
+//------------------------------------------------------------------------------
+
+TEST(Span, views)
+{
+    int values[] = {1, 2, 3, 4, 5};
+    arc::lang::Span<int> span(values);
+    EXPECT_EQ(span.size(), 5U);
+    EXPECT_EQ(span.size_bytes(), sizeof(values));
+    EXPECT_EQ(span.front(), 1);
+    EXPECT_EQ(span.back(), 5);
+
+    arc::lang::Span<const int> middle = span.subspan(1, 3);
+    EXPECT_EQ(middle.size(), 3U);
+    EXPECT_EQ(middle[0], 2);
+    EXPECT_EQ(span.subspan(3).size(), 2U);
+    EXPECT_EQ(span.subspan(5).size(), 0U);
+    EXPECT_THROW(span.subspan(6), arc::ex::ValueError);
+    EXPECT_EQ(span.first(2).back(), 2);
+    EXPECT_EQ(span.last(2).front(), 4);
+
+    int sum = 0;
+    for(int value : middle)
+    {
+        sum += value;
+    }
+    EXPECT_EQ(sum, 9);
+    EXPECT_TRUE(arc::lang::Span<int>().empty());
+}
+
+TEST(MappedFile, read_only)
+{
+    TemporaryPath path;
+    std::string data;
+    for(std::size_t i = 0; i < 10000; ++i)
+    {
+        data += static_cast<char>('a' + i % 26);
+    }
+    path.write(data);
+
+    for(int populate = 0; populate < 2; ++populate)
+    {
+        arc::io::MappedFile file(
+            path.get(),
+            arc::io::MapMode::kReadOnly,
+            populate != 0
+        );
+        EXPECT_TRUE(file.is_open());
+        EXPECT_EQ(file.get_mode(), arc::io::MapMode::kReadOnly);
+        ASSERT_EQ(file.size(), data.size());
+        EXPECT_EQ(std::string(file.data(), file.size()), data);
+
+        arc::lang::Span<const char> view = file.view(26, 3);
+        EXPECT_EQ(std::string(view.data(), view.size()), "abc");
+        EXPECT_EQ(file.view(9990).size(), 10U);
+        EXPECT_THROW(file.view(10001), arc::ex::ValueError);
+
+        EXPECT_TRUE(file.advise(arc::io::MapAdvice::kSequential));
+        EXPECT_TRUE(file.advise(arc::io::MapAdvice::kRandom, 5000, 100));
+        EXPECT_TRUE(file.advise(arc::io::MapAdvice::kWillNeed));
+        // huge pages are only a hint, which may not be supported
+        file.advise(arc::io::MapAdvice::kHugePage);
+        EXPECT_TRUE(file.advise(arc::io::MapAdvice::kNormal));
+
+        EXPECT_THROW(file.mutable_view(), arc::ex::StateError);
+        EXPECT_THROW(file.resize(0), arc::ex::StateError);
+    }
+}
+
+TEST(MappedFile, read_write)
+{
+    TemporaryPath path;
+    path.write("hello");
+    {
+        arc::io::MappedFile file(path.get(), arc::io::MapMode::kReadWrite);
+        ASSERT_EQ(file.size(), 5U);
+
+        // growing within the reserved capacity doesn't move the mapping
+        file.reserve(1024 * 1024);
+        EXPECT_GE(file.get_capacity(), 1024U * 1024U);
+        const char* data = file.data();
+        file.resize(6000);
+        EXPECT_EQ(file.data(), data);
+        EXPECT_EQ(file.data()[5999], '\0');
+
+        arc::lang::Span<char> view = file.mutable_view(5995);
+        std::memcpy(view.data(), "world", 5);
+
+        // growing beyond it remaps
+        file.resize(4 * 1024 * 1024);
+        EXPECT_EQ(std::string(file.data() + 5995, 5), "world");
+        file.mutable_view()[4 * 1024 * 1024 - 1] = '!';
+        file.resize(6001);
+        file.sync();
+    }
+
+    const std::string data = path.read();
+    ASSERT_EQ(data.size(), 6001U);
+    EXPECT_EQ(data.substr(0, 5), "hello");
+    EXPECT_EQ(data.substr(5995, 5), "world");
+    EXPECT_EQ(data[6000], '\0');
+}
+
+TEST(MappedFile, empty)
+{
+    TemporaryPath path;
+
+    arc::io::MappedFile file;
+    EXPECT_FALSE(file.is_open());
+    file.open(path.get());
+    EXPECT_TRUE(file.is_open());
+    EXPECT_TRUE(file.empty());
+    EXPECT_EQ(file.data(), nullptr);
+    EXPECT_TRUE(file.view().empty());
+    EXPECT_FALSE(file.advise(arc::io::MapAdvice::kSequential));
+
+    // writers can start from an empty file
+    file.open(path.get(), arc::io::MapMode::kReadWrite);
+    file.resize(3);
+    std::memcpy(file.mutable_view().data(), "abc", 3);
+    file.close();
+    EXPECT_FALSE(file.is_open());
+    EXPECT_EQ(path.read(), "abc");
+}
+
+TEST(MappedFile, errors)
+{
+    arc::io::MappedFile file;
+    EXPECT_TRUE(file.try_open("/tmp/arc_mapped_file_missing").is_error());
+    EXPECT_FALSE(file.is_open());
+    EXPECT_THROW(file.open("/tmp"), arc::ex::RuntimeError);
+    EXPECT_TRUE(file.try_resize(1).is_error());
+}
@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <arcanecore/base/Exceptions.hpp>
+#include <arcanecore/base/lang/ObjectPool.hpp>
+
+
+//------------------------------------------------------------------------------
+//                                    FIXTURES
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+struct Message
+{
+    std::uint64_t id;
+    double payload[3];
+
+    Message(std::uint64_t id_)
+        : id(id_)
+    {
+    }
+};
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                     TESTS
+//------------------------------------------------------------------------------
+
+TEST(ObjectPool, reuse)
+{
+    arc::lang::ObjectPool<Message> pool(4);
+    EXPECT_EQ(pool.get_capacity(), 0U);
+
+    std::set<Message*> messages;
+    for(std::uint64_t i = 0; i < 100; ++i)
+    {
+        Message* message = pool.create(i);
+        EXPECT_EQ(message->id, i);
+        EXPECT_EQ(
+            reinterpret_cast<std::uintptr_t>(message) % alignof(Message),
+            0U
+        );
+        EXPECT_TRUE(messages.insert(message).second);
+    }
+    const std::size_t capacity = pool.get_capacity();
+    EXPECT_GE(capacity, 100U);
+
+    for(Message* message : messages)
+    {
+        pool.destroy(message);
+    }
+
+    // freed memory is reused rather than the pool growing
+    for(std::uint64_t i = 0; i < 100; ++i)
+    {
+        EXPECT_EQ(messages.count(pool.create(i)), 1U);
+    }
+    EXPECT_EQ(pool.get_capacity(), capacity);
+}
+
+TEST(ObjectPool, threads)
+{
+    static const std::size_t THREAD_COUNT = 4;
+    static const std::size_t OBJECT_COUNT = 2000;
+
+    arc::lang::ObjectPool<Message> pool;
+    std::vector<std::vector<Message*>> created(THREAD_COUNT);
+
+    // objects are created on one thread and destroyed on another
+    for(int round = 0; round < 3; ++round)
+    {
+        std::vector<std::thread> threads;
+        for(std::size_t t = 0; t < THREAD_COUNT; ++t)
+        {
+            threads.emplace_back([&, t]()
+            {
+                std::vector<Message*>& previous =
+                    created[(t + 1) % THREAD_COUNT];
+                for(Message* message : previous)
+                {
+                    pool.destroy(message);
+                }
+                previous.clear();
+            });
+        }
+        for(std::thread& thread : threads)
+        {
+            thread.join();
+        }
+        threads.clear();
+
+        for(std::size_t t = 0; t < THREAD_COUNT; ++t)
+        {
+            threads.emplace_back([&, t]()
+            {
+                for(std::size_t i = 0; i < OBJECT_COUNT; ++i)
+                {
+                    created[t].push_back(pool.create(t * OBJECT_COUNT + i));
+                }
+            });
+        }
+        for(std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        std::set<Message*> unique;
+        for(std::size_t t = 0; t < THREAD_COUNT; ++t)
+        {
+            for(std::size_t i = 0; i < OBJECT_COUNT; ++i)
+            {
+                EXPECT_EQ(created[t][i]->id, t * OBJECT_COUNT + i);
+                EXPECT_TRUE(unique.insert(created[t][i]).second);
+            }
+        }
+    }
+    EXPECT_LE(pool.get_capacity(), 4 * THREAD_COUNT * OBJECT_COUNT);
+}
+
+#ifndef NDEBUG
+
+TEST(ObjectPool, poison)
+{
+    arc::lang::ObjectPool<Message> pool;
+    Message* message = pool.create(1);
+    pool.destroy(message);
+
+    // write to the message after it has been freed
+    *reinterpret_cast<volatile unsigned char*>(message) = 0;
+    EXPECT_THROW(pool.create(2), arc::ex::StateError);
+}
+
+#endif
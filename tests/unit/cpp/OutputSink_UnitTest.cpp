@@ -0,0 +1,207 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arcanecore/base/io/FileDescriptorSink.hpp>
+#include <arcanecore/base/io/MemorySink.hpp>
+
+#ifdef _WIN32
+    #include <io.h>
+    #define dup2 _dup2
+    #define fileno _fileno
+#else
+    #include <unistd.h>
+#endif
+
+
+//------------------------------------------------------------------------------
+//                                    FIXTURES
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+// a temporary file that sinks can write to through its file descriptor
+class TemporaryFile
+{
+public:
+
+    TemporaryFile()
+        : m_file(std::tmpfile())
+    {
+    }
+
+    ~TemporaryFile()
+    {
+        std::fclose(m_file);
+    }
+
+    int get_fd() const
+    {
+        return fileno(m_file);
+    }
+
+    // returns everything that has been written to the file
+    std::string read() const
+    {
+        std::rewind(m_file);
+        std::string ret;
+        char buffer[4096];
+        std::size_t count = 0;
+        while((count = std::fread(buffer, 1, sizeof(buffer), m_file)) > 0)
+        {
+            ret.append(buffer, count);
+        }
+        return ret;
+    }
+
+private:
+
+    std::FILE* m_file;
+};
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                     TESTS
+//------------------------------------------------------------------------------
+
+TEST(MemorySink, write)
+{
+    arc::io::MemorySink sink;
+    sink.write("Hello");
+    sink.write(std::string(", "));
+    arc::lang::StringBuilder builder;
+    builder << "world" << '!';
+    sink.write(builder);
+    const arc::io::Slice slices[] = {{"\n", 1}, {"abc", 2}};
+    sink.write_slices(slices, 2);
+    sink.flush();
+    EXPECT_EQ(sink.to_string(), "Hello, world!\nab");
+    EXPECT_EQ(sink.size(), 16U);
+
+    sink.clear();
+    EXPECT_EQ(sink.size(), 0U);
+}
+
+TEST(FileDescriptorSink, buffering)
+{
+    TemporaryFile file;
+    {
+        arc::io::FileDescriptorSink sink(file.get_fd(), 16);
+        EXPECT_EQ(sink.get_fd(), file.get_fd());
+
+        // small writes are held until the buffer fills or is flushed
+        sink.write("0123456789");
+        EXPECT_EQ(file.read(), "");
+        sink.flush();
+        EXPECT_EQ(file.read(), "0123456789");
+
+        sink.write("abcdef");
+        sink.write("ghijklmnopqrstuvwxyz");
+        EXPECT_EQ(file.read(), "0123456789abcdefghijklmnopqrstuvwxyz");
+
+        // larger than the buffer
+        const std::string large(100000, 'x');
+        const arc::io::Slice slices[] = {
+            {"[", 1},
+            {large.data(), large.size()},
+            {"", 0},
+            {"]", 1}
+        };
+        sink.write("<");
+        sink.write_slices(slices, 4);
+        EXPECT_EQ(
+            file.read(),
+            "0123456789abcdefghijklmnopqrstuvwxyz<[" + large + "]"
+        );
+
+        // flushed by the destructor
+        sink.write(">");
+        EXPECT_FALSE(sink.has_failed());
+    }
+    EXPECT_EQ(file.read().back(), '>');
+}
+
+TEST(FileDescriptorSink, unbuffered)
+{
+    TemporaryFile file;
+    arc::io::FileDescriptorSink sink(file.get_fd(), 0);
+    sink.write("abc");
+    EXPECT_EQ(file.read(), "abc");
+}
+
+TEST(FileDescriptorSink, flush_standard_stream)
+{
+    // the standard output is redirected, so this is done in a child process
+    EXPECT_EXIT(
+        {
+            TemporaryFile file;
+            std::cout.flush();
+            dup2(file.get_fd(), 1);
+            arc::io::FileDescriptorSink sink(1, 0);
+
+            // output held by std::cout is written before the sink's
+            std::cout << "first ";
+            arc::io::FileDescriptorSink::flush_standard_stream(sink);
+            sink.write("second");
+            std::exit(file.read() == "first second" ? 0 : 1);
+        },
+        ::testing::ExitedWithCode(0),
+        ""
+    );
+}
+
+TEST(FileDescriptorSink, concurrent_writes)
+{
+    // the bytes of a single write are never interleaved with another
+    TemporaryFile file;
+    const std::size_t thread_count = 4;
+    const std::size_t line_count = 1000;
+    {
+        arc::io::FileDescriptorSink sink(file.get_fd(), 64);
+        std::vector<std::thread> threads;
+        for(std::size_t i = 0; i < thread_count; ++i)
+        {
+            threads.emplace_back([&sink, i, line_count]()
+            {
+                const std::string line(10 + i * 20, static_cast<char>('a' + i));
+                for(std::size_t j = 0; j < line_count; ++j)
+                {
+                    const arc::io::Slice slices[] = {
+                        {line.data(), line.size()},
+                        {"\n", 1}
+                    };
+                    sink.write_slices(slices, 2);
+                }
+            });
+        }
+        for(std::thread& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    const std::string contents = file.read();
+    std::size_t lines = 0;
+    std::size_t start = 0;
+    while(start < contents.size())
+    {
+        const std::size_t end = contents.find('\n', start);
+        ASSERT_NE(end, std::string::npos);
+        const std::size_t i = static_cast<std::size_t>(contents[start] - 'a');
+        ASSERT_LT(i, thread_count);
+        EXPECT_EQ(
+            contents.substr(start, end - start),
+            std::string(10 + i * 20, contents[start])
+        );
+        ++lines;
+        start = end + 1;
+    }
+    EXPECT_EQ(lines, thread_count * line_count);
+}
@@ -0,0 +1,363 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <arcanecore/base/clock/ClockDefinitions.hpp>
+#include <arcanecore/base/parallel/ForEach.hpp>
+#include <arcanecore/base/parallel/Reduce.hpp>
+#include <arcanecore/base/parallel/Scan.hpp>
+#include <arcanecore/base/parallel/Sort.hpp>
+
+#ifdef __linux__
+    #include <dirent.h>
+#endif
+
+
+//------------------------------------------------------------------------------
+//                                    FIXTURES
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+static const std::size_t COUNT = 300000;
+
+// runs the given test on the default scheduler, and from within a task of a
+// scheduler with several workers
+template<typename Function>
+void run_test(Function function)
+{
+    function();
+
+    arc::task::Scheduler scheduler(4);
+    arc::task::TaskGroup group(scheduler);
+    group.spawn(function);
+    group.wait();
+}
+
+template<typename T>
+std::vector<T> random_values(std::size_t count, T min, T max)
+{
+    std::mt19937_64 engine(count);
+    std::uniform_int_distribution<T> distribution(min, max);
+    std::vector<T> values(count);
+    for(T& value : values)
+    {
+        value = distribution(engine);
+    }
+    return values;
+}
+
+struct Record
+{
+    arc::clock::TimeInt timestamp;
+    std::size_t index;
+};
+
+#ifdef __linux__
+
+// returns the number of threads of this process
+std::size_t get_thread_count()
+{
+    std::size_t count = 0;
+    DIR* directory = opendir("/proc/self/task");
+    if(directory == nullptr)
+    {
+        return 0;
+    }
+    while(readdir(directory) != nullptr)
+    {
+        ++count;
+    }
+    closedir(directory);
+    // not counting . and ..
+    return count - 2;
+}
+
+// runs each algorithm on a small range, returning whether the results are
+// correct and no threads were created
+bool run_small_ranges()
+{
+    const std::size_t threads = get_thread_count();
+    std::vector<std::int32_t> values = {5, -3, 0, 2};
+    arc::parallel::sort(values.begin(), values.end());
+    arc::parallel::sort(
+        values.begin(),
+        values.end(),
+        std::greater<std::int32_t>()
+    );
+    arc::parallel::for_each(
+        values.begin(),
+        values.end(),
+        [](std::int32_t& value) { value *= 2; }
+    );
+    arc::parallel::inclusive_scan(values.begin(), values.end(), values.begin());
+    const std::int32_t sum =
+        arc::parallel::reduce(values.begin(), values.end(), 0);
+    return threads != 0 &&
+           get_thread_count() == threads &&
+           values == std::vector<std::int32_t>({10, 14, 14, 8}) &&
+           sum == 46;
+}
+
+#endif
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                     TESTS
+//------------------------------------------------------------------------------
+
+TEST(Parallel, for_each)
+{
+    run_test([]()
+    {
+        std::vector<std::uint32_t> values(COUNT, 1);
+        arc::parallel::for_each(
+            values.begin(),
+            values.end(),
+            [](std::uint32_t& value) { value *= 3; }
+        );
+        EXPECT_EQ(std::count(values.begin(), values.end(), 3U), COUNT);
+
+        // small explicit grain
+        arc::parallel::for_each(
+            values.begin(),
+            values.begin() + 1000,
+            [](std::uint32_t& value) { ++value; },
+            7
+        );
+        EXPECT_EQ(std::count(values.begin(), values.end(), 4U), 1000);
+    });
+}
+
+TEST(Parallel, transform)
+{
+    run_test([]()
+    {
+        std::vector<std::uint32_t> a(COUNT);
+        std::iota(a.begin(), a.end(), 0);
+        std::vector<std::uint64_t> b(COUNT);
+        EXPECT_TRUE(
+            arc::parallel::transform(
+                a.begin(),
+                a.end(),
+                b.begin(),
+                [](std::uint32_t x) { return std::uint64_t(x) * x; }
+            ) == b.end()
+        );
+        EXPECT_EQ(b[1234], 1234U * 1234U);
+
+        arc::parallel::transform(
+            a.begin(),
+            a.end(),
+            b.begin(),
+            b.begin(),
+            [](std::uint32_t x, std::uint64_t y) { return x + y; }
+        );
+        EXPECT_EQ(b[COUNT - 1], (COUNT - 1) * COUNT);
+    });
+}
+
+TEST(Parallel, reduce)
+{
+    run_test([]()
+    {
+        std::vector<std::uint64_t> values(COUNT);
+        std::iota(values.begin(), values.end(), 1);
+        EXPECT_EQ(
+            arc::parallel::reduce(
+                values.begin(),
+                values.end(),
+                std::uint64_t(0)
+            ),
+            COUNT * (COUNT + 1) / 2
+        );
+        EXPECT_EQ(
+            arc::parallel::reduce(values.begin(), values.begin(), 7U),
+            7U
+        );
+
+        // the operation does not need to be commutative
+        std::vector<std::string> digits(COUNT / 10);
+        for(std::size_t i = 0; i < digits.size(); ++i)
+        {
+            digits[i] = std::to_string(i % 10);
+        }
+        const std::string expected = std::accumulate(
+            digits.begin(),
+            digits.end(),
+            std::string("x")
+        );
+        EXPECT_EQ(
+            arc::parallel::reduce(
+                digits.begin(),
+                digits.end(),
+                std::string("x")
+            ),
+            expected
+        );
+
+        EXPECT_EQ(
+            arc::parallel::transform_reduce(
+                values.begin(),
+                values.end(),
+                std::uint64_t(0),
+                std::plus<std::uint64_t>(),
+                [](std::uint64_t x) { return x % 3; }
+            ),
+            COUNT
+        );
+    });
+}
+
+TEST(Parallel, scan)
+{
+    run_test([]()
+    {
+        std::vector<std::uint64_t> values =
+            random_values<std::uint64_t>(COUNT, 0, 1000);
+
+        std::vector<std::uint64_t> expected(COUNT);
+        std::partial_sum(values.begin(), values.end(), expected.begin());
+        std::vector<std::uint64_t> out(COUNT);
+        arc::parallel::inclusive_scan(
+            values.begin(),
+            values.end(),
+            out.begin()
+        );
+        EXPECT_EQ(out, expected);
+
+        // exclusive and in place
+        expected.insert(expected.begin(), 0);
+        expected.pop_back();
+        for(std::uint64_t& value : expected)
+        {
+            value += 5;
+        }
+        arc::parallel::exclusive_scan(
+            values.begin(),
+            values.end(),
+            values.begin(),
+            std::uint64_t(5)
+        );
+        EXPECT_EQ(values, expected);
+    });
+}
+
+TEST(Parallel, sort_integers)
+{
+    run_test([]()
+    {
+        std::vector<std::uint32_t> u32 =
+            random_values<std::uint32_t>(COUNT, 0, 0xFFFFFFFF);
+        arc::parallel::sort(u32.begin(), u32.end());
+        EXPECT_TRUE(std::is_sorted(u32.begin(), u32.end()));
+
+        std::vector<std::int64_t> i64 =
+            random_values<std::int64_t>(COUNT, -1000000000000, 1000000000000);
+        std::vector<std::int64_t> expected = i64;
+        std::sort(expected.begin(), expected.end());
+        arc::parallel::sort(i64.begin(), i64.end());
+        EXPECT_EQ(i64, expected);
+
+        // small keys skip most passes
+        std::vector<std::uint64_t> small =
+            random_values<std::uint64_t>(COUNT, 0, 255);
+        arc::parallel::sort(small.begin(), small.end());
+        EXPECT_TRUE(std::is_sorted(small.begin(), small.end()));
+
+        std::vector<std::int8_t> tiny = {5, -3, 0, -128, 127, 2};
+        arc::parallel::sort(tiny.begin(), tiny.end());
+        EXPECT_EQ(tiny, std::vector<std::int8_t>({-128, -3, 0, 2, 5, 127}));
+    });
+}
+
+TEST(Parallel, radix_sort_by_key)
+{
+    run_test([]()
+    {
+        std::vector<arc::clock::TimeInt> timestamps =
+            random_values<arc::clock::TimeInt>(COUNT, 0, 1000);
+        std::vector<Record> records(COUNT);
+        for(std::size_t i = 0; i < COUNT; ++i)
+        {
+            records[i].timestamp = timestamps[i];
+            records[i].index = i;
+        }
+        arc::parallel::radix_sort(
+            records.begin(),
+            records.end(),
+            [](const Record& record) { return record.timestamp; }
+        );
+
+        // the sort is stable
+        for(std::size_t i = 1; i < COUNT; ++i)
+        {
+            ASSERT_LE(records[i - 1].timestamp, records[i].timestamp);
+            if(records[i - 1].timestamp == records[i].timestamp)
+            {
+                ASSERT_LT(records[i - 1].index, records[i].index);
+            }
+        }
+    });
+}
+
+TEST(Parallel, merge_sort)
+{
+    run_test([]()
+    {
+        std::vector<std::uint32_t> ints =
+            random_values<std::uint32_t>(COUNT, 0, 100000);
+        std::vector<double> doubles(ints.begin(), ints.end());
+        arc::parallel::sort(doubles.begin(), doubles.end());
+        EXPECT_TRUE(std::is_sorted(doubles.begin(), doubles.end()));
+
+        std::vector<std::string> strings(COUNT / 4);
+        for(std::size_t i = 0; i < strings.size(); ++i)
+        {
+            strings[i] = std::to_string(ints[i]);
+        }
+        std::vector<std::string> expected = strings;
+        std::sort(
+            expected.begin(),
+            expected.end(),
+            std::greater<std::string>()
+        );
+        arc::parallel::sort(
+            strings.begin(),
+            strings.end(),
+            std::greater<std::string>()
+        );
+        EXPECT_EQ(strings, expected);
+
+        std::vector<double> empty;
+        arc::parallel::sort(empty.begin(), empty.end());
+        EXPECT_TRUE(empty.empty());
+    });
+}
+
+#ifdef __linux__
+
+TEST(Parallel, small_ranges_are_serial)
+{
+    // the test is executed in a new process so that the default scheduler
+    // hasn't been created by other tests
+    const std::string style = ::testing::FLAGS_gtest_death_test_style;
+    ::testing::FLAGS_gtest_death_test_style = "threadsafe";
+    EXPECT_EXIT(
+        std::exit(run_small_ranges() ? 0 : 1),
+        ::testing::ExitedWithCode(0),
+        ""
+    );
+    ::testing::FLAGS_gtest_death_test_style = style;
+}
+
+#endif
@@ -0,0 +1,429 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <arcanecore/base/Exceptions.hpp>
+#include <arcanecore/base/arg/Action.hpp>
+#include <arcanecore/base/arg/DefaultHelpFlag.hpp>
+#include <arcanecore/base/arg/Flag.hpp>
+#include <arcanecore/base/arg/KeyTrie.hpp>
+#include <arcanecore/base/arg/Parser.hpp>
+#include <arcanecore/base/io/MemorySink.hpp>
+#include <arcanecore/base/lang/Atom.hpp>
+
+
+//------------------------------------------------------------------------------
+//                                    FIXTURES
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+// records the order flags are executed in
+class RecordingFlag
+    : public arc::arg::Flag
+{
+public:
+
+    RecordingFlag(
+            const deus::UnicodeView& long_key,
+            std::vector<int>& record,
+            std::mutex& mutex,
+            int id,
+            bool succeed = true)
+        : arc::arg::Flag(long_key, "", "")
+        , m_record      (record)
+        , m_mutex       (mutex)
+        , m_id          (id)
+        , m_succeed     (succeed)
+    {
+    }
+
+    virtual bool execute(int& out_exit_code) override
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_record.push_back(m_id);
+        out_exit_code = m_id;
+        return m_succeed;
+    }
+
+private:
+
+    std::vector<int>& m_record;
+    std::mutex& m_mutex;
+    int m_id;
+    bool m_succeed;
+};
+
+// records whether it was executed
+class RecordingAction
+    : public arc::arg::Action
+{
+public:
+
+    RecordingAction(const deus::UnicodeView& key, bool& executed)
+        : arc::arg::Action(key, "")
+        , m_executed      (executed)
+    {
+    }
+
+    virtual bool execute(int& out_exit_code) override
+    {
+        m_executed = true;
+        out_exit_code = 0;
+        return true;
+    }
+
+private:
+
+    bool& m_executed;
+};
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                     TESTS
+//------------------------------------------------------------------------------
+
+TEST(Parser, flags_serial_order)
+{
+    std::vector<int> record;
+    std::mutex mutex;
+
+    arc::arg::Parser parser;
+    parser.add_flag(new RecordingFlag("a", record, mutex, 1));
+    parser.add_flag(new RecordingFlag("b", record, mutex, 2));
+
+    char arg0[] = "app";
+    char arg1[] = "--b";
+    char arg2[] = "--a";
+    char* argv[] = {arg0, arg1, arg2};
+    EXPECT_EQ(parser.execute(3, argv), 0);
+    EXPECT_EQ(record, std::vector<int>({2, 1}));
+}
+
+TEST(Parser, flags_dependencies)
+{
+    std::vector<int> record;
+    std::mutex mutex;
+
+    RecordingFlag* a = new RecordingFlag("a", record, mutex, 1);
+    RecordingFlag* b = new RecordingFlag("b", record, mutex, 2);
+    RecordingFlag* c = new RecordingFlag("c", record, mutex, 3);
+    a->set_concurrent(true);
+    b->set_concurrent(true);
+    c->set_concurrent(true);
+    a->add_dependency("c");
+    b->add_dependency("--a");
+
+    arc::arg::Parser parser;
+    parser.set_max_threads(4);
+    parser.add_flag(a);
+    parser.add_flag(b);
+    parser.add_flag(c);
+
+    char arg0[] = "app";
+    char arg1[] = "--b";
+    char arg2[] = "--a";
+    char arg3[] = "--c";
+    char* argv[] = {arg0, arg1, arg2, arg3};
+    EXPECT_EQ(parser.execute(4, argv), 0);
+    EXPECT_EQ(record, std::vector<int>({3, 1, 2}));
+}
+
+TEST(Parser, flags_dependency_on_later_flag)
+{
+    // the serial path, and the threaded path (as a flag is concurrent)
+    for(std::size_t threads = 1; threads <= 4; threads += 3)
+    {
+        std::vector<int> record;
+        std::mutex mutex;
+
+        // a declared dependency on a flag supplied later takes precedence
+        // over the command line order of flags that are not concurrent
+        RecordingFlag* a = new RecordingFlag("a", record, mutex, 1);
+        RecordingFlag* b = new RecordingFlag("b", record, mutex, 2);
+        RecordingFlag* c = new RecordingFlag("c", record, mutex, 3);
+        RecordingFlag* d = new RecordingFlag("d", record, mutex, 4);
+        a->add_dependency("b");
+        d->set_concurrent(true);
+
+        arc::arg::Parser parser;
+        parser.set_max_threads(threads);
+        parser.add_flag(a);
+        parser.add_flag(b);
+        parser.add_flag(c);
+        parser.add_flag(d);
+
+        char arg0[] = "app";
+        char arg1[] = "--a";
+        char arg2[] = "--c";
+        char arg3[] = "--b";
+        char arg4[] = "--d";
+        char* argv[] = {arg0, arg1, arg2, arg3, arg4};
+        EXPECT_EQ(parser.execute(5, argv), 0);
+
+        // the concurrent flag may run at any point
+        ASSERT_EQ(record.size(), 4U);
+        record.erase(
+            std::remove(record.begin(), record.end(), 4),
+            record.end()
+        );
+        EXPECT_EQ(record, std::vector<int>({3, 2, 1})) << threads;
+    }
+}
+
+TEST(Parser, flags_concurrent_failure)
+{
+    for(std::size_t threads = 1; threads <= 4; ++threads)
+    {
+        std::vector<int> record;
+        std::mutex mutex;
+
+        arc::arg::Parser parser;
+        parser.set_max_threads(threads);
+        for(int i = 0; i < 8; ++i)
+        {
+            std::string key = "flag" + std::to_string(i);
+            RecordingFlag* flag =
+                new RecordingFlag(key.c_str(), record, mutex, 10 + i, i < 3);
+            flag->set_concurrent(true);
+            parser.add_flag(flag);
+        }
+
+        std::vector<std::string> args = {"app"};
+        for(int i = 7; i >= 0; --i)
+        {
+            args.push_back("--flag" + std::to_string(i));
+        }
+        std::vector<char*> argv;
+        for(std::string& arg : args)
+        {
+            argv.push_back(&arg[0]);
+        }
+
+        // --flag7 is the first to fail in command line order
+        EXPECT_EQ(parser.execute(static_cast<int>(argv.size()), &argv[0]), 17);
+    }
+}
+
+TEST(Parser, flags_dependency_cycle)
+{
+    std::vector<int> record;
+    std::mutex mutex;
+
+    RecordingFlag* a = new RecordingFlag("a", record, mutex, 1);
+    RecordingFlag* b = new RecordingFlag("b", record, mutex, 2);
+    a->add_dependency("b");
+    b->add_dependency("a");
+
+    arc::arg::Parser parser;
+    parser.add_flag(a);
+    parser.add_flag(b);
+
+    char arg0[] = "app";
+    char arg1[] = "--a";
+    char arg2[] = "--b";
+    char* argv[] = {arg0, arg1, arg2};
+    EXPECT_THROW(parser.execute(3, argv), arc::ex::StateError);
+    EXPECT_TRUE(record.empty());
+}
+
+TEST(Parser, abbreviated_keys)
+{
+    std::vector<int> record;
+    std::mutex mutex;
+
+    arc::arg::Parser parser;
+    parser.add_flag(new RecordingFlag("verbose", record, mutex, 1));
+    parser.add_flag(new RecordingFlag("version", record, mutex, 2));
+    parser.add_flag(new RecordingFlag("output", record, mutex, 3));
+
+    char arg0[] = "app";
+    char arg1[] = "--verb";
+    char arg2[] = "--o";
+    char* argv[] = {arg0, arg1, arg2};
+    EXPECT_EQ(parser.execute(3, argv), 0);
+    EXPECT_EQ(record, std::vector<int>({1, 3}));
+}
+
+TEST(Parser, ambiguous_keys)
+{
+    std::vector<int> record;
+    std::mutex mutex;
+
+    arc::io::MemorySink output;
+    arc::io::MemorySink error_output;
+    arc::arg::Parser parser(5);
+    parser.set_output(output);
+    parser.set_error_output(error_output);
+    parser.add_flag(new RecordingFlag("verbose", record, mutex, 1));
+    parser.add_flag(new RecordingFlag("version", record, mutex, 2));
+
+    char arg0[] = "app";
+    char arg1[] = "--ver";
+    char* argv[] = {arg0, arg1};
+    EXPECT_EQ(parser.execute(2, argv), 5);
+    EXPECT_TRUE(record.empty());
+    EXPECT_EQ(output.size(), 0U);
+    EXPECT_EQ(
+        error_output.to_string(),
+        "Ambiguous command line argument: '--ver' could be: '--verbose', "
+        "'--version'.\nUse '--help' or '-h' for program help.\n"
+    );
+}
+
+TEST(Parser, empty_argument)
+{
+    bool executed = false;
+    arc::io::MemorySink error_output;
+    arc::arg::Parser parser;
+    parser.set_error_output(error_output);
+    parser.add_action(new RecordingAction("build", executed));
+
+    // an empty argument isn't an abbreviation of the only action
+    char arg0[] = "app";
+    char arg1[] = "";
+    char* argv[] = {arg0, arg1};
+    EXPECT_NE(parser.execute(2, argv), 0);
+    EXPECT_FALSE(executed);
+    EXPECT_NE(
+        error_output.to_string().find("Unrecognised command line argument"),
+        std::string::npos
+    );
+}
+
+TEST(Parser, duplicate_keys)
+{
+    std::vector<int> record;
+    std::mutex mutex;
+
+    arc::arg::Parser parser;
+    parser.add_flag(new RecordingFlag("verbose", record, mutex, 1));
+    const std::size_t revision = parser.get_revision();
+
+    // the parser doesn't take ownership of a flag it rejects
+    std::unique_ptr<RecordingFlag> duplicate(
+        new RecordingFlag("verbose", record, mutex, 2)
+    );
+    EXPECT_THROW(parser.add_flag(duplicate.get()), arc::ex::ValueError);
+    EXPECT_EQ(parser.get_flags().size(), 1U);
+    EXPECT_EQ(parser.get_revision(), revision);
+
+    // the non-throwing variant reports the duplicate as an error
+    const arc::Result<void> result = parser.try_add_flag(duplicate.get());
+    ASSERT_TRUE(result.is_error());
+    EXPECT_EQ(
+        result.get_error().get_code(),
+        arc::ex::ErrorCode::kValueError
+    );
+    EXPECT_EQ(parser.get_flags().size(), 1U);
+    EXPECT_EQ(parser.get_revision(), revision);
+
+    char arg0[] = "app";
+    char arg1[] = "--verbose";
+    char* argv[] = {arg0, arg1};
+    EXPECT_EQ(parser.execute(2, argv), 0);
+    EXPECT_EQ(record, std::vector<int>({1}));
+}
+
+TEST(Parser, frozen_atom_table)
+{
+    // freezing the global table can't be undone, so this is done in a child
+    // process
+    EXPECT_EXIT(
+        {
+            std::vector<int> record;
+            std::mutex mutex;
+            arc::arg::Parser parser;
+            arc::lang::AtomTable::get_global().freeze();
+            std::unique_ptr<RecordingFlag> flag(
+                new RecordingFlag("never-interned-key", record, mutex, 1)
+            );
+            bool thrown = false;
+            try
+            {
+                parser.add_flag(flag.get());
+            }
+            catch(const arc::ex::StateError&)
+            {
+                thrown = true;
+            }
+            // the non-throwing variant reports the frozen table as an error
+            bool reported = false;
+            try
+            {
+                const arc::Result<void> result = parser.try_add_flag(
+                    flag.get()
+                );
+                reported =
+                    result.is_error() &&
+                    result.get_error().get_code() ==
+                        arc::ex::ErrorCode::kStateError;
+            }
+            catch(...)
+            {
+            }
+            std::exit(
+                thrown && reported && parser.get_flags().empty() ? 0 : 1
+            );
+        },
+        ::testing::ExitedWithCode(0),
+        ""
+    );
+}
+
+TEST(Parser, output_sinks)
+{
+    arc::io::MemorySink output;
+    arc::io::MemorySink error_output;
+    arc::arg::Parser parser;
+    parser.set_output(output);
+    parser.set_error_output(error_output);
+    EXPECT_EQ(&parser.get_output(), &output);
+    EXPECT_EQ(&parser.get_error_output(), &error_output);
+    parser.add_flag(new arc::arg::DefaultHelpFlag("app [options]"));
+
+    char arg0[] = "app";
+    char arg1[] = "--help";
+    char* argv[] = {arg0, arg1};
+    EXPECT_EQ(parser.execute(2, argv), 0);
+    const std::string help = output.to_string();
+    EXPECT_NE(help.find("app [options]"), std::string::npos);
+    EXPECT_NE(help.find("--help"), std::string::npos);
+    EXPECT_EQ(error_output.size(), 0U);
+}
+
+TEST(KeyTrie, suggestions)
+{
+    arc::arg::KeyTrie<int> trie;
+    EXPECT_TRUE(trie.insert("--verbose", 9, 1));
+    EXPECT_TRUE(trie.insert("--version", 9, 2));
+    EXPECT_TRUE(trie.insert("--output", 8, 3));
+    EXPECT_FALSE(trie.insert("--output", 8, 4));
+
+    int value = 0;
+    EXPECT_EQ(trie.find("--out", 5, value), arc::arg::KeyMatch::kPrefix);
+    EXPECT_EQ(value, 3);
+    EXPECT_EQ(trie.find("--vers", 6, value), arc::arg::KeyMatch::kPrefix);
+    EXPECT_EQ(value, 2);
+    EXPECT_EQ(trie.find("--ver", 5, value), arc::arg::KeyMatch::kAmbiguous);
+    EXPECT_EQ(trie.find("--x", 3, value), arc::arg::KeyMatch::kNone);
+    EXPECT_EQ(trie.find("", 0, value), arc::arg::KeyMatch::kNone);
+    EXPECT_FALSE(trie.insert("", 0, 5));
+
+    EXPECT_EQ(
+        trie.get_suggestions("--versoin", 9, 2),
+        std::vector<std::string>({"--version"})
+    );
+    EXPECT_EQ(
+        trie.get_suggestions("--verbsoe", 9, 3),
+        std::vector<std::string>({"--verbose", "--version"})
+    );
+}
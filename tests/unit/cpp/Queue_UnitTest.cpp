@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <arcanecore/base/lang/MpmcQueue.hpp>
+#include <arcanecore/base/lang/SpscQueue.hpp>
+
+
+//------------------------------------------------------------------------------
+//                                    FIXTURES
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+static const std::uint64_t VALUE_COUNT = 200000;
+
+// pushes and pops VALUE_COUNT values per producer through a queue with the
+// given number of producers and consumers, checking every value is received
+template<typename Queue>
+void run_mpmc(std::size_t producers, std::size_t consumers, bool batch)
+{
+    Queue queue(64);
+    std::atomic<std::uint64_t> sum(0);
+    std::atomic<std::uint64_t> received(0);
+    const std::uint64_t total = VALUE_COUNT * producers;
+
+    std::vector<std::thread> threads;
+    for(std::size_t p = 0; p < producers; ++p)
+    {
+        threads.emplace_back([&, p]()
+        {
+            std::uint64_t values[16];
+            for(std::uint64_t i = 0; i < VALUE_COUNT; i += 16)
+            {
+                for(std::uint64_t j = 0; j < 16; ++j)
+                {
+                    values[j] = p * VALUE_COUNT + i + j + 1;
+                }
+                if(batch)
+                {
+                    queue.push_batch(values, 16);
+                }
+                else
+                {
+                    for(std::uint64_t value : values)
+                    {
+                        queue.push(value);
+                    }
+                }
+            }
+        });
+    }
+    for(std::size_t c = 0; c < consumers; ++c)
+    {
+        threads.emplace_back([&]()
+        {
+            std::uint64_t values[8];
+            while(received.load() < total)
+            {
+                const std::size_t count = queue.try_pop_batch(values, 8);
+                for(std::size_t i = 0; i < count; ++i)
+                {
+                    sum += values[i];
+                }
+                received += count;
+                if(count == 0)
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for(std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(received.load(), total);
+    EXPECT_EQ(sum.load(), total * (total + 1) / 2);
+    EXPECT_TRUE(queue.empty());
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                     TESTS
+//------------------------------------------------------------------------------
+
+TEST(SpscQueue, order)
+{
+    arc::lang::SpscQueue<std::uint64_t> queue(100);
+    EXPECT_EQ(queue.capacity(), 128U);
+
+    std::thread producer([&]()
+    {
+        std::uint64_t values[7];
+        for(std::uint64_t i = 0; i < VALUE_COUNT; i += 7)
+        {
+            const std::size_t count =
+                (VALUE_COUNT - i < 7) ? VALUE_COUNT - i : 7;
+            for(std::size_t j = 0; j < count; ++j)
+            {
+                values[j] = i + j;
+            }
+            queue.push_batch(values, count);
+        }
+    });
+
+    // alternate between single and batch pops
+    std::uint64_t expected = 0;
+    while(expected < VALUE_COUNT)
+    {
+        if(expected % 2 == 0)
+        {
+            std::uint64_t value = 0;
+            queue.pop(value);
+            ASSERT_EQ(value, expected++);
+        }
+        else
+        {
+            std::uint64_t values[5];
+            const std::size_t count = queue.pop_batch(values, 5);
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                ASSERT_EQ(values[i], expected++);
+            }
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(SpscQueue, full)
+{
+    arc::lang::SpscQueue<std::shared_ptr<int>> queue(4);
+    std::shared_ptr<int> value(new int(1));
+    for(int i = 0; i < 4; ++i)
+    {
+        EXPECT_TRUE(queue.try_push(value));
+    }
+    EXPECT_FALSE(queue.try_push(value));
+    EXPECT_EQ(value.use_count(), 5);
+
+    std::shared_ptr<int> out;
+    EXPECT_TRUE(queue.try_pop(out));
+    EXPECT_TRUE(queue.try_push(std::move(out)));
+    EXPECT_FALSE(queue.try_push(std::move(value)));
+    // values left in the queue are destroyed with it
+    EXPECT_EQ(value.use_count(), 5);
+}
+
+TEST(MpmcQueue, blocking)
+{
+    run_mpmc<arc::lang::MpmcQueue<std::uint64_t>>(1, 1, false);
+    run_mpmc<arc::lang::MpmcQueue<std::uint64_t>>(4, 4, false);
+    run_mpmc<arc::lang::MpmcQueue<std::uint64_t>>(4, 2, true);
+}
+
+TEST(MpmcQueue, spinning)
+{
+    typedef arc::lang::MpmcQueue<std::uint64_t, arc::lang::SpinWait> Queue;
+    run_mpmc<Queue>(2, 2, false);
+    run_mpmc<Queue>(3, 3, true);
+}
+
+TEST(MpmcQueue, full)
+{
+    arc::lang::MpmcQueue<std::shared_ptr<int>> queue(3);
+    EXPECT_EQ(queue.capacity(), 4U);
+
+    std::shared_ptr<int> values[6];
+    for(std::shared_ptr<int>& value : values)
+    {
+        value.reset(new int(1));
+    }
+    EXPECT_EQ(queue.try_push_batch(values, 6), 4U);
+    EXPECT_FALSE(queue.try_push(values[4]));
+    EXPECT_EQ(queue.size(), 4U);
+
+    std::shared_ptr<int> out[6];
+    EXPECT_EQ(queue.try_pop_batch(out, 6), 4U);
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.try_pop(out[5]));
+}
@@ -0,0 +1,300 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <arcanecore/base/Exceptions.hpp>
+#include <arcanecore/base/io/RecordReader.hpp>
+#include <arcanecore/base/lang/Span.hpp>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+
+//------------------------------------------------------------------------------
+//                                    FIXTURES
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+// a uniquely named file holding the given data, which is deleted at the end
+// of the test
+class TemporaryFile
+{
+public:
+
+    explicit TemporaryFile(const std::string& data)
+        : m_path("/tmp/arc_record_reader_XXXXXX")
+    {
+        const int fd = ::mkstemp(&m_path[0]);
+        EXPECT_EQ(
+            ::write(fd, data.data(), data.size()),
+            static_cast<ssize_t>(data.size())
+        );
+        ::close(fd);
+    }
+
+    ~TemporaryFile()
+    {
+        std::remove(m_path.c_str());
+    }
+
+    const char* get() const
+    {
+        return m_path.c_str();
+    }
+
+private:
+
+    std::string m_path;
+};
+
+// splits the given text a byte at a time, to check the reader against
+std::vector<std::string> split(
+        const std::string& text,
+        char delimiter,
+        bool quoting,
+        bool is_record)
+{
+    std::vector<std::string> ret;
+    std::string current;
+    bool quoted = false;
+    for(char c : text)
+    {
+        if(c == '"' && quoting)
+        {
+            quoted = !quoted;
+        }
+        if(c == delimiter && !quoted)
+        {
+            ret.push_back(current);
+            current.clear();
+        }
+        else
+        {
+            current += c;
+        }
+    }
+    if(!is_record || !current.empty())
+    {
+        ret.push_back(current);
+    }
+
+    for(std::string& part : ret)
+    {
+        if(is_record && !part.empty() && part.back() == '\r')
+        {
+            part.pop_back();
+        }
+        if(!is_record &&
+           part.size() >= 2 &&
+           part.front() == '"' &&
+           part.back() == '"')
+        {
+            part = part.substr(1, part.size() - 2);
+        }
+    }
+    return ret;
+}
+
+std::vector<std::string> read_all(arc::io::RecordReader& reader)
+{
+    std::vector<std::string> ret;
+    arc::lang::Span<const char> record;
+    while(reader.next(record))
+    {
+        ret.push_back(std::string(record.data(), record.size()));
+    }
+    EXPECT_FALSE(reader.next(record));
+    EXPECT_EQ(reader.get_record_count(), ret.size());
+    return ret;
+}
+
+std::vector<std::string> read_memory(
+        const std::string& text,
+        arc::io::RecordFormat format)
+{
+    arc::io::RecordReader reader(
+        arc::lang::Span<const char>(text.data(), text.size()),
+        format
+    );
+    EXPECT_EQ(reader.get_format(), format);
+    return read_all(reader);
+}
+
+std::vector<std::string> read_file(
+        const std::string& text,
+        arc::io::RecordFormat format,
+        std::size_t window_size)
+{
+    TemporaryFile file(text);
+    const int fd = ::open(file.get(), O_RDONLY);
+    std::vector<std::string> ret;
+    {
+        arc::io::RecordReader reader(fd, format, window_size);
+        ret = read_all(reader);
+    }
+    ::close(fd);
+    return ret;
+}
+
+std::vector<std::string> read_fields(const std::string& record)
+{
+    std::vector<std::string> ret;
+    arc::io::CsvFields fields(
+        arc::lang::Span<const char>(record.data(), record.size())
+    );
+    arc::lang::Span<const char> field;
+    while(fields.next(field))
+    {
+        ret.push_back(std::string(field.data(), field.size()));
+    }
+    EXPECT_FALSE(fields.next(field));
+    return ret;
+}
+
+// returns random text made up mostly of the characters that matter to
+// splitting, so that they fall on and across block boundaries
+std::string make_text(std::size_t size, std::uint64_t seed)
+{
+    static const char CHARACTERS[] = "\n\n\r\",,abcdefgh";
+    std::string ret;
+    std::uint64_t state = seed * 0x9E3779B97F4A7C15ULL + 1;
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        ret += CHARACTERS[state % (sizeof(CHARACTERS) - 1)];
+    }
+    return ret;
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                     TESTS
+//------------------------------------------------------------------------------
+
+TEST(RecordReader, lines)
+{
+    const std::string text = "first\nsecond\r\n\nfourth \"with,quote\n\"last";
+    const std::vector<std::string> expected = {
+        "first",
+        "second",
+        "",
+        "fourth \"with,quote",
+        "\"last"
+    };
+    EXPECT_EQ(read_memory(text, arc::io::RecordFormat::kLines), expected);
+    EXPECT_EQ(read_file(text, arc::io::RecordFormat::kLines, 4), expected);
+
+    // a terminated last record, and nothing at all
+    EXPECT_EQ(
+        read_memory("a\nb\n", arc::io::RecordFormat::kLines),
+        std::vector<std::string>({"a", "b"})
+    );
+    EXPECT_TRUE(read_memory("", arc::io::RecordFormat::kLines).empty());
+    EXPECT_TRUE(read_file("", arc::io::RecordFormat::kLines, 16).empty());
+    EXPECT_EQ(
+        read_memory("\n", arc::io::RecordFormat::kLines),
+        std::vector<std::string>({""})
+    );
+}
+
+TEST(RecordReader, csv)
+{
+    const std::string text =
+        "id,name,note\r\n"
+        "1,\"Smith, J\",\"said \"\"hi\"\"\"\n"
+        "2,\"multi\nline\r\nnote\",x\n"
+        "3,,\n";
+    const std::vector<std::string> expected = {
+        "id,name,note",
+        "1,\"Smith, J\",\"said \"\"hi\"\"\"",
+        "2,\"multi\nline\r\nnote\",x",
+        "3,,"
+    };
+    EXPECT_EQ(read_memory(text, arc::io::RecordFormat::kCsv), expected);
+    EXPECT_EQ(read_file(text, arc::io::RecordFormat::kCsv, 3), expected);
+
+    EXPECT_EQ(
+        read_fields(expected[1]),
+        std::vector<std::string>({"1", "Smith, J", "said \"\"hi\"\""})
+    );
+    EXPECT_EQ(
+        read_fields(expected[2]),
+        std::vector<std::string>({"2", "multi\nline\r\nnote", "x"})
+    );
+    EXPECT_EQ(
+        read_fields(expected[3]),
+        std::vector<std::string>({"3", "", ""})
+    );
+    EXPECT_EQ(read_fields(""), std::vector<std::string>({""}));
+
+    const std::string escaped = "said \"\"hi\"\"";
+    char buffer[32];
+    const std::size_t size = arc::io::CsvFields::unescape(
+        arc::lang::Span<const char>(escaped.data(), escaped.size()),
+        buffer
+    );
+    EXPECT_EQ(std::string(buffer, size), "said \"hi\"");
+}
+
+TEST(RecordReader, long_records)
+{
+    // records longer than the window and than a block
+    std::string text;
+    std::vector<std::string> expected;
+    for(std::size_t i = 0; i < 20; ++i)
+    {
+        expected.push_back(std::string(i * 97, static_cast<char>('a' + i)));
+        text += expected.back() + "\n";
+    }
+    EXPECT_EQ(read_memory(text, arc::io::RecordFormat::kLines), expected);
+    EXPECT_EQ(read_file(text, arc::io::RecordFormat::kLines, 100), expected);
+    EXPECT_EQ(read_file(text, arc::io::RecordFormat::kCsv, 1), expected);
+}
+
+TEST(RecordReader, random)
+{
+    for(std::uint64_t seed = 0; seed < 20; ++seed)
+    {
+        const std::string text = make_text(500 + seed * 101, seed);
+        const std::vector<std::string> lines =
+            split(text, '\n', false, true);
+        const std::vector<std::string> records =
+            split(text, '\n', true, true);
+
+        EXPECT_EQ(read_memory(text, arc::io::RecordFormat::kLines), lines);
+        EXPECT_EQ(read_memory(text, arc::io::RecordFormat::kCsv), records);
+        for(std::size_t window_size : {1, 13, 64, 200, 65536})
+        {
+            EXPECT_EQ(
+                read_file(text, arc::io::RecordFormat::kLines, window_size),
+                lines
+            );
+            EXPECT_EQ(
+                read_file(text, arc::io::RecordFormat::kCsv, window_size),
+                records
+            );
+        }
+
+        for(const std::string& record : records)
+        {
+            EXPECT_EQ(read_fields(record), split(record, ',', true, false));
+        }
+    }
+}
+
+TEST(RecordReader, errors)
+{
+    arc::io::RecordReader reader(-1);
+    arc::lang::Span<const char> record;
+    EXPECT_THROW(reader.next(record), arc::ex::RuntimeError);
+}
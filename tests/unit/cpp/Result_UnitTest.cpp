@@ -0,0 +1,43 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include <arcanecore/base/Result.hpp>
+
+
+//------------------------------------------------------------------------------
+//                                     TESTS
+//------------------------------------------------------------------------------
+
+TEST(Result, value)
+{
+    arc::Result<std::string> result(std::string("hello"));
+    ASSERT_TRUE(result.is_ok());
+    EXPECT_TRUE(static_cast<bool>(result));
+    EXPECT_EQ(result.get_value(), "hello");
+    EXPECT_EQ(result.get_or_throw(), "hello");
+
+    arc::Result<std::string> moved(std::move(result));
+    EXPECT_EQ(moved.get_value(), "hello");
+}
+
+TEST(Result, error)
+{
+    arc::Result<int> result(
+        arc::ex::Error(arc::ex::ErrorCode::kValueError, "Bad value.")
+    );
+    ASSERT_TRUE(result.is_error());
+    EXPECT_FALSE(static_cast<bool>(result));
+    EXPECT_EQ(result.get_error().get_code(), arc::ex::ErrorCode::kValueError);
+    EXPECT_STREQ(result.get_error().get_message(), "Bad value.");
+    EXPECT_THROW(result.get_or_throw(), arc::ex::ValueError);
+
+    result = 12;
+    EXPECT_EQ(result.get_or_throw(), 12);
+
+    arc::Result<void> void_result(
+        arc::ex::Error(arc::ex::ErrorCode::kStateError, "Bad state.")
+    );
+    EXPECT_THROW(void_result.get_or_throw(), arc::ex::StateError);
+    EXPECT_NO_THROW(arc::Result<void>().get_or_throw());
+}
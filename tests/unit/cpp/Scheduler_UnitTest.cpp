@@ -0,0 +1,229 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <arcanecore/base/Exceptions.hpp>
+#include <arcanecore/base/task/Scheduler.hpp>
+#include <arcanecore/base/task/TaskGroup.hpp>
+#include <arcanecore/base/task/WorkStealingDeque.hpp>
+
+
+//------------------------------------------------------------------------------
+//                                    FIXTURES
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+std::uint64_t fib(arc::task::Scheduler& scheduler, std::uint64_t n)
+{
+    if(n < 2)
+    {
+        return n;
+    }
+    std::uint64_t a = 0;
+    arc::task::TaskGroup group(scheduler);
+    group.spawn([&]() { a = fib(scheduler, n - 1); });
+    const std::uint64_t b = fib(scheduler, n - 2);
+    group.wait();
+    return a + b;
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                     TESTS
+//------------------------------------------------------------------------------
+
+TEST(WorkStealingDeque, owner)
+{
+    arc::task::WorkStealingDeque<int> deque(2);
+    int values[100];
+    for(int& value : values)
+    {
+        deque.push(&value);
+    }
+    EXPECT_EQ(deque.size(), 100U);
+
+    // the owner pops in LIFO order whereas thieves steal in FIFO order
+    EXPECT_EQ(deque.steal(), &values[0]);
+    for(int i = 99; i > 0; --i)
+    {
+        EXPECT_EQ(deque.pop(), &values[i]);
+    }
+    EXPECT_EQ(deque.pop(), nullptr);
+    EXPECT_EQ(deque.steal(), nullptr);
+    EXPECT_TRUE(deque.empty());
+}
+
+TEST(WorkStealingDeque, steal)
+{
+    static const std::size_t COUNT = 100000;
+    std::vector<int> values(COUNT);
+    arc::task::WorkStealingDeque<int> deque(4);
+    std::atomic<bool> done(false);
+
+    // every element must be taken exactly once
+    std::vector<std::vector<int*>> stolen(3);
+    std::vector<std::thread> thieves;
+    for(std::vector<int*>& taken : stolen)
+    {
+        thieves.emplace_back([&]()
+        {
+            while(!done.load() || !deque.empty())
+            {
+                int* value = deque.steal();
+                if(value != nullptr)
+                {
+                    taken.push_back(value);
+                }
+            }
+        });
+    }
+
+    std::vector<int*> popped;
+    for(std::size_t i = 0; i < COUNT; ++i)
+    {
+        deque.push(&values[i]);
+        if(i % 3 == 0)
+        {
+            int* value = deque.pop();
+            if(value != nullptr)
+            {
+                popped.push_back(value);
+            }
+        }
+    }
+    done = true;
+    for(std::thread& thief : thieves)
+    {
+        thief.join();
+    }
+
+    std::set<int*> unique(popped.begin(), popped.end());
+    std::size_t total = popped.size();
+    for(const std::vector<int*>& taken : stolen)
+    {
+        unique.insert(taken.begin(), taken.end());
+        total += taken.size();
+    }
+    EXPECT_EQ(total, COUNT);
+    EXPECT_EQ(unique.size(), COUNT);
+}
+
+TEST(Scheduler, group)
+{
+    arc::task::Scheduler scheduler(4);
+    EXPECT_EQ(scheduler.get_worker_count(), 4U);
+
+    std::atomic<std::uint64_t> sum(0);
+    arc::task::TaskGroup group(scheduler);
+    for(std::uint64_t i = 1; i <= 10000; ++i)
+    {
+        group.spawn([&sum, i]() { sum += i; });
+    }
+    group.wait();
+    EXPECT_EQ(sum.load(), 10000U * 10001U / 2);
+
+    // closures too large to be stored inline
+    std::array<std::uint64_t, 32> large;
+    large.fill(1);
+    for(std::size_t i = 0; i < 100; ++i)
+    {
+        group.spawn([&sum, large]() { sum += large[31]; });
+    }
+    group.wait();
+    EXPECT_EQ(sum.load(), 10000U * 10001U / 2 + 100);
+
+    // the waiting thread is not a worker but may have executed tasks too
+    EXPECT_LE(scheduler.get_total_stats().executed, 10100U);
+}
+
+TEST(Scheduler, nested)
+{
+    arc::task::Scheduler scheduler(3, true);
+    EXPECT_TRUE(scheduler.get_pin_threads());
+    EXPECT_EQ(fib(scheduler, 20), 6765U);
+
+    // nested groups spawned from a worker
+    std::atomic<std::uint64_t> result(0);
+    arc::task::TaskGroup group(scheduler);
+    group.spawn([&]() { result = fib(scheduler, 18); });
+    group.wait();
+    EXPECT_EQ(result.load(), 2584U);
+
+    const arc::task::WorkerStats stats = scheduler.get_total_stats();
+    EXPECT_GT(stats.spawned, 0U);
+    EXPECT_GE(stats.steal_attempts, stats.stolen);
+    EXPECT_THROW(scheduler.get_worker_stats(3), arc::ex::ValueError);
+}
+
+TEST(Scheduler, exception)
+{
+    arc::task::Scheduler scheduler(2);
+    std::atomic<int> executed(0);
+    arc::task::TaskGroup group(scheduler);
+    for(int i = 0; i < 100; ++i)
+    {
+        group.spawn([&executed, i]()
+        {
+            ++executed;
+            if(i % 10 == 5)
+            {
+                throw std::runtime_error("task failed");
+            }
+        });
+    }
+    EXPECT_THROW(group.wait(), std::runtime_error);
+    // all tasks still run
+    EXPECT_EQ(executed.load(), 100);
+
+    // the exception is only reported once
+    group.wait();
+}
+
+TEST(Scheduler, detached)
+{
+    std::atomic<int> executed(0);
+    {
+        arc::task::Scheduler scheduler(2);
+        for(int i = 0; i < 10000; ++i)
+        {
+            scheduler.spawn([&]() { ++executed; });
+        }
+    }
+    // the scheduler finishes every task before it is destroyed
+    EXPECT_EQ(executed.load(), 10000);
+}
+
+TEST(Scheduler, spawn_throws)
+{
+    struct ThrowingCopy
+    {
+        ThrowingCopy()
+        {
+        }
+
+        ThrowingCopy(const ThrowingCopy&)
+        {
+            throw std::runtime_error("copy failed");
+        }
+
+        void operator()() const
+        {
+        }
+    };
+
+    arc::task::Scheduler scheduler(2);
+    arc::task::TaskGroup group(scheduler);
+    const ThrowingCopy function;
+    EXPECT_THROW(group.spawn(function), std::runtime_error);
+    // the failed spawn is not waited for
+    group.wait();
+}
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+
+#include <arcanecore/base/lang/SmallVector.hpp>
+
+
+//------------------------------------------------------------------------------
+//                                     TESTS
+//------------------------------------------------------------------------------
+
+TEST(SmallVector, inline_storage)
+{
+    arc::lang::SmallVector<std::string, 2> v;
+    EXPECT_TRUE(v.empty());
+    EXPECT_EQ(v.capacity(), 2U);
+
+    v.push_back("a");
+    v.emplace_back("b");
+    EXPECT_TRUE(v.is_inline());
+
+    // spills to the heap
+    v.push_back(v[0]);
+    EXPECT_FALSE(v.is_inline());
+    EXPECT_GE(v.capacity(), 3U);
+    EXPECT_EQ(v, (arc::lang::SmallVector<std::string, 2>{"a", "b", "a"}));
+
+    v.insert(v.begin() + 1, "c");
+    v.erase(v.begin());
+    EXPECT_EQ(v, (arc::lang::SmallVector<std::string, 2>{"c", "b", "a"}));
+
+    v.pop_back();
+    v.resize(4);
+    EXPECT_EQ(v.size(), 4U);
+    EXPECT_EQ(v.back(), "");
+
+    v.clear();
+    EXPECT_TRUE(v.empty());
+}
+
+TEST(SmallVector, move)
+{
+    // inline elements are moved individually
+    arc::lang::SmallVector<std::unique_ptr<int>, 2> a;
+    a.emplace_back(new int(1));
+    arc::lang::SmallVector<std::unique_ptr<int>, 2> b(std::move(a));
+    EXPECT_TRUE(a.empty());
+    ASSERT_EQ(b.size(), 1U);
+    EXPECT_EQ(*b[0], 1);
+
+    // heap allocations are stolen
+    for(int i = 2; i <= 4; ++i)
+    {
+        b.emplace_back(new int(i));
+    }
+    const std::unique_ptr<int>* data = b.data();
+    arc::lang::SmallVector<std::unique_ptr<int>, 2> c;
+    c = std::move(b);
+    EXPECT_EQ(c.data(), data);
+    EXPECT_TRUE(b.empty());
+    EXPECT_TRUE(b.is_inline());
+    ASSERT_EQ(c.size(), 4U);
+    EXPECT_EQ(*c[3], 4);
+
+    // copies are deep
+    arc::lang::SmallVector<std::string, 1> d{"x", "y"};
+    arc::lang::SmallVector<std::string, 1> e(d);
+    d[0] = "z";
+    EXPECT_EQ(e[0], "x");
+}
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+
+#include <cfloat>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <string>
+
+#include <deus/UnicodeStorage.hpp>
+#include <deus/UnicodeView.hpp>
+
+#include <arcanecore/base/lang/StringBuilder.hpp>
+
+
+//------------------------------------------------------------------------------
+//                                     TESTS
+//------------------------------------------------------------------------------
+
+TEST(StringBuilder, append)
+{
+    arc::lang::StringBuilder builder;
+    EXPECT_TRUE(builder.empty());
+    EXPECT_STREQ(builder.c_str(), "");
+    EXPECT_EQ(
+        builder.capacity(),
+        arc::lang::StringBuilder::INLINE_CAPACITY - 1
+    );
+
+    const std::string flag = "--verbose";
+    builder
+        << "Flag (" << flag << ") "
+        << deus::UnicodeView("expects ") << 2U << ' '
+        << deus::UnicodeStorage("values") << ": " << true;
+    builder.append(3, '.').append("xyz", 1);
+    EXPECT_EQ(
+        builder.to_string(),
+        "Flag (--verbose) expects 2 values: true...x"
+    );
+    EXPECT_EQ(builder.size(), builder.to_string().size());
+    EXPECT_TRUE(
+        builder.get_view() ==
+        deus::UnicodeView("Flag (--verbose) expects 2 values: true...x")
+    );
+    EXPECT_TRUE(
+        builder.to_unicode() ==
+        deus::UnicodeView("Flag (--verbose) expects 2 values: true...x")
+    );
+
+    builder.clear();
+    EXPECT_TRUE(builder.empty());
+    builder << "again";
+    EXPECT_STREQ(builder.c_str(), "again");
+}
+
+TEST(StringBuilder, grow)
+{
+    // grows past the inline buffer one byte at a time and in large pieces
+    arc::lang::StringBuilder builder;
+    std::string expected;
+    for(int i = 0; i < 10000; ++i)
+    {
+        const char c = static_cast<char>('a' + i % 26);
+        builder << c;
+        expected += c;
+        if(i % 1000 == 0)
+        {
+            const std::string piece(i, 'z');
+            builder << piece;
+            expected += piece;
+        }
+    }
+    EXPECT_EQ(builder.to_string(), expected);
+    EXPECT_STREQ(builder.c_str(), expected.c_str());
+    EXPECT_GE(builder.capacity(), builder.size());
+
+    arc::lang::StringBuilder reserved(100000);
+    EXPECT_GE(reserved.capacity(), 100000U);
+    EXPECT_TRUE(reserved.empty());
+}
+
+TEST(StringBuilder, integers)
+{
+    arc::lang::StringBuilder builder;
+    builder
+        << 0 << ' ' << 7 << ' ' << -7 << ' ' << 10 << ' ' << 99 << ' ' << 100
+        << ' ' << static_cast<short>(-1234) << ' '
+        << static_cast<unsigned char>(200) << ' '
+        << std::numeric_limits<std::int64_t>::min() << ' '
+        << std::numeric_limits<std::int64_t>::max() << ' '
+        << std::numeric_limits<std::uint64_t>::max();
+    EXPECT_EQ(
+        builder.to_string(),
+        "0 7 -7 10 99 100 -1234 200 -9223372036854775808 9223372036854775807 "
+        "18446744073709551615"
+    );
+}
+
+TEST(StringBuilder, floats)
+{
+    // the shortest representation which round trips
+    arc::lang::StringBuilder builder;
+    builder << 0.1 << ' ' << 0.1F << ' ' << 1.5 << ' ' << -2.0 << ' ' << 1e300
+            << ' ' << 100.0F;
+    EXPECT_EQ(builder.to_string(), "0.1 0.1 1.5 -2 1e+300 100");
+
+    const double values[] = {1.0 / 3.0, DBL_MIN, DBL_MAX, 5e-324, 0.3};
+    for(double value : values)
+    {
+        builder.clear();
+        builder << value;
+        EXPECT_EQ(std::strtod(builder.c_str(), nullptr), value);
+    }
+    builder.clear();
+    builder << FLT_MAX;
+    EXPECT_EQ(std::strtof(builder.c_str(), nullptr), FLT_MAX);
+
+    builder.clear();
+    builder << std::numeric_limits<double>::infinity() << ' '
+            << std::numeric_limits<double>::quiet_NaN();
+    EXPECT_EQ(builder.to_string(), "inf nan");
+}